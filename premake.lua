@@ -12,4 +12,6 @@ include("source/plugins/nvigi.net/premake.lua")
 include("source/plugins/nvigi.template.generic/premake.lua")
 include("source/plugins/nvigi.template.inference/premake.lua")
 include("source/tests/ai/premake.lua")
+include("source/tests/bench/premake.lua")
 include("source/tools/utils/premake.lua")
+include("source/tools/host/premake.lua")
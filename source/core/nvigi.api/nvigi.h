@@ -64,9 +64,25 @@ enum class PreferenceFlags : uint64_t
     eDisablePrivilegeDowngrade = 1 << 1,
     //! Optional - Disables higher resolution timer frequency
     //!
-    //! For optimal timing performance NVIGI adjusts CPU timer resolution frequency. 
-    //! Set this flag to opt out and leave it unchanged.
-    eDisableCPUTimerResolutionChange = 1 << 2
+    //! Kept for backwards compatibility, timer resolution is no longer changed unless
+    //! 'eEnableCPUTimerResolutionChange' is set. If both are set this flag wins.
+    eDisableCPUTimerResolutionChange = 1 << 2,
+    //! Optional - Enables thread caching, size-class pooled memory allocator
+    //!
+    //! Reduces allocation overhead for small short-lived buffers (slots, strings, arrays) exchanged with plugins
+    //! at the cost of memory held in per-thread caches.
+    eEnablePooledMemoryAllocator = 1 << 3,
+    //! Optional - Enables asynchronous logging
+    //!
+    //! Messages are written to the console, log file and log callback from a background thread
+    //! so logging threads never block on I/O. Log callback is invoked from that thread too.
+    eEnableAsyncLogging = 1 << 4,
+    //! Optional - Enables higher resolution timer frequency for the whole system
+    //!
+    //! NVIGI waits on per-thread high resolution timers so sub-millisecond wakeups do not need this.
+    //! Setting this flag raises the global CPU timer resolution to 0.5ms, which increases power draw system wide,
+    //! use only if the host itself relies on precise 'Sleep' calls and does not adjust the resolution on its own.
+    eEnableCPUTimerResolutionChange = 1 << 5
 };
 
 NVIGI_ENUM_OPERATORS_64(PreferenceFlags)
@@ -97,6 +113,9 @@ struct alignas(8) Preferences {
     uint32_t numPathsToPlugins = 0;
     //! Optional - Path to the location where logs and other data should be stored
     //! 
+    //! Also used to cache plugin information so that unchanged plugins do not have to be loaded on every nvigiInit
+    //! and to persist GPU pipelines and kernels built by plugins (see "nvigi.gpu.cache" sub-directory)
+    //! 
     //! NOTE: Set this to nullptr in order to disable logging to a file
     const char* utf8PathToLogsAndData{};
     //! Optional - Allows log message tracking including critical errors if they occur
@@ -114,6 +133,112 @@ struct alignas(8) Preferences {
 
 NVIGI_VALIDATE_STRUCT(Preferences)
 
+//! Optional tracing backends, can be combined
+enum class TraceBackendFlags : uint32_t
+{
+    eNone = 0,
+    //! NVTX ranges in the "NVIGI" domain, visible in Nsight Systems
+    eNVTX = 1 << 0,
+    //! ETW start/stop events from the "NVIDIA.NVIGI" TraceLogging provider, visible in WPA
+    eETW = 1 << 1,
+    //! Buffered events written as Chrome trace JSON on nvigiShutdown, open in chrome://tracing or ui.perfetto.dev
+    eChromeJSON = 1 << 2
+};
+
+NVIGI_ENUM_OPERATORS_32(TraceBackendFlags)
+
+//! Optional - chain to 'Preferences' to trace framework and plugin work (nvigiInit, plugin loading, instance creation, evaluation, network transfers)
+//!
+//! Tracing costs a single load and branch per span when disabled.
+//!
+//! {3451E4DA-B5E7-43DE-9CB1-A709CE599A63}
+struct alignas(8) TracePreferences {
+    TracePreferences() {};
+    NVIGI_UID(UID({ 0x3451e4da, 0xb5e7, 0x43de,{ 0x9c, 0xb1, 0xa7, 0x09, 0xce, 0x59, 0x9a, 0x63 } }), kStructVersion1)
+    TraceBackendFlags backends{};
+    //! Required for eChromeJSON - file to write, defaults to "nvigi.trace.json" in 'utf8PathToLogsAndData'
+    const char* utf8PathToTraceFile{};
+    //! Optional - events beyond this limit are dropped (eChromeJSON only)
+    uint32_t maxBufferedEvents = 1u << 20;
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(TracePreferences)
+
+//! Optional - chain to 'Preferences' to unload idle plugins after a grace period
+//!
+//! By default a plugin (and its GPU contexts and dependencies) is unloaded as soon as its last interface is released.
+//! With an idle timeout the plugin stays resident for 'idleTimeoutMs' after that, getting an interface again within
+//! this window costs nothing, afterwards the plugin is evicted and transparently registered again by the next
+//! 'nvigiLoadInterface'. Hosts keep the plugin unused by releasing their interfaces once all instances are destroyed.
+//!
+//! Eviction and reload latencies are recorded as "idle_evict_us" and "idle_reload_us" histograms
+//! for the plugin, see 'IMetrics' in source/core/nvigi.metrics/metrics.h
+//!
+//! {7110E97A-EE2D-45B4-ACD3-28589C072DBC}
+struct alignas(8) IdlePreferences {
+    IdlePreferences() {};
+    NVIGI_UID(UID({ 0x7110e97a, 0xee2d, 0x45b4,{ 0xac, 0xd3, 0x28, 0x58, 0x9c, 0x07, 0x2d, 0xbc } }), kStructVersion1)
+    //! Time a plugin without any interface references stays loaded, 0 unloads immediately
+    uint32_t idleTimeoutMs = 0;
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(IdlePreferences)
+
+//! Structured log record, delivered in batches to 'PFun_LogBatchCallback'
+//!
+//! All pointers are valid only for the duration of the callback, strings are null terminated.
+struct LogRecord
+{
+    //! Level the message was logged at, eDefault or eVerbose
+    LogLevel level;
+    LogType type;
+    //! Optional, nullptr if the message was logged without a tag
+    const char* tag;
+    //! File name without the path
+    const char* file;
+    int line;
+    const char* function;
+    //! System clock time in nanoseconds since epoch
+    uint64_t timestampNs;
+    //! OS thread id of the logging thread
+    uint64_t threadId;
+    //! Message without header or trailing new line
+    const char* message;
+    size_t messageLength;
+};
+
+//! Batched logging callback
+//!
+//! Called from the logging thread only, never from the thread which logged the message.
+//! 'dropped' is the number of records lost since the previous call because the logging thread fell behind.
+using PFun_LogBatchCallback = void(const LogRecord* records, size_t count, uint64_t dropped, void* userData);
+
+//! Optional - chain to 'Preferences' to receive log messages in batches of structured records
+//!
+//! Logging threads only copy the record into a per-thread ring, the host callback is invoked from the logging
+//! thread every 'intervalMs' (or sooner when errors are logged or rings fill up). Enables asynchronous logging.
+//! When a ring is full records are dropped instead of blocking the logging thread, see 'dropped' in the callback.
+//!
+//! NOTE: 'Preferences::logMessageCallback' (if any) keeps receiving formatted messages, also from the logging thread
+//!
+//! {4A059B27-14A4-44CE-A27B-A8AF9C6C544A}
+struct alignas(8) LogBatchPreferences {
+    LogBatchPreferences() {};
+    NVIGI_UID(UID({ 0x4a059b27, 0x14a4, 0x44ce,{ 0xa2, 0x7b, 0xa8, 0xaf, 0x9c, 0x6c, 0x54, 0x4a } }), kStructVersion1)
+    PFun_LogBatchCallback* callback{};
+    void* userData{};
+    //! How often pending records are delivered
+    uint32_t intervalMs = 50;
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(LogBatchPreferences)
+
 struct BaseStructure;
 }
 
@@ -123,6 +248,9 @@ using PFun_nvigiInit = nvigi::Result(const nvigi::Preferences& pref, nvigi::Plug
 using PFun_nvigiShutdown = nvigi::Result();
 using PFun_nvigiLoadInterface = nvigi::Result(nvigi::PluginID feature, const nvigi::UID& interfaceType, uint32_t interfaceVersion, void** _interface, const char* utf8PathToPlugin);
 using PFun_nvigiUnloadInterface = nvigi::Result(nvigi::PluginID feature, void* _interface);
+using PFun_nvigiPreloadCallback = void(nvigi::PluginID feature, nvigi::Result result, void* userData);
+using PFun_nvigiPreloadInterfacesAsync = nvigi::Result(const nvigi::PluginID* features, uint32_t count, PFun_nvigiPreloadCallback* callback, void* userData);
+using PFun_nvigiGetPluginReadiness = nvigi::Result(nvigi::PluginID feature);
 
 //! Initializes the NVIGI framework
 //!
@@ -190,6 +318,34 @@ NVIGI_API nvigi::Result nvigiLoadInterface(nvigi::PluginID feature, const nvigi:
 //! This method is NOT thread safe.
 NVIGI_API nvigi::Result nvigiUnloadInterface(nvigi::PluginID feature, void* _interface);
 
+//! Registers plugins for specific NVIGI features on a background thread
+//!
+//! Call this method during loading screens or similar to move the cost of loading plugin libraries and registering
+//! plugins away from the thread which calls `nvigiLoadInterface` first (often the frame thread).
+//!
+//! Plugins stay registered after preloading, `nvigiLoadInterface` for any of them is a fast lookup once ready.
+//! If `nvigiLoadInterface` is called while a plugin is still being preloaded it waits for the preload to finish.
+//!
+//! @param features Features to preload, must be enumerated during `nvigiInit`
+//! @param count Number of features
+//! @param callback Optional callback invoked from a worker thread once each feature is registered or failed to register
+//! @param userData Optional pointer passed to the callback
+//! @returns nvigi::kResultOk if preloading was scheduled, error code otherwise (see nvigi_result.h for details)
+//!
+//! NOTE: Callback must not call `nvigiShutdown`, shutdown waits for all pending preloads.
+//!
+//! This method is thread safe.
+NVIGI_API nvigi::Result nvigiPreloadInterfacesAsync(const nvigi::PluginID* features, uint32_t count, PFun_nvigiPreloadCallback* callback = nullptr, void* userData = nullptr);
+
+//! Returns registration status for a specific NVIGI feature without blocking
+//!
+//! @param feature Specifies feature to check
+//! @returns nvigi::kResultOk if plugin is registered and ready, nvigi::kResultNotReady if it is being preloaded, 
+//! nvigi::kResultItemNotFound if it was never registered (or has been unloaded), registration error code otherwise
+//!
+//! This method is thread safe.
+NVIGI_API nvigi::Result nvigiGetPluginReadiness(nvigi::PluginID feature);
+
 //! Helper method when statically linking NVIGI framework
 //! 
 template<typename T>
@@ -31,6 +31,40 @@ struct alignas(8) CPUParameters {
 
 NVIGI_VALIDATE_STRUCT(CPUParameters);
 
+//! Cores a plugin instance prefers for its CPU threads, see 'CpuThreadBudget'
+enum class CpuCoreClass : uint32_t
+{
+    eAny,
+    //! P-cores on hybrid CPUs, all cores otherwise
+    ePerformance,
+    //! E-cores on hybrid CPUs, all cores otherwise
+    eEfficiency,
+};
+
+//! Interface 'CpuThreadBudget'
+//!
+//! Optional - chain with creation parameters to limit how many CPU threads an instance spawns and where they run,
+//! so inference does not oversubscribe the cores used by the host's job system (or by other plugins).
+//!
+//! Resolved against the CPU topology detected by the framework, see 'ISystem::resolveCpuThreadBudget'
+//!
+//! {A039855A-6056-4073-8108-3CB8671A59EC}
+struct alignas(8) CpuThreadBudget {
+    CpuThreadBudget() {};
+    NVIGI_UID(UID({ 0xa039855a, 0x6056, 0x4073,{ 0x81, 0x08, 0x3c, 0xb8, 0x67, 0x1a, 0x59, 0xec } }), kStructVersion1)
+    //! Upper bound on worker threads, 0 means no limit beyond 'CommonCreationParameters::numThreads' and the selected cores
+    uint32_t maxThreads{};
+    CpuCoreClass coreClass = CpuCoreClass::eAny;
+    //! Optional explicit affinity (bit N is logical processor N in processor group 0), overrides 'coreClass'
+    uint64_t affinityMask{};
+    //! Keep all threads within one L3 cache domain (e.g. one CCD on multi-die CPUs)
+    bool singleL3Domain{};
+
+    //! NEW MEMBERS GO HERE, BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(CpuThreadBudget)
+
 //! Interface CpuData
 //!
 //! {A8197FE3-FC9B-4730-BC85-CB9F755C111C}
@@ -10,6 +10,8 @@ typedef int CUdevice_v1;                                     /**< CUDA device */
 typedef CUdevice_v1 CUdevice;                                /**< CUDA device */
 typedef struct CUctx_st* CUcontext;                          /**< CUDA context */
 typedef struct CUstream_st* CUstream;                        /**< CUDA stream */
+typedef unsigned long long CUdeviceptr_v2;                   /**< CUDA device pointer */
+typedef CUdeviceptr_v2 CUdeviceptr;                          /**< CUDA device pointer */
 
 namespace nvigi
 {
@@ -64,11 +66,14 @@ NVIGI_VALIDATE_STRUCT(CudaParameters);
 //! {DEE43A64-2622-492E-8737-9AAD6BE1D634}
 struct alignas(8) CudaData {
     CudaData() {}; 
-    NVIGI_UID(UID({ 0xdee43a64, 0x2622, 0x492e,{ 0x87, 0x37, 0x9a, 0xad, 0x6b, 0xe1, 0xd6, 0x34 } }), kStructVersion1)
+    NVIGI_UID(UID({ 0xdee43a64, 0x2622, 0x492e,{ 0x87, 0x37, 0x9a, 0xad, 0x6b, 0xe1, 0xd6, 0x34 } }), kStructVersion2)
     //! Data buffer
     const void* buffer{};
     //! Number of bytes in the buffer
     size_t sizeInBytes{};
+    //! v2
+    //! Optional - stream producing the buffer, consumer orders its work after it (e.g. cuStreamWaitEvent) instead of synchronizing the device
+    CUstream stream{};
     //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
 };
 
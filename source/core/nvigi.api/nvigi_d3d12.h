@@ -10,6 +10,7 @@
 struct ID3D12Device;
 struct ID3D12CommandQueue;
 struct ID3D12Resource;
+struct ID3D12Fence;
 struct D3D12_HEAP_PROPERTIES;
 struct D3D12_RESOURCE_DESC;
 struct D3D12_CLEAR_VALUE;
@@ -101,13 +102,38 @@ NVIGI_VALIDATE_STRUCT(D3D12Parameters);
 //! {4A51AF62-7C2C-41F6-9AA6-B19419084E0D}
 struct alignas(8) D3D12Data {
     D3D12Data() {}; 
-    NVIGI_UID(UID({ 0x4a51af62, 0x7c2c, 0x41f6,{ 0x9a, 0xa6, 0xb1, 0x94, 0x19, 0x08, 0x4e, 0x0d } }), kStructVersion2)
+    NVIGI_UID(UID({ 0x4a51af62, 0x7c2c, 0x41f6,{ 0x9a, 0xa6, 0xb1, 0x94, 0x19, 0x08, 0x4e, 0x0d } }), kStructVersion3)
     ID3D12Resource* resource {};    
     //! v2    
     uint32_t state{}; // D3D12_RESOURCE_STATES
+    //! v3
+    //! Optional - resource is ready once 'fence' reaches 'fenceValue', consumer waits on GPU (ID3D12CommandQueue::Wait)
+    ID3D12Fence* fence{};
+    uint64_t fenceValue{};
     //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
 };
 
 NVIGI_VALIDATE_STRUCT(D3D12Data)
 
+//! Interface D3D12FrameSyncParameters
+//!
+//! Optional, chain to runtime parameters to order the inference GPU work against the host's frame without any CPU waits.
+//! Plugins make their compute queue wait until 'waitFence' reaches 'waitValue' before the first dispatch (e.g. frame
+//! which produced the inputs) and signal 'signalFence' with 'signalValue' after the last one, host can then
+//! ID3D12CommandQueue::Wait on it wherever the results are consumed. Either pair can be left empty.
+//!
+//! {FDA9F7DE-A99F-4A36-9B2D-5474BA778C56}
+struct alignas(8) D3D12FrameSyncParameters {
+    D3D12FrameSyncParameters() {};
+    NVIGI_UID(UID({ 0xfda9f7de, 0xa99f, 0x4a36,{ 0x9b, 0x2d, 0x54, 0x74, 0xba, 0x77, 0x8c, 0x56 } }), kStructVersion1)
+    ID3D12Fence* waitFence{};
+    uint64_t waitValue{};
+    ID3D12Fence* signalFence{};
+    uint64_t signalValue{};
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(D3D12FrameSyncParameters)
+
 } // namespace nvigi
\ No newline at end of file
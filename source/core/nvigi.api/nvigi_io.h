@@ -23,6 +23,15 @@ enum class MapAccess : uint32_t
     eReadWrite = 2,
 };
 
+//! Completion for 'FileIOCallbacks::readAsync'
+//!
+//! completionContext: pointer provided when issuing the read
+//! result: kResultOk on success (bytesRead can be less than requested when reading past the end), error code otherwise
+//! bytesRead: number of bytes actually written to the destination buffer
+//!
+//! NOTE: Can be invoked on any thread, including the one which issued the read
+using FileIOReadCompletion = void(*)(void* completionContext, Result result, size_t bytesRead);
+
 //! Interface 'FileIOCallbacks'
 //!
 //! {BABCD7BC-4951-4DCD-BF23-18D5FF6120DD}
@@ -40,6 +49,8 @@ struct alignas(8) FileIOCallbacks
         , map(nullptr)
         , unmap(nullptr)
         , getLastError(nullptr)
+        , readAsync(nullptr)
+        , waitAsync(nullptr)
     { }
 
     FileIOCallbacks(void *ud,
@@ -52,7 +63,9 @@ struct alignas(8) FileIOCallbacks
                     size_t (*w)(void *, void *, const void *, size_t),
                     uint8_t* (*m)(void*, void*, size_t, size_t, MapAccess) = nullptr,
                     void (*um)(void*, void*, uint8_t*) = nullptr,
-                    Result (*gle)(void*, void*) = nullptr)
+                    Result (*gle)(void*, void*) = nullptr,
+                    Result (*ra)(void*, void*, size_t, size_t, void*, FileIOReadCompletion, void*) = nullptr,
+                    Result (*wa)(void*, void*) = nullptr)
         : userData(ud)
         , open(o)
         , close(c)
@@ -64,9 +77,11 @@ struct alignas(8) FileIOCallbacks
         , map(m)
         , unmap(um)
         , getLastError(gle)
+        , readAsync(ra)
+        , waitAsync(wa)
     { }
 
-    NVIGI_UID(UID({0xbabcd7bc, 0x4951, 0x4dcd,{0xbf, 0x23, 0x18, 0xd5, 0xff, 0x61, 0x20, 0xdd}}), kStructVersion1)
+    NVIGI_UID(UID({0xbabcd7bc, 0x4951, 0x4dcd,{0xbf, 0x23, 0x18, 0xd5, 0xff, 0x61, 0x20, 0xdd}}), kStructVersion2)
 
     // User data pointer passed to all callbacks
     void * userData;
@@ -151,7 +166,27 @@ struct alignas(8) FileIOCallbacks
     //!          - etc.
     Result (*getLastError)(void* userData, void* handle);
 
-    //! v2+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
+    //! v2+
+
+    //! Read data asynchronously (optional)
+    //! offset: absolute offset in bytes from the start of the data source, independent of 'seek'/'tell'
+    //! len: number of bytes to read
+    //! dst: buffer to read into, must stay valid until completion is invoked
+    //! completion: invoked exactly once per successfully issued read
+    //!
+    //! NOTE: This is optional, can be NULL (or struct version < 2) if asynchronous reads are not supported.
+    //! Multiple reads can be in flight on the same handle, implementations can block the caller
+    //! when their queue depth is exhausted.
+    //!
+    //! Returns: kResultOk if read was issued, error code otherwise (completion is NOT invoked in that case)
+    Result (*readAsync)(void* userData, void* handle, size_t offset, size_t len, void* dst, FileIOReadCompletion completion, void* completionContext);
+
+    //! Block until all asynchronous reads issued on the handle have completed (optional, required if 'readAsync' is provided)
+    //!
+    //! Returns: kResultOk if all reads succeeded, otherwise the first error reported by a completion
+    Result (*waitAsync)(void* userData, void* handle);
+
+    //! v3+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
 };
 
 NVIGI_VALIDATE_STRUCT(FileIOCallbacks)
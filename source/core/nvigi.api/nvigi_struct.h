@@ -129,6 +129,7 @@ constexpr uint32_t kStructVersion5 = 5;
 constexpr uint32_t kStructVersion6 = 6;
 constexpr uint32_t kStructVersion7 = 7;
 constexpr uint32_t kStructVersion8 = 8;
+constexpr uint32_t kStructVersion9 = 9;
 
 //! Maximum number of chained structures
 constexpr uint32_t kMaxNumChainedStructs = 16;
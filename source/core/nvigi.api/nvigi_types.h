@@ -154,6 +154,11 @@ enum class SystemFlags : uint64_t
     eAVX = 1ull << 8,
     eAVX2 = 1ull << 9,
     eMMX = 1ull << 10,
+    eFMA = 1ull << 11,
+    eF16C = 1ull << 12,
+    eAVX512F = 1ull << 13,
+    eAVX512BW = 1ull << 14,
+    eAVX512VNNI = 1ull << 15,
 };
 
 NVIGI_ENUM_OPERATORS_64(SystemFlags);
@@ -15,6 +15,7 @@ struct VkSwapchainKHR_T;
 struct VkQueue_T;
 struct VkBuffer_T;
 struct VkDeviceMemory_T;
+struct VkSemaphore_T;
 using VkPhysicalDevice = VkPhysicalDevice_T*;
 using VkDevice = VkDevice_T*;
 using VkInstance = VkInstance_T*;
@@ -22,6 +23,7 @@ using VkSwapchainKHR = VkSwapchainKHR_T*;
 using VkQueue = VkQueue_T*;
 using VkBuffer = VkBuffer_T*;
 using VkDeviceMemory = VkDeviceMemory_T*;
+using VkSemaphore = VkSemaphore_T*;
 using VkDeviceSize = uint64_t;
 
 namespace nvigi
@@ -65,12 +67,18 @@ NVIGI_VALIDATE_STRUCT(VulkanParameters)
 struct alignas(8) VulkanData
 {
     VulkanData() { };
-    NVIGI_UID(UID({0x2b7a560a, 0xa1d7, 0x463e,{0x86, 0xd8, 0xb6, 0x83, 0x35, 0xa6, 0xb9, 0x03}}), kStructVersion1)
+    NVIGI_UID(UID({0x2b7a560a, 0xa1d7, 0x463e,{0x86, 0xd8, 0xb6, 0x83, 0x35, 0xa6, 0xb9, 0x03}}), kStructVersion2)
 
     VkBuffer buffer{};
     size_t sizeInBytes{};
+
+    //! v2
+
+    //! Optional - buffer is ready once timeline 'semaphore' reaches 'semaphoreValue', consumer waits on GPU
+    VkSemaphore semaphore{};
+    uint64_t semaphoreValue{};
     
-    //! v2+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
+    //! v3+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
 };
 
 NVIGI_VALIDATE_STRUCT(VulkanData)
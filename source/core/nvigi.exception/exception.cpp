@@ -382,6 +382,9 @@ int writeMiniDump(LPEXCEPTION_POINTERS exceptionInfo)
 
     NVIGI_LOG_INFO("Stack trace:\n%s", stackTrace.c_str());
 
+    // Make sure messages queued by the async logger (if enabled) end up in the file we are about to copy
+    log::getInterface()->flush(500);
+
     // Copy log file next to the mini-dump
     try 
     { 
@@ -110,6 +110,11 @@ inline std::string toStr(SystemFlags flag)
     case SystemFlags::eAVX: return "AVX";
     case SystemFlags::eAVX2: return "AVX2";
     case SystemFlags::eMMX: return "MMX";
+    case SystemFlags::eFMA: return "FMA";
+    case SystemFlags::eF16C: return "F16C";
+    case SystemFlags::eAVX512F: return "AVX512F";
+    case SystemFlags::eAVX512BW: return "AVX512BW";
+    case SystemFlags::eAVX512VNNI: return "AVX512VNNI";
     }
     assert(false && "please update this method to cover for unknown enum flags.");
     return "Unknown";
@@ -129,6 +134,11 @@ inline std::wstring toWStr(SystemFlags flag)
     case SystemFlags::eAVX: return L"AVX";
     case SystemFlags::eAVX2: return L"AVX2";
     case SystemFlags::eMMX: return L"MMX";
+    case SystemFlags::eFMA: return L"FMA";
+    case SystemFlags::eF16C: return L"F16C";
+    case SystemFlags::eAVX512F: return L"AVX512F";
+    case SystemFlags::eAVX512BW: return L"AVX512BW";
+    case SystemFlags::eAVX512VNNI: return L"AVX512VNNI";
     }
     assert(false && "please update this method to cover for unknown enum flags.");
     return L"Unknown";
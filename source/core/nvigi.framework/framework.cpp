@@ -6,6 +6,8 @@
 #include <Windows.h>
 #endif
 #include <filesystem>
+#include <set>
+#include <thread>
 #include <unordered_set>
 
 #include "source/core/nvigi.api/nvigi.h"
@@ -18,9 +20,14 @@
 #include "source/core/nvigi.extra/extra.h"  
 #include "source/core/nvigi.file/file.h"
 #include "source/core/nvigi.system/system.h"
+#include "source/core/nvigi.simd/simd.h"
+#include "source/core/nvigi.trace/trace.h"
+#include "source/core/nvigi.metrics/metrics.h"
+#include "source/core/nvigi.resources/resources.h"
 #include "source/core/nvigi.exception/exception.h"
 #include "source/core/nvigi.plugin/plugin.h"
 #include "source/core/nvigi.framework/framework.h"
+#include "source/core/nvigi.thread/thread.h"
 #include "source/core/nvigi.api/nvigi_version.h"
 #include "external/json/source/nlohmann/json.hpp"
 #include "_artifacts/gitVersion.h"
@@ -31,17 +38,48 @@ using json = nlohmann::json;
 //! 
 nvigi::Result nvigiLoadInterfaceImpl(nvigi::PluginID feature, const nvigi::UID& type, uint32_t version, void** _interface, const char* utf8PathToPlugin);
 nvigi::Result nvigiUnloadInterfaceImpl(nvigi::PluginID feature, const nvigi::UID& type);
+nvigi::Result preloadPlugin(nvigi::PluginID feature);
 
 //! Implemented in system.cpp, not in a header since we don't want accidental includes by plugins
 namespace nvigi::system
 {
 extern bool getSystemCaps(nvigi::VendorId forceAdapterId, uint32_t forceArchitecture, nvigi::system::SystemCaps* info);
 extern bool getOSVersionAndUpdateTimerResolution(nvigi::system::SystemCaps* caps);
+extern void beginSystemCapsDiscovery(nvigi::VendorId forceAdapterId, uint32_t forceArchitecture, const nvigi::Version& osVersion);
+extern void waitForSystemCaps(nvigi::system::SystemCaps* caps);
+extern nvigi::SystemFlags getCpuFlags();
 extern void cleanup(nvigi::system::SystemCaps* caps);
 extern void setTimerResolution();
 extern bool validateDLL(const std::wstring& dllFilePath, const std::vector<std::wstring>& utf16DependeciesDirectories, std::map<std::string, fs::path>& dependencies);
+extern bool getModuleSignatureHash(const std::wstring& dllFilePath, uint64_t& hash);
+extern void getValidationCacheStats(uint64_t& hits, uint64_t& misses);
+#ifndef NVIGI_PRODUCTION
+extern void loadValidationCache(const wchar_t* path);
+extern void saveValidationCache();
+#endif
 extern void setPreferenceFlags(PreferenceFlags flags);
 }
+namespace nvigi::memory
+{
+extern void setPooledAllocator(bool enable);
+}
+namespace nvigi::simd
+{
+extern void initialize(SystemFlags flags);
+}
+namespace nvigi::trace
+{
+extern void initialize(TraceBackendFlags backends, const char* utf8PathToTraceFile, uint32_t maxBufferedEvents);
+extern void shutdown();
+}
+namespace nvigi::metrics
+{
+extern void shutdown();
+}
+namespace nvigi::resources
+{
+extern void shutdown();
+}
 
 namespace nvigi
 {
@@ -57,7 +95,61 @@ struct PluginInternals
 };
 
 using ModulesMap = std::map<nvigi::PluginID, std::tuple<std::filesystem::path, PluginInternals>>;
-using InterfacesMap = std::map<nvigi::PluginID, std::vector<std::tuple<int32_t, BaseStructure*, InterfaceFlags>>>;
+//! Heap allocated so that lookups via 'InterfaceTable' snapshots never see it move
+struct InterfaceEntry
+{
+    std::atomic<int32_t> refCount{};
+    BaseStructure* _interface{};
+    InterfaceFlags flags{};
+};
+
+//! Reference count of entries claimed by the idle unloader, lock free lookups seeing it fall back to the slow path
+constexpr int32_t kRefCountEvicting = INT32_MIN / 2;
+
+using InterfacesMap = std::map<nvigi::PluginID, std::vector<std::unique_ptr<InterfaceEntry>>>;
+
+//! Read optimized, immutable snapshot of all registered interfaces
+//! 
+//! Flat open addressing table keyed by plugin crc24 and interface UID. Republished on every change (plugin
+//! registration or unload, which are rare) so looking up an already registered interface needs no locks or allocations.
+//! 
+//! RCU style, readers can hold on to an old snapshot hence these and removed entries are retired and released on shutdown.
+struct InterfaceTable
+{
+    struct Slot
+    {
+        uint32_t crc24{};
+        UID type{};
+        InterfaceEntry* entry{};
+    };
+    size_t mask{};
+    std::vector<Slot> slots;
+
+    static size_t hash(uint32_t crc24, const UID& type)
+    {
+        uint64_t h = (uint64_t(crc24) << 32) ^ type.data1 ^ (uint64_t(type.data2) << 16) ^ (uint64_t(type.data3) << 40);
+        for (auto b : type.data4) h = (h ^ b) * 1099511628211ull;
+        return (size_t)(h ^ (h >> 29));
+    }
+
+    InterfaceEntry* find(uint32_t crc24, const UID& type) const
+    {
+        for (size_t i = hash(crc24, type) & mask;; i = (i + 1) & mask)
+        {
+            auto& slot = slots[i];
+            if (!slot.entry) return nullptr;
+            if (slot.crc24 == crc24 && slot.type == type) return slot.entry;
+        }
+    }
+};
+
+//! Explicit counters to verify cost of interface lookups, see 'IFramework::getInterfaceRegistryStats'
+struct InterfaceRegistryCounters
+{
+    std::atomic<uint64_t> fastLookups{};
+    std::atomic<uint64_t> slowLookups{};
+    std::atomic<uint64_t> snapshots{};
+};
 
 struct FrameworkContext
 {
@@ -65,10 +157,15 @@ struct FrameworkContext
     Version apiVersion = { NVIGI_CORESDK_API_VERSION_MAJOR, NVIGI_CORESDK_API_VERSION_MINOR, NVIGI_CORESDK_API_VERSION_PATCH };
     Version hostSDKVersion{};
     nvigi::system::SystemCaps caps{};
+    std::once_flag capsOnce;
     nvigi::framework::IFramework framework{};
     //! Always avoid static destruction hence these are on heap!
     ModulesMap modules{};
     InterfacesMap interfaces{};
+    std::atomic<const InterfaceTable*> interfaceTable{};
+    std::vector<const InterfaceTable*> retiredInterfaceTables{};
+    std::vector<std::unique_ptr<InterfaceEntry>> retiredInterfaceEntries{};
+    InterfaceRegistryCounters interfaceCounters{};
 
     std::string utf8PathToPlugins{}; // internal, set only if JSON override is used
     std::string utf8PathToDependencies{}; // provided by host
@@ -79,6 +176,70 @@ struct FrameworkContext
 
     PluginAndSystemInformation pluginSysInfo{};
 
+    //! Shared worker pool, created on first use since not all hosts/plugins need it
+    std::once_flag workerPoolOnce;
+    uint32_t numWorkerThreads{}; // 0 == one per logical core minus one
+    thread::WorkerPool* workerPool{};
+    thread::IWorkerPool iworkerPool{};
+
+    //! Evaluations running per priority class, shared with plugins via 'thread::IPriorityArbiter'
+    std::mutex priorityMtx;
+    std::condition_variable priorityCv;
+    std::atomic<uint32_t> priorityRunning[thread::kPriorityClassCount]{};
+    thread::IPriorityArbiter ipriorityArbiter{};
+
+    //! Plugin registration and unloading
+    //! 
+    //! Each plugin has its own latch so independent plugins register in parallel (host threads, background preloading).
+    //! Latches are recursive because plugins can request interfaces from other plugins (or themselves) while registering,
+    //! plugins requesting each other's interfaces while both are registering would deadlock hence dependencies must not form cycles.
+    //! 
+    //! Lock order is plugin latch(es), 'enumerateMtx', 'registryMtx'
+    std::map<nvigi::PluginID, std::unique_ptr<std::recursive_mutex>> pluginLatches{};
+    //! Serializes scanning of new plugin directories, guards 'pluginSpecs', 'nameToId' and the manifest cache after 'nvigiInit'
+    std::recursive_mutex enumerateMtx;
+    //! Guards 'modules', 'interfaces', 'pluginLatches' and interface table publishing, never held while calling into plugins
+    std::mutex registryMtx;
+
+#ifdef NVIGI_WINDOWS
+    //! Process wide state shared by concurrent loaders, see 'SharedPrivilegeDowngrade' and 'SharedDLLSearchPaths'
+    std::mutex privilegesMtx;
+    uint32_t privilegeDowngrades{};
+    std::mutex dllDirectoriesMtx;
+    std::map<std::wstring, std::pair<DLL_DIRECTORY_COOKIE, uint32_t>> dllDirectories{};
+#endif
+
+    //! Registration status reported via 'nvigiGetPluginReadiness', guarded by its own lock so queries never block on loading
+    std::mutex statusMtx;
+    std::condition_variable statusCv;
+    std::map<nvigi::PluginID, Result> pluginStatus{};
+    uint32_t numPendingPreloads{};
+
+    //! Idle unloading, see 'IdlePreferences'
+    //! 
+    //! 'idleMtx' is always acquired after plugin latch and guards evicted plugins too
+    uint32_t idleTimeoutMs{};
+    std::mutex idleMtx;
+    std::condition_variable idleCv;
+    std::map<nvigi::PluginID, std::chrono::steady_clock::time_point> idlePlugins{};
+    std::set<nvigi::PluginID> evictedPlugins{};
+    std::thread idleThread;
+    bool idleStop = false;
+
+    //! Plugin manifest cache, unchanged plugins are not loaded just to obtain their 'PluginInfo'
+    std::wstring manifestCachePath{}; // empty if disabled
+    json manifestCache = json::object();
+    bool manifestCacheDirty = false;
+
+    //! Persistent GPU pipeline and kernel cache, see 'IFramework::loadGpuCache'
+    std::wstring gpuCachePath{}; // empty if disabled
+
+    //! Per plugin allocation stats sampled into metrics and tracing, see 'IMemoryManager::getAllocationStats'
+    uint32_t memorySampleIntervalMs = 1000; // 0 == disabled
+    thread::WorkerThread* memorySampler{};
+    std::vector<uint64_t> memorySampleTotals{};
+    std::chrono::steady_clock::time_point memorySampleTime{};
+
     //! DLL validation
 #ifndef NVIGI_PRODUCTION
     std::map<std::string, fs::path> dependencies{};
@@ -91,26 +252,357 @@ FrameworkContext* ctx;
 std::string getPluginName(PluginID id)
 {
     if (id == core::framework::kId) return "nvigi.core.framework";
-    auto& [path, internals] = ctx->modules[id];
+    std::scoped_lock lock(ctx->registryMtx);
+    auto it = ctx->modules.find(id);
+    if (it == ctx->modules.end()) return "unknown";
+    auto& [path, internals] = it->second;
     return path.filename().replace_extension().string();
 }
 
+//! Serializes registration and unloading of a single plugin, see 'FrameworkContext::pluginLatches'
+//! 
+std::recursive_mutex& getPluginLatch(PluginID id)
+{
+    std::scoped_lock lock(ctx->registryMtx);
+    auto& latch = ctx->pluginLatches[id];
+    if (!latch) latch = std::make_unique<std::recursive_mutex>();
+    return *latch;
+}
+
+#ifdef NVIGI_WINDOWS
+//! Privileges are process wide, first of the concurrent loaders downgrades them and the last one restores them
+//! 
+struct SharedPrivilegeDowngrade
+{
+    SharedPrivilegeDowngrade()
+    {
+        std::scoped_lock lock(ctx->privilegesMtx);
+        if (ctx->privilegeDowngrades++ == 0) nvigi::system::getInterface()->downgradeKeyAdminPrivileges();
+    }
+    ~SharedPrivilegeDowngrade()
+    {
+        std::scoped_lock lock(ctx->privilegesMtx);
+        if (--ctx->privilegeDowngrades == 0) nvigi::system::getInterface()->restoreKeyAdminPrivileges();
+    }
+};
+
+//! Same as 'file::ScopedDLLSearchPathChange' but reference counted, a directory added by one loader
+//! must not disappear while another one is still loading DLLs from it
+//! 
+struct SharedDLLSearchPaths
+{
+    SharedDLLSearchPaths(const std::vector<std::wstring>& utf16Directories)
+    {
+        std::scoped_lock lock(ctx->dllDirectoriesMtx);
+        for (auto& directory : utf16Directories)
+        {
+            if (std::find(directories.begin(), directories.end(), directory) != directories.end()) continue;
+            auto& [cookie, count] = ctx->dllDirectories[directory];
+            if (count == 0)
+            {
+                //! Add our path to the search list
+                if (!(cookie = AddDllDirectory(directory.c_str())))
+                {
+                    NVIGI_LOG_WARN("AddDllDirectory failed with last error '%u' - if 3rd party DLLs are not next to the executable some plugins might fail to load!", GetLastError());
+                    ctx->dllDirectories.erase(directory);
+                    continue;
+                }
+                NVIGI_LOG_INFO("Looking for 3rd party dependencies in `%S`", directory.c_str());
+            }
+            count++;
+            directories.push_back(directory);
+        }
+    }
+    ~SharedDLLSearchPaths()
+    {
+        std::scoped_lock lock(ctx->dllDirectoriesMtx);
+        for (auto& directory : directories)
+        {
+            auto it = ctx->dllDirectories.find(directory);
+            auto& [cookie, count] = it->second;
+            if (--count == 0)
+            {
+                //! Remove our path from the search list
+                if (!RemoveDllDirectory(cookie))
+                {
+                    NVIGI_LOG_WARN("RemoveDllDirectory failed with last error '%u' - previous DLL directory not restored", GetLastError());
+                }
+                ctx->dllDirectories.erase(it);
+            }
+        }
+    }
+    SharedDLLSearchPaths(const SharedDLLSearchPaths&) = delete;
+    SharedDLLSearchPaths& operator=(const SharedDLLSearchPaths&) = delete;
+
+    std::vector<std::wstring> directories;
+};
+#endif
+
+//! Rebuilds and publishes interface lookup table, must be called after any change to 'ctx->interfaces'
+//! 
+//! Caller must hold 'registryMtx'
+//! 
+void publishInterfaceTable()
+{
+    size_t count = 0;
+    for (auto& [feature, list] : ctx->interfaces) count += list.size();
+    size_t capacity = 16;
+    while (capacity < count * 2) capacity <<= 1;
+
+    auto table = new InterfaceTable;
+    table->mask = capacity - 1;
+    table->slots.resize(capacity);
+    for (auto& [feature, list] : ctx->interfaces)
+    {
+        for (auto& entry : list)
+        {
+            auto i = InterfaceTable::hash(feature.crc24, entry->_interface->type) & table->mask;
+            while (table->slots[i].entry) i = (i + 1) & table->mask;
+            table->slots[i] = { feature.crc24, entry->_interface->type, entry.get() };
+        }
+    }
+    auto prev = ctx->interfaceTable.exchange(table, std::memory_order_acq_rel);
+    if (prev) ctx->retiredInterfaceTables.push_back(prev);
+    ctx->interfaceCounters.snapshots++;
+}
+
+//! Lock free lookup of an already registered interface
+//! 
+InterfaceEntry* findInterface(PluginID feature, const UID& type)
+{
+    auto table = ctx->interfaceTable.load(std::memory_order_acquire);
+    return table ? table->find(feature.crc24, type) : nullptr;
+}
+
+//! Snapshot of plugin's interface entries
+//! 
+//! Entries are only added or removed while holding plugin's latch and are never freed before shutdown (see 'retiredInterfaceEntries')
+//! 
+std::vector<InterfaceEntry*> getInterfaceEntries(PluginID feature)
+{
+    std::vector<InterfaceEntry*> entries;
+    std::scoped_lock lock(ctx->registryMtx);
+    auto it = ctx->interfaces.find(feature);
+    if (it != ctx->interfaces.end())
+    {
+        for (auto& entry : it->second) entries.push_back(entry.get());
+    }
+    return entries;
+}
+
+//! Claims all reference counted entries before unloading the plugin
+//! 
+//! Fails if someone took a reference since (slow path) or is taking one right now (lock free lookup)
+//! 
+bool claimInterfaceEntries(const std::vector<InterfaceEntry*>& entries)
+{
+    std::vector<InterfaceEntry*> claimed;
+    for (auto entry : entries)
+    {
+        if (entry->flags & nvigi::framework::InterfaceFlagNotRefCounted) continue;
+        int32_t expected = 0;
+        if (!entry->refCount.compare_exchange_strong(expected, kRefCountEvicting))
+        {
+            for (auto c : claimed) c->refCount -= kRefCountEvicting;
+            return false;
+        }
+        claimed.push_back(entry);
+    }
+    return true;
+}
+
+bool hasModule(PluginID feature)
+{
+    std::scoped_lock lock(ctx->registryMtx);
+    return ctx->modules.find(feature) != ctx->modules.end();
+}
+
+//! Records result of the last registration attempt, 'kResultNotReady' while pending
+//! 
+void setPluginStatus(PluginID feature, Result status)
+{
+    std::scoped_lock lock(ctx->statusMtx);
+    ctx->pluginStatus[feature] = status;
+}
+
+void clearPluginStatus(PluginID feature)
+{
+    std::scoped_lock lock(ctx->statusMtx);
+    ctx->pluginStatus.erase(feature);
+}
+
 //! Internal framework API
 //! 
 //! Add interface for a give feature
 //! 
 bool addInterface(PluginID feature, void* _interface, InterfaceFlags flags)
 {
-    auto& list = ctx->interfaces[feature];
-    for (auto& [refCount, i, flagsTmp] : list)
     {
-        if (i->type == ((const nvigi::BaseStructure*)_interface)->type) return false;
+        std::scoped_lock lock(ctx->registryMtx);
+        auto& list = ctx->interfaces[feature];
+        for (auto& entry : list)
+        {
+            if (entry->_interface->type == ((const nvigi::BaseStructure*)_interface)->type) return false;
+        }
+        auto entry = std::make_unique<InterfaceEntry>();
+        entry->_interface = (nvigi::BaseStructure*)_interface;
+        entry->flags = flags;
+        list.push_back(std::move(entry));
+        publishInterfaceTable();
     }
-    list.push_back({ 0, (nvigi::BaseStructure*)_interface, flags });
     NVIGI_LOG_VERBOSE("[%s] added interface '%s'", getPluginName(feature).c_str(), extra::guidToString(((const nvigi::BaseStructure*)_interface)->type).c_str());
     return true;
 }
 
+//! Internal framework API
+//! 
+//! Shared worker pool, shared with plugins via core::framework::kId interfaces
+//! 
+thread::WorkerPool* getWorkerPool()
+{
+    std::call_once(ctx->workerPoolOnce, []()->void
+    {
+        ctx->workerPool = new thread::WorkerPool(L"nvigi.pool", THREAD_PRIORITY_NORMAL, ctx->numWorkerThreads);
+        NVIGI_LOG_INFO("Created worker pool with %u threads", ctx->workerPool->getWorkerCount());
+    });
+    return ctx->workerPool;
+}
+
+//! Runs 'func(i)' for each i in [0, count) on the shared worker pool and waits for all of them
+//! 
+//! Calling thread takes items too so this is safe to call even when all workers are busy.
+//! 
+void parallelFor(size_t count, const std::function<void(size_t)>& func)
+{
+    if (count <= 1)
+    {
+        if (count) func(0);
+        return;
+    }
+    //! Shared since helpers can start after we return, at which point there is nothing left for them to do
+    struct State
+    {
+        std::atomic<size_t> next{};
+        std::atomic<size_t> done{};
+        size_t count{};
+        std::function<void(size_t)> func;
+        std::mutex mtx;
+        std::condition_variable cv;
+    };
+    auto state = std::make_shared<State>();
+    state->count = count;
+    state->func = func;
+    auto run = [state]()->void
+    {
+        size_t i;
+        while ((i = state->next.fetch_add(1)) < state->count)
+        {
+            state->func(i);
+            if (state->done.fetch_add(1) + 1 == state->count)
+            {
+                std::lock_guard<std::mutex> lock(state->mtx);
+                state->cv.notify_all();
+            }
+        }
+    };
+    auto pool = getWorkerPool();
+    auto numHelpers = std::min<size_t>(count - 1, pool->getWorkerCount());
+    for (size_t i = 0; i < numHelpers; i++)
+    {
+        pool->scheduleWork(std::function<void(void)>(run));
+    }
+    run();
+    std::unique_lock<std::mutex> lock(state->mtx);
+    state->cv.wait(lock, [&state]()->bool { return state->done.load() == state->count; });
+}
+
+bool workerPoolScheduleOwnedWork(const void* owner, thread::PFun_WorkerPoolJob* job, thread::PFun_WorkerPoolJob* retire, void* userData, thread::WorkerPoolFlags flags)
+{
+    if (!job) return false;
+    auto priority = (flags & thread::kWorkerPoolFlagHighPriority) ? thread::WorkPriority::eHigh : thread::WorkPriority::eNormal;
+    std::function<void(void)> onRetire{};
+    if (retire)
+    {
+        onRetire = [retire, userData]()->void { retire(userData); };
+    }
+    return getWorkerPool()->scheduleWork([job, userData]()->void { job(userData); }, flags & thread::kWorkerPoolFlagPerpetual, priority, std::move(onRetire), owner);
+}
+
+bool workerPoolScheduleWork(thread::PFun_WorkerPoolJob* job, thread::PFun_WorkerPoolJob* retire, void* userData, thread::WorkerPoolFlags flags)
+{
+    return workerPoolScheduleOwnedWork(nullptr, job, retire, userData, flags);
+}
+
+//! Pool is shared by all plugins, a flush only ever covers the caller's jobs
+Result workerPoolFlushOwner(const void* owner, uint32_t timeoutMs)
+{
+    return getWorkerPool()->flushOwner(owner, timeoutMs) == std::cv_status::timeout ? kResultTimedOut : kResultOk;
+}
+
+Result workerPoolFlush(uint32_t timeoutMs)
+{
+    return workerPoolFlushOwner(nullptr, timeoutMs);
+}
+
+size_t workerPoolGetJobCount()
+{
+    return getWorkerPool()->getJobCount();
+}
+
+uint32_t workerPoolGetWorkerCount()
+{
+    return getWorkerPool()->getWorkerCount();
+}
+
+bool priorityIsPreempted(uint32_t priorityClass)
+{
+    for (uint32_t i = 0; i < priorityClass; i++)
+    {
+        if (ctx->priorityRunning[i].load() > 0) return true;
+    }
+    return false;
+}
+
+bool priorityWait(uint32_t priorityClass, uint32_t timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(ctx->priorityMtx);
+    return thread::waitFor(ctx->priorityCv, lock, std::chrono::milliseconds(timeoutMs), [priorityClass]()->bool { return !priorityIsPreempted(priorityClass); });
+}
+
+Result priorityBeginEvaluation(uint32_t priorityClass, uint32_t timeoutMs)
+{
+    if (priorityClass >= thread::kPriorityClassCount) return kResultInvalidParameter;
+    bool ready = !priorityIsPreempted(priorityClass) || priorityWait(priorityClass, timeoutMs);
+    ctx->priorityRunning[priorityClass]++;
+    return ready ? kResultOk : kResultTimedOut;
+}
+
+void priorityEndEvaluation(uint32_t priorityClass)
+{
+    if (priorityClass >= thread::kPriorityClassCount) return;
+    if (--ctx->priorityRunning[priorityClass] == 0)
+    {
+        // Waiters check the counts under the lock so taking it here is enough to avoid a lost wake up
+        std::lock_guard<std::mutex> lock(ctx->priorityMtx);
+        ctx->priorityCv.notify_all();
+    }
+}
+
+Result priorityYield(uint32_t priorityClass, uint32_t timeoutMs)
+{
+    if (priorityClass >= thread::kPriorityClassCount) return kResultInvalidParameter;
+    // Called per token or similar, no lock unless we actually have to step aside
+    if (!priorityIsPreempted(priorityClass)) return kResultOk;
+    // Not running while parked so lower classes waiting on us are not held back either
+    priorityEndEvaluation(priorityClass);
+    return priorityBeginEvaluation(priorityClass, timeoutMs);
+}
+
+uint32_t priorityGetRunningCount(uint32_t priorityClass)
+{
+    return priorityClass < thread::kPriorityClassCount ? ctx->priorityRunning[priorityClass].load() : 0;
+}
+
 //! Internal framework API
 //! 
 //! Release reference of an interface for a given feature
@@ -138,7 +630,20 @@ void* getInterface(PluginID feature, const UID& type, uint32_t version, const ch
 //! 
 size_t getNumInterfaces(PluginID feature)
 {
-    return ctx->interfaces[feature].size();
+    std::scoped_lock lock(ctx->registryMtx);
+    auto it = ctx->interfaces.find(feature);
+    return it != ctx->interfaces.end() ? it->second.size() : 0;
+}
+
+//! Internal framework API
+//! 
+//! Returns interface lookup counters
+//! 
+void getInterfaceRegistryStats(uint64_t* fastLookups, uint64_t* slowLookups, uint64_t* snapshots)
+{
+    if (fastLookups) *fastLookups = ctx->interfaceCounters.fastLookups.load();
+    if (slowLookups) *slowLookups = ctx->interfaceCounters.slowLookups.load();
+    if (snapshots) *snapshots = ctx->interfaceCounters.snapshots.load();
 }
 
 //! Internal framework API
@@ -180,6 +685,7 @@ PluginID getPluginIdFromName(const char* _name)
     PluginID id{};
     std::string name(_name);
     if (name == "nvigi.core.framework") return core::framework::kId;
+    std::scoped_lock lock(ctx->registryMtx);
     for (auto& item : ctx->modules)
     {
         auto& [path, internals] = item.second;
@@ -192,6 +698,41 @@ PluginID getPluginIdFromName(const char* _name)
     return id;
 }
 
+//! Records live memory and allocation rate for each tag, runs on 'memorySampler' only
+//! 
+void sampleMemory()
+{
+    std::vector<memory::MemoryTagStats> stats(memory::kMaxMemoryTags);
+    auto count = std::min(memory::getInterface()->getAllocationStats(stats.data(), (uint32_t)stats.size()), memory::kMaxMemoryTags);
+
+    auto now = std::chrono::steady_clock::now();
+    auto seconds = std::chrono::duration<double>(now - ctx->memorySampleTime).count();
+    ctx->memorySampleTime = now;
+    ctx->memorySampleTotals.resize(memory::kMaxMemoryTags);
+
+    auto trace = trace::getInterface();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        auto& item = stats[i];
+        // First sample only establishes the baseline
+        uint64_t allocations = item.totalAllocations - ctx->memorySampleTotals[i];
+        uint64_t allocsPerSec = ctx->memorySampleTotals[i] && seconds > 0 ? uint64_t(allocations / seconds) : 0;
+        ctx->memorySampleTotals[i] = item.totalAllocations;
+
+        PluginID id = strcmp(item.name, "nvigi.core") == 0 ? core::framework::kId : getPluginIdFromName(item.name);
+        if (id != PluginID{})
+        {
+            if (auto histogram = metrics::getHistogram(id, "memory_live_kb")) histogram->record(item.liveBytes / 1024);
+            if (auto histogram = metrics::getHistogram(id, "memory_allocs_per_sec")) histogram->record(allocsPerSec);
+        }
+        if (trace::isEnabled(trace))
+        {
+            auto name = std::string("memory ") + item.name;
+            trace->counter(name.c_str(), id != PluginID{} ? &id : nullptr, int64_t(item.liveBytes));
+        }
+    }
+}
+
 //! Internal framework API
 //! 
 //! Returns path to dependencies, useful when plugins need to load shared libs dynamically
@@ -203,10 +744,218 @@ types::string getUTF8PathToDependencies()
 
 // -----------------------------------------------------------------------
 
+//! Blocks until adapter discovery started in 'nvigiInit' is done, only paths which need adapters call this
+void ensureSystemCaps()
+{
+    std::call_once(ctx->capsOnce, []()->void { nvigi::system::waitForSystemCaps(&ctx->caps); });
+}
+
+//! Persistent GPU cache
+//! 
+//! Layout is 'nvigi.gpu.cache/$plugin/$type/$vendor.$device.$architecture/$keyhash.bin', driver version is NOT part of
+//! the path so entries built by an older driver get overwritten rather than accumulating.
+//! 
+//! Each file starts with 'GpuCacheHeader' followed by the key and the blob. Any change to the layout
+//! or validation rules must bump 'kGpuCacheFormatVersion'.
+//! 
+constexpr uint32_t kGpuCacheMagic = 0x4347564e; // 'NVGC'
+constexpr uint32_t kGpuCacheFormatVersion = 1;
+
+struct GpuCacheHeader
+{
+    uint32_t magic{};
+    uint32_t formatVersion{};
+    uint32_t type{};
+    uint32_t version{};
+    uint32_t driverVersion[3]{};
+    uint32_t vendor{};
+    uint32_t deviceId{};
+    uint32_t architecture{};
+    uint32_t revision{};
+    uint32_t keySize{};
+    uint64_t dataSize{};
+    uint64_t dataHash{};
+};
+
+//! FNV-1a, stable across builds and processes unlike 'std::hash'
+uint64_t hashBytes(const void* data, size_t size)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    auto bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+GpuCacheHeader makeGpuCacheHeader(GpuCacheType type, uint32_t version, const system::Adapter* adapter)
+{
+    GpuCacheHeader header{};
+    header.magic = kGpuCacheMagic;
+    header.formatVersion = kGpuCacheFormatVersion;
+    header.type = (uint32_t)type;
+    header.version = version;
+    header.driverVersion[0] = ctx->caps.driverVersion.major;
+    header.driverVersion[1] = ctx->caps.driverVersion.minor;
+    header.driverVersion[2] = ctx->caps.driverVersion.build;
+    header.vendor = (uint32_t)adapter->vendor;
+    header.deviceId = adapter->deviceId;
+    header.architecture = adapter->architecture;
+    header.revision = adapter->revision;
+    return header;
+}
+
+const system::Adapter* findAdapter(const LUID& luid)
+{
+    ensureSystemCaps();
+    for (uint32_t i = 0; i < ctx->caps.adapterCount; i++)
+    {
+        auto adapter = ctx->caps.adapters[i];
+        if (adapter->id.LowPart == luid.LowPart && adapter->id.HighPart == luid.HighPart) return adapter;
+    }
+    return nullptr;
+}
+
+fs::path getGpuCacheDirectory(PluginID feature)
+{
+    return fs::path(ctx->gpuCachePath) / extra::utf8ToUtf16(getPluginName(feature).c_str());
+}
+
+Result getGpuCacheEntryPath(PluginID feature, GpuCacheType type, const system::Adapter* adapter, const char* key, fs::path& path)
+{
+    static const wchar_t* s_typeDirectories[] = { L"d3d12", L"cuda", L"vulkan" };
+    static_assert(std::size(s_typeDirectories) == (size_t)GpuCacheType::eCount);
+    if ((uint32_t)type >= (uint32_t)GpuCacheType::eCount || !key || !*key)
+    {
+        return kResultInvalidParameter;
+    }
+    wchar_t adapterDirectory[64]{};
+    swprintf(adapterDirectory, std::size(adapterDirectory), L"%04x.%04x.%x", (uint32_t)adapter->vendor, adapter->deviceId, adapter->architecture);
+    wchar_t fileName[32]{};
+    swprintf(fileName, std::size(fileName), L"%016llx.bin", (unsigned long long)hashBytes(key, strlen(key)));
+    path = getGpuCacheDirectory(feature) / s_typeDirectories[(uint32_t)type] / adapterDirectory / fileName;
+    return kResultOk;
+}
+
+//! Internal framework API
+//! 
+//! Loads GPU cache entry, stale entries are removed
+//! 
+Result loadGpuCache(PluginID feature, GpuCacheType type, const LUID& adapterLuid, const char* key, uint32_t version, types::vector<uint8_t>& blob)
+{
+    if (ctx->gpuCachePath.empty()) return kResultNoImplementation;
+    auto adapter = findAdapter(adapterLuid);
+    if (!adapter)
+    {
+        NVIGI_LOG_ERROR("GPU cache requested for an unknown adapter");
+        return kResultInvalidParameter;
+    }
+    fs::path path;
+    NVIGI_CHECK(getGpuCacheEntryPath(feature, type, adapter, key, path));
+
+    auto contents = file::read(path.wstring().c_str());
+    if (contents.empty()) return kResultItemNotFound;
+
+    const char* stale{};
+    bool collision = false;
+    GpuCacheHeader header{};
+    if (contents.size() < sizeof(header))
+    {
+        stale = "truncated";
+    }
+    else
+    {
+        memcpy(&header, contents.data(), sizeof(header));
+        auto expected = makeGpuCacheHeader(type, version, adapter);
+        auto payload = contents.data() + sizeof(header);
+        if (header.magic != expected.magic || header.formatVersion != expected.formatVersion || header.type != expected.type) stale = "cache format changed";
+        else if (header.version != expected.version) stale = "plugin version changed";
+        else if (memcmp(header.driverVersion, expected.driverVersion, sizeof(header.driverVersion))) stale = "driver changed";
+        else if (header.vendor != expected.vendor || header.deviceId != expected.deviceId || header.architecture != expected.architecture || header.revision != expected.revision) stale = "adapter changed";
+        else if (sizeof(header) + (uint64_t)header.keySize + header.dataSize != contents.size()) stale = "truncated";
+        else if (std::string_view((const char*)payload, header.keySize) != key) collision = true;
+        else if (hashBytes(payload + header.keySize, header.dataSize) != header.dataHash) stale = "corrupted";
+    }
+    if (collision)
+    {
+        // Another key of the same plugin hashed to this file, keep it and let the caller overwrite if needed
+        return kResultItemNotFound;
+    }
+    if (stale)
+    {
+        NVIGI_LOG_INFO("Dropping GPU cache entry '%s' for plugin [%s] - %s", key, getPluginName(feature).c_str(), stale);
+        std::error_code ec;
+        fs::remove(path, ec);
+        return kResultItemNotFound;
+    }
+    auto data = contents.data() + sizeof(header) + header.keySize;
+    blob = types::vector<uint8_t>(data, data + header.dataSize);
+    NVIGI_LOG_VERBOSE("Loaded GPU cache entry '%s' (%llu bytes) for plugin [%s]", key, (unsigned long long)header.dataSize, getPluginName(feature).c_str());
+    return kResultOk;
+}
+
+//! Internal framework API
+//! 
+//! Stores GPU cache entry, replaces any previous one with the same key
+//! 
+Result storeGpuCache(PluginID feature, GpuCacheType type, const LUID& adapterLuid, const char* key, uint32_t version, const void* data, size_t size)
+{
+    if (ctx->gpuCachePath.empty()) return kResultNoImplementation;
+    if (!data || !size) return kResultInvalidParameter;
+    auto adapter = findAdapter(adapterLuid);
+    if (!adapter)
+    {
+        NVIGI_LOG_ERROR("GPU cache requested for an unknown adapter");
+        return kResultInvalidParameter;
+    }
+    fs::path path;
+    NVIGI_CHECK(getGpuCacheEntryPath(feature, type, adapter, key, path));
+
+    auto header = makeGpuCacheHeader(type, version, adapter);
+    header.keySize = (uint32_t)strlen(key);
+    header.dataSize = size;
+    header.dataHash = hashBytes(data, size);
+    std::vector<uint8_t> contents(sizeof(header) + header.keySize + size);
+    memcpy(contents.data(), &header, sizeof(header));
+    memcpy(contents.data() + sizeof(header), key, header.keySize);
+    memcpy(contents.data() + sizeof(header) + header.keySize, data, size);
+
+    std::error_code ec;
+    fs::create_directories(path.parent_path(), ec);
+    // Write and rename so that concurrent writers and readers (other threads or processes) never see a partial file
+    auto tmpPath = path;
+    tmpPath += L"." + std::to_wstring(std::hash<std::thread::id>{}(std::this_thread::get_id())) + L".tmp";
+    file::write(tmpPath.wstring().c_str(), contents);
+    fs::rename(tmpPath, path, ec);
+    if (ec)
+    {
+        NVIGI_LOG_WARN("Failed to store GPU cache entry '%S' - %s", path.wstring().c_str(), ec.message().c_str());
+        fs::remove(tmpPath, ec);
+        return kResultIOError;
+    }
+    NVIGI_LOG_VERBOSE("Stored GPU cache entry '%s' (%llu bytes) for plugin [%s]", key, (unsigned long long)size, getPluginName(feature).c_str());
+    return kResultOk;
+}
+
+//! Internal framework API
+//! 
+//! Returns path to the plugin's GPU cache directory, created if needed
+//! 
+types::string getGpuCacheDirectoryForPlugin(PluginID feature)
+{
+    if (ctx->gpuCachePath.empty()) return "";
+    auto directory = getGpuCacheDirectory(feature);
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    return (const char*)directory.u8string().c_str();
+}
+
 //! Check minimum specs for a give plugin
 //! 
 Result checkPluginMinSpec(nvigi::plugin::PluginInfo* info, std::string& message)
 {
+    ensureSystemCaps();
     //! IMPORTANT: All messages here continue the sentence along the lines of "Plugin cannot be used due to ..."
     //! 
 #ifdef NVIGI_WINDOWS
@@ -339,12 +1088,204 @@ bool unloadPlugin(HMODULE hmod, const wchar_t* path)
     return true;
 }
 
+//! Plugin manifest cache
+//! 
+//! Stores 'PluginInfo' on disk, keyed by plugin path and identified by file size, modification time and
+//! signature hash so that unchanged plugins are not loaded (running DllMain and pulling in all dependencies)
+//! just to find out what they are. Min spec is always checked against the current system, never cached.
+//! 
+constexpr uint32_t kManifestCacheVersion = 1;
+
+json uidToJSON(const UID& uid)
+{
+    json j = json::array({ uid.data1, uid.data2, uid.data3 });
+    for (auto b : uid.data4) j.push_back(b);
+    return j;
+}
+
+UID uidFromJSON(const json& j)
+{
+    UID uid{};
+    uid.data1 = j.at(0).get<uint32_t>();
+    uid.data2 = j.at(1).get<uint16_t>();
+    uid.data3 = j.at(2).get<uint16_t>();
+    for (size_t i = 0; i < 8; i++) uid.data4[i] = j.at(3 + i).get<uint8_t>();
+    return uid;
+}
+
+json versionToJSON(const Version& v)
+{
+    return json::array({ v.major, v.minor, v.build });
+}
+
+Version versionFromJSON(const json& j)
+{
+    return { j.at(0).get<uint32_t>(), j.at(1).get<uint32_t>(), j.at(2).get<uint32_t>() };
+}
+
+//! Identifies the exact plugin binary, any change invalidates cached manifest
+bool getManifestIdentity(const fs::path& path, json& identity)
+{
+    std::error_code ec;
+    auto size = fs::file_size(path, ec);
+    if (ec) return false;
+    auto mtime = fs::last_write_time(path, ec);
+    if (ec) return false;
+    uint64_t signature{};
+#ifdef NVIGI_WINDOWS
+    if (!system::getModuleSignatureHash(path.wstring(), signature)) return false;
+#endif
+    identity = { {"size", size}, {"mtime", (int64_t)mtime.time_since_epoch().count()}, {"signature", signature} };
+    return true;
+}
+
+void loadManifestCache(const char* utf8PathToData)
+{
+    if (!utf8PathToData) return;
+    ctx->manifestCachePath = (fs::path(extra::utf8ToUtf16(utf8PathToData)) / L"nvigi.plugin.manifest.cache.json").wstring();
+    if (!file::exists(ctx->manifestCachePath.c_str())) return;
+    auto jsonText = file::read(ctx->manifestCachePath.c_str());
+    if (jsonText.empty()) return;
+    try
+    {
+        jsonText.push_back(0);
+        auto cache = json::parse((const char*)jsonText.data());
+        //! Plugins can adjust their info based on the framework they are given so drop everything on any API change
+        if (extra::getJSONValue(cache, "version", 0u) == kManifestCacheVersion &&
+            extra::getJSONValue(cache, "api", std::string()) == extra::toStr(ctx->apiVersion) &&
+            cache.contains("plugins") && cache["plugins"].is_object())
+        {
+            ctx->manifestCache = std::move(cache["plugins"]);
+            NVIGI_LOG_VERBOSE("Loaded %llu cached plugin manifest(s) from '%S'", (unsigned long long)ctx->manifestCache.size(), ctx->manifestCachePath.c_str());
+        }
+    }
+    catch (std::exception& e)
+    {
+        NVIGI_LOG_WARN("Ignoring invalid plugin manifest cache '%S' - %s", ctx->manifestCachePath.c_str(), e.what());
+    }
+}
+
+void saveManifestCache()
+{
+    if (ctx->manifestCachePath.empty() || !ctx->manifestCacheDirty) return;
+    ctx->manifestCacheDirty = false;
+    json cache = { {"version", kManifestCacheVersion}, {"api", extra::toStr(ctx->apiVersion)}, {"plugins", ctx->manifestCache} };
+    auto text = cache.dump(2);
+    // Write and rename so that concurrently starting processes never read a partial file
+    auto tmpPath = ctx->manifestCachePath + L".tmp";
+    file::write(tmpPath.c_str(), std::vector<uint8_t>(text.begin(), text.end()));
+    std::error_code ec;
+    fs::rename(tmpPath, ctx->manifestCachePath, ec);
+    if (ec)
+    {
+        NVIGI_LOG_WARN("Failed to store plugin manifest cache '%S' - %s", ctx->manifestCachePath.c_str(), ec.message().c_str());
+        fs::remove(tmpPath, ec);
+    }
+}
+
+void storeManifest(const std::string& key, const json& identity, const plugin::PluginInfo* info)
+{
+    if (ctx->manifestCachePath.empty() || identity.is_null()) return;
+    json interfaces = json::array();
+    for (auto& interf : info->interfaces)
+    {
+        interfaces.push_back({ {"uid", uidToJSON(interf.uid)}, {"version", interf.version} });
+    }
+    json entry = {
+        {"identity", identity},
+        {"infoVersion", info->getVersion()},
+        {"id", uidToJSON(info->id.id)},
+        {"crc24", info->id.crc24},
+        {"pluginVersion", versionToJSON(info->pluginVersion)},
+        {"pluginAPI", versionToJSON(info->pluginAPI)},
+        {"minOS", versionToJSON(info->minOS)},
+        {"minDriver", versionToJSON(info->minDriver)},
+        {"minGPUArch", info->minGPUArch},
+        {"requiredVendor", (uint32_t)info->requiredVendor},
+        {"description", info->description.c_str()},
+        {"author", info->author.c_str()},
+        {"build", info->build.c_str()},
+        {"interfaces", interfaces}
+    };
+    if (info->getVersion() >= 2)
+    {
+        entry["minSystemFlags"] = (uint64_t)info->minSystemFlags;
+    }
+    ctx->manifestCache[key] = entry;
+    ctx->manifestCacheDirty = true;
+}
+
+bool findManifest(const std::string& key, const json& identity, plugin::PluginInfo& info)
+{
+    if (identity.is_null() || !ctx->manifestCache.contains(key)) return false;
+    try
+    {
+        auto& entry = ctx->manifestCache[key];
+        if (entry.at("identity") != identity) return false;
+        //! Match the version the plugin reported so 'checkPluginMinSpec' reads exactly what the plugin provided
+        info._base.version = std::min(entry.at("infoVersion").get<uint32_t>(), info.getVersion());
+        info.id = { uidFromJSON(entry.at("id")), entry.at("crc24").get<uint32_t>() };
+        info.pluginVersion = versionFromJSON(entry.at("pluginVersion"));
+        info.pluginAPI = versionFromJSON(entry.at("pluginAPI"));
+        info.minOS = versionFromJSON(entry.at("minOS"));
+        info.minDriver = versionFromJSON(entry.at("minDriver"));
+        info.minGPUArch = entry.at("minGPUArch").get<uint32_t>();
+        info.requiredVendor = (VendorId)entry.at("requiredVendor").get<uint32_t>();
+        info.description = entry.at("description").get<std::string>().c_str();
+        info.author = entry.at("author").get<std::string>().c_str();
+        info.build = entry.at("build").get<std::string>().c_str();
+        for (auto& interf : entry.at("interfaces"))
+        {
+            info.interfaces.push_back({ uidFromJSON(interf.at("uid")), interf.at("version").get<uint32_t>() });
+        }
+        info.minSystemFlags = (SystemFlags)extra::getJSONValue(entry, "minSystemFlags", (uint64_t)0);
+    }
+    catch (std::exception& e)
+    {
+        NVIGI_LOG_WARN("Ignoring invalid cached manifest for '%s' - %s", key.c_str(), e.what());
+        ctx->manifestCache.erase(key);
+        return false;
+    }
+    return true;
+}
+
 //! Loads plugins and returns the count
 //! 
 //! Note that plugins are immediatelly unloaded and started on explicit interface request
 //! 
+//! Validation runs in parallel on the shared worker pool, only plugins without a valid cached manifest are loaded
+//! 
+//! Adds newly enumerated plugin, false if its id is already taken
+//! 
+bool addModule(nvigi::PluginID id, const fs::path& path)
+{
+    std::scoped_lock lock(ctx->registryMtx);
+    return ctx->modules.try_emplace(id, path, PluginInternals{}).second;
+}
+
+//! Startup cost of each plugin, reported by 'nvigi.tool.utils --profile-startup'
+//!
+//! Both enumeration and registration record validation, loading and 'getInfo' so counts tell the passes apart
+constexpr const char* kStartupScanUs = "startup_scan_us";
+constexpr const char* kStartupValidateUs = "startup_validate_us";
+constexpr const char* kStartupLoadLibraryUs = "startup_load_library_us";
+constexpr const char* kStartupGetInfoUs = "startup_get_info_us";
+constexpr const char* kStartupRegisterUs = "startup_register_us";
+
+uint64_t getElapsedUs(std::chrono::steady_clock::time_point start)
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void recordStartupTime(const nvigi::PluginID& feature, const char* name, uint64_t us)
+{
+    if (auto histogram = nvigi::metrics::getHistogram(feature, name)) histogram->record(us);
+}
+
 size_t enumeratePlugins(const char8_t* utf8Directory, bool validateDLLs, const nvigi::PluginID* requestedFeature = nullptr)
 {
+    NVIGI_TRACE_SCOPE("enumeratePlugins", requestedFeature);
+    auto scanStart = std::chrono::steady_clock::now();
     size_t numPluginsFound = 0;
     auto utf16Directory = extra::utf8ToUtf16((const char*)utf8Directory);
     NVIGI_LOG_INFO("Scanning directory '%s' for plugins ...", utf8Directory);
@@ -357,50 +1298,98 @@ size_t enumeratePlugins(const char8_t* utf8Directory, bool validateDLLs, const n
     {
         utf16DependeciesDirectories.push_back(extra::utf8ToUtf16(ctx->utf8PathToDependencies.c_str()));
     }
-    file::ScopedDLLSearchPathChange changeDLLPath(utf16DependeciesDirectories);
+    SharedDLLSearchPaths changeDLLPath(utf16DependeciesDirectories);
 #endif
+    struct Candidate
+    {
+        fs::path path;
+        std::u8string name;
+        PluginSpec* spec;
+        json identity{};
+        bool valid = true;
+        std::map<std::string, fs::path> dependencies{};
+        //! Plugin id is not known until 'getInfo' so timings are kept until then
+        uint64_t validateUs{};
+        uint64_t loadLibraryUs{};
+        uint64_t getInfoUs{};
+    };
+    std::vector<Candidate> candidates;
     for (auto const& entry : fs::directory_iterator{ utf8Directory })
     {
         auto ext = entry.path().extension().u8string();
         auto name = entry.path().filename().u8string();
-        auto dir = entry.path().parent_path().u8string();
 
         name = name.erase(name.find(ext));
 
         std::u8string dll = u8".dll";
         if (ext == dll && name.find(u8"nvigi.plugin.") == 0)
         {
-            unsigned long loadLibFlags = LOAD_LIBRARY_SEARCH_DEFAULT_DIRS;
             //! Prepare plugin specs to report back to the host
             auto tmp = new PluginSpec();
             ctx->pluginSpecs.push_back(tmp);
-            PluginSpec& spec = *tmp;
 
             //! Set name early in case we fail for whatever reason
             auto charArray = new char[entry.path().filename().string().length() + 1];
             std::strcpy(charArray, entry.path().filename().string().c_str());
-            spec.pluginName = charArray;
+            tmp->pluginName = charArray;
+
+            candidates.push_back({ entry.path(), name, tmp });
+        }
+    }
+    //! Directory scan is shared by all plugins in it so it is recorded against the framework
+    recordStartupTime(nvigi::core::framework::kId, kStartupScanUs, getElapsedUs(scanStart));
 
-            // Make sure all dependencies came from the expected locations, if not this is an error
+    //! Make sure all dependencies came from the expected locations, no plugins are loaded at this point
+    parallelFor(candidates.size(), [&](size_t i)->void
+    {
+        auto& candidate = candidates[i];
+        if (!ctx->manifestCachePath.empty() && !getManifestIdentity(candidate.path, candidate.identity))
+        {
+            candidate.identity = nullptr;
+        }
 #ifdef NVIGI_WINDOWS
-            std::map<std::string, fs::path> pluginDependencies{};
-            if (validateDLLs)
-            {
-                if (!system::validateDLL(entry.path().wstring().c_str(), utf16DependeciesDirectories, pluginDependencies))
-                {
-                    NVIGI_LOG_WARN("Skipping plugin '%s' due to validation errors", name.c_str());
-                    spec.status = kResultMissingDynamicLibraryDependency;
-                    continue;
-                }
-#ifndef NVIGI_PRODUCTION
-                ctx->dependencies.insert(pluginDependencies.begin(), pluginDependencies.end());
+        if (validateDLLs)
+        {
+            auto start = std::chrono::steady_clock::now();
+            candidate.valid = system::validateDLL(candidate.path.wstring().c_str(), utf16DependeciesDirectories, candidate.dependencies);
+            candidate.validateUs = getElapsedUs(start);
+        }
 #endif
-            }
+    });
+
+    for (auto& candidate : candidates)
+    {
+        auto& name = candidate.name;
+        auto& pluginDependencies = candidate.dependencies;
+        PluginSpec& spec = *candidate.spec;
+        if (!candidate.valid)
+        {
+            NVIGI_LOG_WARN("Skipping plugin '%s' due to validation errors", name.c_str());
+            spec.status = kResultMissingDynamicLibraryDependency;
+            continue;
+        }
+#if defined(NVIGI_WINDOWS) && !defined(NVIGI_PRODUCTION)
+        ctx->dependencies.insert(pluginDependencies.begin(), pluginDependencies.end());
 #endif
+        auto key = candidate.path.u8string();
+        std::string cacheKey(key.begin(), key.end());
+        HMODULE hmod{};
+        nvigi::plugin::PluginInfo cachedInfo{};
+        nvigi::plugin::PluginInfo* info{};
+        if (findManifest(cacheKey, candidate.identity, cachedInfo))
+        {
+            NVIGI_LOG_VERBOSE("Using cached manifest for plugin '%s'", name.c_str());
+            info = &cachedInfo;
+        }
+        else
+        {
+            unsigned long loadLibFlags = LOAD_LIBRARY_SEARCH_DEFAULT_DIRS;
             //! ANSI C Win32 API does not support utf-8 hence using wchar_t
             //! 
-            //! Also note that we must add flag to search for DLLs in user provided paths (see file::ScopedDLLSearchPathChange above)
-            HMODULE hmod = LoadLibraryExW(entry.path().wstring().c_str(), NULL, loadLibFlags);
+            //! Also note that we must add flag to search for DLLs in user provided paths (see SharedDLLSearchPaths above)
+            auto start = std::chrono::steady_clock::now();
+            hmod = LoadLibraryExW(candidate.path.wstring().c_str(), NULL, loadLibFlags);
+            candidate.loadLibraryUs = getElapsedUs(start);
             if (!hmod)
             {
 #ifdef NVIGI_WINDOWS
@@ -417,7 +1406,7 @@ size_t enumeratePlugins(const char8_t* utf8Directory, bool validateDLLs, const n
                 continue;
             }
             auto getInfo = (nvigi::plugin::PFun_PluginGetInfo*)getFunc("nvigiPluginGetInfo");
-            nvigi::plugin::PluginInfo* info{};
+            start = std::chrono::steady_clock::now();
             if (NVIGI_FAILED(error, getInfo(&nvigi::framework::ctx->framework, &info)))
             {
                 NVIGI_LOG_ERROR("'getInfo' failed for plugin %s - error: %s (0x%x) - %s", 
@@ -425,90 +1414,117 @@ size_t enumeratePlugins(const char8_t* utf8Directory, bool validateDLLs, const n
                 spec.status = error;
                 continue;
             }
-            if (requestedFeature && info->id != *requestedFeature)
-            {
-                //! If specific plugin is requested and this is not it just skip it.
-                //!
-                //! This is a NOP and below plugin just gets unloaded
-            }
-            //! NOTE: We intentionally do NOT reject plugins whose 'PluginInfo' is older than the framework's.
+            candidate.getInfoUs = getElapsedUs(start);
+            storeManifest(cacheKey, candidate.identity, info);
+        }
+        if (requestedFeature && info->id != *requestedFeature)
+        {
+            //! If specific plugin is requested and this is not it just skip it.
             //!
-            //! 'PluginInfo' is a versioned structure (see nvigi_struct.h) so older plugins simply report a lower
-            //! version and omit the newer trailing members. We preserve backwards compatibility by always
-            //! checking 'info->getVersion()' before reading any v2+ member (see 'checkPluginMinSpec') and never
-            //! touching functionality that requires info the plugin did not provide.
-            else if (ctx->modules.find(info->id) != ctx->modules.end())
+            //! This is a NOP and below plugin just gets unloaded
+        }
+        //! NOTE: We intentionally do NOT reject plugins whose 'PluginInfo' is older than the framework's.
+        //!
+        //! 'PluginInfo' is a versioned structure (see nvigi_struct.h) so older plugins simply report a lower
+        //! version and omit the newer trailing members. We preserve backwards compatibility by always
+        //! checking 'info->getVersion()' before reading any v2+ member (see 'checkPluginMinSpec') and never
+        //! touching functionality that requires info the plugin did not provide.
+        else if (!addModule(info->id, candidate.path))
+        {
+            NVIGI_LOG_ERROR("Plugin '%s' has duplicated feature uid: %s crc24: 0x%x - skipping ...", name.c_str(), extra::guidToString(info->id.id).c_str(), info->id.crc24);
+            spec.status = kResultDuplicatedPluginId;
+        }
+        else
+        {
+            if (candidate.validateUs) recordStartupTime(info->id, kStartupValidateUs, candidate.validateUs);
+            if (candidate.loadLibraryUs) recordStartupTime(info->id, kStartupLoadLibraryUs, candidate.loadLibraryUs);
+            if (candidate.getInfoUs) recordStartupTime(info->id, kStartupGetInfoUs, candidate.getInfoUs);
+
+            NVIGI_LOG_INFO("Found plugin '%s':", name.c_str());
+            NVIGI_LOG_INFO("# id: %s", extra::guidToString(info->id).c_str());
+            NVIGI_LOG_INFO("# crc24: 0x%x", info->id.crc24);
+            NVIGI_LOG_INFO("# description: '%s'", info->description.c_str());
+            NVIGI_LOG_INFO("# version: %s", extra::toStr(info->pluginVersion).c_str());
+            NVIGI_LOG_INFO("# build: %s", info->build.c_str());
+            NVIGI_LOG_INFO("# author: '%s'", info->author.c_str());
+            for (auto& interf : info->interfaces)
             {
-                NVIGI_LOG_ERROR("Plugin '%s' has duplicated feature uid: %s crc24: 0x%x - skipping ...", name.c_str(), extra::guidToString(info->id.id).c_str(), info->id.crc24);
-                spec.status = kResultDuplicatedPluginId;
+                NVIGI_LOG_INFO("# interface: {%s} v%u", extra::guidToString(interf.uid).c_str(), interf.version);
             }
-            else
-            {
-                ctx->modules[info->id] = { entry.path(), {} };
-                
-                NVIGI_LOG_INFO("Found plugin '%s':", name.c_str());
-                NVIGI_LOG_INFO("# id: %s", extra::guidToString(info->id).c_str());
-                NVIGI_LOG_INFO("# crc24: 0x%x", info->id.crc24);
-                NVIGI_LOG_INFO("# description: '%s'", info->description.c_str());
-                NVIGI_LOG_INFO("# version: %s", extra::toStr(info->pluginVersion).c_str());
-                NVIGI_LOG_INFO("# build: %s", info->build.c_str());
-                NVIGI_LOG_INFO("# author: '%s'", info->author.c_str());
-                for (auto& interf : info->interfaces)
-                {
-                    NVIGI_LOG_INFO("# interface: {%s} v%u", extra::guidToString(interf.uid).c_str(), interf.version);
-                }
 #ifdef NVIGI_WINDOWS
-                for (auto& [libName, libPath] : pluginDependencies)
-                {
-                    NVIGI_LOG_VERBOSE("# dependency '%s' found in '%S'", libName.c_str(), libPath.wstring().c_str());
-                }
+            for (auto& [libName, libPath] : pluginDependencies)
+            {
+                NVIGI_LOG_VERBOSE("# dependency '%s' found in '%S'", libName.c_str(), libPath.wstring().c_str());
+            }
 #endif
-                std::string msg;
-                //! Prepare info to report back if needed
-                //! 
-                //! NOTE: All dynamic allocations are deallocated on shutdown
-                spec.id = info->id;
-                spec.pluginAPI = info->pluginAPI;
-                spec.pluginVersion = info->pluginVersion;
-                spec.requiredOSVersion = info->minOS;
-                spec.requiredAdapterVendor = info->requiredVendor;
-                spec.requiredAdapterDriverVersion = info->minDriver;
-                spec.requiredAdapterArchitecture = info->minGPUArch;
-                spec.status = checkPluginMinSpec(info, msg);
-                if (spec.status != kResultOk)
-                {
-                    NVIGI_LOG_WARN("[%s] failed min spec check - Error: %s - %s - Details: %s", 
-                        name.c_str(), nvigi::resultToString(spec.status), 
-                        nvigi::resultToExplanation(spec.status), msg.c_str());
-                }
-                spec.numSupportedInterfaces = info->interfaces.size();
-                auto supportedInterfaces = new UID[spec.numSupportedInterfaces];
-                for (size_t k = 0; k < spec.numSupportedInterfaces; k++)
-                {
-                    supportedInterfaces[k] = info->interfaces[k].uid;
-                }
-                spec.supportedInterfaces = supportedInterfaces;
+            std::string msg;
+            //! Prepare info to report back if needed
+            //! 
+            //! NOTE: All dynamic allocations are deallocated on shutdown
+            spec.id = info->id;
+            spec.pluginAPI = info->pluginAPI;
+            spec.pluginVersion = info->pluginVersion;
+            spec.requiredOSVersion = info->minOS;
+            spec.requiredAdapterVendor = info->requiredVendor;
+            spec.requiredAdapterDriverVersion = info->minDriver;
+            spec.requiredAdapterArchitecture = info->minGPUArch;
+            spec.status = checkPluginMinSpec(info, msg);
+            if (spec.status != kResultOk)
+            {
+                NVIGI_LOG_WARN("[%s] failed min spec check - Error: %s - %s - Details: %s", 
+                    name.c_str(), nvigi::resultToString(spec.status), 
+                    nvigi::resultToExplanation(spec.status), msg.c_str());
+            }
+            spec.numSupportedInterfaces = info->interfaces.size();
+            auto supportedInterfaces = new UID[spec.numSupportedInterfaces];
+            for (size_t k = 0; k < spec.numSupportedInterfaces; k++)
+            {
+                supportedInterfaces[k] = info->interfaces[k].uid;
+            }
+            spec.supportedInterfaces = supportedInterfaces;
 #if !defined(NVIGI_PRODUCTION) && defined NVIGI_WINDOWS
-                ctx->nameToId[std::string(name.begin(), name.end())] = info->id;
+            ctx->nameToId[std::string(name.begin(), name.end())] = info->id;
 #endif
-                numPluginsFound++;
-            }
-            unloadPlugin(hmod, entry.path().wstring().c_str());
+            numPluginsFound++;
+        }
+        if (hmod)
+        {
+            unloadPlugin(hmod, candidate.path.wstring().c_str());
         }
     }
+    saveManifestCache();
+#ifdef NVIGI_WINDOWS
+#ifndef NVIGI_PRODUCTION
+    system::saveValidationCache();
+#endif
+    uint64_t validationHits{}, validationMisses{};
+    system::getValidationCacheStats(validationHits, validationMisses);
+    NVIGI_LOG_VERBOSE("DLL validation cache - hits %llu misses %llu", validationHits, validationMisses);
+#endif
     return numPluginsFound;
 }
 
+//! Loads and registers plugin, caller must hold its latch (see 'getPluginLatch')
+//! 
+//! Only the plugin's own latch is held while loading so independent plugins register in parallel
+//! 
 Result registerPlugin(nvigi::PluginID feature)
 {
-    if (ctx->modules.find(feature) == ctx->modules.end())
+    NVIGI_TRACE_SCOPE("registerPlugin", &feature);
+    fs::path path;
+    PluginInternals internals{};
     {
-        NVIGI_LOG_ERROR("Cannot register plugin - feature not found. Error: %s - %s", 
-            nvigi::resultToString(nvigi::kResultMissingInterface), 
-            nvigi::resultToExplanation(nvigi::kResultMissingInterface));
-        return nvigi::kResultMissingInterface;
+        std::scoped_lock lock(ctx->registryMtx);
+        auto it = ctx->modules.find(feature);
+        if (it == ctx->modules.end())
+        {
+            NVIGI_LOG_ERROR("Cannot register plugin - feature not found. Error: %s - %s", 
+                nvigi::resultToString(nvigi::kResultMissingInterface), 
+                nvigi::resultToExplanation(nvigi::kResultMissingInterface));
+            return nvigi::kResultMissingInterface;
+        }
+        std::tie(path, internals) = it->second;
     }
-    auto& [path, internals] = ctx->modules[feature];
 
     if (!internals.hmod)
     {
@@ -526,21 +1542,24 @@ Result registerPlugin(nvigi::PluginID feature)
         {
             utf16DependeciesDirectories.push_back(extra::utf8ToUtf16(ctx->utf8PathToDependencies.c_str()));
         }
-        file::ScopedDLLSearchPathChange changeDLLPath(utf16DependeciesDirectories);
+        SharedDLLSearchPaths changeDLLPath(utf16DependeciesDirectories);
 
         // Validate DLL 
         std::map<std::string, fs::path> pluginDependencies{};
+        auto validateStart = std::chrono::steady_clock::now();
         if (!system::validateDLL(path.wstring().c_str(), utf16DependeciesDirectories, pluginDependencies))
         {
             NVIGI_LOG_WARN("Skipping plugin '%s' due to validation errors", name.c_str());
             return nvigi::kResultMissingDynamicLibraryDependency;
         }
+        recordStartupTime(feature, kStartupValidateUs, getElapsedUs(validateStart));
 #endif
         // Load our plugin and try to start it
         unsigned long loadLibFlags = LOAD_LIBRARY_SEARCH_DEFAULT_DIRS;
         //! ANSI C Win32 API does not support utf-8 hence using wchar_t
         //! 
-        //! Also note that we must add flag to search for DLLs in user provided paths (see file::ScopedDLLSearchPathChange above)
+        //! Also note that we must add flag to search for DLLs in user provided paths (see SharedDLLSearchPaths above)
+        auto start = std::chrono::steady_clock::now();
         HMODULE hmod = LoadLibraryExW(path.wstring().c_str(), NULL, loadLibFlags);
         if (!hmod)
         {
@@ -567,14 +1586,17 @@ Result registerPlugin(nvigi::PluginID feature)
             NVIGI_LOG_ERROR("Failed to map internal API for plugin %S", path.wstring().c_str());
             return nvigi::kResultInvalidState;
         }
+        recordStartupTime(feature, kStartupLoadLibraryUs, getElapsedUs(start));
         // Get plugin info
         nvigi::plugin::PluginInfo* info{};
+        start = std::chrono::steady_clock::now();
         if (NVIGI_FAILED(error, getInfo(&nvigi::framework::ctx->framework, &info)))
         {
             NVIGI_LOG_ERROR("'getInfo' failed for plugin %S - error: %s (0x%x) - %s", 
                 path.wstring().c_str(), nvigi::resultToString(error), error, nvigi::resultToExplanation(error));
             return nvigi::kResultInvalidState;
         }
+        recordStartupTime(feature, kStartupGetInfoUs, getElapsedUs(start));
         //! Check min spec based on plugins' info
         //! 
         std::string msg;
@@ -588,6 +1610,7 @@ Result registerPlugin(nvigi::PluginID feature)
         }
         // Keep track of any existing interfaces and make sure plugin actually adds at least one
         size_t currentInterfaceCount = ctx->framework.getNumInterfaces(feature);
+        start = std::chrono::steady_clock::now();
         if (NVIGI_FAILED(error, pluginRegister(&ctx->framework)))
         {
             unloadPlugin(hmod, path.wstring().c_str());
@@ -595,6 +1618,7 @@ Result registerPlugin(nvigi::PluginID feature)
                 path.wstring().c_str(), nvigi::resultToString(error), error, nvigi::resultToExplanation(error));
             return nvigi::kResultInvalidState;
         }
+        recordStartupTime(feature, kStartupRegisterUs, getElapsedUs(start));
         if (currentInterfaceCount >= ctx->framework.getNumInterfaces(feature))
         {
             unloadPlugin(hmod, path.wstring().c_str());
@@ -603,6 +1627,7 @@ Result registerPlugin(nvigi::PluginID feature)
         }
         internals.hmod = hmod;
         internals.pluginDeregister = pluginDeregister;
+        std::scoped_lock lock(ctx->registryMtx);
         ctx->modules[feature] = { path, internals };
     }
     return kResultOk;
@@ -632,9 +1657,27 @@ nvigi::Result nvigiInitImpl(const nvigi::Preferences& pref, nvigi::PluginAndSyst
     // Always validate DLLs when enumerating plugins (but NOT when registering them for use later on)
     bool validateDLLs = true;
 
+    bool usePooledMemoryAllocator = (pref.flags & nvigi::PreferenceFlags::eEnablePooledMemoryAllocator) != 0;
+    bool useAsyncLogging = (pref.flags & nvigi::PreferenceFlags::eEnableAsyncLogging) != 0;
+    bool useManifestCache = true;
+    bool useGpuCache = true;
+
     nvigi::VendorId forceAdapterId = nvigi::VendorId::eAny;
     uint32_t forceArchitecture = 0;
 
+    // Tracing is optional, chained to the preferences by the host
+    auto tracePref = nvigi::findStruct<nvigi::TracePreferences>(pref);
+    auto traceBackends = tracePref ? tracePref->backends : nvigi::TraceBackendFlags::eNone;
+    std::string traceFile = tracePref && tracePref->utf8PathToTraceFile ? tracePref->utf8PathToTraceFile : "";
+    uint32_t traceMaxEvents = tracePref ? tracePref->maxBufferedEvents : nvigi::TracePreferences{}.maxBufferedEvents;
+
+    auto idlePref = nvigi::findStruct<nvigi::IdlePreferences>(pref);
+    ctx->idleTimeoutMs = idlePref ? idlePref->idleTimeoutMs : 0;
+
+    // Batched structured log delivery is optional, it always runs on the async logging thread
+    auto logBatchPref = nvigi::findStruct<nvigi::LogBatchPreferences>(pref);
+    if (logBatchPref && !logBatchPref->callback) logBatchPref = nullptr;
+
     // Setup logging
     auto log = nvigi::log::getInterface();
     log->enableConsole(pref.showConsole);
@@ -717,6 +1760,16 @@ nvigi::Result nvigiInitImpl(const nvigi::Preferences& pref, nvigi::PluginAndSyst
                 nvigi::file::getOSValidDirectoryPath(ctx->utf8PathToDependencies.c_str(), ctx->utf8PathToDependencies);
 
                 validateDLLs = nvigi::extra::getJSONValue(config, "validateDLLs", validateDLLs);
+                ctx->numWorkerThreads = nvigi::extra::getJSONValue(config, "numWorkerThreads", ctx->numWorkerThreads);
+                ctx->idleTimeoutMs = nvigi::extra::getJSONValue(config, "idleTimeoutMs", ctx->idleTimeoutMs);
+                ctx->memorySampleIntervalMs = nvigi::extra::getJSONValue(config, "memorySampleIntervalMs", ctx->memorySampleIntervalMs);
+                usePooledMemoryAllocator = nvigi::extra::getJSONValue(config, "pooledMemoryAllocator", usePooledMemoryAllocator);
+                useAsyncLogging = nvigi::extra::getJSONValue(config, "asyncLogging", useAsyncLogging);
+                useManifestCache = nvigi::extra::getJSONValue(config, "pluginManifestCache", useManifestCache);
+                useGpuCache = nvigi::extra::getJSONValue(config, "gpuCache", useGpuCache);
+                traceBackends = (nvigi::TraceBackendFlags)nvigi::extra::getJSONValue(config, "traceBackends", (uint32_t)traceBackends);
+                traceFile = nvigi::extra::getJSONValue(config, "traceFile", traceFile);
+                log->enableBinaryLogRecords(nvigi::extra::getJSONValue(config, "binaryLogRecords", false));
                 std::string forceAdapterStr = nvigi::extra::getJSONValue(config, "forceAdapter", std::string("0")); // "0" == eAny
                 std::string forceArchitectureStr = nvigi::extra::getJSONValue(config, "forceArchitecture", std::string("0"));
 
@@ -737,6 +1790,19 @@ nvigi::Result nvigiInitImpl(const nvigi::Preferences& pref, nvigi::PluginAndSyst
         // We already printed an error on console since logging setup failed
         return res;
     }
+    log->enableAsyncLogging(useAsyncLogging || logBatchPref);
+    if (logBatchPref)
+    {
+        log->setLogBatchCallback((void*)logBatchPref->callback, logBatchPref->userData, logBatchPref->intervalMs);
+    }
+
+    // Default trace file goes next to the log
+    if (traceFile.empty() && (traceBackends & nvigi::TraceBackendFlags::eChromeJSON) && pref.utf8PathToLogsAndData)
+    {
+        traceFile = (fs::path((const char8_t*)pref.utf8PathToLogsAndData) / "nvigi.trace.json").string();
+    }
+    nvigi::trace::initialize(traceBackends, traceFile.c_str(), traceMaxEvents);
+    NVIGI_TRACE_SCOPE("nvigiInit");
 
     NVIGI_LOG_INFO("Starting 'nvigi.core.framework':");
     NVIGI_LOG_INFO("# time-stamp: %s", __TIMESTAMP__);
@@ -750,7 +1816,7 @@ nvigi::Result nvigiInitImpl(const nvigi::Preferences& pref, nvigi::PluginAndSyst
 
 #ifdef NVIGI_WINDOWS
     //! If process is running with elevated privileges we downgrade them for security reasons
-    nvigi::system::ScopedDowngradePrivileges guardPrivileges;
+    SharedPrivilegeDowngrade guardPrivileges;
 
     std::string miniDumpDirectory;
     if (nvigi::extra::getEnvVar("NVIGI_OVERRIDE_DUMP_PATH", miniDumpDirectory))
@@ -790,11 +1856,33 @@ nvigi::Result nvigiInitImpl(const nvigi::Preferences& pref, nvigi::PluginAndSyst
         // At this point 'ctx->utf8PathToDependencies' is absolute, normalized and "long" if over MAX_PATH on Win11 and it points to a valid directory
     }
 
+    // Must be selected before sharing memory manager with plugins, blocks from either allocator can be released by both
+    nvigi::memory::setPooledAllocator(usePooledMemoryAllocator);
+
     // Share internal interface for logging, memory management and exception handling
     addInterface(nvigi::core::framework::kId, log, nvigi::framework::InterfaceFlagNotRefCounted);
     addInterface(nvigi::core::framework::kId, nvigi::memory::getInterface(), nvigi::framework::InterfaceFlagNotRefCounted);
     addInterface(nvigi::core::framework::kId, nvigi::exception::getInterface(), nvigi::framework::InterfaceFlagNotRefCounted);
     addInterface(nvigi::core::framework::kId, nvigi::system::getInterface(), nvigi::framework::InterfaceFlagNotRefCounted);
+    addInterface(nvigi::core::framework::kId, nvigi::trace::getInterface(), nvigi::framework::InterfaceFlagNotRefCounted);
+    addInterface(nvigi::core::framework::kId, nvigi::metrics::getInterface(), nvigi::framework::InterfaceFlagNotRefCounted);
+    addInterface(nvigi::core::framework::kId, nvigi::resources::getInterface(), nvigi::framework::InterfaceFlagNotRefCounted);
+
+    // Shared worker pool, threads are not created until first used
+    ctx->iworkerPool.scheduleWork = workerPoolScheduleWork;
+    ctx->iworkerPool.flush = workerPoolFlush;
+    ctx->iworkerPool.getJobCount = workerPoolGetJobCount;
+    ctx->iworkerPool.getWorkerCount = workerPoolGetWorkerCount;
+    ctx->iworkerPool.scheduleOwnedWork = workerPoolScheduleOwnedWork;
+    ctx->iworkerPool.flushOwner = workerPoolFlushOwner;
+    addInterface(nvigi::core::framework::kId, &ctx->iworkerPool, nvigi::framework::InterfaceFlagNotRefCounted);
+
+    // Cross plugin priority classes, see 'InferencePriorityClass'
+    ctx->ipriorityArbiter.beginEvaluation = priorityBeginEvaluation;
+    ctx->ipriorityArbiter.endEvaluation = priorityEndEvaluation;
+    ctx->ipriorityArbiter.yield = priorityYield;
+    ctx->ipriorityArbiter.getRunningCount = priorityGetRunningCount;
+    addInterface(nvigi::core::framework::kId, &ctx->ipriorityArbiter, nvigi::framework::InterfaceFlagNotRefCounted);
 
     // Setup internal framework interface - shared via core API with each plugin
     ctx->framework.addInterface = addInterface;
@@ -804,18 +1892,53 @@ nvigi::Result nvigiInitImpl(const nvigi::Preferences& pref, nvigi::PluginAndSyst
     ctx->framework.getModelDirectoryForPlugin = getModelDirectoryForPlugin;
     ctx->framework.getPluginIdFromName = getPluginIdFromName;
     ctx->framework.getUTF8PathToDependencies = getUTF8PathToDependencies;
-
-    // Get system info
-    nvigi::system::getSystemCaps(forceAdapterId, forceArchitecture, &ctx->caps);
+    ctx->framework.getInterfaceRegistryStats = getInterfaceRegistryStats;
+    ctx->framework.loadGpuCache = loadGpuCache;
+    ctx->framework.storeGpuCache = storeGpuCache;
+    ctx->framework.getGpuCacheDirectoryForPlugin = getGpuCacheDirectoryForPlugin;
 
     // Get OS version and update timer resolution
     nvigi::system::getOSVersionAndUpdateTimerResolution(&ctx->caps);
 
-    if(!(pref.flags & nvigi::PreferenceFlags::eDisableCPUTimerResolutionChange))
+    // Adapters are discovered in parallel with plugin enumeration, see 'ensureSystemCaps'
+    nvigi::system::beginSystemCapsDiscovery(forceAdapterId, forceArchitecture, ctx->caps.osVersion);
+
+    // Kernels are selected once, plugins are loaded later so they always see the final dispatch table
+    nvigi::simd::initialize(nvigi::system::getCpuFlags());
+    addInterface(nvigi::core::framework::kId, nvigi::simd::getInterface(), nvigi::framework::InterfaceFlagNotRefCounted);
+
+    // Opt-in only, our own timed waits use high resolution waitable timers (see nvigi.thread/timer.h)
+    if((pref.flags & nvigi::PreferenceFlags::eEnableCPUTimerResolutionChange) && !(pref.flags & nvigi::PreferenceFlags::eDisableCPUTimerResolutionChange))
     {
         // Update timer resolution
         nvigi::system::setTimerResolution();
-    }    
+    }
+
+    // Cached plugin manifests are stored next to the logs, no caching if host does not want us to write anything
+    if (useManifestCache)
+    {
+        loadManifestCache(pref.utf8PathToLogsAndData);
+#if defined(NVIGI_WINDOWS) && !defined(NVIGI_PRODUCTION)
+        if (pref.utf8PathToLogsAndData)
+        {
+            auto validationCachePath = fs::path(nvigi::extra::utf8ToUtf16(pref.utf8PathToLogsAndData)) / L"nvigi.dll.validation.cache.json";
+            nvigi::system::loadValidationCache(validationCachePath.wstring().c_str());
+        }
+#endif
+    }
+
+    if (ctx->memorySampleIntervalMs)
+    {
+        ctx->memorySampleTime = std::chrono::steady_clock::now();
+        ctx->memorySampler = new nvigi::thread::WorkerThread(L"nvigi.memory.sampler", THREAD_PRIORITY_LOWEST);
+        ctx->memorySampler->scheduleEvery(std::chrono::milliseconds(ctx->memorySampleIntervalMs), sampleMemory);
+    }
+
+    // GPU pipelines and kernels are cached next to the logs as well
+    if (useGpuCache && pref.utf8PathToLogsAndData)
+    {
+        ctx->gpuCachePath = (fs::path(nvigi::extra::utf8ToUtf16(pref.utf8PathToLogsAndData)) / L"nvigi.gpu.cache").wstring();
+    }
 
     // Check if JSON was used to override path provided by the host
 #ifndef NVIGI_PRODUCTION
@@ -898,6 +2021,7 @@ nvigi::Result nvigiInitImpl(const nvigi::Preferences& pref, nvigi::PluginAndSyst
      //! Check if requested and report back info to the host
     if (pluginInfo)
     {
+        ensureSystemCaps();
         *pluginInfo = &ctx->pluginSysInfo;
         auto info = *pluginInfo;
         for (uint32_t i = 0; i < ctx->caps.adapterCount; i++)
@@ -928,7 +2052,9 @@ nvigi::Result nvigiInitImpl(const nvigi::Preferences& pref, nvigi::PluginAndSyst
             continue;
         }
         auto id = ctx->nameToId[name];
-        NVIGI_CHECK(registerPlugin(id));
+        auto status = registerPlugin(id);
+        setPluginStatus(id, status);
+        NVIGI_CHECK(status);
     }
 #endif
     return nvigi::kResultOk;
@@ -944,12 +2070,34 @@ nvigi::Result nvigiShutdownImpl()
         return nvigi::kResultInvalidState;
     }
 
+    // Preloading runs on the worker pool and touches everything below
+    {
+        std::unique_lock lock(ctx->statusMtx);
+        ctx->statusCv.wait(lock, []()->bool { return ctx->numPendingPreloads == 0; });
+    }
+
+    // Idle plugins which were not evicted yet are released below like any other
+    {
+        std::scoped_lock lock(ctx->idleMtx);
+        ctx->idleStop = true;
+        ctx->idleCv.notify_all();
+    }
+    if (ctx->idleThread.joinable())
+    {
+        ctx->idleThread.join();
+    }
+
+    // Sampler resolves plugin names so it must stop before modules go away
+    delete ctx->memorySampler;
+    ctx->memorySampler = nullptr;
+
 #ifdef NVIGI_WINDOWS
     //! If process is running with elevated privileges we downgrade them for security reasons
-    nvigi::system::ScopedDowngradePrivileges guardPrivileges;
+    SharedPrivilegeDowngrade guardPrivileges;
 #endif
 
-    // Release adapters
+    // Release adapters, discovery might still be running if nothing needed the caps so far
+    ensureSystemCaps();
     nvigi::system::cleanup(&ctx->caps);
 
     nvigi::Result result = nvigi::kResultOk;
@@ -960,7 +2108,7 @@ nvigi::Result nvigiShutdownImpl()
         auto& list = ctx->interfaces[item.first];
         for (auto it = list.begin(); it != list.end(); it++)
         {
-            auto& [refCount, i, flags] = (*it);
+            auto& [refCount, i, flags] = **it;
             bool counted = !(flags & nvigi::framework::InterfaceFlagNotRefCounted);
             if (counted && refCount > 0)
             {
@@ -974,10 +2122,19 @@ nvigi::Result nvigiShutdownImpl()
         {
             NVIGI_LOG_INFO("Shutting down plugin '%S'", path.wstring().c_str());
             NVIGI_VALIDATE(internals.pluginDeregister());
-            if (!unloadPlugin(internals.hmod, path.wstring().c_str()))
-            {
-                result = nvigi::kResultInvalidState;
-            }
+        }
+    }
+
+    // Pending jobs and their retire callbacks can live in any plugin so pool must go away before unloading DLLs
+    delete ctx->workerPool;
+    ctx->workerPool = nullptr;
+
+    for (auto& item : ctx->modules)
+    {
+        auto& [path, internals] = item.second;
+        if (internals.hmod && !unloadPlugin(internals.hmod, path.wstring().c_str()))
+        {
+            result = nvigi::kResultInvalidState;
         }
     }
     ctx->modules.clear();
@@ -994,6 +2151,21 @@ nvigi::Result nvigiShutdownImpl()
         delete item;
     }
 
+    uint64_t fastLookups{}, slowLookups{}, snapshots{};
+    getInterfaceRegistryStats(&fastLookups, &slowLookups, &snapshots);
+    NVIGI_LOG_VERBOSE("Interface registry - fast lookups %llu slow lookups %llu snapshots %llu", fastLookups, slowLookups, snapshots);
+
+    delete ctx->interfaceTable.load();
+    for (auto table : ctx->retiredInterfaceTables)
+    {
+        delete table;
+    }
+
+    // All plugins are gone, no more spans can be opened
+    nvigi::trace::shutdown();
+    nvigi::metrics::shutdown();
+    nvigi::resources::shutdown();
+
     nvigi::log::destroyInterface();
     nvigi::exception::destroyInterface();
 
@@ -1008,6 +2180,7 @@ nvigi::Result nvigiShutdownImpl()
 
 nvigi::Result nvigiLoadInterfaceImpl(nvigi::PluginID feature, const nvigi::UID& type, uint32_t /*version*/, void** _interface, const char* utf8PathToPlugin)
 {
+    NVIGI_TRACE_SCOPE("nvigiLoadInterface", &feature);
     if (!_interface)
     {
         NVIGI_LOG_ERROR("Interface pointer is null. Error: %s - %s", 
@@ -1023,17 +2196,46 @@ nvigi::Result nvigiLoadInterfaceImpl(nvigi::PluginID feature, const nvigi::UID&
         return nvigi::kResultInvalidState;
     }
 
+    //! Fast path, plugin already registered and provides this interface
+    //! 
+    //! Not checking version here, it is OK to provide older interface. Interface consumer must check the version if accessing v2+ members
+    if (auto entry = findInterface(feature, type))
+    {
+        bool counted = !(entry->flags & nvigi::framework::InterfaceFlagNotRefCounted);
+        //! Unreferenced idle plugin stays loaded until the idle unloader claims it (see 'claimInterfaceEntries') so it
+        //! can be referenced again here. Otherwise a zero count means the plugin can be unloading right now and negative
+        //! means it is being evicted, in both cases the slow path below waits for it and registers the plugin again
+        const int32_t minRefCount = ctx->idleTimeoutMs ? 0 : 1;
+        auto refCount = counted ? entry->refCount.load() : minRefCount;
+        while (refCount >= minRefCount && !entry->refCount.compare_exchange_weak(refCount, refCount + 1)) {}
+        if (!counted || refCount >= minRefCount)
+        {
+            if (counted)
+            {
+                NVIGI_LOG_VERBOSE("Tracking interface '%s' (refCount %d) from plugin [%s]", nvigi::extra::guidToString(type).c_str(), refCount + 1, getPluginName(feature).c_str());
+            }
+            //! No need to log untracked internal interface usage like IMemory, ISystem, ILog etc. - it clogs the logs and can be confusing
+            *_interface = entry->_interface;
+            ctx->interfaceCounters.fastLookups++;
+            return nvigi::kResultOk;
+        }
+    }
+    ctx->interfaceCounters.slowLookups++;
+
+    //! Concurrent requests for the same plugin wait here for the first one to register it, other plugins are not blocked
+    std::scoped_lock pluginLock(getPluginLatch(feature));
+
 #ifdef NVIGI_WINDOWS
     //! If process is running with elevated privileges we downgrade them for security reasons
-    nvigi::system::ScopedDowngradePrivileges guardPrivileges;
+    SharedPrivilegeDowngrade guardPrivileges;
 #endif
 
-    auto& list = ctx->interfaces[feature];
+    auto entries = getInterfaceEntries(feature);
 
-    if (list.empty())
+    if (entries.empty())
     {
         // No interfaces for this feature, check if we never saw this plugin before and user provided new path to find it
-        if (ctx->modules.find(feature) == ctx->modules.end() && utf8PathToPlugin) try
+        if (!hasModule(feature) && utf8PathToPlugin) try
         {
             std::string utf8Path;
             // On Win this can alter the path to handle long paths (over MAX_PATH) and convert symlinks, relative paths to absolute etc.
@@ -1045,6 +2247,7 @@ nvigi::Result nvigiLoadInterfaceImpl(nvigi::PluginID feature, const nvigi::UID&
             }
             // At this point path is absolute, normalized and "long" if over MAX_PATH on Win11 and it points to a valid directory
             auto path = fs::path(utf8Path);
+            std::scoped_lock enumerateLock(ctx->enumerateMtx);
             if (!enumeratePlugins(path.u8string().c_str(), true, &feature))
             {
                 NVIGI_LOG_WARN("No new plugins found or loaded from the provided path '%S' when requesting interface {%s}", path.wstring().c_str(), nvigi::extra::guidToString(type).c_str());
@@ -1063,11 +2266,27 @@ nvigi::Result nvigiLoadInterfaceImpl(nvigi::PluginID feature, const nvigi::UID&
             return nvigi::kResultInvalidParameter;
         }
 
-        NVIGI_CHECK(registerPlugin(feature));
+        auto start = std::chrono::steady_clock::now();
+        auto status = registerPlugin(feature);
+        setPluginStatus(feature, status);
+        bool evicted = false;
+        {
+            std::scoped_lock lock(ctx->idleMtx);
+            evicted = ctx->evictedPlugins.erase(feature) != 0;
+        }
+        if (evicted && status == nvigi::kResultOk)
+        {
+            auto us = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+            if (auto histogram = nvigi::metrics::getHistogram(feature, "idle_reload_us")) histogram->record(us);
+            NVIGI_LOG_INFO("Reloaded idle plugin [%s] in %.2fms", getPluginName(feature).c_str(), us / 1000.0);
+        }
+        NVIGI_CHECK(status);
+        entries = getInterfaceEntries(feature);
     }
 
-    for (auto& [refCount, i, flags] : list)
+    for (auto entry : entries)
     {
+        auto& [refCount, i, flags] = *entry;
         //! Not checking version here, it is OK to provide older interface
         //!
         //! Interface consumer must check the version if accessing v2+ members
@@ -1075,8 +2294,8 @@ nvigi::Result nvigiLoadInterfaceImpl(nvigi::PluginID feature, const nvigi::UID&
         {
             if (!(flags & nvigi::framework::InterfaceFlagNotRefCounted))
             {
-                refCount++;
-                NVIGI_LOG_VERBOSE("Tracking interface '%s' (refCount %d) from plugin [%s]", nvigi::extra::guidToString(i->type).c_str(), refCount, getPluginName(feature).c_str());
+                auto count = ++refCount;
+                NVIGI_LOG_VERBOSE("Tracking interface '%s' (refCount %d) from plugin [%s]", nvigi::extra::guidToString(i->type).c_str(), count, getPluginName(feature).c_str());
             }
             //! No need to log untracked internal interface usage like IMemory, ISystem, ILog etc. - it clogs the logs and can be confusing
             *_interface = i;
@@ -1095,8 +2314,132 @@ nvigi::Result nvigiLoadInterfaceImpl(nvigi::PluginID feature, const nvigi::UID&
     return nvigi::kResultOk;
 }
 
+//! Deregisters and unloads plugin, caller must hold its latch
+//! 
+nvigi::Result shutdownPlugin(nvigi::PluginID feature)
+{
+    auto result = nvigi::kResultOk;
+    fs::path path;
+    PluginInternals internals{};
+    {
+        std::scoped_lock lock(ctx->registryMtx);
+        auto it = ctx->modules.find(feature);
+        if (it != ctx->modules.end()) std::tie(path, internals) = it->second;
+    }
+    if (internals.hmod)
+    {
+        NVIGI_LOG_INFO("Shutting down plugin '%S'", path.wstring().c_str());
+        NVIGI_VALIDATE(internals.pluginDeregister());
+        if (!unloadPlugin(internals.hmod, path.wstring().c_str()))
+        {
+            // unloadPlugin logs the appropriate error so no need to do anything here other than return an error
+            result = nvigi::kResultInvalidState;
+        }
+        internals.hmod = nullptr;
+        internals.pluginDeregister = nullptr;
+        std::scoped_lock lock(ctx->registryMtx);
+        ctx->modules[feature] = { path, internals };
+    }
+    clearPluginStatus(feature);
+    std::scoped_lock lock(ctx->registryMtx);
+    // Lookups can still be using the current snapshot, entries are released on shutdown
+    auto it = ctx->interfaces.find(feature);
+    if (it != ctx->interfaces.end())
+    {
+        for (auto& entry : it->second)
+        {
+            ctx->retiredInterfaceEntries.push_back(std::move(entry));
+        }
+        ctx->interfaces.erase(it);
+    }
+    publishInterfaceTable();
+    return result;
+}
+
+//! Evicts plugin if it is still idle after its deadline
+//! 
+void evictIdlePlugin(nvigi::PluginID feature)
+{
+    std::scoped_lock pluginLock(getPluginLatch(feature));
+    {
+        std::scoped_lock lock(ctx->idleMtx);
+        auto it = ctx->idlePlugins.find(feature);
+        // Released again meanwhile and got a new deadline
+        if (it == ctx->idlePlugins.end() || it->second > std::chrono::steady_clock::now()) return;
+        ctx->idlePlugins.erase(it);
+    }
+
+    auto entries = getInterfaceEntries(feature);
+    if (entries.empty()) return;
+    if (!claimInterfaceEntries(entries))
+    {
+        NVIGI_LOG_VERBOSE("Plugin [%s] is no longer idle", getPluginName(feature).c_str());
+        return;
+    }
+
+#ifdef NVIGI_WINDOWS
+    //! If process is running with elevated privileges we downgrade them for security reasons
+    SharedPrivilegeDowngrade guardPrivileges;
+#endif
+
+    auto start = std::chrono::steady_clock::now();
+    auto name = getPluginName(feature);
+    shutdownPlugin(feature);
+    {
+        std::scoped_lock lock(ctx->idleMtx);
+        ctx->evictedPlugins.insert(feature);
+    }
+    auto us = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    if (auto histogram = nvigi::metrics::getHistogram(feature, "idle_evict_us")) histogram->record(us);
+    NVIGI_LOG_INFO("Evicted idle plugin [%s] in %.2fms", name.c_str(), us / 1000.0);
+}
+
+void idleUnloadThread()
+{
+    std::unique_lock lock(ctx->idleMtx);
+    while (!ctx->idleStop)
+    {
+        auto now = std::chrono::steady_clock::now();
+        auto next = std::chrono::steady_clock::time_point::max();
+        std::vector<nvigi::PluginID> expired;
+        for (auto& [feature, deadline] : ctx->idlePlugins)
+        {
+            if (deadline <= now) expired.push_back(feature);
+            else next = std::min(next, deadline);
+        }
+        if (expired.empty())
+        {
+            if (next == std::chrono::steady_clock::time_point::max()) ctx->idleCv.wait(lock);
+            else ctx->idleCv.wait_until(lock, next);
+            continue;
+        }
+        // Lock order is plugin latch first
+        lock.unlock();
+        for (auto& feature : expired)
+        {
+            evictIdlePlugin(feature);
+        }
+        lock.lock();
+    }
+}
+
+//! Keeps plugin loaded for 'idleTimeoutMs', caller must hold plugin's latch
+//! 
+void scheduleIdleUnload(nvigi::PluginID feature)
+{
+    std::scoped_lock lock(ctx->idleMtx);
+    ctx->idlePlugins[feature] = std::chrono::steady_clock::now() + std::chrono::milliseconds(ctx->idleTimeoutMs);
+    if (!ctx->idleThread.joinable())
+    {
+        ctx->idleThread = std::thread(idleUnloadThread);
+    }
+    ctx->idleCv.notify_one();
+    NVIGI_LOG_VERBOSE("Plugin [%s] is idle, unloading in %ums unless used again", getPluginName(feature).c_str(), ctx->idleTimeoutMs);
+}
+
 nvigi::Result nvigiUnloadInterfaceImpl(nvigi::PluginID feature, const nvigi::UID& type)
 {
+    NVIGI_TRACE_SCOPE("nvigiUnloadInterface", &feature);
     if (!ctx)
     {
         NVIGI_LOG_ERROR("Framework not initialized. Error: %s - %s", 
@@ -1105,21 +2448,23 @@ nvigi::Result nvigiUnloadInterfaceImpl(nvigi::PluginID feature, const nvigi::UID
         return nvigi::kResultInvalidState;
     }
 
+    std::scoped_lock pluginLock(getPluginLatch(feature));
+
 #ifdef NVIGI_WINDOWS
     //! If process is running with elevated privileges we downgrade them for security reasons
-    nvigi::system::ScopedDowngradePrivileges guardPrivileges;
+    SharedPrivilegeDowngrade guardPrivileges;
 #endif
 
-    auto& list = ctx->interfaces[feature];
+    auto entries = getInterfaceEntries(feature);
 
     // We start with the assumption that we will NOT find this interface
     auto result = nvigi::kResultInvalidParameter;
 
     bool deletedInterface = false;
     bool remainingInterfaces = false;
-    for (auto it = list.begin(); it != list.end(); it++)
+    for (auto entry : entries)
     {
-        auto& [refCount, i, flags] = (*it);
+        auto& [refCount, i, flags] = *entry;
         bool counted = !(flags & nvigi::framework::InterfaceFlagNotRefCounted);
         if (type == i->type)
         {
@@ -1127,16 +2472,16 @@ nvigi::Result nvigiUnloadInterfaceImpl(nvigi::PluginID feature, const nvigi::UID
             result = nvigi::kResultOk;
             if (counted)
             {
-                refCount--;
-                assert(refCount >= 0);
-                if (refCount <= 0)
+                auto count = --refCount;
+                assert(count >= 0);
+                if (count <= 0)
                 {
-                    NVIGI_LOG_VERBOSE("[%s] unloading interface '%s' (with refCount %d)", getPluginName(feature).c_str(), nvigi::extra::guidToString(i->type).c_str(), refCount);
+                    NVIGI_LOG_VERBOSE("[%s] unloading interface '%s' (with refCount %d)", getPluginName(feature).c_str(), nvigi::extra::guidToString(i->type).c_str(), count);
                     deletedInterface = true;
                 }
                 else
                 {
-                    NVIGI_LOG_VERBOSE("[%s] removed ref to interface '%s' (with refCount %d)", getPluginName(feature).c_str(), nvigi::extra::guidToString(i->type).c_str(), refCount);
+                    NVIGI_LOG_VERBOSE("[%s] removed ref to interface '%s' (with refCount %d)", getPluginName(feature).c_str(), nvigi::extra::guidToString(i->type).c_str(), count);
                 }
             }
         }
@@ -1149,27 +2494,28 @@ nvigi::Result nvigiUnloadInterfaceImpl(nvigi::PluginID feature, const nvigi::UID
 
     if (deletedInterface && !remainingInterfaces)
     {
-        if (ctx->modules.find(feature) == ctx->modules.end())
+        if (!hasModule(feature))
         {
             NVIGI_LOG_ERROR("Cannot unload plugin - feature not found. Error: %s - %s", 
                 nvigi::resultToString(nvigi::kResultMissingInterface), 
                 nvigi::resultToExplanation(nvigi::kResultMissingInterface));
             return nvigi::kResultMissingInterface;
         }
-        auto& [path, internals] = ctx->modules[feature];
-        if (internals.hmod)
+        if (ctx->idleTimeoutMs)
         {
-            NVIGI_LOG_INFO("Shutting down plugin '%S'", path.wstring().c_str());
-            NVIGI_VALIDATE(internals.pluginDeregister());
-            if (!unloadPlugin(internals.hmod, path.wstring().c_str()))
-            {
-                // unloadPlugin logs the appropriate error so no need to do anything here other than return an error
-                result = nvigi::kResultInvalidState;
-            }
-            internals.hmod = nullptr;
-            internals.pluginDeregister = nullptr;
+            scheduleIdleUnload(feature);
+            return result;
+        }
+        // Lock free lookup can hand out a new reference until entries are claimed
+        if (!claimInterfaceEntries(entries))
+        {
+            NVIGI_LOG_VERBOSE("Plugin [%s] was requested again, not unloading", getPluginName(feature).c_str());
+            return result;
+        }
+        if (shutdownPlugin(feature) != nvigi::kResultOk)
+        {
+            result = nvigi::kResultInvalidState;
         }
-        ctx->interfaces.erase(feature);
     }
     else if (result != nvigi::kResultOk)
     {
@@ -1178,6 +2524,95 @@ nvigi::Result nvigiUnloadInterfaceImpl(nvigi::PluginID feature, const nvigi::UID
     return result;
 }
 
+//! Registers plugin on the calling thread, used by background preloading
+//! 
+nvigi::Result preloadPluginImpl(nvigi::PluginID feature)
+{
+    std::scoped_lock pluginLock(getPluginLatch(feature));
+
+#ifdef NVIGI_WINDOWS
+    //! If process is running with elevated privileges we downgrade them for security reasons
+    SharedPrivilegeDowngrade guardPrivileges;
+#endif
+
+    if (!getInterfaceEntries(feature).empty())
+    {
+        // Already registered, nothing to do
+        return nvigi::kResultOk;
+    }
+    auto result = registerPlugin(feature);
+    if (result == nvigi::kResultOk)
+    {
+        NVIGI_LOG_INFO("Preloaded plugin [%s]", getPluginName(feature).c_str());
+    }
+    return result;
+}
+
+nvigi::Result nvigiPreloadInterfacesAsyncImpl(const nvigi::PluginID* features, uint32_t count, PFun_nvigiPreloadCallback* callback, void* userData)
+{
+    if (!ctx)
+    {
+        NVIGI_LOG_ERROR("Framework not initialized. Error: %s - %s", 
+            nvigi::resultToString(nvigi::kResultInvalidState), 
+            nvigi::resultToExplanation(nvigi::kResultInvalidState));
+        return nvigi::kResultInvalidState;
+    }
+    if (!features && count)
+    {
+        NVIGI_LOG_ERROR("Features pointer is null. Error: %s - %s", 
+            nvigi::resultToString(nvigi::kResultInvalidParameter), 
+            nvigi::resultToExplanation(nvigi::kResultInvalidParameter));
+        return nvigi::kResultInvalidParameter;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        auto feature = features[i];
+        {
+            std::scoped_lock lock(ctx->statusMtx);
+            auto it = ctx->pluginStatus.find(feature);
+            // Keep status of plugins which are already registered, they are reported back via callback right away
+            if (it == ctx->pluginStatus.end() || it->second != nvigi::kResultOk)
+            {
+                ctx->pluginStatus[feature] = nvigi::kResultNotReady;
+            }
+            ctx->numPendingPreloads++;
+        }
+        //! Independent plugins register in parallel on the worker pool (see 'pluginLatches'), host gets notified as soon as each one is ready
+        //! 
+        //! NOTE: Unknown features are reported back via callback, validating here would block on the loader
+        getWorkerPool()->scheduleWork([feature, callback, userData]()->void
+        {
+            auto result = preloadPlugin(feature);
+            setPluginStatus(feature, result);
+            if (callback)
+            {
+                callback(feature, result, userData);
+            }
+            // Notify under the lock, shutdown can delete the context as soon as it observes zero pending preloads
+            std::scoped_lock lock(ctx->statusMtx);
+            ctx->numPendingPreloads--;
+            ctx->statusCv.notify_all();
+        });
+    }
+    return nvigi::kResultOk;
+}
+
+nvigi::Result nvigiGetPluginReadinessImpl(nvigi::PluginID feature)
+{
+    if (!ctx)
+    {
+        return nvigi::kResultInvalidState;
+    }
+    std::scoped_lock lock(ctx->statusMtx);
+    auto it = ctx->pluginStatus.find(feature);
+    return it != ctx->pluginStatus.end() ? it->second : nvigi::kResultItemNotFound;
+}
+
+nvigi::Result preloadPlugin(nvigi::PluginID feature)
+{
+    NVIGI_CATCH_EXCEPTION(preloadPluginImpl(feature));
+}
+
 nvigi::Result nvigiInit(const nvigi::Preferences& pref, nvigi::PluginAndSystemInformation** pluginInfo, uint64_t sdkVersion)
 {
     NVIGI_CATCH_EXCEPTION(nvigiInitImpl(pref, pluginInfo, sdkVersion));
@@ -1199,3 +2634,13 @@ nvigi::Result nvigiUnloadInterface(nvigi::PluginID feature, void* _interface)
         return nvigi::kResultMissingInterface;
     NVIGI_CATCH_EXCEPTION(nvigiUnloadInterfaceImpl(feature, ((nvigi::BaseStructure*)_interface)->type));
 }
+
+nvigi::Result nvigiPreloadInterfacesAsync(const nvigi::PluginID* features, uint32_t count, PFun_nvigiPreloadCallback* callback, void* userData)
+{
+    NVIGI_CATCH_EXCEPTION(nvigiPreloadInterfacesAsyncImpl(features, count, callback, userData));
+}
+
+nvigi::Result nvigiGetPluginReadiness(nvigi::PluginID feature)
+{
+    NVIGI_CATCH_EXCEPTION(nvigiGetPluginReadinessImpl(feature));
+}
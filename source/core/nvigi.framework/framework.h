@@ -26,12 +26,24 @@ using InterfaceFlags = uint32_t;
 constexpr InterfaceFlags InterfaceFlagNone = 0x0;
 constexpr InterfaceFlags InterfaceFlagNotRefCounted = 0x01;
 
+//! Kinds of persistent GPU cache entries, see 'IFramework::loadGpuCache'
+enum class GpuCacheType : uint32_t
+{
+    //! Blob from 'ID3D12PipelineLibrary::Serialize', reopened with 'ID3D12Device1::CreatePipelineLibrary'
+    eD3D12PipelineLibrary,
+    //! Cubin or fatbin from 'cuLinkComplete' or 'nvrtcGetCUBIN', loaded with 'cuModuleLoadData' without going through the PTX JIT
+    eCUDAModule,
+    //! Data from 'vkGetPipelineCacheData', passed back via 'VkPipelineCacheCreateInfo::pInitialData'
+    eVulkanPipelineCache,
+    eCount
+};
+
 //! Internal interface
 //! 
 //! {0F688505-89E4-45FF-84E8-D08380592BD0}
 struct alignas(8) IFramework {
     IFramework() {};
-    NVIGI_UID(UID({ 0xf688505, 0x89e4, 0x45ff,{ 0x84, 0xe8, 0xd0, 0x83, 0x80, 0x59, 0x2b, 0xd0 } }), kStructVersion1)
+    NVIGI_UID(UID({ 0xf688505, 0x89e4, 0x45ff,{ 0x84, 0xe8, 0xd0, 0x83, 0x80, 0x59, 0x2b, 0xd0 } }), kStructVersion3)
     bool (*addInterface)(PluginID feature, void* _interface, InterfaceFlags flags);
     void* (*getInterface)(PluginID feature, const UID& type, uint32_t version, const char* utf8PathToPlugins);
     bool (*releaseInterface)(PluginID feature, const UID& type);
@@ -39,6 +51,30 @@ struct alignas(8) IFramework {
     types::string(*getModelDirectoryForPlugin)(PluginID feature);
     types::string(*getUTF8PathToDependencies)();
     PluginID(*getPluginIdFromName)(const char* _name);
+
+    //! v2
+    //! 
+    //! Number of lookups served from the lock free registry, lookups which had to take the slow path (loading a plugin or
+    //! missing interface) and registry snapshots published so far. Any parameter can be null.
+    void (*getInterfaceRegistryStats)(uint64_t* fastLookups, uint64_t* slowLookups, uint64_t* snapshots);
+
+    //! v3
+    //! 
+    //! Persistent GPU pipeline and kernel cache, stored in "nvigi.gpu.cache" under 'Preferences::utf8PathToLogsAndData'
+    //! 
+    //! Entries are keyed by plugin, type, adapter (LUID as reported by D3D12, CUDA or Vulkan) and a plugin defined 'key'
+    //! (e.g. model name and precision). Driver version, adapter architecture and device id, cache format and plugin provided
+    //! 'version' are validated on load so blobs produced by a different driver or older plugin are dropped instead of being
+    //! handed to the runtime. Plugins bump 'version' whenever kernels or pipeline state change in a way the runtime cannot detect.
+    //! 
+    //! 'loadGpuCache' returns kResultItemNotFound on a miss or invalidated entry, both return kResultNoImplementation if
+    //! caching is disabled (no data path provided by the host). All methods are thread safe.
+    Result (*loadGpuCache)(PluginID feature, GpuCacheType type, const LUID& adapter, const char* key, uint32_t version, types::vector<uint8_t>& blob);
+    Result (*storeGpuCache)(PluginID feature, GpuCacheType type, const LUID& adapter, const char* key, uint32_t version, const void* data, size_t size);
+    //! UTF-8 path to the plugin's cache directory for runtimes which manage files on their own, empty if caching is disabled
+    types::string(*getGpuCacheDirectoryForPlugin)(PluginID feature);
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
 };
 
 NVIGI_VALIDATE_STRUCT(IFramework)
@@ -4,11 +4,18 @@
 
 #include <iomanip>
 #include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <vector>
+#include <deque>
 
 #include "source/core/nvigi.api/nvigi.h"
 #include "source/core/nvigi.log/log.h"
 #include "source/core/nvigi.extra/extra.h"
 #include "source/core/nvigi.file/file.h"
+#include "source/core/nvigi.thread/timer.h"
 
 namespace nvigi
 {
@@ -152,6 +159,492 @@ std::string generateHeader(const char* fl, int l, const char* fn, int t, const c
     return oss.str();
 }
 
+//! Same format as generateHeader but without any allocations, used on the hot path
+//! 
+//! Returns number of characters written (excluding null terminator) or negative value on error
+int formatHeader(char* buffer, size_t size, std::chrono::system_clock::time_point now, const char* fl, int l, const char* fn, int t, const char* customTag)
+{
+    static const char* prefix[] = { "info","warn","error" };
+    static_assert(countof(prefix) == (size_t)LogType::eCount);
+
+    auto nowAsTimeT = std::chrono::system_clock::to_time_t(now);
+    auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
+    std::tm nowTm{};
+#ifdef NVIGI_WINDOWS
+    localtime_s(&nowTm, &nowAsTimeT);
+#else
+    localtime_r(&nowAsTimeT, &nowTm);
+#endif
+    char dateTime[32];
+    strftime(dateTime, sizeof(dateTime), "%Y-%m-%d %H:%M:%S", &nowTm);
+
+    // file is constexpr so always valid
+    auto f = strrchr(fl, '\\');
+    f = f ? f + 1 : fl;
+
+    if (customTag)
+    {
+        return snprintf(buffer, size, "[%s.%03d][nvigi][%s][%s][%s:%d][%s]", dateTime, (int)nowMs.count(), prefix[t], customTag, f, l, fn);
+    }
+    return snprintf(buffer, size, "[%s.%03d][nvigi][%s][%s:%d][%s]", dateTime, (int)nowMs.count(), prefix[t], f, l, fn);
+}
+
+//! Header in front of each message stored in a LogRing
+struct LogRecordHeader
+{
+    uint32_t size;
+    uint8_t type;
+    uint8_t color;
+    uint16_t flags;
+};
+
+//! Record contains arguments to format instead of text, see serializeBinaryRecord
+constexpr uint16_t kLogRecordFlagBinary = 0x1;
+//! Record contains formatted message plus its metadata for batch delivery, see structured::serialize
+constexpr uint16_t kLogRecordFlagStructured = 0x2;
+
+//! Binary log records
+//! 
+//! Layout: [int64 time][int32 line][str file][str function][str tag][str format][args...]
+//! where 'str' is uint32 size (kNullString for nullptr) followed by bytes. Strings are copied
+//! rather than referenced since they can live in a plugin which is unloaded before the record is consumed.
+namespace binary
+{
+
+constexpr uint32_t kNullString = 0xffffffff;
+
+enum class Length : uint8_t
+{
+    eDefault,
+    eLong,
+    eLongLong,
+    eSize,
+    eLongDouble
+};
+
+struct FormatSpec
+{
+    const char* begin; // points to '%'
+    size_t size; // including conversion character
+    const char* flagsAndWidth; // everything after '%' up to the length modifier
+    size_t flagsAndWidthSize;
+    int stars; // '*' used for width and/or precision, each consumes an int argument
+    int precision; // -1 if not specified
+    bool precisionStar; // precision comes from the last '*' argument
+    Length length;
+    char conversion; // 0 if format is malformed
+};
+
+//! Finds next format specifier, copies literal text in front of it (if 'literal' is provided)
+inline bool nextSpec(const char*& p, FormatSpec& spec, std::string* literal)
+{
+    auto start = p;
+    while (*p && *p != '%') p++;
+    if (literal) literal->append(start, p - start);
+    if (!*p) return false;
+
+    spec = {};
+    spec.precision = -1;
+    spec.begin = p++;
+    spec.flagsAndWidth = p;
+    while (*p && strchr("-+ #0", *p)) p++;
+    if (*p == '*') { spec.stars++; p++; }
+    else while (*p >= '0' && *p <= '9') p++;
+    if (*p == '.')
+    {
+        p++;
+        if (*p == '*') { spec.stars++; spec.precisionStar = true; p++; }
+        else
+        {
+            spec.precision = 0;
+            while (*p >= '0' && *p <= '9') spec.precision = spec.precision * 10 + (*p++ - '0');
+        }
+    }
+    spec.flagsAndWidthSize = p - spec.flagsAndWidth;
+
+    if (p[0] == 'h') { p += (p[1] == 'h') ? 2 : 1; }
+    else if (p[0] == 'l' && p[1] == 'l') { spec.length = Length::eLongLong; p += 2; }
+    else if (p[0] == 'l') { spec.length = Length::eLong; p++; }
+    else if (p[0] == 'j' || p[0] == 'q') { spec.length = Length::eLongLong; p++; }
+    else if (p[0] == 'z' || p[0] == 't') { spec.length = Length::eSize; p++; }
+    else if (p[0] == 'L') { spec.length = Length::eLongDouble; p++; }
+    else if (p[0] == 'I' && p[1] == '6' && p[2] == '4') { spec.length = Length::eLongLong; p += 3; }
+    else if (p[0] == 'I' && p[1] == '3' && p[2] == '2') { p += 3; }
+    else if (p[0] == 'I') { spec.length = Length::eSize; p++; }
+
+    spec.conversion = *p;
+    if (*p) p++;
+    spec.size = p - spec.begin;
+    return true;
+}
+
+inline void write(std::string& out, const void* data, size_t size)
+{
+    out.append((const char*)data, size);
+}
+
+template<typename T>
+inline void write(std::string& out, T value)
+{
+    write(out, &value, sizeof(T));
+}
+
+inline void writeString(std::string& out, const void* str, size_t size)
+{
+    if (!str)
+    {
+        write(out, kNullString);
+        return;
+    }
+    write(out, (uint32_t)size);
+    write(out, str, size);
+}
+
+inline void writeString(std::string& out, const char* str)
+{
+    writeString(out, str, str ? strlen(str) : 0);
+}
+
+//! Returns false if format contains something we cannot safely defer
+inline bool serialize(std::string& out, std::chrono::system_clock::time_point time, const char* file, int line, const char* func, const char* tag, const char* fmt, va_list args)
+{
+    out.clear();
+    write(out, (int64_t)time.time_since_epoch().count());
+    write(out, (int32_t)line);
+    // Only file name is used in the header
+    auto f = strrchr(file, '\\');
+    writeString(out, f ? f + 1 : file);
+    writeString(out, func);
+    writeString(out, tag);
+    writeString(out, fmt);
+
+    const char* p = fmt;
+    FormatSpec spec{};
+    while (nextSpec(p, spec, nullptr))
+    {
+        for (int i = 0; i < spec.stars; i++)
+        {
+            auto value = va_arg(args, int);
+            // Negative precision is treated as if it was omitted
+            if (spec.precisionStar && i == spec.stars - 1) spec.precision = value < 0 ? -1 : value;
+            write(out, (int64_t)value);
+        }
+        switch (spec.conversion)
+        {
+            case 'd': case 'i':
+                if (spec.length == Length::eLongLong) write(out, (int64_t)va_arg(args, long long));
+                else if (spec.length == Length::eLong) write(out, (int64_t)va_arg(args, long));
+                else if (spec.length == Length::eSize) write(out, (int64_t)va_arg(args, ptrdiff_t));
+                else write(out, (int64_t)va_arg(args, int));
+                break;
+            case 'u': case 'o': case 'x': case 'X':
+                if (spec.length == Length::eLongLong) write(out, (uint64_t)va_arg(args, unsigned long long));
+                else if (spec.length == Length::eLong) write(out, (uint64_t)va_arg(args, unsigned long));
+                else if (spec.length == Length::eSize) write(out, (uint64_t)va_arg(args, size_t));
+                else write(out, (uint64_t)va_arg(args, unsigned int));
+                break;
+            case 'c': case 'C':
+                write(out, (int64_t)va_arg(args, int));
+                break;
+            case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+                if (spec.length == Length::eLongDouble) write(out, (double)va_arg(args, long double));
+                else write(out, va_arg(args, double));
+                break;
+            case 's': case 'S':
+                if (spec.conversion == 'S' || spec.length == Length::eLong)
+                {
+                    // With precision the argument does not have to be null terminated, never read past it
+                    auto str = va_arg(args, const wchar_t*);
+                    auto length = !str ? 0 : (spec.precision >= 0 ? wcsnlen(str, spec.precision) : wcslen(str));
+                    writeString(out, str, length * sizeof(wchar_t));
+                }
+                else
+                {
+                    auto str = va_arg(args, const char*);
+                    writeString(out, str, !str ? 0 : (spec.precision >= 0 ? strnlen(str, spec.precision) : strlen(str)));
+                }
+                break;
+            case 'p':
+                write(out, (uint64_t)(uintptr_t)va_arg(args, void*));
+                break;
+            case '%':
+                break;
+            default:
+                // %n, malformed or unknown specifier
+                return false;
+        }
+    }
+    return true;
+}
+
+struct Reader
+{
+    const char* p;
+    const char* end;
+
+    template<typename T>
+    T read()
+    {
+        T value{};
+        if (p + sizeof(T) <= end) memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        return value;
+    }
+
+    //! Returns nullptr for null strings, 'storage' keeps null terminated copy
+    const char* readString(std::string& storage)
+    {
+        auto size = read<uint32_t>();
+        if (size == kNullString) return nullptr;
+        storage.assign(p, std::min<size_t>(size, end > p ? end - p : 0));
+        p += size;
+        return storage.c_str();
+    }
+
+    const wchar_t* readWideString(std::wstring& storage)
+    {
+        auto size = read<uint32_t>();
+        if (size == kNullString) return nullptr;
+        storage.assign((const wchar_t*)p, std::min<size_t>(size, end > p ? end - p : 0) / sizeof(wchar_t));
+        p += size;
+        return storage.c_str();
+    }
+};
+
+template<typename T>
+inline void appendFormatted(std::string& out, const std::string& fmt, T value)
+{
+    char buffer[256];
+    int size = snprintf(buffer, sizeof(buffer), fmt.c_str(), value);
+    if (size < 0) return;
+    if (size < (int)sizeof(buffer))
+    {
+        out.append(buffer, size);
+        return;
+    }
+    auto offset = out.size();
+    out.resize(offset + size + 1);
+    snprintf(out.data() + offset, size + 1, fmt.c_str(), value);
+    out.resize(offset + size);
+}
+
+//! Formats binary record into regular log message, same output as logva would produce
+inline void format(std::string& out, const char* data, size_t size, int type)
+{
+    Reader reader{ data, data + size };
+    std::string file, func, tag, fmt, str;
+    std::wstring wstr;
+    auto time = std::chrono::system_clock::time_point(std::chrono::system_clock::duration(reader.read<int64_t>()));
+    auto line = reader.read<int32_t>();
+    auto filePtr = reader.readString(file);
+    auto funcPtr = reader.readString(func);
+    auto tagPtr = reader.readString(tag);
+    auto fmtPtr = reader.readString(fmt);
+
+    char header[512];
+    int headerSize = formatHeader(header, sizeof(header), time, filePtr ? filePtr : "", line, funcPtr ? funcPtr : "", type, tagPtr);
+    out.assign(header, std::clamp<int>(headerSize, 0, (int)sizeof(header) - 1));
+
+    const char* p = fmtPtr ? fmtPtr : "";
+    FormatSpec spec{};
+    std::string subFormat;
+    while (nextSpec(p, spec, &out))
+    {
+        // Rebuild the specifier with explicit width/precision and a length modifier matching the stored type
+        subFormat = "%";
+        auto flags = std::string(spec.flagsAndWidth, spec.flagsAndWidthSize);
+        for (auto& c : flags)
+        {
+            if (c == '*') subFormat += std::to_string((int)reader.read<int64_t>());
+            else subFormat += c;
+        }
+        switch (spec.conversion)
+        {
+            case 'd': case 'i':
+                appendFormatted(out, subFormat + "ll" + spec.conversion, (long long)reader.read<int64_t>());
+                break;
+            case 'u': case 'o': case 'x': case 'X':
+                appendFormatted(out, subFormat + "ll" + spec.conversion, (unsigned long long)reader.read<uint64_t>());
+                break;
+            case 'c': case 'C':
+                appendFormatted(out, subFormat + "c", (int)reader.read<int64_t>());
+                break;
+            case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+                appendFormatted(out, subFormat + spec.conversion, reader.read<double>());
+                break;
+            case 's': case 'S':
+                if (spec.conversion == 'S' || spec.length == Length::eLong)
+                {
+                    auto value = reader.readWideString(wstr);
+                    appendFormatted(out, subFormat + "ls", value ? value : L"(null)");
+                }
+                else
+                {
+                    auto value = reader.readString(str);
+                    appendFormatted(out, subFormat + "s", value ? value : "(null)");
+                }
+                break;
+            case 'p':
+                appendFormatted(out, subFormat + "p", (void*)(uintptr_t)reader.read<uint64_t>());
+                break;
+            case '%':
+                out += '%';
+                break;
+        }
+    }
+    if (out.empty() || out.back() != '\n')
+    {
+        out += '\n';
+    }
+}
+
+}
+
+//! Structured log records
+//! 
+//! Layout: [int64 time][int32 line][uint32 level][uint64 thread][str file][str function][str tag][message]
+//! where 'str' is the same as in binary records but followed by a null terminator so records can point
+//! straight into the payload, message takes the rest of the record (also null terminated).
+namespace structured
+{
+
+inline void writeString(std::string& out, const char* str)
+{
+    binary::writeString(out, str);
+    if (str) out += '\0';
+}
+
+inline void serialize(std::string& out, std::chrono::system_clock::time_point time, const char* file, int line, const char* func, const char* tag, uint32_t level, uint64_t threadId, const char* message, size_t length)
+{
+    out.clear();
+    binary::write(out, (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+    binary::write(out, (int32_t)line);
+    binary::write(out, level);
+    binary::write(out, threadId);
+    auto f = strrchr(file, '\\');
+    writeString(out, f ? f + 1 : file);
+    writeString(out, func);
+    writeString(out, tag);
+    binary::write(out, message, length);
+    out += '\0';
+}
+
+//! Points 'record' into 'payload' which must stay alive (and unchanged) while the record is used
+inline void parse(const std::string& payload, int type, LogRecord& record)
+{
+    binary::Reader reader{ payload.data(), payload.data() + payload.size() };
+    auto readString = [&reader]()->const char*
+    {
+        auto size = reader.read<uint32_t>();
+        if (size == binary::kNullString) return nullptr;
+        auto str = reader.p;
+        reader.p += size + 1;
+        return str;
+    };
+    record = {};
+    record.type = (LogType)type;
+    record.timestampNs = (uint64_t)reader.read<int64_t>();
+    record.line = reader.read<int32_t>();
+    record.level = (LogLevel)reader.read<uint32_t>();
+    record.threadId = reader.read<uint64_t>();
+    record.file = readString();
+    record.function = readString();
+    record.tag = readString();
+    record.message = reader.p;
+    auto end = payload.data() + payload.size() - 1;
+    record.messageLength = end > reader.p ? end - reader.p : 0;
+}
+
+}
+
+inline uint64_t getCurrentThreadId()
+{
+#ifdef NVIGI_WINDOWS
+    return GetCurrentThreadId();
+#else
+    thread_local uint64_t s_id = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return s_id;
+#endif
+}
+
+//! Single producer (owning thread) single consumer (drain thread) byte ring used by async logging
+struct LogRing
+{
+    static constexpr uint64_t kCapacity = 64 * 1024;
+    static_assert((kCapacity & (kCapacity - 1)) == 0);
+
+    alignas(64) std::atomic<uint64_t> head{}; // producer
+    alignas(64) std::atomic<uint64_t> tail{}; // consumer
+    std::atomic<bool> orphaned = false; // owning thread exited, release once drained
+    uint64_t generation{}; // Log instance this ring is registered with
+    uint8_t data[kCapacity];
+
+    void copyIn(uint64_t offset, const void* src, size_t size)
+    {
+        auto start = offset & (kCapacity - 1);
+        auto first = std::min<size_t>(size, kCapacity - start);
+        memcpy(data + start, src, first);
+        memcpy(data, (const uint8_t*)src + first, size - first);
+    }
+
+    void copyOut(uint64_t offset, void* dst, size_t size) const
+    {
+        auto start = offset & (kCapacity - 1);
+        auto first = std::min<size_t>(size, kCapacity - start);
+        memcpy(dst, data + start, first);
+        memcpy((uint8_t*)dst + first, data, size - first);
+    }
+
+    uint64_t usage() const
+    {
+        return head.load(std::memory_order_relaxed) - tail.load(std::memory_order_relaxed);
+    }
+
+    bool push(const LogRecordHeader& header, const char* text)
+    {
+        auto h = head.load(std::memory_order_relaxed);
+        auto t = tail.load(std::memory_order_acquire);
+        auto needed = sizeof(LogRecordHeader) + header.size;
+        if (kCapacity - (h - t) < needed) return false;
+        copyIn(h, &header, sizeof(header));
+        copyIn(h + sizeof(header), text, header.size);
+        head.store(h + needed, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(LogRecordHeader& header, std::string& text)
+    {
+        auto t = tail.load(std::memory_order_relaxed);
+        auto h = head.load(std::memory_order_acquire);
+        if (t == h) return false;
+        copyOut(t, &header, sizeof(header));
+        text.resize(header.size);
+        copyOut(t + sizeof(header), text.data(), header.size);
+        tail.store(t + sizeof(header) + header.size, std::memory_order_release);
+        return true;
+    }
+};
+
+//! Marks ring as orphaned when thread exits so drain thread can release it
+struct ThreadLogRing
+{
+    std::shared_ptr<LogRing> ring;
+    ~ThreadLogRing()
+    {
+        if (ring) ring->orphaned = true;
+    }
+};
+thread_local ThreadLogRing t_logRing;
+//! Reused formatting buffers, avoid heap allocations once warmed up
+thread_local std::string t_logBuffer;
+thread_local std::string t_logBinaryBuffer;
+
+//! Drain thread wakes up at least this often when async logging is on
+constexpr auto kLogDrainInterval = std::chrono::milliseconds(2);
+
+//! Outlives Log instances since other modules cache its address, see isLevelEnabled in log.h
+std::atomic<uint32_t> s_logLevelValue{ (uint32_t)LogLevel::eVerbose };
+
 struct Log
 {
     std::hash<std::string> m_hash;
@@ -160,15 +653,33 @@ struct Log
     std::string m_path;
     std::string m_name;
     std::string m_filePath;
-    LogLevel m_logLevel = LogLevel::eVerbose;
+    std::atomic<bool> m_binaryRecords = false;
     std::atomic<bool> m_consoleActive = false;
     FILE* m_file = {};
     PFun_LogMessageCallback* m_logMessageCallback = {};
+    //! Batch delivery, see 'LogBatchPreferences'
+    std::atomic<PFun_LogBatchCallback*> m_logBatchCallback = {};
+    void* m_logBatchUserData = {};
+    //! Held while a batch is delivered, recursive so the callback itself can replace or remove the callback
+    std::recursive_mutex m_logBatchMtx;
+    //! Records dropped because a ring was full in batch mode, never block logging threads then
+    std::atomic<uint64_t> m_dropped{};
+    uint64_t m_droppedReported{};
     Result m_result = kResultOk;
 
     Log() {}
 
     void print(ConsoleForeground color, LogType type, const std::string &logMessage)
+    {
+        printConsole(color, type, logMessage);
+        if (m_file)
+        {
+            fputs(logMessage.c_str(), m_file);
+            fflush(m_file);
+        }
+    }
+
+    void printConsole(ConsoleForeground color, LogType type, const std::string& logMessage)
     {
 #ifdef NVIGI_WINDOWS
         // Set attribute for newly written text
@@ -205,14 +716,172 @@ struct Log
             fprintf(stderr, "%s", logMessage.c_str());
         }
 #endif
+    }
 
-        if (m_file)
+    //! Async logging
+    //! 
+    //! Callers push formatted messages to their own LogRing, drain thread
+    //! writes them out in batches with a single file flush per batch.
+    std::atomic<bool> m_async = false;
+    uint64_t m_generation{};
+    std::thread m_drainThread;
+    std::mutex m_drainMtx;
+    std::condition_variable m_drainCv;
+    std::condition_variable m_flushCv;
+    bool m_drainQuit = false;
+    bool m_drainRequested = false;
+    //! Produced is incremented before a message is pushed and consumed after it is written so flush can never miss a message
+    std::atomic<uint64_t> m_produced{};
+    std::atomic<uint64_t> m_consumed{};
+    std::mutex m_ringsMtx;
+    std::vector<std::shared_ptr<LogRing>> m_rings;
+    //! Serializes output between drain thread and callers falling back to synchronous logging
+    std::mutex m_printMtx;
+
+    inline static std::atomic<uint64_t> s_nextGeneration{ 1 };
+
+    LogRing* getThreadRing()
+    {
+        auto& ring = t_logRing.ring;
+        if (!ring || ring->generation != m_generation)
         {
-            fputs(logMessage.c_str(), m_file);
-            fflush(m_file);
+            // New thread or logger was recreated, previous ring (if any) is owned by the old registry
+            if (ring) ring->orphaned = true;
+            ring = std::make_shared<LogRing>();
+            ring->generation = m_generation;
+            std::scoped_lock lock(m_ringsMtx);
+            m_rings.push_back(ring);
+        }
+        return ring.get();
+    }
+
+    void wakeDrain()
+    {
+        {
+            std::scoped_lock lock(m_drainMtx);
+            m_drainRequested = true;
+        }
+        m_drainCv.notify_one();
+    }
+
+    void drainRings()
+    {
+        std::vector<std::shared_ptr<LogRing>> rings;
+        {
+            std::scoped_lock lock(m_ringsMtx);
+            // Release rings from threads which exited and have nothing left to write
+            for (auto it = m_rings.begin(); it != m_rings.end();)
+            {
+                if ((*it)->orphaned && (*it)->usage() == 0) it = m_rings.erase(it);
+                else it++;
+            }
+            rings = m_rings;
+        }
+
+        LogRecordHeader header{};
+        std::string message;
+        uint64_t count = 0;
+        m_batch.clear();
+        {
+            std::scoped_lock lock(m_printMtx);
+            for (auto& ring : rings)
+            {
+                while (ring->pop(header, message))
+                {
+                    if (header.flags & kLogRecordFlagBinary)
+                    {
+                        // Deferred formatting, this is the only place where binary records turn into text
+                        binary::format(m_formatted, message.data(), message.size(), header.type);
+                        message.swap(m_formatted);
+                    }
+                    else if (header.flags & kLogRecordFlagStructured)
+                    {
+                        // Payload is kept until the batch is delivered, records point into it
+                        if (m_payloadCount == m_payloads.size()) m_payloads.emplace_back();
+                        auto& payload = m_payloads[m_payloadCount++];
+                        payload.swap(message);
+                        auto& record = m_records.emplace_back();
+                        structured::parse(payload, header.type, record);
+                        formatStructured(message, record);
+                    }
+                    if (m_logMessageCallback)
+                    {
+                        m_logMessageCallback((LogType)header.type, message.c_str());
+                    }
+                    printConsole((ConsoleForeground)header.color, (LogType)header.type, message);
+                    m_batch += message;
+                    count++;
+                }
+            }
+            if (m_file && !m_batch.empty())
+            {
+                fputs(m_batch.c_str(), m_file);
+                fflush(m_file);
+            }
+        }
+        deliverBatch();
+        if (count)
+        {
+            m_consumed += count;
+            std::scoped_lock lock(m_drainMtx);
+            m_flushCv.notify_all();
+        }
+    }
+
+    //! Same text as logva would produce for the regular outputs (console, file, per message callback)
+    void formatStructured(std::string& out, const LogRecord& record)
+    {
+        char header[512];
+        auto time = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(record.timestampNs)));
+        int headerSize = formatHeader(header, sizeof(header), time, record.file ? record.file : "", record.line, record.function ? record.function : "", (int)record.type, record.tag);
+        out.assign(header, std::clamp<int>(headerSize, 0, (int)sizeof(header) - 1));
+        out.append(record.message, record.messageLength);
+        out += '\n';
+    }
+
+    //! Called on the drain thread only
+    void deliverBatch()
+    {
+        std::scoped_lock lock(m_logBatchMtx);
+        auto callback = m_logBatchCallback.load();
+        auto dropped = m_dropped.load() - m_droppedReported;
+        if (callback && (!m_records.empty() || dropped))
+        {
+            m_droppedReported += dropped;
+            callback(m_records.data(), m_records.size(), dropped, m_logBatchUserData);
         }
+        m_records.clear();
+        // Keep the strings around, their capacity is reused by the next batch
+        m_payloadCount = 0;
     }
 
+    std::vector<LogRecord> m_records;
+    std::deque<std::string> m_payloads;
+    size_t m_payloadCount{};
+
+    void drainThread()
+    {
+#ifdef NVIGI_WINDOWS
+        SetThreadDescription(GetCurrentThread(), L"nvigi.log");
+#endif
+        bool quit = false;
+        while (!quit)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_drainMtx);
+                m_drainCv.wait_for(lock, std::chrono::milliseconds(m_drainIntervalMs.load()), [this] { return m_drainQuit || m_drainRequested; });
+                m_drainRequested = false;
+                quit = m_drainQuit;
+            }
+            // Always drain one more time before exiting
+            drainRings();
+        }
+    }
+
+    std::string m_batch;
+    std::string m_formatted;
+    std::atomic<uint32_t> m_drainIntervalMs{ (uint32_t)kLogDrainInterval.count() };
+
     void startConsole()
     {
 #ifdef NVIGI_WINDOWS
@@ -260,14 +929,12 @@ void enableConsole(bool flag)
 
 LogLevel getLogLevel()
 {
-    auto& ctx = *Log::s_log;
-    return ctx.m_logLevel;
+    return (LogLevel)s_logLevelValue.load();
 }
 
 void setLogLevel(LogLevel level)
 {
-    auto& ctx = *Log::s_log;
-    ctx.m_logLevel = level;
+    s_logLevelValue.store((uint32_t)level);
 }
 
 const char* getLogPath()
@@ -395,9 +1062,90 @@ Result setupLogging()
     return ctx.m_result;
 }
 
+Result flush(uint32_t timeoutMs)
+{
+    auto& ctx = *Log::s_log;
+    if (!ctx.m_async || !ctx.m_drainThread.joinable()) return kResultOk;
+    auto target = ctx.m_produced.load();
+    std::unique_lock<std::mutex> lock(ctx.m_drainMtx);
+    ctx.m_drainRequested = true;
+    ctx.m_drainCv.notify_one();
+    if (!thread::waitFor(ctx.m_flushCv, lock, std::chrono::milliseconds(timeoutMs), [&ctx, target] { return ctx.m_consumed.load() >= target; }))
+    {
+        return kResultTimedOut;
+    }
+    return kResultOk;
+}
+
+const std::atomic<uint32_t>* getLogLevelAtomic()
+{
+    return &s_logLevelValue;
+}
+
+void enableBinaryLogRecords(bool flag)
+{
+    auto& ctx = *Log::s_log;
+    ctx.m_binaryRecords = flag;
+}
+
+uint64_t getDroppedRecordCount()
+{
+    auto& ctx = *Log::s_log;
+    return ctx.m_dropped.load();
+}
+
+Result enableAsyncLogging(bool flag)
+{
+    auto& ctx = *Log::s_log;
+    if (flag && !ctx.m_async)
+    {
+        ctx.m_drainQuit = false;
+        ctx.m_drainThread = std::thread(&Log::drainThread, &ctx);
+        ctx.m_async = true;
+    }
+    else if (!flag && ctx.m_async)
+    {
+        ctx.m_async = false;
+        {
+            std::scoped_lock lock(ctx.m_drainMtx);
+            ctx.m_drainQuit = true;
+        }
+        ctx.m_drainCv.notify_one();
+        // Drain thread always empties rings one last time before exiting
+        ctx.m_drainThread.join();
+        // Pick up anything pushed by threads which raced with the above
+        ctx.drainRings();
+    }
+    return kResultOk;
+}
+
+void setLogBatchCallback(void* logBatchCallback, void* userData, uint32_t intervalMs)
+{
+    auto& ctx = *Log::s_log;
+    {
+        // Drain thread might be delivering a batch to the previous callback, once the lock is ours it is done
+        // and the previous callback (and its user data) is never called again
+        std::scoped_lock lock(ctx.m_logBatchMtx);
+        ctx.m_logBatchUserData = logBatchCallback ? userData : nullptr;
+        ctx.m_logBatchCallback = (PFun_LogBatchCallback*)logBatchCallback;
+    }
+    if (!logBatchCallback)
+    {
+        // Records already queued are still written out, just not delivered in batches
+        ctx.m_drainIntervalMs = (uint32_t)kLogDrainInterval.count();
+        return;
+    }
+    ctx.m_drainIntervalMs = std::max(1u, intervalMs);
+    // Batches are only produced by the drain thread
+    enableAsyncLogging(true);
+}
+
 void shutdown()
 {
     auto& ctx = *Log::s_log;
+    // Write out all pending messages before closing the file
+    enableAsyncLogging(false);
+    ctx.m_logBatchCallback = nullptr;
     if (ctx.m_file)
     {
         fflush(ctx.m_file);
@@ -424,70 +1172,163 @@ void logva(uint32_t level, ConsoleForeground color, const char* _file, int line,
 
     try
     {
-        if (level > (uint32_t)ctx->m_logLevel)
+        if (level > s_logLevelValue.load(std::memory_order_relaxed))
         {
             // Higher level than requested, bail out
             return;
         }
 
-        std::string message;
-
-        bool errorDetected = false;
         //! Important, va_list cannot be used multiple times!
-        va_list args, args1;
+        va_list args, args1, args2;
 
         va_start(args, _fmt);
         va_copy(args1, args);
+        va_copy(args2, args);
         // Make sure va_end is called before early out!
-        extra::ScopedTasks onExit([&]() { va_end(args); va_end(args1); });
+        extra::ScopedTasks onExit([&]() { va_end(args); va_end(args1); va_end(args2); });
 
-        // Determine the required size of the formatted message (without null-terminator)
-        int msgSize = std::vsnprintf(nullptr, 0, _fmt, args); //_vscprintf(_fmt, args);
-        if (msgSize >= 1)
+        if (ctx->m_async && ctx->m_logBatchCallback.load(std::memory_order_relaxed))
         {
-            // Account for the null terminator char
-            msgSize++;
-            message.resize(msgSize);
-
-            // Format the message
-            msgSize = std::vsnprintf(message.data(), message.size(), _fmt, args1);
-
-            if (msgSize <= 0)
+            // Batch mode, message is formatted here but header is left to the drain thread
+            auto& message = t_logBuffer;
+            if (message.size() < 1024)
             {
-                // invalid character in the string or any other error
-                errorDetected = true;
+                message.resize(1024);
             }
-            // vsnprintf adds '0' at the end of the string. if we don't remove it,
-            // the '+=' won't work correctly on that string
-            while (message.size() && *message.rbegin() == '\0')
+            int msgSize = std::vsnprintf(message.data(), message.size(), _fmt, args);
+            if (msgSize >= (int)message.size())
             {
-                message.pop_back();
+                message.resize(msgSize + 1);
+                msgSize = std::vsnprintf(message.data(), message.size(), _fmt, args1);
             }
+            if (msgSize > 0)
+            {
+                size_t length = msgSize;
+                while (length && message[length - 1] == '\n') length--;
+                auto& record = t_logBinaryBuffer;
+                structured::serialize(record, std::chrono::system_clock::now(), _file, line, _func, tag, level, getCurrentThreadId(), message.data(), length);
+                if (record.size() < LogRing::kCapacity / 2)
+                {
+                    ctx->m_produced++;
+                    auto ring = ctx->getThreadRing();
+                    if (ring->push({ (uint32_t)record.size(), (uint8_t)type, (uint8_t)color, kLogRecordFlagStructured }, record.data()))
+                    {
+                        if ((LogType)type == LogType::eError || ring->usage() > LogRing::kCapacity / 2)
+                        {
+                            ctx->wakeDrain();
+                        }
+                        return;
+                    }
+                    // Host asked us never to block or call back on this thread, drop and let it know
+                    ctx->m_produced--;
+                    ctx->m_dropped++;
+                    ctx->wakeDrain();
+                    return;
+                }
+            }
+            // Empty, malformed or huge message, regular path below deals with it
+            va_end(args1);
+            va_copy(args1, args2);
+            va_end(args);
+            va_copy(args, args2);
         }
-        else if (msgSize < 0)
+
+        if (ctx->m_async && ctx->m_binaryRecords)
         {
-            // _fmt is bad
-            errorDetected = true;
+            // Copy arguments only, formatting happens on the logging thread
+            auto& record = t_logBinaryBuffer;
+            if (binary::serialize(record, std::chrono::system_clock::now(), _file, line, _func, tag, _fmt, args2) && record.size() < LogRing::kCapacity / 2)
+            {
+                ctx->m_produced++;
+                auto ring = ctx->getThreadRing();
+                if (ring->push({ (uint32_t)record.size(), (uint8_t)type, (uint8_t)color, kLogRecordFlagBinary }, record.data()))
+                {
+                    if ((LogType)type == LogType::eError || ring->usage() > LogRing::kCapacity / 2)
+                    {
+                        ctx->wakeDrain();
+                    }
+                    return;
+                }
+                // Ring is full, regular path below handles it (produced counter already accounts for this message)
+                ctx->m_produced--;
+            }
         }
-        else
+
+        // Format header and message directly into the reused per-thread buffer, single pass unless message does not fit
+        auto& message = t_logBuffer;
+        if (message.size() < 1024)
+        {
+            message.resize(1024);
+        }
+        auto now = std::chrono::system_clock::now();
+        int headerSize = formatHeader(message.data(), message.size(), now, _file, line, _func, type, tag);
+        if (headerSize >= (int)message.size())
+        {
+            // Very long function name or tag, grow the buffer rather than losing the message
+            message.resize(headerSize + 1024);
+            headerSize = formatHeader(message.data(), message.size(), now, _file, line, _func, type, tag);
+        }
+        int msgSize = -1;
+        if (headerSize > 0 && headerSize < (int)message.size())
+        {
+            msgSize = std::vsnprintf(message.data() + headerSize, message.size() - headerSize, _fmt, args);
+            // Reserve space for the null terminator and new line
+            if (msgSize > 0 && headerSize + msgSize + 2 > (int)message.size())
+            {
+                message.resize(headerSize + msgSize + 2);
+                msgSize = std::vsnprintf(message.data() + headerSize, message.size() - headerSize, _fmt, args1);
+            }
+        }
+
+        if (msgSize == 0)
         {
             // Empty message, nothing to log
             return;
         }
-
-        if (errorDetected)
+        else if (msgSize < 0)
         {
-            // Something went wrong during `_vscprintf` or `vsprintf_s` so get error from system
+            // _fmt is bad, invalid character in the string or any other error
             std::string generalLogWarnMessage = generateHeader(__FILE__, __LINE__, __func__, (int)LogType::eWarn, nullptr) + "'vsnprintf' failed while trying to log a message\n";
             ctx->print(DARKYELLOW, LogType::eWarn, generalLogWarnMessage);
             return;
         }
 
-        auto completeLogMessage = generateHeader(_file, line, _func, type, tag) + message;
-        if (completeLogMessage.back() != '\n')
+        size_t length = headerSize + msgSize;
+        if (message[length - 1] != '\n')
         {
-            completeLogMessage += '\n';
+            message[length++] = '\n';
         }
+        message[length] = 0;
+
+        if (ctx->m_async && length < LogRing::kCapacity / 2)
+        {
+            ctx->m_produced++;
+            auto ring = ctx->getThreadRing();
+            if (ring->push({ (uint32_t)length, (uint8_t)type, (uint8_t)color, 0 }, message.c_str()))
+            {
+                // Errors must show up as soon as possible, otherwise wait for the drain interval unless we are running out of space
+                if ((LogType)type == LogType::eError || ring->usage() > LogRing::kCapacity / 2)
+                {
+                    ctx->wakeDrain();
+                }
+                return;
+            }
+            // Ring is full, write synchronously rather than drop or block
+            std::string completeLogMessage(message.c_str(), length);
+            {
+                std::scoped_lock lock(ctx->m_printMtx);
+                if (ctx->m_logMessageCallback)
+                {
+                    ctx->m_logMessageCallback((LogType)type, completeLogMessage.c_str());
+                }
+                ctx->print(color, (LogType)type, completeLogMessage);
+            }
+            ctx->m_consumed++;
+            ctx->wakeDrain();
+            return;
+        }
+
+        std::string completeLogMessage(message.c_str(), length);
         if (ctx->m_logMessageCallback)
         {
             ctx->m_logMessageCallback((LogType)type, completeLogMessage.c_str());
@@ -506,6 +1347,8 @@ ILog* getInterface()
     if (!Log::s_log)
     {
         Log::s_log = new Log();
+        Log::s_log->m_generation = Log::s_nextGeneration++;
+        s_logLevelValue = (uint32_t)LogLevel::eVerbose;
         Log::s_ilog.logva = logva;
         Log::s_ilog.enableConsole = enableConsole;
         Log::s_ilog.getLogLevel = getLogLevel;
@@ -518,6 +1361,12 @@ ILog* getInterface()
         Log::s_ilog.getLogName = getLogName;
         Log::s_ilog.shutdown = shutdown;
         Log::s_ilog.setupLogging = setupLogging;
+        Log::s_ilog.enableAsyncLogging = enableAsyncLogging;
+        Log::s_ilog.flush = flush;
+        Log::s_ilog.getLogLevelAtomic = getLogLevelAtomic;
+        Log::s_ilog.enableBinaryLogRecords = enableBinaryLogRecords;
+        Log::s_ilog.setLogBatchCallback = setLogBatchCallback;
+        Log::s_ilog.getDroppedRecordCount = getDroppedRecordCount;
     }
     return &Log::s_ilog;
 }
@@ -59,7 +59,7 @@ enum ConsoleForeground
 // {8FFD0CA2-62A0-4F4A-8840-E27E3FF4F75F}
 struct alignas(8) ILog {
     ILog() {}; 
-    NVIGI_UID(UID({ 0x8ffd0ca2, 0x62a0, 0x4f4a,{0x88, 0x40, 0xe2, 0x7e, 0x3f, 0xf4, 0xf7, 0x5f} }), kStructVersion2)
+    NVIGI_UID(UID({ 0x8ffd0ca2, 0x62a0, 0x4f4a,{0x88, 0x40, 0xe2, 0x7e, 0x3f, 0xf4, 0xf7, 0x5f} }), kStructVersion5)
     void (*logva)(uint32_t level, ConsoleForeground color, const char *file, int line, const char *func, int type, const char* tag, const char *fmt,...);
     void (*enableConsole)(bool flag);
     LogLevel(*getLogLevel)();
@@ -76,6 +76,41 @@ struct alignas(8) ILog {
     
     Result (*setupLogging)();
 
+    //! v3
+
+    //! When enabled, messages are formatted on the calling thread into a per-thread ring buffer
+    //! and a background thread writes them to the console, file and callback in batches.
+    //! 
+    //! NOTE: Disabling flushes all pending messages first
+    Result (*enableAsyncLogging)(bool flag);
+    //! Blocks until all messages logged so far are written out or timeout expires.
+    //! 
+    //! Returns kResultTimedOut on timeout, safe to call when async logging is disabled (no-op)
+    Result (*flush)(uint32_t timeoutMs);
+
+    //! v4
+
+    //! Current log level owned by the logger, valid for the lifetime of the core module.
+    //! 
+    //! Used by the logging macros to skip disabled messages without calling 'logva'
+    const std::atomic<uint32_t>* (*getLogLevelAtomic)();
+    //! When enabled (and async logging is on) callers only copy format string and arguments into
+    //! a compact binary record, actual formatting happens on the logging thread.
+    //! 
+    //! NOTE: Format string is parsed on the calling thread, unsupported specifiers (like %n) fall back to regular formatting
+    void (*enableBinaryLogRecords)(bool flag);
+
+    //! v5
+
+    //! Delivers structured records in batches from the logging thread, see 'LogBatchPreferences' in nvigi.h
+    //! 
+    //! Requires async logging, pass nullptr callback to go back to per message delivery. Waits for a batch being
+    //! delivered to the previous callback, so its user data can be released once this returns.
+    //! Can be called from within the callback.
+    void (*setLogBatchCallback)(void* logBatchCallback, void* userData, uint32_t intervalMs);
+    //! Total number of records dropped because the logging thread fell behind (batch mode only)
+    uint64_t (*getDroppedRecordCount)();
+
     //! IMPORTANT: New members go here, don't forget to bump the version, see nvigi_struct.h for details
 };
 
@@ -88,18 +123,52 @@ void destroyInterface();
     for (static std::atomic<int> s_runAlready(false); \
          !s_runAlready.fetch_or(true);)               \
 
-#define NVIGI_LOG(tag, type, clr, fmt,...) nvigi::log::getInterface()->logva(2, clr, __FILE__,__LINE__,__func__, (int)type, tag, fmt,##__VA_ARGS__)
-#define NVIGI_LOG_HINT(fmt,...) nvigi::log::getInterface()->logva(2, nvigi::log::CYAN, __FILE__,__LINE__,__func__, 0, nullptr,fmt,##__VA_ARGS__)
-#define NVIGI_LOG_INFO(fmt,...) nvigi::log::getInterface()->logva(1, nvigi::log::WHITE, __FILE__,__LINE__,__func__, 0, nullptr,fmt,##__VA_ARGS__)
-#define NVIGI_LOG_WARN(fmt,...) nvigi::log::getInterface()->logva(1, nvigi::log::YELLOW, __FILE__,__LINE__,__func__, 1, nullptr,fmt,##__VA_ARGS__)
-#define NVIGI_LOG_ERROR(fmt,...) nvigi::log::getInterface()->logva(1, nvigi::log::RED, __FILE__,__LINE__,__func__, 2, nullptr,fmt,##__VA_ARGS__)
-#define NVIGI_LOG_VERBOSE(fmt,...) nvigi::log::getInterface()->logva(2, nvigi::log::WHITE, __FILE__,__LINE__,__func__,0, nullptr,fmt,##__VA_ARGS__)
+//! Highest log level compiled in, messages above it are removed at build time
+//! 
+//! 0 - nothing, 1 - info/warn/error, 2 - everything (default)
+#ifndef NVIGI_LOG_MAX_LEVEL
+#define NVIGI_LOG_MAX_LEVEL 2
+#endif
+
+//! Cached pointer to the level owned by the logger so disabled messages cost a single relaxed load
+inline std::atomic<const std::atomic<uint32_t>*> s_logLevel{};
+
+inline bool isLevelEnabled(uint32_t level)
+{
+    auto logLevel = s_logLevel.load(std::memory_order_relaxed);
+    if (!logLevel)
+    {
+        auto log = getInterface();
+        if (!log) return false;
+        // Older logger, let 'logva' decide
+        if (log->getVersion() < kStructVersion4) return true;
+        logLevel = log->getLogLevelAtomic();
+        s_logLevel.store(logLevel, std::memory_order_relaxed);
+    }
+    return level <= logLevel->load(std::memory_order_relaxed);
+}
+
+//! Must be called when module switches to a different logger instance
+inline void resetLevelCache()
+{
+    s_logLevel.store(nullptr);
+}
+
+//! NOTE: Compiled out messages still reference their arguments (never evaluated) to avoid unused variable warnings
+#define NVIGI_LOG_IMPL(level, tag, type, clr, fmt,...) (((level) <= NVIGI_LOG_MAX_LEVEL && nvigi::log::isLevelEnabled(level)) ? nvigi::log::getInterface()->logva(level, clr, __FILE__,__LINE__,__func__, (int)type, tag, fmt,##__VA_ARGS__) : (void)0)
+
+#define NVIGI_LOG(tag, type, clr, fmt,...) NVIGI_LOG_IMPL(2, tag, type, clr, fmt,##__VA_ARGS__)
+#define NVIGI_LOG_HINT(fmt,...) NVIGI_LOG_IMPL(2, nullptr, 0, nvigi::log::CYAN, fmt,##__VA_ARGS__)
+#define NVIGI_LOG_INFO(fmt,...) NVIGI_LOG_IMPL(1, nullptr, 0, nvigi::log::WHITE, fmt,##__VA_ARGS__)
+#define NVIGI_LOG_WARN(fmt,...) NVIGI_LOG_IMPL(1, nullptr, 1, nvigi::log::YELLOW, fmt,##__VA_ARGS__)
+#define NVIGI_LOG_ERROR(fmt,...) NVIGI_LOG_IMPL(1, nullptr, 2, nvigi::log::RED, fmt,##__VA_ARGS__)
+#define NVIGI_LOG_VERBOSE(fmt,...) NVIGI_LOG_IMPL(2, nullptr, 0, nvigi::log::WHITE, fmt,##__VA_ARGS__)
 
 //! Used by unit test, same as regular logging but with [test] tag and showing in GREEN color in terminal for clear separation
-#define NVIGI_LOG_TEST_INFO(fmt,...) nvigi::log::getInterface()->logva(1, nvigi::log::GREEN, __FILE__,__LINE__,__func__, 0, "test",fmt,##__VA_ARGS__)
-#define NVIGI_LOG_TEST_WARN(fmt,...) nvigi::log::getInterface()->logva(1, nvigi::log::YELLOW, __FILE__,__LINE__,__func__, 1, "test",fmt,##__VA_ARGS__)
-#define NVIGI_LOG_TEST_ERROR(fmt,...) nvigi::log::getInterface()->logva(1, nvigi::log::RED, __FILE__,__LINE__,__func__, 2, "test",fmt,##__VA_ARGS__)
-#define NVIGI_LOG_TEST_VERBOSE(fmt,...) nvigi::log::getInterface()->logva(2, nvigi::log::GREEN, __FILE__,__LINE__,__func__,0, "test",fmt,##__VA_ARGS__)
+#define NVIGI_LOG_TEST_INFO(fmt,...) NVIGI_LOG_IMPL(1, "test", 0, nvigi::log::GREEN, fmt,##__VA_ARGS__)
+#define NVIGI_LOG_TEST_WARN(fmt,...) NVIGI_LOG_IMPL(1, "test", 1, nvigi::log::YELLOW, fmt,##__VA_ARGS__)
+#define NVIGI_LOG_TEST_ERROR(fmt,...) NVIGI_LOG_IMPL(1, "test", 2, nvigi::log::RED, fmt,##__VA_ARGS__)
+#define NVIGI_LOG_TEST_VERBOSE(fmt,...) NVIGI_LOG_IMPL(2, "test", 0, nvigi::log::GREEN, fmt,##__VA_ARGS__)
 
 #define NVIGI_LOG_HINT_ONCE(fmt,...) NVIGI_RUN_ONCE { NVIGI_LOG_HINT(fmt,##__VA_ARGS__); }
 #define NVIGI_LOG_INFO_ONCE(fmt,...) NVIGI_RUN_ONCE { NVIGI_LOG_INFO(fmt,##__VA_ARGS__); }
@@ -6,11 +6,19 @@
 #include <Windows.h>
 #else
 #include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
 #endif
 
-#ifdef NVIGI_VALIDATE_MEMORY
 #include <mutex>
-#include <map>
+#include <atomic>
+#include <array>
+#include <bit>
+#include <utility>
+
+#ifdef NVIGI_VALIDATE_MEMORY
+#include <unordered_map>
 #include <assert.h>
 #endif
 
@@ -22,58 +30,605 @@ namespace nvigi
 namespace memory
 {
 
+//! Every block starts with a header so any deallocate can tell where the block came from.
+//! This allows switching between system and pooled allocators at any time.
+struct alignas(16) BlockHeader
+{
+    uint32_t sizeClass;
+    uint16_t magic;
+    //! Accounting tag, see 'getTaggedInterface'
+    uint16_t tag;
+    uint64_t size;
+};
+static_assert(sizeof(BlockHeader) == 16);
+
+constexpr uint16_t kBlockMagic = 0x4e56; // 'NV'
+constexpr uint32_t kSizeClassSystem = UINT32_MAX;
+//! Page granular blocks from 'allocateWithFlags', header 'size' is the size of the whole OS region
+constexpr uint32_t kSizeClassVirtual = UINT32_MAX - 1;
+//! Payload starts one cache line into the OS region, header sits right before it as usual
+constexpr size_t kVirtualBlockOffset = 64;
+
+//! Size classes are powers of two from 16 bytes to 4KB (payload only), anything bigger goes to the system allocator
+constexpr uint32_t kNumSizeClasses = 9;
+constexpr size_t kMinClassSize = 16;
+constexpr size_t kMaxClassSize = kMinClassSize << (kNumSizeClasses - 1);
+//! Thread cache keeps up to this many blocks per class, half of them go back to the shared list when exceeded
+constexpr uint32_t kMaxCachedBlocksPerClass = 64;
+
+inline uint32_t getSizeClass(size_t size)
+{
+    uint32_t sizeClass = 0;
+    size_t classSize = kMinClassSize;
+    while (classSize < size)
+    {
+        classSize <<= 1;
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+inline size_t getClassSize(uint32_t sizeClass)
+{
+    return kMinClassSize << sizeClass;
+}
+
+//! Free blocks are linked through their payload
+struct FreeBlock
+{
+    FreeBlock* next;
+};
+
+//! Shared per class free lists, only touched when thread caches are empty or full
+struct SharedFreeList
+{
+    std::mutex mtx;
+    FreeBlock* head{};
+    uint32_t count{};
+};
+//! Intentionally leaked to avoid static destruction order issues with allocations released late
+SharedFreeList* s_shared = new SharedFreeList[kNumSizeClasses];
+
+struct ThreadCache
+{
+    FreeBlock* head[kNumSizeClasses]{};
+    uint32_t count[kNumSizeClasses]{};
+
+    ~ThreadCache();
+};
+
+//! Trivially destructible so safe to check even after ThreadCache is gone on this thread
+enum class ThreadCacheState : uint8_t { eNone, eAlive, eDestroyed };
+thread_local ThreadCacheState s_threadCacheState = ThreadCacheState::eNone;
+thread_local ThreadCache s_threadCache;
+
+void pushShared(uint32_t sizeClass, FreeBlock* first, FreeBlock* last, uint32_t count)
+{
+    auto& list = s_shared[sizeClass];
+    std::scoped_lock lock(list.mtx);
+    last->next = list.head;
+    list.head = first;
+    list.count += count;
+}
+
+ThreadCache::~ThreadCache()
+{
+    s_threadCacheState = ThreadCacheState::eDestroyed;
+    for (uint32_t i = 0; i < kNumSizeClasses; i++)
+    {
+        if (!head[i]) continue;
+        auto last = head[i];
+        while (last->next) last = last->next;
+        pushShared(i, head[i], last, count[i]);
+        head[i] = nullptr;
+        count[i] = 0;
+    }
+}
+
+//! Returns null if thread is exiting and its cache is already gone
+ThreadCache* getThreadCache()
+{
+    if (s_threadCacheState == ThreadCacheState::eDestroyed) return nullptr;
+    s_threadCacheState = ThreadCacheState::eAlive;
+    return &s_threadCache;
+}
+
+void* popBlock(uint32_t sizeClass)
+{
+    auto cache = getThreadCache();
+    if (cache && !cache->head[sizeClass])
+    {
+        // Refill from the shared list, take everything to amortize the lock
+        auto& list = s_shared[sizeClass];
+        std::scoped_lock lock(list.mtx);
+        cache->head[sizeClass] = list.head;
+        cache->count[sizeClass] = list.count;
+        list.head = nullptr;
+        list.count = 0;
+    }
+    if (cache && cache->head[sizeClass])
+    {
+        auto block = cache->head[sizeClass];
+        cache->head[sizeClass] = block->next;
+        cache->count[sizeClass]--;
+        return block;
+    }
+    if (!cache)
+    {
+        auto& list = s_shared[sizeClass];
+        std::scoped_lock lock(list.mtx);
+        if (list.head)
+        {
+            auto block = list.head;
+            list.head = block->next;
+            list.count--;
+            return block;
+        }
+    }
+    auto header = (BlockHeader*)malloc(sizeof(BlockHeader) + getClassSize(sizeClass));
+    return header ? header + 1 : nullptr;
+}
+
+void pushBlock(uint32_t sizeClass, void* ptr)
+{
+    auto block = (FreeBlock*)ptr;
+    auto cache = getThreadCache();
+    if (!cache)
+    {
+        pushShared(sizeClass, block, block, 1);
+        return;
+    }
+    block->next = cache->head[sizeClass];
+    cache->head[sizeClass] = block;
+    if (++cache->count[sizeClass] > kMaxCachedBlocksPerClass)
+    {
+        // Give half back so other threads can reuse them
+        auto first = cache->head[sizeClass];
+        auto last = first;
+        for (uint32_t i = 1; i < kMaxCachedBlocksPerClass / 2; i++) last = last->next;
+        cache->head[sizeClass] = last->next;
+        cache->count[sizeClass] -= kMaxCachedBlocksPerClass / 2;
+        pushShared(sizeClass, first, last, kMaxCachedBlocksPerClass / 2);
+    }
+}
+
 #ifdef NVIGI_VALIDATE_MEMORY
-std::mutex mtx;
-std::map<void*, size_t> allocs;
+//! Tracking is sharded by address to keep contention low when many threads allocate
+constexpr size_t kNumTrackingShards = 64;
+struct TrackingShard
+{
+    std::mutex mtx;
+    std::unordered_map<void*, size_t> allocs;
+};
+TrackingShard* s_tracking = new TrackingShard[kNumTrackingShards];
+
+inline TrackingShard& getShard(void* ptr)
+{
+    // Blocks are 16 byte aligned so skip the low bits, mix the rest
+    auto key = ((uintptr_t)ptr >> 4) * 0x9E3779B97F4A7C15ull;
+    return s_tracking[(key >> 58) % kNumTrackingShards];
+}
+
+void track(void* ptr, size_t size)
+{
+    auto& shard = getShard(ptr);
+    std::scoped_lock lock(shard.mtx);
+    assert(shard.allocs.find(ptr) == shard.allocs.end());
+    shard.allocs[ptr] = size;
+}
+
+void untrack(void* ptr)
+{
+    auto& shard = getShard(ptr);
+    std::scoped_lock lock(shard.mtx);
+    assert(shard.allocs.find(ptr) != shard.allocs.end());
+    shard.allocs.erase(ptr);
+}
 #endif
 
+//! Per tag allocation counters, always on
+//!
+//! Each tag sits on its own cache lines so plugins allocating concurrently do not contend with each other
+struct alignas(64) TagCounters
+{
+    std::atomic<int64_t> liveBytes{};
+    std::atomic<int64_t> peakBytes{};
+    std::atomic<int64_t> liveAllocations{};
+    std::atomic<uint64_t> totalAllocations{};
+    std::atomic<uint64_t> totalBytesAllocated{};
+    std::atomic<uint64_t> sizeHistogram[kMemorySizeBucketCount]{};
+    char name[64]{};
+};
+//! Untagged allocations and tags over the limit
+constexpr uint16_t kTagCore = 0;
+constexpr uint16_t kTagOther = kMaxMemoryTags - 1;
+//! Intentionally leaked, same as 's_shared'
+TagCounters* s_tags = []()
+{
+    auto tags = new TagCounters[kMaxMemoryTags];
+    strncpy(tags[kTagCore].name, "nvigi.core", sizeof(tags[kTagCore].name) - 1);
+    strncpy(tags[kTagOther].name, "nvigi.other", sizeof(tags[kTagOther].name) - 1);
+    return tags;
+}();
+std::mutex s_tagsMtx;
+//! "nvigi.other" is only reported once it is used
+std::atomic<uint32_t> s_tagCount{ 1 };
+
+inline uint32_t getSizeBucket(size_t size)
+{
+    if (size <= kMinClassSize) return 0;
+    return std::min<uint32_t>(uint32_t(std::bit_width(size - 1)) - 4, kMemorySizeBucketCount - 1);
+}
+
+inline void account(uint16_t tag, size_t size)
+{
+    auto& counters = s_tags[tag];
+    auto live = counters.liveBytes.fetch_add(int64_t(size), std::memory_order_relaxed) + int64_t(size);
+    auto peak = counters.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !counters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    counters.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+    counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    counters.totalBytesAllocated.fetch_add(size, std::memory_order_relaxed);
+    counters.sizeHistogram[getSizeBucket(size)].fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void unaccount(uint16_t tag, size_t size)
+{
+    auto& counters = s_tags[tag];
+    counters.liveBytes.fetch_sub(int64_t(size), std::memory_order_relaxed);
+    counters.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+inline void* finalize(void* payload, uint32_t sizeClass, size_t size, uint16_t tag)
+{
+    if (!payload) return nullptr;
+    auto header = (BlockHeader*)payload - 1;
+    header->sizeClass = sizeClass;
+    header->magic = kBlockMagic;
+    header->tag = tag;
+    header->size = size;
+    account(tag, size);
+#ifdef NVIGI_VALIDATE_MEMORY
+    track(payload, size);
+#endif
+    return payload;
+}
+
+void* allocateSystem(size_t size, bool zero, uint16_t tag)
+{
+    if (!size) return nullptr;
+    auto header = (BlockHeader*)malloc(sizeof(BlockHeader) + size);
+    auto ptr = finalize(header ? header + 1 : nullptr, kSizeClassSystem, size, tag);
+    if (ptr && zero) memset(ptr, 0, size);
+    return ptr;
+}
+
+void* allocatePooled(size_t size, bool zero, uint16_t tag)
+{
+    if (!size) return nullptr;
+    if (size > kMaxClassSize) return allocateSystem(size, zero, tag);
+    auto sizeClass = getSizeClass(size);
+    auto ptr = finalize(popBlock(sizeClass), sizeClass, size, tag);
+    if (ptr && zero) memset(ptr, 0, size);
+    return ptr;
+}
+
+void* allocateSystemUninitialized(size_t size)
+{
+    return allocateSystem(size, false, kTagCore);
+}
+
 void* allocate(size_t size)
 {
     //NVIGI_LOG_HINT("allocate %llu", size);
+    return allocateSystem(size, true, kTagCore);
+}
+
+void* allocatePooledUninitialized(size_t size)
+{
+    return allocatePooled(size, false, kTagCore);
+}
+
+void* allocatePooled(size_t size)
+{
+    return allocatePooled(size, true, kTagCore);
+}
+
+//! OS capabilities for 'allocateWithFlags', detected on first use
+struct VirtualMemoryCaps
+{
+    std::once_flag once;
+    MemoryFlags available = kMemoryFlagUninitialized;
+    uint32_t numaNodeCount = 1;
+    size_t pageSize = 4096;
+    size_t largePageSize = 0;
+};
+static VirtualMemoryCaps s_virtual{};
+
+static void detectVirtualMemoryCaps()
+{
+#ifdef NVIGI_WINDOWS
+    SYSTEM_INFO info{};
+    GetSystemInfo(&info);
+    s_virtual.pageSize = info.dwPageSize;
+    ULONG highestNode = 0;
+    if (GetNumaHighestNodeNumber(&highestNode))
+    {
+        s_virtual.numaNodeCount = uint32_t(highestNode) + 1;
+    }
+    // Large pages need "Lock pages in memory" granted to the account AND enabled in the process token
+    HANDLE token{};
+    if (OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+    {
+        TOKEN_PRIVILEGES privileges{};
+        privileges.PrivilegeCount = 1;
+        privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+        // AdjustTokenPrivileges succeeds with ERROR_NOT_ALL_ASSIGNED when the account does not hold the privilege
+        if (LookupPrivilegeValueW(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid) &&
+            AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) && GetLastError() == ERROR_SUCCESS)
+        {
+            s_virtual.largePageSize = GetLargePageMinimum();
+        }
+        CloseHandle(token);
+    }
+    if (!s_virtual.largePageSize)
+    {
+        NVIGI_LOG_WARN("SeLockMemoryPrivilege is not available, large page allocations fall back to regular pages (grant 'Lock pages in memory' to enable them)");
+    }
+#else
+    s_virtual.pageSize = size_t(sysconf(_SC_PAGESIZE));
+#ifdef MADV_HUGEPAGE
+    // Transparent huge pages, no privileges needed but the kernel can still decide not to back the range with them
+    s_virtual.largePageSize = 2 * 1024 * 1024;
+#endif
+    while (s_virtual.numaNodeCount < 64)
+    {
+        auto node = std::string("/sys/devices/system/node/node") + std::to_string(s_virtual.numaNodeCount);
+        if (access(node.c_str(), F_OK) != 0) break;
+        s_virtual.numaNodeCount++;
+    }
+#endif
+    if (s_virtual.largePageSize) s_virtual.available |= kMemoryFlagLargePages;
+    if (s_virtual.numaNodeCount > 1) s_virtual.available |= kMemoryFlagNumaPreferred | kMemoryFlagNumaInterleave;
+    NVIGI_LOG_INFO("Memory: %u NUMA node(s), page %zuKB, large page %zuKB", s_virtual.numaNodeCount, s_virtual.pageSize / 1024, s_virtual.largePageSize / 1024);
+}
+
+static const VirtualMemoryCaps& getVirtualMemoryCaps()
+{
+    std::call_once(s_virtual.once, detectVirtualMemoryCaps);
+    return s_virtual;
+}
+
+inline size_t alignUp(size_t size, size_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+void* allocateVirtual(size_t size, MemoryFlags flags, uint32_t numaNode, uint16_t tag)
+{
     if (!size) return nullptr;
-    auto ptr = malloc(size);
-    memset(ptr, 0, size);
-#ifdef NVIGI_VALIDATE_MEMORY
-    std::scoped_lock lock(mtx);
-    assert(allocs.find(ptr) == allocs.end());
-    allocs[ptr] = size;
+    auto& caps = getVirtualMemoryCaps();
+    flags &= caps.available;
+    bool largePages = flags & kMemoryFlagLargePages;
+    bool interleave = flags & kMemoryFlagNumaInterleave;
+    bool preferred = !interleave && (flags & kMemoryFlagNumaPreferred) && numaNode < caps.numaNodeCount;
+
+    size_t regionSize = alignUp(size + kVirtualBlockOffset, caps.pageSize);
+    void* region{};
+#ifdef NVIGI_WINDOWS
+    auto process = GetCurrentProcess();
+    // Large pages must be reserved and committed in one go which rules out committing per node for interleaving
+    if (largePages && !interleave)
+    {
+        auto largeRegionSize = alignUp(size + kVirtualBlockOffset, caps.largePageSize);
+        DWORD type = MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES;
+        region = preferred ? VirtualAllocExNuma(process, nullptr, largeRegionSize, type, PAGE_READWRITE, numaNode) : VirtualAlloc(nullptr, largeRegionSize, type, PAGE_READWRITE);
+        if (region)
+        {
+            regionSize = largeRegionSize;
+        }
+        else
+        {
+            // Typically physical memory is too fragmented to find contiguous large pages
+            NVIGI_LOG_WARN_ONCE("Large page allocation of %zu bytes failed (error %u), falling back to regular pages", largeRegionSize, GetLastError());
+        }
+    }
+    if (!region && interleave)
+    {
+        region = VirtualAlloc(nullptr, regionSize, MEM_RESERVE, PAGE_READWRITE);
+        // Physical pages come from the node each chunk is committed for
+        constexpr size_t kInterleaveChunk = 2 * 1024 * 1024;
+        for (size_t offset = 0, node = 0; region && offset < regionSize; offset += kInterleaveChunk, node = (node + 1) % caps.numaNodeCount)
+        {
+            if (!VirtualAllocExNuma(process, (uint8_t*)region + offset, std::min(kInterleaveChunk, regionSize - offset), MEM_COMMIT, PAGE_READWRITE, DWORD(node)))
+            {
+                NVIGI_LOG_WARN_ONCE("Interleaved allocation of %zu bytes failed (error %u), falling back to default placement", regionSize, GetLastError());
+                VirtualFree(region, 0, MEM_RELEASE);
+                region = nullptr;
+            }
+        }
+    }
+    if (!region)
+    {
+        region = preferred ? VirtualAllocExNuma(process, nullptr, regionSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, numaNode) : VirtualAlloc(nullptr, regionSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    }
+#else
+    if (largePages) regionSize = alignUp(regionSize, caps.largePageSize);
+    region = mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED)
+    {
+        region = nullptr;
+    }
+    else
+    {
+#ifdef MADV_HUGEPAGE
+        if (largePages) madvise(region, regionSize, MADV_HUGEPAGE);
+#endif
+#ifdef SYS_mbind
+        if (interleave || preferred)
+        {
+            // MPOL_PREFERRED and MPOL_INTERLEAVE from linux/mempolicy.h, no libnuma dependency
+            constexpr int kPolicyPreferred = 1;
+            constexpr int kPolicyInterleave = 3;
+            unsigned long nodeMask = interleave ? (caps.numaNodeCount >= 64 ? ~0ul : (1ul << caps.numaNodeCount) - 1) : (1ul << numaNode);
+            if (syscall(SYS_mbind, region, regionSize, interleave ? kPolicyInterleave : kPolicyPreferred, &nodeMask, sizeof(nodeMask) * 8, 0) != 0)
+            {
+                NVIGI_LOG_WARN_ONCE("mbind failed with errno %d, using default NUMA placement", errno);
+            }
+        }
+#endif
+    }
+#endif
+    if (!region)
+    {
+        NVIGI_LOG_ERROR("Failed to allocate %zu bytes with flags 0x%x", size, flags);
+        return nullptr;
+    }
+    // Fresh OS pages are always zeroed so there is nothing to do for initialized allocations
+    auto payload = (uint8_t*)region + kVirtualBlockOffset;
+    return finalize(payload, kSizeClassVirtual, regionSize, tag);
+}
+
+void* allocateWithFlags(size_t size, MemoryFlags flags, uint32_t numaNode)
+{
+    return allocateVirtual(size, flags, numaNode, kTagCore);
+}
+
+void deallocateVirtual(void* ptr, size_t regionSize)
+{
+    auto region = (uint8_t*)ptr - kVirtualBlockOffset;
+#ifdef NVIGI_WINDOWS
+    (void)regionSize;
+    VirtualFree(region, 0, MEM_RELEASE);
+#else
+    munmap(region, regionSize);
 #endif
-    return ptr;
 }
 
+MemoryFlags getAvailableFlags()
+{
+    return getVirtualMemoryCaps().available;
+}
+
+uint32_t getNumaNodeCount()
+{
+    return getVirtualMemoryCaps().numaNodeCount;
+}
+
+//! Shared by both allocators, block header tells us where memory came from
 void deallocate(void* ptr)
 {
     if (!ptr) return;
     //NVIGI_LOG_HINT("deallocate 0x%llx", ptr);
+    auto header = (BlockHeader*)ptr - 1;
 #ifdef NVIGI_VALIDATE_MEMORY
-    std::scoped_lock lock(mtx);
-    assert(allocs.find(ptr) != allocs.end());
-    allocs.erase(ptr);
+    assert(header->magic == kBlockMagic);
+    untrack(ptr);
 #endif
-    free(ptr);
+    unaccount(header->tag, header->size);
+    if (header->sizeClass == kSizeClassSystem)
+    {
+        free(header);
+    }
+    else if (header->sizeClass == kSizeClassVirtual)
+    {
+        deallocateVirtual(ptr, header->size);
+    }
+    else
+    {
+        pushBlock(header->sizeClass, ptr);
+    }
 }
 
 #ifdef NVIGI_VALIDATE_MEMORY
 size_t getNumAllocations() 
 {
-    std::scoped_lock lock(mtx);
-    return allocs.size(); 
+    size_t count = 0;
+    for (size_t i = 0; i < kNumTrackingShards; i++)
+    {
+        std::scoped_lock lock(s_tracking[i].mtx);
+        count += s_tracking[i].allocs.size();
+    }
+    return count;
 }
 
 void dumpAllocations()
 {
-    std::scoped_lock lock(mtx);
     printf("Remaining allocations:\n");
-    for (auto [ptr, sz] : allocs)
+    for (size_t i = 0; i < kNumTrackingShards; i++)
     {
-        printf("%p size %llu\n", (void*)ptr, (long long unsigned int)sz);
+        std::scoped_lock lock(s_tracking[i].mtx);
+        for (auto [ptr, sz] : s_tracking[i].allocs)
+        {
+            printf("%p size %llu\n", (void*)ptr, (long long unsigned int)sz);
+        }
     }
 }
 #endif
 
+std::atomic<bool> s_usePooled = false;
+
+//! Tagged entry points, one instantiation per tag since the interface does not carry any context
+template<uint16_t Tag>
+struct TaggedEntryPoints
+{
+    static void* allocate(size_t size)
+    {
+        return s_usePooled.load(std::memory_order_relaxed) ? allocatePooled(size, true, Tag) : allocateSystem(size, true, Tag);
+    }
+    static void* allocateUninitialized(size_t size)
+    {
+        return s_usePooled.load(std::memory_order_relaxed) ? allocatePooled(size, false, Tag) : allocateSystem(size, false, Tag);
+    }
+    static void* allocateWithFlags(size_t size, MemoryFlags flags, uint32_t numaNode)
+    {
+        return allocateVirtual(size, flags, numaNode, Tag);
+    }
+};
+
+struct TaggedFunctions
+{
+    void* (*allocate)(size_t);
+    void* (*allocateUninitialized)(size_t);
+    void* (*allocateWithFlags)(size_t, MemoryFlags, uint32_t);
+};
+
+template<size_t... Tags>
+constexpr std::array<TaggedFunctions, sizeof...(Tags)> makeTaggedFunctions(std::index_sequence<Tags...>)
+{
+    return { { { &TaggedEntryPoints<Tags>::allocate, &TaggedEntryPoints<Tags>::allocateUninitialized, &TaggedEntryPoints<Tags>::allocateWithFlags }... } };
+}
+constexpr auto s_taggedFunctions = makeTaggedFunctions(std::make_index_sequence<kMaxMemoryTags>());
+
 IMemoryManager s_mm{};
-IMemoryManager* getInterface() 
-{ 
+IMemoryManager s_mmPooled{};
+IMemoryManager s_mmTagged[kMaxMemoryTags]{};
+
+IMemoryManager* getTaggedInterface(const char* tag);
+
+uint32_t getAllocationStats(MemoryTagStats* stats, uint32_t maxCount)
+{
+    auto count = s_tagCount.load();
+    for (uint32_t i = 0; i < count && i < maxCount && stats; i++)
+    {
+        auto& counters = s_tags[i];
+        auto& out = stats[i];
+        out.name = counters.name;
+        out.liveBytes = uint64_t(std::max<int64_t>(0, counters.liveBytes.load(std::memory_order_relaxed)));
+        out.peakBytes = uint64_t(counters.peakBytes.load(std::memory_order_relaxed));
+        out.liveAllocations = uint64_t(std::max<int64_t>(0, counters.liveAllocations.load(std::memory_order_relaxed)));
+        out.totalAllocations = counters.totalAllocations.load(std::memory_order_relaxed);
+        out.totalBytesAllocated = counters.totalBytesAllocated.load(std::memory_order_relaxed);
+        for (uint32_t j = 0; j < kMemorySizeBucketCount; j++)
+        {
+            out.sizeHistogram[j] = counters.sizeHistogram[j].load(std::memory_order_relaxed);
+        }
+    }
+    return count;
+}
+
+IMemoryManager* getSystemInterface()
+{
     if (!s_mm.allocate)
     {
         s_mm.allocate = allocate;
@@ -82,8 +637,80 @@ IMemoryManager* getInterface()
         s_mm.getNumAllocations = getNumAllocations;
         s_mm.dumpAllocations = dumpAllocations;
 #endif
+        s_mm.allocateUninitialized = allocateSystemUninitialized;
+        s_mm.allocateWithFlags = allocateWithFlags;
+        s_mm.getAvailableFlags = getAvailableFlags;
+        s_mm.getNumaNodeCount = getNumaNodeCount;
+        s_mm.getTaggedInterface = getTaggedInterface;
+        s_mm.getAllocationStats = getAllocationStats;
+    }
+    return &s_mm;
+}
+
+IMemoryManager* getPooledInterface()
+{
+    if (!s_mmPooled.allocate)
+    {
+        s_mmPooled.allocate = allocatePooled;
+        s_mmPooled.deallocate = deallocate;
+#ifdef NVIGI_VALIDATE_MEMORY
+        s_mmPooled.getNumAllocations = getNumAllocations;
+        s_mmPooled.dumpAllocations = dumpAllocations;
+#endif
+        s_mmPooled.allocateUninitialized = allocatePooledUninitialized;
+        s_mmPooled.allocateWithFlags = allocateWithFlags;
+        s_mmPooled.getAvailableFlags = getAvailableFlags;
+        s_mmPooled.getNumaNodeCount = getNumaNodeCount;
+        s_mmPooled.getTaggedInterface = getTaggedInterface;
+        s_mmPooled.getAllocationStats = getAllocationStats;
+    }
+    return &s_mmPooled;
+}
+
+IMemoryManager* getTaggedInterface(const char* tag)
+{
+    if (!tag || !*tag) return getInterface();
+    std::scoped_lock lock(s_tagsMtx);
+    uint16_t index = kTagOther;
+    for (uint16_t i = 0; i < s_tagCount; i++)
+    {
+        if (strncmp(s_tags[i].name, tag, sizeof(s_tags[i].name) - 1) == 0)
+        {
+            index = i;
+            break;
+        }
     }
-    return &s_mm; 
+    if (index == kTagOther && s_tagCount < kTagOther)
+    {
+        // Name first, 'getAllocationStats' reads it without the lock as soon as the new count is visible
+        index = uint16_t(s_tagCount.load());
+        strncpy(s_tags[index].name, tag, sizeof(s_tags[index].name) - 1);
+        s_tagCount.store(index + 1u, std::memory_order_release);
+    }
+    else if (index == kTagOther)
+    {
+        NVIGI_LOG_WARN_ONCE("Out of memory accounting tags, allocations made by '%s' and later plugins are reported as 'nvigi.other'", tag);
+        s_tagCount = kMaxMemoryTags;
+    }
+    auto& mm = s_mmTagged[index];
+    if (!mm.allocate)
+    {
+        mm = *getSystemInterface();
+        mm.allocate = s_taggedFunctions[index].allocate;
+        mm.allocateUninitialized = s_taggedFunctions[index].allocateUninitialized;
+        mm.allocateWithFlags = s_taggedFunctions[index].allocateWithFlags;
+    }
+    return &mm;
+}
+
+void setPooledAllocator(bool enable)
+{
+    s_usePooled = enable;
+}
+
+IMemoryManager* getInterface() 
+{ 
+    return s_usePooled ? getPooledInterface() : getSystemInterface();
 }
 
 }
@@ -12,13 +12,87 @@ namespace nvigi
 namespace memory
 {
 
+//! Placement hints for large, long lived allocations (model weights, KV caches) see 'IMemoryManager::allocateWithFlags'
+//!
+//! Every flag is a hint, if the OS or process privileges do not allow it the allocation silently falls back
+//! to regular pages / default placement (reported once in the log and via 'getAvailableFlags')
+using MemoryFlags = uint32_t;
+constexpr MemoryFlags kMemoryFlagNone = 0x0;
+//! Content is undefined, use when entire buffer is overwritten anyway
+constexpr MemoryFlags kMemoryFlagUninitialized = 0x01;
+//! Large (Windows, requires SeLockMemoryPrivilege) or transparent huge (Linux) pages, fewer TLB misses on multi-GB weights
+constexpr MemoryFlags kMemoryFlagLargePages = 0x02;
+//! Prefer physical memory on the given NUMA node
+constexpr MemoryFlags kMemoryFlagNumaPreferred = 0x04;
+//! Spread pages round robin across all NUMA nodes, best for data read by threads on every socket
+constexpr MemoryFlags kMemoryFlagNumaInterleave = 0x08;
+
+//! Allocation size buckets, bucket 'i' counts allocations up to 16 << i bytes, the last one everything larger (over 4MB)
+constexpr uint32_t kMemorySizeBucketCount = 20;
+//! Distinct tags (plugins) accounted separately, tags registered beyond this limit share "nvigi.other"
+constexpr uint32_t kMaxMemoryTags = 64;
+
+//! Allocation counters for one tag, see 'IMemoryManager::getAllocationStats'
+//!
+//! {2E24A677-1337-463B-8FF9-FCC451BE8881}
+struct alignas(8) MemoryTagStats {
+    MemoryTagStats() {};
+    NVIGI_UID(UID({ 0x2e24a677, 0x1337, 0x463b,{ 0x8f, 0xf9, 0xfc, 0xc4, 0x51, 0xbe, 0x88, 0x81 } }), kStructVersion1)
+
+    //! Plugin name, "nvigi.core" covers the framework, host and plugins running on an older core. Valid until nvigiShutdown
+    const char* name{};
+    uint64_t liveBytes{};
+    uint64_t peakBytes{};
+    uint64_t liveAllocations{};
+    //! Since startup, allocation rate is the difference between two snapshots
+    uint64_t totalAllocations{};
+    uint64_t totalBytesAllocated{};
+    uint64_t sizeHistogram[kMemorySizeBucketCount]{};
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(MemoryTagStats)
+
 // {8A6572E0-F713-44C7-A2BF-8493A9499EB2}
 struct alignas(8) IMemoryManager {
     IMemoryManager() {}; 
-    NVIGI_UID(UID({ 0x8a6572e0, 0xf713, 0x44c7,{ 0xa2, 0xbf, 0x84, 0x93, 0xa9, 0x49, 0x9e, 0xb2 } }), kStructVersion1)
+    NVIGI_UID(UID({ 0x8a6572e0, 0xf713, 0x44c7,{ 0xa2, 0xbf, 0x84, 0x93, 0xa9, 0x49, 0x9e, 0xb2 } }), kStructVersion4)
+    //! Returns zero initialized memory
     void* (*allocate)(size_t bytes);
+    //! Releases memory obtained from any of the allocate methods, from any thread
     void (*deallocate)(void* ptr);
+
+    //! v2
+    //! 
+    //! Same as allocate but memory content is undefined, use when entire buffer is overwritten anyway
+    void* (*allocateUninitialized)(size_t bytes);
+
+    //! v3
+    //! 
+    //! Page granular allocation with placement hints, 'numaNode' is used only with kMemoryFlagNumaPreferred.
+    //! Always goes to the OS (never pooled) so meant for big buffers, release with 'deallocate' as usual.
+    void* (*allocateWithFlags)(size_t bytes, MemoryFlags flags, uint32_t numaNode);
+    //! Flags which are actually honored in this process, e.g. kMemoryFlagLargePages is missing without SeLockMemoryPrivilege
+    MemoryFlags (*getAvailableFlags)();
+    //! Number of NUMA nodes, 1 on single socket systems
+    uint32_t (*getNumaNodeCount)();
+
+    //! v4
+    //! 
+    //! Allocation accounting, always on and a few relaxed atomics per allocation
+    //! 
+    //! Returns interface with the same allocators accounting everything to 'tag', same tag always maps to the same counters.
+    //! Plugins switch to their own tagged interface on registration so no changes are needed in the plugin code.
+    //! Memory can be released through any interface, it is always credited back to the tag which allocated it.
+    IMemoryManager* (*getTaggedInterface)(const char* tag);
+    //! Fills up to 'maxCount' snapshots (v1 structures) and returns the number of tags in use
+    uint32_t (*getAllocationStats)(MemoryTagStats* stats, uint32_t maxCount);
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+
 #ifdef NVIGI_VALIDATE_MEMORY
+    //! Validation builds only, kept last so offsets of the versioned members above do not depend on the build config
     size_t (*getNumAllocations)();
     void (*dumpAllocations)();
 #endif
@@ -27,6 +101,20 @@ struct alignas(8) IMemoryManager {
 NVIGI_VALIDATE_STRUCT(IMemoryManager)
 
 IMemoryManager* getInterface();
+
+//! Helper for callers which might get v1 interface from an older core
+inline void* allocateUninitialized(IMemoryManager* mm, size_t bytes)
+{
+    if (mm->getVersion() >= kStructVersion2 && mm->allocateUninitialized) return mm->allocateUninitialized(bytes);
+    return mm->allocate(bytes);
+}
+
+//! Helper for callers which might get v2 or older interface from an older core, flags are dropped in that case
+inline void* allocateWithFlags(IMemoryManager* mm, size_t bytes, MemoryFlags flags, uint32_t numaNode = 0)
+{
+    if (mm->getVersion() >= kStructVersion3 && mm->allocateWithFlags) return mm->allocateWithFlags(bytes, flags, numaNode);
+    return (flags & kMemoryFlagUninitialized) ? allocateUninitialized(mm, bytes) : mm->allocate(bytes);
+}
 }
 
 }
\ No newline at end of file
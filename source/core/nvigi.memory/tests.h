@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "source/core/nvigi.memory/memory.h"
+
+//! Unit tests for per plugin allocation accounting
+//!
+namespace nvigi
+{
+
+namespace memory
+{
+
+TEST_CASE("memory::IMemoryManager tagged allocation stats", "[memory][stats]") {
+    REQUIRE(params.imem != nullptr);
+    if (params.imem->getVersion() < 4) return;
+
+    auto findTag = [](const char* name, MemoryTagStats& out)->bool
+    {
+        std::vector<MemoryTagStats> stats(kMaxMemoryTags);
+        auto count = params.imem->getAllocationStats(stats.data(), (uint32_t)stats.size());
+        for (uint32_t i = 0; i < count && i < kMaxMemoryTags; i++)
+        {
+            if (strcmp(stats[i].name, name) == 0)
+            {
+                out = stats[i];
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto tagged = params.imem->getTaggedInterface("nvigi.test.memory");
+    REQUIRE(tagged != nullptr);
+    // Same tag, same interface
+    REQUIRE(tagged == params.imem->getTaggedInterface("nvigi.test.memory"));
+
+    // Untagged allocations are always reported
+    MemoryTagStats core{};
+    REQUIRE(findTag("nvigi.core", core));
+
+    MemoryTagStats before{};
+    REQUIRE(findTag("nvigi.test.memory", before));
+
+    void* small = tagged->allocate(8);
+    void* large = tagged->allocateUninitialized(1024 * 1024);
+    REQUIRE(small != nullptr);
+    REQUIRE(large != nullptr);
+
+    MemoryTagStats during{};
+    REQUIRE(findTag("nvigi.test.memory", during));
+    REQUIRE(during.liveAllocations == before.liveAllocations + 2);
+    REQUIRE(during.liveBytes == before.liveBytes + 8 + 1024 * 1024);
+    REQUIRE(during.peakBytes >= during.liveBytes);
+    REQUIRE(during.totalAllocations == before.totalAllocations + 2);
+    REQUIRE(during.sizeHistogram[0] == before.sizeHistogram[0] + 1);
+    // 1MB == 16 << 16
+    REQUIRE(during.sizeHistogram[16] == before.sizeHistogram[16] + 1);
+
+    // Any interface can free, the block remembers its tag
+    params.imem->deallocate(small);
+    tagged->deallocate(large);
+
+    MemoryTagStats after{};
+    REQUIRE(findTag("nvigi.test.memory", after));
+    REQUIRE(after.liveAllocations == before.liveAllocations);
+    REQUIRE(after.liveBytes == before.liveBytes);
+    REQUIRE(after.peakBytes == during.peakBytes);
+    REQUIRE(after.totalBytesAllocated == before.totalBytesAllocated + 8 + 1024 * 1024);
+}
+
+}
+}
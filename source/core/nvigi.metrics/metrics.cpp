@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "source/core/nvigi.metrics/metrics.h"
+#include "source/core/nvigi.log/log.h"
+
+namespace nvigi
+{
+namespace metrics
+{
+
+struct Entry
+{
+    PluginID plugin{};
+    std::string name;
+    LatencyHistogram histogram{};
+};
+
+struct MetricsContext
+{
+    //! Only guards the list, recording goes straight to the histograms
+    std::mutex mtx;
+    //! Entries are never removed before shutdown, plugins keep raw pointers to the histograms
+    std::vector<std::unique_ptr<Entry>> entries;
+};
+
+static MetricsContext s_ctx{};
+static IMetrics s_metrics{};
+
+bool matches(const Entry& entry, const PluginID* plugin, const char* name)
+{
+    return (!plugin || entry.plugin == *plugin) && (!name || entry.name == name);
+}
+
+Result getHistogram(const PluginID& plugin, const char* name, LatencyHistogram** histogram)
+{
+    if (!name || !histogram) return kResultInvalidParameter;
+    std::scoped_lock lock(s_ctx.mtx);
+    for (auto& entry : s_ctx.entries)
+    {
+        if (matches(*entry, &plugin, name))
+        {
+            *histogram = &entry->histogram;
+            return kResultOk;
+        }
+    }
+    auto& entry = s_ctx.entries.emplace_back(std::make_unique<Entry>());
+    entry->plugin = plugin;
+    entry->name = name;
+    *histogram = &entry->histogram;
+    return kResultOk;
+}
+
+Result enumerate(const PluginID* plugin, PFun_HistogramCallback* callback, void* userData)
+{
+    if (!callback) return kResultInvalidParameter;
+    // Snapshot the list first so callbacks can call back into the registry
+    std::vector<Entry*> entries;
+    {
+        std::scoped_lock lock(s_ctx.mtx);
+        for (auto& entry : s_ctx.entries)
+        {
+            if (matches(*entry, plugin, nullptr)) entries.push_back(entry.get());
+        }
+    }
+    for (auto entry : entries)
+    {
+        HistogramSnapshot snapshot{};
+        entry->histogram.snapshot(snapshot);
+        snapshot.name = entry->name.c_str();
+        snapshot.plugin = entry->plugin;
+        callback(&snapshot, userData);
+    }
+    return kResultOk;
+}
+
+Result reset(const PluginID* plugin, const char* name)
+{
+    std::scoped_lock lock(s_ctx.mtx);
+    for (auto& entry : s_ctx.entries)
+    {
+        if (matches(*entry, plugin, name)) entry->histogram.reset();
+    }
+    return kResultOk;
+}
+
+//! Called by the framework on nvigiShutdown once all plugins are unloaded
+void shutdown()
+{
+    std::scoped_lock lock(s_ctx.mtx);
+    s_ctx.entries.clear();
+    s_ctx.entries.shrink_to_fit();
+}
+
+IMetrics* getInterface()
+{
+    if (!s_metrics.getHistogram)
+    {
+        s_metrics.getHistogram = getHistogram;
+        s_metrics.enumerate = enumerate;
+        s_metrics.reset = reset;
+    }
+    return &s_metrics;
+}
+
+}
+}
@@ -0,0 +1,193 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <algorithm>
+#include <cmath>
+
+#include "source/core/nvigi.api/nvigi.h"
+
+namespace nvigi
+{
+
+namespace metrics
+{
+
+//! Log-linear bucketing, 32 sub-buckets per power of two keeps the relative error below 3.2%
+constexpr uint32_t kHistogramSubBucketBits = 5;
+constexpr uint32_t kHistogramSubBucketCount = 1u << kHistogramSubBucketBits;
+//! Values up to 2^40us (~12 days), anything larger lands in the last bucket
+constexpr uint32_t kHistogramMagnitudeCount = 40;
+constexpr uint32_t kHistogramBucketCount = (kHistogramMagnitudeCount - kHistogramSubBucketBits + 1) * kHistogramSubBucketCount;
+
+//! Point in time view of a histogram, all values in microseconds
+//!
+//! {91571AC6-C474-491D-9C8F-BEB945378A73}
+struct alignas(8) HistogramSnapshot {
+    HistogramSnapshot() {};
+    NVIGI_UID(UID({ 0x91571ac6, 0xc474, 0x491d,{ 0x9c, 0x8f, 0xbe, 0xb9, 0x45, 0x37, 0x8a, 0x73 } }), kStructVersion1)
+
+    //! Valid until nvigiShutdown
+    const char* name{};
+    PluginID plugin{};
+    uint64_t count{};
+    uint64_t min{};
+    uint64_t max{};
+    double mean{};
+    uint64_t p50{};
+    uint64_t p90{};
+    uint64_t p95{};
+    uint64_t p99{};
+    uint64_t p999{};
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(HistogramSnapshot)
+
+//! Lock-free HDR style latency histogram
+//!
+//! Any number of threads can 'record' concurrently, each record is a handful of relaxed atomics.
+//! 'snapshot' and 'reset' can run at the same time as 'record', a sample landing in the middle of either
+//! is counted in the next snapshot or lost, it never corrupts the histogram.
+struct LatencyHistogram
+{
+    static constexpr uint32_t getBucketIndex(uint64_t value)
+    {
+        if (value < kHistogramSubBucketCount) return uint32_t(value);
+        uint32_t msb = 63 - uint32_t(std::countl_zero(value));
+        if (msb >= kHistogramMagnitudeCount) return kHistogramBucketCount - 1;
+        uint32_t shift = msb - kHistogramSubBucketBits;
+        return (shift + 1) * kHistogramSubBucketCount + uint32_t((value >> shift) - kHistogramSubBucketCount);
+    }
+
+    //! Midpoint of the range of values mapped to 'index'
+    static constexpr uint64_t getBucketValue(uint32_t index)
+    {
+        if (index < kHistogramSubBucketCount) return index;
+        uint32_t shift = index / kHistogramSubBucketCount - 1;
+        uint64_t lower = uint64_t(kHistogramSubBucketCount + index % kHistogramSubBucketCount) << shift;
+        return lower + ((1ull << shift) >> 1);
+    }
+
+    void record(uint64_t value)
+    {
+        buckets[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(value, std::memory_order_relaxed);
+        auto current = minValue.load(std::memory_order_relaxed);
+        while (value < current && !minValue.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+        current = maxValue.load(std::memory_order_relaxed);
+        while (value > current && !maxValue.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+
+    void reset()
+    {
+        for (auto& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+        count.store(0, std::memory_order_relaxed);
+        sum.store(0, std::memory_order_relaxed);
+        minValue.store(UINT64_MAX, std::memory_order_relaxed);
+        maxValue.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+
+    //! Fills in statistics only, name and plugin are up to the caller
+    void snapshot(HistogramSnapshot& out) const
+    {
+        // Percentiles come from one pass over the buckets so they are consistent with each other
+        uint64_t counts[kHistogramBucketCount];
+        uint64_t total = 0;
+        for (uint32_t i = 0; i < kHistogramBucketCount; i++)
+        {
+            counts[i] = buckets[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+        out.count = total;
+        out.mean = total ? double(sum.load(std::memory_order_relaxed)) / double(total) : 0.0;
+        out.min = total ? minValue.load(std::memory_order_relaxed) : 0;
+        out.max = maxValue.load(std::memory_order_relaxed);
+
+        struct { double percentile; uint64_t* value; } targets[] = {
+            { 50.0, &out.p50 }, { 90.0, &out.p90 }, { 95.0, &out.p95 }, { 99.0, &out.p99 }, { 99.9, &out.p999 }
+        };
+        uint64_t cumulative = 0;
+        uint32_t bucket = 0;
+        for (auto& target : targets)
+        {
+            *target.value = 0;
+            if (!total) continue;
+            auto rank = std::max<uint64_t>(1, uint64_t(std::ceil(target.percentile / 100.0 * double(total))));
+            while (bucket < kHistogramBucketCount && cumulative + counts[bucket] < rank)
+            {
+                cumulative += counts[bucket++];
+            }
+            auto value = getBucketValue(std::min(bucket, kHistogramBucketCount - 1));
+            // Bucket midpoint can fall outside of what was actually recorded
+            *target.value = std::clamp(value, out.min, std::max(out.min, out.max));
+        }
+    }
+
+    std::atomic<uint64_t> buckets[kHistogramBucketCount]{};
+    std::atomic<uint64_t> count{};
+    std::atomic<uint64_t> sum{};
+    std::atomic<uint64_t> minValue{ UINT64_MAX };
+    std::atomic<uint64_t> maxValue{};
+};
+
+//! Called once per histogram, snapshot is only valid during the callback
+using PFun_HistogramCallback = void(const HistogramSnapshot* snapshot, void* userData);
+
+//! Interface 'IMetrics'
+//!
+//! Registry of named latency histograms shared by all plugins, 'ModernPluginBase' feeds these automatically:
+//!
+//! "queue_wait_us"             - time an execution context spent queued before evaluation started
+//! "evaluate_us"               - duration of one evaluation
+//! "time_to_first_result_us"   - evaluation start to the first (partial) result
+//! "time_between_results_us"   - time between consecutive partial results
+//! "callback_us"               - time spent in the host callback
+//! "cancel_to_idle_us"         - cancelAsyncEvaluation request until the evaluation actually stopped
+//!
+//! Framework records plugin startup as "startup_validate_us", "startup_load_library_us", "startup_get_info_us" and
+//! "startup_register_us" per plugin and "startup_scan_us" per plugin directory (against nvigi::core::framework::kId).
+//!
+//! Plugins obtain this interface from 'IFramework', hosts via nvigiGetInterface(nvigi::core::framework::kId, &metrics).
+//! Snapshots and resets never block recording, inference keeps running.
+//!
+//! {C0622855-15FC-4E95-AEC1-90B740CF7C0A}
+struct alignas(8) IMetrics {
+    IMetrics() {};
+    NVIGI_UID(UID({ 0xc0622855, 0x15fc, 0x4e95,{ 0xae, 0xc1, 0x90, 0xb7, 0x40, 0xcf, 0x7c, 0x0a } }), kStructVersion1)
+
+    //! Returns existing histogram or creates a new one, pointer stays valid until nvigiShutdown
+    Result (*getHistogram)(const PluginID& plugin, const char* name, LatencyHistogram** histogram);
+
+    //! Snapshots every histogram registered by 'plugin' (or all of them if null)
+    Result (*enumerate)(const PluginID* plugin, PFun_HistogramCallback* callback, void* userData);
+
+    //! Resets histograms matching 'plugin' and 'name', null matches everything
+    Result (*reset)(const PluginID* plugin, const char* name);
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(IMetrics)
+
+//! Null when running on an older core
+IMetrics* getInterface();
+
+//! Convenience helper for plugins, returns null if metrics are not available
+inline LatencyHistogram* getHistogram(const PluginID& plugin, const char* name)
+{
+    LatencyHistogram* histogram{};
+    if (auto i = getInterface()) i->getHistogram(plugin, name, &histogram);
+    return histogram;
+}
+
+}
+}
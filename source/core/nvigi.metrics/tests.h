@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "source/core/nvigi.metrics/metrics.h"
+
+//! Unit tests for latency histograms
+//!
+namespace nvigi
+{
+
+namespace metrics
+{
+
+#ifndef NVIGI_PRODUCTION
+TEST_CASE("metrics::LatencyHistogram percentiles", "[metrics][histogram]") {
+    auto histogram = std::make_unique<LatencyHistogram>();
+    HistogramSnapshot snapshot{};
+    histogram->snapshot(snapshot);
+    REQUIRE(snapshot.count == 0);
+    REQUIRE(snapshot.p99 == 0);
+
+    // 1..10000us recorded from several threads at once
+    std::vector<std::thread> threads;
+    for (uint64_t t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&histogram, t]()->void
+        {
+            for (uint64_t v = 1 + t; v <= 10000; v += 4) histogram->record(v);
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    histogram->snapshot(snapshot);
+    REQUIRE(snapshot.count == 10000);
+    REQUIRE(snapshot.min == 1);
+    REQUIRE(snapshot.max == 10000);
+    REQUIRE(snapshot.mean == Approx(5000.5));
+    // Within the bucket resolution
+    REQUIRE(snapshot.p50 == Approx(5000).epsilon(0.032));
+    REQUIRE(snapshot.p95 == Approx(9500).epsilon(0.032));
+    REQUIRE(snapshot.p99 == Approx(9900).epsilon(0.032));
+    REQUIRE(snapshot.p999 <= snapshot.max);
+
+    histogram->reset();
+    histogram->snapshot(snapshot);
+    REQUIRE(snapshot.count == 0);
+}
+#endif
+
+}
+}
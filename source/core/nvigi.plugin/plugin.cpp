@@ -6,6 +6,10 @@
 #include "source/core/nvigi.log/log.h"
 #include "source/core/nvigi.file/file.h"
 #include "source/core/nvigi.exception/exception.h"
+#include "source/core/nvigi.simd/simd.h"
+#include "source/core/nvigi.trace/trace.h"
+#include "source/core/nvigi.metrics/metrics.h"
+#include "source/core/nvigi.resources/resources.h"
 #include "source/core/nvigi.types/types.h"
 #include "source/core/nvigi.framework/framework.h"
 
@@ -36,6 +40,30 @@ ISystem* s_system{};
 ISystem* getInterface() { return s_system; }
 }
 
+namespace simd
+{
+ISimd* s_simd{};
+ISimd* getInterface() { return s_simd; }
+}
+
+namespace trace
+{
+ITrace* s_trace{};
+ITrace* getInterface() { return s_trace; }
+}
+
+namespace metrics
+{
+IMetrics* s_metrics{};
+IMetrics* getInterface() { return s_metrics; }
+}
+
+namespace resources
+{
+IModelCache* s_cache{};
+IModelCache* getInterface() { return s_cache; }
+}
+
 namespace plugin
 {
 
@@ -45,8 +73,19 @@ bool internalPluginSetup(nvigi::framework::IFramework* framework)
 
     if (!framework::getInterface(framework, nvigi::core::framework::kId, &exception::s_exception)) return false;
     if (!framework::getInterface(framework, nvigi::core::framework::kId, &memory::s_mm)) return false;
+    if (memory::s_mm->getVersion() >= 4)
+    {
+        // Everything this plugin allocates through 'nvigi::memory' is accounted under its name
+        memory::s_mm = memory::s_mm->getTaggedInterface(ctx->pluginName.c_str());
+    }
     if (!framework::getInterface(framework, nvigi::core::framework::kId, &log::s_log)) return false;
+    log::resetLevelCache();
     if (!framework::getInterface(framework, nvigi::core::framework::kId, &system::s_system)) return false;
+    // Optional, older cores do not provide SIMD kernels, tracing, metrics or the model cache
+    framework::getInterface(framework, nvigi::core::framework::kId, &simd::s_simd);
+    framework::getInterface(framework, nvigi::core::framework::kId, &trace::s_trace);
+    framework::getInterface(framework, nvigi::core::framework::kId, &metrics::s_metrics);
+    framework::getInterface(framework, nvigi::core::framework::kId, &resources::s_cache);
 
     ctx->framework = framework;
 
@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "source/core/nvigi.resources/resources.h"
+#include "source/core/nvigi.log/log.h"
+#include "source/core/nvigi.extra/extra.h"
+
+namespace nvigi
+{
+namespace resources
+{
+
+struct Entry
+{
+    PluginID plugin{};
+    std::string modelGUID;
+    std::string backend;
+    uint32_t device{};
+
+    void* resource{};
+    size_t sizeInBytes{};
+    PFun_ModelResourceDestroy* destroy{};
+    uint64_t references{};
+    //! Set while the first acquire is running 'create', others wait on 'ModelCacheContext::loaded'
+    bool loading{};
+    Result loadResult = kResultOk;
+};
+
+struct ModelCacheContext
+{
+    std::mutex mtx;
+    std::condition_variable loaded;
+    std::vector<std::shared_ptr<Entry>> entries;
+    uint64_t hits{};
+    uint64_t misses{};
+};
+
+static ModelCacheContext s_ctx{};
+static IModelCache s_cache{};
+
+bool matches(const Entry& entry, const ModelResourceKey& key)
+{
+    return entry.plugin == key.plugin && entry.device == key.device &&
+        entry.modelGUID == (key.modelGUID ? key.modelGUID : "") && entry.backend == (key.backend ? key.backend : "");
+}
+
+Result acquire(const ModelResourceKey& key, PFun_ModelResourceCreate* create, PFun_ModelResourceDestroy* destroy, void* userData, void** resource)
+{
+    if (!create || !destroy || !resource) return kResultInvalidParameter;
+
+    std::shared_ptr<Entry> entry;
+    {
+        std::unique_lock lock(s_ctx.mtx);
+        while (true)
+        {
+            entry.reset();
+            for (auto& e : s_ctx.entries)
+            {
+                if (matches(*e, key))
+                {
+                    entry = e;
+                    break;
+                }
+            }
+            if (!entry || !entry->loading) break;
+            // Someone else is loading this model, wait and check again since the load can fail
+            s_ctx.loaded.wait(lock);
+        }
+
+        if (entry)
+        {
+            entry->references++;
+            s_ctx.hits++;
+            *resource = entry->resource;
+            return kResultOk;
+        }
+
+        entry = std::make_shared<Entry>();
+        entry->plugin = key.plugin;
+        entry->modelGUID = key.modelGUID ? key.modelGUID : "";
+        entry->backend = key.backend ? key.backend : "";
+        entry->device = key.device;
+        entry->destroy = destroy;
+        entry->loading = true;
+        s_ctx.entries.push_back(entry);
+        s_ctx.misses++;
+    }
+
+    // Loading can take seconds, other models and other keys must not be blocked
+    void* data{};
+    size_t sizeInBytes{};
+    auto result = create(userData, &data, &sizeInBytes);
+
+    std::scoped_lock lock(s_ctx.mtx);
+    entry->loading = false;
+    if (result != kResultOk || !data)
+    {
+        std::erase(s_ctx.entries, entry);
+        s_ctx.loaded.notify_all();
+        return result != kResultOk ? result : kResultInvalidState;
+    }
+    entry->resource = data;
+    entry->sizeInBytes = sizeInBytes;
+    entry->references = 1;
+    s_ctx.loaded.notify_all();
+    NVIGI_LOG_VERBOSE("Model cache loaded '%s' (%s device %u) %lluMB", entry->modelGUID.c_str(), entry->backend.c_str(), entry->device, (unsigned long long)(sizeInBytes / (1024 * 1024)));
+    *resource = data;
+    return kResultOk;
+}
+
+Result release(void* resource)
+{
+    if (!resource) return kResultInvalidParameter;
+
+    std::shared_ptr<Entry> entry;
+    {
+        std::scoped_lock lock(s_ctx.mtx);
+        for (auto& e : s_ctx.entries)
+        {
+            if (!e->loading && e->resource == resource)
+            {
+                entry = e;
+                break;
+            }
+        }
+        if (!entry) return kResultItemNotFound;
+        if (--entry->references) return kResultOk;
+        std::erase(s_ctx.entries, entry);
+    }
+
+    // Outside of the lock, freeing VRAM can block
+    NVIGI_LOG_VERBOSE("Model cache released '%s' (%s device %u)", entry->modelGUID.c_str(), entry->backend.c_str(), entry->device);
+    entry->destroy(entry->resource);
+    return kResultOk;
+}
+
+Result getStats(ModelCacheStats* stats)
+{
+    if (!stats) return kResultInvalidParameter;
+    std::scoped_lock lock(s_ctx.mtx);
+    stats->entries = 0;
+    stats->references = 0;
+    stats->sizeInBytes = 0;
+    for (auto& e : s_ctx.entries)
+    {
+        if (e->loading) continue;
+        stats->entries++;
+        stats->references += e->references;
+        stats->sizeInBytes += e->sizeInBytes;
+    }
+    stats->hits = s_ctx.hits;
+    stats->misses = s_ctx.misses;
+    return kResultOk;
+}
+
+//! Called by the framework on nvigiShutdown once all plugins are unloaded
+void shutdown()
+{
+    std::scoped_lock lock(s_ctx.mtx);
+    for (auto& e : s_ctx.entries)
+    {
+        // Destroy callback lives in the plugin which is gone by now, nothing we can do but report it
+        NVIGI_LOG_WARN("Model cache entry '%s' (%s device %u) still has %llu reference(s) on shutdown", e->modelGUID.c_str(), e->backend.c_str(), e->device, (unsigned long long)e->references);
+    }
+    s_ctx.entries.clear();
+    s_ctx.hits = s_ctx.misses = 0;
+}
+
+IModelCache* getInterface()
+{
+    if (!s_cache.acquire)
+    {
+        s_cache.acquire = acquire;
+        s_cache.release = release;
+        s_cache.getStats = getStats;
+    }
+    return &s_cache;
+}
+
+}
+}
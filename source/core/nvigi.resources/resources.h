@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <memory>
+
+#include "source/core/nvigi.api/nvigi.h"
+
+namespace nvigi
+{
+
+namespace resources
+{
+
+//! Identifies a model resource, usually the immutable weights loaded by an instance
+//!
+//! {7AA3CC97-5893-41CA-826B-0FD49CF3FCD2}
+struct alignas(8) ModelResourceKey {
+    ModelResourceKey() {};
+    NVIGI_UID(UID({ 0x7aa3cc97, 0x5893, 0x41ca,{ 0x82, 0x6b, 0x0f, 0xd4, 0x9c, 0xf3, 0xfc, 0xd2 } }), kStructVersion1)
+
+    //! Plugin owning the resource, resources are never shared across plugins
+    PluginID plugin{};
+    //! Model GUID as provided in 'CommonCreationParameters'
+    const char* modelGUID{};
+    //! Backend specific tag, for example "cuda", "d3d12" or "cpu"
+    const char* backend{};
+    //! Device or adapter index the resource lives on
+    uint32_t device{};
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(ModelResourceKey)
+
+//! {8FC77BDD-BB90-4431-A390-F8293E4E326F}
+struct alignas(8) ModelCacheStats {
+    ModelCacheStats() {};
+    NVIGI_UID(UID({ 0x8fc77bdd, 0xbb90, 0x4431,{ 0xa3, 0x90, 0xf8, 0x29, 0x3e, 0x4e, 0x32, 0x6f } }), kStructVersion1)
+
+    //! Resources currently loaded
+    uint64_t entries{};
+    //! Sum of all outstanding references
+    uint64_t references{};
+    //! Sum of the sizes reported by the create callbacks
+    uint64_t sizeInBytes{};
+    //! Acquires served from the cache versus ones that had to load the resource
+    uint64_t hits{};
+    uint64_t misses{};
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(ModelCacheStats)
+
+//! Loads the resource, 'sizeInBytes' is optional and only used for statistics
+using PFun_ModelResourceCreate = Result(void* userData, void** resource, size_t* sizeInBytes);
+//! Destroys the resource once the last reference is released
+using PFun_ModelResourceDestroy = void(void* resource);
+
+//! Interface 'IModelCache'
+//!
+//! Reference counted cache of immutable model resources shared by all instances of a plugin.
+//! Instances keep only their mutable state (KV cache, streams etc.) private so memory no longer
+//! scales with the instance count and creating another instance of the same model is nearly instant.
+//!
+//! Plugins obtain this interface from 'IFramework', see 'acquireShared' for the C++ helper.
+//!
+//! {3AC7D1BD-E30E-4507-A2EF-D8065D6AA0B1}
+struct alignas(8) IModelCache {
+    IModelCache() {};
+    NVIGI_UID(UID({ 0x3ac7d1bd, 0xe30e, 0x4507,{ 0xa2, 0xef, 0xd8, 0x06, 0x5d, 0x6a, 0xa0, 0xb1 } }), kStructVersion1)
+
+    //! Returns the cached resource for 'key' and adds a reference, otherwise calls 'create' to load it
+    //!
+    //! Concurrent acquires of a key being loaded wait for the first one instead of loading it again.
+    //! 'destroy' must stay valid until the last reference is released, plugins release all references on destroyInstance.
+    //!
+    //! This method is thread safe.
+    Result (*acquire)(const ModelResourceKey& key, PFun_ModelResourceCreate* create, PFun_ModelResourceDestroy* destroy, void* userData, void** resource);
+
+    //! Drops a reference obtained from 'acquire', the resource is destroyed when none are left
+    //!
+    //! This method is thread safe.
+    Result (*release)(void* resource);
+
+    Result (*getStats)(ModelCacheStats* stats);
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(IModelCache)
+
+//! Null when running on an older core
+IModelCache* getInterface();
+
+//! Returns a shared immutable resource, 'factory' returns 'T*' (or null on failure) and only runs on a cache miss
+//!
+//! Falls back to a private copy when the cache is not available so callers do not need two code paths.
+template<typename T, typename F>
+std::shared_ptr<const T> acquireShared(const ModelResourceKey& key, F&& factory, Result* result = nullptr)
+{
+    auto icache = getInterface();
+    if (!icache)
+    {
+        std::shared_ptr<const T> resource(factory());
+        if (result) *result = resource ? kResultOk : kResultInvalidState;
+        return resource;
+    }
+
+    using Factory = std::remove_reference_t<F>;
+    auto create = [](void* userData, void** resource, size_t* /*sizeInBytes*/)->Result
+    {
+        *resource = (*(Factory*)userData)();
+        return *resource ? kResultOk : kResultInvalidState;
+    };
+    auto destroy = [](void* resource)->void
+    {
+        delete (T*)resource;
+    };
+
+    void* resource{};
+    auto res = icache->acquire(key, create, destroy, (void*)&factory, &resource);
+    if (result) *result = res;
+    if (res != kResultOk) return {};
+    return std::shared_ptr<const T>((const T*)resource, [icache](const T* p)->void { icache->release((void*)p); });
+}
+
+}
+}
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "source/core/nvigi.resources/resources.h"
+
+//! Unit tests for the shared model cache
+//!
+namespace nvigi
+{
+
+namespace resources
+{
+
+TEST_CASE("resources::IModelCache shared weights", "[resources][cache]") {
+    IModelCache* icache{};
+    nvigiGetInterfaceDynamic(core::framework::kId, &icache, params.nvigiLoadInterface);
+    REQUIRE(icache != nullptr);
+
+    static std::atomic<int> s_created{};
+    static std::atomic<int> s_destroyed{};
+    s_created = 0;
+    s_destroyed = 0;
+    auto create = [](void* userData, void** resource, size_t* sizeInBytes)->Result
+    {
+        // Slow load so concurrent acquires overlap
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        s_created++;
+        *resource = new std::vector<float>(1024, *(float*)userData);
+        *sizeInBytes = 1024 * sizeof(float);
+        return kResultOk;
+    };
+    auto destroy = [](void* resource)->void
+    {
+        s_destroyed++;
+        delete (std::vector<float>*)resource;
+    };
+
+    ModelResourceKey key{};
+    key.plugin = core::framework::kId;
+    key.modelGUID = "{01234567-0123-0123-0123-0123456789AB}";
+    key.backend = "cpu";
+
+    ModelCacheStats before{};
+    REQUIRE(icache->getStats(&before) == kResultOk);
+
+    // Eight instances of the same model share one copy
+    float value = 1.0f;
+    void* resources[8]{};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; i++)
+    {
+        threads.emplace_back([&, i]()->void { icache->acquire(key, create, destroy, &value, &resources[i]); });
+    }
+    for (auto& t : threads) t.join();
+    REQUIRE(s_created == 1);
+    for (auto r : resources) REQUIRE(r == resources[0]);
+
+    ModelCacheStats stats{};
+    REQUIRE(icache->getStats(&stats) == kResultOk);
+    REQUIRE(stats.entries == before.entries + 1);
+    REQUIRE(stats.hits == before.hits + 7);
+    REQUIRE(stats.misses == before.misses + 1);
+
+    // Different device is a different resource
+    void* other{};
+    key.device = 1;
+    REQUIRE(icache->acquire(key, create, destroy, &value, &other) == kResultOk);
+    REQUIRE(other != resources[0]);
+    REQUIRE(s_created == 2);
+    REQUIRE(icache->release(other) == kResultOk);
+    REQUIRE(s_destroyed == 1);
+
+    for (int i = 0; i < 7; i++) REQUIRE(icache->release(resources[i]) == kResultOk);
+    REQUIRE(s_destroyed == 1);
+    REQUIRE(icache->release(resources[7]) == kResultOk);
+    REQUIRE(s_destroyed == 2);
+    REQUIRE(icache->release(resources[7]) == kResultItemNotFound);
+
+    params.nvigiUnloadInterface(core::framework::kId, icache);
+}
+
+}
+}
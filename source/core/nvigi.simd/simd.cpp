@@ -0,0 +1,579 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define NVIGI_SIMD_X64
+#include <immintrin.h>
+#endif
+
+#include "source/core/nvigi.simd/simd.h"
+#include "source/core/nvigi.log/log.h"
+
+//! MSVC allows intrinsics in any function, GCC and clang need per function targets
+#if defined(_MSC_VER) && !defined(__clang__)
+#define NVIGI_SIMD_TARGET(isa)
+#else
+#define NVIGI_SIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#define NVIGI_SIMD_TARGET_AVX2 NVIGI_SIMD_TARGET("avx2,fma,f16c")
+#define NVIGI_SIMD_TARGET_AVX512 NVIGI_SIMD_TARGET("avx512f,avx2,fma,f16c")
+
+namespace nvigi
+{
+namespace simd
+{
+
+constexpr float kPcm16ToFloat = 1.0f / 32768.0f;
+constexpr float kFloatToPcm16 = 32767.0f;
+
+ISimd s_simd{};
+SimdLevel s_level = SimdLevel::eScalar;
+
+//! SCALAR
+//!
+//! Reference implementations, also used for the tails of the vectorized kernels
+
+namespace scalar
+{
+
+inline uint32_t asBits(float f) { uint32_t u; memcpy(&u, &f, sizeof(u)); return u; }
+inline float asFloat(uint32_t u) { float f; memcpy(&f, &u, sizeof(f)); return f; }
+
+void pcm16ToFloat(const int16_t* src, float* dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++) dst[i] = float(src[i]) * kPcm16ToFloat;
+}
+
+void floatToPcm16(const float* src, int16_t* dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        // Written so NaN clamps to -1, same as max/min instructions
+        float v = src[i] >= -1.0f ? src[i] : -1.0f;
+        v = v < 1.0f ? v : 1.0f;
+        dst[i] = int16_t(std::lrintf(v * kFloatToPcm16));
+    }
+}
+
+float peakAbs(const float* src, size_t count)
+{
+    float peak = 0.0f;
+    for (size_t i = 0; i < count; i++)
+    {
+        float a = std::fabs(src[i]);
+        if (a > peak) peak = a;
+    }
+    return peak;
+}
+
+void scale(float* data, size_t count, float gain)
+{
+    for (size_t i = 0; i < count; i++) data[i] *= gain;
+}
+
+void resampleLinear(const float* src, size_t srcCount, float* dst, size_t dstCount, size_t first, double step)
+{
+    for (size_t i = first; i < dstCount; i++)
+    {
+        double pos = double(i) * step;
+        size_t i0 = std::min(size_t(pos), srcCount - 1);
+        size_t i1 = std::min(i0 + 1, srcCount - 1);
+        float frac = float(pos - double(i0));
+        dst[i] = src[i0] + (src[i1] - src[i0]) * frac;
+    }
+}
+
+void resampleLinear(const float* src, size_t srcCount, float* dst, size_t dstCount)
+{
+    if (!dstCount) return;
+    if (!srcCount)
+    {
+        memset(dst, 0, dstCount * sizeof(float));
+        return;
+    }
+    resampleLinear(src, srcCount, dst, dstCount, 0, double(srcCount) / double(dstCount));
+}
+
+//! Matches VCVTPS2PH with round to nearest even, including NaN payloads
+uint16_t floatToHalf(float f)
+{
+    uint32_t x = asBits(f);
+    uint16_t sign = uint16_t((x >> 16) & 0x8000);
+    x &= 0x7fffffff;
+    if (x >= 0x47800000) // >= 65536, overflows or inf/nan
+    {
+        if (x > 0x7f800000) return sign | 0x7e00 | uint16_t((x >> 13) & 0x3ff);
+        return sign | 0x7c00;
+    }
+    if (x < 0x38800000) // < 2^-14, half denormal or zero
+    {
+        // Let the FPU round by adding 0.5f, mantissa ends up in the low bits
+        return sign | uint16_t(asBits(asFloat(x) + 0.5f) - 0x3f000000);
+    }
+    uint32_t mantissaOdd = (x >> 13) & 1;
+    x += 0xc8000fff + mantissaOdd; // rebias exponent (15 - 127) << 23 and round
+    return sign | uint16_t(x >> 13);
+}
+
+//! Matches VCVTPH2PS, signaling NaNs become quiet
+float halfToFloat(uint16_t h)
+{
+    uint32_t sign = uint32_t(h & 0x8000) << 16;
+    uint32_t exponent = (h >> 10) & 0x1f;
+    uint32_t mantissa = h & 0x3ff;
+    if (exponent == 0x1f)
+    {
+        return asFloat(sign | 0x7f800000 | (mantissa << 13) | (mantissa ? 0x400000 : 0));
+    }
+    if (exponent == 0)
+    {
+        float v = float(mantissa) * (1.0f / 16777216.0f); // 2^-24
+        return sign ? -v : v;
+    }
+    return asFloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+void floatToHalf(const float* src, uint16_t* dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++) dst[i] = floatToHalf(src[i]);
+}
+
+void halfToFloat(const uint16_t* src, float* dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++) dst[i] = halfToFloat(src[i]);
+}
+
+//! Slicing by 8, reflected Castagnoli polynomial
+struct Crc32cTables
+{
+    uint32_t t[8][256];
+    Crc32cTables()
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i;
+            for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0x82f63b78 & (0u - (crc & 1)));
+            t[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            for (int k = 1; k < 8; k++) t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xff];
+        }
+    }
+};
+
+uint32_t crc32c(uint32_t crc, const void* data, size_t size)
+{
+    static const Crc32cTables tables;
+    auto& t = tables.t;
+    auto bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for (; size >= 8; size -= 8, bytes += 8)
+    {
+        uint64_t v;
+        memcpy(&v, bytes, sizeof(v));
+        v ^= crc;
+        crc = t[7][v & 0xff] ^ t[6][(v >> 8) & 0xff] ^ t[5][(v >> 16) & 0xff] ^ t[4][(v >> 24) & 0xff] ^
+            t[3][(v >> 32) & 0xff] ^ t[2][(v >> 40) & 0xff] ^ t[1][(v >> 48) & 0xff] ^ t[0][v >> 56];
+    }
+    for (; size; size--, bytes++) crc = (crc >> 8) ^ t[0][(crc ^ *bytes) & 0xff];
+    return ~crc;
+}
+
+double sumSquares(const float* src, size_t count)
+{
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) sum += double(src[i]) * double(src[i]);
+    return sum;
+}
+
+uint64_t sumSquaresPcm16(const int16_t* src, size_t count)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; i++) sum += uint64_t(int32_t(src[i]) * int32_t(src[i]));
+    return sum;
+}
+
+float meanSquare(const float* src, size_t count)
+{
+    return count ? float(sumSquares(src, count) / double(count)) : 0.0f;
+}
+
+float meanSquarePcm16(const int16_t* src, size_t count)
+{
+    return count ? float(double(sumSquaresPcm16(src, count)) * double(kPcm16ToFloat) * double(kPcm16ToFloat) / double(count)) : 0.0f;
+}
+
+}
+
+#ifdef NVIGI_SIMD_X64
+
+//! AVX2 + FMA + F16C
+//!
+namespace avx2
+{
+
+//! SSE4.2, implied by AVX2
+NVIGI_SIMD_TARGET_AVX2 uint32_t crc32c(uint32_t crc, const void* data, size_t size)
+{
+    auto bytes = static_cast<const uint8_t*>(data);
+    uint64_t c = ~crc;
+    for (; size >= 8; size -= 8, bytes += 8)
+    {
+        uint64_t v;
+        memcpy(&v, bytes, sizeof(v));
+        c = _mm_crc32_u64(c, v);
+    }
+    uint32_t c32 = uint32_t(c);
+    for (; size; size--, bytes++) c32 = _mm_crc32_u8(c32, *bytes);
+    return ~c32;
+}
+
+NVIGI_SIMD_TARGET_AVX2 void pcm16ToFloat(const int16_t* src, float* dst, size_t count)
+{
+    const __m256 scale = _mm256_set1_ps(kPcm16ToFloat);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i v = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+    }
+    scalar::pcm16ToFloat(src + i, dst + i, count - i);
+}
+
+NVIGI_SIMD_TARGET_AVX2 void floatToPcm16(const float* src, int16_t* dst, size_t count)
+{
+    const __m256 lo = _mm256_set1_ps(-1.0f);
+    const __m256 hi = _mm256_set1_ps(1.0f);
+    const __m256 scale = _mm256_set1_ps(kFloatToPcm16);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        // max returns the second operand for NaN
+        __m256 a = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src + i), lo), hi);
+        __m256 b = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src + i + 8), lo), hi);
+        __m256i packed = _mm256_packs_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(a, scale)), _mm256_cvtps_epi32(_mm256_mul_ps(b, scale)));
+        // packs works per 128-bit lane, restore sample order
+        packed = _mm256_permute4x64_epi64(packed, 0xd8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+    }
+    scalar::floatToPcm16(src + i, dst + i, count - i);
+}
+
+NVIGI_SIMD_TARGET_AVX2 float peakAbs(const float* src, size_t count)
+{
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    __m256 peak = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        peak = _mm256_max_ps(_mm256_and_ps(_mm256_loadu_ps(src + i), absMask), peak);
+    }
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, peak);
+    float result = scalar::peakAbs(src + i, count - i);
+    for (float v : lanes) result = std::max(result, v);
+    return result;
+}
+
+NVIGI_SIMD_TARGET_AVX2 void scale(float* data, size_t count, float gain)
+{
+    const __m256 g = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), g));
+    }
+    scalar::scale(data + i, count - i, gain);
+}
+
+NVIGI_SIMD_TARGET_AVX2 void resampleLinear(const float* src, size_t srcCount, float* dst, size_t dstCount)
+{
+    if (!dstCount || !srcCount)
+    {
+        scalar::resampleLinear(src, srcCount, dst, dstCount);
+        return;
+    }
+    const double step = double(srcCount) / double(dstCount);
+    size_t i = 0;
+    // Lane offsets are relative to each block so float precision does not depend on the stream length
+    if (step < 1024.0)
+    {
+        const float stepF = float(step);
+        const __m256 laneOffsets = _mm256_mul_ps(_mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_ps(stepF));
+        for (; i + 8 <= dstCount; i += 8)
+        {
+            double base = double(i) * step;
+            size_t baseIndex = size_t(base);
+            float baseFrac = float(base - double(baseIndex));
+            // Both neighbours of the last lane must be in range, the rest is handled by the scalar tail
+            if (baseIndex + size_t(baseFrac + 7.0f * stepF) + 2 >= srcCount) break;
+
+            __m256 pos = _mm256_add_ps(_mm256_set1_ps(baseFrac), laneOffsets);
+            __m256i idx = _mm256_cvttps_epi32(pos);
+            __m256 frac = _mm256_sub_ps(pos, _mm256_cvtepi32_ps(idx));
+            const float* base0 = src + baseIndex;
+            __m256 a = _mm256_i32gather_ps(base0, idx, 4);
+            __m256 b = _mm256_i32gather_ps(base0 + 1, idx, 4);
+            _mm256_storeu_ps(dst + i, _mm256_fmadd_ps(_mm256_sub_ps(b, a), frac, a));
+        }
+    }
+    scalar::resampleLinear(src, srcCount, dst, dstCount, i, step);
+}
+
+NVIGI_SIMD_TARGET_AVX2 void floatToHalf(const float* src, uint16_t* dst, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), h);
+    }
+    scalar::floatToHalf(src + i, dst + i, count - i);
+}
+
+NVIGI_SIMD_TARGET_AVX2 void halfToFloat(const uint16_t* src, float* dst, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+    }
+    scalar::halfToFloat(src + i, dst + i, count - i);
+}
+
+NVIGI_SIMD_TARGET_AVX2 double sumSquares(const float* src, size_t count)
+{
+    __m256d a = _mm256_setzero_pd();
+    __m256d b = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256d lo = _mm256_cvtps_pd(_mm_loadu_ps(src + i));
+        __m256d hi = _mm256_cvtps_pd(_mm_loadu_ps(src + i + 4));
+        a = _mm256_fmadd_pd(lo, lo, a);
+        b = _mm256_fmadd_pd(hi, hi, b);
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(a, b));
+    return scalar::sumSquares(src + i, count - i) + ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+}
+
+NVIGI_SIMD_TARGET_AVX2 uint64_t sumSquaresPcm16(const int16_t* src, size_t count)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i sum = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        // Pairwise sums are at most 2 * 32768^2 = 2^31, exact once zero extended as unsigned
+        __m256i pairs = _mm256_madd_epi16(v, v);
+        sum = _mm256_add_epi64(sum, _mm256_unpacklo_epi32(pairs, zero));
+        sum = _mm256_add_epi64(sum, _mm256_unpackhi_epi32(pairs, zero));
+    }
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+    return scalar::sumSquaresPcm16(src + i, count - i) + lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+NVIGI_SIMD_TARGET_AVX2 float meanSquare(const float* src, size_t count)
+{
+    return count ? float(sumSquares(src, count) / double(count)) : 0.0f;
+}
+
+NVIGI_SIMD_TARGET_AVX2 float meanSquarePcm16(const int16_t* src, size_t count)
+{
+    return count ? float(double(sumSquaresPcm16(src, count)) * double(kPcm16ToFloat) * double(kPcm16ToFloat) / double(count)) : 0.0f;
+}
+
+}
+
+//! AVX-512F
+//!
+//! Only the streaming kernels, resampling is gather bound and stays on AVX2,
+//! PCM16 energy needs AVX-512BW for 16-bit multiplies and stays on AVX2 too
+namespace avx512
+{
+
+NVIGI_SIMD_TARGET_AVX512 void pcm16ToFloat(const int16_t* src, float* dst, size_t count)
+{
+    const __m512 scale = _mm512_set1_ps(kPcm16ToFloat);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m512i v = _mm512_cvtepi16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+        _mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_cvtepi32_ps(v), scale));
+    }
+    avx2::pcm16ToFloat(src + i, dst + i, count - i);
+}
+
+NVIGI_SIMD_TARGET_AVX512 void floatToPcm16(const float* src, int16_t* dst, size_t count)
+{
+    const __m512 lo = _mm512_set1_ps(-1.0f);
+    const __m512 hi = _mm512_set1_ps(1.0f);
+    const __m512 scale = _mm512_set1_ps(kFloatToPcm16);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m512 v = _mm512_min_ps(_mm512_max_ps(_mm512_loadu_ps(src + i), lo), hi);
+        __m256i packed = _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(_mm512_mul_ps(v, scale)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+    }
+    avx2::floatToPcm16(src + i, dst + i, count - i);
+}
+
+NVIGI_SIMD_TARGET_AVX512 float peakAbs(const float* src, size_t count)
+{
+    __m512 peak = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        peak = _mm512_max_ps(_mm512_abs_ps(_mm512_loadu_ps(src + i)), peak);
+    }
+    return std::max(_mm512_reduce_max_ps(peak), avx2::peakAbs(src + i, count - i));
+}
+
+NVIGI_SIMD_TARGET_AVX512 void scale(float* data, size_t count, float gain)
+{
+    const __m512 g = _mm512_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        _mm512_storeu_ps(data + i, _mm512_mul_ps(_mm512_loadu_ps(data + i), g));
+    }
+    avx2::scale(data + i, count - i, gain);
+}
+
+NVIGI_SIMD_TARGET_AVX512 void floatToHalf(const float* src, uint16_t* dst, size_t count)
+{
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256i h = _mm512_cvtps_ph(_mm512_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), h);
+    }
+    avx2::floatToHalf(src + i, dst + i, count - i);
+}
+
+NVIGI_SIMD_TARGET_AVX512 void halfToFloat(const uint16_t* src, float* dst, size_t count)
+{
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        _mm512_storeu_ps(dst + i, _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i))));
+    }
+    avx2::halfToFloat(src + i, dst + i, count - i);
+}
+
+NVIGI_SIMD_TARGET_AVX512 float meanSquare(const float* src, size_t count)
+{
+    __m512d a = _mm512_setzero_pd();
+    __m512d b = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m512d lo = _mm512_cvtps_pd(_mm256_loadu_ps(src + i));
+        __m512d hi = _mm512_cvtps_pd(_mm256_loadu_ps(src + i + 8));
+        a = _mm512_fmadd_pd(lo, lo, a);
+        b = _mm512_fmadd_pd(hi, hi, b);
+    }
+    double sum = _mm512_reduce_add_pd(_mm512_add_pd(a, b)) + avx2::sumSquares(src + i, count - i);
+    return count ? float(sum / double(count)) : 0.0f;
+}
+
+}
+
+#endif
+
+//! Dispatches to the selected kernels
+float normalize(float* data, size_t count, float targetPeak)
+{
+    float peak = s_simd.peakAbs(data, count);
+    if (peak <= 0.0f) return 1.0f;
+    float gain = targetPeak / peak;
+    s_simd.scale(data, count, gain);
+    return gain;
+}
+
+SimdLevel getLevel()
+{
+    return s_level;
+}
+
+const char* getLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+        case SimdLevel::eAVX2: return "AVX2";
+        case SimdLevel::eAVX512: return "AVX-512";
+        default: return "scalar";
+    };
+}
+
+//! Called by the framework once system caps are known, before any plugin is loaded
+void initialize(SystemFlags flags)
+{
+    s_level = SimdLevel::eScalar;
+    s_simd.getLevel = getLevel;
+    s_simd.pcm16ToFloat = scalar::pcm16ToFloat;
+    s_simd.floatToPcm16 = scalar::floatToPcm16;
+    s_simd.peakAbs = scalar::peakAbs;
+    s_simd.scale = scalar::scale;
+    s_simd.normalize = normalize;
+    s_simd.resampleLinear = scalar::resampleLinear;
+    s_simd.floatToHalf = scalar::floatToHalf;
+    s_simd.halfToFloat = scalar::halfToFloat;
+    s_simd.crc32c = scalar::crc32c;
+    s_simd.meanSquare = scalar::meanSquare;
+    s_simd.meanSquarePcm16 = scalar::meanSquarePcm16;
+
+#ifdef NVIGI_SIMD_X64
+    if ((flags & SystemFlags::eAVX2) && (flags & SystemFlags::eFMA) && (flags & SystemFlags::eF16C))
+    {
+        s_level = SimdLevel::eAVX2;
+        s_simd.pcm16ToFloat = avx2::pcm16ToFloat;
+        s_simd.floatToPcm16 = avx2::floatToPcm16;
+        s_simd.peakAbs = avx2::peakAbs;
+        s_simd.scale = avx2::scale;
+        s_simd.resampleLinear = avx2::resampleLinear;
+        s_simd.floatToHalf = avx2::floatToHalf;
+        s_simd.halfToFloat = avx2::halfToFloat;
+        s_simd.crc32c = avx2::crc32c;
+        s_simd.meanSquare = avx2::meanSquare;
+        s_simd.meanSquarePcm16 = avx2::meanSquarePcm16;
+
+        if (flags & SystemFlags::eAVX512F)
+        {
+            s_level = SimdLevel::eAVX512;
+            s_simd.pcm16ToFloat = avx512::pcm16ToFloat;
+            s_simd.floatToPcm16 = avx512::floatToPcm16;
+            s_simd.peakAbs = avx512::peakAbs;
+            s_simd.scale = avx512::scale;
+            s_simd.floatToHalf = avx512::floatToHalf;
+            s_simd.halfToFloat = avx512::halfToFloat;
+            s_simd.meanSquare = avx512::meanSquare;
+        }
+    }
+#endif
+    NVIGI_LOG_INFO("SIMD kernels: %s", getLevelName(s_level));
+}
+
+ISimd* getInterface()
+{
+    if (!s_simd.getLevel)
+    {
+        // Framework did not detect the CPU yet, scalar kernels are always safe
+        initialize(SystemFlags::eNone);
+    }
+    return &s_simd;
+}
+
+}
+}
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "source/core/nvigi.api/nvigi.h"
+
+namespace nvigi
+{
+
+namespace simd
+{
+
+//! Instruction set used by the kernels, selected once by 'nvigi.core.framework' from the system caps
+enum class SimdLevel : uint32_t
+{
+    eScalar,
+    //! AVX2 + FMA + F16C
+    eAVX2,
+    //! AVX-512F on top of eAVX2
+    eAVX512
+};
+
+//! Interface 'ISimd'
+//!
+//! Vectorized kernels shared with all plugins, use instead of hand written scalar loops.
+//!
+//! All kernels accept unaligned pointers, source and destination must not overlap unless noted otherwise.
+//! Results are identical across levels except for 'meanSquare', which can differ in the last bit, and 'resampleLinear', see below.
+//!
+//! NOTE: Plugins running on an older core will not find this interface, 'getInterface' returns null in that case.
+//!
+//! {A1B91B2A-019A-4B07-B599-43B13C1F66A0}
+struct alignas(8) ISimd {
+    ISimd() {};
+    NVIGI_UID(UID({ 0xa1b91b2a, 0x019a, 0x4b07,{ 0xb5, 0x99, 0x43, 0xb1, 0x3c, 0x1f, 0x66, 0xa0 } }), kStructVersion3)
+
+    SimdLevel (*getLevel)();
+
+    //! PCM
+    //!
+    //! int16 to float in [-1,1) range (sample / 32768)
+    void (*pcm16ToFloat)(const int16_t* src, float* dst, size_t count);
+    //! Float clamped to [-1,1] then scaled by 32767 and rounded to nearest even, NaN maps to -32767
+    void (*floatToPcm16)(const float* src, int16_t* dst, size_t count);
+
+    //! Normalization
+    //!
+    //! Returns max(|x|), NaNs are ignored
+    float (*peakAbs)(const float* src, size_t count);
+    //! In place data[i] *= gain
+    void (*scale)(float* data, size_t count, float gain);
+    //! In place peak normalization, returns the gain applied (1 for silence)
+    float (*normalize)(float* data, size_t count, float targetPeak);
+
+    //! Resampling
+    //!
+    //! Linear interpolation, 'dstCount' samples cover the same duration as 'srcCount' samples
+    //! (e.g. dstCount = srcCount * 16000 / 44100 to go from 44.1kHz to 16kHz)
+    //!
+    //! NOTE: Vectorized levels interpolate in single precision, results differ from the scalar reference by up to
+    //! about 2^-19 * max(1, srcCount / dstCount) * max(|src|), so ~5e-6 for 44.1kHz to 16kHz and more for larger ratios.
+    void (*resampleLinear)(const float* src, size_t srcCount, float* dst, size_t dstCount);
+
+    //! FP16 packing
+    //!
+    //! IEEE half precision, round to nearest even, denormals, infinities and NaNs preserved
+    void (*floatToHalf)(const float* src, uint16_t* dst, size_t count);
+    void (*halfToFloat)(const uint16_t* src, float* dst, size_t count);
+
+    //! v2
+
+    //! Checksums
+    //!
+    //! CRC-32C (Castagnoli), continues from 'crc' so data can be hashed as it streams in, start with 0.
+    //! Uses the SSE4.2 CRC32 instruction at eAVX2 and above.
+    uint32_t (*crc32c)(uint32_t crc, const void* data, size_t size);
+
+    //! v3
+
+    //! Energy
+    //!
+    //! Returns mean(x^2), 0 for an empty input, accumulated in double precision
+    float (*meanSquare)(const float* src, size_t count);
+    //! Same on PCM16 scaled like 'pcm16ToFloat', accumulated in 64-bit integers so identical across levels
+    float (*meanSquarePcm16)(const int16_t* src, size_t count);
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(ISimd)
+
+ISimd* getInterface();
+
+}
+
+}
@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <cmath>
+#include <random>
+
+#include "source/core/nvigi.simd/simd.h"
+
+//! Unit tests for the SIMD kernels, whatever level the framework selected is compared against plain scalar code
+//!
+namespace nvigi
+{
+
+namespace simd
+{
+
+//! Odd sizes so the scalar tails of the vectorized kernels are covered too
+constexpr size_t kSimdTestCount = 4096 + 13;
+
+inline std::vector<float> simdTestSignal(size_t count, float amplitude, uint32_t seed = 7)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-amplitude, amplitude);
+    std::vector<float> data(count);
+    for (auto& v : data) v = dist(rng);
+    return data;
+}
+
+TEST_CASE("simd::ISimd PCM16 conversions match scalar reference", "[simd]") {
+    auto isimd = simd::getInterface();
+    REQUIRE(isimd != nullptr);
+
+    // Out of range, exact limits and NaN
+    auto data = simdTestSignal(kSimdTestCount, 1.5f);
+    data[0] = NAN;
+    data[1] = 1.0f;
+    data[2] = -1.0f;
+    data[3] = 0.5f / 32767.0f;
+    std::vector<int16_t> pcm(data.size());
+    isimd->floatToPcm16(data.data(), pcm.data(), data.size());
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        float v = std::isnan(data[i]) ? -1.0f : std::clamp(data[i], -1.0f, 1.0f);
+        REQUIRE(pcm[i] == int16_t(std::lrintf(v * 32767.0f)));
+    }
+
+    std::vector<float> back(pcm.size());
+    isimd->pcm16ToFloat(pcm.data(), back.data(), pcm.size());
+    for (size_t i = 0; i < pcm.size(); i++)
+    {
+        REQUIRE(back[i] == float(pcm[i]) * (1.0f / 32768.0f));
+    }
+}
+
+TEST_CASE("simd::ISimd FP16 conversions match scalar reference", "[simd]") {
+    auto isimd = simd::getInterface();
+    REQUIRE(isimd != nullptr);
+
+    // Every half value, including denormals, infinities and NaNs
+    std::vector<uint16_t> halfs(65536);
+    for (uint32_t i = 0; i < 65536; i++) halfs[i] = uint16_t(i);
+    std::vector<float> floats(halfs.size());
+    isimd->halfToFloat(halfs.data(), floats.data(), halfs.size());
+    std::vector<uint16_t> roundTrip(halfs.size());
+    isimd->floatToHalf(floats.data(), roundTrip.data(), floats.size());
+    for (uint32_t i = 0; i < 65536; i++)
+    {
+        uint32_t exponent = (i >> 10) & 0x1f;
+        uint32_t mantissa = i & 0x3ff;
+        if (exponent == 0x1f && mantissa)
+        {
+            // Signaling NaNs come back quiet
+            REQUIRE(std::isnan(floats[i]));
+            REQUIRE(roundTrip[i] == (i | 0x200));
+            continue;
+        }
+        float expected = exponent == 0 ? std::ldexp(float(mantissa), -24) : exponent == 0x1f ? INFINITY : std::ldexp(float(mantissa | 0x400), int(exponent) - 25);
+        REQUIRE(floats[i] == ((i & 0x8000) ? -expected : expected));
+        REQUIRE(roundTrip[i] == i);
+    }
+
+    // Halfway cases round to even, overflow saturates to infinity
+    float values[] = { 1.0f + 1.0f / 2048.0f, 1.0f + 3.0f / 2048.0f, 65520.0f, -1e10f, 1e-10f };
+    uint16_t expected[] = { 0x3c00, 0x3c02, 0x7c00, 0xfc00, 0x0000 };
+    uint16_t converted[5]{};
+    isimd->floatToHalf(values, converted, 5);
+    for (size_t i = 0; i < 5; i++) REQUIRE(converted[i] == expected[i]);
+}
+
+TEST_CASE("simd::ISimd normalization matches scalar reference", "[simd]") {
+    auto isimd = simd::getInterface();
+    REQUIRE(isimd != nullptr);
+
+    auto data = simdTestSignal(kSimdTestCount, 0.25f);
+    data[kSimdTestCount - 1] = -0.5f;
+    data[17] = NAN;
+    REQUIRE(isimd->peakAbs(data.data(), data.size()) == 0.5f);
+
+    data[17] = 0.0f;
+    auto reference = data;
+    REQUIRE(isimd->normalize(data.data(), data.size(), 1.0f) == 2.0f);
+    for (size_t i = 0; i < data.size(); i++) REQUIRE(data[i] == reference[i] * 2.0f);
+
+    std::vector<float> silence(kSimdTestCount, 0.0f);
+    REQUIRE(isimd->normalize(silence.data(), silence.size(), 1.0f) == 1.0f);
+}
+
+TEST_CASE("simd::ISimd resampling is within documented error of scalar reference", "[simd]") {
+    auto isimd = simd::getInterface();
+    REQUIRE(isimd != nullptr);
+
+    auto src = simdTestSignal(48000 * 2 + 13, 1.0f);
+    for (size_t dstCount : { size_t(8000 * 2), size_t(16000 * 2 + 5), size_t(44100 * 2), size_t(96000 * 2 + 1), size_t(300) })
+    {
+        std::vector<float> dst(dstCount);
+        isimd->resampleLinear(src.data(), src.size(), dst.data(), dst.size());
+        const double step = double(src.size()) / double(dstCount);
+        const double tolerance = std::ldexp(1.0, -19) * std::max(1.0, step);
+        for (size_t i = 0; i < dstCount; i++)
+        {
+            double pos = double(i) * step;
+            size_t i0 = std::min(size_t(pos), src.size() - 1);
+            size_t i1 = std::min(i0 + 1, src.size() - 1);
+            double expected = src[i0] + (double(src[i1]) - double(src[i0])) * (pos - double(i0));
+            REQUIRE(std::fabs(dst[i] - expected) <= tolerance);
+        }
+    }
+}
+
+TEST_CASE("simd::ISimd checksums and energy match scalar reference", "[simd]") {
+    auto isimd = simd::getInterface();
+    REQUIRE(isimd != nullptr);
+
+    // Standard CRC-32C check value, also streamed in pieces
+    const char* check = "123456789";
+    REQUIRE(isimd->crc32c(0, check, 9) == 0xe3069283);
+    REQUIRE(isimd->crc32c(isimd->crc32c(0, check, 4), check + 4, 5) == 0xe3069283);
+
+    auto data = simdTestSignal(kSimdTestCount, 1.0f);
+    double sum = 0.0;
+    for (float v : data) sum += double(v) * double(v);
+    REQUIRE(isimd->meanSquare(data.data(), data.size()) == Approx(sum / double(data.size())).epsilon(1e-6));
+    REQUIRE(isimd->meanSquare(data.data(), 0) == 0.0f);
+
+    std::vector<int16_t> pcm(data.size());
+    isimd->floatToPcm16(data.data(), pcm.data(), pcm.size());
+    pcm[0] = -32768;
+    uint64_t sum16 = 0;
+    for (int16_t v : pcm) sum16 += uint64_t(int32_t(v) * int32_t(v));
+    REQUIRE(isimd->meanSquarePcm16(pcm.data(), pcm.size()) == float(double(sum16) / (32768.0 * 32768.0) / double(pcm.size())));
+}
+
+}
+
+}
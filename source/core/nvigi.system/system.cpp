@@ -16,13 +16,23 @@
 #include "nvapi.h"
 #include "external/amd-ags/ags_lib/inc/amd_ags.h"
 #endif
+#include <algorithm>
 #include <bitset>
+#include <condition_variable>
+#include <cwctype>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "source/core/nvigi.system/system.h"
 #include "source/core/nvigi.log/log.h"
 #include "source/core/nvigi.file/file.h"
 #include "source/core/nvigi.api/nvigi_version.h"
 #include "source/core/nvigi.api/nvigi_types.h"
+#include "external/json/source/nlohmann/json.hpp"
+
+using json = nlohmann::json;
 
 #define NVAPI_VALIDATE_RF(f) {auto r = f; if(r != NVAPI_OK) { NVIGI_LOG_ERROR( "%s failed error %d", #f, r); return false;} };
 
@@ -80,7 +90,12 @@ public:
             | check_for_cpu_cap(SSE)
             | check_for_cpu_cap(SSE2)
             | check_for_cpu_cap(AVX2)
-            | check_for_cpu_cap(SSE4a);
+            | check_for_cpu_cap(SSE4a)
+            | check_for_cpu_cap(FMA)
+            | check_for_cpu_cap(F16C)
+            | check_for_cpu_cap(AVX512F)
+            | check_for_cpu_cap(AVX512BW)
+            | check_for_cpu_cap(AVX512VNNI);
     }
 
 #undef check_for_cpu_cap
@@ -89,12 +104,17 @@ public:
     static bool SSSE3(void) { return CPU_Rep.f_1_ECX_[9]; }
     static bool SSE41(void) { return CPU_Rep.f_1_ECX_[19]; }
     static bool SSE42(void) { return CPU_Rep.f_1_ECX_[20]; }
-    static bool AVX(void) { return CPU_Rep.f_1_ECX_[28]; }
+    static bool AVX(void) { return CPU_Rep.f_1_ECX_[28] && CPU_Rep.osAVX_; }
     static bool MMX(void) { return CPU_Rep.f_1_EDX_[23]; }
     static bool SSE(void) { return CPU_Rep.f_1_EDX_[25]; }
     static bool SSE2(void) { return CPU_Rep.f_1_EDX_[26]; }
-    static bool AVX2(void) { return CPU_Rep.f_7_EBX_[5]; }
+    static bool AVX2(void) { return CPU_Rep.f_7_EBX_[5] && CPU_Rep.osAVX_; }
     static bool SSE4a(void) { return CPU_Rep.isAMD_ && CPU_Rep.f_81_ECX_[6]; }
+    static bool FMA(void) { return CPU_Rep.f_1_ECX_[12] && CPU_Rep.osAVX_; }
+    static bool F16C(void) { return CPU_Rep.f_1_ECX_[29] && CPU_Rep.osAVX_; }
+    static bool AVX512F(void) { return CPU_Rep.f_7_EBX_[16] && CPU_Rep.osAVX512_; }
+    static bool AVX512BW(void) { return CPU_Rep.f_7_EBX_[30] && CPU_Rep.osAVX512_; }
+    static bool AVX512VNNI(void) { return CPU_Rep.f_7_ECX_[11] && CPU_Rep.osAVX512_; }
 
 
 private:
@@ -108,6 +128,8 @@ private:
             nExIds_{ 0 },
             isIntel_{ false },
             isAMD_{ false },
+            osAVX_{ false },
+            osAVX512_{ false },
             f_1_ECX_{ 0 },
             f_1_EDX_{ 0 },
             f_7_EBX_{ 0 },
@@ -153,6 +175,14 @@ private:
                 f_1_EDX_ = data_[1][3];
             }
 
+            // AVX registers are usable only if the OS saves them on context switch (OSXSAVE + XCR0)
+            if (f_1_ECX_[27])
+            {
+                auto xcr0 = _xgetbv(0);
+                osAVX_ = (xcr0 & 0x6) == 0x6;
+                osAVX512_ = (xcr0 & 0xe6) == 0xe6;
+            }
+
             // load bitset with flags for function 0x00000007
             if (nIds_ >= 7)
             {
@@ -197,6 +227,8 @@ private:
         std::string brand_;
         bool isIntel_;
         bool isAMD_;
+        bool osAVX_;
+        bool osAVX512_;
         std::bitset<32> f_1_ECX_;
         std::bitset<32> f_1_EDX_;
         std::bitset<32> f_7_EBX_;
@@ -432,6 +464,218 @@ DWORD Rva2Offset(DWORD rva, PIMAGE_SECTION_HEADER psh, PIMAGE_NT_HEADERS pnt)
     return (rva - pSeh->VirtualAddress + pSeh->PointerToRawData);
 }
 
+//! Hashes the embedded Authenticode certificate table of a PE file
+//!
+//! Unsigned (development) binaries hash their PE headers instead, these contain link time stamp and checksum.
+//! Used to key the framework's plugin manifest cache, this is NOT a security check (see 'validateDLL').
+bool getModuleSignatureHash(const std::wstring& dllFilePath, uint64_t& hash)
+{
+    HANDLE handle = CreateFileW(dllFilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    auto readAt = [handle](uint64_t offset, void* data, DWORD size)->bool
+    {
+        LARGE_INTEGER pos{};
+        pos.QuadPart = (LONGLONG)offset;
+        DWORD byteread = 0;
+        return SetFilePointerEx(handle, pos, NULL, FILE_BEGIN) && ReadFile(handle, data, size, &byteread, NULL) && byteread == size;
+    };
+
+    bool result = false;
+    IMAGE_DOS_HEADER dosHeader{};
+    IMAGE_NT_HEADERS ntHeaders{};
+    if (readAt(0, &dosHeader, sizeof(dosHeader)) && dosHeader.e_magic == IMAGE_DOS_SIGNATURE &&
+        readAt(dosHeader.e_lfanew, &ntHeaders, sizeof(ntHeaders)) && ntHeaders.Signature == IMAGE_NT_SIGNATURE)
+    {
+        // NOTE: Security directory 'VirtualAddress' is a file offset, not an RVA
+        auto& security = ntHeaders.OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_SECURITY];
+        uint64_t offset = security.Size ? security.VirtualAddress : 0;
+        DWORD size = security.Size ? security.Size : ntHeaders.OptionalHeader.SizeOfHeaders;
+        // Sanity check, certificate tables are a few KB in practice
+        if (size && size <= 16 * 1024 * 1024)
+        {
+            std::vector<uint8_t> data(size);
+            if (readAt(offset, data.data(), size))
+            {
+                // FNV-1a
+                hash = 14695981039346656037ull;
+                for (auto b : data)
+                {
+                    hash = (hash ^ b) * 1099511628211ull;
+                }
+                result = true;
+            }
+        }
+    }
+    CloseHandle(handle);
+    return result;
+}
+
+//! DLL validation cache
+//! 
+//! Validation results are kept for the lifetime of the process (so repeated nvigiInit calls do not pay for it again)
+//! and shared across plugins linking the same runtime libraries. Each entry is bound to the file identity
+//! (volume, file index, size, write and change times) and content hash. Only successful validations are cached.
+//! 
+//! On a cache hit direct dependencies are checked again (via cache) so replacing any library in the chain invalidates it.
+//! In production builds content hash is always recomputed on a hit and nothing is persisted, trust is never derived
+//! from a writable file on disk.
+//! 
+struct FileIdentity
+{
+    uint64_t volume{};
+    uint64_t index{};
+    uint64_t size{};
+    uint64_t writeTime{};
+    uint64_t changeTime{};
+
+    bool operator==(const FileIdentity& rhs) const
+    {
+        return volume == rhs.volume && index == rhs.index && size == rhs.size && writeTime == rhs.writeTime && changeTime == rhs.changeTime;
+    }
+};
+
+struct ValidationCacheEntry
+{
+    FileIdentity identity{};
+    uint64_t contentHash{};
+    //! Direct, non-system dependencies - library name and location
+    std::vector<std::tuple<std::string, std::wstring>> dependencies;
+};
+
+struct ValidationCache
+{
+    std::mutex mtx;
+    std::map<std::wstring, ValidationCacheEntry> entries;
+    std::wstring path; // persisted in non-production builds only
+    bool dirty = false;
+    std::atomic<uint64_t> hits{};
+    std::atomic<uint64_t> misses{};
+};
+static ValidationCache* s_validationCache = new ValidationCache; // never destroyed, can be used on any thread during shutdown
+
+bool getFileIdentity(HANDLE handle, FileIdentity& identity)
+{
+    BY_HANDLE_FILE_INFORMATION info{};
+    FILE_BASIC_INFO basicInfo{};
+    if (!GetFileInformationByHandle(handle, &info) || !GetFileInformationByHandleEx(handle, FileBasicInfo, &basicInfo, sizeof(basicInfo)))
+    {
+        return false;
+    }
+    identity.volume = info.dwVolumeSerialNumber;
+    identity.index = (uint64_t(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+    identity.size = (uint64_t(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+    identity.writeTime = (uint64_t(info.ftLastWriteTime.dwHighDateTime) << 32) | info.ftLastWriteTime.dwLowDateTime;
+    identity.changeTime = (uint64_t)basicInfo.ChangeTime.QuadPart;
+    return true;
+}
+
+uint64_t hashContent(const uint8_t* data, size_t size)
+{
+    // FNV-1a, 8 bytes at a time to keep up with the disk
+    uint64_t hash = 14695981039346656037ull;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t v;
+        memcpy(&v, data + i, 8);
+        hash = (hash ^ v) * 1099511628211ull;
+    }
+    for (; i < size; i++)
+    {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+//! Same library can resolve differently depending on the search locations hence those are part of the key
+std::wstring getValidationCacheKey(const std::wstring& dllFilePath, const std::vector<std::wstring>& utf16DependeciesDirectories)
+{
+    std::wstring key = dllFilePath;
+    for (auto& location : utf16DependeciesDirectories)
+    {
+        key += L"|" + location;
+    }
+    std::transform(key.begin(), key.end(), key.begin(), [](wchar_t c) { return (wchar_t)std::towlower(c); });
+    return key;
+}
+
+#ifndef NVIGI_PRODUCTION
+void loadValidationCache(const wchar_t* path)
+{
+    std::scoped_lock lock(s_validationCache->mtx);
+    s_validationCache->path = path ? path : L"";
+    if (!path || !file::exists(path)) return;
+    auto jsonText = file::read(path);
+    if (jsonText.empty()) return;
+    try
+    {
+        jsonText.push_back(0);
+        auto cache = json::parse((const char*)jsonText.data());
+        if (extra::getJSONValue(cache, "version", 0u) != 1) return;
+        for (auto& item : cache.at("entries"))
+        {
+            ValidationCacheEntry entry{};
+            auto& id = item.at("identity");
+            entry.identity = { id.at(0).get<uint64_t>(), id.at(1).get<uint64_t>(), id.at(2).get<uint64_t>(), id.at(3).get<uint64_t>(), id.at(4).get<uint64_t>() };
+            entry.contentHash = item.at("hash").get<uint64_t>();
+            for (auto& dep : item.at("dependencies"))
+            {
+                entry.dependencies.push_back({ dep.at(0).get<std::string>(), extra::utf8ToUtf16(dep.at(1).get<std::string>().c_str()) });
+            }
+            // Entries validated in this process take precedence
+            s_validationCache->entries.insert({ extra::utf8ToUtf16(item.at("key").get<std::string>().c_str()), entry });
+        }
+    }
+    catch (std::exception& e)
+    {
+        NVIGI_LOG_WARN("Ignoring invalid DLL validation cache '%S' - %s", path, e.what());
+    }
+}
+
+void saveValidationCache()
+{
+    std::scoped_lock lock(s_validationCache->mtx);
+    if (s_validationCache->path.empty() || !s_validationCache->dirty) return;
+    s_validationCache->dirty = false;
+    json entries = json::array();
+    for (auto& [key, entry] : s_validationCache->entries)
+    {
+        auto& id = entry.identity;
+        json dependencies = json::array();
+        for (auto& [name, location] : entry.dependencies)
+        {
+            dependencies.push_back({ name, extra::utf16ToUtf8(location.c_str()) });
+        }
+        entries.push_back({
+            {"key", extra::utf16ToUtf8(key.c_str())},
+            {"identity", { id.volume, id.index, id.size, id.writeTime, id.changeTime }},
+            {"hash", entry.contentHash},
+            {"dependencies", dependencies}
+        });
+    }
+    json cache = { {"version", 1}, {"entries", entries} };
+    auto text = cache.dump(2);
+    auto tmpPath = s_validationCache->path + L".tmp";
+    file::write(tmpPath.c_str(), std::vector<uint8_t>(text.begin(), text.end()));
+    std::error_code ec;
+    fs::rename(tmpPath, s_validationCache->path, ec);
+    if (ec)
+    {
+        NVIGI_LOG_WARN("Failed to store DLL validation cache '%S' - %s", s_validationCache->path.c_str(), ec.message().c_str());
+        fs::remove(tmpPath, ec);
+    }
+}
+#endif
+
+void getValidationCacheStats(uint64_t& hits, uint64_t& misses)
+{
+    hits = s_validationCache->hits.load();
+    misses = s_validationCache->misses.load();
+}
+
 bool validateDLL(const std::wstring& dllFilePath, const std::vector<std::wstring>& utf16DependeciesDirectories, std::map<std::string, fs::path>& dependencies)
 {
     bool dllOK = true;
@@ -446,20 +690,85 @@ bool validateDLL(const std::wstring& dllFilePath, const std::vector<std::wstring
         return (it != strHaystack.end());
     };
 
+    // NOTE: Readers are allowed but nobody can modify the file while we are validating it
+    HANDLE handle = CreateFileW(dllFilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        NVIGI_LOG_ERROR("Failed to open '%S' - last error %s", dllFilePath.c_str(), std::system_category().message(GetLastError()).c_str());
+        return false;
+    }
+
+    auto readContent = [handle](std::vector<uint8_t>& content)->bool
+    {
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(handle, &size) || size.QuadPart > MAXDWORD) return false;
+        content.resize((size_t)size.QuadPart);
+        DWORD byteread = 0;
+        return ReadFile(handle, content.data(), (DWORD)content.size(), &byteread, NULL) && byteread == content.size();
+    };
+
 #if defined(NVIGI_PRODUCTION)
     // Only check signatures on plugins, ignore dependencies since we cannot validate 3rd party libs
+    //
+    // Always checked, the cache below only saves walking the import tables and is never a substitute for the signature
     if (dllFilePath.find(L"nvigi.plugin.") != std::string::npos && !nvigi::security::verifyEmbeddedSignature(dllFilePath.c_str()))
     {
         NVIGI_LOG_WARN("Failed to load plugin '%S' - missing digital signature", dllFilePath.c_str());
+        CloseHandle(handle);
         return false;
     }
 #endif
 
-    HANDLE handle = CreateFileW(dllFilePath.c_str(), GENERIC_READ, 0, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
-    DWORD byteread, size = GetFileSize(handle, NULL);
-    PVOID virtualpointer = VirtualAlloc(NULL, size, MEM_COMMIT, PAGE_READWRITE);
-    ReadFile(handle, virtualpointer, size, &byteread, NULL);
-    CloseHandle(handle);
+    auto key = getValidationCacheKey(dllFilePath, utf16DependeciesDirectories);
+    FileIdentity identity{};
+    bool hasIdentity = getFileIdentity(handle, identity);
+    std::vector<uint8_t> content;
+    
+    ValidationCacheEntry cached{};
+    bool isCached = false;
+    if (hasIdentity)
+    {
+        std::scoped_lock lock(s_validationCache->mtx);
+        auto it = s_validationCache->entries.find(key);
+        if (it != s_validationCache->entries.end() && it->second.identity == identity)
+        {
+            cached = it->second;
+            isCached = true;
+        }
+    }
+#if defined(NVIGI_PRODUCTION)
+    // Identity can be forged, content cannot
+    if (isCached)
+    {
+        isCached = readContent(content) && hashContent(content.data(), content.size()) == cached.contentHash;
+    }
+#endif
+    if (isCached)
+    {
+        CloseHandle(handle);
+        for (auto& [libName, location] : cached.dependencies)
+        {
+            dependencies[libName] = location;
+            if (!validateDLL(fs::path(location) / libName, utf16DependeciesDirectories, dependencies))
+            {
+                return false;
+            }
+        }
+        s_validationCache->hits++;
+        return true;
+    }
+    s_validationCache->misses++;
+
+    if (content.empty() && !readContent(content))
+    {
+        NVIGI_LOG_ERROR("Failed to read '%S' - last error %s", dllFilePath.c_str(), std::system_category().message(GetLastError()).c_str());
+        CloseHandle(handle);
+        return false;
+    }
+    // File stays locked for writing until we are done so hash matches what we validated
+    ValidationCacheEntry entry{ identity, hashContent(content.data(), content.size()) };
+
+    PVOID virtualpointer = content.data();
     // Get pointer to NT header
     PIMAGE_NT_HEADERS           ntheaders = (PIMAGE_NT_HEADERS)(PCHAR(virtualpointer) + PIMAGE_DOS_HEADER(virtualpointer)->e_lfanew);
     PIMAGE_SECTION_HEADER       pSech = IMAGE_FIRST_SECTION(ntheaders);//Pointer to first section header
@@ -483,14 +792,14 @@ bool validateDLL(const std::wstring& dllFilePath, const std::vector<std::wstring
             for (auto& location : utf16DependeciesDirectories) try
             {
                 auto fullPath = fs::path(location) / libname[i];
-                // First check if we have already seen this lib?
                 // Special case(s) to ignore in general
                 found = findStringIC(fullPath, L"dbgHelp.dll");
                 if (!found && fs::exists(fullPath) && fs::is_regular_file(fullPath))
                 {
                     found = true;
-                    // Not a system lib, store it and let's check it recursively
+                    // Not a system lib, store it and let's check it recursively (cached if already seen by another plugin)
                     dependencies[libname[i]] = location;
+                    entry.dependencies.push_back({ libname[i], location });
                     if (dllOK)
                     {
                         dllOK &= validateDLL(fullPath, utf16DependeciesDirectories, dependencies);
@@ -524,14 +833,97 @@ bool validateDLL(const std::wstring& dllFilePath, const std::vector<std::wstring
             i++;
         }
     }
-    if (virtualpointer)
+    CloseHandle(handle);
+    if (dllOK && hasIdentity)
     {
-        VirtualFree(virtualpointer, size, MEM_DECOMMIT);
+        std::scoped_lock lock(s_validationCache->mtx);
+        s_validationCache->entries[key] = std::move(entry);
+        s_validationCache->dirty = true;
     }
     return dllOK;
 }
 #endif
 
+#ifdef NVIGI_WINDOWS
+//! Clocks, core counts and derived bandwidth/GFLOPS cost a handful of NvAPI calls per adapter so they are
+//! queried on the discovery thread rather than on the host's thread, see 'beginSystemCapsDiscovery'
+static bool queryAdapterDetails(Adapter* adapter)
+{
+    auto handle = NvPhysicalGpuHandle(adapter->nvHandle);
+    NvU32 busWidth;
+    NVAPI_VALIDATE_RF(NvAPI_GPU_GetRamBusWidth(handle, &busWidth));
+
+    // grab the boost (peak) frequencies
+    NV_GPU_CLOCK_FREQUENCIES structClkFreqs = {};
+    NV_GPU_CLOCK_FREQUENCIES* clkFreqs{};
+    {
+        structClkFreqs.version = NV_GPU_CLOCK_FREQUENCIES_VER;
+        structClkFreqs.ClockType = NV_GPU_CLOCK_FREQUENCIES_BOOST_CLOCK;
+        auto r = NvAPI_GPU_GetAllClockFrequencies(handle, &structClkFreqs);
+        if (r != NVAPI_OK)
+        {
+            NVIGI_LOG_WARN("NvAPI_GPU_GetAllClockFrequencies failed with error %d", r);
+        }
+        else
+        {
+            clkFreqs = &structClkFreqs;
+        }
+    }
+
+    // "frequency" is in kHz
+    adapter->memoryBandwidthGBPS = (float)(clkFreqs ? clkFreqs->domain[NVAPI_GPU_PUBLIC_CLOCK_MEMORY].frequency : 0) * busWidth / 8000000.0f;
+
+    // compute a very crude estimate of GFLOPs by assuming we can do an FMAD/clk/core
+    NvU32 coreCount;
+    NVAPI_VALIDATE_RF(NvAPI_GPU_GetGpuCoreCount(handle, &coreCount));
+    adapter->coreCount = (uint32_t)coreCount;
+    adapter->shaderGFLOPS = (float)(clkFreqs ? clkFreqs->domain[NVAPI_GPU_PUBLIC_CLOCK_GRAPHICS].frequency : 0) * adapter->coreCount * 2.0f / 1000000.0f;
+
+    // SM count (Shader SubPipes)
+    NvU32 smCount{};
+    if (NvAPI_GPU_GetShaderSubPipeCount(handle, &smCount) == NVAPI_OK)
+    {
+        adapter->smCount = smCount;
+    }
+
+    // RT and Tensor cores
+    NV_GPU_INFO gpuInfo{};
+    gpuInfo.version = NV_GPU_INFO_VER;
+    if (NvAPI_GPU_GetGPUInfo(handle, &gpuInfo) == NVAPI_OK)
+    {
+        adapter->rtCoreCount = gpuInfo.rayTracingCores;
+        adapter->tensorCoreCount = gpuInfo.tensorCores;
+    }
+
+    // Store clock frequencies in MHz
+    adapter->graphicsBoostClockMHz = (clkFreqs ? clkFreqs->domain[NVAPI_GPU_PUBLIC_CLOCK_GRAPHICS].frequency : 0) / 1000;
+    adapter->memoryClockMHz = (clkFreqs ? clkFreqs->domain[NVAPI_GPU_PUBLIC_CLOCK_MEMORY].frequency : 0) / 1000;
+
+    // PCIe width
+    NvU32 pcieWidth{};
+    if (NvAPI_GPU_GetCurrentPCIEDownstreamWidth(handle, &pcieWidth) == NVAPI_OK)
+    {
+        adapter->pcieWidth = pcieWidth;
+    }
+
+    // Memory bus width (already queried above for bandwidth calculation)
+    adapter->memoryBusWidthBits = busWidth;
+
+    NVIGI_LOG_INFO("Adapter '%s' details:", adapter->description.c_str());
+    NVIGI_LOG_INFO("# cores: %u", adapter->coreCount);
+    NVIGI_LOG_INFO("# sm count: %u", adapter->smCount);
+    NVIGI_LOG_INFO("# rt cores: %u", adapter->rtCoreCount);
+    NVIGI_LOG_INFO("# tensor cores: %u", adapter->tensorCoreCount);
+    NVIGI_LOG_INFO("# graphics boost clock: %u MHz", adapter->graphicsBoostClockMHz);
+    NVIGI_LOG_INFO("# memory clock: %u MHz", adapter->memoryClockMHz);
+    NVIGI_LOG_INFO("# PCIe width: x%u", adapter->pcieWidth);
+    NVIGI_LOG_INFO("# mem bus width: %u bits", adapter->memoryBusWidthBits);
+    NVIGI_LOG_INFO("# mem GBPS: %.2f", adapter->memoryBandwidthGBPS);
+    NVIGI_LOG_INFO("# shader GFLOPS: %.2f", adapter->shaderGFLOPS);
+    return true;
+}
+#endif
+
 static SystemCaps s_caps{};
 bool getSystemCaps(nvigi::VendorId forceAdapterId, uint32_t forceArchitecture, SystemCaps* info)
 {
@@ -696,80 +1088,11 @@ bool getSystemCaps(nvigi::VendorId forceAdapterId, uint32_t forceArchitecture, S
                         adapter->revision = archInfo.revision;
                         adapter->nvHandle = nvGPUHandle[gpu];
 
-                        NvU32 busWidth;
-                        NVAPI_VALIDATE_RF(NvAPI_GPU_GetRamBusWidth(nvGPUHandle[gpu], &busWidth));
-
-                        // grab the boost (peak) frequencies
-                        NV_GPU_CLOCK_FREQUENCIES structClkFreqs = {};
-                        NV_GPU_CLOCK_FREQUENCIES* clkFreqs{};
-                        {
-                            structClkFreqs.version = NV_GPU_CLOCK_FREQUENCIES_VER;
-                            structClkFreqs.ClockType = NV_GPU_CLOCK_FREQUENCIES_BOOST_CLOCK;
-                            auto r = NvAPI_GPU_GetAllClockFrequencies(nvGPUHandle[gpu], &structClkFreqs);
-                            if (r != NVAPI_OK)
-                            {
-                                NVIGI_LOG_WARN("NvAPI_GPU_GetAllClockFrequencies failed with error %d", r);
-                            }
-                            else
-                            {
-                                clkFreqs = &structClkFreqs;
-                            }
-                        }
-
-                        // "frequency" is in kHz
-                        adapter->memoryBandwidthGBPS = (float)(clkFreqs ? clkFreqs->domain[NVAPI_GPU_PUBLIC_CLOCK_MEMORY].frequency : 0) * busWidth / 8000000.0f;
-
-                        // compute a very crude estimate of GFLOPs by assuming we can do an FMAD/clk/core
-                        NvU32 coreCount;
-                        NVAPI_VALIDATE_RF(NvAPI_GPU_GetGpuCoreCount(nvGPUHandle[gpu], &coreCount));
-                        adapter->coreCount = (uint32_t)coreCount;
-                        adapter->shaderGFLOPS = (float)(clkFreqs ? clkFreqs->domain[NVAPI_GPU_PUBLIC_CLOCK_GRAPHICS].frequency : 0) * adapter->coreCount * 2.0f / 1000000.0f;
-
-                        // SM count (Shader SubPipes)
-                        NvU32 smCount{};
-                        if (NvAPI_GPU_GetShaderSubPipeCount(nvGPUHandle[gpu], &smCount) == NVAPI_OK)
-                        {
-                            adapter->smCount = smCount;
-                        }
-
-                        // RT and Tensor cores
-                        NV_GPU_INFO gpuInfo{};
-                        gpuInfo.version = NV_GPU_INFO_VER;
-                        if (NvAPI_GPU_GetGPUInfo(nvGPUHandle[gpu], &gpuInfo) == NVAPI_OK)
-                        {
-                            adapter->rtCoreCount = gpuInfo.rayTracingCores;
-                            adapter->tensorCoreCount = gpuInfo.tensorCores;
-                        }
-
-                        // Store clock frequencies in MHz
-                        adapter->graphicsBoostClockMHz = (clkFreqs ? clkFreqs->domain[NVAPI_GPU_PUBLIC_CLOCK_GRAPHICS].frequency : 0) / 1000;
-                        adapter->memoryClockMHz = (clkFreqs ? clkFreqs->domain[NVAPI_GPU_PUBLIC_CLOCK_MEMORY].frequency : 0) / 1000;
-
-                        // PCIe width
-                        NvU32 pcieWidth{};
-                        if (NvAPI_GPU_GetCurrentPCIEDownstreamWidth(nvGPUHandle[gpu], &pcieWidth) == NVAPI_OK)
-                        {
-                            adapter->pcieWidth = pcieWidth;
-                        }
-
-                        // Memory bus width (already queried above for bandwidth calculation)
-                        adapter->memoryBusWidthBits = busWidth;
-
                         NVIGI_LOG_INFO("Found adapter '%s':", adapter->description.c_str());
                         NVIGI_LOG_INFO("# LUID: %u.%u", adapter->id.HighPart, adapter->id.LowPart);
                         NVIGI_LOG_INFO("# arch: 0x%x", adapter->architecture);
                         NVIGI_LOG_INFO("# impl: 0x%x", adapter->implementation);
                         NVIGI_LOG_INFO("# rev: 0x%x", adapter->revision);
-                        NVIGI_LOG_INFO("# cores: %u", adapter->coreCount);
-                        NVIGI_LOG_INFO("# sm count: %u", adapter->smCount);
-                        NVIGI_LOG_INFO("# rt cores: %u", adapter->rtCoreCount);
-                        NVIGI_LOG_INFO("# tensor cores: %u", adapter->tensorCoreCount);
-                        NVIGI_LOG_INFO("# graphics boost clock: %u MHz", adapter->graphicsBoostClockMHz);
-                        NVIGI_LOG_INFO("# memory clock: %u MHz", adapter->memoryClockMHz);
-                        NVIGI_LOG_INFO("# PCIe width: x%u", adapter->pcieWidth);
-                        NVIGI_LOG_INFO("# mem bus width: %u bits", adapter->memoryBusWidthBits);
-                        NVIGI_LOG_INFO("# mem GBPS: %.2f", adapter->memoryBandwidthGBPS);
-                        NVIGI_LOG_INFO("# shader GFLOPS: %.2f", adapter->shaderGFLOPS);
                         NVIGI_LOG_INFO("# driver: %u.%u", info->driverVersion.major, info->driverVersion.minor);
                         break;
                     }
@@ -883,6 +1206,52 @@ bool getSystemCaps(nvigi::VendorId forceAdapterId, uint32_t forceArchitecture, S
     return true;
 }
 
+//! Adapter discovery started by 'beginSystemCapsDiscovery', anything reading 's_caps' waits on it
+static std::shared_future<void> s_capsDiscovery;
+
+void beginSystemCapsDiscovery(nvigi::VendorId forceAdapterId, uint32_t forceArchitecture, const Version& osVersion)
+{
+    // DXGI enumeration, NvAPI and vendor libraries can take a while on hybrid laptops so run them off the host's thread
+    s_capsDiscovery = std::async(std::launch::async, [forceAdapterId, forceArchitecture, osVersion]()->void
+    {
+        SystemCaps caps{};
+        if (!getSystemCaps(forceAdapterId, forceArchitecture, &caps))
+        {
+            // Partial results on NvAPI failures, keep what was found so adapters are still released on shutdown
+            s_caps = caps;
+        }
+        s_caps.osVersion = osVersion;
+        // Before discovery is signalled so every reader (placement, framework, plugins) sees the same complete caps
+#ifdef NVIGI_WINDOWS
+        for (uint32_t i = 0; i < s_caps.adapterCount; i++)
+        {
+            if (s_caps.adapters[i] && s_caps.adapters[i]->nvHandle) queryAdapterDetails(s_caps.adapters[i]);
+        }
+#endif
+    }).share();
+}
+
+static void waitForAdapterDiscovery()
+{
+    if (s_capsDiscovery.valid()) s_capsDiscovery.wait();
+}
+
+//! Blocks until 'beginSystemCapsDiscovery' is done, including the detailed adapter info
+void waitForSystemCaps(SystemCaps* caps)
+{
+    waitForAdapterDiscovery();
+    *caps = s_caps;
+}
+
+SystemFlags getCpuFlags()
+{
+#ifdef NVIGI_WINDOWS
+    return InstructionSet::GetFlags();
+#else
+    return SystemFlags::eNone;
+#endif
+}
+
 #ifdef NVIGI_WINDOWS
 using PFun_RtlGetVersion = NTSTATUS(WINAPI*)(PRTL_OSVERSIONINFOW);
 using PFun_NtSetTimerResolution = NTSTATUS(NTAPI*)(ULONG DesiredResolution, BOOLEAN SetResolution, PULONG CurrentResolution);
@@ -1021,59 +1390,80 @@ void setTimerResolution()
 #endif
 }
 
-void cleanup(SystemCaps* caps)
+//! VRAM manager
+//!
+//! Tracks VRAM reservations declared by plugin instances and, on Windows, listens to DXGI budget change notifications.
+//! When the process goes over budget the least recently used instances are asked to free VRAM via their callbacks.
+struct VRAMManager
 {
-    for (auto& adapter : caps->adapters)
+    struct Reservation
     {
-        if (!adapter) continue;
-#ifdef NVIGI_WINDOWS
-        auto i = static_cast<IUnknown*>(adapter->nativeInterface);
-        i->Release();
-#endif
-        delete adapter;
-    }
+        uint32_t adapterIndex{};
+        PluginID plugin{};
+        size_t sizeMB{};
+        PFun_VRAMPressureCallback* callback{};
+        void* userData{};
+        uint64_t lastUse{};
+    };
+
+    std::mutex mtx;
+    std::map<void*, Reservation> reservations;
+    uint64_t useCounter{};
+    //! Instance whose pressure callback is running, 'releaseVRAM' waits for it so the callback never outlives the instance
+    void* inCallback{};
+    std::condition_variable callbackDone;
 #ifdef NVIGI_WINDOWS
+    // Queried once instead of on every stats request
+    IDXGIAdapter3* adapters[kMaxNumSupportedGPUs]{};
+    DWORD cookies[kMaxNumSupportedGPUs]{};
+    HANDLE budgetEvent{};
+    HANDLE stopEvent{};
+    std::thread thread;
 #endif
-}
+};
+static VRAMManager s_vram{};
 
-const SystemCaps* getSystemCapsShared()
+//! Must be called with VRAM manager lock held
+static size_t trackedReservationsMB(uint32_t adapterIndex)
 {
-    return &s_caps;
+    size_t total = 0;
+    for (auto& [instance, reservation] : s_vram.reservations)
+    {
+        if (reservation.adapterIndex == adapterIndex) total += reservation.sizeMB;
+    }
+    return total;
 }
 
-Result getVRAMStats(uint32_t adapterIndex, VRAMUsage** _usage)
+//! Must be called with VRAM manager lock held
+static Result queryVRAMStats(uint32_t adapterIndex, VRAMUsage* usage)
 {
-    if(!_usage) return kResultInvalidParameter;
-    // Empty struct, set all to 0
-    static VRAMUsage usage{};
-    // To prevent crashes always return a pointer to an "empty" struct in case we fail down the road
-    *_usage = &usage;
-    assert(adapterIndex < s_caps.adapterCount);
+    *usage = {};
     if (adapterIndex >= s_caps.adapterCount)
     {
         NVIGI_LOG_ERROR("Unsupported adater index %u", adapterIndex);
         return kResultInvalidParameter;
     }
+    usage->trackedReservationsMB = trackedReservationsMB(adapterIndex);
 #ifdef NVIGI_WINDOWS
-    IDXGIAdapter3* adapter3{};
-    static_cast<IUnknown*>(s_caps.adapters[adapterIndex]->nativeInterface)->QueryInterface(&adapter3);
-    if (adapter3)
+    if (!s_vram.adapters[adapterIndex])
+    {
+        static_cast<IUnknown*>(s_caps.adapters[adapterIndex]->nativeInterface)->QueryInterface(&s_vram.adapters[adapterIndex]);
+    }
+    if (auto adapter3 = s_vram.adapters[adapterIndex])
     {
         DXGI_QUERY_VIDEO_MEMORY_INFO memInfo;
         adapter3->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &memInfo);
 
-        usage.currentUsageMB = memInfo.CurrentUsage / 1024 / 1024;
-        usage.availableToReserveMB = memInfo.AvailableForReservation / 1024 / 1024;
-        usage.currentReservationMB = memInfo.CurrentReservation / 1024 / 1024;
-        usage.budgetMB = memInfo.Budget / 1024 / 1024;
+        usage->currentUsageMB = memInfo.CurrentUsage / 1024 / 1024;
+        usage->availableToReserveMB = memInfo.AvailableForReservation / 1024 / 1024;
+        usage->currentReservationMB = memInfo.CurrentReservation / 1024 / 1024;
+        usage->budgetMB = memInfo.Budget / 1024 / 1024;
 
         NV_GPU_MEMORY_INFO_EX memoryInfo = { NV_GPU_MEMORY_INFO_EX_VER };
         if (NvAPI_GPU_GetMemoryInfoEx(NvPhysicalGpuHandle(s_caps.adapters[adapterIndex]->nvHandle), &memoryInfo) == NVAPI_OK)
         {
-            usage.systemUsageMB = (memoryInfo.availableDedicatedVideoMemory - memoryInfo.curAvailableDedicatedVideoMemory) / 1024 / 1024;
+            usage->systemUsageMB = (memoryInfo.availableDedicatedVideoMemory - memoryInfo.curAvailableDedicatedVideoMemory) / 1024 / 1024;
         }
-
-        adapter3->Release();
     }
     else
     {
@@ -1084,6 +1474,467 @@ Result getVRAMStats(uint32_t adapterIndex, VRAMUsage** _usage)
     return kResultOk;
 }
 
+Result getVRAMStatsCopy(uint32_t adapterIndex, VRAMUsage* usage)
+{
+    waitForAdapterDiscovery();
+    if (!usage) return kResultInvalidParameter;
+    std::scoped_lock lock(s_vram.mtx);
+    return queryVRAMStats(adapterIndex, usage);
+}
+
+Result getVRAMStats(uint32_t adapterIndex, VRAMUsage** _usage)
+{
+    waitForAdapterDiscovery();
+    if(!_usage) return kResultInvalidParameter;
+    // Per thread so concurrent callers do not overwrite each other's results.
+    // To prevent crashes always return a pointer to an "empty" struct in case we fail down the road
+    static thread_local VRAMUsage usage{};
+    *_usage = &usage;
+    assert(adapterIndex < s_caps.adapterCount);
+    return getVRAMStatsCopy(adapterIndex, &usage);
+}
+
+#ifdef NVIGI_WINDOWS
+//! Asks the least recently used instances to free VRAM until the deficit is covered
+static void relieveVRAMPressure(uint32_t adapterIndex)
+{
+    VRAMUsage usage{};
+    if (getVRAMStatsCopy(adapterIndex, &usage) != kResultOk || usage.currentUsageMB <= usage.budgetMB) return;
+
+    size_t deficitMB = usage.currentUsageMB - usage.budgetMB;
+    NVIGI_LOG_WARN("VRAM budget on adapter %u dropped to %zuMB, process is using %zuMB (tracked reservations %zuMB)", adapterIndex, usage.budgetMB, usage.currentUsageMB, usage.trackedReservationsMB);
+
+    std::vector<std::pair<uint64_t, void*>> candidates;
+    {
+        std::scoped_lock lock(s_vram.mtx);
+        for (auto& [instance, reservation] : s_vram.reservations)
+        {
+            if (reservation.adapterIndex == adapterIndex && reservation.callback) candidates.push_back({ reservation.lastUse, instance });
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    for (auto& [lastUse, instance] : candidates)
+    {
+        if (deficitMB == 0) break;
+        VRAMManager::Reservation reservation;
+        {
+            // Could have been released in the meantime, once marked as in callback releasing waits for us
+            std::scoped_lock lock(s_vram.mtx);
+            auto it = s_vram.reservations.find(instance);
+            if (it == s_vram.reservations.end()) continue;
+            reservation = it->second;
+            s_vram.inCallback = instance;
+        }
+        auto freedMB = reservation.callback(adapterIndex, deficitMB, instance, reservation.userData);
+        {
+            std::scoped_lock lock(s_vram.mtx);
+            s_vram.inCallback = {};
+        }
+        s_vram.callbackDone.notify_all();
+        NVIGI_LOG_INFO("Plugin '%s' freed %zuMB of VRAM", extra::guidToString(reservation.plugin.id).c_str(), freedMB);
+        deficitMB -= std::min(deficitMB, freedMB);
+    }
+    if (deficitMB)
+    {
+        NVIGI_LOG_WARN("Still %zuMB over VRAM budget on adapter %u", deficitMB, adapterIndex);
+    }
+}
+
+//! Must be called with VRAM manager lock held
+static void startVRAMManager()
+{
+    if (s_vram.thread.joinable()) return;
+
+    s_vram.budgetEvent = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    s_vram.stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    for (uint32_t i = 0; i < s_caps.adapterCount; i++)
+    {
+        if (!s_vram.adapters[i])
+        {
+            static_cast<IUnknown*>(s_caps.adapters[i]->nativeInterface)->QueryInterface(&s_vram.adapters[i]);
+        }
+        if (s_vram.adapters[i] && FAILED(s_vram.adapters[i]->RegisterVideoMemoryBudgetChangeNotificationEvent(s_vram.budgetEvent, &s_vram.cookies[i])))
+        {
+            NVIGI_LOG_WARN("Failed to register for VRAM budget notifications on adapter %u", i);
+        }
+    }
+    s_vram.thread = std::thread([]()
+    {
+        HANDLE events[] = { s_vram.stopEvent, s_vram.budgetEvent };
+        while (WaitForMultipleObjects(2, events, FALSE, INFINITE) == WAIT_OBJECT_0 + 1)
+        {
+            for (uint32_t i = 0; i < s_caps.adapterCount; i++)
+            {
+                relieveVRAMPressure(i);
+            }
+        }
+    });
+}
+
+static void stopVRAMManager()
+{
+    if (s_vram.thread.joinable())
+    {
+        SetEvent(s_vram.stopEvent);
+        s_vram.thread.join();
+    }
+    std::scoped_lock lock(s_vram.mtx);
+    for (uint32_t i = 0; i < kMaxNumSupportedGPUs; i++)
+    {
+        if (!s_vram.adapters[i]) continue;
+        if (s_vram.cookies[i]) s_vram.adapters[i]->UnregisterVideoMemoryBudgetChangeNotification(s_vram.cookies[i]);
+        s_vram.adapters[i]->Release();
+        s_vram.adapters[i] = {};
+        s_vram.cookies[i] = {};
+    }
+    if (s_vram.budgetEvent) CloseHandle(s_vram.budgetEvent);
+    if (s_vram.stopEvent) CloseHandle(s_vram.stopEvent);
+    s_vram.budgetEvent = s_vram.stopEvent = {};
+}
+#endif
+
+//! Must be called with VRAM manager lock held
+static void reserveVRAMLocked(uint32_t adapterIndex, const PluginID& plugin, void* instance, size_t sizeMB, PFun_VRAMPressureCallback* callback, void* userData)
+{
+    s_vram.reservations[instance] = { adapterIndex, plugin, sizeMB, callback, userData, ++s_vram.useCounter };
+#ifdef NVIGI_WINDOWS
+    if (callback) startVRAMManager();
+#endif
+}
+
+Result reserveVRAM(uint32_t adapterIndex, const PluginID& plugin, void* instance, size_t sizeMB, PFun_VRAMPressureCallback* callback, void* userData)
+{
+    waitForAdapterDiscovery();
+    if (!instance || adapterIndex >= s_caps.adapterCount) return kResultInvalidParameter;
+
+    std::scoped_lock lock(s_vram.mtx);
+    reserveVRAMLocked(adapterIndex, plugin, instance, sizeMB, callback, userData);
+    return kResultOk;
+}
+
+Result releaseVRAM(void* instance)
+{
+    std::unique_lock lock(s_vram.mtx);
+    auto result = s_vram.reservations.erase(instance) ? kResultOk : kResultItemNotFound;
+#ifdef NVIGI_WINDOWS
+    // Instance is typically destroyed right after this returns, callback releasing its own instance must not wait for itself
+    if (std::this_thread::get_id() != s_vram.thread.get_id())
+    {
+        s_vram.callbackDone.wait(lock, [instance]() { return s_vram.inCallback != instance; });
+    }
+#endif
+    return result;
+}
+
+Result touchVRAMReservation(void* instance)
+{
+    std::scoped_lock lock(s_vram.mtx);
+    auto it = s_vram.reservations.find(instance);
+    if (it == s_vram.reservations.end()) return kResultItemNotFound;
+    it->second.lastUse = ++s_vram.useCounter;
+    return kResultOk;
+}
+
+//! Adapter drives at least one display
+static bool hasDisplayOutput(uint32_t adapterIndex)
+{
+#ifdef NVIGI_WINDOWS
+    IDXGIAdapter* adapter{};
+    static_cast<IUnknown*>(s_caps.adapters[adapterIndex]->nativeInterface)->QueryInterface(&adapter);
+    if (!adapter) return false;
+    IDXGIOutput* output{};
+    bool hasOutput = SUCCEEDED(adapter->EnumOutputs(0, &output));
+    if (output) output->Release();
+    adapter->Release();
+    return hasOutput;
+#else
+    (void)adapterIndex;
+    return false;
+#endif
+}
+
+//! GPU utilization in [0,1], 0 if not available
+static float getAdapterUtilization(uint32_t adapterIndex)
+{
+#ifdef NVIGI_WINDOWS
+    if (s_caps.adapters[adapterIndex]->vendor == VendorId::eNVDA && s_caps.adapters[adapterIndex]->nvHandle)
+    {
+        NV_GPU_DYNAMIC_PSTATES_INFO_EX info = { NV_GPU_DYNAMIC_PSTATES_INFO_EX_VER };
+        if (NvAPI_GPU_GetDynamicPstatesInfoEx(NvPhysicalGpuHandle(s_caps.adapters[adapterIndex]->nvHandle), &info) == NVAPI_OK && info.utilization[0].bIsPresent)
+        {
+            return std::min(float(info.utilization[0].percentage), 100.0f) / 100.0f;
+        }
+    }
+#else
+    (void)adapterIndex;
+#endif
+    return 0.0f;
+}
+
+Result selectAdapter(const AdapterPlacementRequest& request, uint32_t* adapterIndex)
+{
+    waitForAdapterDiscovery();
+    if (!adapterIndex || (request.instance && !request.plugin)) return kResultInvalidParameter;
+
+    struct Candidate
+    {
+        uint32_t index;
+        size_t freeMB;
+        float load;
+        float score;
+        bool display;
+    };
+    std::vector<Candidate> candidates;
+    // Held until the reservation is made, otherwise concurrent placements all see the same free VRAM and pick the same adapter
+    std::scoped_lock lock(s_vram.mtx);
+    for (uint32_t i = 0; i < s_caps.adapterCount; i++)
+    {
+        auto adapter = s_caps.adapters[i];
+        if (request.vendor != VendorId::eAny && adapter->vendor != request.vendor) continue;
+        if (adapter->vendor == VendorId::eMS) continue;
+
+        VRAMUsage usage{};
+        queryVRAMStats(i, &usage);
+        // System wide usage covers other processes (multi-session servers), tracked reservations cover models not loaded yet
+        size_t usedMB = std::min(adapter->dedicatedMemoryInMB, std::max(usage.systemUsageMB, usage.trackedReservationsMB));
+        Candidate candidate{ i, adapter->dedicatedMemoryInMB - usedMB };
+        candidate.load = 0.5f * (adapter->dedicatedMemoryInMB ? float(usedMB) / float(adapter->dedicatedMemoryInMB) : 1.0f) + 0.5f * getAdapterUtilization(i);
+        // Headroom weighted by compute so a faster GPU gets proportionally more instances
+        candidate.score = (1.0f - candidate.load) * (adapter->shaderGFLOPS > 0.0f ? adapter->shaderGFLOPS : 1.0f);
+        candidate.display = request.avoidDisplayAdapter && hasDisplayOutput(i);
+        if (candidate.freeMB >= request.requiredVRAMMB) candidates.push_back(candidate);
+    }
+    if (candidates.empty())
+    {
+        NVIGI_LOG_ERROR("No adapter has %zuMB of free VRAM", request.requiredVRAMMB);
+        return kResultInsufficientResources;
+    }
+
+    auto best = std::min_element(candidates.begin(), candidates.end(), [&request](const Candidate& a, const Candidate& b)
+    {
+        if (a.display != b.display) return !a.display;
+        return request.policy == AdapterPlacementPolicy::ePack ? a.load > b.load : a.score > b.score;
+    });
+    if (best->display)
+    {
+        NVIGI_LOG_WARN("Only display adapters can host the instance, using adapter %u", best->index);
+    }
+    *adapterIndex = best->index;
+    NVIGI_LOG_VERBOSE("Placing instance on adapter %u '%s' (free %zuMB, load %.2f)", best->index, s_caps.adapters[best->index]->description.c_str(), best->freeMB, best->load);
+
+    if (request.instance)
+    {
+        reserveVRAMLocked(best->index, *request.plugin, request.instance, request.requiredVRAMMB, nullptr, nullptr);
+    }
+    return kResultOk;
+}
+
+//! CPU topology, detected on first use
+struct CpuTopologyCache
+{
+    std::once_flag once;
+    CpuTopology topology{};
+    //! Logical processors of each physical core, used to count cores in an affinity mask
+    std::vector<uint64_t> coreMasks;
+};
+static CpuTopologyCache s_cpu{};
+
+static void detectCpuTopology()
+{
+    auto& topology = s_cpu.topology;
+#ifdef NVIGI_WINDOWS
+    DWORD size = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &size);
+    std::vector<uint8_t> buffer(size);
+    auto info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data());
+    if (size && GetLogicalProcessorInformationEx(RelationAll, info, &size))
+    {
+        struct Core { uint64_t mask; BYTE efficiencyClass; };
+        std::vector<Core> cores;
+        BYTE maxEfficiencyClass = 0;
+        for (DWORD offset = 0; offset < size;)
+        {
+            auto entry = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data() + offset);
+            if (entry->Relationship == RelationProcessorCore && entry->Processor.GroupMask[0].Group == 0)
+            {
+                cores.push_back({ entry->Processor.GroupMask[0].Mask, entry->Processor.EfficiencyClass });
+                maxEfficiencyClass = std::max(maxEfficiencyClass, entry->Processor.EfficiencyClass);
+            }
+            else if (entry->Relationship == RelationCache && entry->Cache.Level == 3 && entry->Cache.GroupMask.Group == 0)
+            {
+                if (topology.l3DomainCount < kMaxCpuL3Domains)
+                {
+                    topology.l3DomainMasks[topology.l3DomainCount++] = entry->Cache.GroupMask.Mask;
+                }
+            }
+            offset += entry->Size;
+        }
+        // Higher efficiency class means higher performance, non-hybrid CPUs report zero for all cores
+        topology.hybrid = maxEfficiencyClass > 0;
+        for (auto& core : cores)
+        {
+            s_cpu.coreMasks.push_back(core.mask);
+            topology.allMask |= core.mask;
+            if (!topology.hybrid || core.efficiencyClass == maxEfficiencyClass)
+            {
+                topology.performanceMask |= core.mask;
+                topology.performanceCoreCount++;
+            }
+            else
+            {
+                topology.efficiencyMask |= core.mask;
+                topology.efficiencyCoreCount++;
+            }
+        }
+    }
+#endif
+    if (s_cpu.coreMasks.empty())
+    {
+        // No topology information, treat each logical processor as a core
+        auto count = std::clamp(std::thread::hardware_concurrency(), 1u, 64u);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            s_cpu.coreMasks.push_back(1ull << i);
+            topology.allMask |= 1ull << i;
+        }
+        topology.performanceMask = topology.allMask;
+        topology.performanceCoreCount = count;
+    }
+    if (topology.l3DomainCount == 0)
+    {
+        topology.l3DomainMasks[topology.l3DomainCount++] = topology.allMask;
+    }
+    topology.physicalCoreCount = (uint32_t)s_cpu.coreMasks.size();
+    topology.logicalProcessorCount = (uint32_t)std::bitset<64>(topology.allMask).count();
+    NVIGI_LOG_INFO("CPU topology: %u logical processors, %u cores (%u P-cores, %u E-cores), %u L3 domain(s)", topology.logicalProcessorCount,
+        topology.physicalCoreCount, topology.performanceCoreCount, topology.efficiencyCoreCount, topology.l3DomainCount);
+}
+
+static const CpuTopology& getCpuTopologyShared()
+{
+    std::call_once(s_cpu.once, detectCpuTopology);
+    return s_cpu.topology;
+}
+
+Result getCpuTopology(CpuTopology* topology)
+{
+    if (!topology) return kResultInvalidParameter;
+    *topology = getCpuTopologyShared();
+    return kResultOk;
+}
+
+Result resolveCpuThreadBudget(const CpuThreadBudget* budget, uint32_t requestedThreads, CpuThreadAssignment* assignment)
+{
+    if (!assignment) return kResultInvalidParameter;
+    auto& topology = getCpuTopologyShared();
+
+    uint64_t mask = topology.allMask;
+    uint32_t maxThreads = 0;
+    if (budget)
+    {
+        maxThreads = budget->maxThreads;
+        if (budget->affinityMask)
+        {
+            mask = budget->affinityMask & topology.allMask;
+        }
+        else if (topology.hybrid && budget->coreClass == CpuCoreClass::ePerformance)
+        {
+            mask = topology.performanceMask;
+        }
+        else if (topology.hybrid && budget->coreClass == CpuCoreClass::eEfficiency)
+        {
+            mask = topology.efficiencyMask;
+        }
+        if (budget->singleL3Domain)
+        {
+            // Domain covering most of the selected processors
+            uint64_t best = 0;
+            for (uint32_t i = 0; i < topology.l3DomainCount; i++)
+            {
+                uint64_t candidate = mask & topology.l3DomainMasks[i];
+                if (std::bitset<64>(candidate).count() > std::bitset<64>(best).count()) best = candidate;
+            }
+            mask = best;
+        }
+        if (!mask)
+        {
+            NVIGI_LOG_ERROR("CPU thread budget does not select any of the available processors (0x%llx)", topology.allMask);
+            return kResultInvalidParameter;
+        }
+    }
+
+    // Hyper-threads share execution units, one inference thread per physical core is the most that scales
+    uint32_t cores = 0;
+    for (auto coreMask : s_cpu.coreMasks)
+    {
+        if (coreMask & mask) cores++;
+    }
+    uint32_t threads = requestedThreads ? requestedThreads : cores;
+    if (maxThreads) threads = std::min(threads, maxThreads);
+    threads = std::clamp(threads, 1u, std::max(cores, 1u));
+
+    assignment->threadCount = threads;
+    // Everything allowed is the same as no affinity, do not pin threads needlessly
+    assignment->affinityMask = mask == topology.allMask ? 0 : mask;
+    if (requestedThreads && threads != requestedThreads)
+    {
+        NVIGI_LOG_VERBOSE("CPU thread budget limits %u requested threads to %u (affinity 0x%llx)", requestedThreads, threads, assignment->affinityMask);
+    }
+    return kResultOk;
+}
+
+Result applyCpuThreadAssignment(const CpuThreadAssignment& assignment, CpuThreadAssignment* previous)
+{
+#ifdef NVIGI_WINDOWS
+    GROUP_AFFINITY affinity{};
+    affinity.Group = 0;
+    affinity.Mask = (KAFFINITY)(assignment.affinityMask ? assignment.affinityMask : getCpuTopologyShared().allMask);
+    GROUP_AFFINITY old{};
+    if (!SetThreadGroupAffinity(GetCurrentThread(), &affinity, &old))
+    {
+        NVIGI_LOG_ERROR("SetThreadGroupAffinity failed with error %u", GetLastError());
+        return kResultInvalidState;
+    }
+    if (previous)
+    {
+        previous->threadCount = assignment.threadCount;
+        previous->affinityMask = old.Mask == getCpuTopologyShared().allMask ? 0 : old.Mask;
+    }
+    return kResultOk;
+#else
+    (void)assignment;
+    (void)previous;
+    return kResultNoImplementation;
+#endif
+}
+
+void cleanup(SystemCaps* caps)
+{
+#ifdef NVIGI_WINDOWS
+    // Adapters are released below, no more notifications after this point
+    stopVRAMManager();
+#endif
+    for (auto& adapter : caps->adapters)
+    {
+        if (!adapter) continue;
+#ifdef NVIGI_WINDOWS
+        auto i = static_cast<IUnknown*>(adapter->nativeInterface);
+        i->Release();
+#endif
+        delete adapter;
+    }
+    // Next 'nvigiInit' starts a fresh discovery
+    s_caps = {};
+    s_capsDiscovery = {};
+}
+
+const SystemCaps* getSystemCapsShared()
+{
+    waitForAdapterDiscovery();
+    return &s_caps;
+}
+
 void setPreferenceFlags(PreferenceFlags flags)
 {
     if (flags & PreferenceFlags::eDisablePrivilegeDowngrade)
@@ -1105,6 +1956,14 @@ ISystem* getInterface()
         s_instance.getVRAMStats = getVRAMStats;
         s_instance.downgradeKeyAdminPrivileges = downgradePrivileges;
         s_instance.restoreKeyAdminPrivileges = restorePrivileges;
+        s_instance.getVRAMStatsCopy = getVRAMStatsCopy;
+        s_instance.reserveVRAM = reserveVRAM;
+        s_instance.releaseVRAM = releaseVRAM;
+        s_instance.touchVRAMReservation = touchVRAMReservation;
+        s_instance.selectAdapter = selectAdapter;
+        s_instance.getCpuTopology = getCpuTopology;
+        s_instance.resolveCpuThreadBudget = resolveCpuThreadBudget;
+        s_instance.applyCpuThreadAssignment = applyCpuThreadAssignment;
     }
     return &s_instance;
 }
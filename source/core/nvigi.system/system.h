@@ -12,6 +12,7 @@
 #include "source/core/nvigi.api/nvigi_struct.h"
 #include "source/core/nvigi.api/nvigi_version.h"
 #include "source/core/nvigi.api/nvigi_types.h"
+#include "source/core/nvigi.api/nvigi_cpu.h"
 #include "source/core/nvigi.api/internal.h"
 #include "source/core/nvigi.types/types.h"
 
@@ -74,31 +75,153 @@ struct alignas(8) SystemCaps {
 struct alignas(8) VRAMUsage
 {
     VRAMUsage() { };
-    NVIGI_UID(UID({ 0xbcb847bc, 0xe8d0, 0x466d,{0x92, 0x7a, 0xc8, 0x10, 0xa7, 0xa2, 0x39, 0xbc} }), kStructVersion1)
+    NVIGI_UID(UID({ 0xbcb847bc, 0xe8d0, 0x466d,{0x92, 0x7a, 0xc8, 0x10, 0xa7, 0xa2, 0x39, 0xbc} }), kStructVersion2)
 
-    size_t currentUsageMB;          // this process
-    size_t systemUsageMB;           // system wide usage
-    size_t availableToReserveMB;
-    size_t currentReservationMB;
-    size_t budgetMB;                // total budget
+    size_t currentUsageMB{};          // this process
+    size_t systemUsageMB{};           // system wide usage
+    size_t availableToReserveMB{};
+    size_t currentReservationMB{};
+    size_t budgetMB{};                // total budget
+
+    //! v2
+    size_t trackedReservationsMB{};   // sum of all plugin reservations, see ISystem::reserveVRAM
 
     //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
 };
 
 NVIGI_VALIDATE_STRUCT(VRAMUsage)
 
+//! Called when the VRAM budget for the adapter drops below what this process is using
+//!
+//! 'requestedMB' is how much the process is over budget, plugin should shrink caches or release the idle instance
+//! and return how many MB were actually freed (0 if nothing can be done). Triggered on the VRAM manager thread,
+//! least recently used reservations first, until the deficit is covered.
+//!
+//! IMPORTANT: Must not call 'reserveVRAM' or 'releaseVRAM' for other instances from within the callback
+using PFun_VRAMPressureCallback = size_t(uint32_t adapterIndex, size_t requestedMB, void* instance, void* userData);
+
+enum class AdapterPlacementPolicy : uint32_t
+{
+    //! Adapter with the most headroom (VRAM, utilization, compute) so load is balanced across GPUs
+    eSpread,
+    //! Most loaded adapter which still fits the model so other GPUs stay free for large models
+    ePack,
+};
+
+//! Interface 'AdapterPlacementRequest'
+//!
+//! {BCB86150-C679-49D5-93A4-B03D5E94E3B7}
+struct alignas(8) AdapterPlacementRequest
+{
+    AdapterPlacementRequest() { };
+    NVIGI_UID(UID({ 0xbcb86150, 0xc679, 0x49d5,{ 0x93, 0xa4, 0xb0, 0x3d, 0x5e, 0x94, 0xe3, 0xb7 } }), kStructVersion1)
+
+    AdapterPlacementPolicy policy = AdapterPlacementPolicy::eSpread;
+    //! Typically 'modelMemoryBudgetMB' from CommonCapabilitiesAndRequirements, 0 if unknown
+    size_t requiredVRAMMB{};
+    VendorId vendor = VendorId::eAny;
+    //! Skip adapters driving a display unless there is no other choice
+    bool avoidDisplayAdapter{};
+    //! Optional, if provided 'requiredVRAMMB' is reserved for the instance on the selected adapter (see 'reserveVRAM')
+    //! so concurrent placements see each other before the model is actually loaded
+    const PluginID* plugin{};
+    void* instance{};
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(AdapterPlacementRequest)
+
+constexpr uint32_t kMaxCpuL3Domains = 16;
+
+//! Interface 'CpuTopology'
+//!
+//! Detected once, masks cover processor group 0 (bit N is logical processor N)
+//!
+//! {22004307-FF80-44B0-A650-2A2AD40CF076}
+struct alignas(8) CpuTopology
+{
+    CpuTopology() { };
+    NVIGI_UID(UID({ 0x22004307, 0xff80, 0x44b0,{ 0xa6, 0x50, 0x2a, 0x2a, 0xd4, 0x0c, 0xf0, 0x76 } }), kStructVersion1)
+
+    uint32_t logicalProcessorCount{};
+    uint32_t physicalCoreCount{};
+    //! Physical cores, on non-hybrid CPUs all cores are reported as performance cores
+    uint32_t performanceCoreCount{};
+    uint32_t efficiencyCoreCount{};
+    bool hybrid{};
+    uint64_t allMask{};
+    uint64_t performanceMask{};
+    uint64_t efficiencyMask{};
+    uint32_t l3DomainCount{};
+    uint64_t l3DomainMasks[kMaxCpuL3Domains]{};
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(CpuTopology)
+
+//! Interface 'CpuThreadAssignment'
+//!
+//! Resolved 'CpuThreadBudget', what a backend should actually use for its CPU threads
+//!
+//! {DC15B286-61F6-4B13-AD6D-7D747296BA89}
+struct alignas(8) CpuThreadAssignment
+{
+    CpuThreadAssignment() { };
+    NVIGI_UID(UID({ 0xdc15b286, 0x61f6, 0x4b13,{ 0xad, 0x6d, 0x7d, 0x74, 0x72, 0x96, 0xba, 0x89 } }), kStructVersion1)
+
+    uint32_t threadCount{};
+    //! Zero means no affinity, threads can run anywhere
+    uint64_t affinityMask{};
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(CpuThreadAssignment)
+
 //! Interface 'ISystem'
 //!
 //! {E2B94F2B-7AE8-467D-98E0-6F2B14410079}
 struct alignas(8) ISystem
 {
     ISystem() { };
-    NVIGI_UID(UID({ 0xe2b94f2b, 0x7ae8, 0x467d,{0x98, 0xe0, 0x6f, 0x2b, 0x14, 0x41, 0x00, 0x79} }), kStructVersion1)
+    NVIGI_UID(UID({ 0xe2b94f2b, 0x7ae8, 0x467d,{0x98, 0xe0, 0x6f, 0x2b, 0x14, 0x41, 0x00, 0x79} }), kStructVersion4)
 
+    //! Adapters, including the detailed per-adapter info (clocks, core counts, bandwidth, GFLOPS), are discovered
+    //! asynchronously during 'nvigiInit', this blocks until discovery is done
     const SystemCaps* (*getSystemCaps)() {};
     Result (*getVRAMStats)(uint32_t adapterIndex, VRAMUsage** usage);
     Result (*downgradeKeyAdminPrivileges)();
     Result (*restoreKeyAdminPrivileges)();
+
+    //! v2
+    //! 
+    //! Thread safe alternative to 'getVRAMStats', copies the stats into the provided struct
+    Result (*getVRAMStatsCopy)(uint32_t adapterIndex, VRAMUsage* usage);
+    //! Declares VRAM used by a plugin instance (typically 'modelMemoryBudgetMB' from CommonCapabilitiesAndRequirements)
+    //! Calling again for the same instance updates the reservation, callback is optional
+    Result (*reserveVRAM)(uint32_t adapterIndex, const PluginID& plugin, void* instance, size_t sizeMB, PFun_VRAMPressureCallback* callback, void* userData);
+    //! Blocks while the pressure callback for this instance is running, once this returns the callback is never invoked for it
+    Result (*releaseVRAM)(void* instance);
+    //! Marks the instance as used so it is among the last to be asked to free VRAM, typically called on evaluate
+    Result (*touchVRAMReservation)(void* instance);
+
+    //! v3
+    //! 
+    //! Picks the adapter for a new instance when the host did not pin one, based on live VRAM usage, tracked reservations and utilization
+    //! Returns kResultInsufficientResources if no adapter has enough free VRAM
+    Result (*selectAdapter)(const AdapterPlacementRequest& request, uint32_t* adapterIndex);
+
+    //! v4
+    //! 
+    //! CPU topology (P-cores, E-cores, L3 domains) shared by all plugins so they can stay out of each other's way
+    Result (*getCpuTopology)(CpuTopology* topology);
+    //! Turns the host's budget (optional) into a thread count and affinity, 'requestedThreads' is what the plugin would use
+    //! otherwise (typically 'CommonCreationParameters::numThreads'). Thread count never exceeds the physical cores selected.
+    Result (*resolveCpuThreadBudget)(const CpuThreadBudget* budget, uint32_t requestedThreads, CpuThreadAssignment* assignment);
+    //! Applies the affinity to the calling thread, 'previous' (optional) receives the old one so it can be restored
+    Result (*applyCpuThreadAssignment)(const CpuThreadAssignment& assignment, CpuThreadAssignment* previous);
     //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
 };
 
@@ -106,6 +229,21 @@ NVIGI_VALIDATE_STRUCT(ISystem)
 
 ISystem* getInterface();
 
+//! Backend helper, resolves 'CpuThreadBudget' chained to 'params' (if any)
+//!
+//! Always returns something usable, on older cores or without a budget it is 'defaultThreads' with no affinity
+inline CpuThreadAssignment getCpuThreadAssignment(const BaseStructure* params, uint32_t defaultThreads)
+{
+    CpuThreadAssignment assignment{};
+    assignment.threadCount = defaultThreads;
+    auto isystem = getInterface();
+    if (isystem && isystem->getVersion() >= kStructVersion4)
+    {
+        isystem->resolveCpuThreadBudget(findStruct<CpuThreadBudget>(params), defaultThreads, &assignment);
+    }
+    return assignment;
+}
+
 #ifdef NVIGI_WINDOWS
 
 struct ScopedDowngradePrivileges
@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "source/core/nvigi.thread/thread.h"
+
+//! Unit tests for threading primitives
+//! 
+namespace nvigi
+{
+
+namespace thread
+{
+
+#ifndef NVIGI_PRODUCTION
+//! Live 'ThreadContextCounter' objects, local classes cannot have static data members
+inline std::atomic<int> s_liveThreadContextCounters = 0;
+
+struct ThreadContextCounter
+{
+    int value = 0;
+    ThreadContextCounter() { s_liveThreadContextCounters++; }
+    ~ThreadContextCounter() { s_liveThreadContextCounters--; }
+};
+
+TEST_CASE("thread::ThreadContext is unique per thread and reclaimed on exit", "[thread][context]") {
+    {
+        ThreadContext<ThreadContextCounter> context;
+        std::vector<std::thread> threads;
+        std::atomic<int> valid = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            threads.emplace_back([&context, &valid]()->void
+            {
+                for (int j = 0; j < 100; j++) context.getContext().value++;
+                if (context.getContext().value == 100) valid++;
+            });
+        }
+        for (auto& t : threads) t.join();
+        REQUIRE(valid == 8);
+        REQUIRE(s_liveThreadContextCounters == 0);
+        context.getContext().value = 1;
+        context.clear();
+        REQUIRE(context.getContext().value == 0);
+    }
+    REQUIRE(s_liveThreadContextCounters == 0);
+}
+
+TEST_CASE("thread::WorkerPool executes all scheduled jobs", "[thread][pool]") {
+    WorkerPool pool(L"nvigi.test.pool", THREAD_PRIORITY_NORMAL, 4);
+    REQUIRE(pool.getWorkerCount() == 4);
+    std::atomic<int> counter = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        REQUIRE(pool.scheduleWork([&counter]()->void { counter++; }));
+    }
+    REQUIRE(pool.flush(5000) == std::cv_status::no_timeout);
+    REQUIRE(counter == 1000);
+    REQUIRE(pool.getJobCount() == 0);
+}
+
+TEST_CASE("thread::WorkerPool runs jobs scheduled from workers", "[thread][pool]") {
+    WorkerPool pool(L"nvigi.test.pool", THREAD_PRIORITY_NORMAL, 4);
+    std::atomic<int> counter = 0;
+    for (int i = 0; i < 100; i++)
+    {
+        pool.scheduleWork([&pool, &counter]()->void
+        {
+            REQUIRE(pool.isWorkerThread());
+            for (int j = 0; j < 10; j++)
+            {
+                pool.scheduleWork([&counter]()->void { counter++; });
+            }
+        });
+    }
+    REQUIRE(pool.flush(5000) == std::cv_status::no_timeout);
+    REQUIRE(counter == 1000);
+}
+
+TEST_CASE("thread::WorkerPool retires perpetual jobs on flush", "[thread][pool]") {
+    WorkerPool pool(L"nvigi.test.pool", THREAD_PRIORITY_NORMAL, 2);
+    std::atomic<int> runs = 0;
+    std::atomic<int> retired = 0;
+    pool.scheduleWork([&runs]()->void { runs++; }, true, WorkPriority::eNormal, [&retired]()->void { retired++; });
+    while (runs < 10)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(pool.flush(5000) == std::cv_status::no_timeout);
+    REQUIRE(retired == 1);
+    REQUIRE(pool.getJobCount() == 0);
+}
+
+TEST_CASE("thread::WorkerPool flushes only the owner's jobs", "[thread][pool]") {
+    WorkerPool pool(L"nvigi.test.pool", THREAD_PRIORITY_NORMAL, 2);
+    int ownerA = 0, ownerB = 0;
+    std::atomic<int> runsA = 0, runsB = 0;
+    std::atomic<int> retiredA = 0, retiredB = 0;
+    pool.scheduleWork([&runsA]()->void { runsA++; }, true, WorkPriority::eNormal, [&retiredA]()->void { retiredA++; }, &ownerA);
+    pool.scheduleWork([&runsB]()->void { runsB++; }, true, WorkPriority::eNormal, [&retiredB]()->void { retiredB++; }, &ownerB);
+    while (runsA < 10 || runsB < 10)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(pool.flushOwner(&ownerA, 5000) == std::cv_status::no_timeout);
+    REQUIRE(retiredA == 1);
+    REQUIRE(retiredB == 0);
+    REQUIRE(pool.getJobCount() == 1);
+
+    // Other owner's perpetual job keeps running, flushing jobs without an owner leaves it alone too
+    int runs = runsB;
+    while (runsB < runs + 10)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(pool.flushOwner(nullptr, 5000) == std::cv_status::no_timeout);
+    REQUIRE(retiredB == 0);
+    REQUIRE(pool.flush(5000) == std::cv_status::no_timeout);
+    REQUIRE(retiredB == 1);
+    REQUIRE(pool.getJobCount() == 0);
+}
+
+TEST_CASE("thread::WorkerThread runs timed, periodic and dependent jobs", "[thread][worker]") {
+    WorkerThread worker(L"nvigi.test.worker", THREAD_PRIORITY_NORMAL);
+    std::atomic<int> ticks = 0;
+    std::atomic<bool> timedRan = false;
+    std::atomic<bool> dependentRan = false;
+    auto start = std::chrono::steady_clock::now();
+    auto timed = worker.scheduleAt(start + std::chrono::milliseconds(20), [&timedRan]()->void { timedRan = true; });
+    worker.scheduleAfter(timed, [&timedRan, &dependentRan]()->void { dependentRan = timedRan.load(); });
+    auto periodic = worker.scheduleEvery(std::chrono::milliseconds(5), [&ticks]()->void { ticks++; });
+    REQUIRE(periodic != kInvalidJobHandle);
+    // One shot work is not held back by the timers
+    std::atomic<bool> ran = false;
+    worker.scheduleWork([&ran]()->void { ran = true; });
+    while (!ran || ticks < 3)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(worker.cancel(periodic));
+    // Also when the tick is still running and the job has not retired yet
+    REQUIRE(!worker.cancel(periodic));
+    auto count = ticks.load();
+    REQUIRE(worker.flush(5000) == std::cv_status::no_timeout);
+    REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+    REQUIRE(dependentRan);
+    // Tick which was already running when canceled can still complete
+    REQUIRE(ticks <= count + 1);
+    REQUIRE(worker.getJobCount() == 0);
+
+    // Periodic jobs are retired by flush, dependency which already retired does not block
+    worker.scheduleEvery(std::chrono::milliseconds(1), []()->void {});
+    REQUIRE(worker.flush(5000) == std::cv_status::no_timeout);
+    worker.scheduleAfter(timed, [&ran]()->void { ran = false; });
+    REQUIRE(worker.flush(5000) == std::cv_status::no_timeout);
+    REQUIRE(!ran);
+}
+
+TEST_CASE("thread::waitFor honors notifications and sub-millisecond timeouts", "[thread][timer]") {
+    auto start = std::chrono::steady_clock::now();
+    preciseSleep(std::chrono::microseconds(1500));
+    REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::microseconds(1500));
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool ready = false;
+    {
+        std::unique_lock lock(mtx);
+        start = std::chrono::steady_clock::now();
+        REQUIRE(!waitFor(cv, lock, std::chrono::milliseconds(2), [&ready]() { return ready; }));
+        REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(2));
+    }
+    std::thread notifier([&]()->void
+    {
+        std::scoped_lock lock(mtx);
+        ready = true;
+        cv.notify_all();
+    });
+    {
+        std::unique_lock lock(mtx);
+        REQUIRE(waitFor(cv, lock, std::chrono::seconds(5), [&ready]() { return ready; }));
+    }
+    notifier.join();
+}
+#endif
+
+}
+}
@@ -6,14 +6,22 @@
 
 #include <vector>
 #include <list>
+#include <deque>
 #include <functional>
 #include <mutex>
 #include <atomic>
 #include <map>
+#include <unordered_set>
+#include <unordered_map>
 #include <thread>
 #include <condition_variable>
+#include <memory>
+#include <string>
+#include <algorithm>
 
 #include "source/core/nvigi.log/log.h"
+#include "source/core/nvigi.api/nvigi_struct.h"
+#include "source/core/nvigi.thread/timer.h"
 
 using namespace std::chrono_literals;
 
@@ -22,140 +30,327 @@ namespace nvigi
 namespace thread
 {
 
+namespace detail
+{
+
+//! Contexts owned by one ThreadContext instance, shared with all threads which created a context in it
+//!
+//! Only touched when a thread creates its context, when a thread exits or when owner is cleared/destroyed.
+struct ThreadContextRegistry
+{
+    std::mutex mutex;
+    bool alive = true;
+    void (*deleter)(void*) {};
+    std::unordered_set<void*> contexts;
+
+    void release(void* context)
+    {
+        std::scoped_lock lock(mutex);
+        if (alive && contexts.erase(context))
+        {
+            deleter(context);
+        }
+    }
+
+    void releaseAll()
+    {
+        std::scoped_lock lock(mutex);
+        alive = false;
+        for (auto context : contexts)
+        {
+            deleter(context);
+        }
+        contexts.clear();
+    }
+};
+
+//! Per thread slots, indexed by ThreadContext instance index
+struct ThreadContextSlots
+{
+    struct Slot
+    {
+        uint64_t generation{};
+        void* context{};
+        std::shared_ptr<ThreadContextRegistry> registry;
+    };
+    std::vector<Slot> slots;
+
+    //! Thread is exiting, reclaim all contexts it created which are still alive
+    ~ThreadContextSlots()
+    {
+        for (auto& slot : slots)
+        {
+            if (slot.registry) slot.registry->release(slot.context);
+        }
+    }
+
+    //! Instance indices are recycled so per thread slot arrays stay proportional to the number of live instances
+    inline static std::mutex s_indexMutex{};
+    inline static std::vector<uint32_t> s_freeIndices{};
+    inline static uint32_t s_nextIndex{};
+    //! Generation tells apart different owners of the same index, never reused
+    inline static std::atomic<uint64_t> s_nextGeneration{ 1 };
+
+    static uint32_t acquireIndex()
+    {
+        std::scoped_lock lock(s_indexMutex);
+        if (s_freeIndices.empty()) return s_nextIndex++;
+        auto index = s_freeIndices.back();
+        s_freeIndices.pop_back();
+        return index;
+    }
+
+    static void releaseIndex(uint32_t index)
+    {
+        std::scoped_lock lock(s_indexMutex);
+        s_freeIndices.push_back(index);
+    }
+};
+inline thread_local ThreadContextSlots s_threadContextSlots{};
+
+}
+
+//! Per thread instance of T
+//!
+//! Any thread id is supported, lookup is a thread_local array access without any locks.
+//! Context is deleted when its thread exits or when this object is cleared or destroyed.
+//!
+//! NOTE: 'clear' and destruction must not race with 'getContext' on other threads.
 template<typename T>
 struct ThreadContext
 {
-    ThreadContext() 
+    ThreadContext()
     {
-        // Space for 64K thread ids.
-        // This does not waste too much memory
-        threads.resize(65536);
+        index = detail::ThreadContextSlots::acquireIndex();
+        reset();
     };
 
     ~ThreadContext()
     {
-        clear();
+        registry->releaseAll();
+        detail::ThreadContextSlots::releaseIndex(index);
     }
 
     void clear()
     {
-        for (auto& t : threads)
-        {
-            delete t;
-        }
-        for (auto& t : threadMap)
-        {
-            delete t.second;
-        }
-        threads.clear();
-        threadMap.clear();
+        registry->releaseAll();
+        // New generation invalidates all thread local slots pointing to the released contexts
+        reset();
     }
 
     T &getContext()
     {
-        // Accessing thread context via thread id
-        // This is super fast since there are no sync points
-        // but can result in huge memory consumption if
-        // OS assigns some really big id (it is 32bit value)
-        // As long as thread ids are 16bit we are good.
-        // If we hit a title where thread ids are crazy high we 
-        // need to switch to classic mode with mutex lock.
-#ifdef NVIGI_WINDOWS
-        auto id = GetCurrentThreadId();
-#endif
-        if (!useThreadMap && id > 65536)
+        auto& slots = detail::s_threadContextSlots.slots;
+        if (index < slots.size() && slots[index].generation == generation)
         {
-            useThreadMap = true; 
-            NVIGI_LOG_WARN("Thread id over 65536 detected, switching to thread map");
+            return *static_cast<T*>(slots[index].context);
         }
-        // Atomic check
-        if (useThreadMap)
+
+        // First access from this thread
+        if (index >= slots.size())
         {
-            std::lock_guard<std::mutex> lock(mutex);
-            auto it = threadMap.find(id);
-            if (it == threadMap.end())
-            {
-                T* context = new T;
-                // If we switched to this later in the game copy our context if any
-                if (threads.size() > (size_t)id && threads[id])
-                {
-                    *context = *threads[id];
-                }
-                threadMap[id] = context;
-            }
-            return *threadMap[id];
+            slots.resize(index + 1);
         }
-
-        // Each thread has different id so no need to sync here
-        if (!threads[id])
+        auto& slot = slots[index];
+        T* context = new T();
         {
-            threads[id] = new T();
-            threadCount++;
-            NVIGI_LOG_HINT("detected new thread %u - total threads %u", id, threadCount.load());
+            std::scoped_lock lock(registry->mutex);
+            registry->contexts.insert(context);
         }
-        return *threads[id];
+        // Previous owner of this index is no longer around so just drop the reference
+        slot.generation = generation;
+        slot.context = context;
+        slot.registry = registry;
+        threadCount++;
+        NVIGI_LOG_HINT("detected new thread - total threads %u", threadCount.load());
+        return *context;
     }
 
 protected:
 
-    std::atomic<bool> useThreadMap = false;
-    std::mutex mutex = {};
-    std::vector<T*> threads = {};
-    std::map<unsigned long, T*> threadMap = {};
+    void reset()
+    {
+        generation = detail::ThreadContextSlots::s_nextGeneration++;
+        registry = std::make_shared<detail::ThreadContextRegistry>();
+        registry->deleter = [](void* context)->void { delete static_cast<T*>(context); };
+    }
+
+    uint32_t index{};
+    uint64_t generation{};
+    std::shared_ptr<detail::ThreadContextRegistry> registry;
     std::atomic<uint32_t> threadCount = {};
 };
 
+//! Identifies a job scheduled on 'WorkerThread', used as a dependency or to cancel the job
+using JobHandle = uint64_t;
+constexpr JobHandle kInvalidJobHandle = 0;
+
+//! Single worker executing jobs in order
+//!
+//! Besides regular jobs it supports jobs which run at a given time, periodically or once another job retires.
+//! Timed jobs wait in a heap ordered by deadline and the worker sleeps until the earliest one, idle worker never polls.
+//!
+//! * perpetual jobs are re-queued after all other pending work until flush is requested, they keep the worker busy so
+//!   prefer 'scheduleEvery' for anything polling status or driving a heartbeat
+//! * periodic jobs are retired on flush or 'cancel' without running again
+//! * flush(timeout) blocks until all scheduled jobs are retired or timeout expires, including timed and dependent ones
 class WorkerThread
 {
+    using Clock = std::chrono::steady_clock;
+
+    struct Job
+    {
+        JobHandle handle{};
+        std::function<void(void)> func;
+        bool perpetual = false;
+        //! Non zero for periodic jobs
+        Clock::duration interval{};
+        Clock::time_point due{};
+    };
+
     std::mutex m_mtx;
 
     std::condition_variable m_cv; // work queue cv
     bool m_workAdded = false;
 
-    std::condition_variable m_cvf; // flushing cv, no need for flag since we use a timeout for it
+    std::condition_variable m_cvf; // flushing cv
 
     std::atomic<bool> m_quit = false;
     std::atomic<bool> m_flush = false;
 
     size_t m_jobCount = 0;
     std::thread m_thread;
-    std::list<std::pair<bool, std::function<void(void)>>> m_work{};
+    //! Jobs ready to run
+    std::list<Job> m_work{};
+    //! Jobs waiting for their deadline, min heap on 'due'
+    std::vector<Job> m_timers{};
+    //! Jobs waiting for another job to retire, keyed by the dependency
+    std::map<JobHandle, std::vector<Job>> m_dependents{};
+    //! Scheduled but not retired yet
+    std::unordered_set<JobHandle> m_pending{};
+    //! Canceled while running
+    std::unordered_set<JobHandle> m_canceled{};
+    JobHandle m_nextHandle = 1;
     std::wstring m_name;
 
+    static bool dueLater(const Job& a, const Job& b)
+    {
+        // Same deadline runs in the scheduling order
+        return a.due > b.due || (a.due == b.due && a.handle > b.handle);
+    }
+
+    //! Caller must hold 'm_mtx'
+    void pushTimer(Job&& job)
+    {
+        m_timers.push_back(std::move(job));
+        std::push_heap(m_timers.begin(), m_timers.end(), dueLater);
+    }
+
+    //! Caller must hold 'm_mtx'
+    void notifyWorker()
+    {
+        m_workAdded = true;
+        m_cv.notify_one();
+    }
+
+    //! Caller must hold 'm_mtx'
+    JobHandle add(Job&& job, bool timed, JobHandle dependency = kInvalidJobHandle)
+    {
+        job.handle = m_nextHandle++;
+        auto handle = job.handle;
+        m_pending.insert(handle);
+        m_jobCount++;
+        if (m_pending.count(dependency))
+        {
+            m_dependents[dependency].push_back(std::move(job));
+            return handle;
+        }
+        if (timed)
+        {
+            pushTimer(std::move(job));
+        }
+        else
+        {
+            m_work.push_back(std::move(job));
+        }
+        notifyWorker();
+        return handle;
+    }
+
+    //! Releases jobs depending on this one, caller must hold 'm_mtx'
+    void retire(JobHandle handle)
+    {
+        m_pending.erase(handle);
+        auto it = m_dependents.find(handle);
+        if (it != m_dependents.end())
+        {
+            for (auto& job : it->second)
+            {
+                m_work.push_back(std::move(job));
+            }
+            m_dependents.erase(it);
+            notifyWorker();
+        }
+        if (--m_jobCount == 0)
+        {
+            // Tell threads waiting on flush that we are done
+            m_cvf.notify_all();
+        }
+    }
+
     void workerFunction()
     {
+        std::unique_lock<std::mutex> lock(m_mtx);
         while (!m_quit)
         {
-            std::unique_lock<std::mutex> lock(m_mtx);
-            if (m_work.empty())
+            // Expired timers join the queue after work which is already waiting there
+            auto now = Clock::now();
+            while (!m_timers.empty() && m_timers.front().due <= now)
             {
-                // Tell threads waiting on flush that we are done
-                m_cvf.notify_all();
-
-                // Check if there was work added while the work queue was empty. If added, don't wait. Otherwise, keep waiting until notify + work added
-                m_cv.wait(lock, [this] { return m_workAdded; });
-                m_workAdded = false;
+                std::pop_heap(m_timers.begin(), m_timers.end(), dueLater);
+                m_work.push_back(std::move(m_timers.back()));
+                m_timers.pop_back();
             }
-            else
+            if (m_work.empty())
             {
-                auto [perpetual, func] = m_work.front();
-                lock.unlock();
-                // NOTE: No need to wrap this in the exception handler
-                // since all internal workers are already executing within one.
-                func();
-                lock.lock();
-                // Done, remove from the queue
-                m_work.erase(m_work.begin());
-                // Keep perpetual jobs until flush is requested
-                if (!perpetual || m_flush.load())
+                // Sleep until new work is added or the earliest deadline, whichever comes first
+                if (m_timers.empty())
                 {
-                    m_jobCount--;
+                    m_cv.wait(lock, [this] { return m_workAdded; });
                 }
                 else
                 {
-                    // Back to the queue to execute again but after other workloads (if any)
-                    m_work.push_back({ perpetual, func });
+                    // Precise wait, a regular one can run timers a whole system timer tick late on Windows
+                    waitUntil(m_cv, lock, m_timers.front().due, [this] { return m_workAdded; });
                 }
+                m_workAdded = false;
+                continue;
+            }
+            auto job = std::move(m_work.front());
+            m_work.pop_front();
+            lock.unlock();
+            // NOTE: No need to wrap this in the exception handler
+            // since all internal workers are already executing within one.
+            job.func();
+            lock.lock();
+            bool periodic = job.interval != Clock::duration::zero();
+            // Keep perpetual and periodic jobs until flush or cancel is requested
+            if (m_canceled.erase(job.handle) || m_flush.load() || m_quit.load() || (!job.perpetual && !periodic))
+            {
+                retire(job.handle);
+            }
+            else if (job.perpetual)
+            {
+                // Back to the queue to execute again but after other workloads (if any)
+                m_work.push_back(std::move(job));
+            }
+            else
+            {
+                // Fixed rate, periods missed while the worker was busy are skipped rather than executed back to back
+                now = Clock::now();
+                job.due += job.interval;
+                if (job.due <= now) job.due = now + job.interval;
+                pushTimer(std::move(job));
             }
         }
     }
@@ -196,10 +391,22 @@ public:
         if (!m_flush.exchange(true))
         {
             std::unique_lock<std::mutex> lock(m_mtx);
-            if (!m_work.empty())
+            // Periodic jobs waiting for their next deadline are retired right away
+            std::vector<JobHandle> periodic;
+            for (auto& job : m_timers)
+            {
+                if (job.interval != Clock::duration::zero()) periodic.push_back(job.handle);
+            }
+            if (!periodic.empty())
             {
-                // Wait and free the lock
-                res = m_cvf.wait_for(lock, std::chrono::milliseconds(timeout));
+                std::erase_if(m_timers, [](const Job& job) { return job.interval != Clock::duration::zero(); });
+                std::make_heap(m_timers.begin(), m_timers.end(), dueLater);
+                for (auto handle : periodic) retire(handle);
+            }
+            if (m_jobCount)
+            {
+                // Wait and free the lock, worker notifies once the last job retires
+                res = waitFor(m_cvf, lock, std::chrono::milliseconds(timeout), [this] { return m_jobCount == 0; }) ? std::cv_status::no_timeout : std::cv_status::timeout;
                 if (res == std::cv_status::timeout)
                 {
                     NVIGI_LOG_WARN("Worker thread '%S' timed out", m_name.c_str());
@@ -216,19 +423,604 @@ public:
         return m_jobCount;
     }
 
-    bool scheduleWork(const std::function<void(void)>& func, bool perpetual = false)
+    //! Runs 'func' as soon as the worker gets to it
+    JobHandle scheduleWork(const std::function<void(void)>& func, bool perpetual = false)
     {
         std::unique_lock<std::mutex> lock(m_mtx);
-        m_work.push_back({ perpetual, func });
-        m_workAdded = true;
-        m_jobCount++;
+        return add({ kInvalidJobHandle, func, perpetual }, false);
+    }
 
-        m_cv.notify_one();
+    //! Runs 'func' once 'due' is reached, after any work already waiting at that point
+    JobHandle scheduleAt(Clock::time_point due, const std::function<void(void)>& func)
+    {
+        std::unique_lock<std::mutex> lock(m_mtx);
+        return add({ kInvalidJobHandle, func, false, {}, due }, true);
+    }
 
+    //! Runs 'func' every 'interval' starting one interval from now, until flush or 'cancel'
+    JobHandle scheduleEvery(Clock::duration interval, const std::function<void(void)>& func)
+    {
+        if (interval <= Clock::duration::zero()) return kInvalidJobHandle;
+        std::unique_lock<std::mutex> lock(m_mtx);
+        return add({ kInvalidJobHandle, func, false, interval, Clock::now() + interval }, true);
+    }
+
+    //! Runs 'func' once 'dependency' retires, right away if it already did
+    JobHandle scheduleAfter(JobHandle dependency, const std::function<void(void)>& func)
+    {
+        std::unique_lock<std::mutex> lock(m_mtx);
+        return add({ kInvalidJobHandle, func }, false, dependency);
+    }
+
+    //! Retires job which did not run yet, running job completes but does not run again
+    //!
+    //! Jobs depending on it are released. Returns false if the job already retired or was canceled before.
+    bool cancel(JobHandle handle)
+    {
+        std::unique_lock<std::mutex> lock(m_mtx);
+        if (!m_pending.count(handle) || m_canceled.count(handle)) return false;
+        auto matches = [handle](const Job& job) { return job.handle == handle; };
+        if (std::erase_if(m_timers, matches))
+        {
+            std::make_heap(m_timers.begin(), m_timers.end(), dueLater);
+        }
+        else if (!std::erase_if(m_work, matches))
+        {
+            auto it = std::find_if(m_dependents.begin(), m_dependents.end(), [&matches](auto& item) { return std::erase_if(item.second, matches) != 0; });
+            if (it != m_dependents.end())
+            {
+                if (it->second.empty()) m_dependents.erase(it);
+            }
+            else
+            {
+                // Running right now, retired by the worker once done
+                m_canceled.insert(handle);
+                return true;
+            }
+        }
+        retire(handle);
         return true;
     }
 };
 
+//! Priority lane used when scheduling work on the WorkerPool
+enum class WorkPriority : uint32_t
+{
+    //! Regular work, executed in LIFO order on the scheduling worker and stolen FIFO by others
+    eNormal,
+    //! Latency critical work, always picked up before any normal work
+    eHigh
+};
+
+//! Single producer (owner) multiple consumer (thieves) lock-free deque
+//!
+//! Based on "Correct and Efficient Work-Stealing for Weak Memory Models" (Le, Pop, Cohen, Nardelli 2013)
+//!
+//! Only the owning worker can push/pop, any other worker can steal from the opposite end.
+//! Capacity is fixed, push fails when full and caller must fall back to the shared queue.
+template<typename T, size_t Capacity = 4096>
+class WorkStealingDeque
+{
+    static_assert((Capacity& (Capacity - 1)) == 0, "Capacity must be power of two");
+    alignas(64) std::atomic<int64_t> m_top{};
+    alignas(64) std::atomic<int64_t> m_bottom{};
+    alignas(64) std::atomic<T*> m_items[Capacity]{};
+
+public:
+    //! Owner only
+    bool push(T* item)
+    {
+        auto b = m_bottom.load(std::memory_order_relaxed);
+        auto t = m_top.load(std::memory_order_acquire);
+        if (b - t >= (int64_t)Capacity) return false;
+        m_items[b & (Capacity - 1)].store(item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    //! Owner only
+    T* pop()
+    {
+        auto b = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto t = m_top.load(std::memory_order_relaxed);
+        T* item{};
+        if (t <= b)
+        {
+            item = m_items[b & (Capacity - 1)].load(std::memory_order_relaxed);
+            if (t == b)
+            {
+                // Last item, race against thieves
+                if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    item = nullptr;
+                }
+                m_bottom.store(b + 1, std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    //! Any thread
+    T* steal()
+    {
+        auto t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto b = m_bottom.load(std::memory_order_acquire);
+        if (t < b)
+        {
+            T* item = m_items[t & (Capacity - 1)].load(std::memory_order_relaxed);
+            if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                // Lost the race to another thief or the owner
+                return nullptr;
+            }
+            return item;
+        }
+        return nullptr;
+    }
+
+    //! Approximate, any thread
+    bool empty() const
+    {
+        return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+    }
+};
+
+//! Multi-worker pool with per-worker lock-free deques and work stealing
+//!
+//! Semantics match WorkerThread:
+//!
+//! * perpetual jobs are re-queued after all other pending work until flush is requested
+//! * flush(timeout) blocks until all scheduled jobs are retired or timeout expires
+//!
+//! Work scheduled from a worker thread goes to that worker's own deque, work scheduled
+//! from any other thread goes to the shared queue. High priority work has its own lane
+//! which is always checked first.
+class WorkerPool
+{
+    struct Job
+    {
+        std::function<void(void)> func;
+        std::function<void(void)> onRetire;
+        bool perpetual = false;
+        //! See 'flushOwner', null for jobs without an owner
+        const void* owner{};
+        ~Job() { if (onRetire) onRetire(); }
+    };
+
+    struct Worker
+    {
+        std::thread thread;
+        WorkStealingDeque<Job> deque;
+    };
+
+    std::mutex m_mtx;
+    std::condition_variable m_cv;  // work available cv
+    std::condition_variable m_cvf; // flushing cv
+
+    std::atomic<bool> m_quit = false;
+    std::atomic<bool> m_flush = false;
+    std::atomic<size_t> m_jobCount = 0; // scheduled but not retired yet
+    std::atomic<size_t> m_queued = 0;   // sitting in one of the queues
+    std::atomic<uint32_t> m_sleeping = 0;
+
+    //! Outstanding jobs per owner and owners being flushed, see 'flushOwner'
+    std::mutex m_ownerMtx;
+    std::unordered_map<const void*, size_t> m_ownerJobs;
+    std::unordered_map<const void*, uint32_t> m_flushingOwners;
+    std::atomic<uint32_t> m_ownerFlushes = 0;
+
+    //! Shared queues for work coming from non-worker threads, overflowing deques and perpetual jobs
+    std::mutex m_sharedMtx;
+    std::deque<Job*> m_shared[2]{};
+    std::atomic<size_t> m_sharedCount[2]{};
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::wstring m_name;
+
+    inline static thread_local WorkerPool* s_currentPool{};
+    inline static thread_local uint32_t s_currentWorker{};
+
+    void pushShared(Job* job, WorkPriority priority)
+    {
+        auto lane = (size_t)priority;
+        {
+            std::scoped_lock lock(m_sharedMtx);
+            m_shared[lane].push_back(job);
+        }
+        m_sharedCount[lane]++;
+    }
+
+    Job* popShared(WorkPriority priority)
+    {
+        auto lane = (size_t)priority;
+        // Avoid taking the lock when lane is empty
+        if (m_sharedCount[lane].load() == 0) return nullptr;
+        std::scoped_lock lock(m_sharedMtx);
+        if (m_shared[lane].empty()) return nullptr;
+        auto job = m_shared[lane].front();
+        m_shared[lane].pop_front();
+        m_sharedCount[lane]--;
+        return job;
+    }
+
+    void wakeWorker()
+    {
+        // Paired with the sleeping check in workerFunction, both sides use seq_cst so either
+        // the worker sees queued work or we see the sleeping worker and notify it.
+        if (m_sleeping.load() > 0)
+        {
+            std::unique_lock<std::mutex> lock(m_mtx);
+            m_cv.notify_one();
+        }
+    }
+
+    void enqueue(Job* job, WorkPriority priority)
+    {
+        m_queued++;
+        // Normal work scheduled from one of our own workers stays local to that worker
+        if (priority == WorkPriority::eNormal && s_currentPool == this)
+        {
+            if (!m_workers[s_currentWorker]->deque.push(job))
+            {
+                pushShared(job, priority);
+            }
+        }
+        else
+        {
+            pushShared(job, priority);
+        }
+        wakeWorker();
+    }
+
+    Job* findJob(uint32_t index)
+    {
+        Job* job = popShared(WorkPriority::eHigh);
+        if (!job) job = m_workers[index]->deque.pop();
+        if (!job) job = popShared(WorkPriority::eNormal);
+        if (!job)
+        {
+            // Steal from others, start with our neighbour to spread the contention
+            auto count = (uint32_t)m_workers.size();
+            for (uint32_t i = 1; i < count && !job; i++)
+            {
+                job = m_workers[(index + i) % count]->deque.steal();
+            }
+        }
+        if (job) m_queued--;
+        return job;
+    }
+
+    bool isOwnerFlushing(const void* owner)
+    {
+        if (m_ownerFlushes.load() == 0) return false;
+        std::scoped_lock lock(m_ownerMtx);
+        return m_flushingOwners.count(owner) != 0;
+    }
+
+    size_t getOwnerJobCount(const void* owner)
+    {
+        std::scoped_lock lock(m_ownerMtx);
+        auto it = m_ownerJobs.find(owner);
+        return it == m_ownerJobs.end() ? 0 : it->second;
+    }
+
+    void retire(Job* job)
+    {
+        auto owner = job->owner;
+        delete job;
+        bool ownerDone = false;
+        {
+            std::scoped_lock lock(m_ownerMtx);
+            auto it = m_ownerJobs.find(owner);
+            if (--it->second == 0)
+            {
+                m_ownerJobs.erase(it);
+                ownerDone = true;
+            }
+        }
+        if (--m_jobCount == 0 || (ownerDone && m_ownerFlushes.load() > 0))
+        {
+            // Tell threads waiting on flush that we are done
+            std::unique_lock<std::mutex> lock(m_mtx);
+            m_cvf.notify_all();
+        }
+    }
+
+    void workerFunction(uint32_t index)
+    {
+        s_currentPool = this;
+        s_currentWorker = index;
+        while (!m_quit)
+        {
+            auto job = findJob(index);
+            if (!job)
+            {
+                std::unique_lock<std::mutex> lock(m_mtx);
+                m_sleeping++;
+                m_cv.wait(lock, [this] { return m_quit.load() || m_queued.load() > 0; });
+                m_sleeping--;
+                continue;
+            }
+            // NOTE: No need to wrap this in the exception handler
+            // since all internal workers are already executing within one.
+            job->func();
+            // Keep perpetual jobs until flush is requested
+            if (!job->perpetual || m_flush.load() || m_quit.load() || isOwnerFlushing(job->owner))
+            {
+                retire(job);
+            }
+            else
+            {
+                // Back to the shared queue to execute again but after other workloads (if any)
+                m_queued++;
+                pushShared(job, WorkPriority::eNormal);
+                wakeWorker();
+            }
+        }
+    }
+
+public:
+    WorkerPool(const WorkerPool&) = delete;
+
+    //! Zero workers means one per logical core minus one (for the host's main thread), never less than one
+    WorkerPool(const wchar_t* name, int priority, uint32_t numWorkers = 0)
+    {
+        m_name = name;
+        if (numWorkers == 0)
+        {
+            auto cores = std::thread::hardware_concurrency();
+            numWorkers = cores > 1 ? cores - 1 : 1;
+        }
+        for (uint32_t i = 0; i < numWorkers; i++)
+        {
+            m_workers.push_back(std::make_unique<Worker>());
+        }
+        // Start threads only once all deques exist since workers steal from each other
+        for (uint32_t i = 0; i < numWorkers; i++)
+        {
+            auto& worker = *m_workers[i];
+            worker.thread = std::thread(&WorkerPool::workerFunction, this, i);
+#ifdef NVIGI_WINDOWS
+            if (!SetThreadPriority(worker.thread.native_handle(), priority))
+            {
+                NVIGI_LOG_WARN("Failed to set thread priority to %d for thread '%S'", priority, name);
+            }
+            auto threadName = m_name + L"." + std::to_wstring(i);
+            SetThreadDescription(worker.thread.native_handle(), threadName.c_str());
+#else
+            (void)priority;
+#endif
+        }
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mtx);
+            m_quit = true; // set to true so that worker threads can exit their loop
+        }
+        m_cv.notify_all(); // wake up all threads
+        for (auto& worker : m_workers)
+        {
+            worker->thread.join(); // block until thread exits
+        }
+        // Retire anything which never got a chance to run
+        for (uint32_t i = 0; i < m_workers.size(); i++)
+        {
+            while (auto job = m_workers[i]->deque.steal()) retire(job);
+        }
+        for (auto& lane : m_shared)
+        {
+            for (auto job : lane) retire(job);
+            lane.clear();
+        }
+    }
+
+    std::cv_status flush(uint32_t timeout = 500)
+    {
+        std::cv_status res = std::cv_status::no_timeout;
+
+        // Atomic swap to true and check that it was false so we don't flush
+        // multiple times from different threads.
+        if (!m_flush.exchange(true))
+        {
+            // Perpetual jobs sitting in queues must run once more to be retired
+            m_cv.notify_all();
+            std::unique_lock<std::mutex> lock(m_mtx);
+            if (!waitFor(m_cvf, lock, std::chrono::milliseconds(timeout), [this] { return m_jobCount.load() == 0; }))
+            {
+                res = std::cv_status::timeout;
+                NVIGI_LOG_WARN("Worker pool '%S' timed out", m_name.c_str());
+            }
+            m_flush = false;
+        }
+        return res;
+    }
+
+    //! Same as 'flush' but only for the jobs scheduled with 'owner', jobs of other owners keep running
+    //!
+    //! Null 'owner' stands for the jobs scheduled without an owner
+    std::cv_status flushOwner(const void* owner, uint32_t timeout = 500)
+    {
+        std::cv_status res = std::cv_status::no_timeout;
+        {
+            std::scoped_lock lock(m_ownerMtx);
+            m_flushingOwners[owner]++;
+        }
+        m_ownerFlushes++;
+        // Perpetual jobs sitting in queues must run once more to be retired
+        m_cv.notify_all();
+        {
+            std::unique_lock<std::mutex> lock(m_mtx);
+            if (!waitFor(m_cvf, lock, std::chrono::milliseconds(timeout), [this, owner] { return getOwnerJobCount(owner) == 0; }))
+            {
+                res = std::cv_status::timeout;
+                NVIGI_LOG_WARN("Worker pool '%S' timed out", m_name.c_str());
+            }
+        }
+        m_ownerFlushes--;
+        std::scoped_lock lock(m_ownerMtx);
+        if (--m_flushingOwners[owner] == 0)
+        {
+            m_flushingOwners.erase(owner);
+        }
+        return res;
+    }
+
+    size_t getJobCount() const
+    {
+        return m_jobCount.load();
+    }
+
+    uint32_t getWorkerCount() const
+    {
+        return (uint32_t)m_workers.size();
+    }
+
+    //! Returns true if called from one of the workers in this pool
+    bool isWorkerThread() const
+    {
+        return s_currentPool == this;
+    }
+
+    //! Optional 'onRetire' is called exactly once, when job is done (perpetual jobs after flush) or if pool is destroyed before it ran
+    //!
+    //! Optional 'owner' groups jobs for 'flushOwner'
+    bool scheduleWork(std::function<void(void)>&& func, bool perpetual = false, WorkPriority priority = WorkPriority::eNormal, std::function<void(void)>&& onRetire = {}, const void* owner = nullptr)
+    {
+        if (m_quit) return false;
+        auto job = new Job{ std::move(func), std::move(onRetire), perpetual, owner };
+        {
+            std::scoped_lock lock(m_ownerMtx);
+            m_ownerJobs[owner]++;
+        }
+        m_jobCount++;
+        enqueue(job, priority);
+        return true;
+    }
+
+    bool scheduleWork(const std::function<void(void)>& func, bool perpetual = false, WorkPriority priority = WorkPriority::eNormal)
+    {
+        return scheduleWork(std::function<void(void)>(func), perpetual, priority);
+    }
+};
+
+//! C style job callbacks, shared across DLL boundaries hence no STL
+using PFun_WorkerPoolJob = void(void* userData);
+
+using WorkerPoolFlags = uint32_t;
+constexpr WorkerPoolFlags kWorkerPoolFlagNone = 0x0;
+constexpr WorkerPoolFlags kWorkerPoolFlagPerpetual = 0x01;
+constexpr WorkerPoolFlags kWorkerPoolFlagHighPriority = 0x02;
+
+//! Interface 'IWorkerPool'
+//!
+//! Framework wide worker pool shared by all plugins, obtained via framework::getInterface(framework, core::framework::kId, &pool)
+//!
+//! IMPORTANT: Plugins must make sure their jobs are done before 'nvigiPluginDeregister' returns since plugin can be
+//! unloaded while the pool keeps running. Perpetual jobs are only retired on flush so plugins should prefer regular jobs
+//! which reschedule themselves.
+//!
+//! Jobs are flushed per owner so one plugin flushing never retires the jobs of another one. Plugins should schedule with
+//! 'scheduleOwnedWork' (v2) using a pointer unique to the plugin, for example its plugin context, and flush with 'flushOwner'.
+//!
+//! {4B98B7C7-BDC7-4E14-815E-99FA01E321CF}
+struct alignas(8) IWorkerPool
+{
+    IWorkerPool() { };
+    NVIGI_UID(UID({ 0x4b98b7c7, 0xbdc7, 0x4e14,{ 0x81, 0x5e, 0x99, 0xfa, 0x01, 0xe3, 0x21, 0xcf } }), kStructVersion2)
+
+    //! Schedules 'job' and calls optional 'retire' once the job will no longer run
+    //!
+    //! This method is thread safe.
+    bool (*scheduleWork)(PFun_WorkerPoolJob* job, PFun_WorkerPoolJob* retire, void* userData, WorkerPoolFlags flags);
+    //! Waits for the jobs scheduled without an owner ('scheduleWork'), owned jobs are not affected
+    //!
+    //! Returns kResultTimedOut if outstanding jobs did not finish within the given timeout
+    //!
+    //! This method is thread safe.
+    Result (*flush)(uint32_t timeoutMs);
+    size_t (*getJobCount)();
+    uint32_t (*getWorkerCount)();
+
+    //! v2
+
+    //! Same as 'scheduleWork' but the job belongs to 'owner'
+    //!
+    //! This method is thread safe.
+    bool (*scheduleOwnedWork)(const void* owner, PFun_WorkerPoolJob* job, PFun_WorkerPoolJob* retire, void* userData, WorkerPoolFlags flags);
+    //! Waits for the jobs of 'owner' and retires its perpetual jobs, jobs of other owners keep running
+    //!
+    //! Returns kResultTimedOut if outstanding jobs did not finish within the given timeout
+    //!
+    //! This method is thread safe.
+    Result (*flushOwner)(const void* owner, uint32_t timeoutMs);
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(IWorkerPool)
+
+//! Number of priority classes tracked by 'IPriorityArbiter', zero is the highest
+constexpr uint32_t kPriorityClassCount = 3;
+
+//! Interface 'IPriorityArbiter'
+//!
+//! Framework wide count of running evaluations per priority class (see 'InferencePriorityClass') so that evaluations
+//! in one plugin can step aside while a higher class runs in another one. Preemption is cooperative, a class waits while
+//! any higher class is running but never longer than the given timeout so lower classes cannot starve completely.
+//!
+//! {D552E31A-7B9F-48C7-AF13-B2DFBECE3DE4}
+struct alignas(8) IPriorityArbiter
+{
+    IPriorityArbiter() { };
+    NVIGI_UID(UID({ 0xd552e31a, 0x7b9f, 0x48c7,{ 0xaf, 0x13, 0xb2, 0xdf, 0xbe, 0xce, 0x3d, 0xe4 } }), kStructVersion1)
+
+    //! Waits for higher classes and marks the evaluation as running, must be paired with 'endEvaluation' even on timeout
+    //!
+    //! Returns kResultTimedOut if higher classes were still running when 'timeoutMs' expired
+    //!
+    //! This method is thread safe.
+    Result (*beginEvaluation)(uint32_t priorityClass, uint32_t timeoutMs);
+    void (*endEvaluation)(uint32_t priorityClass);
+    //! Called by a running evaluation between work items (e.g. tokens), returns immediately if no higher class is running
+    //!
+    //! This method is thread safe.
+    Result (*yield)(uint32_t priorityClass, uint32_t timeoutMs);
+    uint32_t (*getRunningCount)(uint32_t priorityClass);
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(IPriorityArbiter)
+
+//! Helper allowing plugins to schedule lambdas on the shared pool
+//!
+//! Function object is allocated and released on the plugin side so it never crosses DLL boundary.
+//! Optional 'owner' needs IWorkerPool v2, see 'IWorkerPool::flushOwner'
+inline bool scheduleWork(IWorkerPool* pool, std::function<void(void)>&& func, WorkerPoolFlags flags = kWorkerPoolFlagNone, const void* owner = nullptr)
+{
+    if (!pool || (owner && pool->getVersion() < kStructVersion2)) return false;
+    auto job = new std::function<void(void)>(std::move(func));
+    auto run = [](void* userData)->void { (*static_cast<std::function<void(void)>*>(userData))(); };
+    auto release = [](void* userData)->void { delete static_cast<std::function<void(void)>*>(userData); };
+    bool scheduled = owner ? pool->scheduleOwnedWork(owner, run, release, job, flags) : pool->scheduleWork(run, release, job, flags);
+    if (!scheduled)
+    {
+        delete job;
+        return false;
+    }
+    return true;
+}
+
 struct LockAtomic
 {
     LockAtomic() {};
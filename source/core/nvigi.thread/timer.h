@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#ifdef NVIGI_WINDOWS
+#include <windows.h>
+#endif
+
+namespace nvigi
+{
+namespace thread
+{
+
+//! Timed waits with sub-millisecond precision WITHOUT raising the global timer resolution
+//!
+//! On Windows sleeps and timeouts are rounded up to the system timer tick (15.6ms by default) unless someone calls
+//! 'NtSetTimerResolution'/'timeBeginPeriod', which costs power system wide. Instead we sleep on a per-thread
+//! 'CREATE_WAITABLE_TIMER_HIGH_RESOLUTION' timer (Windows 10 1803+) and spin the last few microseconds.
+//! On Linux 'nanosleep' and futex timeouts are already high resolution so these map to the std equivalents.
+
+//! Remaining time which is spun (with yield) rather than slept, covers the wakeup latency of high resolution timers
+constexpr auto kPreciseSleepSpinTail = std::chrono::microseconds(200);
+
+#ifdef NVIGI_WINDOWS
+//! Timeouts closer than this are polled with 'preciseSleep', anything longer can overshoot by one system timer tick
+constexpr auto kPreciseWaitPollTail = std::chrono::milliseconds(16);
+//! Polling interval within 'kPreciseWaitPollTail'
+constexpr auto kPreciseWaitPollStep = std::chrono::microseconds(500);
+
+namespace detail
+{
+struct HighResolutionTimer
+{
+    HANDLE handle{};
+    HighResolutionTimer() { handle = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS); }
+    ~HighResolutionTimer() { if (handle) CloseHandle(handle); }
+};
+
+//! Null on Windows versions without high resolution timers
+inline HANDLE getThreadTimer()
+{
+    static thread_local HighResolutionTimer s_timer{};
+    return s_timer.handle;
+}
+}
+#endif
+
+//! Sleeps until 'deadline' with sub-millisecond precision
+inline void preciseSleepUntil(std::chrono::steady_clock::time_point deadline)
+{
+#ifdef NVIGI_WINDOWS
+    auto remaining = deadline - std::chrono::steady_clock::now();
+    if (remaining > kPreciseSleepSpinTail)
+    {
+        auto sleep = remaining - kPreciseSleepSpinTail;
+        auto timer = detail::getThreadTimer();
+        LARGE_INTEGER dueTime{};
+        // Negative means relative, in 100ns units
+        dueTime.QuadPart = -std::max<int64_t>(1, std::chrono::duration_cast<std::chrono::nanoseconds>(sleep).count() / 100);
+        if (!timer || !SetWaitableTimerEx(timer, &dueTime, 0, nullptr, nullptr, nullptr, 0) || WaitForSingleObject(timer, INFINITE) != WAIT_OBJECT_0)
+        {
+            // Older OS, precision is whatever the current timer resolution is
+            std::this_thread::sleep_for(sleep);
+        }
+    }
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+#else
+    std::this_thread::sleep_until(deadline);
+#endif
+}
+
+//! Sleeps for 'duration' with sub-millisecond precision, use instead of 'std::this_thread::sleep_for'
+template<class Rep, class Period>
+void preciseSleep(const std::chrono::duration<Rep, Period>& duration)
+{
+    preciseSleepUntil(std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration));
+}
+
+//! Same as 'std::condition_variable::wait_until' with a predicate but usually returns much closer to the deadline
+//!
+//! On Windows the last 'kPreciseWaitPollTail' before the deadline is polled with 'preciseSleep' since a regular
+//! timed wait could wake up a whole timer tick late. Within that tail notifications are not waited on, the
+//! predicate is only checked every 'kPreciseWaitPollStep', so a notification can be seen up to one step late.
+//! Deadline accuracy is best effort, it depends on high resolution timer support (see 'preciseSleepUntil') and
+//! on the thread being scheduled, there is no hard latency bound.
+template<class Predicate>
+bool waitUntil(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, std::chrono::steady_clock::time_point deadline, Predicate pred)
+{
+#ifdef NVIGI_WINDOWS
+    while (!pred())
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) return false;
+        if (deadline - now > kPreciseWaitPollTail)
+        {
+            cv.wait_until(lock, deadline - kPreciseWaitPollTail);
+            continue;
+        }
+        lock.unlock();
+        preciseSleepUntil(std::min<std::chrono::steady_clock::time_point>(deadline, now + kPreciseWaitPollStep));
+        lock.lock();
+    }
+    return true;
+#else
+    return cv.wait_until(lock, deadline, pred);
+#endif
+}
+
+//! See 'waitUntil'
+template<class Rep, class Period, class Predicate>
+bool waitFor(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, const std::chrono::duration<Rep, Period>& timeout, Predicate pred)
+{
+    return waitUntil(cv, lock, std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout), pred);
+}
+
+}
+}
@@ -0,0 +1,476 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifdef NVIGI_WINDOWS
+#include <windows.h>
+#include <winmeta.h>
+#include <TraceLoggingProvider.h>
+#if __has_include(<nvtx3/nvToolsExt.h>)
+#include <nvtx3/nvToolsExt.h>
+#define NVIGI_TRACE_NVTX
+#endif
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "source/core/nvigi.trace/trace.h"
+#include "source/core/nvigi.log/log.h"
+#include "source/core/nvigi.extra/extra.h"
+
+#ifdef NVIGI_WINDOWS
+// {C3A8DB25-EACB-4F8D-9F34-E37E544F8DBA}
+TRACELOGGING_DEFINE_PROVIDER(s_etwProvider, "NVIDIA.NVIGI", (0xc3a8db25, 0xeacb, 0x4f8d, 0x9f, 0x34, 0xe3, 0x7e, 0x54, 0x4f, 0x8d, 0xba));
+#endif
+
+namespace nvigi
+{
+namespace trace
+{
+
+constexpr size_t kMaxNameLength = 63;
+constexpr size_t kThreadBatchSize = 256;
+
+//! Chrome trace event, names are copied since plugins can be unloaded before the trace is written
+struct ChromeEvent
+{
+    char name[kMaxNameLength + 1];
+    char phase; // 'X' complete, 'b'/'e' async begin/end, 'C' counter
+    uint32_t tid;
+    uint64_t timestampUs;
+    uint64_t durationUs;
+    uint64_t id;
+    int64_t value;
+    UID plugin;
+    bool hasPlugin;
+    const void* instance;
+};
+
+struct OpenScope
+{
+    ChromeEvent event;
+    uint32_t backends;
+};
+
+struct AsyncInfo
+{
+    ChromeEvent event;
+    uint32_t backends;
+#ifdef NVIGI_TRACE_NVTX
+    nvtxRangeId_t range;
+#endif
+};
+
+struct TraceContext
+{
+    uint32_t activeBackends{};
+    std::string path;
+    size_t maxEvents{};
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    std::mutex eventsMtx;
+    std::vector<ChromeEvent> events;
+    std::atomic<uint64_t> droppedEvents{};
+
+    std::mutex asyncMtx;
+    std::unordered_map<uint64_t, AsyncInfo> async;
+    std::atomic<uint64_t> nextAsyncId{ 1 };
+
+#ifdef NVIGI_TRACE_NVTX
+    nvtxDomainHandle_t nvtxDomain{};
+#endif
+};
+
+static TraceContext s_ctx{};
+static ITrace s_trace{};
+
+uint64_t now()
+{
+    return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - s_ctx.epoch).count());
+}
+
+uint32_t getThreadId()
+{
+#ifdef NVIGI_WINDOWS
+    return GetCurrentThreadId();
+#else
+    return uint32_t(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+#endif
+}
+
+void appendEvents(const ChromeEvent* events, size_t count)
+{
+    std::scoped_lock lock(s_ctx.eventsMtx);
+    size_t room = s_ctx.maxEvents > s_ctx.events.size() ? s_ctx.maxEvents - s_ctx.events.size() : 0;
+    size_t n = std::min(room, count);
+    s_ctx.events.insert(s_ctx.events.end(), events, events + n);
+    if (n < count) s_ctx.droppedEvents += count - n;
+}
+
+//! Per thread scope stack and batch of completed events, batch is handed over on exit
+struct ThreadState
+{
+    std::vector<OpenScope> stack;
+    std::vector<ChromeEvent> batch;
+
+    ~ThreadState() { flush(); }
+
+    void push(const ChromeEvent& event)
+    {
+        batch.push_back(event);
+        if (batch.size() >= kThreadBatchSize) flush();
+    }
+    void flush()
+    {
+        if (batch.empty()) return;
+        appendEvents(batch.data(), batch.size());
+        batch.clear();
+    }
+};
+
+ThreadState& getThreadState()
+{
+    thread_local ThreadState state;
+    return state;
+}
+
+void fillEvent(ChromeEvent& event, const char* name, const PluginID* plugin, const void* instance)
+{
+    size_t len = name ? std::min(strlen(name), kMaxNameLength) : 0;
+    memcpy(event.name, name, len);
+    event.name[len] = 0;
+    event.tid = getThreadId();
+    event.hasPlugin = plugin != nullptr;
+    event.plugin = plugin ? plugin->id : UID{};
+    event.instance = instance;
+    event.timestampUs = now();
+    event.durationUs = 0;
+    event.id = 0;
+    event.value = 0;
+}
+
+#ifdef NVIGI_WINDOWS
+GUID toGUID(const UID& uid)
+{
+    GUID guid;
+    static_assert(sizeof(guid) == sizeof(uid));
+    memcpy(&guid, &uid, sizeof(guid));
+    return guid;
+}
+#endif
+
+#ifdef NVIGI_TRACE_NVTX
+nvtxEventAttributes_t getNVTXAttributes(const char* name, const void* instance)
+{
+    nvtxEventAttributes_t attributes{};
+    attributes.version = NVTX_VERSION;
+    attributes.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
+    attributes.messageType = NVTX_MESSAGE_TYPE_ASCII;
+    attributes.message.ascii = name;
+    if (instance)
+    {
+        attributes.payloadType = NVTX_PAYLOAD_TYPE_UNSIGNED_INT64;
+        attributes.payload.ullValue = uint64_t(instance);
+    }
+    return attributes;
+}
+#endif
+
+void beginScope(const char* name, const PluginID* plugin, const void* instance)
+{
+    auto backends = s_ctx.activeBackends;
+    auto& state = getThreadState();
+    state.stack.push_back({});
+    auto& scope = state.stack.back();
+    scope.backends = backends;
+    if (backends & uint32_t(TraceBackendFlags::eChromeJSON))
+    {
+        fillEvent(scope.event, name, plugin, instance);
+        scope.event.phase = 'X';
+    }
+#ifdef NVIGI_TRACE_NVTX
+    if (backends & uint32_t(TraceBackendFlags::eNVTX))
+    {
+        auto attributes = getNVTXAttributes(name, instance);
+        nvtxDomainRangePushEx(s_ctx.nvtxDomain, &attributes);
+    }
+#endif
+#ifdef NVIGI_WINDOWS
+    if (backends & uint32_t(TraceBackendFlags::eETW))
+    {
+        TraceLoggingWrite(s_etwProvider, "Scope",
+            TraceLoggingOpcode(WINEVENT_OPCODE_START),
+            TraceLoggingString(name, "Name"),
+            TraceLoggingGuid(toGUID(plugin ? plugin->id : UID{}), "Plugin"),
+            TraceLoggingPointer(instance, "Instance"));
+    }
+#endif
+}
+
+void endScope()
+{
+    auto& state = getThreadState();
+    if (state.stack.empty()) return;
+    auto scope = state.stack.back();
+    state.stack.pop_back();
+#ifdef NVIGI_WINDOWS
+    if (scope.backends & uint32_t(TraceBackendFlags::eETW))
+    {
+        TraceLoggingWrite(s_etwProvider, "Scope", TraceLoggingOpcode(WINEVENT_OPCODE_STOP));
+    }
+#endif
+#ifdef NVIGI_TRACE_NVTX
+    if (scope.backends & uint32_t(TraceBackendFlags::eNVTX))
+    {
+        nvtxDomainRangePop(s_ctx.nvtxDomain);
+    }
+#endif
+    if (scope.backends & uint32_t(TraceBackendFlags::eChromeJSON))
+    {
+        scope.event.durationUs = now() - scope.event.timestampUs;
+        state.push(scope.event);
+        // Outermost scope finished, make sure short lived threads do not hold back events
+        if (state.stack.empty()) state.flush();
+    }
+}
+
+uint64_t beginAsync(const char* name, const PluginID* plugin, const void* instance)
+{
+    auto backends = s_ctx.activeBackends;
+    if (!backends) return 0;
+    AsyncInfo info{};
+    info.backends = backends;
+    uint64_t id = s_ctx.nextAsyncId.fetch_add(1);
+    if (backends & uint32_t(TraceBackendFlags::eChromeJSON))
+    {
+        fillEvent(info.event, name, plugin, instance);
+        info.event.phase = 'b';
+        info.event.id = id;
+    }
+#ifdef NVIGI_TRACE_NVTX
+    if (backends & uint32_t(TraceBackendFlags::eNVTX))
+    {
+        auto attributes = getNVTXAttributes(name, instance);
+        info.range = nvtxDomainRangeStartEx(s_ctx.nvtxDomain, &attributes);
+    }
+#endif
+#ifdef NVIGI_WINDOWS
+    if (backends & uint32_t(TraceBackendFlags::eETW))
+    {
+        TraceLoggingWrite(s_etwProvider, "Async",
+            TraceLoggingOpcode(WINEVENT_OPCODE_START),
+            TraceLoggingUInt64(id, "Id"),
+            TraceLoggingString(name, "Name"),
+            TraceLoggingGuid(toGUID(plugin ? plugin->id : UID{}), "Plugin"),
+            TraceLoggingPointer(instance, "Instance"));
+    }
+#endif
+    std::scoped_lock lock(s_ctx.asyncMtx);
+    s_ctx.async[id] = info;
+    return id;
+}
+
+void endAsync(uint64_t id)
+{
+    AsyncInfo info{};
+    {
+        std::scoped_lock lock(s_ctx.asyncMtx);
+        auto it = s_ctx.async.find(id);
+        if (it == s_ctx.async.end()) return;
+        info = it->second;
+        s_ctx.async.erase(it);
+    }
+#ifdef NVIGI_WINDOWS
+    if (info.backends & uint32_t(TraceBackendFlags::eETW))
+    {
+        TraceLoggingWrite(s_etwProvider, "Async", TraceLoggingOpcode(WINEVENT_OPCODE_STOP), TraceLoggingUInt64(id, "Id"));
+    }
+#endif
+#ifdef NVIGI_TRACE_NVTX
+    if (info.backends & uint32_t(TraceBackendFlags::eNVTX))
+    {
+        nvtxDomainRangeEnd(s_ctx.nvtxDomain, info.range);
+    }
+#endif
+    if (info.backends & uint32_t(TraceBackendFlags::eChromeJSON))
+    {
+        ChromeEvent events[2] = { info.event, info.event };
+        events[1].phase = 'e';
+        events[1].timestampUs = now();
+        appendEvents(events, 2);
+    }
+}
+
+void counter(const char* name, const PluginID* plugin, int64_t value)
+{
+    auto backends = s_ctx.activeBackends;
+#ifdef NVIGI_WINDOWS
+    if (backends & uint32_t(TraceBackendFlags::eETW))
+    {
+        TraceLoggingWrite(s_etwProvider, "Counter",
+            TraceLoggingString(name, "Name"),
+            TraceLoggingGuid(toGUID(plugin ? plugin->id : UID{}), "Plugin"),
+            TraceLoggingInt64(value, "Value"));
+    }
+#endif
+    if (backends & uint32_t(TraceBackendFlags::eChromeJSON))
+    {
+        ChromeEvent event{};
+        fillEvent(event, name, plugin, nullptr);
+        event.phase = 'C';
+        event.value = value;
+        appendEvents(&event, 1);
+    }
+}
+
+std::string escapeJSON(const char* s)
+{
+    std::string out;
+    for (; *s; s++)
+    {
+        if (*s == '"' || *s == '\\') out += '\\';
+        if (uint8_t(*s) < 0x20) continue;
+        out += *s;
+    }
+    return out;
+}
+
+bool writeChromeJSON()
+{
+    FILE* file{};
+#ifdef NVIGI_WINDOWS
+    _wfopen_s(&file, extra::utf8ToUtf16(s_ctx.path.c_str()).c_str(), L"wt");
+#else
+    file = fopen(s_ctx.path.c_str(), "wt");
+#endif
+    if (!file)
+    {
+        NVIGI_LOG_ERROR("Failed to open trace file '%s'", s_ctx.path.c_str());
+        return false;
+    }
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    for (auto& e : s_ctx.events)
+    {
+        fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"nvigi\",\"ph\":\"%c\",\"ts\":%llu,\"pid\":1,\"tid\":%u",
+            first ? "" : ",\n", escapeJSON(e.name).c_str(), e.phase, (unsigned long long)e.timestampUs, e.tid);
+        if (e.phase == 'C')
+        {
+            // Counter tracks are keyed by name, plugin is already part of it
+            fprintf(file, ",\"args\":{\"value\":%lld}}", (long long)e.value);
+            first = false;
+            continue;
+        }
+        if (e.phase == 'X') fprintf(file, ",\"dur\":%llu", (unsigned long long)e.durationUs);
+        else fprintf(file, ",\"id\":%llu", (unsigned long long)e.id);
+        if (e.phase != 'e')
+        {
+            fprintf(file, ",\"args\":{\"plugin\":\"%s\",\"instance\":\"%p\"}", e.hasPlugin ? extra::guidToString(e.plugin).c_str() : "", e.instance);
+        }
+        fprintf(file, "}");
+        first = false;
+    }
+    fprintf(file, "\n]}\n");
+    fclose(file);
+    return true;
+}
+
+//! Called by the framework during nvigiInit, before any plugin is loaded
+void initialize(TraceBackendFlags backends, const char* utf8PathToTraceFile, uint32_t maxBufferedEvents)
+{
+    uint32_t active = 0;
+    if ((backends & TraceBackendFlags::eChromeJSON) && utf8PathToTraceFile && *utf8PathToTraceFile)
+    {
+        s_ctx.path = utf8PathToTraceFile;
+        s_ctx.maxEvents = maxBufferedEvents;
+        s_ctx.events.reserve(std::min<size_t>(maxBufferedEvents, 64 * 1024));
+        active |= uint32_t(TraceBackendFlags::eChromeJSON);
+    }
+    else if (backends & TraceBackendFlags::eChromeJSON)
+    {
+        NVIGI_LOG_WARN("Chrome trace requested but no output file provided, ignoring");
+    }
+#ifdef NVIGI_TRACE_NVTX
+    if (backends & TraceBackendFlags::eNVTX)
+    {
+        s_ctx.nvtxDomain = nvtxDomainCreateA("NVIGI");
+        active |= uint32_t(TraceBackendFlags::eNVTX);
+    }
+#else
+    if (backends & TraceBackendFlags::eNVTX)
+    {
+        NVIGI_LOG_WARN("NVTX tracing is not available in this build");
+    }
+#endif
+#ifdef NVIGI_WINDOWS
+    if (backends & TraceBackendFlags::eETW)
+    {
+        if (SUCCEEDED(TraceLoggingRegister(s_etwProvider))) active |= uint32_t(TraceBackendFlags::eETW);
+    }
+#endif
+    s_ctx.epoch = std::chrono::steady_clock::now();
+    s_ctx.activeBackends = active;
+    if (active)
+    {
+        NVIGI_LOG_INFO("Tracing enabled - backends 0x%x", active);
+    }
+}
+
+//! Called by the framework on nvigiShutdown once all plugins are unloaded
+void shutdown()
+{
+    auto active = s_ctx.activeBackends;
+    s_ctx.activeBackends = 0;
+    getThreadState().flush();
+    if (active & uint32_t(TraceBackendFlags::eChromeJSON))
+    {
+        std::scoped_lock lock(s_ctx.eventsMtx);
+        if (writeChromeJSON())
+        {
+            NVIGI_LOG_INFO("Wrote %zu trace events to '%s' (%llu dropped)", s_ctx.events.size(), s_ctx.path.c_str(), s_ctx.droppedEvents.load());
+        }
+        s_ctx.events.clear();
+        s_ctx.events.shrink_to_fit();
+    }
+#ifdef NVIGI_TRACE_NVTX
+    if (s_ctx.nvtxDomain)
+    {
+        nvtxDomainDestroy(s_ctx.nvtxDomain);
+        s_ctx.nvtxDomain = {};
+    }
+#endif
+#ifdef NVIGI_WINDOWS
+    if (active & uint32_t(TraceBackendFlags::eETW))
+    {
+        TraceLoggingUnregister(s_etwProvider);
+    }
+#endif
+    std::scoped_lock lock(s_ctx.asyncMtx);
+    s_ctx.async.clear();
+}
+
+ITrace* getInterface()
+{
+    if (!s_trace.activeBackends)
+    {
+        // Everything stays disabled until 'initialize' selects the backends
+        s_trace.activeBackends = &s_ctx.activeBackends;
+        s_trace.beginScope = beginScope;
+        s_trace.endScope = endScope;
+        s_trace.beginAsync = beginAsync;
+        s_trace.endAsync = endAsync;
+        s_trace.counter = counter;
+    }
+    return &s_trace;
+}
+
+}
+}
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "source/core/nvigi.api/nvigi.h"
+
+namespace nvigi
+{
+
+namespace trace
+{
+
+//! Interface 'ITrace'
+//!
+//! Spans routed to the backends selected by the host via 'TracePreferences'.
+//!
+//! IMPORTANT: Use 'isEnabled' (or the helpers below) before building names or tags, disabled tracing
+//! must stay at a single load and branch. Names are copied, they do not have to outlive the call.
+//!
+//! {AC1FC9A7-EC06-40C3-AEEE-6EF79EB439D1}
+struct alignas(8) ITrace {
+    ITrace() {};
+    NVIGI_UID(UID({ 0xac1fc9a7, 0xec06, 0x40c3,{ 0xae, 0xee, 0x6e, 0xf7, 0x9e, 0xb4, 0x39, 0xd1 } }), kStructVersion2)
+
+    //! Active 'TraceBackendFlags', set during nvigiInit and cleared on nvigiShutdown
+    const uint32_t* activeBackends{};
+
+    //! Span on the calling thread, scopes must be closed on the same thread in LIFO order
+    void (*beginScope)(const char* name, const PluginID* plugin, const void* instance);
+    void (*endScope)();
+
+    //! Span which can end on any thread (network transfers, GPU work), returns 0 when tracing is disabled
+    uint64_t (*beginAsync)(const char* name, const PluginID* plugin, const void* instance);
+    void (*endAsync)(uint64_t id);
+
+    //! v2
+
+    //! Sampled value (memory usage, queue depth etc.), shown as a counter track. NVTX has no counters and ignores it
+    void (*counter)(const char* name, const PluginID* plugin, int64_t value);
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(ITrace)
+
+//! Null when running on an older core
+ITrace* getInterface();
+
+inline bool isEnabled(const ITrace* trace)
+{
+    return trace && *trace->activeBackends != 0;
+}
+
+//! RAII helper, see NVIGI_TRACE_SCOPE
+struct Scope
+{
+    Scope(const char* name, const PluginID* plugin = nullptr, const void* instance = nullptr)
+    {
+        auto trace = getInterface();
+        if (isEnabled(trace))
+        {
+            active = trace;
+            trace->beginScope(name, plugin, instance);
+        }
+    }
+    ~Scope()
+    {
+        if (active) active->endScope();
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    ITrace* active{};
+};
+
+//! Movable helper for spans which end on another thread
+struct AsyncSpan
+{
+    AsyncSpan() {};
+    AsyncSpan(const char* name, const PluginID* plugin = nullptr, const void* instance = nullptr)
+    {
+        auto trace = getInterface();
+        if (isEnabled(trace)) id = trace->beginAsync(name, plugin, instance);
+    }
+    AsyncSpan(AsyncSpan&& other) noexcept : id(other.id) { other.id = 0; }
+    AsyncSpan& operator=(AsyncSpan&& other) noexcept
+    {
+        if (this != &other)
+        {
+            end();
+            id = other.id;
+            other.id = 0;
+        }
+        return *this;
+    }
+    ~AsyncSpan() { end(); }
+
+    void end()
+    {
+        if (id)
+        {
+            // Interface cannot go away while spans are open, framework outlives all plugins
+            getInterface()->endAsync(id);
+            id = 0;
+        }
+    }
+
+private:
+    uint64_t id{};
+};
+
+}
+}
+
+#ifdef NVIGI_DISABLE_TRACING
+#define NVIGI_TRACE_SCOPE(...)
+#else
+#define NVIGI_TRACE_CONCAT_(a, b) a##b
+#define NVIGI_TRACE_CONCAT(a, b) NVIGI_TRACE_CONCAT_(a, b)
+//! Usage: NVIGI_TRACE_SCOPE("evaluate", &featureId, instance);
+#define NVIGI_TRACE_SCOPE(...) nvigi::trace::Scope NVIGI_TRACE_CONCAT(nvigiTraceScope, __LINE__)(__VA_ARGS__)
+#endif
@@ -78,6 +78,33 @@ TEST_CASE("Random number can be found in the randomly generated vector", "[types
     REQUIRE(vec.contains(pickedNumber));
 }
 
+TEST_CASE("types::vector moves and grows without losing elements", "[types][vector]") {
+    types::vector<types::string> vec;
+    for (int i = 0; i < 100; i++) {
+        vec.emplace_back(std::to_string(i).c_str());
+    }
+    vec.push_back(vec[0]); // element of the same vector while relocating
+    REQUIRE(vec.size() == 101);
+    REQUIRE(vec[99] == "99");
+    REQUIRE(vec[100] == "0");
+
+    types::vector<types::string> moved(std::move(vec));
+    REQUIRE(vec.empty());
+    REQUIRE(moved.size() == 101);
+    moved.resize(2);
+    moved.resize(3);
+    REQUIRE(moved[1] == "1");
+    REQUIRE(moved[2].empty());
+
+    types::vector<uint8_t> bytes = { 1, 2, 3 };
+    types::vector<uint8_t> copy;
+    copy = bytes;
+    bytes = std::move(copy);
+    REQUIRE(copy.empty());
+    REQUIRE(bytes.size() == 3);
+    REQUIRE(bytes[2] == 3);
+}
+
 //! STRING
 
 TEST_CASE("std::string supports constructing empty strings", "[types][string]") {
@@ -97,6 +124,18 @@ TEST_CASE("std::string supports substring operations", "[types][string]") {
     REQUIRE(substr == "Hello");
 }
 
+TEST_CASE("types::string supports move and in place copies", "[types][string]") {
+    nvigi::types::string str = "Hello, World!";
+    nvigi::types::string moved(std::move(str));
+    REQUIRE(str.empty());
+    REQUIRE(moved == "Hello, World!");
+    nvigi::types::string shorter = "Hi";
+    moved = shorter;
+    REQUIRE(moved == "Hi");
+    REQUIRE(!(moved == "Hi!"));
+    REQUIRE((nvigi::types::string() + moved).size() == 2);
+}
+
 TEST_CASE("std::string finds substring positions correctly", "[types][string]") {
     nvigi::types::string str = "Hello, World!";
     auto pos = str.find("World");
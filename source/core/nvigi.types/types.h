@@ -6,6 +6,12 @@
 
 #include <cstring>
 #include <stdexcept>
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 #include "source/core/nvigi.memory/memory.h"
 
@@ -27,10 +33,7 @@ public:
 
     string(const char* str) 
     {
-        auto mm = memory::getInterface();
-        length = std::strlen(str);
-        data = (char*)mm->allocate(length + 1);
-        strcpy_s(data, length + 1, str);
+        assign(str, std::strlen(str));
     }
 
     ~string() 
@@ -41,13 +44,14 @@ public:
     // Copy constructor
     string(const string& other) 
     {
-        auto mm = memory::getInterface();
-        length = other.length;
-        data = length > 0 ? (char*)mm->allocate(length + 1) : nullptr;
-        if (data)
-        {
-            strcpy_s(data, length + 1, other.data);
-        }
+        assign(other.data, other.length);
+    }
+
+    // Move constructor, no allocations
+    string(string&& other) noexcept : data(other.data), length(other.length)
+    {
+        other.data = nullptr;
+        other.length = 0;
     }
 
     // Copy assignment operator
@@ -55,47 +59,57 @@ public:
     {
         if (this != &other) 
         {
-            auto mm = memory::getInterface();
-            mm->deallocate(data);
-            length = other.length;
-            data = length > 0 ? (char*)mm->allocate(length + 1) : nullptr;
-            if (data)
+            if (data && other.length <= length)
             {
-                strcpy_s(data, length + 1, other.data);
+                // Buffer always holds at least 'length + 1' bytes so shorter strings are copied in place
+                memcpy(data, other.data, other.length);
+                length = other.length;
+                data[length] = 0;
+            }
+            else
+            {
+                memory::getInterface()->deallocate(data);
+                assign(other.data, other.length);
             }
         }
         return *this;
     }
 
+    // Move assignment operator
+    string& operator=(string&& other) noexcept
+    {
+        if (this != &other)
+        {
+            memory::getInterface()->deallocate(data);
+            data = other.data;
+            length = other.length;
+            other.data = nullptr;
+            other.length = 0;
+        }
+        return *this;
+    }
+
     // Concatenation operator
     friend string operator+(const string& a, const string& b) 
     {
-        auto mm = memory::getInterface();
         string result;
-        result.length = a.length + b.length;
-        result.data = (char*)(mm->allocate(result.length + 1));
-        strcpy_s(result.data, result.length + 1, a.data);
-        strcat_s(result.data, result.length + 1, b.data);
+        result.concat(a.data, a.length, b.data, b.length);
         return result;
     }
 
     // Concatenation operator
     string& operator+=(const string& b)
     {
-        auto& a = *this;
-        auto mm = memory::getInterface();
-        a.length = a.length + b.length;
-        auto dataTemp = (char*)(mm->allocate(a.length + 1));
-        strcpy_s(dataTemp, a.length + 1, a.data);
-        strcat_s(dataTemp, a.length + 1, b.data);
-        mm->deallocate(a.data);
-        a.data = dataTemp;
-        return a;
+        if (b.length == 0) return *this;
+        auto previous = data;
+        concat(data, length, b.data, b.length);
+        memory::getInterface()->deallocate(previous);
+        return *this;
     }
 
     bool operator==(const string& other) const
     {
-        return std::strncmp(data, other.data, length) == 0;
+        return length == other.length && (length == 0 || std::memcmp(data, other.data, length) == 0);
     }
 
     // Accessor
@@ -104,6 +118,11 @@ public:
         return data;
     }
 
+    size_t size() const
+    {
+        return length;
+    }
+
     // Other methods like length, append, etc., can be added as needed.
     bool empty() const
     {
@@ -114,14 +133,9 @@ public:
     string substr(size_t start, size_t len = npos) const {
         if (start > length) throw std::out_of_range("start is out of range");
 
-        auto mm = memory::getInterface();
-
-        size_t effectiveLength = start + len > length ? length - start : len;
-        char* subStr = (char*)mm->allocate(effectiveLength + 1);
-        strncpy_s(subStr, effectiveLength + 1, data + start, effectiveLength);
-        subStr[effectiveLength] = '\0';
-        string result(subStr);
-        mm->deallocate(subStr);
+        size_t effectiveLength = len > length - start ? length - start : len;
+        string result;
+        result.assign(data + start, effectiveLength);
         return result;
     }
 
@@ -136,6 +150,26 @@ public:
     static const size_t npos = -1;
 
 private:
+    // One allocation, no zero fill, buffer is always null-terminated
+    void assign(const char* str, size_t len)
+    {
+        length = len;
+        data = (char*)memory::allocateUninitialized(memory::getInterface(), length + 1);
+        if (length) memcpy(data, str, length);
+        data[length] = 0;
+    }
+
+    void concat(const char* a, size_t aLength, const char* b, size_t bLength)
+    {
+        length = aLength + bLength;
+        data = (char*)memory::allocateUninitialized(memory::getInterface(), length + 1);
+        if (aLength) memcpy(data, a, aLength);
+        if (bLength) memcpy(data + aLength, b, bLength);
+        data[length] = 0;
+    }
+
+    // IMPORTANT: Layout and ownership (heap buffer released with 'deallocate') are shared with inline code compiled
+    // into older plugins, an inline small-string buffer would break them so it is deliberately not used here.
     char* data;
     size_t length;
 };
@@ -175,21 +209,14 @@ public:
 
     vector() : data_(nullptr), size_(0), capacity(0) {}
     vector(std::initializer_list<T> initList)
-        : size_(initList.size()), capacity(initList.size())
     {
-        auto mm = memory::getInterface();
-        data_ = (T*)mm->allocate(sizeof(T) * capacity);
-        std::copy(initList.begin(), initList.end(), data_);
+        copyFrom(initList.begin(), initList.size());
     }
 
     // Constructor that takes two pointers as a range
     vector(T* start, T* end) 
     {
-        auto mm = memory::getInterface();
-        size_ = std::distance(start, end);
-        capacity = size_;
-        data_ = (T*)mm->allocate(sizeof(T) * capacity);
-        std::copy(start, end, data_);
+        copyFrom(start, size_t(std::distance(start, end)));
     }
 
     // Constructor that takes two pointers as a range
@@ -211,18 +238,35 @@ public:
         operator=(other);
     }
 
+    // Move constructor, no allocations
+    vector(vector&& other) noexcept : data_(other.data_), size_(other.size_), capacity(other.capacity)
+    {
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.capacity = 0;
+    }
+
     // Copy assignment operator
     vector& operator=(const vector& other) 
     {
         if (this != &other) {
-            auto mm = memory::getInterface();
-            mm->deallocate(data_);
-            data_ = (T*)mm->allocate(sizeof(T) * other.capacity);
+            clear();
+            copyFrom(other.data_, other.size_);
+        }
+        return *this;
+    }
+
+    // Move assignment operator
+    vector& operator=(vector&& other) noexcept
+    {
+        if (this != &other) {
+            clear();
+            data_ = other.data_;
             size_ = other.size_;
             capacity = other.capacity;
-            for (size_t i = 0; i < other.size_; ++i) {
-                data_[i] = other.data_[i];
-            }
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.capacity = 0;
         }
         return *this;
     }
@@ -230,12 +274,35 @@ public:
     // Add an element to the end of the vector
     void push_back(const T& value) {
         if (size_ == capacity) {
-            expand((capacity == 0) ? 1 : 2 * capacity);
+            // 'value' can live in this vector, copy before relocating
+            T tmp(value);
+            expand(grow(size_ + 1));
+            new (data_ + size_) T(std::move(tmp));
+        }
+        else {
+            new (data_ + size_) T(value);
         }
-        data_[size_] = value;
         ++size_;
     }
 
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    // Construct an element in place at the end of the vector
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity) {
+            T tmp(std::forward<Args>(args)...);
+            expand(grow(size_ + 1));
+            new (data_ + size_) T(std::move(tmp));
+        }
+        else {
+            new (data_ + size_) T(std::forward<Args>(args)...);
+        }
+        return data_[size_++];
+    }
+
     // Access elements
     T& operator[](size_t index) {
         if (index >= size_) {
@@ -285,32 +352,30 @@ public:
     T* data() { return data_; }
     const T* data() const { return data_; }
 
+    // New elements are value initialized, existing storage is reused when it fits
     void resize(size_t newSize)
     {
-        auto mm = memory::getInterface();
-        T* newData = (T*)mm->allocate(sizeof(T) * newSize);
-        for (size_t i = 0; i < std::min(newSize,size_); ++i) {
-            newData[i] = data_[i];
+        if (newSize > capacity) {
+            expand(newSize);
+        }
+        for (size_t i = newSize; i < size_; ++i) {
+            data_[i].~T();
+        }
+        if constexpr (!std::is_trivially_copyable_v<T>) {
+            if (newSize < size_) memset((void*)(data_ + newSize), 0, sizeof(T) * (size_ - newSize));
         }
         for (size_t i = size_; i < newSize; ++i) {
-            newData[i] = {};
+            new (data_ + i) T();
         }
-        mm->deallocate(data_);
-        data_ = newData;
-        capacity = newSize;
         size_ = newSize;
     }
 
+    // Never shrinks
     void reserve(size_t newCapacity)
     {
-        auto mm = memory::getInterface();
-        T* newData = (T*)mm->allocate(sizeof(T) * newCapacity);
-        for (size_t i = 0; i < std::min(newCapacity, size_); ++i) {
-            newData[i] = data_[i];
+        if (newCapacity > capacity) {
+            expand(newCapacity);
         }
-        mm->deallocate(data_);
-        data_ = newData;
-        capacity = newCapacity;
     }
 
     inline iterator find(const T& v) const
@@ -329,12 +394,18 @@ public:
 
     inline void clear()
     {
-        for (size_t i = 0; i < size_; i++)
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < size_; i++)
+            {
+                data_[i].~T();
+            }
+        }
+        // Empty vectors can outlive the memory manager (statics in test hosts)
+        if (data_)
         {
-            data_[i].~T();
+            auto mm = memory::getInterface();
+            mm->deallocate(data_);
         }
-        auto mm = memory::getInterface();
-        mm->deallocate(data_);
         data_ = nullptr;
         size_ = 0;
         capacity = 0;
@@ -345,21 +416,54 @@ private:
     size_t size_{};
     size_t capacity{};
 
-    void expand(size_t newCapacity)
+    size_t grow(size_t required) const
+    {
+        return std::max(required, capacity == 0 ? 1 : 2 * capacity);
+    }
+
+    // IMPORTANT: Inline code in older plugins assigns straight into slots past 'size_', for types which are not
+    // trivially copyable those slots must stay zeroed (zero is the empty state of 'string' and friends)
+    static T* allocate(size_t count)
     {
         auto mm = memory::getInterface();
-        T* newData = (T*)mm->allocate(sizeof(T) * newCapacity);
-        for (size_t i = 0; i < size_; ++i) {
-            newData[i] = data_[i];
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            return (T*)memory::allocateUninitialized(mm, sizeof(T) * count);
         }
-        for (size_t i = size_; i < newCapacity; ++i) {
-            newData[i] = {};
+        else {
+            return (T*)mm->allocate(sizeof(T) * count);
         }
-        for (size_t i = 0; i < size_; i++)
-        {
-            data_[i].~T();
+    }
+
+    // Trivially copyable elements are copied with memcpy, no zero fill
+    void copyFrom(const T* src, size_t count)
+    {
+        size_ = count;
+        capacity = count;
+        data_ = count ? allocate(count) : nullptr;
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (count) memcpy(data_, src, sizeof(T) * count);
+        }
+        else {
+            for (size_t i = 0; i < count; ++i) {
+                new (data_ + i) T(src[i]);
+            }
+        }
+    }
+
+    // Elements are relocated with memcpy when trivially copyable, moved otherwise
+    void expand(size_t newCapacity)
+    {
+        T* newData = allocate(newCapacity);
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (size_) memcpy(newData, data_, sizeof(T) * size_);
+        }
+        else {
+            for (size_t i = 0; i < size_; ++i) {
+                new (newData + i) T(std::move(data_[i]));
+                data_[i].~T();
+            }
         }
-        mm->deallocate(data_);
+        memory::getInterface()->deallocate(data_);
         data_ = newData;
         capacity = newCapacity;
     }
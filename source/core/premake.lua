@@ -25,6 +25,14 @@ project "nvigi.core.framework"
 		"./nvigi.memory/**.cpp",
 		"./nvigi.system/**.h",
 		"./nvigi.system/**.cpp",
+		"./nvigi.simd/**.h",
+		"./nvigi.simd/**.cpp",
+		"./nvigi.trace/**.h",
+		"./nvigi.trace/**.cpp",
+		"./nvigi.metrics/**.h",
+		"./nvigi.metrics/**.cpp",
+		"./nvigi.resources/**.h",
+		"./nvigi.resources/**.cpp",
 		"./nvigi.exception/**.h",
 		"./nvigi.exception/**.cpp",		
 		"./nvigi.plugin/**.h",
@@ -39,7 +47,8 @@ project "nvigi.core.framework"
 	filter {"system:windows", "configurations:not Production"}
 		defines { "NVIGI_VALIDATE_MEMORY" }
 	filter {"system:windows", "platforms:x64"}
-		includedirs {ROOT .. "external/nvapi"}
+		-- NVTX is header only, tracing falls back to ETW and Chrome JSON when CUDA is not pulled
+		includedirs {ROOT .. "external/nvapi", externaldir .. "cuda/include"}
 		links {ROOT .. "external/nvapi/amd64/nvapi64.lib", "dxgi.lib", "Version.lib", "dbghelp.lib"}
 		linkoptions { "/DEF:" .. "\"" .. ROOT .. "source/core/nvigi.framework/exports.def\"" }
 	filter {}
@@ -49,6 +58,10 @@ project "nvigi.core.framework"
 		vpaths { ["log"] = {"./nvigi.log/**.h","./nvigi.log/**.cpp"}}
 		vpaths { ["memory"] = {"./nvigi.memory/**.h","./nvigi.memory/**.cpp"}}
 		vpaths { ["system"] = {"./nvigi.system/**.h","./nvigi.system/**.cpp"}}
+		vpaths { ["simd"] = {"./nvigi.simd/**.h","./nvigi.simd/**.cpp"}}
+		vpaths { ["trace"] = {"./nvigi.trace/**.h","./nvigi.trace/**.cpp"}}
+		vpaths { ["metrics"] = {"./nvigi.metrics/**.h","./nvigi.metrics/**.cpp"}}
+		vpaths { ["resources"] = {"./nvigi.resources/**.h","./nvigi.resources/**.cpp"}}
 		vpaths { ["framework"] = {"./nvigi.framework/**.cpp", "./nvigi.framework/framework.h"}}
 		vpaths { ["exception"] = {"./nvigi.exception/**.h","./nvigi.exception/**.cpp"}}			
 		vpaths { ["plugin"] = {"./nvigi.plugin/**.h","./nvigi.plugin/**.cpp"}}			
@@ -17,14 +17,32 @@
 #include <concepts>
 #include <unordered_map>
 #include <chrono>
+#include <cstring>
+#include <algorithm>
+#include <new>
+#include <deque>
+#include <thread>
+#include <memory>
+#include <bit>
+#include <cctype>
 
 #include "source/core/nvigi.api/nvigi.h"
 #include "source/core/nvigi.api/internal.h"
+#include "source/core/nvigi.api/nvigi_d3d12.h"
+#include "source/core/nvigi.api/nvigi_cuda.h"
+#include "source/core/nvigi.api/nvigi_vulkan.h"
 #include "source/core/nvigi.log/log.h"
 #include "source/core/nvigi.exception/exception.h"
+#include "source/core/nvigi.extra/extra.h"
 #include "source/core/nvigi.plugin/plugin.h"
+#include "source/core/nvigi.trace/trace.h"
+#include "source/core/nvigi.metrics/metrics.h"
+#include "source/core/nvigi.thread/thread.h"
+#include "source/core/nvigi.system/system.h"
 #include "source/utils/nvigi.poll/poll.h"
 #include "source/utils/nvigi.ai/ai.h"
+#include "source/utils/nvigi.ai/ai_capture.h"
+#include "source/utils/nvigi.ai/ai_tuning.h"
 #include "external/json/source/nlohmann/json.hpp"
 
 using json = nlohmann::json;
@@ -76,6 +94,438 @@ using Expected = std::expected<T, Error>;
         return std::span(descriptors); \
     }()
 
+// ============================================================================
+// Evaluation Arena - Scoped Bump Allocator for Per-Evaluation Outputs
+// ============================================================================
+
+// Memory handed out is valid until reset(), which happens after each callback
+// (or once host calls releaseResults() in polled mode). If a cycle did not fit
+// into the current block, blocks are merged on reset so steady state streaming
+// does not touch the heap at all.
+//
+// Only trivially destructible data (NVIGI structs, text) is placed here, nothing
+// is ever destructed. Not thread safe, owned by a single instance.
+class EvaluationArena {
+public:
+    EvaluationArena() = default;
+    EvaluationArena(const EvaluationArena&) = delete;
+    EvaluationArena& operator=(const EvaluationArena&) = delete;
+    ~EvaluationArena() {
+        for (auto& block : m_blocks) ::operator delete(block.data);
+    }
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        if (!m_blocks.empty()) {
+            auto& block = m_blocks.back();
+            auto offset = (block.used + alignment - 1) & ~(alignment - 1);
+            if (offset + bytes <= block.size) {
+                block.used = offset + bytes;
+                return block.data + offset;
+            }
+        }
+        // Does not fit, grab a new block at least twice the size of the previous one
+        size_t size = std::max<size_t>(bytes + alignment, m_blocks.empty() ? kMinBlockSize : m_blocks.back().size * 2);
+        m_blocks.push_back({ static_cast<uint8_t*>(::operator new(size)), size, 0 });
+        return allocate(bytes, alignment);
+    }
+
+    template<typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena never runs destructors");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    T* createArray(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena never runs destructors");
+        auto items = static_cast<T*>(allocate(sizeof(T) * std::max<size_t>(count, 1), alignof(T)));
+        for (size_t i = 0; i < count; i++) new (items + i) T();
+        return items;
+    }
+
+    // Null terminated copy
+    const char* copyString(std::string_view str) {
+        auto text = static_cast<char*>(allocate(str.size() + 1, 1));
+        memcpy(text, str.data(), str.size());
+        text[str.size()] = 0;
+        return text;
+    }
+
+    void reset() {
+        if (m_blocks.size() > 1) {
+            // Multiple blocks were needed, replace them with one which fits everything next time
+            size_t total = 0;
+            for (auto& block : m_blocks) {
+                total += block.size;
+                ::operator delete(block.data);
+            }
+            m_blocks.clear();
+            m_blocks.push_back({ static_cast<uint8_t*>(::operator new(total)), total, 0 });
+        }
+        else if (!m_blocks.empty()) {
+            m_blocks.back().used = 0;
+        }
+    }
+
+    size_t capacity() const {
+        size_t total = 0;
+        for (auto& block : m_blocks) total += block.size;
+        return total;
+    }
+
+private:
+    static constexpr size_t kMinBlockSize = 4096;
+
+    struct Block {
+        uint8_t* data;
+        size_t size;
+        size_t used;
+    };
+    std::vector<Block> m_blocks;
+};
+
+// ============================================================================
+// Executor Results - Outputs Handed Over To A Host Executor
+// ============================================================================
+
+// Results posted to 'InferenceCallbackExecutor', each entry owns the arena backing its outputs until
+// the host's callback returns. Entries are reused in order so steady state does not touch the heap.
+//
+// Thread safe, owned by a single instance.
+class ExecutorResultRing {
+public:
+    struct Entry {
+        EvaluationArena arena;
+        InferenceExecutionContext execCtx{};
+        InferenceExecutionState state = kInferenceExecutionStateDone;
+        ExecutorResultRing* ring{};
+        bool busy = false;
+    };
+
+    // Resizing waits until nothing is in flight, host normally keeps the same depth
+    void resize(uint32_t depth) {
+        depth = std::max(depth, 1u);
+        std::unique_lock lock(m_mtx);
+        if (depth == m_depth) return;
+        m_cv.wait(lock, [this]() { return m_inFlight == 0; });
+        m_entries = std::make_unique<Entry[]>(depth);
+        for (uint32_t i = 0; i < depth; i++) m_entries[i].ring = this;
+        m_depth = depth;
+        m_next = 0;
+    }
+
+    // Blocks while all entries are in flight
+    Entry& acquire() {
+        std::unique_lock lock(m_mtx);
+        m_cv.wait(lock, [this]() { return m_inFlight < m_depth; });
+        while (m_entries[m_next].busy) m_next = (m_next + 1) % m_depth;
+        auto& entry = m_entries[m_next];
+        m_next = (m_next + 1) % m_depth;
+        entry.busy = true;
+        m_inFlight++;
+        entry.arena.reset();
+        return entry;
+    }
+
+    // Notifies under the lock, 'waitIdle' returning lets the owner destroy the ring right away
+    void release(Entry& entry) {
+        std::scoped_lock lock(m_mtx);
+        entry.busy = false;
+        m_inFlight--;
+        m_cv.notify_all();
+    }
+
+    // Everything posted so far was executed by the host
+    void waitIdle() {
+        std::unique_lock lock(m_mtx);
+        m_cv.wait(lock, [this]() { return m_inFlight == 0; });
+    }
+
+    // Task posted to the host's executor
+    static void execute(void* data) {
+        auto entry = static_cast<Entry*>(data);
+        entry->execCtx.callback(&entry->execCtx, entry->state, entry->execCtx.callbackUserData);
+        entry->ring->release(*entry);
+    }
+
+private:
+    std::mutex m_mtx;
+    std::condition_variable m_cv;
+    std::unique_ptr<Entry[]> m_entries;
+    uint32_t m_depth = 0;
+    uint32_t m_next = 0;
+    uint32_t m_inFlight = 0;
+};
+
+// ============================================================================
+// Device Buffer Pool - Recycles GPU Allocations Between Evaluations
+// ============================================================================
+
+// Backend agnostic, plugin provides allocate/free for its API (cuMemAlloc, D3D12 committed
+// resource, VkBuffer + memory etc.). Sizes are rounded up to power of two buckets and released
+// buffers are kept for reuse, so steady state streaming does not allocate device memory.
+//
+// Thread safe, typically owned by the plugin instance. Buffers must only be released once
+// the GPU is done with them (e.g. after waiting on the fence/semaphore/stream of the slot).
+template<typename Handle>
+class DeviceBufferPool {
+public:
+    using AllocateFn = std::function<Handle(size_t bytes)>;
+    using FreeFn = std::function<void(Handle handle)>;
+
+    struct Buffer {
+        Handle handle{};
+        size_t capacity{};
+        explicit operator bool() const { return capacity != 0; }
+    };
+
+    DeviceBufferPool(AllocateFn allocate, FreeFn free, size_t maxCachedBytes = SIZE_MAX)
+        : m_allocateFn(std::move(allocate)), m_freeFn(std::move(free)), m_maxCachedBytes(maxCachedBytes) {}
+    DeviceBufferPool(const DeviceBufferPool&) = delete;
+    DeviceBufferPool& operator=(const DeviceBufferPool&) = delete;
+    ~DeviceBufferPool() { trim(); }
+
+    // Returns empty buffer if allocation failed
+    Buffer acquire(size_t bytes) {
+        size_t capacity = std::bit_ceil(std::max<size_t>(bytes, kMinBufferSize));
+        {
+            std::scoped_lock lock(m_mtx);
+            auto it = std::find_if(m_cached.begin(), m_cached.end(), [capacity](const Buffer& b) { return b.capacity == capacity; });
+            if (it != m_cached.end()) {
+                auto buffer = *it;
+                *it = m_cached.back();
+                m_cached.pop_back();
+                m_cachedBytes -= capacity;
+                return buffer;
+            }
+        }
+        Handle handle = m_allocateFn(capacity);
+        if (!handle) return {};
+        return { handle, capacity };
+    }
+
+    void release(const Buffer& buffer) {
+        if (!buffer) return;
+        {
+            std::scoped_lock lock(m_mtx);
+            if (m_cachedBytes + buffer.capacity <= m_maxCachedBytes) {
+                m_cached.push_back(buffer);
+                m_cachedBytes += buffer.capacity;
+                return;
+            }
+        }
+        m_freeFn(buffer.handle);
+    }
+
+    // Frees all cached buffers (e.g. when under VRAM pressure)
+    void trim() {
+        std::vector<Buffer> buffers;
+        {
+            std::scoped_lock lock(m_mtx);
+            buffers.swap(m_cached);
+            m_cachedBytes = 0;
+        }
+        for (auto& buffer : buffers) m_freeFn(buffer.handle);
+    }
+
+    size_t getCachedBytes() {
+        std::scoped_lock lock(m_mtx);
+        return m_cachedBytes;
+    }
+
+private:
+    static constexpr size_t kMinBufferSize = 256;
+
+    AllocateFn m_allocateFn;
+    FreeFn m_freeFn;
+    std::mutex m_mtx;
+    std::vector<Buffer> m_cached;
+    size_t m_cachedBytes = 0;
+    size_t m_maxCachedBytes;
+};
+
+// ============================================================================
+// Slot Index - O(1) Slot Lookup Against a Signature
+// ============================================================================
+
+// Keys of a signature are interned once, slot arrays are then bound against it once per
+// evaluation (or not at all when host reuses the same array) so each lookup becomes a hash
+// of the requested key plus array indexing instead of strcmp over every slot.
+class SlotSignatureIndex {
+public:
+    explicit SlotSignatureIndex(std::span<const InferenceDataDescriptor> signature) {
+        m_keys.reserve(signature.size());
+        for (size_t i = 0; i < signature.size(); i++) {
+            m_keys.push_back(signature[i].key);
+            m_positions.emplace(signature[i].key, uint32_t(i));
+        }
+    }
+
+    std::optional<uint32_t> find(std::string_view key) const {
+        auto it = m_positions.find(key);
+        if (it == m_positions.end()) return std::nullopt;
+        return it->second;
+    }
+
+    const char* getKey(size_t position) const { return position < m_keys.size() ? m_keys[position] : nullptr; }
+    size_t size() const { return m_keys.size(); }
+
+private:
+    std::vector<const char*> m_keys;
+    std::unordered_map<std::string_view, uint32_t> m_positions;
+};
+
+// Signature position -> slot for one slot array
+class SlotBinding {
+public:
+    void bind(const SlotSignatureIndex& index, const InferenceDataSlotArray* slots) {
+        if (isBound(index, slots)) return;
+
+        m_index = &index;
+        m_array = slots;
+        m_items = slots ? slots->items : nullptr;
+        m_keys.clear();
+        m_slots.assign(index.size(), nullptr);
+        if (!slots) return;
+        for (size_t i = 0; i < slots->count; i++) {
+            auto& slot = slots->items[i];
+            m_keys.push_back(slot.key);
+            if (!slot.key) continue;
+            if (auto position = index.find(slot.key); position && !m_slots[*position]) {
+                m_slots[*position] = &slot;
+            }
+        }
+    }
+
+    const InferenceDataSlot* get(size_t position) const {
+        return position < m_slots.size() ? m_slots[position] : nullptr;
+    }
+
+    template<typename T>
+    const T* get(size_t position) const {
+        auto slot = get(position);
+        if (!slot || !slot->data || static_cast<const BaseStructure*>(slot->data)->type != T::s_type) return nullptr;
+        return reinterpret_cast<const T*>(slot->data);
+    }
+
+private:
+    // Same array with the same key pointers, no need to hash anything again
+    bool isBound(const SlotSignatureIndex& index, const InferenceDataSlotArray* slots) const {
+        if (m_index != &index || m_array != slots || !slots || m_items != slots->items || m_keys.size() != slots->count) return false;
+        for (size_t i = 0; i < slots->count; i++) {
+            if (m_keys[i] != slots->items[i].key) return false;
+        }
+        return true;
+    }
+
+    const SlotSignatureIndex* m_index{};
+    const InferenceDataSlotArray* m_array{};
+    const InferenceDataSlot* m_items{};
+    std::vector<const char*> m_keys;
+    std::vector<const InferenceDataSlot*> m_slots;
+};
+
+// ============================================================================
+// Struct Chain Index - Bounded Lookup of Chained Parameters
+// ============================================================================
+
+// Parameter chain is walked once and (UID, struct) pairs are kept in a flat array, so typed
+// lookups never chase 'next' pointers again and cost at most kMaxNumChainedStructs compares
+// of the first UID dword. First struct of a given type wins, same as 'findStruct'.
+class StructChainIndex {
+public:
+    // Returns false if the chain contains the same struct type more than once (or is too long), see 'logProblems'
+    bool build(const BaseStructure* head) {
+        m_head = head;
+        m_count = 0;
+        m_duplicate = nullptr;
+        m_duplicateCount = 0;
+        m_truncated = false;
+        for (auto base = head; base; base = static_cast<const BaseStructure*>(base->next)) {
+            if (m_count == kMaxNumChainedStructs) {
+                m_truncated = true;
+                break;
+            }
+            if (findEntry(base->type)) {
+                if (!m_duplicate) m_duplicate = base;
+                m_duplicateCount++;
+                continue;
+            }
+            m_entries[m_count++] = { base->type, base };
+        }
+        return !m_duplicate && !m_truncated;
+    }
+
+    void logProblems(const char* chainName) const {
+        if (m_duplicate) {
+            NVIGI_LOG_WARN("%s chain contains struct '%s' more than once, only the first one is used", chainName, extra::guidToString(m_duplicate->type).c_str());
+        }
+        if (m_truncated) {
+            NVIGI_LOG_WARN("%s chain is longer than %u structs, remaining structs are ignored", chainName, kMaxNumChainedStructs);
+        }
+    }
+
+    // True if the only problem is a single shadowed struct of this type
+    bool hasOnlyDuplicateOf(const UID& type) const { return !m_truncated && m_duplicateCount == 1 && m_duplicate->type == type; }
+
+    bool isBuiltFor(const BaseStructure* head) const { return m_head == head && (head || m_count == 0); }
+    size_t size() const { return m_count; }
+
+    template<typename T>
+    const T* find() const {
+        return reinterpret_cast<const T*>(findEntry(T::s_type));
+    }
+
+private:
+    struct Entry {
+        UID type;
+        const BaseStructure* base;
+    };
+
+    const BaseStructure* findEntry(const UID& type) const {
+        for (size_t i = 0; i < m_count; i++) {
+            if (m_entries[i].type.data1 == type.data1 && m_entries[i].type == type) return m_entries[i].base;
+        }
+        return nullptr;
+    }
+
+    const BaseStructure* m_head{};
+    const BaseStructure* m_duplicate{};
+    size_t m_duplicateCount{};
+    bool m_truncated = false;
+    size_t m_count{};
+    Entry m_entries[kMaxNumChainedStructs]{};
+};
+
+// ============================================================================
+// Evaluation Metrics
+// ============================================================================
+
+// Plugin wide latency histograms from the core registry (see 'IMetrics'), all null on older cores
+struct EvaluationMetrics {
+    metrics::LatencyHistogram* queueWait{};
+    metrics::LatencyHistogram* evaluate{};
+    metrics::LatencyHistogram* firstResult{};
+    metrics::LatencyHistogram* betweenResults{};
+    metrics::LatencyHistogram* callback{};
+    metrics::LatencyHistogram* cancelToIdle{};
+
+    void init(const PluginID& feature) {
+        queueWait = metrics::getHistogram(feature, "queue_wait_us");
+        evaluate = metrics::getHistogram(feature, "evaluate_us");
+        firstResult = metrics::getHistogram(feature, "time_to_first_result_us");
+        betweenResults = metrics::getHistogram(feature, "time_between_results_us");
+        callback = metrics::getHistogram(feature, "callback_us");
+        cancelToIdle = metrics::getHistogram(feature, "cancel_to_idle_us");
+    }
+
+    static void record(metrics::LatencyHistogram* histogram, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+        if (histogram) {
+            histogram->record(uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()));
+        }
+    }
+};
+
 // ============================================================================
 // Plugin Context - Ergonomic API for Plugin Authors
 // ============================================================================
@@ -86,15 +536,34 @@ public:
     PluginContext(InferenceExecutionContext* execCtx,
         const NVIGIParameter* creationParams,
         std::any& pluginDataParam,
-        poll::PollContext<InferenceExecutionState>* pollCtxPtr = nullptr)
+        poll::PollContext<InferenceExecutionState>* pollCtxPtr = nullptr,
+        EvaluationArena* arena = nullptr)
         : m_execCtx(execCtx)
         , m_creationParams(creationParams)
         , pluginData(pluginDataParam)      // Initialize public reference directly from parameter
         , m_pluginData(pluginDataParam)    // Initialize private reference from same parameter
         , m_pollCtx(pollCtxPtr)
+        , m_arena(arena ? arena : &m_localArena)
     {
         NVIGI_LOG_INFO("PluginContext constructor: pluginData param address=%p, public ref address=%p, private ref address=%p",
                       &pluginDataParam, &pluginData, &m_pluginData);
+        // One pass over the runtime chain, all 'getRuntimeParam' calls for this evaluation use the index
+        if (!m_runtimeIndex.build(m_execCtx ? m_execCtx->runtimeParameters : nullptr)) {
+            // Host likely repeats the same chain every evaluation, report it once
+            static std::atomic<bool> s_reported{};
+            if (!s_reported.exchange(true)) {
+                m_runtimeIndex.logProblems("Runtime parameter");
+            }
+        }
+        m_textStreaming = m_runtimeIndex.find<TextStreamingParameters>();
+        m_lastTextDelivery = std::chrono::steady_clock::now();
+    }
+
+    // Creation parameters indexed once per instance, must be built for the same chain this context was given
+    void setCreationIndex(const StructChainIndex* index) {
+        if (index && index->isBuiltFor(m_creationParams)) {
+            m_creationIndex = index;
+        }
     }
 
     // ========================================================================
@@ -103,7 +572,11 @@ public:
 
     template<typename T>
     std::optional<const T*> getCreationParam() const {
-        if (auto param = findStruct<T>(m_creationParams)) {
+        if (!m_creationIndex && !m_localCreationIndex.isBuiltFor(m_creationParams)) {
+            m_localCreationIndex.build(m_creationParams);
+        }
+        auto& index = m_creationIndex ? *m_creationIndex : m_localCreationIndex;
+        if (auto param = index.find<T>()) {
             return param;
         }
         return std::nullopt;
@@ -115,14 +588,24 @@ public:
 
     template<typename T>
     std::optional<const T*> getRuntimeParam() const {
-        if (m_execCtx && m_execCtx->runtimeParameters) {
-            if (auto param = findStruct<T>(m_execCtx->runtimeParameters)) {
-                return param;
-            }
+        if (auto param = m_runtimeIndex.find<T>()) {
+            return param;
         }
         return std::nullopt;
     }
 
+    // Model's preprocessing with the host's crop rectangle (if any) applied, feed to 'd3d12::ImagePreprocessor'
+    ImagePreprocessParameters getImagePreprocessParameters(const ImagePreprocessParameters& modelDefaults) const {
+        auto desc = modelDefaults;
+        if (auto host = m_runtimeIndex.find<ImagePreprocessParameters>()) {
+            desc.cropX = host->cropX;
+            desc.cropY = host->cropY;
+            desc.cropWidth = host->cropWidth;
+            desc.cropHeight = host->cropHeight;
+        }
+        return desc;
+    }
+
     // ========================================================================
     // Get Inputs (Type-Safe and Ergonomic)
     // ========================================================================
@@ -136,7 +619,7 @@ public:
 
         if constexpr (std::is_same_v<T, std::string>) {
             const InferenceDataText* data{};
-            if (!m_execCtx->inputs->findAndValidateSlot(name.data(), &data)) {
+            if (!findInputSlot(name, &data)) {
                 return std::unexpected(Error{
                     kResultInvalidParameter,
                     std::string("Missing required input: ") + std::string(name)
@@ -186,6 +669,25 @@ public:
         }
     }
 
+    // Input slot by position in the plugin's input signature, plain array indexing after binding
+    template<typename T>
+    const T* getInputSlot(size_t signaturePosition) const {
+        if (!m_execCtx || !m_execCtx->inputs) return nullptr;
+        if (m_inputIndex) {
+            return m_inputBinding->get<T>(signaturePosition);
+        }
+        return nullptr;
+    }
+
+    // Binds inputs once so all lookups below are O(1), ad-hoc keys not in the signature fall back to a linear search
+    void setInputIndex(const SlotSignatureIndex* index, SlotBinding* binding = nullptr) {
+        m_inputIndex = index;
+        m_inputBinding = binding ? binding : &m_localBinding;
+        if (m_inputIndex) {
+            m_inputBinding->bind(*m_inputIndex, m_execCtx ? m_execCtx->inputs : nullptr);
+        }
+    }
+
     // Optional input - returns nullopt if missing
     template<typename T>
     std::optional<T> getOptionalInput(std::string_view name) const {
@@ -200,17 +702,230 @@ public:
     // Set Outputs (Type-Safe and Ergonomic)
     // ========================================================================
 
+    // Outputs are copied into the evaluation arena and stay valid until the callback
+    // returns (or host releases polled results)
     template<typename T>
     Expected<void> setOutput(std::string_view name, const T& value) {
         if (!m_execCtx) {
             return std::unexpected(Error{ kResultInvalidParameter, "No execution context" });
         }
 
-        // Store output for later
-        m_pendingOutputs[std::string(name)] = value;
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            std::string_view text(value);
+            // Store output for later, setting the same slot again overrides previous value
+            for (auto& output : m_pendingOutputs) {
+                if (name == output.name) {
+                    output.text = arena().copyString(text);
+                    output.length = text.size();
+                    output.device = nullptr;
+                    return {};
+                }
+            }
+            m_pendingOutputs.push_back({ arena().copyString(name), arena().copyString(text), text.size(), nullptr });
+            return {};
+        }
+        else {
+            static_assert(always_false<T>, "Unsupported output type");
+        }
+    }
+
+    // ========================================================================
+    // Streaming Text (Coalesced)
+    // ========================================================================
+
+    // Appends generated text (typically one token) to the evaluation's text stream
+    //
+    // Unless host chained 'TextStreamingParameters' every call is delivered right away, same as setOutput() + flushOutputs().
+    // Otherwise text accumulates in one growable buffer and only the new part is delivered once host's thresholds are
+    // reached, the remainder is delivered automatically when onEvaluate() returns.
+    Expected<void> appendText(std::string_view name, std::string_view text, uint32_t tokens = 1) {
+        if (!m_textStreaming) {
+            if (auto result = setOutput(name, text); !result) return result;
+            return flushOutputs();
+        }
+        if (m_textStreamName != name) {
+            // Switching slots, previous slot's text goes out first
+            if (auto result = flushText(); !result) return result;
+            m_textStreamName = name;
+        }
+        m_textStream->append(text);
+        m_textPendingTokens += tokens;
+        bool tokensDue = m_textStreaming->maxTokens && m_textPendingTokens >= m_textStreaming->maxTokens;
+        bool timeDue = m_textStreaming->maxIntervalMs && std::chrono::steady_clock::now() - m_lastTextDelivery >= std::chrono::milliseconds(m_textStreaming->maxIntervalMs);
+        bool everyToken = !m_textStreaming->maxTokens && !m_textStreaming->maxIntervalMs;
+        if (tokensDue || timeDue || everyToken) {
+            return flushText();
+        }
+        return {};
+    }
+
+    // Delivers text appended since the previous result, nop if there is none
+    Expected<void> flushText() {
+        if (!m_textStreaming || m_textDelivered == m_textStream->size()) {
+            return {};
+        }
+        std::string_view delta(m_textStream->data() + m_textDelivered, m_textStream->size() - m_textDelivered);
+        if (m_textStreaming->useTextView && m_execCtx && (m_ringArenas || !m_execCtx->outputs)) {
+            // Results which outlive the next append (result ring, host executor) get their own copy, otherwise host
+            // reads our buffer directly since it cannot grow before the callback returns or the result is released
+            bool outlivesAppend = m_ringArenas || m_executorRing;
+            auto view = arena().create<InferenceDataTextView>();
+            view->utf8Text = outlivesAppend ? arena().copyString(delta) : delta.data();
+            view->length = delta.size();
+            view->streamOffset = m_textDelivered;
+            view->tokenCount = m_textPendingTokens;
+            m_pendingOutputs.push_back({ arena().copyString(m_textStreamName), nullptr, 0, nullptr, nullptr, *view });
+        }
+        else if (auto result = setOutput(m_textStreamName, delta); !result) {
+            return result;
+        }
+        m_textDelivered = m_textStream->size();
+        m_textPendingTokens = 0;
+        m_lastTextDelivery = std::chrono::steady_clock::now();
+        return flushOutputs();
+    }
+
+    // Instance owned buffer so its capacity carries over between evaluations
+    void setTextStream(std::string* buffer) {
+        m_textStream = buffer;
+        m_textStream->clear();
+    }
+
+    // ========================================================================
+    // GPU Resident Data (Zero-Copy)
+    // ========================================================================
+
+    // T is one of CudaData, D3D12Data or VulkanData. Returned struct carries the buffer and the
+    // optional stream/fence/semaphore the plugin must wait on (on the GPU) before reading it.
+    template<typename T>
+    Expected<const T*> getDeviceInput(std::string_view name) const {
+        if (!m_execCtx || !m_execCtx->inputs) {
+            return std::unexpected(Error{ kResultInvalidParameter, "No inputs provided" });
+        }
+        auto data = castTo<T>(findSlotPayload(m_execCtx->inputs, name));
+        if (!data) {
+            return std::unexpected(Error{
+                kResultInvalidParameter,
+                std::string("Missing GPU resident input: ") + std::string(name)
+                });
+        }
+        return data;
+    }
+
+    // Host provided GPU resident output (if any), plugin writes into it directly and sets the
+    // stream/fence/semaphore the host should wait on before building the output
+    template<typename T>
+    std::optional<T*> getDeviceOutput(std::string_view name) const {
+        if (m_execCtx && m_execCtx->outputs) {
+            if (auto data = castTo<T>(const_cast<NVIGIParameter*>(findSlotPayload(m_execCtx->outputs, name)))) {
+                return data;
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Publishes plugin owned GPU resident output (e.g. from DeviceBufferPool) as InferenceDataByteArray,
+    // handle is copied into the arena so it stays valid until the callback returns (or results are released)
+    template<typename T>
+    Expected<void> setDeviceOutput(std::string_view name, const T& data) {
+        if (!m_execCtx) {
+            return std::unexpected(Error{ kResultInvalidParameter, "No execution context" });
+        }
+        if (getDeviceOutput<T>(name)) {
+            return std::unexpected(Error{ kResultInvalidParameter, "Host provided output '" + std::string(name) + "', use getDeviceOutput() to write into it" });
+        }
+        auto device = arena().create<T>(data);
+        for (auto& output : m_pendingOutputs) {
+            if (name == output.name) {
+                output.device = *device;
+                return {};
+            }
+        }
+        m_pendingOutputs.push_back({ arena().copyString(name), nullptr, 0, *device });
         return {};
     }
 
+    // ========================================================================
+    // Persistent State (prompt/KV cache snapshots)
+    // ========================================================================
+
+    struct StateView {
+        const InferenceDataState* state;
+        // CPU resident payload, null if the blob lives on the GPU (cast 'state->blob' to CudaData/D3D12Data instead)
+        const void* payload;
+        size_t payloadSize;
+        uint64_t tokenCount;
+    };
+
+    // Host provided 'kInferenceDataSlotStateIn' if it matches format, version and model, otherwise nullopt
+    // and the plugin processes the full input as if no state was provided
+    std::optional<StateView> getInputState(const UID& format, uint32_t formatVersion, uint64_t modelHash) const {
+        if (!m_execCtx || !m_execCtx->inputs) {
+            return std::nullopt;
+        }
+        const InferenceDataState* state{};
+        if (!m_execCtx->inputs->findAndValidateSlot(kInferenceDataSlotStateIn, &state)) {
+            return std::nullopt;
+        }
+        StateView view{ state, nullptr, 0, state->tokenCount };
+        auto header = state->getHeader();
+        if (header) {
+            if (header->format != format || header->formatVersion != formatVersion || header->modelHash != modelHash) {
+                NVIGI_LOG_WARN("Ignoring '%s', state was produced by a different model or format", kInferenceDataSlotStateIn);
+                return std::nullopt;
+            }
+            view.payload = static_cast<const uint8_t*>(castTo<CpuData>(state->blob)->buffer) + header->headerSize;
+            view.payloadSize = header->payloadSize;
+            view.tokenCount = header->tokenCount;
+            return view;
+        }
+        if (castTo<CpuData>(state->blob)) {
+            NVIGI_LOG_WARN("Ignoring '%s', invalid state header", kInferenceDataSlotStateIn);
+            return std::nullopt;
+        }
+        if (state->format != format || state->formatVersion != formatVersion || state->modelHash != modelHash) {
+            NVIGI_LOG_WARN("Ignoring '%s', state was produced by a different model or format", kInferenceDataSlotStateIn);
+            return std::nullopt;
+        }
+        return view;
+    }
+
+    // Exports CPU resident state as 'kInferenceDataSlotStateOut', header and payload are copied into a single blob
+    // which the host can write to disk as is
+    Expected<void> setOutputState(const UID& format, uint32_t formatVersion, uint64_t modelHash, uint64_t tokenCount, const void* payload, size_t payloadSize) {
+        if (!m_execCtx) {
+            return std::unexpected(Error{ kResultInvalidParameter, "No execution context" });
+        }
+        auto size = sizeof(InferenceStateHeader) + payloadSize;
+        auto blob = static_cast<uint8_t*>(arena().allocate(size, alignof(InferenceStateHeader)));
+        auto header = new (blob) InferenceStateHeader();
+        header->format = format;
+        header->formatVersion = formatVersion;
+        header->modelHash = modelHash;
+        header->tokenCount = tokenCount;
+        header->payloadSize = payloadSize;
+        if (payloadSize) {
+            memcpy(blob + sizeof(InferenceStateHeader), payload, payloadSize);
+        }
+        auto buffer = arena().create<CpuData>(size, (const void*)blob);
+        return setStateOutput(*buffer, format, formatVersion, modelHash, tokenCount);
+    }
+
+    // Exports GPU resident state (T is CudaData or D3D12Data), handle is copied into the arena
+    template<typename T>
+    Expected<void> setDeviceOutputState(const UID& format, uint32_t formatVersion, uint64_t modelHash, uint64_t tokenCount, const T& data) {
+        if (!m_execCtx) {
+            return std::unexpected(Error{ kResultInvalidParameter, "No execution context" });
+        }
+        auto device = arena().create<T>(data);
+        return setStateOutput(*device, format, formatVersion, modelHash, tokenCount);
+    }
+
+    // Memory valid for the current evaluation cycle, use for any custom output data
+    EvaluationArena& getArena() {
+        return arena();
+    }
+
     // ========================================================================
     // Fluent Output Builder
     // ========================================================================
@@ -278,72 +993,347 @@ public:
 
     // Check if cancellation was requested
     // Plugins should call this periodically during long-running operations
-    // to allow early termination
+    // to allow early termination, it is a single relaxed load so calling it per token is fine
     bool isCancelled() const {
-        return m_cancelled && m_cancelled->load();
+        return m_cancelled && m_cancelled->load(std::memory_order_relaxed);
+    }
+
+    // Cancellation point, propagate with 'if (auto r = ctx.checkCancelled(); !r) return r;'
+    //
+    // kResultCanceled is treated as a clean exit by the base, nothing is logged as an error
+    Expected<void> checkCancelled() const {
+        if (isCancelled()) {
+            return std::unexpected(Error{kResultCanceled, "Evaluation cancelled"});
+        }
+        return {};
+    }
+
+    // Same flag for code which has no PluginContext, e.g. 'net::Parameters::cancelCallback' and 'cancelUserData'
+    // so blocking transfers are aborted as well. Valid for the duration of the evaluation.
+    struct CancellationToken {
+        bool(*isCancelled)(void* userData) = nullptr;
+        void* userData = nullptr;
+    };
+
+    CancellationToken getCancellationToken() const {
+        if (!m_cancelled) return {};
+        return { [](void* userData)->bool { return static_cast<std::atomic<bool>*>(userData)->load(std::memory_order_relaxed); }, m_cancelled };
     }
 
     void setCancelledFlag(std::atomic<bool>* flag) {
         m_cancelled = flag;
     }
 
-    // Get execution context (for advanced usage)
-    InferenceExecutionContext* getExecutionContext() const {
-        return m_execCtx;
-    }
+    // ========================================================================
+    // Priority (see 'CommonCreationParameters::priorityClass')
+    // ========================================================================
 
-private:
-    template<typename T>
-    static constexpr bool always_false = false;
+    InferencePriorityClass getPriorityClass() const {
+        return m_priorityClass;
+    }
 
-    Expected<void> flushOutputs() {
-        if (!m_execCtx) {
-            return std::unexpected(Error{kResultInvalidParameter, "No execution context"});
+    // Yield point for long evaluations, call between work items (e.g. per token), cheap when nothing of higher priority runs
+    //
+    // Blocks for at most 'timeoutMs' while an evaluation of a higher priority class is running in any plugin
+    void yieldToHigherPriority(uint32_t timeoutMs = 100) const {
+        if (m_arbiter && m_priorityClass != InferencePriorityClass::eRealtime) {
+            m_arbiter->yield((uint32_t)m_priorityClass, timeoutMs);
         }
+    }
 
-        // Create temporary output slots if host didn't provide them
-        std::vector<InferenceDataSlot> tempSlots;
-        std::vector<CpuData> tempBuffers;  // Keep alive for callback duration
-        std::vector< InferenceDataText> tempTextData;  // Keep alive for callback duration
-        InferenceDataSlotArray tempOutputs{};
-        InferenceDataSlotArray* originalOutputs = m_execCtx->outputs;
-        
+    // ========================================================================
+    // Time slicing (see 'EvaluationBudgetParameters')
+    // ========================================================================
+
+    // Safe point for time sliced evaluations, call after each work item (e.g. per layer group or per token)
+    //
+    // Returns true once the host's budget for this call is used up. Plugin must then keep whatever it needs to continue
+    // in 'getResumeState()' and return success, the base reports 'kInferenceExecutionStateSuspended' and the next 'evaluate'
+    // with the same execution context calls onEvaluate() again with 'isResuming()' set. Always false unless slicing is active.
+    bool shouldSuspend() {
+        if (!m_budget || m_suspended) return m_suspended;
+        m_workItems++;
+        bool itemsDue = m_budget->maxWorkItems && m_workItems >= m_budget->maxWorkItems;
+        bool timeDue = m_budget->timeBudgetUs && std::chrono::steady_clock::now() - m_sliceStart >= std::chrono::microseconds(m_budget->timeBudgetUs);
+        m_suspended = itemsDue || timeDue;
+        return m_suspended;
+    }
+
+    // True if this call continues a suspended evaluation, 'getResumeState()' holds what the previous call left there
+    bool isResuming() const {
+        return m_resuming;
+    }
+
+    bool isSuspended() const {
+        return m_suspended;
+    }
+
+    // Kept across the calls of one time sliced evaluation, reset once it finishes or is abandoned
+    std::any& getResumeState() {
+        return m_resumeState ? *m_resumeState : m_localResumeState;
+    }
+
+    void setTimeSlice(std::any* resumeState, bool resuming) {
+        m_budget = m_runtimeIndex.find<EvaluationBudgetParameters>();
+        m_resumeState = resumeState;
+        m_resuming = resuming;
+        m_sliceStart = std::chrono::steady_clock::now();
+    }
+
+    // Threads and affinity backends should use for their own CPU workers, see 'CpuThreadBudget'
+    const system::CpuThreadAssignment& getCpuThreadAssignment() const {
+        return m_cpuThreads ? *m_cpuThreads : s_defaultCpuThreads;
+    }
+
+    void setCpuThreadAssignment(const system::CpuThreadAssignment* assignment) {
+        m_cpuThreads = assignment;
+    }
+
+    // Flags for jobs this evaluation puts on the shared 'IWorkerPool'
+    thread::WorkerPoolFlags getWorkerPoolFlags() const {
+        return m_priorityClass == InferencePriorityClass::eRealtime ? thread::kWorkerPoolFlagHighPriority : thread::kWorkerPoolFlagNone;
+    }
+
+#if GGML_USE_CUBLAS
+    // Class for streams acquired via 'IHWICuda::cudaAcquireStream', background work never gets the highest stream priority
+    uint32_t getCudaStreamClass() const {
+        return m_priorityClass == InferencePriorityClass::eBackground ? CudaStreamClass::kBackground : CudaStreamClass::kForeground;
+    }
+#elif defined(GGML_USE_D3D12)
+    // Class for queues acquired via 'IHWID3D12::d3d12AcquireComputeQueue' (see 'd3d12::ComputeQueue'), same split as CUDA streams
+    uint32_t getD3D12QueueClass() const {
+        return m_priorityClass == InferencePriorityClass::eBackground ? D3D12QueueClass::kBackground : D3D12QueueClass::kForeground;
+    }
+#endif
+
+    void setPriority(InferencePriorityClass priorityClass, thread::IPriorityArbiter* arbiter) {
+        m_priorityClass = priorityClass;
+        m_arbiter = arbiter;
+    }
+
+    // Evaluation starts now, each flushOutputs() records result latencies and callback duration
+    void setMetrics(const EvaluationMetrics* metrics) {
+        m_metrics = metrics;
+        m_evaluationStart = std::chrono::steady_clock::now();
+        m_lastResult = {};
+    }
+
+    // Polled results go through the poll context ring, one arena per ring entry (see 'PollContext::setRingDepth')
+    //
+    // Decided once per evaluation, host owns the execution context while ring results are outstanding and can change it
+    void setResultRing(EvaluationArena* arenas) {
+        if (!arenas || m_execCtx->callback || m_execCtx->outputs) return;
+        m_ringArenas = arenas;
+        m_arena = nullptr;
+    }
+
+    // Results are posted to the host's executor, one arena per result in flight (see 'InferenceCallbackExecutor')
+    void setExecutor(const InferenceCallbackExecutor* executor, ExecutorResultRing* ring) {
+        m_executor = executor;
+        m_executorRing = ring;
+        m_arena = nullptr;
+    }
+
+    ~PluginContext() {
+        // Outputs were produced but never flushed
+        if (m_executorEntry) {
+            m_executorRing->release(*m_executorEntry);
+        }
+    }
+
+    // Get execution context (for advanced usage)
+    InferenceExecutionContext* getExecutionContext() const {
+        return m_execCtx;
+    }
+
+private:
+    template<typename T>
+    static constexpr bool always_false = false;
+
+    template<typename T>
+    bool findInputSlot(std::string_view name, const T** data) const {
+        if (m_inputIndex) {
+            if (auto position = m_inputIndex->find(name)) {
+                *data = m_inputBinding->get<T>(*position);
+                return *data != nullptr;
+            }
+        }
+        return m_execCtx->inputs->findAndValidateSlot(std::string(name).c_str(), data);
+    }
+
+    // Data behind a slot regardless of its type (text, audio, bytes, image)
+    static const NVIGIParameter* findSlotPayload(const InferenceDataSlotArray* slots, std::string_view name) {
+        for (size_t i = 0; i < slots->count; i++) {
+            auto& slot = slots->items[i];
+            if (!slot.data || !slot.key || name != slot.key) continue;
+            if (auto text = castTo<InferenceDataText>(slot.data)) return text->utf8Text;
+            if (auto audio = castTo<InferenceDataAudio>(slot.data)) return audio->audio;
+            if (auto bytes = castTo<InferenceDataByteArray>(slot.data)) return bytes->bytes;
+            if (auto image = castTo<InferenceDataImage>(slot.data)) return image->bytes;
+            return nullptr;
+        }
+        return nullptr;
+    }
+
+    // In ring mode the arena of the next ring entry is acquired lazily, blocks while host holds all entries
+    EvaluationArena& arena() {
+        if (!m_arena && m_executorRing) {
+            // Entry resets its arena on acquire
+            m_executorEntry = &m_executorRing->acquire();
+            m_arena = &m_executorEntry->arena;
+        }
+        else if (!m_arena) {
+            m_arena = &m_ringArenas[m_pollCtx->acquireSlot()];
+            m_arena->reset();
+        }
+        return *m_arena;
+    }
+
+    Expected<void> setStateOutput(NVIGIParameter* blob, const UID& format, uint32_t formatVersion, uint64_t modelHash, uint64_t tokenCount) {
+        auto state = arena().create<InferenceDataState>(blob);
+        state->format = format;
+        state->formatVersion = formatVersion;
+        state->modelHash = modelHash;
+        state->tokenCount = tokenCount;
+        for (auto& output : m_pendingOutputs) {
+            if (output.state && std::string_view(output.name) == kInferenceDataSlotStateOut) {
+                output.state = state;
+                return {};
+            }
+        }
+        m_pendingOutputs.push_back({ kInferenceDataSlotStateOut, nullptr, 0, nullptr, state });
+        return {};
+    }
+
+    Expected<void> flushOutputs() {
+        if (!m_execCtx) {
+            return std::unexpected(Error{kResultInvalidParameter, "No execution context"});
+        }
+
+        if (m_metrics) {
+            auto now = std::chrono::steady_clock::now();
+            if (m_lastResult == std::chrono::steady_clock::time_point{}) {
+                EvaluationMetrics::record(m_metrics->firstResult, m_evaluationStart, now);
+            }
+            else {
+                EvaluationMetrics::record(m_metrics->betweenResults, m_lastResult, now);
+            }
+            m_lastResult = now;
+        }
+
+        // Ring entries carry their own outputs, host picks them up in getResults(), see 'setResultRing'
+        bool useRing = m_ringArenas != nullptr;
+        InferenceDataSlotArray* originalOutputs = useRing ? nullptr : m_execCtx->outputs;
         bool usingTempOutputs = false;
-        
-        if (!m_execCtx->outputs) {
-            // Host didn't provide output slots, create temporary ones
+
+        // Create temporary output slots if host didn't provide them, all from the arena so nothing hits the heap
+        if (useRing || !m_execCtx->outputs) {
             NVIGI_LOG_VERBOSE("Creating temporary output slots");
             usingTempOutputs = true;
-            
-            for (const auto& [slotName, value] : m_pendingOutputs) {
-                if (auto strValue = std::any_cast<std::string>(&value)) {
-                    tempBuffers.emplace_back(strValue->length() + 1, (const void*)strValue->c_str());
-                    tempTextData.emplace_back(InferenceDataText(tempBuffers.back()));
-                    tempSlots.push_back({slotName.c_str(), tempTextData.back()});
+
+            auto count = m_pendingOutputs.size();
+            auto tempSlots = arena().createArray<InferenceDataSlot>(count);
+            for (size_t i = 0; i < count; i++) {
+                auto& output = m_pendingOutputs[i];
+                if (output.state) {
+                    tempSlots[i] = InferenceDataSlot(output.name, *output.state);
+                    continue;
                 }
+                if (output.view) {
+                    tempSlots[i] = InferenceDataSlot(output.name, output.view);
+                    continue;
+                }
+                if (output.device) {
+                    auto bytes = arena().create<InferenceDataByteArray>(output.device);
+                    tempSlots[i] = InferenceDataSlot(output.name, *bytes);
+                    continue;
+                }
+                auto buffer = arena().create<CpuData>(output.length + 1, (const void*)output.text);
+                auto text = arena().create<InferenceDataText>(*buffer);
+                tempSlots[i] = InferenceDataSlot(output.name, *text);
             }
-            
-            tempOutputs = { static_cast<uint32_t>(tempSlots.size()), tempSlots.data() };
-            m_execCtx->outputs = &tempOutputs;
+
+            auto tempOutputs = arena().create<InferenceDataSlotArray>();
+            *tempOutputs = { static_cast<uint32_t>(count), tempSlots };
+            if (m_executorEntry) {
+                // Host owns the entry until its callback returns, our execution context is never shared with the host thread
+                auto entry = m_executorEntry;
+                entry->execCtx = *m_execCtx;
+                entry->execCtx.outputs = tempOutputs;
+                entry->state = kInferenceExecutionStateDone;
+                m_executorEntry = nullptr;
+                m_arena = nullptr;
+                m_pendingOutputs.clear();
+                m_executor->post(&ExecutorResultRing::execute, entry, m_executor->executorUserData);
+                return {};
+            }
+            if (useRing) {
+                // Execution context belongs to the host while results are outstanding so it is not touched here,
+                // entry (and its arena) stays alive until released and the next cycle moves on to the next entry
+                m_pollCtx->publish(kInferenceExecutionStateDone, tempOutputs);
+                m_pendingOutputs.clear();
+                m_arena = nullptr;
+                return {};
+            }
+            m_execCtx->outputs = tempOutputs;
         }
 
+        // Host state slot temporarily pointing to our blob, restored once the host is done with the outputs
+        InferenceDataState* replacedState{};
+        NVIGIParameter* replacedBlob{};
+
         // Write all pending outputs to the execution context
-        for (const auto& [slotName, value] : m_pendingOutputs) {
-            // For now, only support string outputs (text slots)
-            if (auto strValue = std::any_cast<std::string>(&value)) {
-                const InferenceDataText* outputSlot{};
-                if (m_execCtx->outputs->findAndValidateSlot(slotName.c_str(), &outputSlot)) {
-                    auto cpuBuffer = castTo<CpuData>(outputSlot->utf8Text);
-                    if (cpuBuffer->buffer && cpuBuffer->sizeInBytes >= strValue->size() + 1) {
-                        strcpy_s((char*)cpuBuffer->buffer, cpuBuffer->sizeInBytes, strValue->c_str());
-                        NVIGI_LOG_VERBOSE("Wrote output '%s': %zu bytes", slotName.c_str(), strValue->size());
-                    } else {
-                        NVIGI_LOG_ERROR("Output buffer too small for slot '%s'", slotName.c_str());
-                        if (usingTempOutputs) {
-                            m_execCtx->outputs = originalOutputs;
-                        }
-                        return std::unexpected(Error{kResultInsufficientResources, "Output buffer too small"});
+        for (const auto& output : m_pendingOutputs) {
+            if (output.state) {
+                InferenceDataState* hostState{};
+                if (usingTempOutputs || !m_execCtx->outputs->findAndValidateSlot(output.name, &hostState)) {
+                    // Temporary slot already points to our state or host did not ask for it
+                    continue;
+                }
+                auto src = castTo<CpuData>(output.state->blob);
+                auto dst = castTo<CpuData>(hostState->blob);
+                if (!src || !dst || !dst->buffer || dst->sizeInBytes < src->sizeInBytes) {
+                    // GPU state or host buffer too small, hand over ours instead, it lives in the arena so the
+                    // host's blob is put back below before the arena is recycled
+                    NVIGI_LOG_VERBOSE("Output '%s' replaced with plugin owned state", output.name);
+                    replacedState = hostState;
+                    replacedBlob = hostState->blob;
+                    hostState->blob = output.state->blob;
+                }
+                else {
+                    memcpy((void*)dst->buffer, src->buffer, src->sizeInBytes);
+                }
+                hostState->format = output.state->format;
+                hostState->formatVersion = output.state->formatVersion;
+                hostState->modelHash = output.state->modelHash;
+                hostState->tokenCount = output.state->tokenCount;
+                continue;
+            }
+            if (output.device || output.view) {
+                // Either in a temporary slot already or host slot is missing, GPU data is never copied here
+                continue;
+            }
+            const InferenceDataText* outputSlot{};
+            if (m_execCtx->outputs->findAndValidateSlot(output.name, &outputSlot)) {
+                auto cpuBuffer = castTo<CpuData>(outputSlot->utf8Text);
+                if (cpuBuffer->buffer == output.text) {
+                    // Temporary slot already points to our data
+                    continue;
+                }
+                if (cpuBuffer->buffer && cpuBuffer->sizeInBytes >= output.length + 1) {
+                    strcpy_s((char*)cpuBuffer->buffer, cpuBuffer->sizeInBytes, output.text);
+                    NVIGI_LOG_VERBOSE("Wrote output '%s': %zu bytes", output.name, output.length);
+                } else {
+                    NVIGI_LOG_ERROR("Output buffer too small for slot '%s'", output.name);
+                    if (usingTempOutputs) {
+                        m_execCtx->outputs = originalOutputs;
                     }
+                    if (replacedState) {
+                        replacedState->blob = replacedBlob;
+                    }
+                    m_pendingOutputs.clear();
+                    resetArena();
+                    return std::unexpected(Error{kResultInsufficientResources, "Output buffer too small"});
                 }
             }
         }
@@ -351,9 +1341,14 @@ private:
         // Trigger callback with the outputs
         if (m_execCtx->callback) {
             // Callback mode: Invoke callback directly
+            auto start = std::chrono::steady_clock::now();
             m_execCtx->callback(m_execCtx, kInferenceExecutionStateDone, m_execCtx->callbackUserData);
+            if (m_metrics) {
+                EvaluationMetrics::record(m_metrics->callback, start, std::chrono::steady_clock::now());
+            }
         } else if (m_pollCtx) {
             // Polled mode: Signal poll context to unblock getResults()
+            // NOTE: This blocks until host calls releaseResults() so arena can be safely reset below
             m_pollCtx->triggerCallback(kInferenceExecutionStateDone);
         }
         
@@ -361,18 +1356,86 @@ private:
         if (usingTempOutputs) {
             m_execCtx->outputs = originalOutputs;
         }
-        
+        if (replacedState) {
+            replacedState->blob = replacedBlob;
+        }
+
+        // Host is done with the outputs, recycle memory for the next cycle (clear keeps vector capacity)
         m_pendingOutputs.clear();
+        resetArena();
         return {};
     }
 
+    void resetArena() {
+        if (m_executorEntry) {
+            m_executorRing->release(*m_executorEntry);
+            m_executorEntry = nullptr;
+            m_arena = nullptr;
+        }
+        else if (m_ringArenas || m_executorRing) {
+            // Entry is reset once acquired again
+            m_arena = nullptr;
+        }
+        else {
+            m_arena->reset();
+        }
+    }
+
     InferenceExecutionContext* m_execCtx;
     const NVIGIParameter* m_creationParams;
     std::any& m_pluginData;
     std::atomic<bool>* m_cancelled = nullptr;
+    InferencePriorityClass m_priorityClass = InferencePriorityClass::eInteractive;
+    thread::IPriorityArbiter* m_arbiter = nullptr;
+    const system::CpuThreadAssignment* m_cpuThreads = nullptr;
+    inline static const system::CpuThreadAssignment s_defaultCpuThreads{};
     poll::PollContext<InferenceExecutionState>* m_pollCtx = nullptr;
-
-    std::unordered_map<std::string, std::any> m_pendingOutputs;
+    const EvaluationMetrics* m_metrics = nullptr;
+    std::chrono::steady_clock::time_point m_evaluationStart{};
+    std::chrono::steady_clock::time_point m_lastResult{};
+
+    struct PendingOutput {
+        const char* name;
+        const char* text;
+        size_t length;
+        // GPU resident output, handle struct lives in the arena
+        NVIGIParameter* device;
+        // Persistent state output, lives in the arena
+        InferenceDataState* state = nullptr;
+        // Any other slot type used as is (e.g. InferenceDataTextView), lives in the arena
+        NVIGIParameter* view = nullptr;
+    };
+    // Used only if instance does not provide one
+    EvaluationArena m_localArena;
+    EvaluationArena* m_arena;
+    EvaluationArena* m_ringArenas = nullptr;
+    const InferenceCallbackExecutor* m_executor = nullptr;
+    ExecutorResultRing* m_executorRing = nullptr;
+    ExecutorResultRing::Entry* m_executorEntry = nullptr;
+    const SlotSignatureIndex* m_inputIndex = nullptr;
+    SlotBinding* m_inputBinding = nullptr;
+    SlotBinding m_localBinding;
+    StructChainIndex m_runtimeIndex;
+    // Instance's index if set, otherwise built on first 'getCreationParam'
+    const StructChainIndex* m_creationIndex = nullptr;
+    mutable StructChainIndex m_localCreationIndex;
+    std::vector<PendingOutput> m_pendingOutputs;
+    // Streamed text, see 'appendText'
+    const TextStreamingParameters* m_textStreaming = nullptr;
+    std::string m_localTextStream;
+    std::string* m_textStream = &m_localTextStream;
+    std::string m_textStreamName;
+    size_t m_textDelivered = 0;
+    uint32_t m_textPendingTokens = 0;
+    std::chrono::steady_clock::time_point m_lastTextDelivery{};
+    // Time slicing, see 'shouldSuspend'
+    const EvaluationBudgetParameters* m_budget = nullptr;
+    std::any* m_resumeState = nullptr;
+    std::any m_localResumeState;
+    std::chrono::steady_clock::time_point m_sliceStart{};
+    uint32_t m_workItems = 0;
+    bool m_resuming = false;
+    bool m_suspended = false;
 };
 
 // ============================================================================
@@ -424,6 +1487,92 @@ public:
 
         std::any pluginData;
         const NVIGIParameter* creationParams = nullptr;
+        // Rebuilt whenever 'creationParams' changes
+        StructChainIndex creationIndex;
+        // Creation parameter hash, see 'acquireInstance'
+        uint64_t poolKey = 0;
+        // Host's common parameters with the tuned profile applied, chained in front of the host's parameters, see 'TunedExecutionParameters'
+        std::unique_ptr<CommonCreationParameters> tunedCommon;
+
+        // See 'CommonCreationParameters::priorityClass'
+        InferencePriorityClass priorityClass = InferencePriorityClass::eInteractive;
+
+        // Host's 'CpuThreadBudget' resolved against the CPU topology, evaluation threads run with this affinity
+        system::CpuThreadAssignment cpuThreads;
+
+        // Backs all outputs produced by PluginContext, recycled after each callback
+        EvaluationArena arena;
+
+        // Optional bounded FIFO of execution contexts submitted while evaluating, see 'AsyncEvaluationParameters'
+        //
+        // Guarded by 'mtx', 'active' is true from job launch until the job finds the queue empty
+        struct QueuedRequest {
+            InferenceExecutionContext* execCtx;
+            std::chrono::steady_clock::time_point enqueued;
+        };
+        uint32_t queueDepth = 0;
+        EvaluationQueueOverflowPolicy overflowPolicy = EvaluationQueueOverflowPolicy::eReject;
+        std::deque<QueuedRequest> pending;
+        std::condition_variable pendingCV;
+        bool active = false;
+
+        // Optional long-lived evaluation thread, see 'AsyncEvaluationParameters::persistentThread'
+        //
+        // Guarded by 'workerMtx', at most one task is handed over at a time since 'job' is always consumed before the next launch
+        bool persistentThread = false;
+        std::thread worker;
+        std::mutex workerMtx;
+        std::condition_variable workerCV;
+        std::packaged_task<Result()> workerTask;
+        bool workerExit = false;
+
+        // Optional ring of polled results, one arena per entry, see 'AsyncEvaluationParameters::resultRingDepth'
+        std::unique_ptr<EvaluationArena[]> ringArenas;
+
+        // Results posted to the host's executor, sized on first use, see 'InferenceCallbackExecutor'
+        ExecutorResultRing executorRing;
+
+        // Streamed text of the running evaluation, see 'PluginContext::appendText' (guarded by 'evalMtx')
+        std::string textStream;
+
+        // One arena per execution context in a batch since outputs of all contexts are alive at the same time
+        std::vector<std::unique_ptr<EvaluationArena>> batchArenas;
+
+        // Serializes plugin evaluations, async jobs and the batch scheduler can otherwise overlap
+        std::mutex evalMtx;
+
+        // Inputs bound against the input signature, reused while host keeps passing the same slot array (guarded by 'evalMtx')
+        SlotBinding inputBinding;
+
+        // Synchronous evaluation waiting for its next time slice and the plugin's state for it, see 'EvaluationBudgetParameters'
+        //
+        // Written under 'evalMtx', pointer is atomic so cancellation can check it without waiting for a running evaluation
+        std::atomic<InferenceExecutionContext*> suspendedCtx{ nullptr };
+        std::any resumeState;
+
+        // Optional micro-batching scheduler, see 'CommonCreationParameters::maxBatchSize'
+        //
+        // Guarded by 'batchMtx', scheduler thread is started on first request
+        uint32_t maxBatchSize = 0;
+        std::chrono::microseconds batchWindow{};
+        std::mutex batchMtx;
+        std::condition_variable batchCV;
+        std::vector<QueuedRequest> batchQueue;
+        std::thread batchThread;
+        bool batchExit = false;
+
+        // Optional recording of submitted evaluations, see 'EvaluationCaptureParameters'
+        std::unique_ptr<ai::EvaluationCaptureWriter> capture;
+
+        // Background model load, see 'InferenceInstance::swapModel' (guarded by 'swapMtx')
+        std::mutex swapMtx;
+        std::future<void> swapJob;
+        // Guards 'pluginData' for cancellation which runs without 'evalMtx'
+        std::mutex pluginDataMtx;
+
+        // VRAM declared for the model, see 'reserveInstanceVRAM' (0 when nothing is reserved)
+        std::atomic<size_t> reservedVRAMMB{ 0 };
+        uint32_t vramAdapterIndex = 0;
     };
 
     // ========================================================================
@@ -441,8 +1590,24 @@ public:
         APIType api{};
         IPolledInferenceInterface polledApi{};
         PluginID feature{};
+        EvaluationMetrics metrics{};
+
+        // Warm instances released via 'releaseInstance', keyed by creation parameter hash
+        struct InstancePool {
+            std::mutex mtx;
+            std::unordered_map<uint64_t, std::vector<InferenceInstance*>> idle;
+            uint32_t maxIdlePerKey = 4;
+        } pool;
 
         ai::CommonCapsData capsData;
+        // Snapshots handed out by 'getCapsAndRequirements', freed on deregister
+        ai::CapsCache capsCache;
+
+        // CPU only plugins (VendorId::eNone) do not reserve VRAM for their instances
+        VendorId requiredVendor{};
+
+        // Optional, older cores do not arbitrate priority classes between plugins
+        thread::IPriorityArbiter* arbiter{};
 
 #ifdef GGML_USE_CUBLAS
         nvigi::IHWICuda* icig{};
@@ -464,6 +1629,18 @@ public:
         NVIGI_CATCH_EXCEPTION(destroyInstanceImpl(instance));
     }
 
+    static Result acquireInstance(const NVIGIParameter* params, InferenceInstance** outInstance) {
+        NVIGI_CATCH_EXCEPTION(acquireInstanceImpl(params, outInstance));
+    }
+
+    static Result releaseInstance(InferenceInstance* instance) {
+        NVIGI_CATCH_EXCEPTION(releaseInstanceImpl(instance));
+    }
+
+    static Result trimInstancePool(uint32_t maxIdleInstances) {
+        NVIGI_CATCH_EXCEPTION(trimInstancePoolImpl(maxIdleInstances));
+    }
+
     static Result evaluate(InferenceExecutionContext* execCtx) {
         NVIGI_CATCH_EXCEPTION(evaluateInternal(execCtx, false));
     }
@@ -472,6 +1649,10 @@ public:
         NVIGI_CATCH_EXCEPTION(evaluateInternal(execCtx, true));
     }
 
+    static Result evaluateBatch(InferenceExecutionContext** execCtxs, size_t count) {
+        NVIGI_CATCH_EXCEPTION(evaluateBatchImpl(execCtxs, count));
+    }
+
     static Result getResults(InferenceExecutionContext* execCtx, bool wait, InferenceExecutionState* state) {
         NVIGI_CATCH_EXCEPTION(getResultsImpl(execCtx, wait, state));
     }
@@ -480,10 +1661,18 @@ public:
         NVIGI_CATCH_EXCEPTION(releaseResultsImpl(execCtx, state));
     }
 
+    static Result getResultsWaitHandle(InferenceExecutionContext* execCtx, uint64_t* handle) {
+        NVIGI_CATCH_EXCEPTION(getResultsWaitHandleImpl(execCtx, handle));
+    }
+
     static Result cancelAsyncEvaluation(InferenceExecutionContext* execCtx) {
         NVIGI_CATCH_EXCEPTION(cancelAsyncEvaluationImpl(execCtx));
     }
 
+    static Result swapModel(InferenceInstance* instance, const NVIGIParameter* params, PFun_nvigiModelSwapCallback* callback, void* userData) {
+        NVIGI_CATCH_EXCEPTION(swapModelImpl(instance, params, callback, userData));
+    }
+
     // ========================================================================
     // Plugin Registration
     // ========================================================================
@@ -505,6 +1694,7 @@ public:
         info.minGPUArch = pluginInfo.minGPUArch;
         info.minDriver = pluginInfo.minDriver;
         info.requiredVendor = pluginInfo.requiredVendor;
+        getContext().requiredVendor = pluginInfo.requiredVendor;
 
         return kResultOk;
     }
@@ -515,15 +1705,21 @@ public:
 
         auto& ctx = getContext();
         ctx.feature = PluginImpl::getPluginID();
+        ctx.metrics.init(ctx.feature);
+        framework::getInterface(framework, nvigi::core::framework::kId, &ctx.arbiter);
 
         ctx.api.createInstance = createInstance;
         ctx.api.destroyInstance = destroyInstance;
         ctx.api.getCapsAndRequirements = getCapsAndRequirements;
+        ctx.api.acquireInstance = acquireInstance;
+        ctx.api.releaseInstance = releaseInstance;
+        ctx.api.trimInstancePool = trimInstancePool;
 
         framework->addInterface(ctx.feature, &ctx.api, 0);
 
         ctx.polledApi.getResults = getResults;
         ctx.polledApi.releaseResults = releaseResults;
+        ctx.polledApi.getResultsWaitHandle = getResultsWaitHandle;
         framework->addInterface(ctx.feature, &ctx.polledApi, 0);
 
         return PluginImpl::onPluginRegister(framework);
@@ -531,7 +1727,9 @@ public:
 
     static Result pluginDeregister() {
         auto& ctx = getContext();
+        trimInstancePoolImpl(0);
         ai::freeCommonCapsAndRequirements(ctx.capsData);
+        ctx.capsCache.clear();
 
 #if GGML_USE_CUBLAS
         if (ctx.icig) {
@@ -563,6 +1761,7 @@ private:
     // ========================================================================
 
     static Result createInstanceImpl(const NVIGIParameter* params, InferenceInstance** outInstance) {
+        NVIGI_TRACE_SCOPE("createInstance", &getContext().feature);
         auto common = findStruct<CommonCreationParameters>(params);
         if (!common || !params || !outInstance)
             return kResultInvalidParameter;
@@ -570,7 +1769,36 @@ private:
         *outInstance = nullptr;
 
         auto instance = new InstanceData(params);
+        params = applyTunedProfile(instance->tunedCommon, params);
+        common = findStruct<CommonCreationParameters>(params);
         instance->creationParams = params;
+        buildCreationIndex(instance);
+        if (common->getVersion() >= kStructVersion3) {
+            instance->maxBatchSize = common->maxBatchSize;
+            instance->batchWindow = std::chrono::microseconds(common->batchWindowUs);
+        }
+        instance->priorityClass = resolvePriorityClass(common);
+        instance->cpuThreads = system::getCpuThreadAssignment(params, (uint32_t)std::max(common->numThreads, 1));
+        if (auto asyncParams = instance->creationIndex.find<AsyncEvaluationParameters>()) {
+            instance->queueDepth = asyncParams->queueDepth;
+            instance->overflowPolicy = asyncParams->overflowPolicy;
+            instance->persistentThread = asyncParams->persistentThread;
+            if (asyncParams->resultRingDepth > 1 && !requiresSingleSlotPolledResults()) {
+                instance->pollCtx.setRingDepth(asyncParams->resultRingDepth);
+                instance->ringArenas = std::make_unique<EvaluationArena[]>(asyncParams->resultRingDepth);
+            }
+        }
+        if (auto captureParams = instance->creationIndex.find<EvaluationCaptureParameters>(); captureParams && captureParams->utf8PathToCaptureFile) {
+            instance->capture = std::make_unique<ai::EvaluationCaptureWriter>();
+            auto res = instance->capture->open(captureParams->utf8PathToCaptureFile, getContext().feature, common, captureParams->maxCaptureBytes, getCapturedRuntimeParameters());
+            if (res != kResultOk) {
+                NVIGI_LOG_WARN("Failed to open evaluation capture '%s' - error 0x%x", captureParams->utf8PathToCaptureFile, res);
+                instance->capture.reset();
+            }
+            else {
+                NVIGI_LOG_INFO("Recording evaluations to '%s'", captureParams->utf8PathToCaptureFile);
+            }
+        }
 
 #if GGML_USE_CUBLAS
         if (!instance->cudaContext.constructorSucceeded) {
@@ -587,7 +1815,7 @@ private:
             return createResult.error().code;
         }
 
-        auto wrapper = new InferenceInstance();
+        auto wrapper = new InferenceInstance(kStructVersion5);
         wrapper->data = instance;
         wrapper->getFeatureId = getFeatureId;
         wrapper->getInputSignature = getInputSignature;
@@ -595,15 +1823,89 @@ private:
         wrapper->evaluate = evaluate;
         wrapper->evaluateAsync = evaluateAsync;
         wrapper->cancelAsyncEvaluation = cancelAsyncEvaluation;
+        wrapper->evaluateBatch = evaluateBatch;
+        wrapper->swapModel = swapModel;
+        reserveInstanceVRAM(wrapper, params);
 
         *outInstance = wrapper;
         return kResultOk;
     }
 
+    static InferencePriorityClass resolvePriorityClass(const CommonCreationParameters* common) {
+        if (common->getVersion() >= kStructVersion4 && common->priorityClass < InferencePriorityClass::eCount) {
+            return common->priorityClass;
+        }
+        return InferencePriorityClass::eInteractive;
+    }
+
+    static void buildCreationIndex(InstanceData* instance) {
+        auto& index = instance->creationIndex;
+        // Tuned copy shadows the host's 'CommonCreationParameters' on purpose, see 'applyTunedProfile'
+        if (!index.build(instance->creationParams) && !(instance->tunedCommon && index.hasOnlyDuplicateOf(CommonCreationParameters::s_type))) {
+            index.logProblems("Creation parameter");
+        }
+    }
+
+    // Puts a copy of the host's 'CommonCreationParameters' with the tuned profile applied in front of the host's chain,
+    // the base and the plugin then find the tuned values first. Returns the chain the instance should use.
+    static const NVIGIParameter* applyTunedProfile(std::unique_ptr<CommonCreationParameters>& tunedCommon, const NVIGIParameter* params) {
+        tunedCommon.reset();
+        auto tuned = findStruct<TunedExecutionParameters>(params);
+        auto common = findStruct<CommonCreationParameters>(params);
+        if (!tuned || !common) {
+            return params;
+        }
+        if (common->getVersion() < kStructVersion3) {
+            NVIGI_LOG_WARN("TunedExecutionParameters require CommonCreationParameters v3 or newer, ignored");
+            return params;
+        }
+        auto profile = ai::findTunedProfile(ai::getTuningProfilePath(tuned, common), common->modelGUID, &getContext().feature);
+        if (!profile) {
+            NVIGI_LOG_VERBOSE("No tuned profile for model %s on this machine, run the test host with [tune]", common->modelGUID ? common->modelGUID : "unknown");
+            return params;
+        }
+
+        // Field by field, host's struct can be an older (smaller) version
+        auto copy = std::make_unique<CommonCreationParameters>();
+        copy->numThreads = common->numThreads;
+        copy->vramBudgetMB = common->vramBudgetMB;
+        copy->modelGUID = common->modelGUID;
+        copy->utf8PathToModels = common->utf8PathToModels;
+        copy->utf8PathToAdditionalModels = common->utf8PathToAdditionalModels;
+        copy->modelCardJSON = common->modelCardJSON;
+        copy->maxBatchSize = common->maxBatchSize;
+        copy->batchWindowUs = common->batchWindowUs;
+        if (common->getVersion() >= kStructVersion4) {
+            copy->priorityClass = common->priorityClass;
+        }
+        if (!(tuned->hostOverrides & kTunedSettingNumThreads)) {
+            copy->numThreads = profile->numThreads;
+        }
+        if (!(tuned->hostOverrides & kTunedSettingBatching)) {
+            copy->maxBatchSize = profile->maxBatchSize;
+            copy->batchWindowUs = profile->batchWindowUs;
+        }
+        NVIGI_LOG_INFO("Using tuned profile for model %s - threads %d, batch %u (%uus)", common->modelGUID ? common->modelGUID : "unknown",
+            copy->numThreads, copy->maxBatchSize, copy->batchWindowUs);
+        copy->_base.next = const_cast<NVIGIParameter*>(params);
+        tunedCommon = std::move(copy);
+        return *tunedCommon;
+    }
+
     static Result destroyInstanceImpl(const InferenceInstance* instance) {
         if (instance) {
+            NVIGI_TRACE_SCOPE("destroyInstance", &getContext().feature, instance);
             auto ctx = static_cast<InstanceData*>(instance->data);
+            // Waits for the pressure callback if it is running for this instance, nothing can evict it after this
+            releaseInstanceVRAM(instance);
+            waitForModelSwap(ctx);
+            stopBatchScheduler(ctx);
             flushAndTerminate(ctx);
+            stopWorker(ctx);
+            // Host's executor still references outputs owned by this instance
+            ctx->executorRing.waitIdle();
+            // Resume state can reference plugin data
+            abandonSuspended(ctx);
             
             // Call plugin's onDestroyInstance callback
             auto destroyResult = PluginImpl::onDestroyInstance(ctx->pluginData);
@@ -618,12 +1920,328 @@ private:
         return kResultOk;
     }
 
+    // Plugins opt into instance pooling by implementing 'static Expected<void> onReset(std::any& pluginData)'
+    // which clears per-session state (KV cache, history etc.) while keeping the model loaded
+    static constexpr bool hasReset() {
+        return requires(std::any& pluginData) {
+            { PluginImpl::onReset(pluginData) } -> std::same_as<Expected<void>>;
+        };
+    }
+
+    // Plugins with custom creation parameters that change backend state should implement
+    // 'static uint64_t hashCreationParameters(const NVIGIParameter* params)', it is combined with the common parameters
+    static uint64_t getPoolKey(const NVIGIParameter* params) {
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const void* data, size_t size)->void {
+            auto bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; i++) {
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            }
+        };
+        auto mixString = [&mix](const char* str)->void {
+            std::string_view view = str ? str : "";
+            mix(view.data(), view.size());
+            mix("", 1);
+        };
+        auto mixValue = [&mix](const auto& value)->void {
+            mix(&value, sizeof(value));
+        };
+        // Chain layout first, same structs in the same order
+        for (auto p = params; p; p = static_cast<const BaseStructure*>(p->next)) {
+            mix(&p->type, sizeof(p->type));
+            mix(&p->version, sizeof(p->version));
+        }
+        if (auto common = findStruct<CommonCreationParameters>(params)) {
+            mix(&common->numThreads, sizeof(common->numThreads));
+            mix(&common->vramBudgetMB, sizeof(common->vramBudgetMB));
+            mixString(common->modelGUID);
+            mixString(common->utf8PathToModels);
+            mixString(common->utf8PathToAdditionalModels);
+            if (common->getVersion() >= kStructVersion2) {
+                mixString(common->modelCardJSON);
+            }
+            if (common->getVersion() >= kStructVersion3) {
+                mix(&common->maxBatchSize, sizeof(common->maxBatchSize));
+                mix(&common->batchWindowUs, sizeof(common->batchWindowUs));
+            }
+            if (common->getVersion() >= kStructVersion4) {
+                mix(&common->priorityClass, sizeof(common->priorityClass));
+            }
+        }
+        if (auto budget = findStruct<CpuThreadBudget>(params)) {
+            mix(&budget->maxThreads, sizeof(budget->maxThreads));
+            mix(&budget->coreClass, sizeof(budget->coreClass));
+            mix(&budget->affinityMask, sizeof(budget->affinityMask));
+            mix(&budget->singleL3Domain, sizeof(budget->singleL3Domain));
+        }
+        if (auto tuned = findStruct<TunedExecutionParameters>(params)) {
+            mixString(tuned->utf8PathToProfiles);
+            mix(&tuned->hostOverrides, sizeof(tuned->hostOverrides));
+        }
+        if (auto asyncParams = findStruct<AsyncEvaluationParameters>(params)) {
+            mix(&asyncParams->queueDepth, sizeof(asyncParams->queueDepth));
+            mix(&asyncParams->overflowPolicy, sizeof(asyncParams->overflowPolicy));
+            mix(&asyncParams->persistentThread, sizeof(asyncParams->persistentThread));
+            mix(&asyncParams->resultRingDepth, sizeof(asyncParams->resultRingDepth));
+        }
+        // Devices, queues and allocation callbacks stay with the instance, the structs holding them are
+        // often on the host's stack so their addresses say nothing and only the members are hashed
+        if (auto d3d12 = findStruct<D3D12Parameters>(params)) {
+            mixValue(d3d12->device);
+            mixValue(d3d12->queue);
+            if (d3d12->getVersion() >= kStructVersion2) {
+                mixValue(d3d12->queueCompute);
+                mixValue(d3d12->queueCopy);
+                mixValue(d3d12->createCommittedResourceCallback);
+                mixValue(d3d12->destroyResourceCallback);
+                mixValue(d3d12->createCommitResourceUserContext);
+                mixValue(d3d12->destroyResourceUserContext);
+            }
+            if (d3d12->getVersion() >= kStructVersion3) {
+                mixValue(d3d12->flags);
+            }
+        }
+        if (auto cuda = findStruct<CudaParameters>(params)) {
+            mixValue(cuda->impl);
+            mixValue(cuda->device);
+            mixValue(cuda->context);
+            mixValue(cuda->stream);
+            if (cuda->getVersion() >= kStructVersion2) {
+                mixValue(cuda->cudaMallocReportCallback);
+                mixValue(cuda->cudaMallocReportUserContext);
+                mixValue(cuda->cudaFreeReportCallback);
+                mixValue(cuda->cudaFreeReportUserContext);
+                mixValue(cuda->cudaMallocCallback);
+                mixValue(cuda->cudaMallocUserContext);
+                mixValue(cuda->cudaFreeCallback);
+                mixValue(cuda->cudaFreeUserContext);
+            }
+        }
+        if (auto vulkan = findStruct<VulkanParameters>(params)) {
+            mixValue(vulkan->physicalDevice);
+            mixValue(vulkan->device);
+            mixValue(vulkan->instance);
+            mixValue(vulkan->queue);
+            if (vulkan->getVersion() >= kStructVersion2) {
+                mixValue(vulkan->queueCompute);
+                mixValue(vulkan->queueTransfer);
+                mixValue(vulkan->allocateMemoryCallback);
+                mixValue(vulkan->freeMemoryCallback);
+                mixValue(vulkan->allocateMemoryCallbackUserContext);
+                mixValue(vulkan->freeMemoryCallbackUserContext);
+            }
+        }
+        if constexpr (requires { { PluginImpl::hashCreationParameters(params) } -> std::convertible_to<uint64_t>; }) {
+            uint64_t custom = PluginImpl::hashCreationParameters(params);
+            mix(&custom, sizeof(custom));
+        }
+        return hash;
+    }
+
+    static Result acquireInstanceImpl(const NVIGIParameter* params, InferenceInstance** outInstance) {
+        if (!params || !outInstance)
+            return kResultInvalidParameter;
+
+        auto key = getPoolKey(params);
+        if constexpr (hasReset()) {
+            auto& pool = getContext().pool;
+            std::scoped_lock lock(pool.mtx);
+            if (auto it = pool.idle.find(key); it != pool.idle.end() && !it->second.empty()) {
+                *outInstance = it->second.back();
+                it->second.pop_back();
+                // Previous parameters belonged to the previous owner
+                auto instance = static_cast<InstanceData*>((*outInstance)->data);
+                instance->creationParams = applyTunedProfile(instance->tunedCommon, params);
+                buildCreationIndex(instance);
+                updateVRAMReservation(*outInstance, false);
+                return kResultOk;
+            }
+        }
+
+        NVIGI_CHECK(createInstanceImpl(params, outInstance));
+        static_cast<InstanceData*>((*outInstance)->data)->poolKey = key;
+        return kResultOk;
+    }
+
+    static Result releaseInstanceImpl(InferenceInstance* instance) {
+        if (!instance)
+            return kResultOk;
+
+        if constexpr (hasReset()) {
+            auto ctx = static_cast<InstanceData*>(instance->data);
+            // Outstanding work belongs to the previous session, requests still waiting for a batch are
+            // reported as cancelled and the scheduler restarts on the next batched request
+            waitForModelSwap(ctx);
+            stopBatchScheduler(ctx);
+            if (flushAndTerminate(ctx) == kResultTimedOut) {
+                // Job still runs and could touch the next owner's session
+                NVIGI_LOG_WARN("Async job did not finish, instance will be destroyed instead of pooled");
+                return destroyInstanceImpl(instance);
+            }
+            {
+                std::scoped_lock lock(ctx->mtx);
+                ctx->pending.clear();
+                ctx->active = false;
+            }
+            while (ctx->pollCtx.checkResultPending()) {
+                ctx->pollCtx.releaseResults(kInferenceExecutionStateDone);
+            }
+            ctx->inputBinding = SlotBinding{};
+            abandonSuspended(ctx);
+            ctx->cancelled.store(false);
+            ctx->running.store(true);
+
+            auto resetResult = PluginImpl::onReset(ctx->pluginData);
+            if (!resetResult) {
+                NVIGI_LOG_WARN("onReset failed, instance will be destroyed: %s", resetResult.error().message.c_str());
+                return destroyInstanceImpl(instance);
+            }
+
+            auto& pool = getContext().pool;
+            std::unique_lock lock(pool.mtx);
+            auto& idle = pool.idle[ctx->poolKey];
+            if (idle.size() < pool.maxIdlePerKey) {
+                ctx->creationParams = nullptr;
+                ctx->creationIndex.build(nullptr);
+                idle.push_back(instance);
+                // Under the pool lock so the pressure callback never sees an instance which is not in the pool yet
+                updateVRAMReservation(instance, true);
+                return kResultOk;
+            }
+        }
+        return destroyInstanceImpl(instance);
+    }
+
+    static Result trimInstancePoolImpl(uint32_t maxIdleInstances) {
+        std::vector<InferenceInstance*> trimmed;
+        {
+            auto& pool = getContext().pool;
+            std::scoped_lock lock(pool.mtx);
+            pool.maxIdlePerKey = maxIdleInstances;
+            for (auto& [key, idle] : pool.idle) {
+                while (idle.size() > maxIdleInstances) {
+                    trimmed.push_back(idle.back());
+                    idle.pop_back();
+                }
+            }
+            std::erase_if(pool.idle, [](const auto& entry) { return entry.second.empty(); });
+        }
+        // Outside of the lock, tearing down backends can take a while
+        for (auto instance : trimmed) {
+            destroyInstanceImpl(instance);
+        }
+        return kResultOk;
+    }
+
+    // ========================================================================
+    // VRAM Reservations
+    // ========================================================================
+    //
+    // Each instance reserves its model's 'modelMemoryBudgetMB' (see 'ISystem::reserveVRAM') so adapter placement
+    // and other plugins see it. Evaluations mark it as recently used, pooled idle instances are the ones offered
+    // for eviction when the process goes over the VRAM budget.
+    //
+    // Plugins which know the adapter their backend runs on can implement
+    // 'static uint32_t getAdapterIndex(const std::any& pluginData)', otherwise adapter 0 is assumed.
+
+    static size_t getModelMemoryBudgetMB(const NVIGIParameter* params) {
+        auto common = findStruct<CommonCreationParameters>(params);
+        NVIGIParameter* info{};
+        if (!common || !common->modelGUID || getCapsAndRequirements(&info, params) != kResultOk) return 0;
+        auto caps = findStruct<CommonCapabilitiesAndRequirements>(info);
+        if (!caps || !caps->supportedModelGUIDs || !caps->modelMemoryBudgetMB) return 0;
+        auto sameGUID = [](std::string_view a, std::string_view b)->bool {
+            return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](char x, char y) {
+                return std::toupper(static_cast<unsigned char>(x)) == std::toupper(static_cast<unsigned char>(y));
+            });
+        };
+        for (size_t i = 0; i < caps->numSupportedModels; i++) {
+            if (caps->supportedModelGUIDs[i] && sameGUID(caps->supportedModelGUIDs[i], common->modelGUID)) {
+                return caps->modelMemoryBudgetMB[i];
+            }
+        }
+        return 0;
+    }
+
+    // Called on creation and after a model swap, a model without a known budget drops the reservation
+    static void reserveInstanceVRAM(InferenceInstance* wrapper, const NVIGIParameter* params) {
+        auto isystem = system::getInterface();
+        if (!isystem || isystem->getVersion() < kStructVersion2 || getContext().requiredVendor == VendorId::eNone) return;
+        auto ctx = static_cast<InstanceData*>(wrapper->data);
+        auto sizeMB = getModelMemoryBudgetMB(params);
+        if (!sizeMB) {
+            releaseInstanceVRAM(wrapper);
+            return;
+        }
+        if constexpr (requires(const std::any& pluginData) { { PluginImpl::getAdapterIndex(pluginData) } -> std::convertible_to<uint32_t>; }) {
+            ctx->vramAdapterIndex = PluginImpl::getAdapterIndex(ctx->pluginData);
+        }
+        auto result = isystem->reserveVRAM(ctx->vramAdapterIndex, getContext().feature, wrapper, sizeMB, nullptr, nullptr);
+        if (result != kResultOk) {
+            NVIGI_LOG_WARN("Unable to reserve %zuMB of VRAM on adapter %u - error 0x%x", sizeMB, ctx->vramAdapterIndex, result);
+            sizeMB = 0;
+        }
+        ctx->reservedVRAMMB = sizeMB;
+    }
+
+    // Only idle instances are registered with the pressure callback, instances in use cannot give anything back
+    static void updateVRAMReservation(InferenceInstance* wrapper, bool idle) {
+        auto ctx = static_cast<InstanceData*>(wrapper->data);
+        auto sizeMB = ctx->reservedVRAMMB.load();
+        if (!sizeMB) return;
+        auto isystem = system::getInterface();
+        isystem->reserveVRAM(ctx->vramAdapterIndex, getContext().feature, wrapper, sizeMB, idle ? onVRAMPressure : nullptr, nullptr);
+    }
+
+    static void touchInstanceVRAM(const InferenceInstance* wrapper) {
+        if (static_cast<InstanceData*>(wrapper->data)->reservedVRAMMB.load(std::memory_order_relaxed)) {
+            system::getInterface()->touchVRAMReservation(const_cast<InferenceInstance*>(wrapper));
+        }
+    }
+
+    static void releaseInstanceVRAM(const InferenceInstance* wrapper) {
+        auto ctx = static_cast<InstanceData*>(wrapper->data);
+        if (ctx->reservedVRAMMB.exchange(0)) {
+            system::getInterface()->releaseVRAM(const_cast<InferenceInstance*>(wrapper));
+        }
+    }
+
+    // Runs on the system's VRAM manager thread, least recently used idle instances are asked first
+    static size_t onVRAMPressure(uint32_t adapterIndex, size_t requestedMB, void* instance, void*) {
+        auto wrapper = static_cast<InferenceInstance*>(instance);
+        {
+            auto& pool = getContext().pool;
+            std::scoped_lock lock(pool.mtx);
+            bool found = false;
+            for (auto& [key, idle] : pool.idle) {
+                if (auto it = std::find(idle.begin(), idle.end(), wrapper); it != idle.end()) {
+                    idle.erase(it);
+                    found = true;
+                    break;
+                }
+            }
+            // Acquired or trimmed in the meantime
+            if (!found) return 0;
+            std::erase_if(pool.idle, [](const auto& entry) { return entry.second.empty(); });
+        }
+        auto freedMB = static_cast<InstanceData*>(wrapper->data)->reservedVRAMMB.load();
+        NVIGI_LOG_INFO("Evicting idle instance to free %zuMB of VRAM on adapter %u (%zuMB requested)", freedMB, adapterIndex, requestedMB);
+        destroyInstanceImpl(wrapper);
+        return freedMB;
+    }
+
     static Result getResultsImpl(InferenceExecutionContext* execCtx, bool wait, InferenceExecutionState* state) {
         if (!execCtx || !execCtx->instance)
             return kResultInvalidParameter;
 
         auto instance = static_cast<InstanceData*>(execCtx->instance->data);
-        return instance->pollCtx.getResults(wait, state);
+        void* outputs{};
+        auto result = instance->pollCtx.getResults(wait, state, poll::kDefaultTimeoutMs, &outputs);
+        if (result == kResultOk && outputs) {
+            // Ring entry, expose its outputs until released
+            execCtx->outputs = static_cast<InferenceDataSlotArray*>(outputs);
+        }
+        return result;
     }
 
     static Result releaseResultsImpl(InferenceExecutionContext* execCtx, InferenceExecutionState state) {
@@ -631,15 +2249,41 @@ private:
             return kResultInvalidParameter;
 
         auto instance = static_cast<InstanceData*>(execCtx->instance->data);
+        if (instance->ringArenas && execCtx->outputs && execCtx->outputs == instance->pollCtx.peekPayload()) {
+            // Entry memory is recycled by the plugin from now on
+            execCtx->outputs = nullptr;
+        }
         return instance->pollCtx.releaseResults(state);
     }
 
+    static Result getResultsWaitHandleImpl(InferenceExecutionContext* execCtx, uint64_t* handle) {
+        if (!execCtx || !execCtx->instance || !handle)
+            return kResultInvalidParameter;
+
+        auto instance = static_cast<InstanceData*>(execCtx->instance->data);
+        *handle = instance->pollCtx.getWaitHandle();
+        return *handle ? kResultOk : kResultInvalidState;
+    }
+
     static Result cancelAsyncEvaluationImpl(InferenceExecutionContext* execCtx) {
         if (!execCtx || !execCtx->instance)
             return kResultInvalidParameter;
 
         auto instance = static_cast<InstanceData*>(execCtx->instance->data);
 
+        // Time sliced evaluation waiting for its next 'evaluate', nothing is running so it is simply dropped
+        if (instance->suspendedCtx.load() == execCtx) {
+            std::unique_lock evalLock(instance->evalMtx);
+            if (instance->suspendedCtx.load() == execCtx) {
+                abandonSuspended(instance);
+                evalLock.unlock();
+                if (execCtx->callback) {
+                    execCtx->callback(execCtx, kInferenceExecutionStateCancel, execCtx->callbackUserData);
+                }
+                return kResultOk;
+            }
+        }
+
         // Check if async job is actually running
         if (!instance->job.valid()) {
             NVIGI_LOG_WARN("cancelAsyncEvaluation called but no async evaluation is running");
@@ -647,55 +2291,185 @@ private:
         }
 
         // Set cancellation flag to interrupt the evaluation loop as early as possible
+        auto start = std::chrono::steady_clock::now();
         instance->cancelled.store(true);
 
         // Let plugin handle cancellation
-        PluginContext ctx(execCtx, instance->creationParams, instance->pluginData, &instance->pollCtx);
-        auto result = PluginImpl::onCancel(ctx);
-        if (!result) {
-            NVIGI_LOG_ERROR("Cancel failed: %s", result.error().message.c_str());
+        {
+            std::scoped_lock dataLock(instance->pluginDataMtx);
+            PluginContext ctx(execCtx, instance->creationParams, instance->pluginData, &instance->pollCtx);
+            ctx.setCreationIndex(&instance->creationIndex);
+            auto result = PluginImpl::onCancel(ctx);
+            if (!result) {
+                NVIGI_LOG_ERROR("Cancel failed: %s", result.error().message.c_str());
+            }
         }
 
-        return flushAndTerminate(instance);
+        // How long plugin code ran on after the request, large values mean missing cancellation points
+        auto res = flushAndTerminate(instance);
+        EvaluationMetrics::record(getContext().metrics.cancelToIdle, start, std::chrono::steady_clock::now());
+        return res;
     }
 
     // ========================================================================
     // Internal Helpers
     // ========================================================================
 
-    // Lambda factory for async evaluation jobs
-    // This creates the worker function that runs in the background thread.
-    // It checks both 'running' and 'cancelled' flags to allow graceful termination.
+    // Runs one evaluation on the calling (background) thread
     //
     // IMPORTANT: The plugin's onEvaluate() may trigger callbacks or use polled results:
     //   - WITH callback: Calls execCtx->callback(), returns immediately
     //   - WITHOUT callback (polled): Calls pollCtx.triggerCallback(), which blocks
     //     until host calls getResults() and releaseResults()
-    static auto createEvaluationJob(InstanceData* instance, InferenceExecutionContext* execCtx) {
-        return [instance, execCtx]() -> Result {
-            PluginContext ctx(execCtx, instance->creationParams, instance->pluginData, &instance->pollCtx);
-            ctx.setCancelledFlag(&instance->cancelled);
+    static Result runEvaluation(InstanceData* instance, InferenceExecutionContext* execCtx, std::chrono::steady_clock::time_point enqueued) {
+        std::scoped_lock evalLock(instance->evalMtx);
+        abandonSuspended(instance);
+        NVIGI_TRACE_SCOPE("evaluate", &getContext().feature, execCtx->instance);
+        auto& metrics = getContext().metrics;
+        // Time spent stepping aside for higher priority features counts as queue wait
+        PriorityScope priority(getContext().arbiter, instance->priorityClass);
+        auto start = std::chrono::steady_clock::now();
+        EvaluationMetrics::record(metrics.queueWait, enqueued, start);
+        PluginContext ctx(execCtx, instance->creationParams, instance->pluginData, &instance->pollCtx, &instance->arena);
+        ctx.setCreationIndex(&instance->creationIndex);
+        ctx.setCancelledFlag(&instance->cancelled);
+        ctx.setPriority(instance->priorityClass, getContext().arbiter);
+        ctx.setCpuThreadAssignment(&instance->cpuThreads);
+        CpuAffinityScope affinity(instance->cpuThreads);
+        ctx.setMetrics(&metrics);
+        ctx.setInputIndex(&getInputIndex(), &instance->inputBinding);
+        if (instance->ringArenas) {
+            ctx.setResultRing(instance->ringArenas.get());
+        }
+        if (auto executor = ctx.getRuntimeParam<InferenceCallbackExecutor>(); executor && (*executor)->post && execCtx->callback && !execCtx->outputs) {
+            instance->executorRing.resize((*executor)->maxResultsInFlight);
+            ctx.setExecutor(*executor, &instance->executorRing);
+        }
+        ctx.setTextStream(&instance->textStream);
 
-            auto res = kResultOk;
-            while (instance->running.load() && !instance->cancelled.load() && res == kResultOk) {
-                auto result = PluginImpl::onEvaluate(ctx);
-                if (!result) {
-                    // Only report an error if user did not cancel, to avoid confusion with expected cancellation flow, result should have the code we can check for cancellation vs actual errors
-                    if(result.error().code != kResultCanceled) {
-                        NVIGI_LOG_ERROR("Evaluation failed: %s", result.error().message.c_str());
-                    }
-                    else
-                    {
-                        NVIGI_LOG_INFO("Evaluation cancelled successfully");
-                    }
-                    res = result.error().code;
-                    break;
+        auto res = kResultOk;
+        while (instance->running.load() && !instance->cancelled.load() && res == kResultOk) {
+            auto result = PluginImpl::onEvaluate(ctx);
+            if (result) {
+                // Coalesced text still pending
+                result = ctx.flushText();
+            }
+            if (!result) {
+                // Only report an error if user did not cancel, to avoid confusion with expected cancellation flow, result should have the code we can check for cancellation vs actual errors
+                if(result.error().code != kResultCanceled) {
+                    NVIGI_LOG_ERROR("Evaluation failed: %s", result.error().message.c_str());
                 }
-
-                // For most plugins, one evaluation is enough
+                else
+                {
+                    NVIGI_LOG_INFO("Evaluation cancelled successfully");
+                }
+                res = result.error().code;
                 break;
             }
 
+            // For most plugins, one evaluation is enough
+            break;
+        }
+        EvaluationMetrics::record(metrics.evaluate, start, std::chrono::steady_clock::now());
+        return res;
+    }
+
+    // Evaluation is registered with the framework wide arbiter and the calling thread follows the priority class for its duration
+    struct PriorityScope {
+        // Upper bound on waiting for higher classes at the start of an evaluation, lower classes must not starve
+        static constexpr uint32_t kMaxWaitMs = 1000;
+
+        PriorityScope(thread::IPriorityArbiter* arbiter, InferencePriorityClass priorityClass)
+            : m_arbiter(arbiter), m_priorityClass(priorityClass) {
+            if (m_arbiter && m_arbiter->beginEvaluation((uint32_t)m_priorityClass, kMaxWaitMs) == kResultTimedOut) {
+                NVIGI_LOG_VERBOSE("Evaluation with priority class %u started while higher priority work is still running", (uint32_t)m_priorityClass);
+            }
+#ifdef NVIGI_WINDOWS
+            if (m_priorityClass != InferencePriorityClass::eInteractive) {
+                m_previousThreadPriority = GetThreadPriority(GetCurrentThread());
+                SetThreadPriority(GetCurrentThread(), m_priorityClass == InferencePriorityClass::eRealtime ? THREAD_PRIORITY_ABOVE_NORMAL : THREAD_PRIORITY_BELOW_NORMAL);
+            }
+#endif
+        }
+        ~PriorityScope() {
+#ifdef NVIGI_WINDOWS
+            if (m_previousThreadPriority != THREAD_PRIORITY_ERROR_RETURN) {
+                SetThreadPriority(GetCurrentThread(), m_previousThreadPriority);
+            }
+#endif
+            if (m_arbiter) {
+                m_arbiter->endEvaluation((uint32_t)m_priorityClass);
+            }
+        }
+
+        thread::IPriorityArbiter* m_arbiter;
+        InferencePriorityClass m_priorityClass;
+#ifdef NVIGI_WINDOWS
+        int m_previousThreadPriority = THREAD_PRIORITY_ERROR_RETURN;
+#endif
+    };
+
+    // Evaluation thread runs on the cores the host gave the instance, restored afterwards since async threads can be reused
+    struct CpuAffinityScope {
+        CpuAffinityScope(const system::CpuThreadAssignment& assignment) {
+            auto isystem = system::getInterface();
+            if (assignment.affinityMask && isystem && isystem->getVersion() >= kStructVersion4) {
+                m_applied = isystem->applyCpuThreadAssignment(assignment, &m_previous) == kResultOk;
+            }
+        }
+        ~CpuAffinityScope() {
+            if (m_applied) {
+                system::getInterface()->applyCpuThreadAssignment(m_previous, nullptr);
+            }
+        }
+
+        system::CpuThreadAssignment m_previous{};
+        bool m_applied = false;
+    };
+
+    // Queued execution contexts which will never be evaluated are reported as cancelled (if host provided a callback)
+    static void dropPending(std::deque<InferenceExecutionContext*>& dropped) {
+        for (auto execCtx : dropped) {
+            NVIGI_LOG_VERBOSE("Dropping queued execution context %p", execCtx);
+            if (execCtx->callback) {
+                execCtx->callback(execCtx, kInferenceExecutionStateCancel, execCtx->callbackUserData);
+            }
+        }
+        dropped.clear();
+    }
+
+    // Lambda factory for async evaluation jobs
+    // This creates the worker function that runs in the background thread.
+    // It checks both 'running' and 'cancelled' flags to allow graceful termination.
+    //
+    // Execution contexts queued while evaluating (see 'AsyncEvaluationParameters') are drained back-to-back.
+    static auto createEvaluationJob(InstanceData* instance, InferenceExecutionContext* execCtx) {
+        return [instance, execCtx, enqueued = std::chrono::steady_clock::now()]() -> Result {
+            auto res = runEvaluation(instance, execCtx, enqueued);
+
+            std::deque<InferenceExecutionContext*> dropped;
+            while (true) {
+                typename InstanceData::QueuedRequest next{};
+                {
+                    std::scoped_lock lock(instance->mtx);
+                    if (res != kResultOk || !instance->running.load() || instance->cancelled.load() || instance->pending.empty()) {
+                        // Nothing left to do (or we must stop), new submissions start a new job from now on
+                        for (auto& request : instance->pending) {
+                            dropped.push_back(request.execCtx);
+                        }
+                        instance->pending.clear();
+                        instance->active = false;
+                        instance->pendingCV.notify_all();
+                        break;
+                    }
+                    next = instance->pending.front();
+                    instance->pending.pop_front();
+                    instance->pendingCV.notify_all();
+                }
+                res = runEvaluation(instance, next.execCtx, next.enqueued);
+            }
+            dropPending(dropped);
+
             // If cancelled, exit cleanly
             if (instance->cancelled.load()) {
                 NVIGI_LOG_VERBOSE("Evaluation cancelled by user request");
@@ -706,6 +2480,161 @@ private:
         };
     }
 
+    // Starts an evaluation job, either on a fresh thread or on the instance's persistent worker
+    static std::future<Result> launchJob(InstanceData* instance, InferenceExecutionContext* execCtx) {
+        if (!instance->persistentThread) {
+            return std::async(std::launch::async, createEvaluationJob(instance, execCtx));
+        }
+
+        std::packaged_task<Result()> task(createEvaluationJob(instance, execCtx));
+        auto future = task.get_future();
+        {
+            std::scoped_lock lock(instance->workerMtx);
+            if (!instance->worker.joinable()) {
+                // Created lazily so instances which never evaluate async do not pay for a thread
+                instance->workerExit = false;
+                instance->worker = std::thread(workerLoop, instance);
+            }
+            instance->workerTask = std::move(task);
+        }
+        instance->workerCV.notify_one();
+        return future;
+    }
+
+    // Persistent worker parks on 'workerCV' between evaluations
+    static void workerLoop(InstanceData* instance) {
+#if GGML_USE_CUBLAS
+        // Bind once for the lifetime of the thread, plugin's RuntimeContextScope becomes a no-op here
+        instance->cudaContext.pinRuntimeContext();
+#endif
+        while (true) {
+            std::packaged_task<Result()> task;
+            {
+                std::unique_lock lock(instance->workerMtx);
+                instance->workerCV.wait(lock, [instance]() { return instance->workerExit || instance->workerTask.valid(); });
+                if (!instance->workerTask.valid()) {
+                    break;
+                }
+                task = std::move(instance->workerTask);
+            }
+            task();
+        }
+#if GGML_USE_CUBLAS
+        instance->cudaContext.unpinRuntimeContext();
+#endif
+    }
+
+    static void stopWorker(InstanceData* instance) {
+        {
+            std::scoped_lock lock(instance->workerMtx);
+            if (!instance->worker.joinable()) {
+                return;
+            }
+            instance->workerExit = true;
+        }
+        instance->workerCV.notify_one();
+        instance->worker.join();
+    }
+
+    // Plugins relying on the host releasing each polled result before producing the next one
+    // can opt out of the result ring by declaring 'static constexpr bool kSingleSlotPolledResults = true;'
+    static constexpr bool requiresSingleSlotPolledResults() {
+        if constexpr (requires { PluginImpl::kSingleSlotPolledResults; }) {
+            return PluginImpl::kSingleSlotPolledResults;
+        }
+        return false;
+    }
+
+    // Plugins can fuse batches into one forward pass by implementing
+    // 'static Expected<void> onEvaluateBatch(std::span<PluginContext*> batch)', otherwise onEvaluate() runs per context
+    static constexpr bool hasBatchedEvaluate() {
+        return requires(std::span<PluginContext*> batch) {
+            { PluginImpl::onEvaluateBatch(batch) } -> std::same_as<Expected<void>>;
+        };
+    }
+
+    // Runs all execution contexts on the calling thread, each one gets its own arena and its callback once its outputs are built
+    static Result runBatch(InstanceData* instance, std::span<InferenceExecutionContext*> execCtxs) {
+        std::scoped_lock evalLock(instance->evalMtx);
+        abandonSuspended(instance);
+        NVIGI_TRACE_SCOPE("evaluateBatch", &getContext().feature, execCtxs.empty() ? nullptr : execCtxs[0]->instance);
+        if (instance->batchArenas.size() < execCtxs.size()) {
+            instance->batchArenas.resize(execCtxs.size());
+            for (auto& arena : instance->batchArenas) {
+                if (!arena) arena = std::make_unique<EvaluationArena>();
+            }
+        }
+
+        if constexpr (hasBatchedEvaluate()) {
+            // PluginContext is not movable, deque keeps elements in place
+            std::deque<PluginContext> contexts;
+            std::vector<PluginContext*> batch;
+            batch.reserve(execCtxs.size());
+            for (size_t i = 0; i < execCtxs.size(); i++) {
+                auto& ctx = contexts.emplace_back(execCtxs[i], instance->creationParams, instance->pluginData, nullptr, instance->batchArenas[i].get());
+                ctx.setCreationIndex(&instance->creationIndex);
+                ctx.setCancelledFlag(&instance->cancelled);
+                ctx.setMetrics(&getContext().metrics);
+                ctx.setInputIndex(&getInputIndex());
+                batch.push_back(&ctx);
+            }
+            auto start = std::chrono::steady_clock::now();
+            auto result = PluginImpl::onEvaluateBatch(std::span<PluginContext*>(batch));
+            for (size_t i = 0; i < batch.size() && result; i++) {
+                result = batch[i]->flushText();
+            }
+            EvaluationMetrics::record(getContext().metrics.evaluate, start, std::chrono::steady_clock::now());
+            if (!result) {
+                NVIGI_LOG_ERROR("Batched evaluation failed: %s", result.error().message.c_str());
+                return result.error().code;
+            }
+            return kResultOk;
+        }
+        else {
+            // Keep going on errors so every context gets a chance to run, first error is reported
+            auto res = kResultOk;
+            for (size_t i = 0; i < execCtxs.size(); i++) {
+                PluginContext ctx(execCtxs[i], instance->creationParams, instance->pluginData, nullptr, instance->batchArenas[i].get());
+                ctx.setCreationIndex(&instance->creationIndex);
+                ctx.setCancelledFlag(&instance->cancelled);
+                ctx.setMetrics(&getContext().metrics);
+                ctx.setInputIndex(&getInputIndex(), &instance->inputBinding);
+                auto start = std::chrono::steady_clock::now();
+                auto result = PluginImpl::onEvaluate(ctx);
+                if (result) {
+                    result = ctx.flushText();
+                }
+                EvaluationMetrics::record(getContext().metrics.evaluate, start, std::chrono::steady_clock::now());
+                if (!result) {
+                    NVIGI_LOG_ERROR("Evaluation %zu of %zu in batch failed: %s", i + 1, execCtxs.size(), result.error().message.c_str());
+                    if (res == kResultOk) res = result.error().code;
+                }
+            }
+            return res;
+        }
+    }
+
+    // Runtime parameters recorded by 'EvaluationCaptureParameters', plugins can add their own flat structs
+    //
+    //   static std::span<const ai::CaptureStructDesc> getCapturedRuntimeParameters();
+    static std::span<const ai::CaptureStructDesc> getCapturedRuntimeParameters() {
+        static const std::vector<ai::CaptureStructDesc> s_structs = []() {
+            auto common = ai::getCommonCapturedRuntimeParameters();
+            std::vector<ai::CaptureStructDesc> structs(common.begin(), common.end());
+            if constexpr (requires { { PluginImpl::getCapturedRuntimeParameters() } -> std::convertible_to<std::span<const ai::CaptureStructDesc>>; }) {
+                auto custom = PluginImpl::getCapturedRuntimeParameters();
+                structs.insert(structs.end(), custom.begin(), custom.end());
+            }
+            return structs;
+        }();
+        return s_structs;
+    }
+
+    static const SlotSignatureIndex& getInputIndex() {
+        static SlotSignatureIndex s_index(PluginImpl::getPluginInputSignature());
+        return s_index;
+    }
+
     static PluginID getFeatureId(InferenceInstanceData* data) {
         return PluginImpl::getPluginID();
     }
@@ -728,17 +2657,38 @@ private:
         return &s_desc;
     }
 
+    // Cached per normalized parameters, host gets an immutable snapshot safe to read from any thread (see ai::CapsCache)
     static Result getCapsAndRequirements(NVIGIParameter** outInfo, const NVIGIParameter* params) {
+        if (!outInfo) return kResultInvalidParameter;
+        auto& cache = getContext().capsCache;
+
+        std::string key;
+        uint64_t stamp{};
+        bool cacheable = ai::getCapsCacheKey(params, key, stamp);
+        if (cacheable) {
+            if (auto snapshot = cache.find(key, stamp)) {
+                *outInfo = snapshot->caps;
+                return kResultOk;
+            }
+        }
+
+        std::scoped_lock lock(cache.queryMtx);
+        // Another thread could have populated it while we waited
+        if (cacheable) {
+            if (auto snapshot = cache.find(key, stamp)) {
+                *outInfo = snapshot->caps;
+                return kResultOk;
+            }
+        }
         auto result = PluginImpl::getPluginCapsAndRequirements(params);
         if (!result) {
             NVIGI_LOG_ERROR("getCapsAndRequirements failed: %s", result.error().message.c_str());
             return result.error().code;
         }
-
-        static CommonCapabilitiesAndRequirements s_caps;
-        s_caps = *result;
-        // CommonCapabilitiesAndRequirements inherits from NVIGIParameter via NVIGI_UID macro
-        *outInfo = s_caps;
+        // Uncacheable queries share one entry which is only replaced when the result differs
+        auto snapshot = cache.insert(key, stamp, *result);
+        // CommonCapabilitiesAndRequirements converts to NVIGIParameter via NVIGI_UID macro
+        *outInfo = snapshot->caps;
         return kResultOk;
     }
 
@@ -781,6 +2731,9 @@ private:
     // NOTE: Plugins needing input buffering (like ASR streaming) should buffer
     // BEFORE calling base evaluate, allowing rapid calls without data loss.
     //
+    // NOTE: Hosts can opt in to a bounded queue of pending execution contexts instead,
+    // see 'AsyncEvaluationParameters' and 'evaluateQueued' below.
+    //
     static Result evaluateInternal(InferenceExecutionContext* execCtx, bool async) {
         if (!execCtx) {
             NVIGI_LOG_ERROR("No execution context");
@@ -798,78 +2751,396 @@ private:
         }
 
         auto instance = static_cast<InstanceData*>(execCtx->instance->data);
+        touchInstanceVRAM(execCtx->instance);
+        // Time sliced evaluation is recorded once, replay runs it to completion in one call
+        if (instance->capture && (async || instance->suspendedCtx != execCtx)) {
+            instance->capture->record(async ? ai::CapturedCallKind::eEvaluateAsync : ai::CapturedCallKind::eEvaluate, &execCtx, 1);
+        }
 
         if (async) {
             // Async execution
-            if (!instance->job.valid()) {
-                // No job running, start a new one
-                instance->running.store(true);
-                instance->cancelled.store(false);  // Reset cancellation flag for new evaluation
-                instance->job = std::async(std::launch::async, createEvaluationJob(instance, execCtx));
+            if (instance->maxBatchSize && execCtx->callback) {
+                return enqueueBatched(instance, execCtx);
+            }
+            if (instance->queueDepth) {
+                return evaluateQueued(instance, execCtx);
+            }
+            // No job running or the previous one completed, start a new one
+            //
+            // IMPORTANT: We use a short timeout (10 microseconds) to avoid deadlock.
+            // The job might be blocked waiting for the host to consume polled results,
+            // so we must NOT block here waiting for the job to complete.
+            if (!instance->job.valid() || instance->job.wait_for(std::chrono::microseconds(10)) == std::future_status::ready) {
+                NVIGI_CHECK(startJob(instance, execCtx));
             }
             else {
-                // Job already running - check if it's done with a very short timeout
-                // IMPORTANT: We use a short timeout (10 microseconds) to avoid deadlock.
-                // The job might be blocked waiting for the host to consume polled results,
-                // so we must NOT block here waiting for the job to complete.
-                if (instance->job.wait_for(std::chrono::microseconds(10)) == std::future_status::ready) {
-                    // Job completed, get the result and check for errors
-                    if (NVIGI_FAILED(result, instance->job.get())) {
-                        NVIGI_LOG_ERROR("Previous async evaluation returned error: %u", result);
-                        return result;
-                    }
-
-                    // Start a new job
-                    instance->running.store(true);
-                    instance->cancelled.store(false);  // Reset cancellation flag for new evaluation
-                    instance->job = std::async(std::launch::async, createEvaluationJob(instance, execCtx));
-                }
-                else {
-                    // Job still running - return kResultNotReady
-                    //
-                    // This applies to BOTH callback and polled result modes:
-                    //
-                    // WITH callback (execCtx->callback != nullptr):
-                    //   - Job won't block, but we still can't accept new inputs
-                    //   - Returning kResultNotReady signals inputs would be lost
-                    //   - Host should wait for current job to complete
-                    //
-                    // WITHOUT callback (polled results):
-                    //   - Job may be blocked waiting for getResults()
-                    //   - CRITICAL: We cannot wait here or we'd cause deadlock
-                    //   - Host MUST consume results before calling evaluateAsync() again
-                    //
-                    // NOTE: Plugins with input buffering (like ASR streaming audio) can
-                    // buffer inputs BEFORE calling base evaluate to avoid this error.
-                    return kResultNotReady;
-                }
+                // Job still running - return kResultNotReady
+                //
+                // This applies to BOTH callback and polled result modes:
+                //
+                // WITH callback (execCtx->callback != nullptr):
+                //   - Job won't block, but we still can't accept new inputs
+                //   - Returning kResultNotReady signals inputs would be lost
+                //   - Host should wait for current job to complete
+                //
+                // WITHOUT callback (polled results):
+                //   - Job may be blocked waiting for getResults()
+                //   - CRITICAL: We cannot wait here or we'd cause deadlock
+                //   - Host MUST consume results before calling evaluateAsync() again
+                //
+                // NOTE: Plugins with input buffering (like ASR streaming audio) can
+                // buffer inputs BEFORE calling base evaluate to avoid this error.
+                return kResultNotReady;
             }
         }
         else {
             // Sync execution
             
             // First make sure any async jobs are done
-            if (instance->job.valid()) {
-                NVIGI_LOG_WARN("'evaluateAsync' task not finished, interrupting before running blocking 'evaluate' ...");
-                instance->running.store(false);
-                instance->job.get();
-            }
+            interruptAsyncJob(instance);
 
-            // Run synchronously
+            // Run synchronously, parameters and plugin data can only change under 'evalMtx' (see 'swapModel')
+            std::scoped_lock evalLock(instance->evalMtx);
             NVIGI_LOG_INFO("Creating PluginContext for sync eval, instance=%p, pluginData address=%p", 
                           instance, &instance->pluginData);
-            PluginContext ctx(execCtx, instance->creationParams, instance->pluginData, nullptr);
+            PluginContext ctx(execCtx, instance->creationParams, instance->pluginData, nullptr, &instance->arena);
+            ctx.setCreationIndex(&instance->creationIndex);
             NVIGI_LOG_INFO("PluginContext created, checking pluginData reference address=%p", 
                           &ctx.pluginData);
             ctx.setCancelledFlag(&instance->cancelled);
 
+            // Same execution context continues a time sliced evaluation, any other one starts over
+            bool resuming = instance->suspendedCtx == execCtx;
+            if (!resuming) {
+                abandonSuspended(instance);
+            }
+            instance->suspendedCtx = nullptr;
+            ctx.setTimeSlice(&instance->resumeState, resuming);
+            // Reported back for hosts checking the state after each call instead of in the callback
+            auto budget = findStruct<EvaluationBudgetParameters>(execCtx->runtimeParameters);
+            if (budget && budget->getVersion() >= kStructVersion2) {
+                budget->suspended = false;
+            }
+            else {
+                budget = nullptr;
+            }
+            auto& metrics = getContext().metrics;
+            ctx.setMetrics(&metrics);
+            ctx.setInputIndex(&getInputIndex(), &instance->inputBinding);
+            ctx.setTextStream(&instance->textStream);
+            auto start = std::chrono::steady_clock::now();
             auto result = PluginImpl::onEvaluate(ctx);
+            if (result) {
+                result = ctx.flushText();
+            }
+            EvaluationMetrics::record(metrics.evaluate, start, std::chrono::steady_clock::now());
             if (!result) {
+                instance->resumeState.reset();
                 NVIGI_LOG_ERROR("Evaluation failed: %s", result.error().message.c_str());
                 return result.error().code;
             }
+            if (budget) {
+                budget->suspended = ctx.isSuspended();
+            }
+            if (ctx.isSuspended()) {
+                instance->suspendedCtx = execCtx;
+                if (execCtx->callback) {
+                    execCtx->callback(execCtx, kInferenceExecutionStateSuspended, execCtx->callbackUserData);
+                }
+            }
+            else {
+                instance->resumeState.reset();
+            }
+        }
+
+        return kResultOk;
+    }
+
+    // Plugins can make swaps cheaper by implementing
+    // 'static Expected<void> onSwapModel(const NVIGIParameter* params, const std::any& current, std::any& next)',
+    // for example to keep the base weights and only load a new LoRA. 'current' is still used by evaluations so only
+    // immutable parts (weights) can be shared. Without it the new model is created with 'onCreateInstance'.
+    static constexpr bool hasSwapModel() {
+        return requires(const NVIGIParameter* params, const std::any& current, std::any& next) {
+            { PluginImpl::onSwapModel(params, current, next) } -> std::same_as<Expected<void>>;
+        };
+    }
+
+    static Result swapModelImpl(InferenceInstance* wrapper, const NVIGIParameter* params, PFun_nvigiModelSwapCallback* callback, void* userData) {
+        if (!wrapper || !wrapper->data || !findStruct<CommonCreationParameters>(params)) {
+            return kResultInvalidParameter;
+        }
+        auto instance = static_cast<InstanceData*>(wrapper->data);
+        std::scoped_lock lock(instance->swapMtx);
+        if (instance->swapJob.valid()) {
+            if (instance->swapJob.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                NVIGI_LOG_WARN("Model swap already in progress");
+                return kResultInvalidState;
+            }
+            instance->swapJob.get();
+        }
+        instance->swapJob = std::async(std::launch::async, [wrapper, instance, params, callback, userData]()->void {
+            auto result = runModelSwap(instance, params);
+            if (result == kResultOk) {
+                reserveInstanceVRAM(wrapper, params);
+            }
+            if (callback) {
+                callback(wrapper, result, userData);
+            }
+        });
+        return kResultOk;
+    }
+
+    // Loads the new model next to the current one and switches over between evaluations
+    static Result runModelSwap(InstanceData* instance, const NVIGIParameter* params) {
+        NVIGI_TRACE_SCOPE("swapModel", &getContext().feature);
+        auto start = std::chrono::steady_clock::now();
+        std::unique_ptr<CommonCreationParameters> tunedCommon;
+        auto effective = applyTunedProfile(tunedCommon, params);
+
+        // Batch scheduler and callers read the batching settings without 'evalMtx', they are fixed for the instance lifetime
+        auto common = findStruct<CommonCreationParameters>(effective);
+        uint32_t maxBatchSize = common->getVersion() >= kStructVersion3 ? common->maxBatchSize : 0;
+        auto batchWindow = std::chrono::microseconds(common->getVersion() >= kStructVersion3 ? common->batchWindowUs : 0);
+        if (maxBatchSize != instance->maxBatchSize || (maxBatchSize && batchWindow != instance->batchWindow)) {
+            NVIGI_LOG_ERROR("Model swap cannot change micro-batching (batch %u -> %u), create a new instance instead", instance->maxBatchSize, maxBatchSize);
+            return kResultInvalidParameter;
+        }
+        auto priorityClass = resolvePriorityClass(common);
+        auto cpuThreads = system::getCpuThreadAssignment(effective, (uint32_t)std::max(common->numThreads, 1));
+
+        std::any next;
+        Expected<void> created;
+        try {
+            if constexpr (hasSwapModel()) {
+                created = PluginImpl::onSwapModel(effective, instance->pluginData, next);
+            }
+            else {
+                created = PluginImpl::onCreateInstance(effective, next);
+            }
+        }
+        catch (std::exception& e) {
+            created = std::unexpected(Error{ kResultInvalidState, e.what() });
+        }
+        if (!created) {
+            NVIGI_LOG_ERROR("Model swap failed, keeping the current model: %s", created.error().message.c_str());
+            return created.error().code;
+        }
+        auto loaded = std::chrono::steady_clock::now();
+
+        {
+            // Evaluation in flight finishes on the current model, everything started after this uses the new one
+            std::scoped_lock evalLock(instance->evalMtx);
+            std::scoped_lock dataLock(instance->pluginDataMtx);
+            abandonSuspended(instance);
+            instance->textStream.clear();
+            std::swap(instance->pluginData, next);
+            instance->tunedCommon = std::move(tunedCommon);
+            instance->creationParams = effective;
+            buildCreationIndex(instance);
+            instance->priorityClass = priorityClass;
+            instance->cpuThreads = cpuThreads;
+            if (instance->poolKey) {
+                instance->poolKey = getPoolKey(params);
+            }
         }
+        auto switched = std::chrono::steady_clock::now();
 
+        // Previous model is released outside of the lock so evaluations are not held up
+        auto destroyResult = PluginImpl::onDestroyInstance(next);
+        if (!destroyResult) {
+            NVIGI_LOG_ERROR("onDestroyInstance failed for the previous model: %s", destroyResult.error().message.c_str());
+        }
+        NVIGI_LOG_INFO("Model swapped - loaded in %.2fms, switched in %.2fms", std::chrono::duration<double, std::milli>(loaded - start).count(),
+            std::chrono::duration<double, std::milli>(switched - loaded).count());
+        return kResultOk;
+    }
+
+    static void waitForModelSwap(InstanceData* instance) {
+        std::scoped_lock lock(instance->swapMtx);
+        if (instance->swapJob.valid()) {
+            instance->swapJob.get();
+        }
+    }
+
+    // Suspended time sliced evaluation will not be continued, caller holds 'evalMtx'
+    static void abandonSuspended(InstanceData* instance) {
+        if (instance->suspendedCtx) {
+            NVIGI_LOG_VERBOSE("Suspended evaluation abandoned");
+            instance->suspendedCtx = nullptr;
+        }
+        instance->resumeState.reset();
+    }
+
+    static void interruptAsyncJob(InstanceData* instance) {
+        if (instance->job.valid()) {
+            NVIGI_LOG_WARN("'evaluateAsync' task not finished, interrupting before running blocking evaluation ...");
+            instance->running.store(false);
+            instance->job.get();
+        }
+    }
+
+    static Result evaluateBatchImpl(InferenceExecutionContext** execCtxs, size_t count) {
+        if (!execCtxs || !count || !execCtxs[0] || !execCtxs[0]->instance) {
+            NVIGI_LOG_ERROR("No execution contexts");
+            return kResultInvalidParameter;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (!execCtxs[i] || execCtxs[i]->instance != execCtxs[0]->instance) {
+                NVIGI_LOG_ERROR("Execution context %zu is missing or does not use the same inference instance", i);
+                return kResultInvalidParameter;
+            }
+            if (!execCtxs[i]->callback) {
+                NVIGI_LOG_ERROR("Callback not provided for execution context %zu in batch", i);
+                return kResultInvalidParameter;
+            }
+        }
+
+        auto instance = static_cast<InstanceData*>(execCtxs[0]->instance->data);
+        touchInstanceVRAM(execCtxs[0]->instance);
+        if (instance->capture) {
+            instance->capture->record(ai::CapturedCallKind::eEvaluateBatch, execCtxs, count);
+        }
+        interruptAsyncJob(instance);
+        return runBatch(instance, std::span<InferenceExecutionContext*>(execCtxs, count));
+    }
+
+    // Micro-batching (opt-in via 'CommonCreationParameters::maxBatchSize')
+    //
+    // Callers on any thread only enqueue, the scheduler thread coalesces requests and dispatches them to runBatch()
+    static Result enqueueBatched(InstanceData* instance, InferenceExecutionContext* execCtx) {
+        {
+            std::scoped_lock lock(instance->batchMtx);
+            if (!instance->batchThread.joinable()) {
+                instance->batchExit = false;
+                instance->batchThread = std::thread(batchSchedulerLoop, instance);
+            }
+            instance->batchQueue.push_back({ execCtx, std::chrono::steady_clock::now() });
+        }
+        instance->batchCV.notify_one();
+        return kResultOk;
+    }
+
+    static void batchSchedulerLoop(InstanceData* instance) {
+        std::vector<InferenceExecutionContext*> batch;
+        std::unique_lock lock(instance->batchMtx);
+        while (true) {
+            instance->batchCV.wait(lock, [instance]() { return instance->batchExit || !instance->batchQueue.empty(); });
+            if (instance->batchExit) {
+                break;
+            }
+
+            // Window starts with the oldest request so no request waits longer than the window (plus one evaluation)
+            auto deadline = instance->batchQueue.front().enqueued + instance->batchWindow;
+            thread::waitUntil(instance->batchCV, lock, deadline, [instance]() {
+                return instance->batchExit || instance->batchQueue.size() >= instance->maxBatchSize;
+            });
+            if (instance->batchExit) {
+                break;
+            }
+
+            auto count = std::min<size_t>(instance->batchQueue.size(), instance->maxBatchSize);
+            auto now = std::chrono::steady_clock::now();
+            batch.clear();
+            for (size_t i = 0; i < count; i++) {
+                auto& request = instance->batchQueue[i];
+                EvaluationMetrics::record(getContext().metrics.queueWait, request.enqueued, now);
+                if (auto stats = findStruct<EvaluationQueueStats>(request.execCtx->runtimeParameters)) {
+                    stats->queueWaitUs = std::chrono::duration_cast<std::chrono::microseconds>(now - request.enqueued).count();
+                    stats->batchSize = uint32_t(count);
+                }
+                batch.push_back(request.execCtx);
+            }
+            instance->batchQueue.erase(instance->batchQueue.begin(), instance->batchQueue.begin() + count);
+            lock.unlock();
+
+            // Errors are reported per context by the plugin, nobody is waiting for the batch result
+            NVIGI_LOG_VERBOSE("Dispatching batch of %zu execution context(s)", count);
+            if (NVIGI_FAILED(result, runBatch(instance, std::span<InferenceExecutionContext*>(batch)))) {
+                NVIGI_LOG_ERROR("Batched async evaluation returned error: %u", result);
+            }
+            lock.lock();
+        }
+
+        // Requests which never made it into a batch are reported as cancelled
+        std::deque<InferenceExecutionContext*> dropped;
+        for (auto& request : instance->batchQueue) {
+            dropped.push_back(request.execCtx);
+        }
+        instance->batchQueue.clear();
+        lock.unlock();
+        dropPending(dropped);
+    }
+
+    static void stopBatchScheduler(InstanceData* instance) {
+        {
+            std::scoped_lock lock(instance->batchMtx);
+            if (!instance->batchThread.joinable()) {
+                return;
+            }
+            instance->batchExit = true;
+        }
+        instance->batchCV.notify_one();
+        instance->batchThread.join();
+    }
+
+    // Async evaluation with a bounded input queue (opt-in via 'AsyncEvaluationParameters')
+    //
+    // Busy instance queues the execution context instead of returning kResultNotReady, the running job
+    // drains the queue back-to-back so the model stays busy without host side retry loops.
+    static Result evaluateQueued(InstanceData* instance, InferenceExecutionContext* execCtx) {
+        std::deque<InferenceExecutionContext*> dropped;
+        {
+            std::unique_lock lock(instance->mtx);
+            if (instance->active) {
+                auto policy = instance->overflowPolicy;
+                if (policy == EvaluationQueueOverflowPolicy::eBlock && !execCtx->callback) {
+                    // Host must poll to make room, blocking here would deadlock
+                    policy = EvaluationQueueOverflowPolicy::eReject;
+                }
+                if (instance->pending.size() >= instance->queueDepth) {
+                    if (policy == EvaluationQueueOverflowPolicy::eReject) {
+                        return kResultNotReady;
+                    }
+                    else if (policy == EvaluationQueueOverflowPolicy::eDropOldest) {
+                        dropped.push_back(instance->pending.front().execCtx);
+                        instance->pending.pop_front();
+                    }
+                    else {
+                        instance->pendingCV.wait(lock, [instance]() { return !instance->active || instance->pending.size() < instance->queueDepth; });
+                    }
+                }
+                if (instance->active) {
+                    instance->pending.push_back({ execCtx, std::chrono::steady_clock::now() });
+                    lock.unlock();
+                    dropPending(dropped);
+                    return kResultOk;
+                }
+            }
+            // Idle or the job just found the queue empty, start a new job
+        }
+
+        // Job is done or about to return, we never wait on an evaluation here
+        return startJob(instance, execCtx, true);
+    }
+
+    // Collects the result of the previous async job (which must be done or about to return) and launches a new one
+    //
+    // 'queued' marks the bounded input queue active so new execution contexts get queued behind this one.
+    static Result startJob(InstanceData* instance, InferenceExecutionContext* execCtx, bool queued = false) {
+        if (instance->job.valid()) {
+            if (NVIGI_FAILED(result, instance->job.get())) {
+                NVIGI_LOG_ERROR("Previous async evaluation returned error: %u", result);
+                return result;
+            }
+        }
+        if (queued) {
+            std::scoped_lock lock(instance->mtx);
+            instance->active = true;
+        }
+        instance->running.store(true);
+        instance->cancelled.store(false);  // Reset cancellation flag for new evaluation
+        instance->job = launchJob(instance, execCtx);
         return kResultOk;
     }
 
@@ -884,7 +3155,7 @@ private:
             auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
             while (std::chrono::steady_clock::now() < timeout) {
                 // Release any pending results to unblock the background thread
-                if (instance->pollCtx.checkResultPending()) {
+                while (instance->pollCtx.checkResultPending()) {
                     instance->pollCtx.releaseResults(kInferenceExecutionStateDone);
                 }
 
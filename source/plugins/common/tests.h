@@ -0,0 +1,592 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <map>
+
+#include "source/plugins/common/plugin_base_ai.hpp"
+
+//! Unit tests for the building blocks shared by all modern plugins, see plugin_base_ai.hpp
+//!
+namespace nvigi
+{
+
+namespace plugin::modern
+{
+
+TEST_CASE("modern::ExecutorResultRing release and waitIdle", "[plugin_base]") {
+    auto callback = [](const InferenceExecutionContext*, InferenceExecutionState state, void* userData) -> InferenceExecutionState {
+        static_cast<std::atomic<uint32_t>*>(userData)->fetch_add(1);
+        return state;
+    };
+
+    SECTION("acquire blocks while all entries are in flight") {
+        ExecutorResultRing ring;
+        ring.resize(2);
+        auto& first = ring.acquire();
+        auto& second = ring.acquire();
+        REQUIRE(&first != &second);
+
+        std::atomic<bool> acquired{};
+        std::thread waiter([&ring, &acquired]() {
+            auto& entry = ring.acquire();
+            acquired.store(true);
+            ring.release(entry);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        REQUIRE(!acquired.load());
+        ring.release(first);
+        waiter.join();
+        REQUIRE(acquired.load());
+        ring.release(second);
+        ring.waitIdle();
+    }
+
+    SECTION("ring can be destroyed as soon as waitIdle returns") {
+        // Host executor threads release entries while the owner tears the ring down, any access after
+        // waitIdle returned would be a use after free
+        for (int i = 0; i < 200; i++) {
+            std::atomic<uint32_t> executed{};
+            auto ring = std::make_unique<ExecutorResultRing>();
+            ring->resize(4);
+            std::vector<std::thread> executors;
+            for (int j = 0; j < 4; j++) {
+                auto& entry = ring->acquire();
+                entry.execCtx.callback = callback;
+                entry.execCtx.callbackUserData = &executed;
+                executors.emplace_back(&ExecutorResultRing::execute, &entry);
+            }
+            ring->waitIdle();
+            REQUIRE(executed.load() == 4);
+            ring.reset();
+            for (auto& executor : executors) executor.join();
+        }
+    }
+}
+
+TEST_CASE("modern::SlotBinding sees data attached after binding", "[plugin_base]") {
+    std::vector<InferenceDataDescriptor> signature = { { "system", InferenceDataText::s_type, true }, { "user", InferenceDataText::s_type, false } };
+    SlotSignatureIndex index(signature);
+    auto user = index.find("user");
+    REQUIRE(user.has_value());
+
+    // Host reuses the same array and only fills in the data later
+    InferenceDataText text{};
+    std::vector<InferenceDataSlot> slots = { { "user", nullptr } };
+    InferenceDataSlotArray inputs(slots.size(), slots.data());
+    SlotBinding binding;
+    binding.bind(index, &inputs);
+    REQUIRE(binding.get<InferenceDataText>(*user) == nullptr);
+
+    slots[0].data = text;
+    binding.bind(index, &inputs);
+    REQUIRE(binding.get<InferenceDataText>(*user) == &text);
+    REQUIRE(binding.get<InferenceDataText>(*index.find("system")) == nullptr);
+}
+
+//! Plugin doing nothing, tests derive from it and replace the hooks they exercise through the public ModernPluginBase API
+struct MinimalTestPlugin {
+    static PluginID getPluginID() { return { {0x6f1d2b7a, 0x3c4e, 0x4b19, {0x9a, 0x52, 0x1e, 0x7c, 0x0d, 0x83, 0x46, 0xb5}}, 0x4f2a1c }; }
+    static plugin::PluginInfo getPluginInfo() { return {}; }
+    static std::span<const InferenceDataDescriptor> getPluginInputSignature() { return {}; }
+    static std::span<const InferenceDataDescriptor> getPluginOutputSignature() { return {}; }
+    static Expected<CommonCapabilitiesAndRequirements> getPluginCapsAndRequirements(const NVIGIParameter*) { return CommonCapabilitiesAndRequirements{}; }
+    static Result onPluginRegister(framework::IFramework*) { return kResultOk; }
+    static Result onPluginDeregister() { return kResultOk; }
+    static Expected<void> onCreateInstance(const NVIGIParameter*, std::any&) { return {}; }
+    static Expected<void> onDestroyInstance(std::any&) { return {}; }
+    static Expected<void> onEvaluate(PluginContext&) { return {}; }
+    static Expected<void> onCancel(PluginContext&) { return {}; }
+};
+
+//! Each evaluation runs 'kTestWorkItems' work items and keeps its position in the resume state when time sliced
+struct TimeSlicedTestPlugin : MinimalTestPlugin {
+    static constexpr uint32_t kTestWorkItems = 5;
+    static inline uint32_t s_workItems = 0;
+    static inline uint32_t s_completed = 0;
+
+    static Expected<void> onEvaluate(PluginContext& ctx) {
+        auto& state = ctx.getResumeState();
+        if (!ctx.isResuming()) {
+            state = uint32_t(0);
+        }
+        auto& step = std::any_cast<uint32_t&>(state);
+        while (step < kTestWorkItems) {
+            step++;
+            s_workItems++;
+            if (step < kTestWorkItems && ctx.shouldSuspend()) {
+                return {};
+            }
+        }
+        s_completed++;
+        return {};
+    }
+};
+
+TEST_CASE("modern::ModernPluginBase time sliced evaluation", "[plugin_base]") {
+    using Base = ModernPluginBase<TimeSlicedTestPlugin, InferenceInterface>;
+    auto callback = [](const InferenceExecutionContext*, InferenceExecutionState state, void* userData) -> InferenceExecutionState {
+        static_cast<std::vector<InferenceExecutionState>*>(userData)->push_back(state);
+        return state;
+    };
+
+    CommonCreationParameters common{};
+    InferenceInstance* instance{};
+    REQUIRE(Base::createInstance(common, &instance) == kResultOk);
+    REQUIRE(instance != nullptr);
+    TimeSlicedTestPlugin::s_workItems = 0;
+    TimeSlicedTestPlugin::s_completed = 0;
+
+    EvaluationBudgetParameters budget{};
+    budget.maxWorkItems = 2;
+    std::vector<InferenceExecutionState> states;
+    InferenceExecutionContext execCtx{};
+    execCtx.instance = instance;
+    execCtx.runtimeParameters = budget;
+    execCtx.callback = callback;
+    execCtx.callbackUserData = &states;
+
+    SECTION("shouldSuspend stops each call after the budget and resume continues") {
+        REQUIRE(Base::evaluate(&execCtx) == kResultOk);
+        REQUIRE(TimeSlicedTestPlugin::s_workItems == 2);
+        REQUIRE(budget.suspended);
+        REQUIRE(states == std::vector<InferenceExecutionState>{ kInferenceExecutionStateSuspended });
+
+        REQUIRE(Base::evaluate(&execCtx) == kResultOk);
+        REQUIRE(TimeSlicedTestPlugin::s_workItems == 4);
+        REQUIRE(budget.suspended);
+
+        REQUIRE(Base::evaluate(&execCtx) == kResultOk);
+        REQUIRE(TimeSlicedTestPlugin::s_workItems == TimeSlicedTestPlugin::kTestWorkItems);
+        REQUIRE(TimeSlicedTestPlugin::s_completed == 1);
+        REQUIRE(!budget.suspended);
+        REQUIRE(states.size() == 2);
+    }
+
+    SECTION("suspended state is visible without a callback state check") {
+        // Host polling 'suspended' instead of tracking states in the callback
+        execCtx.callback = [](const InferenceExecutionContext*, InferenceExecutionState state, void*) { return state; };
+        uint32_t calls = 0;
+        do {
+            REQUIRE(Base::evaluate(&execCtx) == kResultOk);
+            calls++;
+        } while (budget.suspended && calls < 10);
+        REQUIRE(calls == 3);
+        REQUIRE(TimeSlicedTestPlugin::s_completed == 1);
+    }
+
+    SECTION("other execution context abandons the suspended evaluation") {
+        REQUIRE(Base::evaluate(&execCtx) == kResultOk);
+        REQUIRE(budget.suspended);
+
+        InferenceExecutionContext other = execCtx;
+        EvaluationBudgetParameters otherBudget{};
+        other.runtimeParameters = otherBudget;
+        REQUIRE(Base::evaluate(&other) == kResultOk);
+        REQUIRE(TimeSlicedTestPlugin::s_completed == 1);
+
+        // Starts over rather than resuming
+        REQUIRE(Base::evaluate(&execCtx) == kResultOk);
+        REQUIRE(TimeSlicedTestPlugin::s_workItems == 2 + TimeSlicedTestPlugin::kTestWorkItems + 2);
+        REQUIRE(budget.suspended);
+    }
+
+    SECTION("cancel drops the suspended evaluation") {
+        REQUIRE(Base::evaluate(&execCtx) == kResultOk);
+        REQUIRE(budget.suspended);
+        REQUIRE(Base::cancelAsyncEvaluation(&execCtx) == kResultOk);
+        REQUIRE(states == std::vector<InferenceExecutionState>{ kInferenceExecutionStateSuspended, kInferenceExecutionStateCancel });
+
+        // Nothing left to resume, the next call starts over
+        REQUIRE(Base::evaluate(&execCtx) == kResultOk);
+        REQUIRE(TimeSlicedTestPlugin::s_workItems == 4);
+        REQUIRE(TimeSlicedTestPlugin::s_completed == 0);
+    }
+
+    REQUIRE(Base::destroyInstance(instance) == kResultOk);
+}
+
+
+//! Records the creation parameters the plugin sees, see 'applyTunedProfile'
+struct TunedTestPlugin : MinimalTestPlugin {
+    static inline CommonCreationParameters s_created{};
+
+    static Expected<void> onCreateInstance(const NVIGIParameter* params, std::any&) {
+        auto common = findStruct<CommonCreationParameters>(params);
+        s_created.numThreads = common->numThreads;
+        s_created.maxBatchSize = common->maxBatchSize;
+        s_created.batchWindowUs = common->batchWindowUs;
+        return {};
+    }
+};
+
+TEST_CASE("modern::ModernPluginBase applies tuned profiles", "[plugin_base]") {
+    using Base = ModernPluginBase<TunedTestPlugin, InferenceInterface>;
+    // Normally set on registration, the profile is keyed by it
+    Base::getContext().feature = TunedTestPlugin::getPluginID();
+
+    const char* modelGUID = "{5C0A3E1B-7D24-4F86-A9B3-2E6D1C8F0A47}";
+    auto path = (fs::temp_directory_path() / "nvigi.test.tuned.json").string();
+    {
+        auto isystem = system::getInterface();
+        ai::TuningProfile profile{};
+        profile.backend = extra::guidToString(TunedTestPlugin::getPluginID().id);
+        profile.numThreads = 6;
+        profile.maxBatchSize = 4;
+        profile.batchWindowUs = 500;
+        ai::TuningProfileStore store;
+        REQUIRE(store.load(path) == kResultOk);
+        store.store(ai::getMachineKey(isystem ? isystem->getSystemCaps() : nullptr), modelGUID, profile);
+        REQUIRE(store.save() == kResultOk);
+    }
+
+    CommonCreationParameters common{};
+    common.modelGUID = modelGUID;
+    common.numThreads = 2;
+    common.maxBatchSize = 0;
+    common.batchWindowUs = 0;
+    TunedExecutionParameters tuned{};
+    tuned.utf8PathToProfiles = path.c_str();
+    REQUIRE(common.chain(tuned) == kResultOk);
+
+    auto create = [&common]() {
+        TunedTestPlugin::s_created = {};
+        InferenceInstance* instance{};
+        REQUIRE(Base::createInstance(common, &instance) == kResultOk);
+        REQUIRE(Base::destroyInstance(instance) == kResultOk);
+    };
+
+    SECTION("profile replaces the host's settings") {
+        create();
+        REQUIRE(TunedTestPlugin::s_created.numThreads == 6);
+        REQUIRE(TunedTestPlugin::s_created.maxBatchSize == 4);
+        REQUIRE(TunedTestPlugin::s_created.batchWindowUs == 500);
+        // Host's struct is never modified
+        REQUIRE(common.numThreads == 2);
+    }
+
+    SECTION("host overrides keep the host's settings") {
+        tuned.hostOverrides = kTunedSettingNumThreads;
+        create();
+        REQUIRE(TunedTestPlugin::s_created.numThreads == 2);
+        REQUIRE(TunedTestPlugin::s_created.maxBatchSize == 4);
+
+        tuned.hostOverrides = kTunedSettingBatching;
+        create();
+        REQUIRE(TunedTestPlugin::s_created.numThreads == 6);
+        REQUIRE(TunedTestPlugin::s_created.maxBatchSize == 0);
+        REQUIRE(TunedTestPlugin::s_created.batchWindowUs == 0);
+    }
+
+    SECTION("unknown model is created as requested") {
+        common.modelGUID = "{00000000-0000-0000-0000-000000000000}";
+        create();
+        REQUIRE(TunedTestPlugin::s_created.numThreads == 2);
+        REQUIRE(TunedTestPlugin::s_created.maxBatchSize == 0);
+    }
+
+    fs::remove(path);
+}
+
+//! Model is the GUID the plugin was created with, loads and evaluations can be held to control what overlaps with a swap
+struct SwapTestPlugin : MinimalTestPlugin {
+    static constexpr const char* kBrokenModel = "{BADBADBA-DBAD-BADB-ADBA-DBADBADBADBA}";
+    static inline std::mutex s_mtx;
+    static inline std::condition_variable s_cv;
+    static inline bool s_holdLoad = false;
+    static inline bool s_holdEvaluate = false;
+    static inline bool s_evaluating = false;
+    static inline uint32_t s_loads = 0;
+    static inline uint32_t s_destroyed = 0;
+    static inline uint32_t s_evaluations = 0;
+    static inline std::string s_evaluatedModel;
+    static inline InferencePriorityClass s_priorityClass{};
+    static inline uint32_t s_threadCount = 0;
+
+    static void reset() {
+        std::scoped_lock lock(s_mtx);
+        s_holdLoad = s_holdEvaluate = s_evaluating = false;
+        s_loads = s_destroyed = s_evaluations = s_threadCount = 0;
+        s_evaluatedModel.clear();
+        s_priorityClass = {};
+    }
+    static void set(bool& flag, bool value) {
+        std::scoped_lock lock(s_mtx);
+        flag = value;
+        s_cv.notify_all();
+    }
+    template<typename Pred>
+    static bool waitFor(Pred pred) {
+        std::unique_lock lock(s_mtx);
+        return s_cv.wait_for(lock, std::chrono::seconds(5), pred);
+    }
+
+    static Expected<void> onCreateInstance(const NVIGIParameter* params, std::any& pluginData) {
+        auto common = findStruct<CommonCreationParameters>(params);
+        std::unique_lock lock(s_mtx);
+        s_loads++;
+        s_cv.notify_all();
+        s_cv.wait(lock, []() { return !s_holdLoad; });
+        if (std::string(common->modelGUID) == kBrokenModel) {
+            return std::unexpected(Error{ kResultItemNotFound, "Broken model" });
+        }
+        pluginData = std::string(common->modelGUID);
+        return {};
+    }
+    static Expected<void> onDestroyInstance(std::any&) {
+        std::scoped_lock lock(s_mtx);
+        s_destroyed++;
+        return {};
+    }
+    static Expected<void> onEvaluate(PluginContext& ctx) {
+        std::unique_lock lock(s_mtx);
+        s_evaluating = true;
+        s_evaluatedModel = std::any_cast<std::string>(ctx.pluginData);
+        s_priorityClass = ctx.getPriorityClass();
+        s_threadCount = ctx.getCpuThreadAssignment().threadCount;
+        s_cv.notify_all();
+        s_cv.wait(lock, []() { return !s_holdEvaluate; });
+        s_evaluating = false;
+        s_evaluations++;
+        s_cv.notify_all();
+        return {};
+    }
+};
+
+TEST_CASE("modern::ModernPluginBase model swap", "[plugin_base]") {
+    using Base = ModernPluginBase<SwapTestPlugin, InferenceInterface>;
+    using Plugin = SwapTestPlugin;
+    struct SwapOutcome {
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::optional<Result> result;
+        Result wait() {
+            std::unique_lock lock(mtx);
+            cv.wait_for(lock, std::chrono::seconds(5), [this]() { return result.has_value(); });
+            return result.value_or(kResultTimedOut);
+        }
+        bool done() {
+            std::scoped_lock lock(mtx);
+            return result.has_value();
+        }
+    } outcome;
+    auto swapCallback = [](InferenceInstance*, Result result, void* userData) {
+        auto outcome = static_cast<SwapOutcome*>(userData);
+        std::scoped_lock lock(outcome->mtx);
+        outcome->result = result;
+        outcome->cv.notify_all();
+    };
+
+    Plugin::reset();
+    CommonCreationParameters first{};
+    first.modelGUID = "{11111111-1111-1111-1111-111111111111}";
+    first.numThreads = 2;
+    InferenceInstance* instance{};
+    REQUIRE(Base::createInstance(first, &instance) == kResultOk);
+
+    CommonCreationParameters second{};
+    second.modelGUID = "{22222222-2222-2222-2222-222222222222}";
+    second.numThreads = 3;
+    second.priorityClass = InferencePriorityClass::eBackground;
+
+    InferenceExecutionContext execCtx{};
+    execCtx.instance = instance;
+    execCtx.callback = [](const InferenceExecutionContext*, InferenceExecutionState state, void*) { return state; };
+
+    SECTION("evaluation in flight finishes on the current model") {
+        Plugin::set(Plugin::s_holdEvaluate, true);
+        Result evaluated = kResultInvalidState;
+        std::thread evaluation([&execCtx, &evaluated]() { evaluated = Base::evaluate(&execCtx); });
+        REQUIRE(Plugin::waitFor([]() { return Plugin::s_evaluating; }));
+
+        // New model loads next to the running evaluation, the switch waits for it
+        REQUIRE(Base::swapModel(instance, second, swapCallback, &outcome) == kResultOk);
+        REQUIRE(Plugin::waitFor([]() { return Plugin::s_loads == 2; }));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        REQUIRE(!outcome.done());
+
+        Plugin::set(Plugin::s_holdEvaluate, false);
+        evaluation.join();
+        REQUIRE(evaluated == kResultOk);
+        REQUIRE(Plugin::s_evaluatedModel == first.modelGUID);
+        REQUIRE(outcome.wait() == kResultOk);
+        REQUIRE(Plugin::s_destroyed == 1);
+
+        REQUIRE(Base::evaluate(&execCtx) == kResultOk);
+        REQUIRE(Plugin::s_evaluatedModel == second.modelGUID);
+    }
+
+    SECTION("failed load keeps the current model") {
+        CommonCreationParameters broken = second;
+        broken.modelGUID = Plugin::kBrokenModel;
+        REQUIRE(Base::swapModel(instance, broken, swapCallback, &outcome) == kResultOk);
+        REQUIRE(outcome.wait() == kResultItemNotFound);
+        REQUIRE(Plugin::s_destroyed == 0);
+
+        REQUIRE(Base::evaluate(&execCtx) == kResultOk);
+        REQUIRE(Plugin::s_evaluatedModel == first.modelGUID);
+    }
+
+    SECTION("micro-batching settings cannot change") {
+        CommonCreationParameters batched = second;
+        batched.maxBatchSize = 4;
+        REQUIRE(Base::swapModel(instance, batched, swapCallback, &outcome) == kResultOk);
+        REQUIRE(outcome.wait() == kResultInvalidParameter);
+        REQUIRE(Plugin::s_loads == 1);
+    }
+
+    SECTION("priority class and CPU threads follow the new model") {
+        REQUIRE(Base::swapModel(instance, second, swapCallback, &outcome) == kResultOk);
+        REQUIRE(outcome.wait() == kResultOk);
+
+        // Async evaluations run with the instance's scheduling settings
+        REQUIRE(Base::evaluateAsync(&execCtx) == kResultOk);
+        REQUIRE(Plugin::waitFor([]() { return Plugin::s_evaluations == 1; }));
+        REQUIRE(Plugin::s_evaluatedModel == second.modelGUID);
+        REQUIRE(Plugin::s_priorityClass == InferencePriorityClass::eBackground);
+        REQUIRE(Plugin::s_threadCount == 3);
+    }
+
+    SECTION("destroy waits for the swap") {
+        Plugin::set(Plugin::s_holdLoad, true);
+        REQUIRE(Base::swapModel(instance, second, swapCallback, &outcome) == kResultOk);
+        REQUIRE(Plugin::waitFor([]() { return Plugin::s_loads == 2; }));
+
+        std::atomic<bool> destroyed{};
+        std::thread destroyer([instance, &destroyed]() {
+            Base::destroyInstance(instance);
+            destroyed.store(true);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        REQUIRE(!destroyed.load());
+
+        Plugin::set(Plugin::s_holdLoad, false);
+        destroyer.join();
+        REQUIRE(outcome.done());
+        REQUIRE(outcome.wait() == kResultOk);
+        // Previous model released by the swap, the new one by destroy
+        REQUIRE(Plugin::s_destroyed == 2);
+        instance = nullptr;
+    }
+
+    if (instance) {
+        REQUIRE(Base::destroyInstance(instance) == kResultOk);
+    }
+}
+
+//! Reports a VRAM budget for its only model and supports pooling so idle instances can be evicted
+struct VRAMTestPlugin : MinimalTestPlugin {
+    static constexpr const char* kModel = "{5E2C7A1D-8B34-4F6A-9C21-7D0E4B3A6F19}";
+    static constexpr size_t kModelMB = 512;
+    static inline uint32_t s_destroyed = 0;
+
+    static Expected<CommonCapabilitiesAndRequirements> getPluginCapsAndRequirements(const NVIGIParameter*) {
+        static const char* s_guids[] = { kModel };
+        static const size_t s_budgets[] = { kModelMB };
+        CommonCapabilitiesAndRequirements caps{};
+        caps.numSupportedModels = 1;
+        caps.supportedModelGUIDs = s_guids;
+        caps.modelMemoryBudgetMB = s_budgets;
+        return caps;
+    }
+    static Expected<void> onReset(std::any&) { return {}; }
+    static Expected<void> onDestroyInstance(std::any&) {
+        s_destroyed++;
+        return {};
+    }
+};
+
+//! Stands in for the VRAM manager in 'ISystem', records what the plugin base declares
+struct TestVRAMManager {
+    struct Reservation {
+        size_t sizeMB{};
+        system::PFun_VRAMPressureCallback* callback{};
+        uint64_t lastUse{};
+    };
+    static inline std::map<void*, Reservation> s_reservations;
+    static inline uint64_t s_useCounter = 0;
+
+    static Result reserveVRAM(uint32_t, const PluginID&, void* instance, size_t sizeMB, system::PFun_VRAMPressureCallback* callback, void*) {
+        s_reservations[instance] = { sizeMB, callback, ++s_useCounter };
+        return kResultOk;
+    }
+    static Result releaseVRAM(void* instance) {
+        return s_reservations.erase(instance) ? kResultOk : kResultItemNotFound;
+    }
+    static Result touchVRAMReservation(void* instance) {
+        auto it = s_reservations.find(instance);
+        if (it == s_reservations.end()) return kResultItemNotFound;
+        it->second.lastUse = ++s_useCounter;
+        return kResultOk;
+    }
+    static Result resolveCpuThreadBudget(const CpuThreadBudget*, uint32_t requestedThreads, system::CpuThreadAssignment* assignment) {
+        *assignment = {};
+        assignment->threadCount = requestedThreads;
+        return kResultOk;
+    }
+};
+
+TEST_CASE("modern::ModernPluginBase reserves VRAM and evicts idle instances", "[plugin_base]") {
+    using Base = ModernPluginBase<VRAMTestPlugin, InferenceInterface>;
+    Base::getContext().feature = VRAMTestPlugin::getPluginID();
+    auto& reservations = TestVRAMManager::s_reservations;
+    reservations.clear();
+    VRAMTestPlugin::s_destroyed = 0;
+
+    system::ISystem isystem{};
+    isystem.reserveVRAM = TestVRAMManager::reserveVRAM;
+    isystem.releaseVRAM = TestVRAMManager::releaseVRAM;
+    isystem.touchVRAMReservation = TestVRAMManager::touchVRAMReservation;
+    isystem.resolveCpuThreadBudget = TestVRAMManager::resolveCpuThreadBudget;
+    auto previous = nvigi::params.isystem;
+    nvigi::params.isystem = &isystem;
+
+    CommonCreationParameters common{};
+    common.modelGUID = VRAMTestPlugin::kModel;
+    common.numThreads = 1;
+    InferenceInstance* first{};
+    InferenceInstance* second{};
+    REQUIRE(Base::acquireInstance(common, &first) == kResultOk);
+    REQUIRE(Base::acquireInstance(common, &second) == kResultOk);
+
+    // Model budget is reserved on creation, instances in use are never offered for eviction
+    REQUIRE(reservations.size() == 2);
+    REQUIRE(reservations[first].sizeMB == VRAMTestPlugin::kModelMB);
+    REQUIRE(reservations[first].callback == nullptr);
+
+    // Evaluation marks the instance as recently used
+    InferenceExecutionContext execCtx{};
+    execCtx.instance = first;
+    execCtx.callback = [](const InferenceExecutionContext*, InferenceExecutionState state, void*) { return state; };
+    REQUIRE(Base::evaluate(&execCtx) == kResultOk);
+    REQUIRE(reservations[first].lastUse > reservations[second].lastUse);
+
+    // Pooled idle instances can be evicted
+    REQUIRE(Base::releaseInstance(first) == kResultOk);
+    REQUIRE(Base::releaseInstance(second) == kResultOk);
+    auto evict = reservations[first].callback;
+    REQUIRE(evict != nullptr);
+    REQUIRE(reservations[second].callback == evict);
+
+    // VRAM manager under pressure, evicted instance is destroyed and leaves the pool
+    REQUIRE(evict(0, 256, first, nullptr) == VRAMTestPlugin::kModelMB);
+    REQUIRE(VRAMTestPlugin::s_destroyed == 1);
+    REQUIRE(!reservations.contains(first));
+
+    InferenceInstance* reused{};
+    REQUIRE(Base::acquireInstance(common, &reused) == kResultOk);
+    REQUIRE(reused == second);
+    REQUIRE(reservations[second].callback == nullptr);
+    // Acquired while the VRAM manager was about to ask, nothing to give back
+    REQUIRE(evict(0, 256, second, nullptr) == 0);
+    REQUIRE(VRAMTestPlugin::s_destroyed == 1);
+
+    REQUIRE(Base::destroyInstance(reused) == kResultOk);
+    REQUIRE(reservations.empty());
+    nvigi::params.isystem = previous;
+}
+}
+
+}
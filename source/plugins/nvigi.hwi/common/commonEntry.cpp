@@ -12,6 +12,13 @@
 
 #include "nvigi_hwi_common.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace nvigi
 {
 namespace hwiCommon
@@ -31,18 +38,86 @@ namespace hwiCommon
         };
 
         IHWICommon api{};
-        uint32_t globalSchedulingMode = kDefaultSchedulingMode;
+        std::atomic<uint32_t> globalSchedulingMode = kDefaultSchedulingMode;
+
+        struct ModeChangedCallback
+        {
+            PFun_nvigiSchedulingModeChangedCallback* callback{};
+            void* userData{};
+        };
+        std::mutex callbackMutex;
+        std::vector<ModeChangedCallback> callbacks;
+        //! Held while callbacks run so unregistering can wait for them, lock order is dispatch then callback mutex
+        std::mutex dispatchMutex;
+        std::atomic<std::thread::id> dispatchThread{};
+
+        struct AdaptiveController
+        {
+            bool enabled{};
+            AdaptiveSchedulingSettings settings{};
+            float averageFrameTimeMs{};
+            uint32_t candidateMode = kDefaultSchedulingMode;
+            uint32_t candidateSamples{};
+            std::chrono::steady_clock::time_point lastSwitch{};
+        };
+        std::mutex controllerMutex;
+        AdaptiveController controller;
     };
 };
 
 NVIGI_PLUGIN_DEFINE("nvigi.plugin.hwi.common", Version(VERSION_MAJOR, VERSION_MINOR, VERSION_PATCH), Version(API_MAJOR, API_MINOR, API_PATCH), hwiCommon, CommonContext)
 
+//! Must be called with 'controllerMutex' held so an explicit mode cannot be overwritten by a stale adaptive decision,
+//! the lock is released once the dispatch is claimed so callbacks run without it but still observe modes in order
+static void commonApplySchedulingMode(uint32_t schedulingMode, std::unique_lock<std::mutex>& controllerLock)
+{
+    auto& ctx = (*hwiCommon::getContext());
+
+    if (ctx.globalSchedulingMode.exchange(schedulingMode) == schedulingMode)
+        return;
+
+    std::scoped_lock dispatchLock(ctx.dispatchMutex);
+    controllerLock.unlock();
+    ctx.dispatchThread = std::this_thread::get_id();
+
+    // Copy so callbacks can run without holding the lock and (un)register from within the callback
+    std::vector<hwiCommon::CommonContext::ModeChangedCallback> callbacks;
+    {
+        std::scoped_lock lock(ctx.callbackMutex);
+        callbacks = ctx.callbacks;
+    }
+    for (auto& cb : callbacks)
+    {
+        {
+            // Skip anything unregistered by an earlier callback in this dispatch
+            std::scoped_lock lock(ctx.callbackMutex);
+            auto it = std::find_if(ctx.callbacks.begin(), ctx.callbacks.end(), [&cb](const hwiCommon::CommonContext::ModeChangedCallback& other)
+                {
+                    return other.callback == cb.callback && other.userData == cb.userData;
+                });
+            if (it == ctx.callbacks.end())
+                continue;
+        }
+        cb.callback(schedulingMode, cb.userData);
+    }
+    ctx.dispatchThread = std::thread::id{};
+}
+
 // Typically called by the user
 static nvigi::Result commonSetGpuInferenceSchedulingMode(uint32_t schedulingMode)
 {
+    if (schedulingMode >= SchedulingMode::kNumOptions)
+        return nvigi::kResultInvalidParameter;
+
     auto& ctx = (*hwiCommon::getContext());
+    std::unique_lock lock(ctx.controllerMutex);
+    if (ctx.controller.enabled)
+    {
+        NVIGI_LOG_INFO("Scheduling mode set explicitly, adaptive scheduling disabled");
+        ctx.controller.enabled = false;
+    }
 
-    ctx.globalSchedulingMode = schedulingMode;
+    commonApplySchedulingMode(schedulingMode, lock);
     return nvigi::kResultOk;
 }
 
@@ -58,6 +133,131 @@ static nvigi::Result commonGetGpuInferenceSchedulingMode(uint32_t* schedulingMod
     return nvigi::kResultOk;
 }
 
+static nvigi::Result commonRegisterSchedulingModeChangedCallback(PFun_nvigiSchedulingModeChangedCallback* callback, void* userData)
+{
+    if (callback == nullptr)
+        return nvigi::kResultInvalidParameter;
+
+    auto& ctx = (*hwiCommon::getContext());
+    std::scoped_lock lock(ctx.callbackMutex);
+    ctx.callbacks.push_back({ callback, userData });
+
+    return nvigi::kResultOk;
+}
+
+static nvigi::Result commonUnregisterSchedulingModeChangedCallback(PFun_nvigiSchedulingModeChangedCallback* callback, void* userData)
+{
+    auto& ctx = (*hwiCommon::getContext());
+    {
+        std::scoped_lock lock(ctx.callbackMutex);
+        auto it = std::find_if(ctx.callbacks.begin(), ctx.callbacks.end(), [callback, userData](const hwiCommon::CommonContext::ModeChangedCallback& cb)
+            {
+                return cb.callback == callback && cb.userData == userData;
+            });
+        if (it == ctx.callbacks.end())
+            return nvigi::kResultItemNotFound;
+
+        ctx.callbacks.erase(it);
+    }
+
+    // Wait for a dispatch on another thread which might still be running the callback, when called from
+    // within the callback the dispatch already skips it from now on
+    if (ctx.dispatchThread != std::this_thread::get_id())
+    {
+        std::scoped_lock dispatchLock(ctx.dispatchMutex);
+    }
+    return nvigi::kResultOk;
+}
+
+static nvigi::Result commonEnableAdaptiveScheduling(const AdaptiveSchedulingSettings* settings)
+{
+    auto& ctx = (*hwiCommon::getContext());
+    std::scoped_lock lock(ctx.controllerMutex);
+
+    auto& controller = ctx.controller;
+    if (!settings)
+    {
+        controller.enabled = false;
+        return nvigi::kResultOk;
+    }
+    if (settings->frameBudgetMs <= 0.0f || settings->smoothing <= 0.0f || settings->smoothing > 1.0f ||
+        settings->computeRatio > settings->releaseRatio || settings->releaseRatio > settings->throttleRatio)
+    {
+        NVIGI_LOG_ERROR("Invalid adaptive scheduling settings, ratios must satisfy compute <= release <= throttle");
+        return nvigi::kResultInvalidParameter;
+    }
+
+    controller.enabled = true;
+    controller.settings = *settings;
+    controller.averageFrameTimeMs = 0.0f;
+    controller.candidateMode = ctx.globalSchedulingMode;
+    controller.candidateSamples = 0;
+    controller.lastSwitch = {};
+    NVIGI_LOG_INFO("Adaptive scheduling enabled, frame budget %.2fms", settings->frameBudgetMs);
+    return nvigi::kResultOk;
+}
+
+static nvigi::Result commonReportSchedulingSample(float frameTimeMs, uint32_t inferenceQueueDepth)
+{
+    if (frameTimeMs < 0.0f)
+        return nvigi::kResultInvalidParameter;
+
+    auto& ctx = (*hwiCommon::getContext());
+    std::unique_lock lock(ctx.controllerMutex);
+    auto& controller = ctx.controller;
+    if (!controller.enabled)
+        return nvigi::kResultInvalidState;
+
+    auto& settings = controller.settings;
+    const uint32_t currentMode = ctx.globalSchedulingMode;
+
+    // Target mode for this sample, anything between the release and the throttle threshold keeps the current mode
+    uint32_t target = currentMode;
+    if (frameTimeMs == 0.0f)
+    {
+        // Nothing to protect, drop the history so we start fresh once frames are back
+        controller.averageFrameTimeMs = 0.0f;
+        target = SchedulingMode::kPrioritizeCompute;
+    }
+    else
+    {
+        controller.averageFrameTimeMs = controller.averageFrameTimeMs == 0.0f ? frameTimeMs :
+            controller.averageFrameTimeMs + settings.smoothing * (frameTimeMs - controller.averageFrameTimeMs);
+        const float ratio = controller.averageFrameTimeMs / settings.frameBudgetMs;
+        if (ratio > settings.throttleRatio)
+            target = SchedulingMode::kPrioritizeGraphics;
+        else if (ratio < settings.computeRatio || (ratio < settings.releaseRatio && inferenceQueueDepth >= settings.queueDepthForCompute))
+            target = SchedulingMode::kPrioritizeCompute;
+        else if (ratio < settings.releaseRatio)
+            target = SchedulingMode::kBalance;
+    }
+
+    if (target == currentMode)
+    {
+        controller.candidateSamples = 0;
+        return nvigi::kResultOk;
+    }
+    if (target != controller.candidateMode)
+    {
+        controller.candidateMode = target;
+        controller.candidateSamples = 0;
+    }
+    controller.candidateSamples++;
+
+    // Higher mode is more graphics friendly, protecting the frame reacts faster than giving GPU back to inference
+    const uint32_t required = target > currentMode ? settings.samplesToThrottle : settings.samplesToRelease;
+    const auto now = std::chrono::steady_clock::now();
+    if (controller.candidateSamples < required || now - controller.lastSwitch < std::chrono::milliseconds(settings.minHoldMs))
+        return nvigi::kResultOk;
+
+    controller.candidateSamples = 0;
+    controller.lastSwitch = now;
+    NVIGI_LOG_VERBOSE("Adaptive scheduling switching mode %u -> %u (average frame %.2fms, queue depth %u)", currentMode, target, controller.averageFrameTimeMs, inferenceQueueDepth);
+
+    commonApplySchedulingMode(target, lock);
+    return nvigi::kResultOk;
+}
+
 //! Making sure our implementation is covered with our exception handler
 //! 
 namespace hwiCommon
@@ -71,6 +271,26 @@ namespace hwiCommon
     {
         NVIGI_CATCH_EXCEPTION(commonGetGpuInferenceSchedulingMode(schedulingMode));
     }
+
+    static nvigi::Result RegisterSchedulingModeChangedCallback(PFun_nvigiSchedulingModeChangedCallback* callback, void* userData)
+    {
+        NVIGI_CATCH_EXCEPTION(commonRegisterSchedulingModeChangedCallback(callback, userData));
+    }
+
+    static nvigi::Result UnregisterSchedulingModeChangedCallback(PFun_nvigiSchedulingModeChangedCallback* callback, void* userData)
+    {
+        NVIGI_CATCH_EXCEPTION(commonUnregisterSchedulingModeChangedCallback(callback, userData));
+    }
+
+    static nvigi::Result EnableAdaptiveScheduling(const AdaptiveSchedulingSettings* settings)
+    {
+        NVIGI_CATCH_EXCEPTION(commonEnableAdaptiveScheduling(settings));
+    }
+
+    static nvigi::Result ReportSchedulingSample(float frameTimeMs, uint32_t inferenceQueueDepth)
+    {
+        NVIGI_CATCH_EXCEPTION(commonReportSchedulingSample(frameTimeMs, inferenceQueueDepth));
+    }
 } // namespace hwiCommon
 
 //! Main entry point - get information about our plugin
@@ -109,6 +329,10 @@ Result nvigiPluginRegister(framework::IFramework* framework)
 
     ctx.api.SetGpuInferenceSchedulingMode = hwiCommon::SetGpuInferenceSchedulingMode;
     ctx.api.GetGpuInferenceSchedulingMode = hwiCommon::GetGpuInferenceSchedulingMode;
+    ctx.api.RegisterSchedulingModeChangedCallback = hwiCommon::RegisterSchedulingModeChangedCallback;
+    ctx.api.UnregisterSchedulingModeChangedCallback = hwiCommon::UnregisterSchedulingModeChangedCallback;
+    ctx.api.EnableAdaptiveScheduling = hwiCommon::EnableAdaptiveScheduling;
+    ctx.api.ReportSchedulingSample = hwiCommon::ReportSchedulingSample;
 
     framework->addInterface(plugin::hwi::common::kId, &ctx.api, 0);
     
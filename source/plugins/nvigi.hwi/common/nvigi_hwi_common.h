@@ -15,16 +15,75 @@ namespace plugin::hwi::common
     constexpr PluginID kId = { {0x3126c2d9, 0xfc19, 0x4b27,{0xb8, 0xdf, 0x85, 0xbe, 0x10, 0x45, 0x0a, 0x39}}, 0x19148c }; //{3126C2D9-FC19-4B27-B8DF-85BE10450A39} [nvigi.plugin.hwi.common]
 }
 
+//! Called on the thread which changed the mode, must not call back into IHWICommon
+using PFun_nvigiSchedulingModeChangedCallback = void(uint32_t schedulingMode, void* userData);
+
+//! Adaptive scheduling controller settings, see 'EnableAdaptiveScheduling'
+//!
+//! {D84254F9-6621-42A4-88CA-05314FB86B02}
+struct alignas(8) AdaptiveSchedulingSettings
+{
+    AdaptiveSchedulingSettings() { };
+    NVIGI_UID(UID({ 0xd84254f9, 0x6621, 0x42a4,{ 0x88, 0xca, 0x05, 0x31, 0x4f, 0xb8, 0x6b, 0x02 } }), kStructVersion1)
+
+    //! Frame time the game targets
+    float frameBudgetMs = 16.6f;
+    //! Smoothing factor for the frame time moving average, higher reacts faster
+    float smoothing = 0.2f;
+    //! Smoothed frame time above 'frameBudgetMs * throttleRatio' switches to SchedulingMode::kPrioritizeGraphics
+    float throttleRatio = 1.0f;
+    //! Smoothed frame time below 'frameBudgetMs * releaseRatio' allows going back to SchedulingMode::kBalance
+    float releaseRatio = 0.85f;
+    //! Smoothed frame time below 'frameBudgetMs * computeRatio', or at least 'queueDepthForCompute' pending inference
+    //! requests while under 'releaseRatio', switches to SchedulingMode::kPrioritizeCompute
+    float computeRatio = 0.5f;
+    uint32_t queueDepthForCompute = 4;
+    //! Hysteresis, number of consecutive samples asking for a more graphics friendly mode before switching
+    uint32_t samplesToThrottle = 3;
+    //! Hysteresis, number of consecutive samples asking for a more compute friendly mode before switching
+    uint32_t samplesToRelease = 30;
+    //! Minimum time between two switches
+    uint32_t minHoldMs = 250;
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(AdaptiveSchedulingSettings)
+
 //! Interface 'IHWICommon'
 //!
 //! {425CE80B-397A-4FA3-B5BC-C6D17EEB5A26}
 struct alignas(8) IHWICommon
 {
     IHWICommon() { };
-    NVIGI_UID(UID({ 0x425ce80b, 0x397a, 0x4fa3,{0xb5, 0xbc, 0xc6, 0xd1, 0x7e, 0xeb, 0x5a, 0x26} }), kStructVersion1)
+    NVIGI_UID(UID({ 0x425ce80b, 0x397a, 0x4fa3,{0xb5, 0xbc, 0xc6, 0xd1, 0x7e, 0xeb, 0x5a, 0x26} }), kStructVersion3)
 
+    //! NOTE: Setting the mode explicitly disables the adaptive controller
     nvigi::Result(*SetGpuInferenceSchedulingMode)(uint32_t schedulingMode);
     nvigi::Result(*GetGpuInferenceSchedulingMode)(uint32_t* schedulingMode);
+
+    //! v2
+    //! 
+    //! Typically used by other hwi plugins to re-apply the mode to already created queues/streams
+    //! Callback is triggered only when the mode actually changes
+    nvigi::Result(*RegisterSchedulingModeChangedCallback)(PFun_nvigiSchedulingModeChangedCallback* callback, void* userData);
+    //! Blocks until any in-flight invocation of the callback on another thread has returned, once this returns the
+    //! callback is never invoked again so 'userData' can be released.
+    //!
+    //! NOTE: Do not call while holding a lock the callback acquires, calling from within the callback itself is fine
+    nvigi::Result(*UnregisterSchedulingModeChangedCallback)(PFun_nvigiSchedulingModeChangedCallback* callback, void* userData);
+
+    //! v3
+    //! 
+    //! Closed loop controller, the scheduling mode follows the frame time and the inference queue depth reported by the host.
+    //! Mode changes propagate the same way as 'SetGpuInferenceSchedulingMode' does (next D3D12 command list, CUDA streams, pooled streams immediately).
+    //! Pass nullptr to disable, the current mode is kept.
+    nvigi::Result(*EnableAdaptiveScheduling)(const AdaptiveSchedulingSettings* settings);
+    //! Typically called once per frame by the host, 'frameTimeMs' of 0 means there is no frame to protect (menus, loading screens)
+    //! 'inferenceQueueDepth' is the number of inference requests the host has pending
+    nvigi::Result(*ReportSchedulingSample)(float frameTimeMs, uint32_t inferenceQueueDepth);
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
 };
 
 NVIGI_VALIDATE_STRUCT(IHWICommon)
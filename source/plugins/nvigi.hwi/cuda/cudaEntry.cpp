@@ -9,14 +9,27 @@
 #include "source/core/nvigi.file/file.h"
 #include "source/core/nvigi.exception/exception.h"
 #include "source/core/nvigi.plugin/plugin.h"
+#include "source/core/nvigi.metrics/metrics.h"
 #include "source/plugins/nvigi.hwi/cuda/versions.h"
 #include "source/plugins/nvigi.hwi/common/nvigi_hwi_common.h"
 #include "_artifacts/gitVersion.h"
 #include "cig_scheduler_settings.h"
 
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
 #include <cuda.h>
 #include <cuda_runtime.h>
 
+#ifdef NVIGI_WINDOWS
+#define VK_USE_PLATFORM_WIN32_KHR
+#endif
+#include <vulkan/vulkan.h>
+
+#include "source/utils/nvigi.hwi/gpu_timing.h"
+
 #include "cuda_scg.h"
 #include "nvigi_hwi_cuda.h"
 
@@ -25,6 +38,10 @@ namespace nvigi
 
 namespace hwiCuda
 {
+//! Pinned blocks are power of two sizes starting at 64KB, 32 classes cover anything a plugin would upload
+constexpr size_t kPinnedMinBlockSize = 64 * 1024;
+constexpr uint32_t kPinnedSizeClasses = 32;
+
 struct CudaContext
 {
     NVIGI_PLUGIN_CONTEXT_CREATE_DESTROY(CudaContext);
@@ -45,9 +62,97 @@ struct CudaContext
         int64_t refcount{};
     };
 
+    // Contexts are requested from plugin createInstance calls which can run on any thread
+    std::mutex contextMutex;
     std::map<ID3D12CommandQueue*, CudaContextInfo> contextMap;
     std::map<VkQueue, CudaContextInfo> contextMapVulkan;
 
+    // CudaSharedContextPolicy::kPerDevice, queue owning the context which is shared by all queues on the device
+    uint32_t contextPolicy = CudaSharedContextPolicy::kPerQueue;
+    std::map<ID3D12Device*, ID3D12CommandQueue*> deviceContexts;
+    std::map<VkDevice, VkQueue> deviceContextsVulkan;
+
+    struct CudaGraphInfo
+    {
+        CUgraphExec exec{};
+        uint64_t updates{};
+    };
+
+    // Graphs are launched from plugin evaluation threads hence the lock
+    std::mutex graphMutex;
+    std::map<CUcontext, std::map<uint64_t, CudaGraphInfo>> graphs;
+
+    struct CudaStreamPool
+    {
+        std::vector<CUstream> available[CudaStreamClass::kNumOptions];
+        // All streams owned by the pool and their class
+        std::map<CUstream, uint32_t> streams;
+    };
+
+    std::mutex streamMutex;
+    std::map<CUcontext, CudaStreamPool> streamPools;
+
+    struct CudaEventPair
+    {
+        CUevent start{};
+        CUevent end{};
+    };
+    struct CudaGpuTiming
+    {
+        CUcontext ctx{};
+        unsigned long long ctxId{};
+        CudaEventPair events{};
+    };
+
+    // Event pairs are recycled per context, keyed by the context ID since host contexts can be recreated at the same address
+    std::mutex timingMutex;
+    std::map<unsigned long long, std::vector<CudaEventPair>> timingEvents;
+    std::map<uint32_t, CudaGpuTiming> timings;
+    uint32_t nextTimingToken{};
+    gpu_timing::Resolver timingResolver;
+
+    struct VulkanMemoryInfo
+    {
+        CUcontext ctx{};
+        CUexternalMemory memory{};
+    };
+    struct VulkanSemaphoreInfo
+    {
+        CUcontext ctx{};
+        CUexternalSemaphore semaphore{};
+    };
+
+    std::mutex interopMutex;
+    std::map<CUdeviceptr, VulkanMemoryInfo> vulkanMemory;
+    std::map<VkSemaphore, VulkanSemaphoreInfo> vulkanSemaphores;
+
+    struct PinnedBlock
+    {
+        CUcontext ctx{};
+        size_t size{};
+        uint32_t sizeClass{};
+        // Handed out and not released yet
+        bool inUse{};
+    };
+    struct PinnedPending
+    {
+        void* ptr{};
+        CUevent event{};
+    };
+    struct PinnedPool
+    {
+        std::vector<void*> available[kPinnedSizeClasses];
+        // Released with a stream, recycled once the event completes
+        std::vector<PinnedPending> pending;
+        std::vector<CUevent> events;
+    };
+
+    // Staged copies return blocks from CUDA host callbacks, never call into CUDA while holding this lock if it can synchronize
+    std::mutex pinnedMutex;
+    std::map<CUcontext, PinnedPool> pinnedPools;
+    // All blocks by address so interior pointers (e.g. offset into a host buffer) are recognized as pinned
+    std::map<uintptr_t, PinnedBlock> pinnedBlocks;
+
     IHWICommon* hwiCommon;
 
     CigSchedulerSettingsAPI sched;
@@ -63,13 +168,215 @@ struct CudaContext
 //! IMPORTANT: Make sure to place this macro right after the context declaration and always within the 'nvigi' namespace ONLY.
 NVIGI_PLUGIN_DEFINE("nvigi.plugin.hwi.cuda", Version(VERSION_MAJOR, VERSION_MINOR, VERSION_PATCH), Version(API_MAJOR, API_MINOR, API_PATCH), hwiCuda, CudaContext)
 
-static nvigi::Result cudaGetSharedContextForQueue(const nvigi::D3D12Parameters& params, CUcontext* cuCtx)
+static nvigi::Result cudaLogError(CUresult result, const char* what)
+{
+    const char* name = nullptr;
+    const char* msg = nullptr;
+    cuGetErrorName(result, &name);
+    cuGetErrorString(result, &msg);
+    if (!name) name = "Unknown";
+    if (!msg)  msg = "Unknown";
+    NVIGI_LOG_ERROR("%s failed - CUDA error: %s - %s", what, name, msg);
+    return kResultInvalidState;
+}
+
+//! Must be called with stream mutex locked and the context current
+static CUresult cudaTagPooledStream(CUstream stream, uint32_t streamClass, uint32_t schedulingMode)
+{
+    auto& ctx = (*hwiCuda::getContext());
+    // Class is the lower bound, both share the order of CigWorkloadType
+    return ctx.sched.StreamSetWorkloadType(stream, CigWorkloadType(std::max(streamClass, schedulingMode)));
+}
+
+//! Must be called with stream mutex locked
+static void cudaDestroyStreams(CUcontext cuCtx)
+{
+    auto& ctx = (*hwiCuda::getContext());
+    auto pool = ctx.streamPools.find(cuCtx);
+    if (pool == ctx.streamPools.end()) return;
+
+    size_t available = 0;
+    for (auto& streams : pool->second.available) available += streams.size();
+    if (available != pool->second.streams.size())
+    {
+        NVIGI_LOG_WARN("Destroying %zu pooled CUDA stream(s) which were never released", pool->second.streams.size() - available);
+    }
+    for (auto& [stream, streamClass] : pool->second.streams)
+    {
+        cuStreamDestroy(stream);
+    }
+    ctx.streamPools.erase(pool);
+}
+
+//! Unique for the lifetime of the process unlike the context handle, 0 if not available
+static unsigned long long cudaGetContextId(CUcontext cuCtx)
+{
+    unsigned long long id{};
+    return cuCtxGetId(cuCtx, &id) == CUDA_SUCCESS ? id : 0;
+}
+
+//! Pending timings on the context are dropped, must be called before the context is destroyed
+static void cudaAbortTimings(CUcontext cuCtx)
+{
+    auto& ctx = (*hwiCuda::getContext());
+    auto ctxId = cudaGetContextId(cuCtx);
+    ctx.timingResolver.abort([ctxId](const gpu_timing::Resolver::Tag& tag) { return tag.contextId == ctxId; });
+}
+
+//! Must be called with timing mutex locked
+static void cudaDestroyTimingEvents(unsigned long long ctxId)
+{
+    auto& ctx = (*hwiCuda::getContext());
+    auto pool = ctx.timingEvents.find(ctxId);
+    if (pool == ctx.timingEvents.end()) return;
+    for (auto& events : pool->second)
+    {
+        cuEventDestroy(events.start);
+        cuEventDestroy(events.end);
+    }
+    ctx.timingEvents.erase(pool);
+}
+
+//! Must be called with interop mutex locked and the context current
+static void cudaDestroyVulkanInterop(CUcontext cuCtx)
+{
+    auto& ctx = (*hwiCuda::getContext());
+    for (auto it = ctx.vulkanMemory.begin(); it != ctx.vulkanMemory.end();)
+    {
+        if (cuCtx && it->second.ctx != cuCtx) { it++; continue; }
+        cuMemFree(it->first);
+        cuDestroyExternalMemory(it->second.memory);
+        it = ctx.vulkanMemory.erase(it);
+    }
+    for (auto it = ctx.vulkanSemaphores.begin(); it != ctx.vulkanSemaphores.end();)
+    {
+        if (cuCtx && it->second.ctx != cuCtx) { it++; continue; }
+        cuDestroyExternalSemaphore(it->second.semaphore);
+        it = ctx.vulkanSemaphores.erase(it);
+    }
+}
+
+//! Takes the pinned mutex itself, blocks are freed outside of it since cuMemFreeHost synchronizes and staged copies
+//! return blocks from CUDA host callbacks. Some context must be current, contexts can be gone on shutdown and errors are ignored.
+static void cudaDestroyPinnedMemory(CUcontext cuCtx)
+{
+    auto& ctx = (*hwiCuda::getContext());
+    std::vector<void*> blocks;
+    std::vector<CUevent> events;
+    size_t inUse = 0;
+    {
+        std::scoped_lock lock(ctx.pinnedMutex);
+        for (auto it = ctx.pinnedPools.begin(); it != ctx.pinnedPools.end();)
+        {
+            if (cuCtx && it->first != cuCtx) { it++; continue; }
+            for (auto& pending : it->second.pending) events.push_back(pending.event);
+            events.insert(events.end(), it->second.events.begin(), it->second.events.end());
+            it = ctx.pinnedPools.erase(it);
+        }
+        for (auto it = ctx.pinnedBlocks.begin(); it != ctx.pinnedBlocks.end();)
+        {
+            if (cuCtx && it->second.ctx != cuCtx) { it++; continue; }
+            if (it->second.inUse) inUse++;
+            blocks.push_back((void*)it->first);
+            it = ctx.pinnedBlocks.erase(it);
+        }
+    }
+    if (inUse)
+    {
+        NVIGI_LOG_WARN("Destroying %zu pinned memory block(s) which were never released", inUse);
+    }
+    for (auto event : events) cuEventDestroy(event);
+    for (auto block : blocks) cuMemFreeHost(block);
+}
+
+//! Triggered by hwi.common on the thread changing the mode
+static void cudaOnSchedulingModeChanged(uint32_t schedulingMode, void* userData)
+{
+    (void)userData;
+    auto& ctx = (*hwiCuda::getContext());
+
+    std::scoped_lock lock(ctx.streamMutex);
+    for (auto& [cuCtx, pool] : ctx.streamPools)
+    {
+        if (cuCtxPushCurrent(cuCtx) != CUDA_SUCCESS) continue;
+        for (auto& [stream, streamClass] : pool.streams)
+        {
+            cudaTagPooledStream(stream, streamClass, schedulingMode);
+        }
+        CUcontext dummy;
+        cuCtxPopCurrent(&dummy);
+    }
+    NVIGI_LOG_VERBOSE("Scheduling mode changed to %u, re-tagged pooled CUDA streams", schedulingMode);
+}
+
+//! Must be called with graph mutex locked
+static void cudaDestroyGraphs(CUcontext cuCtx, uint64_t graphKey)
+{
+    auto& ctx = (*hwiCuda::getContext());
+    auto graphs = ctx.graphs.find(cuCtx);
+    if (graphs == ctx.graphs.end()) return;
+
+    for (auto it = graphs->second.begin(); it != graphs->second.end();)
+    {
+        if (graphKey == kCudaGraphKeyAll || it->first == graphKey)
+        {
+            NVIGI_LOG_VERBOSE("Releasing CUDA graph 0x%llx (%llu update(s))", it->first, it->second.updates);
+            if (it->second.exec) cuGraphExecDestroy(it->second.exec);
+            it = graphs->second.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+    if (graphs->second.empty())
+    {
+        ctx.graphs.erase(graphs);
+    }
+}
+
+//! CiG context creation is expensive (tens of ms or more) so it is always reported
+//! 
+//! 'creationTimeUs' accumulates time spent including failed attempts, histogram only sees contexts which were actually created
+template<typename Create>
+static nvigi::Result cudaCreateSharedContextTimed(const char* api, const void* queue, uint64_t& creationTimeUs, Create&& create)
+{
+    auto start = std::chrono::steady_clock::now();
+    nvigi::Result res = create();
+    auto us = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    creationTimeUs += us;
+    if (res == kResultOk)
+    {
+        if (auto histogram = metrics::getHistogram(plugin::hwi::cuda::kId, "cig_context_create_us")) histogram->record(us);
+        NVIGI_LOG_INFO("Created shared CUDA context for %s queue 0x%llx in %.2fms", api, (uint64_t)queue, us / 1000.0);
+    }
+    return res;
+}
+
+static nvigi::Result cudaGetSharedContextForQueueImpl(const nvigi::D3D12Parameters& params, CUcontext* cuCtx, uint64_t* creationTimeUs)
 {
     auto& ctx = (*hwiCuda::getContext());
 
     if (cuCtx == nullptr || params.device == nullptr || params.queue == nullptr)
         return nvigi::kResultInvalidParameter;
 
+    uint64_t timeUs = 0;
+    if (creationTimeUs) *creationTimeUs = 0;
+
+    std::scoped_lock lock(ctx.contextMutex);
+
+    if (ctx.contextPolicy == CudaSharedContextPolicy::kPerDevice)
+    {
+        auto owner = ctx.deviceContexts.find(params.device);
+        if (owner != ctx.deviceContexts.end())
+        {
+            hwiCuda::CudaContext::CudaContextInfo& ctxInfo = ctx.contextMap[owner->second];
+            ctxInfo.refcount++;
+            *cuCtx = ctxInfo.ctx;
+            return kResultOk;
+        }
+    }
+
     //! IMPORTANT: With CiG sometimes we can fail to create context with a direct (graphics) queue hence we need to try with the async compute one
     //!
     //! Logic:
@@ -78,7 +385,7 @@ static nvigi::Result cudaGetSharedContextForQueue(const nvigi::D3D12Parameters&
     //! * If direct fails then async compute queue becomes a mandatory parameter
     //! * If both queues fail then we have a problem but ideally that should never happen
     //! 
-    auto creaateSharedContext = [&ctx](const D3D12Parameters& params, ID3D12CommandQueue** actualQueueUsed) -> nvigi::Result
+    auto creaateSharedContext = [&ctx, &timeUs](const D3D12Parameters& params, ID3D12CommandQueue** actualQueueUsed) -> nvigi::Result
         {
             CUcontext cuCtx{};
             *actualQueueUsed = params.queue;
@@ -86,7 +393,7 @@ static nvigi::Result cudaGetSharedContextForQueue(const nvigi::D3D12Parameters&
             if (!ctx.contextMap.contains(params.queue))
             {
                 // Not cached, create one
-                if (NVIGI_FAILED(res, nvigi::cudaScg::CreateSharedCUDAContext(params.device, params.queue, cuCtx)))
+                if (NVIGI_FAILED(res, cudaCreateSharedContextTimed("D3D12", params.queue, timeUs, [&]() { return nvigi::cudaScg::CreateSharedCUDAContext(params.device, params.queue, cuCtx); })))
                 {
                     // Failed with direct queue, let's try async compute, it becomes a mandatory parameter now
                     if (!params.queueCompute)
@@ -98,7 +405,7 @@ static nvigi::Result cudaGetSharedContextForQueue(const nvigi::D3D12Parameters&
                     if (!ctx.contextMap.contains(params.queueCompute))
                     {
                         // Not cached, create one
-                        if (NVIGI_FAILED(res, nvigi::cudaScg::CreateSharedCUDAContext(params.device, params.queueCompute, cuCtx)))
+                        if (NVIGI_FAILED(res, cudaCreateSharedContextTimed("D3D12", params.queueCompute, timeUs, [&]() { return nvigi::cudaScg::CreateSharedCUDAContext(params.device, params.queueCompute, cuCtx); })))
                         {
                             return res;
                         }
@@ -123,9 +430,15 @@ static nvigi::Result cudaGetSharedContextForQueue(const nvigi::D3D12Parameters&
         return res;
     }
 
+    if (ctx.contextPolicy == CudaSharedContextPolicy::kPerDevice)
+    {
+        ctx.deviceContexts[params.device] = actualQueueUsed;
+    }
+
     hwiCuda::CudaContext::CudaContextInfo& ctxInfo = ctx.contextMap[actualQueueUsed];
     ctxInfo.refcount++;
     *cuCtx = ctxInfo.ctx;
+    if (creationTimeUs) *creationTimeUs = timeUs;
 
     return kResultOk;
 }
@@ -134,6 +447,8 @@ static nvigi::Result cudaReleaseSharedContext(CUcontext cuCtx)
 {
     auto& ctx = (*hwiCuda::getContext());
 
+    std::scoped_lock contextLock(ctx.contextMutex);
+
     // Check D3D12 context map first
     for (auto& [queue, queueInfo] : ctx.contextMap)
     {
@@ -142,9 +457,40 @@ static nvigi::Result cudaReleaseSharedContext(CUcontext cuCtx)
             queueInfo.refcount--;
             if (queueInfo.refcount <= 0)
             {
+                {
+                    std::scoped_lock lock(ctx.graphMutex);
+                    cudaDestroyGraphs(cuCtx, kCudaGraphKeyAll);
+                }
+                {
+                    std::scoped_lock lock(ctx.streamMutex);
+                    cudaDestroyStreams(cuCtx);
+                }
+                // Resolver thread must be done with the context before it goes away
+                cudaAbortTimings(cuCtx);
+                {
+                    std::scoped_lock lock(ctx.timingMutex);
+                    cudaDestroyTimingEvents(cudaGetContextId(cuCtx));
+                }
+                {
+                    std::scoped_lock lock(ctx.interopMutex);
+                    if (cuCtxPushCurrent(cuCtx) == CUDA_SUCCESS)
+                    {
+                        cudaDestroyVulkanInterop(cuCtx);
+                        CUcontext dummy;
+                        cuCtxPopCurrent(&dummy);
+                    }
+                }
+                if (cuCtxPushCurrent(cuCtx) == CUDA_SUCCESS)
+                {
+                    cudaDestroyPinnedMemory(cuCtx);
+                    CUcontext dummy;
+                    cuCtxPopCurrent(&dummy);
+                }
                 cuCtxDestroy(cuCtx);
 
-                ctx.contextMap.erase(queue);
+                auto owner = queue;
+                std::erase_if(ctx.deviceContexts, [owner](const auto& entry) { return entry.second == owner; });
+                ctx.contextMap.erase(owner);
             }
             return kResultOk;
         }
@@ -158,9 +504,40 @@ static nvigi::Result cudaReleaseSharedContext(CUcontext cuCtx)
             queueInfo.refcount--;
             if (queueInfo.refcount <= 0)
             {
+                {
+                    std::scoped_lock lock(ctx.graphMutex);
+                    cudaDestroyGraphs(cuCtx, kCudaGraphKeyAll);
+                }
+                {
+                    std::scoped_lock lock(ctx.streamMutex);
+                    cudaDestroyStreams(cuCtx);
+                }
+                // Resolver thread must be done with the context before it goes away
+                cudaAbortTimings(cuCtx);
+                {
+                    std::scoped_lock lock(ctx.timingMutex);
+                    cudaDestroyTimingEvents(cudaGetContextId(cuCtx));
+                }
+                {
+                    std::scoped_lock lock(ctx.interopMutex);
+                    if (cuCtxPushCurrent(cuCtx) == CUDA_SUCCESS)
+                    {
+                        cudaDestroyVulkanInterop(cuCtx);
+                        CUcontext dummy;
+                        cuCtxPopCurrent(&dummy);
+                    }
+                }
+                if (cuCtxPushCurrent(cuCtx) == CUDA_SUCCESS)
+                {
+                    cudaDestroyPinnedMemory(cuCtx);
+                    CUcontext dummy;
+                    cuCtxPopCurrent(&dummy);
+                }
                 cuCtxDestroy(cuCtx);
 
-                ctx.contextMapVulkan.erase(queue);
+                auto owner = queue;
+                std::erase_if(ctx.deviceContextsVulkan, [owner](const auto& entry) { return entry.second == owner; });
+                ctx.contextMapVulkan.erase(owner);
             }
             return kResultOk;
         }
@@ -169,13 +546,30 @@ static nvigi::Result cudaReleaseSharedContext(CUcontext cuCtx)
     return kResultInvalidParameter;
 }
 
-static nvigi::Result cudaGetSharedContextForVulkanQueue(const nvigi::VulkanParameters& params, CUcontext* cuCtx)
+static nvigi::Result cudaGetSharedContextForVulkanQueueImpl(const nvigi::VulkanParameters& params, CUcontext* cuCtx, uint64_t* creationTimeUs)
 {
     auto& ctx = (*hwiCuda::getContext());
 
     if (cuCtx == nullptr || params.device == nullptr || params.queue == nullptr)
         return nvigi::kResultInvalidParameter;
 
+    uint64_t timeUs = 0;
+    if (creationTimeUs) *creationTimeUs = 0;
+
+    std::scoped_lock lock(ctx.contextMutex);
+
+    if (ctx.contextPolicy == CudaSharedContextPolicy::kPerDevice)
+    {
+        auto owner = ctx.deviceContextsVulkan.find(params.device);
+        if (owner != ctx.deviceContextsVulkan.end())
+        {
+            hwiCuda::CudaContext::CudaContextInfo& ctxInfo = ctx.contextMapVulkan[owner->second];
+            ctxInfo.refcount++;
+            *cuCtx = ctxInfo.ctx;
+            return kResultOk;
+        }
+    }
+
     //! IMPORTANT: With CiG sometimes we can fail to create context with a direct (graphics) queue hence we need to try with the async compute one
     //!
     //! Logic:
@@ -184,7 +578,7 @@ static nvigi::Result cudaGetSharedContextForVulkanQueue(const nvigi::VulkanParam
     //! * If direct fails then async compute queue becomes a mandatory parameter
     //! * If both queues fail then we have a problem but ideally that should never happen
     //! 
-    auto createSharedContextVulkan = [&ctx](const VulkanParameters& params, VkQueue* actualQueueUsed) -> nvigi::Result
+    auto createSharedContextVulkan = [&ctx, &timeUs](const VulkanParameters& params, VkQueue* actualQueueUsed) -> nvigi::Result
         {
             CUcontext cuCtx{};
             *actualQueueUsed = params.queue;
@@ -192,7 +586,7 @@ static nvigi::Result cudaGetSharedContextForVulkanQueue(const nvigi::VulkanParam
             if (!ctx.contextMapVulkan.contains(params.queue))
             {
                 // Not cached, create one
-                if (NVIGI_FAILED(res, nvigi::cudaScg::CreateSharedCUDAContextVulkan(params.physicalDevice, params.device, params.queue, cuCtx)))
+                if (NVIGI_FAILED(res, cudaCreateSharedContextTimed("Vulkan", params.queue, timeUs, [&]() { return nvigi::cudaScg::CreateSharedCUDAContextVulkan(params.physicalDevice, params.device, params.queue, cuCtx); })))
                 {
                     // Failed with direct queue, let's try async compute, it becomes a mandatory parameter now
                     if (!params.queueCompute)
@@ -204,7 +598,7 @@ static nvigi::Result cudaGetSharedContextForVulkanQueue(const nvigi::VulkanParam
                     if (!ctx.contextMapVulkan.contains(params.queueCompute))
                     {
                         // Not cached, create one
-                        if (NVIGI_FAILED(res, nvigi::cudaScg::CreateSharedCUDAContextVulkan(params.physicalDevice, params.device, params.queueCompute, cuCtx)))
+                        if (NVIGI_FAILED(res, cudaCreateSharedContextTimed("Vulkan", params.queueCompute, timeUs, [&]() { return nvigi::cudaScg::CreateSharedCUDAContextVulkan(params.physicalDevice, params.device, params.queueCompute, cuCtx); })))
                         {
                             return res;
                         }
@@ -229,10 +623,53 @@ static nvigi::Result cudaGetSharedContextForVulkanQueue(const nvigi::VulkanParam
         return res;
     }
 
+    if (ctx.contextPolicy == CudaSharedContextPolicy::kPerDevice)
+    {
+        ctx.deviceContextsVulkan[params.device] = actualQueueUsed;
+    }
+
     hwiCuda::CudaContext::CudaContextInfo& ctxInfo = ctx.contextMapVulkan[actualQueueUsed];
     ctxInfo.refcount++;
     *cuCtx = ctxInfo.ctx;
+    if (creationTimeUs) *creationTimeUs = timeUs;
+
+    return kResultOk;
+}
+
+static nvigi::Result cudaGetSharedContextForQueue(const nvigi::D3D12Parameters& params, CUcontext* cuCtx)
+{
+    return cudaGetSharedContextForQueueImpl(params, cuCtx, nullptr);
+}
+
+static nvigi::Result cudaGetSharedContextForVulkanQueue(const nvigi::VulkanParameters& params, CUcontext* cuCtx)
+{
+    return cudaGetSharedContextForVulkanQueueImpl(params, cuCtx, nullptr);
+}
 
+static nvigi::Result cudaPrewarmSharedContextForQueue(const nvigi::D3D12Parameters& params, CUcontext* cuCtx, uint64_t* creationTimeUs)
+{
+    return cudaGetSharedContextForQueueImpl(params, cuCtx, creationTimeUs);
+}
+
+static nvigi::Result cudaPrewarmSharedContextForVulkanQueue(const nvigi::VulkanParameters& params, CUcontext* cuCtx, uint64_t* creationTimeUs)
+{
+    return cudaGetSharedContextForVulkanQueueImpl(params, cuCtx, creationTimeUs);
+}
+
+static nvigi::Result cudaSetSharedContextPolicy(uint32_t policy)
+{
+    if (policy >= CudaSharedContextPolicy::kNumOptions)
+        return kResultInvalidParameter;
+
+    auto& ctx = (*hwiCuda::getContext());
+    std::scoped_lock lock(ctx.contextMutex);
+    ctx.contextPolicy = policy;
+    if (policy == CudaSharedContextPolicy::kPerQueue)
+    {
+        // Contexts already handed out stay alive, new requests simply stop looking them up by device
+        ctx.deviceContexts.clear();
+        ctx.deviceContextsVulkan.clear();
+    }
     return kResultOk;
 }
 
@@ -276,13 +713,7 @@ static nvigi::Result cudaApplyGlobalGpuInferenceSchedulingMode(CUstream* cudaStr
         else
         {
             // Driver is sufficient, a "real" CUDA error
-            const char* name = nullptr;
-            const char* msg = nullptr;
-            cuGetErrorName(okSoFar, &name);
-            cuGetErrorString(okSoFar, &msg);
-            if (!name) name = "Unknown";
-            if (!msg)  msg = "Unknown";
-            NVIGI_LOG_ERROR("CUDA error: %s - %s", name, msg);
+            cudaLogError(okSoFar, "StreamSetWorkloadType");
             retval = kResultInvalidParameter;
         }
     }
@@ -290,78 +721,951 @@ static nvigi::Result cudaApplyGlobalGpuInferenceSchedulingMode(CUstream* cudaStr
     return retval;
 }
 
-//! Making sure our implementation is covered with our exception handler
-//! 
-namespace hwiCuda
+//! Must be called with graph mutex locked
+static nvigi::Result cudaLaunchGraph(CUgraphExec exec, CUstream stream)
 {
+    // Scheduling mode can change at any point so always apply it to the replay stream,
+    // launching is still fine on drivers which do not support it (already reported)
+    cudaApplyGlobalGpuInferenceSchedulingMode(&stream, 1);
 
-    static nvigi::Result GetSharedContextForQueue(const nvigi::D3D12Parameters& params, CUcontext* cuCtx)
+    auto result = cuGraphLaunch(exec, stream);
+    if (result != CUDA_SUCCESS)
     {
-        NVIGI_CATCH_EXCEPTION(cudaGetSharedContextForQueue(params, cuCtx));
+        return cudaLogError(result, "cuGraphLaunch");
     }
+    return kResultOk;
+}
 
-    static nvigi::Result ReleaseSharedContext(CUcontext cuCtx)
+static nvigi::Result cudaGraphCaptureAndLaunch(CUcontext cuCtx, CUstream stream, uint64_t graphKey, PFun_nvigiCudaGraphRecordCallback* record, void* userData)
+{
+    if (cuCtx == nullptr || stream == nullptr || record == nullptr || graphKey == kCudaGraphKeyAll)
+        return nvigi::kResultInvalidParameter;
+
+    auto& ctx = (*hwiCuda::getContext());
+
+    auto result = cuCtxPushCurrent(cuCtx);
+    if (result != CUDA_SUCCESS)
     {
-        NVIGI_CATCH_EXCEPTION(cudaReleaseSharedContext(cuCtx));
+        return cudaLogError(result, "cuCtxPushCurrent");
     }
+    extra::ScopedTasks popContext([]() { CUcontext dummy; cuCtxPopCurrent(&dummy); });
 
-    static nvigi::Result ApplyGlobalGpuInferenceSchedulingMode(CUstream* cudaStreams, size_t cudaStreamsCount)
+    // Thread local mode so other threads using CUDA in the meantime do not invalidate our capture
+    result = cuStreamBeginCapture(stream, CU_STREAM_CAPTURE_MODE_THREAD_LOCAL);
+    if (result != CUDA_SUCCESS)
     {
-        NVIGI_CATCH_EXCEPTION(cudaApplyGlobalGpuInferenceSchedulingMode(cudaStreams, cudaStreamsCount));
+        return cudaLogError(result, "cuStreamBeginCapture");
     }
 
-    static nvigi::Result GetSharedContextForVulkanQueue(const nvigi::VulkanParameters& params, CUcontext* cuCtx)
+    auto recorded = record(stream, userData);
+
+    // Always end the capture, otherwise the stream is left unusable
+    CUgraph graph{};
+    result = cuStreamEndCapture(stream, &graph);
+    extra::ScopedTasks destroyGraph([&graph]() { if (graph) cuGraphDestroy(graph); });
+    if (recorded != kResultOk)
     {
-        NVIGI_CATCH_EXCEPTION(cudaGetSharedContextForVulkanQueue(params, cuCtx));
+        NVIGI_LOG_ERROR("Failed to record CUDA graph 0x%llx - error 0x%x", graphKey, recorded);
+        return recorded;
+    }
+    if (result != CUDA_SUCCESS)
+    {
+        return cudaLogError(result, "cuStreamEndCapture");
     }
-} // namespace hwiCuda
-
-//! Main entry point - get information about our plugin
-//! 
-Result nvigiPluginGetInfo(nvigi::framework::IFramework* framework, nvigi::plugin::PluginInfo** _info)
-{
-    if (!plugin::internalPluginSetup(framework)) return kResultInvalidState;
-    
-    // Internal API, we know that incoming pointer is always valid
-    auto& info = plugin::getContext()->info;
-    *_info = &info;
 
-    info.id = plugin::hwi::cuda::kId;
-    info.description = "CUDA context plugin";
-    info.author = "NVIDIA";
-    info.build = GIT_BRANCH_AND_LAST_COMMIT;
-    info.interfaces = { plugin::getInterfaceInfo<IHWICuda>()};
-    info.requiredVendor = VendorId::eNVDA;
+    std::scoped_lock lock(ctx.graphMutex);
 
-    //! Specify minimum spec for the OS, driver and GPU architecture
-    //! 
-    info.minDriver = { 555, 85, 0 }; // CUDA in Graphics min spec
-    info.minOS = { NVIGI_DEF_MIN_OS_MAJOR, NVIGI_DEF_MIN_OS_MINOR, NVIGI_DEF_MIN_OS_BUILD };
-    info.minGPUArch = { NVIGI_CUDA_MIN_GPU_ARCH };
-    
-    nvigi::system::ISystem* system;
-    framework::getInterface(framework, nvigi::core::framework::kId, &system);
-    if (!system)
+    auto& info = ctx.graphs[cuCtx][graphKey];
+    if (info.exec)
     {
-        NVIGI_LOG_ERROR("NVIGI is in invalid state - missing core interface 'nvigi::system::ISystem'");
-        return kResultMissingInterface;
-    } 
-    extra::ScopedTasks releaseSystem([framework, system]() {framework::releaseInterface(framework, nvigi::core::framework::kId, system); });
-
-    bool hasNVAdapter = false;
-    const nvigi::system::SystemCaps* caps = system->getSystemCaps();
-    for (uint32_t i = 0; i < caps->adapterCount; i++)
+        // Same topology only changes node parameters which is an in place update, if anything else changed we must instantiate again
+        CUgraphExecUpdateResultInfo updateInfo{};
+        if (cuGraphExecUpdate(info.exec, graph, &updateInfo) == CUDA_SUCCESS)
+        {
+            info.updates++;
+        }
+        else
+        {
+            NVIGI_LOG_VERBOSE("CUDA graph 0x%llx topology changed (update result %d), instantiating again", graphKey, updateInfo.result);
+            cuGraphExecDestroy(info.exec);
+            info.exec = {};
+        }
+    }
+    if (!info.exec)
     {
-        const nvigi::system::Adapter* adapter = caps->adapters[i];
-        if (adapter->vendor == VendorId::eNVDA)
+        result = cuGraphInstantiate(&info.exec, graph, 0);
+        if (result != CUDA_SUCCESS)
         {
-            hasNVAdapter = true;
-            break;
-        }     
+            info.exec = {};
+            cudaDestroyGraphs(cuCtx, graphKey);
+            return cudaLogError(result, "cuGraphInstantiate");
+        }
     }
 
-    if (hasNVAdapter)
-    {
+    return cudaLaunchGraph(info.exec, stream);
+}
+
+static nvigi::Result cudaGraphLaunch(CUcontext cuCtx, CUstream stream, uint64_t graphKey)
+{
+    if (cuCtx == nullptr || stream == nullptr || graphKey == kCudaGraphKeyAll)
+        return nvigi::kResultInvalidParameter;
+
+    auto& ctx = (*hwiCuda::getContext());
+
+    std::scoped_lock lock(ctx.graphMutex);
+    auto graphs = ctx.graphs.find(cuCtx);
+    if (graphs == ctx.graphs.end() || !graphs->second.contains(graphKey))
+    {
+        return kResultItemNotFound;
+    }
+
+    auto result = cuCtxPushCurrent(cuCtx);
+    if (result != CUDA_SUCCESS)
+    {
+        return cudaLogError(result, "cuCtxPushCurrent");
+    }
+    extra::ScopedTasks popContext([]() { CUcontext dummy; cuCtxPopCurrent(&dummy); });
+
+    return cudaLaunchGraph(graphs->second[graphKey].exec, stream);
+}
+
+static nvigi::Result cudaGraphRelease(CUcontext cuCtx, uint64_t graphKey)
+{
+    if (cuCtx == nullptr)
+        return nvigi::kResultInvalidParameter;
+
+    auto& ctx = (*hwiCuda::getContext());
+
+    std::scoped_lock lock(ctx.graphMutex);
+    cudaDestroyGraphs(cuCtx, graphKey);
+    return kResultOk;
+}
+
+static nvigi::Result cudaAcquireStream(CUcontext cuCtx, uint32_t streamClass, CUstream* stream)
+{
+    if (cuCtx == nullptr || stream == nullptr || streamClass >= CudaStreamClass::kNumOptions)
+        return nvigi::kResultInvalidParameter;
+
+    auto& ctx = (*hwiCuda::getContext());
+
+    std::scoped_lock lock(ctx.streamMutex);
+    auto& pool = ctx.streamPools[cuCtx];
+    auto& available = pool.available[streamClass];
+    if (!available.empty())
+    {
+        *stream = available.back();
+        available.pop_back();
+        return kResultOk;
+    }
+
+    auto result = cuCtxPushCurrent(cuCtx);
+    if (result != CUDA_SUCCESS)
+    {
+        return cudaLogError(result, "cuCtxPushCurrent");
+    }
+    extra::ScopedTasks popContext([]() { CUcontext dummy; cuCtxPopCurrent(&dummy); });
+
+    // Lower number means higher priority in CUDA
+    int leastPriority{}, greatestPriority{};
+    cuCtxGetStreamPriorityRange(&leastPriority, &greatestPriority);
+    int priority = streamClass == CudaStreamClass::kForeground ? greatestPriority :
+        (streamClass == CudaStreamClass::kThrottled ? leastPriority : (leastPriority + greatestPriority) / 2);
+
+    CUstream newStream{};
+    result = cuStreamCreateWithPriority(&newStream, CU_STREAM_NON_BLOCKING, priority);
+    if (result != CUDA_SUCCESS)
+    {
+        return cudaLogError(result, "cuStreamCreateWithPriority");
+    }
+
+    uint32_t schedulingMode;
+    ctx.hwiCommon->GetGpuInferenceSchedulingMode(&schedulingMode);
+    if (cudaTagPooledStream(newStream, streamClass, schedulingMode) != CUDA_SUCCESS && ctx.driverVersion.major < 575)
+    {
+        NVIGI_LOG_ERROR_ONCE("Driver version 575.00 or newer is required to set the GPU scheduling mode.");
+    }
+
+    pool.streams[newStream] = streamClass;
+    *stream = newStream;
+    return kResultOk;
+}
+
+static nvigi::Result cudaReleaseStream(CUcontext cuCtx, CUstream stream)
+{
+    if (cuCtx == nullptr || stream == nullptr)
+        return nvigi::kResultInvalidParameter;
+
+    auto& ctx = (*hwiCuda::getContext());
+
+    std::scoped_lock lock(ctx.streamMutex);
+    auto pool = ctx.streamPools.find(cuCtx);
+    if (pool == ctx.streamPools.end() || !pool->second.streams.contains(stream))
+    {
+        NVIGI_LOG_ERROR("CUDA stream %p is not owned by the pool", stream);
+        return kResultInvalidParameter;
+    }
+    pool->second.available[pool->second.streams[stream]].push_back(stream);
+    return kResultOk;
+}
+
+static nvigi::Result cudaGpuTimingBegin(CUstream stream, uint32_t* token)
+{
+    if (!token)
+        return kResultInvalidParameter;
+
+    auto& ctx = (*hwiCuda::getContext());
+
+    CUcontext cuCtx{};
+    auto result = cuStreamGetCtx(stream, &cuCtx);
+    if (result != CUDA_SUCCESS)
+    {
+        return cudaLogError(result, "cuStreamGetCtx");
+    }
+
+    auto ctxId = cudaGetContextId(cuCtx);
+    hwiCuda::CudaContext::CudaEventPair events{};
+    {
+        std::scoped_lock lock(ctx.timingMutex);
+        auto& pool = ctx.timingEvents[ctxId];
+        if (!pool.empty())
+        {
+            events = pool.back();
+            pool.pop_back();
+        }
+    }
+
+    result = cuCtxPushCurrent(cuCtx);
+    if (result != CUDA_SUCCESS)
+    {
+        return cudaLogError(result, "cuCtxPushCurrent");
+    }
+    extra::ScopedTasks popContext([]() { CUcontext dummy; cuCtxPopCurrent(&dummy); });
+
+    if (!events.start)
+    {
+        if ((result = cuEventCreate(&events.start, CU_EVENT_DEFAULT)) != CUDA_SUCCESS ||
+            (result = cuEventCreate(&events.end, CU_EVENT_DEFAULT)) != CUDA_SUCCESS)
+        {
+            if (events.start) cuEventDestroy(events.start);
+            return cudaLogError(result, "cuEventCreate");
+        }
+    }
+    result = cuEventRecord(events.start, stream);
+    if (result != CUDA_SUCCESS)
+    {
+        std::scoped_lock lock(ctx.timingMutex);
+        ctx.timingEvents[ctxId].push_back(events);
+        return cudaLogError(result, "cuEventRecord");
+    }
+
+    std::scoped_lock lock(ctx.timingMutex);
+    *token = ++ctx.nextTimingToken;
+    ctx.timings[*token] = { cuCtx, ctxId, events };
+    return kResultOk;
+}
+
+static nvigi::Result cudaGpuTimingEnd(CUstream stream, uint32_t token, PFun_nvigiCudaGpuTimingCallback* callback, void* userData)
+{
+    if (!callback)
+        return kResultInvalidParameter;
+
+    auto& ctx = (*hwiCuda::getContext());
+
+    hwiCuda::CudaContext::CudaGpuTiming timing{};
+    {
+        std::scoped_lock lock(ctx.timingMutex);
+        auto it = ctx.timings.find(token);
+        if (it == ctx.timings.end())
+            return kResultItemNotFound;
+        timing = it->second;
+        ctx.timings.erase(it);
+    }
+
+    auto result = cuEventRecord(timing.events.end, stream);
+    if (result != CUDA_SUCCESS)
+    {
+        std::scoped_lock lock(ctx.timingMutex);
+        ctx.timingEvents[timing.ctxId].push_back(timing.events);
+        return cudaLogError(result, "cuEventRecord");
+    }
+
+    ctx.timingResolver.submit({ timing.ctxId, userData }, [timing, token, callback, userData](bool shuttingDown)->bool
+    {
+        auto& ctx = (*hwiCuda::getContext());
+        if (cuCtxPushCurrent(timing.ctx) != CUDA_SUCCESS) return true;
+        if (!shuttingDown)
+        {
+            auto status = cuEventQuery(timing.events.end);
+            if (status == CUDA_ERROR_NOT_READY)
+            {
+                // Polled instead of cuEventSynchronize so a hung GPU never blocks shutdown or aborts
+                CUcontext dummy;
+                cuCtxPopCurrent(&dummy);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                return false;
+            }
+            float ms = 0.0f;
+            if (status == CUDA_SUCCESS && cuEventElapsedTime(&ms, timing.events.start, timing.events.end) == CUDA_SUCCESS)
+            {
+                callback(token, uint64_t(double(ms) * 1000.0), userData);
+            }
+        }
+        CUcontext dummy;
+        cuCtxPopCurrent(&dummy);
+
+        std::scoped_lock lock(ctx.timingMutex);
+        ctx.timingEvents[timing.ctxId].push_back(timing.events);
+        return true;
+    });
+    return kResultOk;
+}
+
+static nvigi::Result cudaGpuTimingAbort(void* userData)
+{
+    auto& ctx = (*hwiCuda::getContext());
+    ctx.timingResolver.abort([userData](const gpu_timing::Resolver::Tag& tag) { return tag.userData == userData; });
+    return kResultOk;
+}
+
+static nvigi::Result cudaImportVulkanMemory(CUcontext cuCtx, VkDevice device, VkDeviceMemory memory, uint64_t allocationSize, uint64_t offset, uint64_t size, CUdeviceptr* devicePtr)
+{
+    if (!cuCtx || !device || !memory || !devicePtr || !size || offset + size > allocationSize)
+        return kResultInvalidParameter;
+
+    auto& ctx = (*hwiCuda::getContext());
+
+    CUDA_EXTERNAL_MEMORY_HANDLE_DESC memoryDesc{};
+    memoryDesc.size = allocationSize;
+#ifdef NVIGI_WINDOWS
+    auto getHandle = (PFN_vkGetMemoryWin32HandleKHR)vkGetDeviceProcAddr(device, "vkGetMemoryWin32HandleKHR");
+    VkMemoryGetWin32HandleInfoKHR handleInfo{ VK_STRUCTURE_TYPE_MEMORY_GET_WIN32_HANDLE_INFO_KHR };
+    handleInfo.memory = memory;
+    handleInfo.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_WIN32_BIT;
+    HANDLE handle{};
+    if (!getHandle || getHandle(device, &handleInfo, &handle) != VK_SUCCESS)
+    {
+        NVIGI_LOG_ERROR("Failed to export Vulkan memory, make sure VK_KHR_external_memory_win32 is enabled and memory was allocated as exportable");
+        return kResultInvalidState;
+    }
+    // CUDA does not take ownership of NT handles
+    extra::ScopedTasks closeHandle([handle]() { CloseHandle(handle); });
+    memoryDesc.type = CU_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_WIN32;
+    memoryDesc.handle.win32.handle = handle;
+#else
+    auto getFd = (PFN_vkGetMemoryFdKHR)vkGetDeviceProcAddr(device, "vkGetMemoryFdKHR");
+    VkMemoryGetFdInfoKHR fdInfo{ VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR };
+    fdInfo.memory = memory;
+    fdInfo.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+    int fd = -1;
+    if (!getFd || getFd(device, &fdInfo, &fd) != VK_SUCCESS)
+    {
+        NVIGI_LOG_ERROR("Failed to export Vulkan memory, make sure VK_KHR_external_memory_fd is enabled and memory was allocated as exportable");
+        return kResultInvalidState;
+    }
+    // Ownership of the fd is transferred to CUDA on success
+    memoryDesc.type = CU_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD;
+    memoryDesc.handle.fd = fd;
+#endif
+
+    auto result = cuCtxPushCurrent(cuCtx);
+    if (result != CUDA_SUCCESS)
+    {
+        return cudaLogError(result, "cuCtxPushCurrent");
+    }
+    extra::ScopedTasks popContext([]() { CUcontext dummy; cuCtxPopCurrent(&dummy); });
+
+    CUexternalMemory externalMemory{};
+    result = cuImportExternalMemory(&externalMemory, &memoryDesc);
+    if (result != CUDA_SUCCESS)
+    {
+#ifndef NVIGI_WINDOWS
+        close(fd);
+#endif
+        return cudaLogError(result, "cuImportExternalMemory");
+    }
+
+    CUDA_EXTERNAL_MEMORY_BUFFER_DESC bufferDesc{};
+    bufferDesc.offset = offset;
+    bufferDesc.size = size;
+    result = cuExternalMemoryGetMappedBuffer(devicePtr, externalMemory, &bufferDesc);
+    if (result != CUDA_SUCCESS)
+    {
+        cuDestroyExternalMemory(externalMemory);
+        return cudaLogError(result, "cuExternalMemoryGetMappedBuffer");
+    }
+
+    std::scoped_lock lock(ctx.interopMutex);
+    ctx.vulkanMemory[*devicePtr] = { cuCtx, externalMemory };
+    return kResultOk;
+}
+
+static nvigi::Result cudaReleaseVulkanMemory(CUcontext cuCtx, CUdeviceptr devicePtr)
+{
+    auto& ctx = (*hwiCuda::getContext());
+
+    std::scoped_lock lock(ctx.interopMutex);
+    auto it = ctx.vulkanMemory.find(devicePtr);
+    if (it == ctx.vulkanMemory.end() || it->second.ctx != cuCtx)
+        return kResultItemNotFound;
+
+    auto result = cuCtxPushCurrent(cuCtx);
+    if (result != CUDA_SUCCESS)
+    {
+        return cudaLogError(result, "cuCtxPushCurrent");
+    }
+    cuMemFree(devicePtr);
+    cuDestroyExternalMemory(it->second.memory);
+    CUcontext dummy;
+    cuCtxPopCurrent(&dummy);
+
+    ctx.vulkanMemory.erase(it);
+    return kResultOk;
+}
+
+//! Must be called with interop mutex locked and the context current
+static nvigi::Result cudaGetVulkanSemaphore(CUcontext cuCtx, VkDevice device, VkSemaphore semaphore, CUexternalSemaphore* externalSemaphore)
+{
+    auto& ctx = (*hwiCuda::getContext());
+
+    auto it = ctx.vulkanSemaphores.find(semaphore);
+    if (it != ctx.vulkanSemaphores.end())
+    {
+        *externalSemaphore = it->second.semaphore;
+        return kResultOk;
+    }
+
+    CUDA_EXTERNAL_SEMAPHORE_HANDLE_DESC semaphoreDesc{};
+#ifdef NVIGI_WINDOWS
+    auto getHandle = (PFN_vkGetSemaphoreWin32HandleKHR)vkGetDeviceProcAddr(device, "vkGetSemaphoreWin32HandleKHR");
+    VkSemaphoreGetWin32HandleInfoKHR handleInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_GET_WIN32_HANDLE_INFO_KHR };
+    handleInfo.semaphore = semaphore;
+    handleInfo.handleType = VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_WIN32_BIT;
+    HANDLE handle{};
+    if (!getHandle || getHandle(device, &handleInfo, &handle) != VK_SUCCESS)
+    {
+        NVIGI_LOG_ERROR("Failed to export Vulkan semaphore, make sure VK_KHR_external_semaphore_win32 is enabled and the semaphore was created as exportable");
+        return kResultInvalidState;
+    }
+    extra::ScopedTasks closeHandle([handle]() { CloseHandle(handle); });
+    semaphoreDesc.type = CU_EXTERNAL_SEMAPHORE_HANDLE_TYPE_TIMELINE_SEMAPHORE_WIN32;
+    semaphoreDesc.handle.win32.handle = handle;
+#else
+    auto getFd = (PFN_vkGetSemaphoreFdKHR)vkGetDeviceProcAddr(device, "vkGetSemaphoreFdKHR");
+    VkSemaphoreGetFdInfoKHR fdInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_GET_FD_INFO_KHR };
+    fdInfo.semaphore = semaphore;
+    fdInfo.handleType = VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_FD_BIT;
+    int fd = -1;
+    if (!getFd || getFd(device, &fdInfo, &fd) != VK_SUCCESS)
+    {
+        NVIGI_LOG_ERROR("Failed to export Vulkan semaphore, make sure VK_KHR_external_semaphore_fd is enabled and the semaphore was created as exportable");
+        return kResultInvalidState;
+    }
+    semaphoreDesc.type = CU_EXTERNAL_SEMAPHORE_HANDLE_TYPE_TIMELINE_SEMAPHORE_FD;
+    semaphoreDesc.handle.fd = fd;
+#endif
+
+    auto result = cuImportExternalSemaphore(externalSemaphore, &semaphoreDesc);
+    if (result != CUDA_SUCCESS)
+    {
+#ifndef NVIGI_WINDOWS
+        close(fd);
+#endif
+        return cudaLogError(result, "cuImportExternalSemaphore");
+    }
+    ctx.vulkanSemaphores[semaphore] = { cuCtx, *externalSemaphore };
+    return kResultOk;
+}
+
+static nvigi::Result cudaWaitOrSignalVulkanSemaphore(CUcontext cuCtx, VkDevice device, VkSemaphore semaphore, uint64_t value, CUstream stream, bool signal)
+{
+    if (!cuCtx || !device || !semaphore)
+        return kResultInvalidParameter;
+
+    auto& ctx = (*hwiCuda::getContext());
+
+    auto result = cuCtxPushCurrent(cuCtx);
+    if (result != CUDA_SUCCESS)
+    {
+        return cudaLogError(result, "cuCtxPushCurrent");
+    }
+    extra::ScopedTasks popContext([]() { CUcontext dummy; cuCtxPopCurrent(&dummy); });
+
+    CUexternalSemaphore externalSemaphore{};
+    {
+        std::scoped_lock lock(ctx.interopMutex);
+        if (NVIGI_FAILED(res, cudaGetVulkanSemaphore(cuCtx, device, semaphore, &externalSemaphore)))
+        {
+            return res;
+        }
+    }
+
+    if (signal)
+    {
+        CUDA_EXTERNAL_SEMAPHORE_SIGNAL_PARAMS params{};
+        params.params.fence.value = value;
+        result = cuSignalExternalSemaphoresAsync(&externalSemaphore, &params, 1, stream);
+    }
+    else
+    {
+        CUDA_EXTERNAL_SEMAPHORE_WAIT_PARAMS params{};
+        params.params.fence.value = value;
+        result = cuWaitExternalSemaphoresAsync(&externalSemaphore, &params, 1, stream);
+    }
+    if (result != CUDA_SUCCESS)
+    {
+        return cudaLogError(result, signal ? "cuSignalExternalSemaphoresAsync" : "cuWaitExternalSemaphoresAsync");
+    }
+    return kResultOk;
+}
+
+static nvigi::Result cudaWaitVulkanSemaphore(CUcontext cuCtx, VkDevice device, VkSemaphore semaphore, uint64_t value, CUstream stream)
+{
+    return cudaWaitOrSignalVulkanSemaphore(cuCtx, device, semaphore, value, stream, false);
+}
+
+static nvigi::Result cudaSignalVulkanSemaphore(CUcontext cuCtx, VkDevice device, VkSemaphore semaphore, uint64_t value, CUstream stream)
+{
+    return cudaWaitOrSignalVulkanSemaphore(cuCtx, device, semaphore, value, stream, true);
+}
+
+static nvigi::Result cudaReleaseVulkanSemaphore(CUcontext cuCtx, VkSemaphore semaphore)
+{
+    auto& ctx = (*hwiCuda::getContext());
+
+    std::scoped_lock lock(ctx.interopMutex);
+    auto it = ctx.vulkanSemaphores.find(semaphore);
+    if (it == ctx.vulkanSemaphores.end() || it->second.ctx != cuCtx)
+        return kResultItemNotFound;
+
+    auto result = cuCtxPushCurrent(cuCtx);
+    if (result != CUDA_SUCCESS)
+    {
+        return cudaLogError(result, "cuCtxPushCurrent");
+    }
+    cuDestroyExternalSemaphore(it->second.semaphore);
+    CUcontext dummy;
+    cuCtxPopCurrent(&dummy);
+
+    ctx.vulkanSemaphores.erase(it);
+    return kResultOk;
+}
+
+static uint32_t cudaPinnedSizeClass(size_t size)
+{
+    uint32_t sizeClass = 0;
+    while (sizeClass + 1 < hwiCuda::kPinnedSizeClasses && (hwiCuda::kPinnedMinBlockSize << sizeClass) < size) sizeClass++;
+    return sizeClass;
+}
+
+//! Must be called with pinned mutex locked, moves blocks released with a stream back to the pool once the stream got there
+static void cudaRecyclePinnedMemory(hwiCuda::CudaContext::PinnedPool& pool)
+{
+    auto& ctx = (*hwiCuda::getContext());
+    for (auto it = pool.pending.begin(); it != pool.pending.end();)
+    {
+        if (cuEventQuery(it->event) == CUDA_ERROR_NOT_READY) { it++; continue; }
+        pool.available[ctx.pinnedBlocks[(uintptr_t)it->ptr].sizeClass].push_back(it->ptr);
+        pool.events.push_back(it->event);
+        it = pool.pending.erase(it);
+    }
+}
+
+//! Must be called with pinned mutex locked
+static bool cudaIsPinnedMemory(const void* ptr, size_t size)
+{
+    auto& ctx = (*hwiCuda::getContext());
+    auto block = ctx.pinnedBlocks.upper_bound((uintptr_t)ptr);
+    if (block == ctx.pinnedBlocks.begin()) return false;
+    block--;
+    return block->second.inUse && (uintptr_t)ptr + size <= block->first + block->second.size;
+}
+
+static nvigi::Result cudaAllocatePinnedMemory(CUcontext cuCtx, size_t size, void** ptr)
+{
+    if (cuCtx == nullptr || ptr == nullptr || size == 0)
+        return kResultInvalidParameter;
+
+    auto& ctx = (*hwiCuda::getContext());
+
+    auto sizeClass = cudaPinnedSizeClass(size);
+    size_t blockSize = hwiCuda::kPinnedMinBlockSize << sizeClass;
+    if (blockSize < size)
+        return kResultInvalidParameter;
+    {
+        std::scoped_lock lock(ctx.pinnedMutex);
+        auto& pool = ctx.pinnedPools[cuCtx];
+        cudaRecyclePinnedMemory(pool);
+        auto& available = pool.available[sizeClass];
+        if (!available.empty())
+        {
+            *ptr = available.back();
+            available.pop_back();
+            ctx.pinnedBlocks[(uintptr_t)*ptr].inUse = true;
+            return kResultOk;
+        }
+    }
+
+    // Page locking is slow, keep it outside of the lock
+    auto result = cuCtxPushCurrent(cuCtx);
+    if (result != CUDA_SUCCESS)
+    {
+        return cudaLogError(result, "cuCtxPushCurrent");
+    }
+    extra::ScopedTasks popContext([]() { CUcontext dummy; cuCtxPopCurrent(&dummy); });
+
+    void* block{};
+    result = cuMemHostAlloc(&block, blockSize, CU_MEMHOSTALLOC_PORTABLE);
+    if (result != CUDA_SUCCESS)
+    {
+        return cudaLogError(result, "cuMemHostAlloc");
+    }
+
+    std::scoped_lock lock(ctx.pinnedMutex);
+    ctx.pinnedBlocks[(uintptr_t)block] = { cuCtx, blockSize, sizeClass, true };
+    *ptr = block;
+    return kResultOk;
+}
+
+static nvigi::Result cudaReleasePinnedMemory(CUcontext cuCtx, void* ptr, CUstream stream)
+{
+    if (cuCtx == nullptr || ptr == nullptr)
+        return kResultInvalidParameter;
+
+    auto& ctx = (*hwiCuda::getContext());
+
+    std::scoped_lock lock(ctx.pinnedMutex);
+    auto block = ctx.pinnedBlocks.find((uintptr_t)ptr);
+    if (block == ctx.pinnedBlocks.end() || block->second.ctx != cuCtx || !block->second.inUse)
+    {
+        NVIGI_LOG_ERROR("Pinned memory %p is not owned by the pool or was already released", ptr);
+        return kResultInvalidParameter;
+    }
+    auto& pool = ctx.pinnedPools[cuCtx];
+    if (!stream)
+    {
+        block->second.inUse = false;
+        pool.available[block->second.sizeClass].push_back(ptr);
+        return kResultOk;
+    }
+
+    auto result = cuCtxPushCurrent(cuCtx);
+    if (result != CUDA_SUCCESS)
+    {
+        return cudaLogError(result, "cuCtxPushCurrent");
+    }
+    extra::ScopedTasks popContext([]() { CUcontext dummy; cuCtxPopCurrent(&dummy); });
+
+    CUevent event{};
+    if (!pool.events.empty())
+    {
+        event = pool.events.back();
+        pool.events.pop_back();
+    }
+    else if ((result = cuEventCreate(&event, CU_EVENT_DISABLE_TIMING)) != CUDA_SUCCESS)
+    {
+        return cudaLogError(result, "cuEventCreate");
+    }
+    result = cuEventRecord(event, stream);
+    if (result != CUDA_SUCCESS)
+    {
+        pool.events.push_back(event);
+        return cudaLogError(result, "cuEventRecord");
+    }
+    block->second.inUse = false;
+    pool.pending.push_back({ ptr, event });
+    return kResultOk;
+}
+
+static nvigi::Result cudaCopyToDeviceAsync(CUcontext cuCtx, CUdeviceptr dst, const void* src, size_t size, CUstream stream)
+{
+    if (cuCtx == nullptr || dst == 0 || src == nullptr)
+        return kResultInvalidParameter;
+    if (size == 0)
+        return kResultOk;
+
+    auto& ctx = (*hwiCuda::getContext());
+
+    bool pinned{};
+    {
+        std::scoped_lock lock(ctx.pinnedMutex);
+        pinned = cudaIsPinnedMemory(src, size);
+    }
+
+    auto result = cuCtxPushCurrent(cuCtx);
+    if (result != CUDA_SUCCESS)
+    {
+        return cudaLogError(result, "cuCtxPushCurrent");
+    }
+    extra::ScopedTasks popContext([]() { CUcontext dummy; cuCtxPopCurrent(&dummy); });
+
+    if (pinned)
+    {
+        result = cuMemcpyHtoDAsync(dst, src, size, stream);
+        return result == CUDA_SUCCESS ? kResultOk : cudaLogError(result, "cuMemcpyHtoDAsync");
+    }
+
+    // Pageable source, copy into a pooled block so 'src' can be reused right away and the DMA does not block the CPU
+    NVIGI_LOG_VERBOSE_ONCE("Staging pageable host memory for CUDA uploads, allocate inputs with 'cudaAllocatePinnedMemory' to avoid the extra copy");
+    void* staging{};
+    if (NVIGI_FAILED(res, cudaAllocatePinnedMemory(cuCtx, size, &staging)))
+        return res;
+    memcpy(staging, src, size);
+    result = cuMemcpyHtoDAsync(dst, staging, size, stream);
+    if (result != CUDA_SUCCESS)
+    {
+        cudaReleasePinnedMemory(cuCtx, staging, nullptr);
+        return cudaLogError(result, "cuMemcpyHtoDAsync");
+    }
+    return cudaReleasePinnedMemory(cuCtx, staging, stream);
+}
+
+struct CudaStagedCopy
+{
+    void* dst{};
+    void* staging{};
+    size_t size{};
+};
+
+//! Runs on a CUDA internal thread once the stream reaches the staged download, must not call into CUDA
+static void CUDA_CB cudaFinishStagedCopy(void* userData)
+{
+    auto copy = (CudaStagedCopy*)userData;
+    memcpy(copy->dst, copy->staging, copy->size);
+    {
+        auto& ctx = (*hwiCuda::getContext());
+        std::scoped_lock lock(ctx.pinnedMutex);
+        auto block = ctx.pinnedBlocks.find((uintptr_t)copy->staging);
+        if (block != ctx.pinnedBlocks.end())
+        {
+            block->second.inUse = false;
+            ctx.pinnedPools[block->second.ctx].available[block->second.sizeClass].push_back(copy->staging);
+        }
+    }
+    delete copy;
+}
+
+static nvigi::Result cudaCopyToHostAsync(CUcontext cuCtx, void* dst, CUdeviceptr src, size_t size, CUstream stream)
+{
+    if (cuCtx == nullptr || dst == nullptr || src == 0)
+        return kResultInvalidParameter;
+    if (size == 0)
+        return kResultOk;
+
+    auto& ctx = (*hwiCuda::getContext());
+
+    bool pinned{};
+    {
+        std::scoped_lock lock(ctx.pinnedMutex);
+        pinned = cudaIsPinnedMemory(dst, size);
+    }
+
+    auto result = cuCtxPushCurrent(cuCtx);
+    if (result != CUDA_SUCCESS)
+    {
+        return cudaLogError(result, "cuCtxPushCurrent");
+    }
+    extra::ScopedTasks popContext([]() { CUcontext dummy; cuCtxPopCurrent(&dummy); });
+
+    if (pinned)
+    {
+        result = cuMemcpyDtoHAsync(dst, src, size, stream);
+        return result == CUDA_SUCCESS ? kResultOk : cudaLogError(result, "cuMemcpyDtoHAsync");
+    }
+
+    // Pageable destination, download into a pooled block and copy out from a host callback once the stream gets there
+    NVIGI_LOG_VERBOSE_ONCE("Staging pageable host memory for CUDA downloads, allocate outputs with 'cudaAllocatePinnedMemory' to avoid the extra copy");
+    void* staging{};
+    if (NVIGI_FAILED(res, cudaAllocatePinnedMemory(cuCtx, size, &staging)))
+        return res;
+    result = cuMemcpyDtoHAsync(staging, src, size, stream);
+    if (result != CUDA_SUCCESS)
+    {
+        cudaReleasePinnedMemory(cuCtx, staging, nullptr);
+        return cudaLogError(result, "cuMemcpyDtoHAsync");
+    }
+    auto copy = new CudaStagedCopy{ dst, staging, size };
+    result = cuLaunchHostFunc(stream, cudaFinishStagedCopy, copy);
+    if (result != CUDA_SUCCESS)
+    {
+        // Download is already enqueued, finish it synchronously so the block is not lost
+        cuStreamSynchronize(stream);
+        cudaFinishStagedCopy(copy);
+        return cudaLogError(result, "cuLaunchHostFunc");
+    }
+    return kResultOk;
+}
+
+//! Making sure our implementation is covered with our exception handler
+//! 
+namespace hwiCuda
+{
+
+    static nvigi::Result GetSharedContextForQueue(const nvigi::D3D12Parameters& params, CUcontext* cuCtx)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaGetSharedContextForQueue(params, cuCtx));
+    }
+
+    static nvigi::Result ReleaseSharedContext(CUcontext cuCtx)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaReleaseSharedContext(cuCtx));
+    }
+
+    static nvigi::Result ApplyGlobalGpuInferenceSchedulingMode(CUstream* cudaStreams, size_t cudaStreamsCount)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaApplyGlobalGpuInferenceSchedulingMode(cudaStreams, cudaStreamsCount));
+    }
+
+    static nvigi::Result GetSharedContextForVulkanQueue(const nvigi::VulkanParameters& params, CUcontext* cuCtx)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaGetSharedContextForVulkanQueue(params, cuCtx));
+    }
+
+    static nvigi::Result SetSharedContextPolicy(uint32_t policy)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaSetSharedContextPolicy(policy));
+    }
+
+    static nvigi::Result PrewarmSharedContextForQueue(const nvigi::D3D12Parameters& params, CUcontext* cuCtx, uint64_t* creationTimeUs)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaPrewarmSharedContextForQueue(params, cuCtx, creationTimeUs));
+    }
+
+    static nvigi::Result PrewarmSharedContextForVulkanQueue(const nvigi::VulkanParameters& params, CUcontext* cuCtx, uint64_t* creationTimeUs)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaPrewarmSharedContextForVulkanQueue(params, cuCtx, creationTimeUs));
+    }
+
+    static nvigi::Result GraphCaptureAndLaunch(CUcontext cuCtx, CUstream stream, uint64_t graphKey, PFun_nvigiCudaGraphRecordCallback* record, void* userData)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaGraphCaptureAndLaunch(cuCtx, stream, graphKey, record, userData));
+    }
+
+    static nvigi::Result GraphLaunch(CUcontext cuCtx, CUstream stream, uint64_t graphKey)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaGraphLaunch(cuCtx, stream, graphKey));
+    }
+
+    static nvigi::Result GraphRelease(CUcontext cuCtx, uint64_t graphKey)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaGraphRelease(cuCtx, graphKey));
+    }
+
+    static nvigi::Result AcquireStream(CUcontext cuCtx, uint32_t streamClass, CUstream* stream)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaAcquireStream(cuCtx, streamClass, stream));
+    }
+
+    static nvigi::Result ReleaseStream(CUcontext cuCtx, CUstream stream)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaReleaseStream(cuCtx, stream));
+    }
+
+    static nvigi::Result GpuTimingBegin(CUstream stream, uint32_t* token)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaGpuTimingBegin(stream, token));
+    }
+
+    static nvigi::Result GpuTimingEnd(CUstream stream, uint32_t token, PFun_nvigiCudaGpuTimingCallback* callback, void* userData)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaGpuTimingEnd(stream, token, callback, userData));
+    }
+
+    static nvigi::Result GpuTimingAbort(void* userData)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaGpuTimingAbort(userData));
+    }
+
+    static nvigi::Result ImportVulkanMemory(CUcontext cuCtx, VkDevice device, VkDeviceMemory memory, uint64_t allocationSize, uint64_t offset, uint64_t size, CUdeviceptr* devicePtr)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaImportVulkanMemory(cuCtx, device, memory, allocationSize, offset, size, devicePtr));
+    }
+
+    static nvigi::Result ReleaseVulkanMemory(CUcontext cuCtx, CUdeviceptr devicePtr)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaReleaseVulkanMemory(cuCtx, devicePtr));
+    }
+
+    static nvigi::Result WaitVulkanSemaphore(CUcontext cuCtx, VkDevice device, VkSemaphore semaphore, uint64_t value, CUstream stream)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaWaitVulkanSemaphore(cuCtx, device, semaphore, value, stream));
+    }
+
+    static nvigi::Result SignalVulkanSemaphore(CUcontext cuCtx, VkDevice device, VkSemaphore semaphore, uint64_t value, CUstream stream)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaSignalVulkanSemaphore(cuCtx, device, semaphore, value, stream));
+    }
+
+    static nvigi::Result ReleaseVulkanSemaphore(CUcontext cuCtx, VkSemaphore semaphore)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaReleaseVulkanSemaphore(cuCtx, semaphore));
+    }
+    static nvigi::Result AllocatePinnedMemory(CUcontext cuCtx, size_t size, void** ptr)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaAllocatePinnedMemory(cuCtx, size, ptr));
+    }
+
+    static nvigi::Result ReleasePinnedMemory(CUcontext cuCtx, void* ptr, CUstream stream)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaReleasePinnedMemory(cuCtx, ptr, stream));
+    }
+
+    static nvigi::Result CopyToDeviceAsync(CUcontext cuCtx, CUdeviceptr dst, const void* src, size_t size, CUstream stream)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaCopyToDeviceAsync(cuCtx, dst, src, size, stream));
+    }
+
+    static nvigi::Result CopyToHostAsync(CUcontext cuCtx, void* dst, CUdeviceptr src, size_t size, CUstream stream)
+    {
+        NVIGI_CATCH_EXCEPTION(cudaCopyToHostAsync(cuCtx, dst, src, size, stream));
+    }
+} // namespace hwiCuda
+
+//! Main entry point - get information about our plugin
+//! 
+Result nvigiPluginGetInfo(nvigi::framework::IFramework* framework, nvigi::plugin::PluginInfo** _info)
+{
+    if (!plugin::internalPluginSetup(framework)) return kResultInvalidState;
+    
+    // Internal API, we know that incoming pointer is always valid
+    auto& info = plugin::getContext()->info;
+    *_info = &info;
+
+    info.id = plugin::hwi::cuda::kId;
+    info.description = "CUDA context plugin";
+    info.author = "NVIDIA";
+    info.build = GIT_BRANCH_AND_LAST_COMMIT;
+    info.interfaces = { plugin::getInterfaceInfo<IHWICuda>()};
+    info.requiredVendor = VendorId::eNVDA;
+
+    //! Specify minimum spec for the OS, driver and GPU architecture
+    //! 
+    info.minDriver = { 555, 85, 0 }; // CUDA in Graphics min spec
+    info.minOS = { NVIGI_DEF_MIN_OS_MAJOR, NVIGI_DEF_MIN_OS_MINOR, NVIGI_DEF_MIN_OS_BUILD };
+    info.minGPUArch = { NVIGI_CUDA_MIN_GPU_ARCH };
+    
+    nvigi::system::ISystem* system;
+    framework::getInterface(framework, nvigi::core::framework::kId, &system);
+    if (!system)
+    {
+        NVIGI_LOG_ERROR("NVIGI is in invalid state - missing core interface 'nvigi::system::ISystem'");
+        return kResultMissingInterface;
+    } 
+    extra::ScopedTasks releaseSystem([framework, system]() {framework::releaseInterface(framework, nvigi::core::framework::kId, system); });
+
+    bool hasNVAdapter = false;
+    const nvigi::system::SystemCaps* caps = system->getSystemCaps();
+    for (uint32_t i = 0; i < caps->adapterCount; i++)
+    {
+        const nvigi::system::Adapter* adapter = caps->adapters[i];
+        if (adapter->vendor == VendorId::eNVDA)
+        {
+            hasNVAdapter = true;
+            break;
+        }     
+    }
+
+    if (hasNVAdapter)
+    {
         info.minSystemFlags |= SystemFlags::eHWSchedulingEnabled;
     }
     (*hwiCuda::getContext()).driverVersion = system->getSystemCaps()->driverVersion;
@@ -383,6 +1687,26 @@ Result nvigiPluginRegister(framework::IFramework* framework)
     ctx.api.cudaReleaseSharedContext = hwiCuda::ReleaseSharedContext;
     ctx.api.cudaApplyGlobalGpuInferenceSchedulingMode = hwiCuda::ApplyGlobalGpuInferenceSchedulingMode;
     ctx.api.cudaGetSharedContextForVulkanQueue = hwiCuda::GetSharedContextForVulkanQueue;
+    ctx.api.cudaGraphCaptureAndLaunch = hwiCuda::GraphCaptureAndLaunch;
+    ctx.api.cudaGraphLaunch = hwiCuda::GraphLaunch;
+    ctx.api.cudaGraphRelease = hwiCuda::GraphRelease;
+    ctx.api.cudaAcquireStream = hwiCuda::AcquireStream;
+    ctx.api.cudaReleaseStream = hwiCuda::ReleaseStream;
+    ctx.api.cudaGpuTimingBegin = hwiCuda::GpuTimingBegin;
+    ctx.api.cudaGpuTimingEnd = hwiCuda::GpuTimingEnd;
+    ctx.api.cudaGpuTimingAbort = hwiCuda::GpuTimingAbort;
+    ctx.api.cudaImportVulkanMemory = hwiCuda::ImportVulkanMemory;
+    ctx.api.cudaReleaseVulkanMemory = hwiCuda::ReleaseVulkanMemory;
+    ctx.api.cudaWaitVulkanSemaphore = hwiCuda::WaitVulkanSemaphore;
+    ctx.api.cudaSignalVulkanSemaphore = hwiCuda::SignalVulkanSemaphore;
+    ctx.api.cudaReleaseVulkanSemaphore = hwiCuda::ReleaseVulkanSemaphore;
+    ctx.api.cudaSetSharedContextPolicy = hwiCuda::SetSharedContextPolicy;
+    ctx.api.cudaPrewarmSharedContextForQueue = hwiCuda::PrewarmSharedContextForQueue;
+    ctx.api.cudaPrewarmSharedContextForVulkanQueue = hwiCuda::PrewarmSharedContextForVulkanQueue;
+    ctx.api.cudaAllocatePinnedMemory = hwiCuda::AllocatePinnedMemory;
+    ctx.api.cudaReleasePinnedMemory = hwiCuda::ReleasePinnedMemory;
+    ctx.api.cudaCopyToDeviceAsync = hwiCuda::CopyToDeviceAsync;
+    ctx.api.cudaCopyToHostAsync = hwiCuda::CopyToHostAsync;
 
     framework->addInterface(plugin::hwi::cuda::kId, &ctx.api, 0);
     
@@ -398,6 +1722,14 @@ Result nvigiPluginRegister(framework::IFramework* framework)
         NVIGI_LOG_ERROR("Get plugin::hwi::common interface failed");
         return kResultMissingDynamicLibraryDependency;
     }
+    if (ctx.hwiCommon->getVersion() >= kStructVersion2)
+    {
+        ctx.hwiCommon->RegisterSchedulingModeChangedCallback(cudaOnSchedulingModeChanged, nullptr);
+    }
+    else
+    {
+        NVIGI_LOG_WARN("Older 'nvigi.plugin.hwi.common' detected, pooled CUDA streams will not follow scheduling mode changes");
+    }
 
     // Always load DLLs with full path and check signatures in production
     auto dependenciesPathW = extra::utf8ToUtf16(dependenciesPath.c_str());
@@ -432,6 +1764,15 @@ Result nvigiPluginDeregister()
 {
     auto& ctx = (*hwiCuda::getContext());
 
+    // Pending timings are dropped, callbacks are not triggered after this point
+    ctx.timingResolver.stop();
+
+    // Pooled streams are re-tagged via the CIG helper so stop listening before it goes away
+    if (ctx.hwiCommon && ctx.hwiCommon->getVersion() >= kStructVersion2)
+    {
+        ctx.hwiCommon->UnregisterSchedulingModeChangedCallback(cudaOnSchedulingModeChanged, nullptr);
+    }
+
     // Free CIG helper DLL first (before releasing interfaces that might use it)
     if (ctx.cigHelper)
     {
@@ -446,6 +1787,34 @@ Result nvigiPluginDeregister()
     }
 
     //! Do any other shutdown tasks here
+    {
+        std::scoped_lock lock(ctx.graphMutex);
+        while (!ctx.graphs.empty())
+        {
+            cudaDestroyGraphs(ctx.graphs.begin()->first, kCudaGraphKeyAll);
+        }
+    }
+    {
+        std::scoped_lock lock(ctx.streamMutex);
+        while (!ctx.streamPools.empty())
+        {
+            cudaDestroyStreams(ctx.streamPools.begin()->first);
+        }
+    }
+    {
+        std::scoped_lock lock(ctx.timingMutex);
+        while (!ctx.timingEvents.empty())
+        {
+            cudaDestroyTimingEvents(ctx.timingEvents.begin()->first);
+        }
+        ctx.timings.clear();
+    }
+    {
+        // Contexts can be gone already, CUDA reports errors we simply ignore here
+        std::scoped_lock lock(ctx.interopMutex);
+        cudaDestroyVulkanInterop(nullptr);
+    }
+    cudaDestroyPinnedMemory(nullptr);
     return kResultOk;
 }
 
@@ -16,10 +16,43 @@ namespace plugin::hwi::cuda
     constexpr PluginID kId = { {0xf991d01a, 0x8e38, 0x43f9,{0x96, 0x96, 0x81, 0x7e, 0x5c, 0xae, 0x94, 0xdd}}, 0xf4b3f7 }; //{F991D01A-8E38-43F9-9696-817E5CAE94DD} [nvigi.plugin.hwi.cuda]
 }
 
+//! Issues the work to be captured into a CUDA graph, everything must be enqueued on 'stream' which is in capture mode
+//!
+//! IMPORTANT: Synchronous CUDA calls (cuStreamSynchronize, cudaMemcpy without 'Async' etc.) are not allowed while capturing
+using PFun_nvigiCudaGraphRecordCallback = nvigi::Result(CUstream stream, void* userData);
+
+//! Pass to 'cudaGraphRelease' to release all graphs cached for a context
+constexpr uint64_t kCudaGraphKeyAll = ~0ull;
+
+//! Priority classes for pooled streams, see 'cudaAcquireStream'
+namespace CudaStreamClass
+{
+    //! Follows the global scheduling mode
+    constexpr uint32_t kForeground = 0;
+    //! Never scheduled more aggressively than SchedulingMode::kBalance
+    constexpr uint32_t kBackground = 1;
+    //! Always scheduled as SchedulingMode::kPrioritizeGraphics
+    constexpr uint32_t kThrottled = 2;
+    constexpr uint32_t kNumOptions = 3;
+};
+
+//! Controls which queues share a CiG context, see 'cudaSetSharedContextPolicy'
+namespace CudaSharedContextPolicy
+{
+    //! Separate context for each distinct queue (default)
+    constexpr uint32_t kPerQueue = 0;
+    //! First context created on a device (ID3D12Device or VkDevice) is shared by all queues on that device
+    constexpr uint32_t kPerDevice = 1;
+    constexpr uint32_t kNumOptions = 2;
+};
+
+//! Triggered on an internal thread once the GPU finished the timed work
+using PFun_nvigiCudaGpuTimingCallback = void(uint32_t token, uint64_t gpuTimeUs, void* userData);
+
 // {68E08679-28C6-400C-B9E9-8E8FDBB6426B}
 struct alignas(8) IHWICuda {
     IHWICuda() {}; 
-    NVIGI_UID(UID({ 0x68e08679, 0x28c6, 0x400c,{ 0xb9, 0xe9, 0x8e, 0x8f, 0xdb, 0xb6, 0x42, 0x6b } }), kStructVersion3)
+    NVIGI_UID(UID({ 0x68e08679, 0x28c6, 0x400c,{ 0xb9, 0xe9, 0x8e, 0x8f, 0xdb, 0xb6, 0x42, 0x6b } }), kStructVersion10)
     // The D3D12 device and queue must be set in params
     // If a context exists for the given device and queue, it will be returned.  A new one will not be created
     nvigi::Result(*cudaGetSharedContextForQueue)(const nvigi::D3D12Parameters& params, CUcontext* ctx);
@@ -34,6 +67,88 @@ struct alignas(8) IHWICuda {
     // The Vulkan device and queue must be set in params
     // If a context exists for the given device and queue, it will be returned.  A new one will not be created
     nvigi::Result(*cudaGetSharedContextForVulkanQueue)(const nvigi::VulkanParameters& params, CUcontext* ctx);
+
+    // v4: CUDA graphs
+    // Captures the work issued by 'record' on 'stream' and launches it as a CUDA graph cached per context and 'graphKey'
+    // A plugin typically derives 'graphKey' from the shapes of the evaluation so each shape is instantiated only once,
+    // subsequent calls with the same key update the cached executable graph in place (node parameters only) which is much cheaper than instantiating.
+    // The global scheduling mode is applied to 'stream' before each launch.
+    // Cached graphs are released together with the last reference to the shared context (see cudaReleaseSharedContext).
+    nvigi::Result(*cudaGraphCaptureAndLaunch)(CUcontext ctx, CUstream stream, uint64_t graphKey, PFun_nvigiCudaGraphRecordCallback* record, void* userData);
+
+    // Launches the cached graph as is, without capturing, when nothing changed since the last capture (same buffers and parameters)
+    // Returns kResultItemNotFound if nothing was captured for the given key
+    nvigi::Result(*cudaGraphLaunch)(CUcontext ctx, CUstream stream, uint64_t graphKey);
+
+    // Releases the graph cached for 'graphKey' or all graphs for the context if 'graphKey' is kCudaGraphKeyAll
+    nvigi::Result(*cudaGraphRelease)(CUcontext ctx, uint64_t graphKey);
+
+    // v5: Stream pool
+    // Returns a non-blocking stream from the pool owned by the shared context, a new one is created only if the pool is empty
+    // Pooled streams are tagged with the global scheduling mode (limited by their class) and re-tagged automatically when the mode changes
+    // so there is no need to call cudaApplyGlobalGpuInferenceSchedulingMode for them. Class also selects the CUDA stream priority.
+    // Streams are destroyed together with the last reference to the shared context (see cudaReleaseSharedContext)
+    nvigi::Result(*cudaAcquireStream)(CUcontext ctx, uint32_t streamClass, CUstream* stream);
+
+    // Returns the stream to the pool, any pending work is NOT waited on and stays ordered before the next user's work
+    nvigi::Result(*cudaReleaseStream)(CUcontext ctx, CUstream stream);
+
+    // v6: GPU timing
+    // Records a pair of pooled events around the inference work on 'stream', 'cudaGpuTimingBegin' before the first inference command
+    // and 'cudaGpuTimingEnd' after the last one. Callback receives the GPU time asynchronously once the stream reaches the end event.
+    nvigi::Result(*cudaGpuTimingBegin)(CUstream stream, uint32_t* token);
+    nvigi::Result(*cudaGpuTimingEnd)(CUstream stream, uint32_t token, PFun_nvigiCudaGpuTimingCallback* callback, void* userData);
+
+    // v7: Vulkan interop
+    // Maps Vulkan device memory into the CUDA context without copies, memory must be allocated with VkExportMemoryAllocateInfo
+    // (VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_WIN32_BIT on Windows, VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT elsewhere).
+    // 'allocationSize' is the size used in VkMemoryAllocateInfo, 'offset' and 'size' select the range (e.g. VkBuffer bound to the memory).
+    // Mapping is valid until cudaReleaseVulkanMemory or until the shared context is released.
+    nvigi::Result(*cudaImportVulkanMemory)(CUcontext ctx, VkDevice device, VkDeviceMemory memory, uint64_t allocationSize, uint64_t offset, uint64_t size, CUdeviceptr* devicePtr);
+    nvigi::Result(*cudaReleaseVulkanMemory)(CUcontext ctx, CUdeviceptr devicePtr);
+
+    // GPU side synchronization with Vulkan timeline semaphores created with VkExportSemaphoreCreateInfo (OPAQUE_WIN32 or OPAQUE_FD)
+    // Wait makes work submitted to 'stream' afterwards wait for 'value' (e.g. VulkanData::semaphoreValue), signal sets 'value' once
+    // preceding work on 'stream' is done so Vulkan can consume the results. Semaphores are imported once and cached.
+    nvigi::Result(*cudaWaitVulkanSemaphore)(CUcontext ctx, VkDevice device, VkSemaphore semaphore, uint64_t value, CUstream stream);
+    nvigi::Result(*cudaSignalVulkanSemaphore)(CUcontext ctx, VkDevice device, VkSemaphore semaphore, uint64_t value, CUstream stream);
+    // Must be called before the semaphore is destroyed on the Vulkan side
+    nvigi::Result(*cudaReleaseVulkanSemaphore)(CUcontext ctx, VkSemaphore semaphore);
+
+    // v8: Shared context registry
+    // Selects how contexts are shared, see CudaSharedContextPolicy. Each CiG context has its own memory pools and scheduling overhead
+    // so engines giving ASR, LLM, TTS etc. different queues on the same device should use kPerDevice. Only affects contexts
+    // requested after the call, contexts which are already handed out stay as they are.
+    nvigi::Result(*cudaSetSharedContextPolicy)(uint32_t policy);
+
+    // Same as cudaGetSharedContextForQueue/cudaGetSharedContextForVulkanQueue but meant to be called during engine init (next to d3d12InitScheduler)
+    // so the first createInstance does not pay for the context creation. Returned context holds a reference, release it with cudaReleaseSharedContext.
+    // 'creationTimeUs' (optional) receives the time spent creating the context or 0 if it was already cached.
+    nvigi::Result(*cudaPrewarmSharedContextForQueue)(const nvigi::D3D12Parameters& params, CUcontext* ctx, uint64_t* creationTimeUs);
+    nvigi::Result(*cudaPrewarmSharedContextForVulkanQueue)(const nvigi::VulkanParameters& params, CUcontext* ctx, uint64_t* creationTimeUs);
+
+    // v9: Pinned host memory
+    // Page-locked host memory pooled per shared context, so all plugins on the context draw from the same blocks. Blocks are recycled
+    // by size class and freed together with the last reference to the shared context (see cudaReleaseSharedContext).
+    // Hosts can allocate input buffers (audio, prompts, images) here and pass them as CpuData, plugins then upload them without staging.
+    nvigi::Result(*cudaAllocatePinnedMemory)(CUcontext ctx, size_t size, void** ptr);
+
+    // If 'stream' is provided the block is recycled only once work issued to 'stream' so far completes, otherwise the GPU must be done with it
+    nvigi::Result(*cudaReleasePinnedMemory)(CUcontext ctx, void* ptr, CUstream stream);
+
+    // Asynchronous copies on 'stream'. Pinned memory from the pool is copied directly, pageable memory is staged through a pooled block
+    // so the copy still overlaps with kernels. Pageable 'src' can be reused as soon as the call returns, pageable 'dst' must stay valid
+    // until 'stream' reaches the copy.
+    nvigi::Result(*cudaCopyToDeviceAsync)(CUcontext ctx, CUdeviceptr dst, const void* src, size_t size, CUstream stream);
+    nvigi::Result(*cudaCopyToHostAsync)(CUcontext ctx, void* dst, CUdeviceptr src, size_t size, CUstream stream);
+
+    // v10: GPU timing
+    // Drops measurements still pending for 'userData' (as passed to cudaGpuTimingEnd), once this returns their callback is never
+    // triggered. Blocks only while a callback is running, must not be called from within the callback.
+    // Call before 'userData' is released or before destroying a context which has measurements in flight.
+    nvigi::Result(*cudaGpuTimingAbort)(void* userData);
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
 };
 
 NVIGI_VALIDATE_STRUCT(IHWICuda)
@@ -72,6 +72,50 @@ TEST_CASE("hwi_cuda", "[hwi],[cuda]")
         CUcontext old = nullptr;
         err = cuCtxPopCurrent(&old);
         REQUIRE(err == CUDA_SUCCESS);
+
+        if (nvigi::params.icig->getVersion() >= kStructVersion9)
+        {
+            // Round trip through pinned and pageable memory, both directions must be asynchronous
+            constexpr size_t kSize = 100 * 1024 + 3;
+            std::vector<uint8_t> pageable(kSize), result(kSize);
+            for (size_t i = 0; i < kSize; i++) pageable[i] = uint8_t(i * 7);
+
+            void* pinned{};
+            REQUIRE(nvigi::params.icig->cudaAllocatePinnedMemory(cuCtx, kSize, &pinned) == nvigi::kResultOk);
+            memcpy(pinned, pageable.data(), kSize);
+
+            CUstream stream{};
+            REQUIRE(nvigi::params.icig->cudaAcquireStream(cuCtx, CudaStreamClass::kForeground, &stream) == nvigi::kResultOk);
+            REQUIRE(cuCtxPushCurrent(cuCtx) == CUDA_SUCCESS);
+            CUdeviceptr device0{}, device1{};
+            REQUIRE(cuMemAlloc(&device0, kSize) == CUDA_SUCCESS);
+            REQUIRE(cuMemAlloc(&device1, kSize) == CUDA_SUCCESS);
+            REQUIRE(cuCtxPopCurrent(&old) == CUDA_SUCCESS);
+
+            REQUIRE(nvigi::params.icig->cudaCopyToDeviceAsync(cuCtx, device0, pinned, kSize, stream) == nvigi::kResultOk);
+            REQUIRE(nvigi::params.icig->cudaCopyToDeviceAsync(cuCtx, device1, pageable.data(), kSize, stream) == nvigi::kResultOk);
+            // Staged upload already owns a copy of the source
+            std::fill(pageable.begin(), pageable.end(), uint8_t(0));
+            REQUIRE(nvigi::params.icig->cudaCopyToHostAsync(cuCtx, result.data(), device1, kSize, stream) == nvigi::kResultOk);
+            REQUIRE(nvigi::params.icig->cudaCopyToHostAsync(cuCtx, pageable.data(), device0, kSize, stream) == nvigi::kResultOk);
+            REQUIRE(nvigi::params.icig->cudaReleasePinnedMemory(cuCtx, pinned, stream) == nvigi::kResultOk);
+            REQUIRE(nvigi::params.icig->cudaReleasePinnedMemory(cuCtx, pinned, stream) == nvigi::kResultInvalidParameter);
+            REQUIRE(cuStreamSynchronize(stream) == CUDA_SUCCESS);
+            REQUIRE(pageable == result);
+            REQUIRE(result[kSize - 1] == uint8_t((kSize - 1) * 7));
+
+            // Blocks of the same size class are recycled once the stream is done with them, staging blocks included
+            void* recycled{};
+            REQUIRE(nvigi::params.icig->cudaAllocatePinnedMemory(cuCtx, kSize - 1024, &recycled) == nvigi::kResultOk);
+            REQUIRE(recycled != nullptr);
+            REQUIRE(nvigi::params.icig->cudaReleasePinnedMemory(cuCtx, recycled, nullptr) == nvigi::kResultOk);
+
+            REQUIRE(cuCtxPushCurrent(cuCtx) == CUDA_SUCCESS);
+            cuMemFree(device0);
+            cuMemFree(device1);
+            REQUIRE(cuCtxPopCurrent(&old) == CUDA_SUCCESS);
+            REQUIRE(nvigi::params.icig->cudaReleaseStream(cuCtx, stream) == nvigi::kResultOk);
+        }
     }
 
     if (compatChecker)
@@ -13,13 +13,19 @@
 #include "source/plugins/nvigi.hwi/common/nvigi_hwi_common.h"
 #include "_artifacts/gitVersion.h"
 
+#include "source/utils/nvigi.hwi/gpu_timing.h"
+
 #include "d3d_scheduler_settings.h"
 #include "nvigi_hwi_d3d12.h"
 
 #include "dxgi.h"
 #include "nvapi.h"
 
+#include <map>
+#include <mutex>
 #include <unordered_set>
+#include <unordered_map>
+#include <vector>
 
 namespace nvigi
 {
@@ -43,7 +49,49 @@ struct D3D12Context
     CigSchedulerSettingsAPI sched;
     HMODULE cigHelper{};
 
+    // Plugins initialize the scheduler from createInstance which can run on any thread
+    std::mutex schedulerMutex;
     std::unordered_set<ID3D12Device*> initializedDevices;
+
+    struct ComputeQueue
+    {
+        ID3D12CommandQueue* queue{};
+        ID3D12Fence* fence{};
+        uint64_t value{};
+        int64_t refcount{};
+    };
+
+    //! Pooled compute queues, one per device and D3D12QueueClass
+    std::mutex queueMutex;
+    std::map<std::pair<ID3D12Device*, uint32_t>, ComputeQueue> computeQueues;
+
+    //! Timestamp query pairs and matching readback slots, one pool per device
+    struct GpuTimingHeap
+    {
+        static constexpr uint32_t kMaxInFlight = 256;
+        ID3D12QueryHeap* queryHeap{};
+        ID3D12Resource* readback{};
+        std::vector<uint32_t> freeSlots;
+    };
+    struct GpuTiming
+    {
+        GpuTimingHeap* heap{};
+        uint32_t slot{};
+    };
+    struct GpuTimingFence
+    {
+        ID3D12Fence* fence{};
+        uint64_t value{};
+    };
+
+    //! Keyed by IDs stored as private data (see d3d12GetTimingObjectId), host objects can be recreated at the same address
+    std::mutex timingMutex;
+    std::unordered_map<uint64_t, GpuTimingHeap> timingHeaps;
+    std::unordered_map<uint64_t, GpuTimingFence> timingFences;
+    std::unordered_map<uint32_t, GpuTiming> timings;
+    uint32_t nextTimingToken{};
+    uint64_t nextTimingObjectId{};
+    gpu_timing::Resolver timingResolver;
 };
 };
 
@@ -123,6 +171,7 @@ static nvigi::Result d3d12InitScheduler(ID3D12Device* device)
     auto& ctx = (*hwiD3D12::getContext());
     nvigi::Result retval = kResultOk;
 
+    std::scoped_lock lock(ctx.schedulerMutex);
     bool found = (ctx.initializedDevices.find(device) != ctx.initializedDevices.end());
     if (!found)
     {
@@ -139,6 +188,264 @@ static nvigi::Result d3d12InitScheduler(ID3D12Device* device)
     return retval;
 }
 
+// {CC11D169-CAAB-4664-8EFE-380CA2EEE2E1}
+static const GUID kGpuTimingObjectIdGuid = { 0xcc11d169, 0xcaab, 0x4664, { 0x8e, 0xfe, 0x38, 0x0c, 0xa2, 0xee, 0xe2, 0xe1 } };
+
+//! Must be called with timing mutex locked, ID lives with the object so it is never shared with a later object at the same address
+static uint64_t d3d12GetTimingObjectId(ID3D12Object* object)
+{
+    auto& ctx = (*hwiD3D12::getContext());
+    uint64_t id{};
+    UINT size = sizeof(id);
+    if (FAILED(object->GetPrivateData(kGpuTimingObjectIdGuid, &size, &id)) || size != sizeof(id))
+    {
+        id = ++ctx.nextTimingObjectId;
+        object->SetPrivateData(kGpuTimingObjectIdGuid, sizeof(id), &id);
+    }
+    return id;
+}
+
+static nvigi::Result d3d12GpuTimingBegin(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, uint32_t* token)
+{
+    if (!device || !commandList || !token)
+        return kResultInvalidParameter;
+
+    auto& ctx = (*hwiD3D12::getContext());
+    std::scoped_lock lock(ctx.timingMutex);
+
+    auto deviceId = d3d12GetTimingObjectId(device);
+    auto& heap = ctx.timingHeaps[deviceId];
+    if (!heap.queryHeap)
+    {
+        using GpuTimingHeap = hwiD3D12::D3D12Context::GpuTimingHeap;
+        D3D12_QUERY_HEAP_DESC queryDesc{ D3D12_QUERY_HEAP_TYPE_TIMESTAMP, 2 * GpuTimingHeap::kMaxInFlight, 0 };
+        D3D12_HEAP_PROPERTIES heapProps{ D3D12_HEAP_TYPE_READBACK };
+        D3D12_RESOURCE_DESC bufferDesc{};
+        bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        bufferDesc.Width = 2 * GpuTimingHeap::kMaxInFlight * sizeof(uint64_t);
+        bufferDesc.Height = bufferDesc.DepthOrArraySize = bufferDesc.MipLevels = 1;
+        bufferDesc.SampleDesc.Count = 1;
+        bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+        if (FAILED(device->CreateQueryHeap(&queryDesc, IID_PPV_ARGS(&heap.queryHeap))) ||
+            FAILED(device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&heap.readback))))
+        {
+            NVIGI_LOG_ERROR("Failed to create GPU timing query heap");
+            if (heap.queryHeap) heap.queryHeap->Release();
+            ctx.timingHeaps.erase(deviceId);
+            return kResultInvalidState;
+        }
+        for (uint32_t i = GpuTimingHeap::kMaxInFlight; i > 0; i--) heap.freeSlots.push_back(i - 1);
+    }
+    if (heap.freeSlots.empty())
+    {
+        NVIGI_LOG_WARN_ONCE("Too many GPU timings in flight, skipping measurements");
+        return kResultInsufficientResources;
+    }
+
+    auto slot = heap.freeSlots.back();
+    heap.freeSlots.pop_back();
+    commandList->EndQuery(heap.queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, 2 * slot);
+
+    *token = ++ctx.nextTimingToken;
+    ctx.timings[*token] = { &heap, slot };
+    return kResultOk;
+}
+
+static nvigi::Result d3d12GpuTimingEnd(ID3D12GraphicsCommandList* commandList, uint32_t token)
+{
+    if (!commandList)
+        return kResultInvalidParameter;
+
+    auto& ctx = (*hwiD3D12::getContext());
+    std::scoped_lock lock(ctx.timingMutex);
+
+    auto it = ctx.timings.find(token);
+    if (it == ctx.timings.end())
+        return kResultItemNotFound;
+
+    auto& [heap, slot] = it->second;
+    commandList->EndQuery(heap->queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, 2 * slot + 1);
+    commandList->ResolveQueryData(heap->queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, 2 * slot, 2, heap->readback, 2 * slot * sizeof(uint64_t));
+    return kResultOk;
+}
+
+static nvigi::Result d3d12GpuTimingSubmit(ID3D12CommandQueue* queue, uint32_t token, PFun_nvigiD3D12GpuTimingCallback* callback, void* userData)
+{
+    if (!queue || !callback)
+        return kResultInvalidParameter;
+
+    auto& ctx = (*hwiD3D12::getContext());
+    std::scoped_lock lock(ctx.timingMutex);
+
+    auto it = ctx.timings.find(token);
+    if (it == ctx.timings.end())
+        return kResultItemNotFound;
+    auto timing = it->second;
+    ctx.timings.erase(it);
+
+    auto queueId = d3d12GetTimingObjectId(queue);
+    auto& fence = ctx.timingFences[queueId];
+    if (!fence.fence)
+    {
+        ID3D12Device* device{};
+        queue->GetDevice(IID_PPV_ARGS(&device));
+        if (!device || FAILED(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence.fence))))
+        {
+            if (device) device->Release();
+            ctx.timingFences.erase(queueId);
+            timing.heap->freeSlots.push_back(timing.slot);
+            NVIGI_LOG_ERROR("Failed to create GPU timing fence");
+            return kResultInvalidState;
+        }
+        device->Release();
+    }
+    auto value = ++fence.value;
+    queue->Signal(fence.fence, value);
+
+    uint64_t frequency = 0;
+    queue->GetTimestampFrequency(&frequency);
+
+    ctx.timingResolver.submit({ queueId, userData }, [fence = fence.fence, value, timing, frequency, token, callback, userData](bool shuttingDown)->bool
+    {
+        auto& ctx = (*hwiD3D12::getContext());
+        if (!shuttingDown && fence->GetCompletedValue() < value)
+        {
+            // Short wait so we don't spin but can still observe shutdown
+            HANDLE event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+            fence->SetEventOnCompletion(value, event);
+            WaitForSingleObject(event, 100);
+            CloseHandle(event);
+            if (fence->GetCompletedValue() < value) return false;
+        }
+        if (!shuttingDown && frequency)
+        {
+            D3D12_RANGE range{ 2 * timing.slot * sizeof(uint64_t), 2 * (timing.slot + 1) * sizeof(uint64_t) };
+            uint64_t* data{};
+            if (SUCCEEDED(timing.heap->readback->Map(0, &range, (void**)&data)))
+            {
+                auto ticks = data[2 * timing.slot + 1] > data[2 * timing.slot] ? data[2 * timing.slot + 1] - data[2 * timing.slot] : 0;
+                D3D12_RANGE written{};
+                timing.heap->readback->Unmap(0, &written);
+                callback(token, ticks * 1000000 / frequency, userData);
+            }
+        }
+        std::scoped_lock lock(ctx.timingMutex);
+        timing.heap->freeSlots.push_back(timing.slot);
+        return true;
+    });
+    return kResultOk;
+}
+
+static nvigi::Result d3d12GpuTimingAbort(void* userData)
+{
+    auto& ctx = (*hwiD3D12::getContext());
+    ctx.timingResolver.abort([userData](const gpu_timing::Resolver::Tag& tag) { return tag.userData == userData; });
+    return kResultOk;
+}
+
+//! Must be called with queue mutex locked, waits for the GPU so the queue is not destroyed with work in flight
+static void d3d12DestroyComputeQueue(hwiD3D12::D3D12Context::ComputeQueue& entry)
+{
+    if (entry.fence && entry.queue && SUCCEEDED(entry.queue->Signal(entry.fence, ++entry.value)) && entry.fence->GetCompletedValue() < entry.value)
+    {
+        HANDLE event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+        entry.fence->SetEventOnCompletion(entry.value, event);
+        WaitForSingleObject(event, INFINITE);
+        CloseHandle(event);
+    }
+    if (entry.fence) entry.fence->Release();
+    if (entry.queue) entry.queue->Release();
+    entry = {};
+}
+
+static nvigi::Result d3d12AcquireComputeQueue(ID3D12Device* device, uint32_t queueClass, ID3D12CommandQueue** queue)
+{
+    if (!device || !queue || queueClass >= D3D12QueueClass::kNumOptions)
+        return kResultInvalidParameter;
+
+    auto& ctx = (*hwiD3D12::getContext());
+    std::scoped_lock lock(ctx.queueMutex);
+
+    auto key = std::make_pair(device, queueClass);
+    auto& entry = ctx.computeQueues[key];
+    if (!entry.queue)
+    {
+        // Scheduler must be initialized before the queue is created, otherwise scheduling modes do not apply to it
+        if (d3d12InitScheduler(device) != kResultOk)
+        {
+            NVIGI_LOG_WARN_ONCE("D3D12 scheduler failed to init, requires 580 driver or higher");
+        }
+
+        D3D12_COMMAND_QUEUE_DESC desc{ D3D12_COMMAND_LIST_TYPE_COMPUTE };
+        desc.Priority = queueClass == D3D12QueueClass::kForeground ? D3D12_COMMAND_QUEUE_PRIORITY_HIGH : D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+        if (FAILED(device->CreateCommandQueue(&desc, IID_PPV_ARGS(&entry.queue))) ||
+            FAILED(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&entry.fence))))
+        {
+            NVIGI_LOG_ERROR("Failed to create pooled D3D12 compute queue");
+            d3d12DestroyComputeQueue(entry);
+            ctx.computeQueues.erase(key);
+            return kResultInvalidState;
+        }
+        entry.queue->SetName(queueClass == D3D12QueueClass::kForeground ? L"nvigi.compute.foreground" : L"nvigi.compute.background");
+
+        // Inference is not part of the frame, keep Reflex and frame pacing from waiting on it
+        if (d3d12NotifyOutOfBandCommandQueue(entry.queue, OutOfBandCommandQueueType::kIgnore) != kResultOk)
+        {
+            NVIGI_LOG_WARN_ONCE("Failed to mark pooled compute queues as out of band, this might impact frame pacing");
+        }
+        NVIGI_LOG_INFO("Created pooled %s compute queue for device 0x%llx", queueClass == D3D12QueueClass::kForeground ? "foreground" : "background", (uint64_t)device);
+    }
+    entry.refcount++;
+    *queue = entry.queue;
+    return kResultOk;
+}
+
+static nvigi::Result d3d12ReleaseComputeQueue(ID3D12CommandQueue* queue)
+{
+    if (!queue)
+        return kResultInvalidParameter;
+
+    auto& ctx = (*hwiD3D12::getContext());
+    std::scoped_lock lock(ctx.queueMutex);
+
+    for (auto it = ctx.computeQueues.begin(); it != ctx.computeQueues.end(); it++)
+    {
+        if (it->second.queue != queue) continue;
+        if (--it->second.refcount <= 0)
+        {
+            d3d12DestroyComputeQueue(it->second);
+            ctx.computeQueues.erase(it);
+        }
+        return kResultOk;
+    }
+    NVIGI_LOG_ERROR("D3D12 queue %p is not owned by the pool", queue);
+    return kResultInvalidParameter;
+}
+
+static nvigi::Result d3d12SignalComputeQueue(ID3D12CommandQueue* queue, ID3D12Fence** fence, uint64_t* value)
+{
+    if (!queue || !fence || !value)
+        return kResultInvalidParameter;
+
+    auto& ctx = (*hwiD3D12::getContext());
+    std::scoped_lock lock(ctx.queueMutex);
+
+    for (auto& [key, entry] : ctx.computeQueues)
+    {
+        if (entry.queue != queue) continue;
+        if (FAILED(queue->Signal(entry.fence, entry.value + 1)))
+        {
+            NVIGI_LOG_ERROR("Failed to signal pooled compute queue");
+            return kResultInvalidState;
+        }
+        *fence = entry.fence;
+        *value = ++entry.value;
+        return kResultOk;
+    }
+    NVIGI_LOG_ERROR("D3D12 queue %p is not owned by the pool", queue);
+    return kResultInvalidParameter;
+}
+
 //! Making sure our implementation is covered with our exception handler
 //! 
 namespace hwiD3D12
@@ -163,6 +470,34 @@ static nvigi::Result ApplyGlobalGpuInferenceSchedulingModeToCommandList(ID3D12Gr
 {
     NVIGI_CATCH_EXCEPTION(d3d12ApplyGlobalGpuInferenceSchedulingModeToCommandList(commandList));
 }
+static nvigi::Result GpuTimingBegin(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, uint32_t* token)
+{
+    NVIGI_CATCH_EXCEPTION(d3d12GpuTimingBegin(device, commandList, token));
+}
+static nvigi::Result GpuTimingEnd(ID3D12GraphicsCommandList* commandList, uint32_t token)
+{
+    NVIGI_CATCH_EXCEPTION(d3d12GpuTimingEnd(commandList, token));
+}
+static nvigi::Result GpuTimingSubmit(ID3D12CommandQueue* queue, uint32_t token, PFun_nvigiD3D12GpuTimingCallback* callback, void* userData)
+{
+    NVIGI_CATCH_EXCEPTION(d3d12GpuTimingSubmit(queue, token, callback, userData));
+}
+static nvigi::Result GpuTimingAbort(void* userData)
+{
+    NVIGI_CATCH_EXCEPTION(d3d12GpuTimingAbort(userData));
+}
+static nvigi::Result AcquireComputeQueue(ID3D12Device* device, uint32_t queueClass, ID3D12CommandQueue** queue)
+{
+    NVIGI_CATCH_EXCEPTION(d3d12AcquireComputeQueue(device, queueClass, queue));
+}
+static nvigi::Result ReleaseComputeQueue(ID3D12CommandQueue* queue)
+{
+    NVIGI_CATCH_EXCEPTION(d3d12ReleaseComputeQueue(queue));
+}
+static nvigi::Result SignalComputeQueue(ID3D12CommandQueue* queue, ID3D12Fence** fence, uint64_t* value)
+{
+    NVIGI_CATCH_EXCEPTION(d3d12SignalComputeQueue(queue, fence, value));
+}
 } // namespace hwiD3D12
 
 //! Main entry point - get information about our plugin
@@ -215,6 +550,13 @@ Result nvigiPluginRegister(framework::IFramework* framework)
     ctx.api.d3d12NotifyOutOfBandCommandQueue = hwiD3D12::NotifyOutOfBandCommandQueue;
     ctx.api.d3d12InitScheduler = hwiD3D12::InitScheduler;
     ctx.api.d3d12ApplyGlobalGpuInferenceSchedulingModeToCommandList = hwiD3D12::ApplyGlobalGpuInferenceSchedulingModeToCommandList;
+    ctx.api.d3d12GpuTimingBegin = hwiD3D12::GpuTimingBegin;
+    ctx.api.d3d12GpuTimingEnd = hwiD3D12::GpuTimingEnd;
+    ctx.api.d3d12GpuTimingSubmit = hwiD3D12::GpuTimingSubmit;
+    ctx.api.d3d12GpuTimingAbort = hwiD3D12::GpuTimingAbort;
+    ctx.api.d3d12AcquireComputeQueue = hwiD3D12::AcquireComputeQueue;
+    ctx.api.d3d12ReleaseComputeQueue = hwiD3D12::ReleaseComputeQueue;
+    ctx.api.d3d12SignalComputeQueue = hwiD3D12::SignalComputeQueue;
 
     framework->addInterface(plugin::hwi::d3d12::kId, &ctx.api, 0);
 
@@ -278,6 +620,28 @@ Result nvigiPluginDeregister()
 {
     auto& ctx = (*hwiD3D12::getContext());
 
+    // Pending timings are dropped, callbacks are not triggered after this point
+    ctx.timingResolver.stop();
+    for (auto& [queue, fence] : ctx.timingFences) fence.fence->Release();
+    for (auto& [device, heap] : ctx.timingHeaps)
+    {
+        heap.queryHeap->Release();
+        heap.readback->Release();
+    }
+    ctx.timingFences.clear();
+    ctx.timingHeaps.clear();
+    ctx.timings.clear();
+
+    {
+        std::scoped_lock lock(ctx.queueMutex);
+        if (!ctx.computeQueues.empty())
+        {
+            NVIGI_LOG_WARN("Destroying %zu pooled compute queue(s) which were never released", ctx.computeQueues.size());
+        }
+        for (auto& [key, entry] : ctx.computeQueues) d3d12DestroyComputeQueue(entry);
+        ctx.computeQueues.clear();
+    }
+
     framework::releaseInterface(plugin::getContext()->framework, nvigi::plugin::hwi::common::kId, ctx.hwiCommon);
 
     // We know this is a valid handle otherwise plugin register would have failed
@@ -22,11 +22,24 @@ enum class OutOfBandCommandQueueType : int
     kRenderPresent = 3,
 };
 
+//! Priority classes for pooled compute queues, see 'd3d12AcquireComputeQueue'
+namespace D3D12QueueClass
+{
+    //! D3D12_COMMAND_QUEUE_PRIORITY_HIGH, for latency sensitive inference (ASR, NPC replies)
+    constexpr uint32_t kForeground = 0;
+    //! D3D12_COMMAND_QUEUE_PRIORITY_NORMAL
+    constexpr uint32_t kBackground = 1;
+    constexpr uint32_t kNumOptions = 2;
+};
+
+//! Triggered on an internal thread once the GPU finished the timed work
+using PFun_nvigiD3D12GpuTimingCallback = void(uint32_t token, uint64_t gpuTimeUs, void* userData);
+
 //! {EAE8496C-327C-4FEB-8940-2A8C63CB9A6A}
 struct alignas(8) IHWID3D12
 {
     IHWID3D12() {};
-    NVIGI_UID(UID({ 0xeae8496c, 0x327c, 0x4feb,{0x89, 0x40, 0x2a, 0x8c, 0x63, 0xcb, 0x9a, 0x6a} }), kStructVersion4)
+    NVIGI_UID(UID({ 0xeae8496c, 0x327c, 0x4feb,{0x89, 0x40, 0x2a, 0x8c, 0x63, 0xcb, 0x9a, 0x6a} }), kStructVersion7)
 
     // Called by plugins to apply the global scheduling mode to all work launched on the current thread
     nvigi::Result(*d3d12ApplyGlobalGpuInferenceSchedulingModeToThread)(ID3D12Device* device);
@@ -45,7 +58,37 @@ struct alignas(8) IHWID3D12
     // Called by plugins to apply the global scheduling mode to all work launched on the given command list
     nvigi::Result(*d3d12ApplyGlobalGpuInferenceSchedulingModeToCommandList)(ID3D12GraphicsCommandList* commandList);
 
-    //! v5+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
+    // v5
+    // GPU timing, records timestamp queries around the inference work on a command list:
+    //
+    // * d3d12GpuTimingBegin - before the first inference command, returns token identifying the measurement
+    // * d3d12GpuTimingEnd - after the last inference command, resolves the queries into an internal readback buffer
+    // * d3d12GpuTimingSubmit - after the command list is executed on the queue, callback receives the GPU time asynchronously
+    //
+    // Queries are pooled per device, returns kResultInsufficientResources when too many measurements are in flight
+    nvigi::Result(*d3d12GpuTimingBegin)(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, uint32_t* token);
+    nvigi::Result(*d3d12GpuTimingEnd)(ID3D12GraphicsCommandList* commandList, uint32_t token);
+    nvigi::Result(*d3d12GpuTimingSubmit)(ID3D12CommandQueue* queue, uint32_t token, PFun_nvigiD3D12GpuTimingCallback* callback, void* userData);
+
+    // v6
+    // Compute queue pool, at most one queue per device and class is created and it is shared by all plugins so inference
+    // never lands on the host's direct queue. Queues are created once the scheduler is initialized for the device (see d3d12InitScheduler)
+    // and are marked as OutOfBandCommandQueueType::kIgnore so they overlap graphics instead of being counted as frame work.
+    // Command lists still need d3d12ApplyGlobalGpuInferenceSchedulingModeToCommandList. Returned queue holds a reference which
+    // must be returned with d3d12ReleaseComputeQueue (not ID3D12CommandQueue::Release), see also 'd3d12::getComputeQueue' helper.
+    nvigi::Result(*d3d12AcquireComputeQueue)(ID3D12Device* device, uint32_t queueClass, ID3D12CommandQueue** queue);
+    nvigi::Result(*d3d12ReleaseComputeQueue)(ID3D12CommandQueue* queue);
+
+    // Timeline shared by everyone submitting to a pooled queue, signals it once all work submitted so far completes.
+    // Host or another queue can wait on 'fence' and 'value' on the GPU (ID3D12CommandQueue::Wait), fence lives as long as the queue.
+    nvigi::Result(*d3d12SignalComputeQueue)(ID3D12CommandQueue* queue, ID3D12Fence** fence, uint64_t* value);
+
+    // v7
+    // Drops GPU timing measurements still pending for 'userData' (as passed to d3d12GpuTimingSubmit), once this returns their callback
+    // is never triggered. Blocks only while a callback is running, must not be called from within the callback.
+    nvigi::Result(*d3d12GpuTimingAbort)(void* userData);
+
+    //! v8+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
 };
 
 NVIGI_VALIDATE_STRUCT(IHWID3D12)
@@ -4,13 +4,30 @@
 
 #include "source/core/nvigi.log/log.h"
 #include "source/core/nvigi.extra/extra.h"
+#include "source/core/nvigi.trace/trace.h"
+#include "source/core/nvigi.metrics/metrics.h"
 #include "source/plugins/nvigi.net/net.h"
 #define CURL_STATICLIB
 #include "external/libcurl/include/curl/curl.h"
 #include "external/json/source/nlohmann/json.hpp"
 #include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <random>
+#include <thread>
+#include <optional>
+#include <cmath>
+#include <ctime>
+#include <cctype>
+#include <algorithm>
+#include <fstream>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <string_view>
 
 using json = nlohmann::json;
+namespace fs = std::filesystem;
 
 namespace nvigi
 {
@@ -56,32 +73,129 @@ static size_t curlCallbackWriteStdString(void* contents, size_t size, size_t nme
     return newLength;
 };
 
-struct MemoryStruct {
-    const uint8_t* memory;
-    size_t size;
-    size_t position;
+// Response headers we care about
+struct ResponseHeaders {
+    uint32_t retryAfterMs = 0;
+    //! Filled in after the transfer
+    long httpStatus = 0;
+    //! Used by the response cache
+    std::string etag;
+    std::string lastModified;
+    std::string cacheControl;
+    std::string expires;
+    uint32_t ageSeconds = 0;
 };
 
-size_t curlCallbackReadBytes(void* ptr, size_t size, size_t nmemb, void* userp)
+static void trimHeaderValue(std::string& value)
 {
-    MemoryStruct* mem = (MemoryStruct*)userp;
+    value.erase(0, value.find_first_not_of(" \t"));
+    value.erase(value.find_last_not_of(" \t\r\n") + 1);
+}
 
-    if (size * nmemb < 1)
-        return 0;
+//! Delta-seconds form used by 'Retry-After' and 'Age', false for anything else (including values too large to parse)
+static bool parseHeaderSeconds(const std::string& value, uint64_t& seconds)
+{
+    if (value.empty() || value.size() > 15) return false;
+    if (!std::all_of(value.begin(), value.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; })) return false;
+    seconds = std::stoull(value);
+    return true;
+}
 
-    if (mem->position < mem->size) {
-        size_t buffer_size = size * nmemb;
-        size_t remaining_data = mem->size - mem->position;
-        size_t copy_this_much = buffer_size < remaining_data ? buffer_size : remaining_data;
+static size_t curlCallbackHeader(char* buffer, size_t size, size_t nitems, ResponseHeaders* headers)
+{
+    size_t length = size * nitems;
+    std::string line(buffer, length);
+    // New response (redirect or interim 1xx), headers from the previous one no longer apply
+    if (line.starts_with("HTTP/"))
+    {
+        *headers = {};
+        return length;
+    }
+    auto colon = line.find(':');
+    if (colon == std::string::npos) return length;
+    std::string name = line.substr(0, colon);
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+    auto value = line.substr(colon + 1);
+    trimHeaderValue(value);
+    if (name == "retry-after")
+    {
+        uint64_t seconds{};
+        if (parseHeaderSeconds(value, seconds))
+        {
+            headers->retryAfterMs = uint32_t(std::min<uint64_t>(seconds * 1000, UINT32_MAX));
+        }
+        else if (auto when = curl_getdate(value.c_str(), nullptr); when > 0)
+        {
+            // HTTP-date form
+            auto now = time(nullptr);
+            headers->retryAfterMs = when > now ? uint32_t(std::min<uint64_t>(uint64_t(when - now) * 1000, UINT32_MAX)) : 0;
+        }
+    }
+    else if (name == "etag") headers->etag = value;
+    else if (name == "last-modified") headers->lastModified = value;
+    else if (name == "cache-control") headers->cacheControl = value;
+    else if (name == "expires") headers->expires = value;
+    else if (name == "age")
+    {
+        uint64_t seconds{};
+        if (parseHeaderSeconds(value, seconds)) headers->ageSeconds = uint32_t(std::min<uint64_t>(seconds, UINT32_MAX));
+    }
+    return length;
+}
 
-        memcpy(ptr, mem->memory + mem->position, copy_this_much);
-        mem->position += copy_this_much;
+//! Paces status polling requests according to the strategy selected in the parameters
+struct StatusPoller
+{
+    StatusPoller(const Parameters& params) : rng(std::random_device{}())
+    {
+        // Older structs get the default strategy
+        static const Parameters s_defaults{};
+        cfg = params.getVersion() >= kStructVersion5 ? &params : &s_defaults;
+    }
 
-        return copy_this_much;
+    uint32_t nextDelayMs(uint32_t retryAfterMs)
+    {
+        uint32_t delay = 0;
+        switch (cfg->pollingStrategy)
+        {
+        case StatusPollingStrategy::eCustom:
+            if (cfg->pollingDelayCallback)
+            {
+                delay = cfg->pollingDelayCallback(attempt, retryAfterMs, cfg->pollingDelayUserData);
+                break;
+            }
+            [[fallthrough]];
+        case StatusPollingStrategy::eExponentialBackoff:
+        {
+            if (retryAfterMs > 0)
+            {
+                delay = retryAfterMs;
+            }
+            else if (cfg->longPollSeconds == 0)
+            {
+                // Server is not holding requests for us so back off
+                auto backoff = std::min(double(cfg->pollingMaxDelayMs),
+                    double(cfg->pollingInitialDelayMs) * std::pow(double(std::max(1.0f, cfg->pollingBackoffFactor)), double(std::min(attempt, 32u))));
+                if (cfg->pollingJitter > 0.0f)
+                {
+                    std::uniform_real_distribution<double> jitter(1.0 - cfg->pollingJitter, 1.0 + cfg->pollingJitter);
+                    backoff *= jitter(rng);
+                }
+                delay = uint32_t(std::max(0.0, backoff));
+            }
+            break;
+        }
+        case StatusPollingStrategy::eImmediate:
+            break;
+        }
+        attempt++;
+        return delay;
     }
 
-    return 0; // No more data left to deliver
-}
+    const Parameters* cfg{};
+    uint32_t attempt{};
+    std::minstd_rand rng;
+};
 
 // Custom debug function with optional credential redaction
 int curlCallbackDebug(CURL* handle, curl_infotype type, char* data, size_t size, void* userptr) 
@@ -124,12 +238,339 @@ int curlCallbackDebug(CURL* handle, curl_infotype type, char* data, size_t size,
     return 0; // Return 0 to indicate success
 }
 
+//! Incremental SSE/NDJSON splitter behind 'StreamFraming'
+//!
+//! Complete lines are consumed straight from CURL's buffer, only an incomplete tail is carried over to the next chunk.
+struct StreamFramer
+{
+    StreamFramer(const StreamFraming& framing) : format(framing.format), callback(framing.eventCallback), userdata(framing.eventUserData)
+    {
+        if (framing.endOfStream) endOfStream = framing.endOfStream;
+        for (size_t i = 0; i < framing.fieldCount; i++)
+        {
+            std::vector<std::string> path;
+            std::string_view field = framing.fields[i];
+            while (!field.empty())
+            {
+                auto slash = field.find('/');
+                path.emplace_back(field.substr(0, slash));
+                field = slash == std::string_view::npos ? std::string_view{} : field.substr(slash + 1);
+            }
+            paths.push_back(std::move(path));
+        }
+        scratch.resize(paths.size());
+        values.resize(paths.size());
+        sizes.resize(paths.size());
+    }
+
+    //! False aborts the transfer
+    bool feed(const char* data, size_t size)
+    {
+        if (done) return true;
+        std::string_view chunk(data, size);
+        if (!tail.empty())
+        {
+            // Only the new bytes can complete the pending line
+            auto newline = chunk.find('\n');
+            if (newline == std::string_view::npos)
+            {
+                tail.append(chunk);
+                return true;
+            }
+            tail.append(chunk.substr(0, newline));
+            std::string line = std::move(tail);
+            tail.clear();
+            if (!processLine(line)) return false;
+            chunk.remove_prefix(newline + 1);
+        }
+        size_t newline;
+        while (!done && (newline = chunk.find('\n')) != std::string_view::npos)
+        {
+            if (!processLine(chunk.substr(0, newline))) return false;
+            chunk.remove_prefix(newline + 1);
+        }
+        if (!done) tail.assign(chunk);
+        return true;
+    }
+
+    //! Event callback asked to abort the transfer
+    bool stopped = false;
+
+    //! Delivers an event left open when the server closed the stream
+    bool finish()
+    {
+        if (!tail.empty())
+        {
+            std::string line = std::move(tail);
+            tail.clear();
+            if (!processLine(line)) return false;
+        }
+        return format != StreamFormat::eSSE || processLine({});
+    }
+
+private:
+    bool processLine(std::string_view line)
+    {
+        if (done) return true;
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (format == StreamFormat::eNDJSON)
+        {
+            return line.empty() || dispatch({}, line);
+        }
+
+        if (line.empty())
+        {
+            if (!hasData)
+            {
+                eventType.clear();
+                return true;
+            }
+            hasData = false;
+            bool result = dispatch(eventType, eventData);
+            eventType.clear();
+            eventData.clear();
+            return result;
+        }
+        // Comment, typically a keep-alive
+        if (line.front() == ':') return true;
+        auto colon = line.find(':');
+        auto name = line.substr(0, colon);
+        std::string_view value;
+        if (colon != std::string_view::npos)
+        {
+            value = line.substr(colon + 1);
+            if (!value.empty() && value.front() == ' ') value.remove_prefix(1);
+        }
+        if (name == "data")
+        {
+            if (hasData) eventData.push_back('\n');
+            eventData.append(value);
+            hasData = true;
+        }
+        else if (name == "event")
+        {
+            eventType.assign(value);
+        }
+        // 'id' and 'retry' are only meaningful for EventSource reconnection
+        return true;
+    }
+
+    bool dispatch(std::string_view type, std::string_view data)
+    {
+        if (!endOfStream.empty() && data == endOfStream)
+        {
+            done = true;
+            return true;
+        }
+        for (size_t i = 0; i < paths.size(); i++)
+        {
+            std::string_view value;
+            bool found = extractField(data, paths[i], scratch[i], value);
+            values[i] = found ? value.data() : nullptr;
+            sizes[i] = found ? value.size() : 0;
+        }
+        StreamEvent event{};
+        event.type = type.data();
+        event.typeSize = type.size();
+        event.data = data.data();
+        event.dataSize = data.size();
+        event.fieldValues = values.data();
+        event.fieldSizes = sizes.data();
+        event.fieldCount = values.size();
+        stopped = !callback(event, userdata);
+        return !stopped;
+    }
+
+    static void skipWhitespace(std::string_view json, size_t& i)
+    {
+        while (i < json.size() && (json[i] == ' ' || json[i] == '\t' || json[i] == '\n' || json[i] == '\r')) i++;
+    }
+
+    //! Leaves 'i' after the closing quote, false if unterminated
+    static bool skipString(std::string_view json, size_t& i)
+    {
+        for (i++; i < json.size(); i++)
+        {
+            if (json[i] == '\\') i++;
+            else if (json[i] == '"') return ++i, true;
+        }
+        return false;
+    }
+
+    static bool skipValue(std::string_view json, size_t& i)
+    {
+        skipWhitespace(json, i);
+        if (i >= json.size()) return false;
+        if (json[i] == '"') return skipString(json, i);
+        if (json[i] == '{' || json[i] == '[')
+        {
+            int depth = 0;
+            while (i < json.size())
+            {
+                char c = json[i];
+                if (c == '"')
+                {
+                    if (!skipString(json, i)) return false;
+                    continue;
+                }
+                if (c == '{' || c == '[') depth++;
+                else if ((c == '}' || c == ']') && --depth == 0) return ++i, true;
+                i++;
+            }
+            return false;
+        }
+        // Number, true, false or null
+        while (i < json.size() && json[i] != ',' && json[i] != '}' && json[i] != ']' && json[i] != ' ' && json[i] != '\n' && json[i] != '\r' && json[i] != '\t') i++;
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t cp)
+    {
+        if (cp < 0x80) out.push_back(char(cp));
+        else if (cp < 0x800) { out.push_back(char(0xc0 | (cp >> 6))); out.push_back(char(0x80 | (cp & 0x3f))); }
+        else if (cp < 0x10000) { out.push_back(char(0xe0 | (cp >> 12))); out.push_back(char(0x80 | ((cp >> 6) & 0x3f))); out.push_back(char(0x80 | (cp & 0x3f))); }
+        else { out.push_back(char(0xf0 | (cp >> 18))); out.push_back(char(0x80 | ((cp >> 12) & 0x3f))); out.push_back(char(0x80 | ((cp >> 6) & 0x3f))); out.push_back(char(0x80 | (cp & 0x3f))); }
+    }
+
+    static bool parseHex4(std::string_view s, size_t i, uint32_t& cp)
+    {
+        if (i + 4 > s.size()) return false;
+        cp = 0;
+        for (size_t k = i; k < i + 4; k++)
+        {
+            char c = s[k];
+            cp <<= 4;
+            if (c >= '0' && c <= '9') cp |= c - '0';
+            else if (c >= 'a' && c <= 'f') cp |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') cp |= c - 'A' + 10;
+            else return false;
+        }
+        return true;
+    }
+
+    //! 'raw' includes the quotes, result is a view into 'raw' when nothing is escaped (the common case for tokens)
+    static std::string_view unescape(std::string_view raw, std::string& out)
+    {
+        auto body = raw.substr(1, raw.size() - 2);
+        if (body.find('\\') == std::string_view::npos) return body;
+        out.clear();
+        for (size_t i = 0; i < body.size(); i++)
+        {
+            if (body[i] != '\\' || i + 1 >= body.size())
+            {
+                out.push_back(body[i]);
+                continue;
+            }
+            char c = body[++i];
+            switch (c)
+            {
+                case 'n': out.push_back('\n'); break;
+                case 't': out.push_back('\t'); break;
+                case 'r': out.push_back('\r'); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'u':
+                {
+                    uint32_t cp;
+                    if (!parseHex4(body, i + 1, cp)) break;
+                    i += 4;
+                    uint32_t low;
+                    if (cp >= 0xd800 && cp < 0xdc00 && i + 2 < body.size() && body[i + 1] == '\\' && body[i + 2] == 'u' && parseHex4(body, i + 3, low))
+                    {
+                        cp = 0x10000 + ((cp - 0xd800) << 10) + (low - 0xdc00);
+                        i += 6;
+                    }
+                    appendUtf8(out, cp);
+                    break;
+                }
+                default: out.push_back(c); break; // '"', '\\' and '/'
+            }
+        }
+        return out;
+    }
+
+    //! Walks 'json' along 'path' skipping everything else, no allocation unless the value contains escapes
+    static bool extractField(std::string_view json, const std::vector<std::string>& path, std::string& scratch, std::string_view& value)
+    {
+        size_t i = 0;
+        for (auto& key : path)
+        {
+            skipWhitespace(json, i);
+            if (i >= json.size()) return false;
+            if (json[i] == '{')
+            {
+                i++;
+                bool found = false;
+                while (!found)
+                {
+                    skipWhitespace(json, i);
+                    if (i >= json.size() || json[i] != '"') return false;
+                    size_t start = i;
+                    if (!skipString(json, i)) return false;
+                    found = json.substr(start + 1, i - start - 2) == key;
+                    skipWhitespace(json, i);
+                    if (i >= json.size() || json[i] != ':') return false;
+                    i++;
+                    if (found) break;
+                    if (!skipValue(json, i)) return false;
+                    skipWhitespace(json, i);
+                    if (i >= json.size() || json[i] != ',') return false;
+                    i++;
+                }
+            }
+            else if (json[i] == '[')
+            {
+                char* end{};
+                auto index = std::strtoul(key.c_str(), &end, 10);
+                if (key.empty() || *end) return false;
+                i++;
+                for (unsigned long k = 0; k < index; k++)
+                {
+                    if (!skipValue(json, i)) return false;
+                    skipWhitespace(json, i);
+                    if (i >= json.size() || json[i] != ',') return false;
+                    i++;
+                }
+                skipWhitespace(json, i);
+                if (i < json.size() && json[i] == ']') return false;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        skipWhitespace(json, i);
+        size_t start = i;
+        if (!skipValue(json, i) || i == start) return false;
+        auto raw = json.substr(start, i - start);
+        if (raw == "null") return false;
+        value = raw.front() == '"' ? unescape(raw, scratch) : raw;
+        return true;
+    }
+
+    StreamFormat format;
+    StreamEventCallback callback;
+    void* userdata;
+    std::string endOfStream;
+    std::vector<std::vector<std::string>> paths;
+    std::vector<std::string> scratch;
+    std::vector<const char*> values;
+    std::vector<size_t> sizes;
+    std::string tail;
+    std::string eventType;
+    std::string eventData;
+    bool hasData = false;
+    bool done = false;
+};
+
 // Structure to pass callback, userdata, and limits to CURL for streaming
 struct StreamingCallbackData {
     StreamingDataCallback callback;
     void* userdata;
     uint64_t maxSize;
     uint64_t bytesReceived = 0;
+    //! Replaces 'callback' when the caller chained 'StreamFraming'
+    std::unique_ptr<StreamFramer> framer{};
 };
 
 // Create a custom write callback for streaming data with size limit enforcement
@@ -145,13 +586,781 @@ size_t streamingWriteCallback(void* contents, size_t size, size_t nmemb, void* u
     }
     
     cbData->bytesReceived += realsize;
+    if (cbData->framer) return cbData->framer->feed(static_cast<const char*>(contents), realsize) ? realsize : 0;
     return cbData->callback(static_cast<const char*>(contents), realsize, cbData->userdata);
 };
 
+// Raw response destination, either caller's sink or response vector written in place
+struct SinkWriter {
+    CURL* curl{};
+    ResponseSink* sink{};
+    types::vector<uint8_t>* vector{};
+    uint64_t maxSize{};
+    uint64_t bytesReceived = 0;
+    bool tooLarge = false;
+};
+
+static size_t curlCallbackWriteSink(void* contents, size_t size, size_t nmemb, SinkWriter* writer)
+{
+    size_t length = size * nmemb;
+    auto data = static_cast<const uint8_t*>(contents);
+    auto required = writer->bytesReceived + length;
+
+    if (writer->maxSize > 0 && required > writer->maxSize)
+    {
+        NVIGI_LOG_ERROR("Response exceeds maximum size limit of %llu bytes", writer->maxSize);
+        writer->tooLarge = true;
+        return 0;
+    }
+
+    if (auto sink = writer->sink)
+    {
+        if (sink->buffer)
+        {
+            if (required > sink->bufferSize)
+            {
+                NVIGI_LOG_ERROR("Response exceeds provided buffer of %zu bytes", sink->bufferSize);
+                writer->tooLarge = true;
+                return 0;
+            }
+            memcpy(sink->buffer + writer->bytesReceived, data, length);
+        }
+        else if (sink->chunkCallback)
+        {
+            if (!sink->chunkCallback(data, length, sink->chunkUserData)) return 0;
+        }
+        else if (sink->io->write(sink->io->userData, sink->ioHandle, data, length) != length)
+        {
+            NVIGI_LOG_ERROR("Failed to write response to the provided file handle");
+            return 0;
+        }
+    }
+    else
+    {
+        auto& vector = *writer->vector;
+        if (required > vector.size())
+        {
+            // Size up front once if server told us, otherwise grow geometrically and trim at the end
+            curl_off_t contentLength = -1;
+            curl_easy_getinfo(writer->curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &contentLength);
+            size_t newSize = contentLength > 0 && uint64_t(contentLength) >= required ? size_t(contentLength) : std::max<size_t>(required, vector.size() * 2);
+            try
+            {
+                vector.resize(newSize);
+            }
+            catch (std::bad_alloc& e)
+            {
+                NVIGI_LOG_ERROR("bad_alloc exception in CURL write callback - %s", e.what());
+                return 0;
+            }
+        }
+        memcpy(vector.data() + writer->bytesReceived, data, length);
+    }
+    writer->bytesReceived = required;
+    return length;
+}
+
+//! Process wide cache of CA bundles, each bundle is read from disk once and handed to CURL as an in-memory blob
+//!
+//! Only used with CURL older than 7.87, newer versions cache the parsed store per handle (CURLOPT_CA_CACHE_TIMEOUT)
+//! which does not apply to blobs.
+struct CABundleCache
+{
+    //! Returns nullptr if bundle could not be read, caller falls back to CURLOPT_CAINFO
+    const std::string* get(const std::string& path)
+    {
+        std::scoped_lock lock(mtx);
+        auto it = bundles.find(path);
+        if (it != bundles.end()) return it->second.empty() ? nullptr : &it->second;
+        std::ifstream file(path, std::ios::binary);
+        std::string contents;
+        if (file)
+        {
+            contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            NVIGI_LOG_VERBOSE("Cached CA bundle '%s' (%zu bytes)", path.c_str(), contents.size());
+        }
+        // Entries are never removed so returned pointers stay valid for the lifetime of the process
+        auto& entry = bundles[path] = std::move(contents);
+        return entry.empty() ? nullptr : &entry;
+    }
+
+    std::mutex mtx;
+    std::unordered_map<std::string, std::string> bundles;
+};
+
+//! Pool of easy handles sharing DNS, TLS session and connection caches
+//!
+//! Each request leases a handle for its duration so independent requests run concurrently
+//! while still reusing warm keep-alive connections established by any other handle.
+struct CurlHandlePool
+{
+    struct Handle
+    {
+        CURL* curl{};
+        // Read by the debug callback, must be per handle since requests run in parallel
+        bool redactAuth = true;
+    };
+
+    //! RAII lease, returns the handle to the pool when going out of scope
+    struct Lease
+    {
+        Lease(CurlHandlePool* p, Handle* h, std::string&& hostName) : pool(p), handle(h), host(std::move(hostName)) {}
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease() { reset(); }
+
+        void reset()
+        {
+            if (handle) pool->release(handle, host);
+            handle = {};
+        }
+
+        CURL* get() const { return handle ? handle->curl : nullptr; }
+        bool* redactAuth() const { return &handle->redactAuth; }
+
+        CurlHandlePool* pool{};
+        Handle* handle{};
+        std::string host;
+    };
+
+    Result initialize()
+    {
+        share = curl_share_init();
+        if (!share)
+        {
+            NVIGI_LOG_ERROR("Unable to initialize CURL share handle");
+            return kResultNetFailedToInitializeCurl;
+        }
+        curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lockShared);
+        curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlockShared);
+        curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+        return kResultOk;
+    }
+
+    void shutdown()
+    {
+        std::unique_lock lock(mtx);
+        if (active)
+        {
+            NVIGI_LOG_WARN("Shutting down networking with %u request(s) still in flight", active);
+            cv.wait(lock, [this]() { return active == 0; });
+        }
+        for (auto handle : idle)
+        {
+            curl_easy_cleanup(handle->curl);
+            delete handle;
+        }
+        idle.clear();
+        // Share can only be released once no easy handle references it
+        if (share)
+        {
+            curl_share_cleanup(share);
+            share = {};
+        }
+    }
+
+    //! Blocks if concurrency limits from the parameters are reached, returns empty lease if handle could not be created
+    //!
+    //! Asynchronous requests must not block, their limits are enforced by the multi handle instead.
+    Lease acquire(const Parameters& params, bool enforceLimits = true)
+    {
+        auto host = getHost(params.url.c_str());
+        // Older structs have no limits
+        uint32_t maxTotal = enforceLimits && params.getVersion() >= kStructVersion4 ? params.maxConcurrentRequests : 0;
+        uint32_t maxPerHost = enforceLimits && params.getVersion() >= kStructVersion4 ? params.maxConnectionsPerHost : 0;
+
+        Handle* handle{};
+        {
+            std::unique_lock lock(mtx);
+            cv.wait(lock, [&]()
+            {
+                return (maxTotal == 0 || active < maxTotal) && (maxPerHost == 0 || activePerHost[host] < maxPerHost);
+            });
+            active++;
+            activePerHost[host]++;
+            maxIdle = std::max(maxIdle, maxTotal);
+            if (!idle.empty())
+            {
+                handle = idle.back();
+                idle.pop_back();
+            }
+        }
+        if (!handle)
+        {
+            handle = new Handle();
+            handle->curl = curl_easy_init();
+            if (!handle->curl)
+            {
+                NVIGI_LOG_ERROR("Unable to initialize CURL handle");
+                delete handle;
+                release(nullptr, host);
+                return Lease(this, nullptr, {});
+            }
+        }
+        // Options (including the share) are wiped by curl_easy_reset on release, caches are not
+        curl_easy_setopt(handle->curl, CURLOPT_SHARE, share);
+        curl_easy_setopt(handle->curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        if (maxPerHost > 0)
+        {
+            curl_easy_setopt(handle->curl, CURLOPT_MAXCONNECTS, static_cast<long>(std::max(maxPerHost, maxTotal)));
+        }
+        return Lease(this, handle, std::move(host));
+    }
+
+    void release(Handle* handle, const std::string& host)
+    {
+        if (handle)
+        {
+            curl_easy_reset(handle->curl);
+        }
+        std::scoped_lock lock(mtx);
+        active--;
+        if (--activePerHost[host] == 0)
+        {
+            activePerHost.erase(host);
+        }
+        if (handle)
+        {
+            if (maxIdle == 0 || idle.size() < maxIdle)
+            {
+                idle.push_back(handle);
+            }
+            else
+            {
+                curl_easy_cleanup(handle->curl);
+                delete handle;
+            }
+        }
+        cv.notify_all();
+    }
+
+    static std::string getHost(const char* url)
+    {
+        std::string host;
+        if (auto u = curl_url())
+        {
+            char* h{};
+            if (curl_url_set(u, CURLUPART_URL, url, 0) == CURLUE_OK && curl_url_get(u, CURLUPART_HOST, &h, 0) == CURLUE_OK)
+            {
+                host = h;
+                curl_free(h);
+            }
+            curl_url_cleanup(u);
+        }
+        return host;
+    }
+
+    static void lockShared(CURL*, curl_lock_data data, curl_lock_access, void* userptr)
+    {
+        static_cast<CurlHandlePool*>(userptr)->shareLocks[data].lock();
+    }
+
+    static void unlockShared(CURL*, curl_lock_data data, void* userptr)
+    {
+        static_cast<CurlHandlePool*>(userptr)->shareLocks[data].unlock();
+    }
+
+    CURLSH* share{};
+    std::mutex shareLocks[CURL_LOCK_DATA_LAST];
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::vector<Handle*> idle;
+    std::unordered_map<std::string, uint32_t> activePerHost;
+    uint32_t active{};
+    // Largest pool size requested so far, 0 = keep everything
+    uint32_t maxIdle{};
+};
+
+//! Asynchronous request in flight on the reactor
+struct AsyncRequest
+{
+    AsyncRequest(CurlHandlePool& pool, const Parameters& params) : lease(pool.acquire(params, false)) {}
+
+    RequestHandle id{};
+    CurlHandlePool::Lease lease;
+    curl_slist* headers{};
+    std::string body;
+    ResponseBuffer buffer{};
+    StreamingCallbackData streaming{};
+    RequestCompletionCallback completion{};
+    void* userdata{};
+    //! Covers submission to completion, ends on the reactor thread
+    trace::AsyncSpan span;
+
+    ~AsyncRequest()
+    {
+        curl_slist_free_all(headers);
+    }
+};
+
+//! Single thread driving all asynchronous requests through one curl multi handle
+//!
+//! Requests to the same host are multiplexed over HTTP/2 when the server supports it.
+struct CurlMultiReactor
+{
+    Result start()
+    {
+        std::scoped_lock lock(mtx);
+        if (stopped) return kResultInvalidState;
+        if (multi) return kResultOk;
+        multi = curl_multi_init();
+        if (!multi)
+        {
+            NVIGI_LOG_ERROR("Unable to initialize CURL multi handle");
+            return kResultNetFailedToInitializeCurl;
+        }
+        curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        quit = false;
+        thread = std::thread(&CurlMultiReactor::loop, this);
+        return kResultOk;
+    }
+
+    //! Allows 'start' again after 'stop', see 'INet::initialize'
+    void open()
+    {
+        std::scoped_lock lock(mtx);
+        stopped = false;
+    }
+
+    //! Cancels everything still in flight, completions are invoked before this returns
+    //!
+    //! New requests are rejected with kResultInvalidState until 'open' is called
+    void stop()
+    {
+        {
+            std::scoped_lock lock(mtx);
+            stopped = true;
+            if (!multi) return;
+            quit = true;
+            curl_multi_wakeup(multi);
+        }
+        thread.join();
+        curl_multi_cleanup(multi);
+        multi = {};
+    }
+
+    //! Request is dropped without invoking its completion if the reactor is not running
+    Result submit(std::unique_ptr<AsyncRequest>&& request, const Parameters& params, RequestHandle& id)
+    {
+        std::scoped_lock lock(mtx);
+        if (stopped || !multi) return kResultInvalidState;
+        id = request->id = ++nextId;
+        if (params.getVersion() >= kStructVersion4)
+        {
+            // Multi handle limits are global, use the most restrictive ones requested so far
+            if (params.maxConnectionsPerHost > 0 && (maxPerHost == 0 || params.maxConnectionsPerHost < maxPerHost))
+            {
+                maxPerHost = params.maxConnectionsPerHost;
+                curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(maxPerHost));
+            }
+            if (params.maxConcurrentRequests > 0 && (maxTotal == 0 || params.maxConcurrentRequests < maxTotal))
+            {
+                maxTotal = params.maxConcurrentRequests;
+                curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, static_cast<long>(maxTotal));
+            }
+        }
+        pending.push_back(std::move(request));
+        curl_multi_wakeup(multi);
+        return kResultOk;
+    }
+
+    Result cancel(RequestHandle id)
+    {
+        std::scoped_lock lock(mtx);
+        if (!multi) return kResultInvalidState;
+        canceled.push_back(id);
+        curl_multi_wakeup(multi);
+        return kResultOk;
+    }
+
+private:
+
+    void finish(std::unique_ptr<AsyncRequest>& request, Result result)
+    {
+        auto curl = request->lease.get();
+        long httpStatus = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpStatus);
+        curl_multi_remove_handle(multi, curl);
+        if (auto& framer = request->streaming.framer)
+        {
+            if (framer->stopped || (result == kResultOk && !framer->finish())) result = kResultNetCanceled;
+        }
+        request->span.end();
+        auto& data = request->body;
+        request->completion(request->id, result, httpStatus, reinterpret_cast<const uint8_t*>(data.data()), data.size(), request->userdata);
+        request.reset();
+    }
+
+    void loop()
+    {
+        std::unordered_map<RequestHandle, std::unique_ptr<AsyncRequest>> active;
+        while (true)
+        {
+            std::vector<std::unique_ptr<AsyncRequest>> added;
+            std::vector<RequestHandle> toCancel;
+            bool exiting;
+            {
+                std::scoped_lock lock(mtx);
+                added.swap(pending);
+                toCancel.swap(canceled);
+                exiting = quit;
+            }
+            for (auto& request : added)
+            {
+                auto id = request->id;
+                if (exiting)
+                {
+                    // Removing a handle which was never added is a no-op
+                    finish(request, kResultNetCanceled);
+                    continue;
+                }
+                curl_multi_add_handle(multi, request->lease.get());
+                active[id] = std::move(request);
+            }
+            if (exiting)
+            {
+                for (auto& [id, request] : active) finish(request, kResultNetCanceled);
+                break;
+            }
+            for (auto id : toCancel)
+            {
+                auto it = active.find(id);
+                if (it == active.end()) continue;
+                NVIGI_LOG_VERBOSE("Canceling request %llu", id);
+                finish(it->second, kResultNetCanceled);
+                active.erase(it);
+            }
+
+            int running = 0;
+            curl_multi_perform(multi, &running);
+            int queued = 0;
+            while (auto msg = curl_multi_info_read(multi, &queued))
+            {
+                if (msg->msg != CURLMSG_DONE) continue;
+                AsyncRequest* request{};
+                curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, reinterpret_cast<char**>(&request));
+                auto id = request->id;
+                auto it = active.find(id);
+                if (it == active.end()) continue;
+                auto code = msg->data.result;
+                if (code != CURLE_OK)
+                {
+                    NVIGI_LOG_ERROR("CURL request %llu failed with error - %s", id, curl_easy_strerror(code));
+                }
+                finish(it->second, code == CURLE_OK ? kResultOk : kResultNetCurlError);
+                active.erase(it);
+            }
+            curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+        }
+    }
+
+    std::mutex mtx;
+    CURLM* multi{};
+    std::thread thread;
+    bool quit = false;
+    bool stopped = false;
+    RequestHandle nextId{};
+    uint32_t maxPerHost{};
+    uint32_t maxTotal{};
+    std::vector<std::unique_ptr<AsyncRequest>> pending;
+    std::vector<RequestHandle> canceled;
+};
+
+//! In-memory LRU plus optional on-disk store for GET responses, see 'Parameters::useResponseCache'
+//!
+//! Expiry is kept in wall clock seconds so entries on disk stay meaningful across restarts.
+struct ResponseCache
+{
+    static constexpr const char* kFileExtension = ".nvigi.http";
+
+    struct Entry
+    {
+        std::string url;
+        std::string body;
+        std::string etag;
+        std::string lastModified;
+        int64_t expiresAt{};
+    };
+
+    //! Identical GETs issued while a transfer is running wait for it and share the result
+    struct InFlight
+    {
+        std::mutex mtx;
+        std::condition_variable cv;
+        bool done = false;
+        Result result = kResultOk;
+        std::string body;
+    };
+
+    //! Credentials are hashed into the key, they are never stored
+    static std::string makeKey(const Parameters& params, const std::string& authToken)
+    {
+        std::string key = params.url.c_str();
+        for (auto& header : params.headers)
+        {
+            key += "\n";
+            key += header.c_str();
+        }
+        key += "\n" + std::to_string(std::hash<std::string>{}(authToken));
+        return key;
+    }
+
+    //! Lifetime of a response, false if it must not be stored
+    static bool getExpiry(const ResponseHeaders& headers, uint32_t defaultMaxAge, int64_t now, int64_t& expiresAt)
+    {
+        std::string cacheControl = headers.cacheControl;
+        std::transform(cacheControl.begin(), cacheControl.end(), cacheControl.begin(), ::tolower);
+        if (cacheControl.find("no-store") != std::string::npos) return false;
+
+        bool validators = !headers.etag.empty() || !headers.lastModified.empty();
+        int64_t lifetime = -1;
+        if (cacheControl.find("no-cache") != std::string::npos)
+        {
+            lifetime = 0;
+        }
+        else if (auto maxAge = cacheControl.find("max-age="); maxAge != std::string::npos)
+        {
+            lifetime = std::strtoll(cacheControl.c_str() + maxAge + strlen("max-age="), nullptr, 10);
+        }
+        else if (!headers.expires.empty())
+        {
+            auto when = curl_getdate(headers.expires.c_str(), nullptr);
+            lifetime = when > 0 ? int64_t(when) - now : 0;
+        }
+        else if (validators)
+        {
+            lifetime = defaultMaxAge;
+        }
+        if (lifetime < 0) return false;
+        lifetime = std::max<int64_t>(0, lifetime - headers.ageSeconds);
+        // Nothing to gain from storing a response which is stale right away and cannot be revalidated
+        if (lifetime == 0 && !validators) return false;
+        expiresAt = now + lifetime;
+        return true;
+    }
+
+    void configure(const ResponseCacheSettings& _settings)
+    {
+        std::scoped_lock lock(mtx);
+        if (settings.directory != _settings.directory.c_str())
+        {
+            memory.clear();
+            lru.clear();
+            memoryBytes = 0;
+        }
+        settings.maxMemoryBytes = _settings.maxMemoryBytes;
+        settings.maxEntryBytes = _settings.maxEntryBytes;
+        settings.directory = _settings.directory.c_str();
+        if (!settings.directory.empty())
+        {
+            std::error_code ec;
+            fs::create_directories(fs::u8path(settings.directory), ec);
+        }
+        evict();
+    }
+
+    uint64_t getMaxEntryBytes()
+    {
+        std::scoped_lock lock(mtx);
+        return settings.maxEntryBytes;
+    }
+
+    bool find(const std::string& key, Entry& entry)
+    {
+        std::scoped_lock lock(mtx);
+        if (auto it = memory.find(key); it != memory.end())
+        {
+            lru.splice(lru.begin(), lru, it->second.lru);
+            entry = it->second.entry;
+            return true;
+        }
+        if (!readFromDisk(key, entry)) return false;
+        insert(key, entry);
+        return true;
+    }
+
+    void store(const std::string& key, const Entry& entry)
+    {
+        std::scoped_lock lock(mtx);
+        if (entry.body.size() > settings.maxEntryBytes) return;
+        insert(key, entry);
+        writeToDisk(key, entry);
+    }
+
+    void clear()
+    {
+        std::scoped_lock lock(mtx);
+        memory.clear();
+        lru.clear();
+        memoryBytes = 0;
+        if (!settings.directory.empty())
+        {
+            std::error_code ec;
+            for (auto it = fs::directory_iterator(fs::u8path(settings.directory), ec); !ec && it != fs::directory_iterator(); it.increment(ec))
+            {
+                if (it->path().filename().string().ends_with(kFileExtension)) fs::remove(it->path(), ec);
+            }
+        }
+        hits = revalidated = misses = coalesced = bytesSaved = 0;
+    }
+
+    void getStats(ResponseCacheStats& stats)
+    {
+        stats.hits = hits;
+        stats.revalidated = revalidated;
+        stats.misses = misses;
+        stats.coalesced = coalesced;
+        stats.bytesSaved = bytesSaved;
+        std::scoped_lock lock(mtx);
+        stats.memoryBytes = memoryBytes;
+        stats.entries = memory.size();
+    }
+
+    //! Returns the transfer to wait for, 'leader' is set if the caller must perform it and call 'finish'
+    std::shared_ptr<InFlight> join(const std::string& key, bool& leader)
+    {
+        std::scoped_lock lock(flightMtx);
+        auto& flight = inFlight[key];
+        leader = !flight;
+        if (leader) flight = std::make_shared<InFlight>();
+        return flight;
+    }
+
+    void finish(const std::string& key, const std::shared_ptr<InFlight>& flight, Result result, const std::string& body)
+    {
+        {
+            std::scoped_lock lock(flightMtx);
+            inFlight.erase(key);
+        }
+        {
+            std::scoped_lock lock(flight->mtx);
+            flight->result = result;
+            flight->body = body;
+            flight->done = true;
+        }
+        flight->cv.notify_all();
+    }
+
+    std::atomic<uint64_t> hits{};
+    std::atomic<uint64_t> revalidated{};
+    std::atomic<uint64_t> misses{};
+    std::atomic<uint64_t> coalesced{};
+    std::atomic<uint64_t> bytesSaved{};
+
+private:
+    struct Settings
+    {
+        uint64_t maxMemoryBytes = ResponseCacheSettings{}.maxMemoryBytes;
+        uint64_t maxEntryBytes = ResponseCacheSettings{}.maxEntryBytes;
+        std::string directory;
+    };
+
+    struct MemoryEntry
+    {
+        Entry entry;
+        std::list<std::string>::iterator lru;
+    };
+
+    void insert(const std::string& key, const Entry& entry)
+    {
+        if (auto it = memory.find(key); it != memory.end())
+        {
+            memoryBytes -= it->second.entry.body.size();
+            lru.erase(it->second.lru);
+            memory.erase(it);
+        }
+        lru.push_front(key);
+        memory[key] = { entry, lru.begin() };
+        memoryBytes += entry.body.size();
+        evict();
+    }
+
+    void evict()
+    {
+        while (memoryBytes > settings.maxMemoryBytes && !lru.empty())
+        {
+            auto it = memory.find(lru.back());
+            memoryBytes -= it->second.entry.body.size();
+            memory.erase(it);
+            lru.pop_back();
+        }
+    }
+
+    fs::path getFilePath(const std::string& key) const
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "%016llx", (unsigned long long)std::hash<std::string>{}(key));
+        return fs::u8path(settings.directory) / (std::string(name) + kFileExtension);
+    }
+
+    //! Header line with JSON metadata followed by the body
+    bool readFromDisk(const std::string& key, Entry& entry)
+    {
+        if (settings.directory.empty()) return false;
+        std::ifstream file(getFilePath(key), std::ios::binary);
+        std::string header;
+        if (!file || !std::getline(file, header)) return false;
+        try
+        {
+            auto meta = json::parse(header);
+            // Key is hashed, make sure it is really our entry
+            if (meta.value("key", std::string()) != std::to_string(std::hash<std::string>{}(key)) + ":" + std::to_string(key.size())) return false;
+            entry.url = meta.value("url", std::string());
+            entry.etag = meta.value("etag", std::string());
+            entry.lastModified = meta.value("lastModified", std::string());
+            entry.expiresAt = meta.value("expiresAt", int64_t(0));
+            entry.body.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            return entry.body.size() == meta.value("size", uint64_t(0));
+        }
+        catch (std::exception&)
+        {
+            return false;
+        }
+    }
+
+    void writeToDisk(const std::string& key, const Entry& entry)
+    {
+        if (settings.directory.empty()) return;
+        json meta = {
+            {"key", std::to_string(std::hash<std::string>{}(key)) + ":" + std::to_string(key.size())},
+            {"url", entry.url},
+            {"etag", entry.etag},
+            {"lastModified", entry.lastModified},
+            {"expiresAt", entry.expiresAt},
+            {"size", entry.body.size()}
+        };
+        // Write and rename so that concurrent processes never read a partial entry
+        auto path = getFilePath(key);
+        auto tmpPath = path;
+        tmpPath += ".tmp";
+        {
+            std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+            file << meta.dump(-1, ' ', false, json::error_handler_t::replace) << "\n";
+            file.write(entry.body.data(), entry.body.size());
+            if (!file) return;
+        }
+        std::error_code ec;
+        fs::rename(tmpPath, path, ec);
+        if (ec) fs::remove(tmpPath, ec);
+    }
+
+    std::mutex mtx;
+    Settings settings;
+    std::unordered_map<std::string, MemoryEntry> memory;
+    std::list<std::string> lru;
+    uint64_t memoryBytes{};
+    std::mutex flightMtx;
+    std::unordered_map<std::string, std::shared_ptr<InFlight>> inFlight;
+};
+
 struct Network : public INetworkInternal
 {
     // Helper function to apply security settings from Parameters to CURL handle
-    void applySecuritySettings(CURL* handle, const Parameters& params)
+    void applySecuritySettings(CURL* handle, const Parameters& params, bool* redactAuth)
     {
         // SSL/TLS Verification
         curl_easy_setopt(handle, CURLOPT_SSL_VERIFYPEER, params.verifySSLPeer ? 1L : 0L);
@@ -159,8 +1368,23 @@ struct Network : public INetworkInternal
         
         if (!params.sslCABundlePath.empty())
         {
-            curl_easy_setopt(handle, CURLOPT_CAINFO, params.sslCABundlePath.c_str());
+#if LIBCURL_VERSION_NUM >= 0x074d00 && LIBCURL_VERSION_NUM < 0x075700
+            if (auto bundle = caBundles.get(params.sslCABundlePath.c_str()))
+            {
+                curl_blob blob{ (void*)bundle->data(), bundle->size(), CURL_BLOB_NOCOPY };
+                curl_easy_setopt(handle, CURLOPT_CAINFO_BLOB, &blob);
+            }
+            else
+#endif
+            {
+                // CURL only caches the parsed CA store for file based bundles, a CAINFO blob is parsed on every handshake
+                curl_easy_setopt(handle, CURLOPT_CAINFO, params.sslCABundlePath.c_str());
+            }
         }
+#if LIBCURL_VERSION_NUM >= 0x075700
+        // Pooled handles keep the parsed CA store instead of rebuilding it for every new connection
+        curl_easy_setopt(handle, CURLOPT_CA_CACHE_TIMEOUT, 24L * 60 * 60);
+#endif
         
         // Timeout settings
         if (params.timeoutSeconds > 0)
@@ -195,9 +1419,35 @@ struct Network : public INetworkInternal
         curl_easy_setopt(handle, CURLOPT_PATH_AS_IS, 0L);
         
         // Store redaction flag and setup debug callback
-        currentRedactAuthFlag = params.redactAuthInLogs;
+        *redactAuth = params.redactAuthInLogs;
         curl_easy_setopt(handle, CURLOPT_DEBUGFUNCTION, curlCallbackDebug);
-        curl_easy_setopt(handle, CURLOPT_DEBUGDATA, &currentRedactAuthFlag);
+        curl_easy_setopt(handle, CURLOPT_DEBUGDATA, redactAuth);
+    }
+
+    static bool isCanceled(const Parameters& params)
+    {
+        return params.getVersion() >= kStructVersion6 && params.cancelCallback && params.cancelCallback(params.cancelUserData);
+    }
+
+    static int curlCallbackProgress(void* userptr, curl_off_t, curl_off_t, curl_off_t, curl_off_t)
+    {
+        // Non-zero aborts the transfer with CURLE_ABORTED_BY_CALLBACK
+        return isCanceled(*static_cast<const Parameters*>(userptr)) ? 1 : 0;
+    }
+
+    // Blocking requests only, 'params' must outlive curl_easy_perform
+    void applyCancellation(CURL* handle, const Parameters& params)
+    {
+        if (params.getVersion() < kStructVersion6 || !params.cancelCallback) return;
+        // Invoked at least once per second even when stalled, more often while data is flowing
+        curl_easy_setopt(handle, CURLOPT_XFERINFOFUNCTION, curlCallbackProgress);
+        curl_easy_setopt(handle, CURLOPT_XFERINFODATA, (void*)&params);
+        curl_easy_setopt(handle, CURLOPT_NOPROGRESS, 0L);
+    }
+
+    static Result curlErrorToResult(CURLcode code)
+    {
+        return code == CURLE_ABORTED_BY_CALLBACK ? kResultNetCanceled : kResultNetCurlError;
     }
 
     virtual Result initialize() override final
@@ -210,25 +1460,22 @@ struct Network : public INetworkInternal
             return kResultNetFailedToInitializeCurl;
         }
         
-        curl = curl_easy_init();
-        if (!curl)
+        if (pool.initialize() != kResultOk)
         {
-            NVIGI_LOG_ERROR("Unable to initialize CURL library");
             curl_global_cleanup();
             return kResultNetFailedToInitializeCurl;
         }
         
+        reactor.open();
         NVIGI_LOG_VERBOSE("CURL initialized successfully");
         return kResultOk;
     }
 
     virtual Result shutdown() override final
     {
-        if (curl)
-        {
-            curl_easy_cleanup(curl);
-            curl = {};
-        }
+        // Asynchronous requests hold pooled handles
+        reactor.stop();
+        pool.shutdown();
         
         // Cleanup CURL globally
         curl_global_cleanup();
@@ -256,8 +1503,114 @@ struct Network : public INetworkInternal
 
     virtual Result httpGet(const Parameters& params, std::string& response) override final
     {
+        if (params.getVersion() >= kStructVersion7 && params.useResponseCache) return cachedGet(params, response);
+        return httpGet(params, response, nullptr);
+    }
+
+    static int64_t getEpochSeconds()
+    {
+        return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    //! GET served from 'responseCache' when fresh, revalidated with the origin when stale
+    //!
+    //! Identical requests in flight share a single transfer, a canceled transfer is not shared.
+    Result cachedGet(const Parameters& params, std::string& response)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto elapsedUs = [start]()->uint64_t
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        auto key = ResponseCache::makeKey(params, resolveAuthToken(params));
+        ResponseCache::Entry entry{};
+        bool cached = responseCache.find(key, entry);
+        if (cached && entry.expiresAt > getEpochSeconds())
+        {
+            responseCache.hits++;
+            responseCache.bytesSaved += entry.body.size();
+            response = std::move(entry.body);
+            metrics::getHistogram(plugin::net::kId, "http_cache_hit_us")->record(elapsedUs());
+            return kResultOk;
+        }
+
+        bool leader = false;
+        auto flight = responseCache.join(key, leader);
+        if (!leader)
+        {
+            std::unique_lock lock(flight->mtx);
+            while (!flight->cv.wait_for(lock, std::chrono::milliseconds(100), [&flight]() { return flight->done; }))
+            {
+                if (isCanceled(params)) return kResultNetCanceled;
+            }
+            if (flight->result != kResultNetCanceled)
+            {
+                responseCache.coalesced++;
+                if (flight->result == kResultOk) response = flight->body;
+                return flight->result;
+            }
+            // Leader was canceled by its own caller, this request is still wanted
+            lock.unlock();
+            return httpGet(params, response, nullptr);
+        }
+
+        Result result = kResultNetCurlError;
+        std::string body;
+        extra::ScopedTasks finish([&]()
+        {
+            responseCache.finish(key, flight, result, body);
+        });
+
+        std::vector<std::string> conditions;
+        if (cached && !entry.etag.empty()) conditions.push_back("If-None-Match: " + entry.etag);
+        if (cached && !entry.lastModified.empty()) conditions.push_back("If-Modified-Since: " + entry.lastModified);
+
+        ResponseHeaders headers{};
+        result = httpGet(params, body, &headers, &conditions);
+        if (result != kResultOk) return result;
+
+        auto now = getEpochSeconds();
+        if (cached && headers.httpStatus == 304)
+        {
+            // Validators and freshness may be updated by the 304, body is ours
+            if (headers.etag.empty()) headers.etag = entry.etag;
+            if (headers.lastModified.empty()) headers.lastModified = entry.lastModified;
+            int64_t expiresAt{};
+            entry.expiresAt = ResponseCache::getExpiry(headers, params.cacheDefaultMaxAgeSeconds, now, expiresAt) ? expiresAt : now;
+            entry.etag = headers.etag;
+            entry.lastModified = headers.lastModified;
+            responseCache.store(key, entry);
+            responseCache.revalidated++;
+            responseCache.bytesSaved += entry.body.size();
+            body = std::move(entry.body);
+            metrics::getHistogram(plugin::net::kId, "http_cache_revalidate_us")->record(elapsedUs());
+        }
+        else
+        {
+            responseCache.misses++;
+            int64_t expiresAt{};
+            if (headers.httpStatus == 200 && body.size() <= responseCache.getMaxEntryBytes() &&
+                ResponseCache::getExpiry(headers, params.cacheDefaultMaxAgeSeconds, now, expiresAt))
+            {
+                responseCache.store(key, { params.url.c_str(), body, headers.etag, headers.lastModified, expiresAt });
+            }
+            metrics::getHistogram(plugin::net::kId, "http_cache_miss_us")->record(elapsedUs());
+        }
+        response = body;
+        return kResultOk;
+    }
+
+    Result httpGet(const Parameters& params, std::string& response, ResponseHeaders* responseHeaders, const std::vector<std::string>* extraHeaders = nullptr)
+    {
+        NVIGI_TRACE_SCOPE("httpGet", &plugin::net::kId, this);
+        auto lease = pool.acquire(params);
+        auto curl = lease.get();
+        if (!curl) return kResultNetFailedToInitializeCurl;
+
         // Apply security settings first
-        applySecuritySettings(curl, params);
+        applySecuritySettings(curl, params, lease.redactAuth());
+        applyCancellation(curl, params);
         
         curl_easy_setopt(curl, CURLOPT_URL, params.url.c_str());
 
@@ -267,6 +1620,14 @@ struct Network : public INetworkInternal
             headers = curl_slist_append(headers, h.c_str());
         }
 
+        if (extraHeaders)
+        {
+            for (auto& h : *extraHeaders)
+            {
+                headers = curl_slist_append(headers, h.c_str());
+            }
+        }
+
         auto bearerToken = resolveAuthToken(params);
         if (!bearerToken.empty())
         {
@@ -280,6 +1641,11 @@ struct Network : public INetworkInternal
         curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlCallbackWriteStdString);
         curl_easy_setopt(curl, CURLOPT_WRITEDATA, &buffer);
         curl_easy_setopt(curl, CURLOPT_VERBOSE, verboseMode ? 1 : 0);
+        if (responseHeaders)
+        {
+            curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, curlCallbackHeader);
+            curl_easy_setopt(curl, CURLOPT_HEADERDATA, responseHeaders);
+        }
         
         NVIGI_LOG_VERBOSE("Connecting to '%s', awaiting response ...", params.url.c_str());
         auto res = curl_easy_perform(curl);
@@ -287,13 +1653,15 @@ struct Network : public INetworkInternal
         if (res != CURLE_OK)
         {
             NVIGI_LOG_ERROR("CURL GET request failed with error - %s", curl_easy_strerror(res));
-            curl_easy_reset(curl);
             curl_slist_free_all(headers);
-            return kResultNetCurlError;
+            return curlErrorToResult(res);
         }
 
-        curl_easy_reset(curl);
         curl_slist_free_all(headers);
+        if (responseHeaders)
+        {
+            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseHeaders->httpStatus);
+        }
 
         NVIGI_LOG_VERBOSE("CURL GET request returned %llu bytes", buffer.currentSize);
 
@@ -303,8 +1671,14 @@ struct Network : public INetworkInternal
 
     virtual Result httpPost(const Parameters& params, std::string& response) override final
     {
+        NVIGI_TRACE_SCOPE("httpPost", &plugin::net::kId, this);
+        auto lease = pool.acquire(params);
+        auto curl = lease.get();
+        if (!curl) return kResultNetFailedToInitializeCurl;
+
         // Apply security settings first
-        applySecuritySettings(curl, params);
+        applySecuritySettings(curl, params, lease.redactAuth());
+        applyCancellation(curl, params);
         
         curl_easy_setopt(curl, CURLOPT_URL, params.url.c_str());
 
@@ -338,13 +1712,13 @@ struct Network : public INetworkInternal
         {
             NVIGI_LOG_ERROR("CURL POST request returned %llu bytes - %s", buffer.currentSize, tmp.c_str());
             NVIGI_LOG_ERROR("CURL POST request failed with error - %s", curl_easy_strerror(res));
-            curl_easy_reset(curl);
             curl_slist_free_all(headers);
-            return kResultNetCurlError;
+            return curlErrorToResult(res);
         }
 
-        curl_easy_reset(curl);
         curl_slist_free_all(headers);
+        // Status polling below leases its own handles
+        lease.reset();
 
         // If status polling is enabled, parse as JSON and poll for completion (NVCF-style)
         if (params.enableStatusPolling)
@@ -353,7 +1727,6 @@ struct Network : public INetworkInternal
             {
                 json jsonResponse = json::parse(tmp);
 
-                constexpr float kMaxWaitMs = 5000.0f;
                 constexpr const char* kStatusOK = "fulfilled";
 
                 auto getStatus = [](json& resp)->std::string
@@ -385,7 +1758,7 @@ struct Network : public INetworkInternal
                 };
 
                 auto status = getStatus(jsonResponse);
-                auto tStart = std::chrono::high_resolution_clock::now();
+                auto tStart = std::chrono::steady_clock::now();
 
                 // Determine the base URL for status polling
                 std::string pollBaseUrl = !params.statusPollingBaseUrl.empty()
@@ -394,25 +1767,78 @@ struct Network : public INetworkInternal
                 // Ensure trailing slash
                 if (!pollBaseUrl.empty() && pollBaseUrl.back() != '/') pollBaseUrl += '/';
 
+                StatusPoller poller(params);
+                const uint32_t maxWaitMs = poller.cfg->pollingTimeoutMs;
+                StatusPollingStats stats{};
+
+                auto elapsedMs = [&tStart]()->uint32_t
+                {
+                    return uint32_t(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - tStart).count());
+                };
+
+                std::optional<Parameters> statusParams;
+                uint32_t retryAfterMs = 0;
                 while (status == "pending-evaluation")
                 {
+                    if (isCanceled(params))
+                    {
+                        NVIGI_LOG_VERBOSE("Status polling canceled after %ums", elapsedMs());
+                        return kResultNetCanceled;
+                    }
+                    auto delay = poller.nextDelayMs(retryAfterMs);
+                    if (retryAfterMs > 0) stats.retryAfterCount++;
+                    // Never sleep past the deadline
+                    delay = std::min(delay, maxWaitMs - std::min(maxWaitMs, elapsedMs()));
+                    if (delay > 0)
+                    {
+                        // Sliced so cancellation does not wait out the whole backoff
+                        auto wakeUp = std::chrono::steady_clock::now() + std::chrono::milliseconds(delay);
+                        while (std::chrono::steady_clock::now() < wakeUp && !isCanceled(params))
+                        {
+                            std::this_thread::sleep_until(std::min(wakeUp, std::chrono::steady_clock::now() + std::chrono::milliseconds(10)));
+                        }
+                        stats.waitTimeMs += delay;
+                    }
+
                     std::string reqId = jsonResponse["reqId"];
-                    // Inherit caller's params (auth, SSL, timeouts) for the status poll
-                    Parameters statusParams = params;
-                    statusParams.url = (pollBaseUrl + reqId).c_str();
-                    statusParams.enableStatusPolling = false; // Prevent recursive polling
-                    statusParams.data = {};  // GET request, no body
+                    if (!statusParams)
+                    {
+                        // Inherit caller's params (auth, SSL, timeouts) for the status poll, built once
+                        statusParams = params;
+                        statusParams->enableStatusPolling = false; // Prevent recursive polling
+                        statusParams->data = {};  // GET request, no body
+                        if (poller.cfg->longPollSeconds > 0)
+                        {
+                            statusParams->headers.push_back(extra::format("NVCF-POLL-SECONDS: {}", poller.cfg->longPollSeconds).c_str());
+                        }
+                    }
+                    statusParams->url = (pollBaseUrl + reqId).c_str();
                     std::string statusRawResponse;
-                    if (httpGet(statusParams, statusRawResponse) != kResultOk) break;
+                    ResponseHeaders responseHeaders{};
+                    stats.pollCount++;
+                    if (auto res = httpGet(*statusParams, statusRawResponse, &responseHeaders); res != kResultOk)
+                    {
+                        if (res == kResultNetCanceled) return res;
+                        break;
+                    }
+                    retryAfterMs = responseHeaders.retryAfterMs;
                     jsonResponse = json::parse(statusRawResponse);
                     status = getStatus(jsonResponse);
-                    std::chrono::duration<float, std::milli> tElapsed = std::chrono::high_resolution_clock::now() - tStart;
-                    if (tElapsed.count() > kMaxWaitMs)
+                    if (status == "pending-evaluation" && elapsedMs() > maxWaitMs)
                     {
-                        status = extra::format("timed out after {}ms", kMaxWaitMs);
+                        status = extra::format("timed out after {}ms", maxWaitMs);
                         break;
                     }
                 }
+                stats.elapsedMs = elapsedMs();
+                if (stats.pollCount)
+                {
+                    NVIGI_LOG_VERBOSE("Status polling issued %u request(s), waited %ums out of %ums", stats.pollCount, stats.waitTimeMs, stats.elapsedMs);
+                }
+                if (params.getVersion() >= kStructVersion5 && params.pollingStats)
+                {
+                    *params.pollingStats = stats;
+                }
                 if (status != kStatusOK)
                 {
                     NVIGI_LOG_WARN("POST request failed, status '%s', details: '%s'", status.c_str(), tmp.c_str());
@@ -437,8 +1863,14 @@ struct Network : public INetworkInternal
 
     virtual Result httpPostStreaming(const Parameters& params, StreamingDataCallback callback, void* userdata) override final
     {
+        NVIGI_TRACE_SCOPE("httpPostStreaming", &plugin::net::kId, this);
+        auto lease = pool.acquire(params);
+        auto curl = lease.get();
+        if (!curl) return kResultNetFailedToInitializeCurl;
+
         // Apply security settings first
-        applySecuritySettings(curl, params);
+        applySecuritySettings(curl, params, lease.redactAuth());
+        applyCancellation(curl, params);
         
         curl_easy_setopt(curl, CURLOPT_URL, params.url.c_str());
 
@@ -454,7 +1886,15 @@ struct Network : public INetworkInternal
             headers = curl_slist_append(headers, ("Authorization: Bearer " + bearerToken).c_str());
         }
 
+        auto framing = findStruct<StreamFraming>(params);
+        if (framing ? !framing->eventCallback : !callback)
+        {
+            NVIGI_LOG_ERROR("Streaming request requires a data callback or 'StreamFraming' with an event callback");
+            curl_slist_free_all(headers);
+            return kResultInvalidParameter;
+        }
         StreamingCallbackData callbackData = { callback, userdata, params.maxStreamingSizeBytes, 0 };
+        if (framing) callbackData.framer = std::make_unique<StreamFramer>(*framing);
 
         curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
         curl_easy_setopt(curl, CURLOPT_POST, 1L);
@@ -470,20 +1910,328 @@ struct Network : public INetworkInternal
         
         if (res != CURLE_OK)
         {
-            NVIGI_LOG_ERROR("CURL streaming POST request failed with error - %s", curl_easy_strerror(res));
-            curl_easy_reset(curl);
             curl_slist_free_all(headers);
-            return kResultNetCurlError;
+            if (callbackData.framer && callbackData.framer->stopped) return kResultNetCanceled;
+            NVIGI_LOG_ERROR("CURL streaming POST request failed with error - %s", curl_easy_strerror(res));
+            return curlErrorToResult(res);
         }
 
         NVIGI_LOG_VERBOSE("Streaming completed, received %llu bytes", callbackData.bytesReceived);
-        curl_easy_reset(curl);
         curl_slist_free_all(headers);
+        if (callbackData.framer && !callbackData.framer->finish()) return kResultNetCanceled;
+        return kResultOk;
+    }
+
+    virtual Result httpRequestAsync(const Parameters& params, RequestCompletionCallback completion, StreamingDataCallback streamCallback, void* userdata, RequestHandle* handle) override final
+    {
+        if (!completion)
+        {
+            NVIGI_LOG_ERROR("Asynchronous request requires a completion callback");
+            return kResultInvalidParameter;
+        }
+        if (params.enableStatusPolling)
+        {
+            NVIGI_LOG_ERROR("Status polling is not supported for asynchronous requests");
+            return kResultInvalidParameter;
+        }
+        if (auto res = reactor.start(); res != kResultOk) return res;
+
+        auto request = std::make_unique<AsyncRequest>(pool, params);
+        auto curl = request->lease.get();
+        if (!curl) return kResultNetFailedToInitializeCurl;
+
+        applySecuritySettings(curl, params, request->lease.redactAuth());
+        curl_easy_setopt(curl, CURLOPT_URL, params.url.c_str());
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+
+        for (auto h : params.headers)
+        {
+            request->headers = curl_slist_append(request->headers, h.c_str());
+        }
+        auto bearerToken = resolveAuthToken(params);
+        if (!bearerToken.empty())
+        {
+            request->headers = curl_slist_append(request->headers, ("Authorization: Bearer " + bearerToken).c_str());
+        }
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, request->headers);
+
+        if (!params.data.empty())
+        {
+            curl_easy_setopt(curl, CURLOPT_POST, 1L);
+            // Caller's parameters are not guaranteed to outlive the request
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, params.data.size());
+            curl_easy_setopt(curl, CURLOPT_COPYPOSTFIELDS, params.data.data());
+        }
+
+        auto framing = findStruct<StreamFraming>(params);
+        if (framing && !framing->eventCallback)
+        {
+            NVIGI_LOG_ERROR("'StreamFraming' requires an event callback");
+            return kResultInvalidParameter;
+        }
+        if (streamCallback || framing)
+        {
+            request->streaming = { streamCallback, userdata, params.maxStreamingSizeBytes, 0 };
+            // Caller's framing parameters are not guaranteed to outlive the request, the framer keeps copies
+            if (framing) request->streaming.framer = std::make_unique<StreamFramer>(*framing);
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, streamingWriteCallback);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &request->streaming);
+        }
+        else
+        {
+            request->buffer = { &request->body, params.maxResponseSizeBytes, 0 };
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlCallbackWriteStdString);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &request->buffer);
+        }
+        curl_easy_setopt(curl, CURLOPT_VERBOSE, verboseMode ? 1 : 0);
+
+        request->completion = completion;
+        request->userdata = userdata;
+        request->span = trace::AsyncSpan("httpRequestAsync", &plugin::net::kId, this);
+        curl_easy_setopt(curl, CURLOPT_PRIVATE, request.get());
+
+        RequestHandle id{};
+        if (auto res = reactor.submit(std::move(request), params, id); res != kResultOk)
+        {
+            NVIGI_LOG_ERROR("Unable to queue asynchronous request to '%s', INet is shut down", params.url.c_str());
+            return res;
+        }
+        NVIGI_LOG_VERBOSE("Queued asynchronous request %llu to '%s'", id, params.url.c_str());
+        if (handle) *handle = id;
+        return kResultOk;
+    }
+
+    virtual Result cancelRequest(RequestHandle handle) override final
+    {
+        return reactor.cancel(handle);
+    }
+
+    virtual Result prewarm(const Parameters& params, const char** urls, size_t count) override final
+    {
+        NVIGI_TRACE_SCOPE("prewarm", &plugin::net::kId, this);
+        if (!urls || count == 0) return kResultInvalidParameter;
+
+        CURLM* multi = curl_multi_init();
+        if (!multi) return kResultNetFailedToInitializeCurl;
+
+        // HEAD requests resolve names, connect and complete TLS handshakes, everything ends up in the shared caches
+        std::vector<std::unique_ptr<AsyncRequest>> requests;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!urls[i]) continue;
+            Parameters warmParams = params;
+            warmParams.url = urls[i];
+            warmParams.headers = {};
+            warmParams.data = {};
+            auto request = std::make_unique<AsyncRequest>(pool, warmParams);
+            auto curl = request->lease.get();
+            if (!curl) continue;
+            applySecuritySettings(curl, warmParams, request->lease.redactAuth());
+            curl_easy_setopt(curl, CURLOPT_URL, urls[i]);
+            curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+            curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+            curl_easy_setopt(curl, CURLOPT_VERBOSE, verboseMode ? 1 : 0);
+            curl_multi_add_handle(multi, curl);
+            requests.push_back(std::move(request));
+        }
+
+        int running = 0;
+        do
+        {
+            curl_multi_perform(multi, &running);
+            if (running) curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+        } while (running);
+
+        uint32_t warmed = 0;
+        int queued = 0;
+        while (auto msg = curl_multi_info_read(multi, &queued))
+        {
+            if (msg->msg != CURLMSG_DONE) continue;
+            char* url{};
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_EFFECTIVE_URL, &url);
+            if (msg->data.result == CURLE_OK)
+            {
+                warmed++;
+            }
+            else
+            {
+                NVIGI_LOG_WARN("Failed to prewarm connection to '%s' - %s", url ? url : "unknown", curl_easy_strerror(msg->data.result));
+            }
+        }
+        for (auto& request : requests)
+        {
+            curl_multi_remove_handle(multi, request->lease.get());
+        }
+        // Releasing the leases returns handles to the pool, connections stay alive in the shared cache
+        requests.clear();
+        curl_multi_cleanup(multi);
+
+        NVIGI_LOG_VERBOSE("Prewarmed %u out of %zu connection(s)", warmed, count);
+        return warmed == count ? kResultOk : kResultNetCurlError;
+    }
+
+    virtual Result httpGetRaw(const Parameters& params, types::vector<uint8_t>& response) override final
+    {
+        return httpRaw(params, false, response);
+    }
+
+    virtual Result httpPostRaw(const Parameters& params, types::vector<uint8_t>& response) override final
+    {
+        return httpRaw(params, true, response);
+    }
+
+    Result httpRaw(const Parameters& params, bool post, types::vector<uint8_t>& response)
+    {
+        NVIGI_TRACE_SCOPE(post ? "httpPostRaw" : "httpGetRaw", &plugin::net::kId, this);
+        auto sink = const_cast<ResponseSink*>(findStruct<ResponseSink>(params));
+        if (!post && !sink && params.getVersion() >= kStructVersion7 && params.useResponseCache)
+        {
+            std::string body;
+            if (NVIGI_FAILED(res, cachedGet(params, body))) return res;
+            response.resize(body.size());
+            memcpy(response.data(), body.data(), body.size());
+            return kResultOk;
+        }
+        if (sink && !sink->buffer && !sink->chunkCallback && !(sink->io && sink->io->write && sink->ioHandle))
+        {
+            NVIGI_LOG_ERROR("ResponseSink requires a buffer, chunk callback or writable file handle");
+            return kResultInvalidParameter;
+        }
+
+        auto lease = pool.acquire(params);
+        auto curl = lease.get();
+        if (!curl) return kResultNetFailedToInitializeCurl;
+
+        // Apply security settings first
+        applySecuritySettings(curl, params, lease.redactAuth());
+        applyCancellation(curl, params);
+
+        curl_easy_setopt(curl, CURLOPT_URL, params.url.c_str());
+
+        struct curl_slist* headers = NULL;
+        for (auto h : params.headers)
+        {
+            headers = curl_slist_append(headers, h.c_str());
+        }
+
+        auto bearerToken = resolveAuthToken(params);
+        if (!bearerToken.empty())
+        {
+            headers = curl_slist_append(headers, ("Authorization: Bearer " + bearerToken).c_str());
+        }
+
+        SinkWriter writer{ curl, sink, &response, params.maxResponseSizeBytes, 0 };
+
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+        if (post)
+        {
+            curl_easy_setopt(curl, CURLOPT_POST, 1L);
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, params.data.data());
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, params.data.size());
+        }
+        if (params.maxResponseSizeBytes > 0)
+        {
+            // Rejects oversized responses based on Content-Length before any data is received
+            curl_easy_setopt(curl, CURLOPT_MAXFILESIZE_LARGE, static_cast<curl_off_t>(params.maxResponseSizeBytes));
+        }
+        if (sink && sink->acceptCompressed)
+        {
+            // Empty string means all encodings supported by this CURL build
+            curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
+        }
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlCallbackWriteSink);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &writer);
+        curl_easy_setopt(curl, CURLOPT_VERBOSE, verboseMode ? 1 : 0);
+
+        NVIGI_LOG_VERBOSE("Connecting to '%s', awaiting response ...", params.url.c_str());
+        auto res = curl_easy_perform(curl);
+        curl_slist_free_all(headers);
+
+        if (sink) sink->bytesReceived = writer.bytesReceived;
+        // Drop any over allocation, no-op if server reported correct Content-Length
+        if (!sink && response.size() != writer.bytesReceived) response.resize(writer.bytesReceived);
+
+        if (res != CURLE_OK)
+        {
+            NVIGI_LOG_ERROR("CURL %s request failed with error - %s", post ? "POST" : "GET", curl_easy_strerror(res));
+            return writer.tooLarge || res == CURLE_FILESIZE_EXCEEDED ? kResultNetResponseTooLarge : curlErrorToResult(res);
+        }
+
+        NVIGI_LOG_VERBOSE("CURL %s request returned %llu bytes", post ? "POST" : "GET", writer.bytesReceived);
         return kResultOk;
     }
 
     virtual Result uploadAsset(const types::string& contentType, const types::string& description, const types::vector<uint8_t>& asset, types::string& assetId) override final
     {
+        AssetUploadSource source{};
+        source.size = asset.size();
+        source.pull = [](uint8_t* dst, uint64_t offset, size_t size, void* userdata)->size_t
+        {
+            auto& memory = *static_cast<const types::vector<uint8_t>*>(userdata);
+            memcpy(dst, memory.data() + offset, size);
+            return size;
+        };
+        source.pullUserData = const_cast<types::vector<uint8_t>*>(&asset);
+        return uploadAssetStreaming(contentType, description, source, assetId);
+    }
+
+    // Sequential reader over the upload source, curl rewinds it via the seek callback on redirects and retries
+    struct UploadReader
+    {
+        AssetUploadSource* source{};
+        uint64_t position{};
+        bool failed = false;
+
+        static size_t read(char* ptr, size_t size, size_t nmemb, void* userp)
+        {
+            auto reader = static_cast<UploadReader*>(userp);
+            auto source = reader->source;
+            size_t length = size_t(std::min<uint64_t>(size * nmemb, source->size - reader->position));
+            if (length == 0) return 0;
+            size_t bytes = 0;
+            if (source->pull)
+            {
+                bytes = source->pull(reinterpret_cast<uint8_t*>(ptr), reader->position, length, source->pullUserData);
+            }
+            else
+            {
+                auto io = source->io;
+                if (io->tell(io->userData, source->ioHandle) != reader->position && io->seek(io->userData, source->ioHandle, reader->position, SEEK_SET) != 0)
+                {
+                    reader->failed = true;
+                    return CURL_READFUNC_ABORT;
+                }
+                bytes = io->read(io->userData, source->ioHandle, ptr, length);
+            }
+            if (bytes == 0)
+            {
+                // Source ended before the advertised size, request would never complete
+                NVIGI_LOG_ERROR("Upload source returned no data at offset %llu out of %llu", reader->position, source->size);
+                reader->failed = true;
+                return CURL_READFUNC_ABORT;
+            }
+            reader->position += bytes;
+            return bytes;
+        }
+
+        static int seek(void* userp, curl_off_t offset, int origin)
+        {
+            auto reader = static_cast<UploadReader*>(userp);
+            if (origin != SEEK_SET || offset < 0 || uint64_t(offset) > reader->source->size) return CURL_SEEKFUNC_CANTSEEK;
+            reader->position = uint64_t(offset);
+            return CURL_SEEKFUNC_OK;
+        }
+    };
+
+    virtual Result uploadAssetStreaming(const types::string& contentType, const types::string& description, AssetUploadSource& source, types::string& assetId) override final
+    {
+        NVIGI_TRACE_SCOPE("uploadAsset", &plugin::net::kId, this);
+        if (!source.pull && !(source.io && source.io->read && source.io->seek && source.io->tell && source.ioHandle))
+        {
+            NVIGI_LOG_ERROR("Asset upload requires a pull callback or a readable file handle");
+            return kResultInvalidParameter;
+        }
+
         // First we need to obtain asset id and URL from NVCF
         net::Parameters params;
         params.url = "https://api.nvcf.nvidia.com/v2/nvcf/assets";
@@ -501,71 +2249,143 @@ struct Network : public INetworkInternal
         
         std::string responseStr;
         auto res = httpPost(params, responseStr);
-        if (res == kResultOk)
-        {
-            try
-            {
-                json response = json::parse(responseStr);
+        if (res != kResultOk) return res;
 
-                // We got our id and url, now we can upload the data
-                assetId = response["assetId"].operator std::string().c_str();
-                std::string uploadUrl = response["uploadUrl"];
-
-                NVIGI_LOG_VERBOSE("Uploaded asset id '%s'", assetId.c_str());
+        std::string uploadUrl;
+        try
+        {
+            json response = json::parse(responseStr);
 
-                MemoryStruct uploadData = { asset.data(), asset.size(), 0};
+            // We got our id and url, now we can upload the data
+            assetId = response["assetId"].operator std::string().c_str();
+            uploadUrl = response["uploadUrl"];
+        }
+        catch (std::exception& e)
+        {
+            NVIGI_LOG_ERROR("Failed to parse upload response - %s", e.what());
+            return kResultNetServerError;
+        }
 
-                // Create upload parameters with secure defaults for the PUT request
-                Parameters uploadParams;
-                uploadParams.url = uploadUrl.c_str();
-                // Apply security settings for the upload
-                applySecuritySettings(curl, uploadParams);
+        NVIGI_LOG_VERBOSE("Uploading asset id '%s' (%llu bytes)", assetId.c_str(), source.size);
 
-                struct curl_slist* headers = NULL;
-                headers = curl_slist_append(headers, ("Content-Type: " + contentType).c_str());
-                headers = curl_slist_append(headers, ("x-amz-meta-nvcf-asset-description: " + description).c_str());
-            
-                std::string tmp;
-                ResponseBuffer buffer{ &tmp, uploadParams.maxResponseSizeBytes, 0 };
-            
-                curl_easy_setopt(curl, CURLOPT_URL, uploadUrl.c_str());
-                curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-                curl_easy_setopt(curl, CURLOPT_PUT, 1L);
-                curl_easy_setopt(curl, CURLOPT_READFUNCTION, curlCallbackReadBytes);
-                curl_easy_setopt(curl, CURLOPT_READDATA, (void*)&uploadData);
-                curl_easy_setopt(curl, CURLOPT_UPLOAD, 1L);
-                curl_easy_setopt(curl, CURLOPT_INFILESIZE_LARGE, (curl_off_t)uploadData.size);
-                curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlCallbackWriteStdString);
-                curl_easy_setopt(curl, CURLOPT_WRITEDATA, &buffer);
-                curl_easy_setopt(curl, CURLOPT_VERBOSE, verboseMode ? 1 : 0);
+        // Create upload parameters with secure defaults for the PUT request
+        Parameters uploadParams;
+        uploadParams.url = uploadUrl.c_str();
 
-                auto res = curl_easy_perform(curl);
+        // Presigned URL accepts a single PUT, there are no part URLs to upload in parallel so a failed
+        // attempt is retried from the start, re-reading the source instead of keeping it in memory
+        auto tStart = std::chrono::steady_clock::now();
+        source.attempts = 0;
+        source.bytesSent = 0;
+        res = kResultNetCurlError;
+        for (uint32_t attempt = 0; attempt <= source.maxRetries && res != kResultOk; attempt++)
+        {
+            if (attempt > 0)
+            {
+                auto delay = std::min(4000u, 250u << std::min(attempt - 1, 4u));
+                NVIGI_LOG_WARN("Retrying asset upload in %ums (attempt %u out of %u)", delay, attempt + 1, source.maxRetries + 1);
+                std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+            }
+            source.attempts++;
+
+            auto lease = pool.acquire(uploadParams);
+            auto curl = lease.get();
+            if (!curl) return kResultNetFailedToInitializeCurl;
+            // Apply security settings for the upload
+            applySecuritySettings(curl, uploadParams, lease.redactAuth());
+
+            struct curl_slist* headers = NULL;
+            headers = curl_slist_append(headers, ("Content-Type: " + contentType).c_str());
+            headers = curl_slist_append(headers, ("x-amz-meta-nvcf-asset-description: " + description).c_str());
+
+            std::string tmp;
+            ResponseBuffer buffer{ &tmp, uploadParams.maxResponseSizeBytes, 0 };
+            UploadReader reader{ &source, 0 };
+
+            curl_easy_setopt(curl, CURLOPT_URL, uploadUrl.c_str());
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+            curl_easy_setopt(curl, CURLOPT_READFUNCTION, UploadReader::read);
+            curl_easy_setopt(curl, CURLOPT_READDATA, (void*)&reader);
+            curl_easy_setopt(curl, CURLOPT_SEEKFUNCTION, UploadReader::seek);
+            curl_easy_setopt(curl, CURLOPT_SEEKDATA, (void*)&reader);
+            curl_easy_setopt(curl, CURLOPT_UPLOAD, 1L);
+            curl_easy_setopt(curl, CURLOPT_INFILESIZE_LARGE, (curl_off_t)source.size);
+            // Larger chunks, default 64KB means many small reads from the source
+            curl_easy_setopt(curl, CURLOPT_UPLOAD_BUFFERSIZE, 1024L * 1024L);
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlCallbackWriteStdString);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &buffer);
+            curl_easy_setopt(curl, CURLOPT_VERBOSE, verboseMode ? 1 : 0);
+
+            auto code = curl_easy_perform(curl);
+            long httpStatus = 0;
+            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpStatus);
+            curl_off_t uploaded = 0;
+            curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD_T, &uploaded);
+            source.bytesSent += uint64_t(uploaded);
 
-                curl_easy_reset(curl);
-                curl_slist_free_all(headers);
+            curl_slist_free_all(headers);
 
-                NVIGI_LOG_VERBOSE("CURL upload request returned %llu bytes - %s", buffer.currentSize, tmp.c_str());
+            NVIGI_LOG_VERBOSE("CURL upload request returned %llu bytes - %s", buffer.currentSize, tmp.c_str());
 
-                if (res != CURLE_OK)
-                {
-                    NVIGI_LOG_ERROR("CURL request failed with error - %s", curl_easy_strerror(res));
-                    return kResultNetCurlError;
-                }
+            if (reader.failed)
+            {
+                // Source is broken, retrying will not help
+                return kResultNetCurlError;
             }
-            catch (std::exception& e)
+            if (code != CURLE_OK)
             {
-                NVIGI_LOG_ERROR("Failed to parse upload response - %s", e.what());
-                return kResultNetServerError;
+                NVIGI_LOG_ERROR("CURL request failed with error - %s", curl_easy_strerror(code));
+                res = kResultNetCurlError;
+            }
+            else if (httpStatus >= 400)
+            {
+                NVIGI_LOG_ERROR("Asset upload rejected with HTTP status %ld", httpStatus);
+                res = kResultNetServerError;
+                // Client errors (expired URL, bad request) are final
+                if (httpStatus < 500) break;
+            }
+            else
+            {
+                res = kResultOk;
             }
         }
 
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - tStart;
+        source.elapsedMs = uint32_t(elapsed.count() * 1000.0);
+        source.bytesPerSecond = elapsed.count() > 0.0 ? double(source.bytesSent) / elapsed.count() : 0.0;
+        NVIGI_LOG_VERBOSE("Asset upload sent %llu bytes in %ums (%.2f MB/s)", source.bytesSent, source.elapsedMs, source.bytesPerSecond / (1024.0 * 1024.0));
         return res;
     }
 
-    CURL* curl{};
+    virtual Result configureResponseCache(const ResponseCacheSettings& settings) override final
+    {
+        if (settings.maxEntryBytes > settings.maxMemoryBytes)
+        {
+            NVIGI_LOG_ERROR("Response cache entry limit %llu exceeds memory limit %llu", settings.maxEntryBytes, settings.maxMemoryBytes);
+            return kResultInvalidParameter;
+        }
+        responseCache.configure(settings);
+        return kResultOk;
+    }
+
+    virtual Result getResponseCacheStats(ResponseCacheStats& stats) override final
+    {
+        responseCache.getStats(stats);
+        return kResultOk;
+    }
+
+    virtual Result clearResponseCache() override final
+    {
+        responseCache.clear();
+        return kResultOk;
+    }
+
+    CurlHandlePool pool{};
+    CurlMultiReactor reactor{};
+    CABundleCache caBundles{};
+    ResponseCache responseCache{};
     std::string gfnKey{};
     bool verboseMode = false;
-    bool currentRedactAuthFlag = true; // Current redaction flag for CURL debug callback
     inline static Network* s_interface = {};
 };
 
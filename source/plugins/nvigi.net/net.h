@@ -2,10 +2,13 @@
 // SPDX-License-Identifier: MIT
 //
 
+#pragma once
+
 #include <string>
 #include <vector>
 
 #include "source/core/nvigi.api/nvigi_struct.h"
+#include "source/core/nvigi.api/nvigi_io.h"
 #include "source/core/nvigi.types/types.h"
 #include "source/plugins/nvigi.net/nvigi_net.h"
 #include "external/json/source/nlohmann/json.hpp"
@@ -17,10 +20,211 @@ namespace nvigi
 namespace net
 {
 
+//! How to pace status polling requests while the server reports "pending-evaluation"
+enum class StatusPollingStrategy : uint32_t
+{
+    //! Exponential backoff with jitter, honors server provided 'Retry-After'
+    eExponentialBackoff,
+    //! Delay between polls is provided by 'Parameters::pollingDelayCallback'
+    eCustom,
+    //! Poll again immediately (legacy behavior)
+    eImmediate
+};
+
+//! Returns delay in milliseconds before the next status poll
+//!
+//! attempt: zero based index of the poll about to be issued
+//! retryAfterMs: delay requested by the server via 'Retry-After' or 0 if none
+typedef uint32_t(*StatusPollingDelayCallback)(uint32_t attempt, uint32_t retryAfterMs, void* userdata);
+
+//! Polled while a blocking request is in flight and between status polls, return true to abort with kResultNetCanceled
+//!
+//! IMPORTANT: Called on the thread issuing the request, must be cheap (typically an atomic load)
+typedef bool(*CancellationCallback)(void* userdata);
+
+//! Status polling metrics, filled in when provided via 'Parameters::pollingStats'
+//!
+//! {1577F68D-7742-422B-900C-16FD3BFD5905}
+struct alignas(8) StatusPollingStats {
+    StatusPollingStats() {};
+    NVIGI_UID(UID({ 0x1577f68d, 0x7742, 0x422b,{ 0x90, 0x0c, 0x16, 0xfd, 0x3b, 0xfd, 0x59, 0x05 } }), kStructVersion1);
+    //! Number of status requests issued
+    uint32_t pollCount{};
+    //! Time spent sleeping between polls
+    uint32_t waitTimeMs{};
+    //! Total time from first poll until final status was received (or timeout)
+    uint32_t elapsedMs{};
+    //! Number of times server provided 'Retry-After' was honored
+    uint32_t retryAfterCount{};
+};
+
+NVIGI_VALIDATE_STRUCT(StatusPollingStats)
+
+//! Receives response data straight from CURL's buffer, only valid for the duration of the call
+//!
+//! Return false to abort the transfer
+typedef bool(*ResponseChunkCallback)(const uint8_t* data, size_t size, void* userdata);
+
+//! Response sink
+//!
+//! Chain to 'Parameters' used with 'httpGetRaw'/'httpPostRaw' to receive the response without intermediate copies,
+//! in that case the 'response' vector is left empty. Exactly one destination must be provided.
+//!
+//! {DA793D30-12E1-428D-A32B-F066EB895F35}
+struct alignas(8) ResponseSink {
+    ResponseSink() {};
+    NVIGI_UID(UID({ 0xda793d30, 0x12e1, 0x428d,{ 0xa3, 0x2b, 0xf0, 0x66, 0xeb, 0x89, 0x5f, 0x35 } }), kStructVersion1);
+    //! Caller provided buffer, response larger than 'bufferSize' fails with kResultNetResponseTooLarge
+    uint8_t* buffer{};
+    size_t bufferSize{};
+    //! Chunk callback
+    ResponseChunkCallback chunkCallback{};
+    void* chunkUserData{};
+    //! Handle opened for writing ("wb") via 'io'
+    const FileIOCallbacks* io{};
+    void* ioHandle{};
+    //! Ask the server for compressed content (gzip, deflate or br depending on CURL build),
+    //! decompressed while streaming so the destination always receives the plain payload
+    bool acceptCompressed = false;
+    //! Output - number of bytes delivered to the destination
+    uint64_t bytesReceived{};
+};
+
+NVIGI_VALIDATE_STRUCT(ResponseSink)
+
+//! Pulls upload data, must write exactly 'size' bytes starting at 'offset' into 'dst' and return number of bytes written
+//!
+//! NOTE: Offsets can go backwards when an upload is retried
+typedef size_t(*UploadPullCallback)(uint8_t* dst, uint64_t offset, size_t size, void* userdata);
+
+//! Asset upload source, data is streamed instead of being materialized in memory
+//!
+//! {46FF047E-733B-448F-9032-334F5DB92404}
+struct alignas(8) AssetUploadSource {
+    AssetUploadSource() {};
+    NVIGI_UID(UID({ 0x46ff047e, 0x733b, 0x448f,{ 0x90, 0x32, 0x33, 0x4f, 0x5d, 0xb9, 0x24, 0x04 } }), kStructVersion1);
+    //! Total size in bytes, required since service expects Content-Length
+    uint64_t size{};
+    //! Either a handle opened for reading ("rb") via 'io' ...
+    const FileIOCallbacks* io{};
+    void* ioHandle{};
+    //! ... or a pull callback
+    UploadPullCallback pull{};
+    void* pullUserData{};
+    //! Failed attempts (network errors or 5xx responses) are retried up to this many times
+    uint32_t maxRetries = 3;
+
+    //! Outputs
+    uint64_t bytesSent{};
+    uint32_t attempts{};
+    uint32_t elapsedMs{};
+    double bytesPerSecond{};
+};
+
+NVIGI_VALIDATE_STRUCT(AssetUploadSource)
+
+//! Response cache configuration, see 'INet::configureResponseCache'
+//!
+//! {E6A1D30B-DBE0-4C07-B848-9C560421DC21}
+struct alignas(8) ResponseCacheSettings {
+    ResponseCacheSettings() {};
+    NVIGI_UID(UID({ 0xe6a1d30b, 0xdbe0, 0x4c07,{ 0xb8, 0x48, 0x9c, 0x56, 0x04, 0x21, 0xdc, 0x21 } }), kStructVersion1);
+    //! In-memory budget, least recently used responses are evicted first
+    uint64_t maxMemoryBytes = 16 * 1024 * 1024;
+    //! Larger responses are never cached, the cache is meant for small resources (metadata, model cards, status)
+    uint64_t maxEntryBytes = 1024 * 1024;
+    //! Optional - responses are also stored here and survive restarts, empty disables the on-disk cache
+    types::string directory{};
+};
+
+NVIGI_VALIDATE_STRUCT(ResponseCacheSettings)
+
+//! Response cache counters since the plugin was loaded (or the cache was cleared)
+//!
+//! {8B2C46EE-08E5-4599-867B-7B8EE2C32AFD}
+struct alignas(8) ResponseCacheStats {
+    ResponseCacheStats() {};
+    NVIGI_UID(UID({ 0x8b2c46ee, 0x08e5, 0x4599,{ 0x86, 0x7b, 0x7b, 0x8e, 0xe2, 0xc3, 0x2a, 0xfd } }), kStructVersion1);
+    //! Served from memory or disk without any network traffic
+    uint64_t hits{};
+    //! Stale entry confirmed by the server ('304 Not Modified'), body was not transferred
+    uint64_t revalidated{};
+    //! Full transfers
+    uint64_t misses{};
+    //! Requests which joined an identical GET already in flight instead of issuing their own
+    uint64_t coalesced{};
+    //! Response bytes which did not have to be transferred
+    uint64_t bytesSaved{};
+    //! Current in-memory footprint
+    uint64_t memoryBytes{};
+    uint64_t entries{};
+};
+
+NVIGI_VALIDATE_STRUCT(ResponseCacheStats)
+
+//! Wire format of a streamed response, see 'StreamFraming'
+enum class StreamFormat : uint32_t
+{
+    //! Server-sent events ('text/event-stream'), blank line terminates an event
+    eSSE,
+    //! Newline delimited JSON, one event per line
+    eNDJSON
+};
+
+//! Complete event of a framed stream
+//!
+//! All views point into internal buffers and are only valid for the duration of the callback, nothing is null terminated.
+//!
+//! {5D3E2B0A-6C41-4F57-9E1A-2F7C8B64D913}
+struct alignas(8) StreamEvent {
+    StreamEvent() {};
+    NVIGI_UID(UID({ 0x5d3e2b0a, 0x6c41, 0x4f57,{ 0x9e, 0x1a, 0x2f, 0x7c, 0x8b, 0x64, 0xd9, 0x13 } }), kStructVersion1);
+    //! SSE 'event:' field, empty for NDJSON and unnamed events
+    const char* type{};
+    size_t typeSize{};
+    //! SSE 'data:' lines joined with '\n' or the NDJSON line without its terminator
+    const char* data{};
+    size_t dataSize{};
+    //! Values of 'StreamFraming::fields' in the same order, nullptr if the field is missing or 'data' is not JSON.
+    //! Strings are unescaped, numbers, booleans, objects and arrays are returned as raw JSON text.
+    const char* const* fieldValues{};
+    const size_t* fieldSizes{};
+    size_t fieldCount{};
+};
+
+NVIGI_VALIDATE_STRUCT(StreamEvent)
+
+//! Return false to abort the transfer
+typedef bool(*StreamEventCallback)(const StreamEvent& event, void* userdata);
+
+//! Stream framing
+//!
+//! Chain to 'Parameters' used with 'nvcfPostStreaming' or 'httpRequestAsync' (with a stream callback) to receive one
+//! callback per complete event instead of raw chunks. Events are split incrementally as data arrives, bytes are never
+//! scanned twice and requested JSON fields are extracted without building a DOM. Raw 'StreamingDataCallback' is not
+//! invoked and can be null.
+//!
+//! {A4F1C9E2-37B8-4D0C-8A65-E1B02D7F5C48}
+struct alignas(8) StreamFraming {
+    StreamFraming() {};
+    NVIGI_UID(UID({ 0xa4f1c9e2, 0x37b8, 0x4d0c,{ 0x8a, 0x65, 0xe1, 0xb0, 0x2d, 0x7f, 0x5c, 0x48 } }), kStructVersion1);
+    StreamFormat format = StreamFormat::eSSE;
+    StreamEventCallback eventCallback{};
+    void* eventUserData{};
+    //! Optional - JSON fields to extract from each event as '/' separated paths with array indices,
+    //! for example "choices/0/delta/content". Strings are copied, caller's array does not have to outlive the call.
+    const char* const* fields{};
+    size_t fieldCount{};
+    //! Optional - payload which ends the stream (e.g. "[DONE]"), it is not delivered and everything after it is ignored
+    const char* endOfStream{};
+};
+
+NVIGI_VALIDATE_STRUCT(StreamFraming)
+
 // {8560A124-99B4-4ED8-89FE-4406EF08CB30}
 struct alignas(8) Parameters {
     Parameters() {}; 
-    NVIGI_UID(UID({ 0x8560a124, 0x99b4, 0x4ed8,{ 0x89, 0xfe, 0x44, 0x6, 0xef, 0x8, 0xcb, 0x30 } }), kStructVersion3);
+    NVIGI_UID(UID({ 0x8560a124, 0x99b4, 0x4ed8,{ 0x89, 0xfe, 0x44, 0x6, 0xef, 0x8, 0xcb, 0x30 } }), kStructVersion7);
     //! IMPORTANT: Using nvigi::types ABI stable implementations
     //! 
     types::string url{};
@@ -52,6 +256,49 @@ struct alignas(8) Parameters {
     //! Base URL for status polling requests. The request ID is appended as a path segment.
     //! If empty and enableStatusPolling is true, defaults to "https://api.nvcf.nvidia.com/v2/nvcf/exec/status/".
     types::string statusPollingBaseUrl{};
+
+    //! v4 - Connection pooling
+    //! Requests lease pooled CURL handles sharing DNS, TLS session and connection caches.
+    //! Maximum number of requests in flight across the process, further requests block until one completes (0 = unlimited).
+    //! Also caps how many idle handles (and their keep-alive connections) are kept around.
+    //!
+    //! NOTE: Asynchronous requests never block the caller and do not count towards this limit. For them both limits cap
+    //! the connections opened by the shared asynchronous transport, requests beyond that are queued there and HTTP/2 requests
+    //! to the same host can share a connection. Most restrictive non-zero limits submitted so far apply to all asynchronous requests.
+    uint32_t maxConcurrentRequests = 0;
+    //! Maximum number of requests in flight to the same host (0 = unlimited)
+    uint32_t maxConnectionsPerHost = 0;
+
+    //! v5 - Status polling strategy (only used when enableStatusPolling is true)
+    StatusPollingStrategy pollingStrategy = StatusPollingStrategy::eExponentialBackoff;
+    //! Give up polling after this much time
+    uint32_t pollingTimeoutMs = 5000;
+    //! Backoff starts at 'pollingInitialDelayMs' and grows by 'pollingBackoffFactor' up to 'pollingMaxDelayMs'
+    uint32_t pollingInitialDelayMs = 50;
+    uint32_t pollingMaxDelayMs = 1000;
+    float pollingBackoffFactor = 2.0f;
+    //! Random +/- fraction applied to each delay so many clients do not poll in lockstep
+    float pollingJitter = 0.2f;
+    //! If non-zero server is asked to hold each status request for up to this long (NVCF long polling)
+    //! and backoff is skipped while it does so
+    uint32_t longPollSeconds = 0;
+    StatusPollingDelayCallback pollingDelayCallback{};
+    void* pollingDelayUserData{};
+    //! Optional output
+    StatusPollingStats* pollingStats{};
+
+    //! v6 - Cooperative cancellation of blocking requests (asynchronous ones use 'INet::cancelRequest')
+    CancellationCallback cancelCallback{};
+    void* cancelUserData{};
+
+    //! v7 - Response cache, GET only ('nvcfGet' and 'httpGetRaw' without a 'ResponseSink')
+    //!
+    //! Honors 'Cache-Control' (max-age, no-store, no-cache), 'Expires' and 'Age'. Stale entries with an 'ETag' or
+    //! 'Last-Modified' are revalidated with 'If-None-Match'/'If-Modified-Since'. Identical GETs in flight share one transfer.
+    //! Entries are keyed by URL, headers and auth token so responses never leak between credentials.
+    bool useResponseCache = false;
+    //! Freshness assumed when the server provides validators but no lifetime, 0 revalidates every time
+    uint32_t cacheDefaultMaxAgeSeconds = 0;
 };
 
 NVIGI_VALIDATE_STRUCT(Parameters)
@@ -59,10 +306,22 @@ NVIGI_VALIDATE_STRUCT(Parameters)
 // C-style callback function pointer for streaming
 typedef size_t(*StreamingDataCallback)(const char* data, size_t size, void* userdata);
 
+//! Identifies an asynchronous request, 0 is never a valid handle
+typedef uint64_t RequestHandle;
+
+//! Invoked exactly once when an asynchronous request completes, fails or is canceled
+//!
+//! result: kResultOk, kResultNetCurlError, kResultNetCanceled etc.
+//! httpStatus: HTTP response code or 0 if no response was received
+//! data/size: full response body, always empty when the request was issued with a streaming callback
+//!
+//! IMPORTANT: Called on the networking thread, keep it short and never block on other asynchronous requests
+typedef void(*RequestCompletionCallback)(RequestHandle handle, Result result, long httpStatus, const uint8_t* data, size_t size, void* userdata);
+
 // {E70C7C30-5E61-4F3A-B40F-A6F561EDB563}
 struct alignas(8) INet {
     INet() {};
-    NVIGI_UID(UID({ 0xe70c7c30, 0x5e61, 0x4f3a,{ 0xb4, 0xf, 0xa6, 0xf5, 0x61, 0xed, 0xb5, 0x63 } }), kStructVersion3);
+    NVIGI_UID(UID({ 0xe70c7c30, 0x5e61, 0x4f3a,{ 0xb4, 0xf, 0xa6, 0xf5, 0x61, 0xed, 0xb5, 0x63 } }), kStructVersion7);
     Result(*setVerboseMode)(bool flag);
     //! NOTE: The nvcf* names are historical and kept for ABI compatibility.
     //! These are generic HTTP methods — NVCF-specific behavior (e.g. status polling)
@@ -78,6 +337,32 @@ struct alignas(8) INet {
     // v3 - Raw response methods for non-JSON payloads (e.g. audio, binary data)
     Result(*httpGetRaw)(const Parameters& params, types::vector<uint8_t>& response);
     Result(*httpPostRaw)(const Parameters& params, types::vector<uint8_t>& response);
+
+    // v4 - Non-blocking requests, all multiplexed on a single networking thread
+    //! Issues POST when 'params.data' is not empty, GET otherwise. Status polling is not supported.
+    //! If 'streamCallback' is provided response data is delivered through it as it arrives.
+    //! Request handle is returned in 'handle' (optional), completion is NOT invoked if this call fails.
+    Result(*httpRequestAsync)(const Parameters& params, RequestCompletionCallback completion, StreamingDataCallback streamCallback, void* userdata, RequestHandle* handle);
+    //! Cancels the request, completion is invoked with kResultNetCanceled unless request has completed already
+    Result(*cancelRequest)(RequestHandle handle);
+
+    // v5
+    //! Resolves names, connects and completes TLS handshakes for the given URLs so first real requests
+    //! run at steady state latency. Security settings (CA bundle etc.) are taken from 'params', its url is ignored.
+    //! Blocks until all connections are established or failed, connections are kept alive in the shared cache.
+    Result(*prewarm)(const Parameters& params, const char** urls, size_t count);
+
+    // v6
+    //! Same as 'nvcfUploadAsset' but asset is streamed from the source, upload statistics are reported back in 'source'
+    Result(*nvcfUploadAssetStreaming)(const types::string& contentType, const types::string& description, AssetUploadSource& source, types::string& assetId);
+
+    // v7
+    //! Configures the response cache used by requests with 'Parameters::useResponseCache', defaults apply until called.
+    //! Memory cache is cleared when the directory changes.
+    Result(*configureResponseCache)(const ResponseCacheSettings& settings);
+    Result(*getResponseCacheStats)(ResponseCacheStats& stats);
+    //! Drops all cached responses (memory and disk) and resets the counters
+    Result(*clearResponseCache)();
 };
 
 NVIGI_VALIDATE_STRUCT(INet)
@@ -91,7 +376,16 @@ struct INetworkInternal
     virtual Result httpGet(const Parameters& params, std::string& response) = 0;
     virtual Result httpPost(const Parameters& params, std::string& response) = 0;
     virtual Result httpPostStreaming(const Parameters& params, StreamingDataCallback callback, void* userdata) = 0;
+    virtual Result httpGetRaw(const Parameters& params, types::vector<uint8_t>& response) = 0;
+    virtual Result httpPostRaw(const Parameters& params, types::vector<uint8_t>& response) = 0;
     virtual Result uploadAsset(const types::string& contentType, const types::string& description, const types::vector<uint8_t>& asset, types::string& assetId) = 0;
+    virtual Result httpRequestAsync(const Parameters& params, RequestCompletionCallback completion, StreamingDataCallback streamCallback, void* userdata, RequestHandle* handle) = 0;
+    virtual Result cancelRequest(RequestHandle handle) = 0;
+    virtual Result prewarm(const Parameters& params, const char** urls, size_t count) = 0;
+    virtual Result uploadAssetStreaming(const types::string& contentType, const types::string& description, AssetUploadSource& source, types::string& assetId) = 0;
+    virtual Result configureResponseCache(const ResponseCacheSettings& settings) = 0;
+    virtual Result getResponseCacheStats(ResponseCacheStats& stats) = 0;
+    virtual Result clearResponseCache() = 0;
 };
 
 INetworkInternal* getInterface();
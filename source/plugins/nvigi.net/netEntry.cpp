@@ -67,22 +67,12 @@ Result _httpPost(const Parameters& params, types::string& response)
 }
 Result _httpGetRaw(const Parameters& params, types::vector<uint8_t>& response)
 {
-    std::string data;
-    auto res = net::getInterface()->httpGet(params, data);
-    response.resize(data.size());
-    if (!data.empty()) memcpy(response.data(), data.data(), data.size());
-    return res;
+    return net::getInterface()->httpGetRaw(params, response);
 }
 Result _httpPostRaw(const Parameters& params, types::vector<uint8_t>& response)
 {
-    // Raw methods must never enter the JSON parse / status polling path
-    Parameters rawParams = params;
-    rawParams.enableStatusPolling = false;
-    std::string data;
-    auto res = net::getInterface()->httpPost(rawParams, data);
-    response.resize(data.size());
-    if (!data.empty()) memcpy(response.data(), data.data(), data.size());
-    return res;
+    // Raw methods never enter the JSON parse / status polling path
+    return net::getInterface()->httpPostRaw(params, response);
 }
 Result _httpPostStreaming(const Parameters& params, StreamingDataCallback callback, void* userdata)
 {
@@ -92,6 +82,34 @@ Result _uploadAsset(const types::string& contentType, const types::string& descr
 {
     return net::getInterface()->uploadAsset(contentType, description, asset, assetId);
 }
+Result _httpRequestAsync(const Parameters& params, RequestCompletionCallback completion, StreamingDataCallback streamCallback, void* userdata, RequestHandle* handle)
+{
+    return net::getInterface()->httpRequestAsync(params, completion, streamCallback, userdata, handle);
+}
+Result _cancelRequest(RequestHandle handle)
+{
+    return net::getInterface()->cancelRequest(handle);
+}
+Result _prewarm(const Parameters& params, const char** urls, size_t count)
+{
+    return net::getInterface()->prewarm(params, urls, count);
+}
+Result _uploadAssetStreaming(const types::string& contentType, const types::string& description, AssetUploadSource& source, types::string& assetId)
+{
+    return net::getInterface()->uploadAssetStreaming(contentType, description, source, assetId);
+}
+Result _configureResponseCache(const ResponseCacheSettings& settings)
+{
+    return net::getInterface()->configureResponseCache(settings);
+}
+Result _getResponseCacheStats(ResponseCacheStats& stats)
+{
+    return net::getInterface()->getResponseCacheStats(stats);
+}
+Result _clearResponseCache()
+{
+    return net::getInterface()->clearResponseCache();
+}
 
 namespace net
 {
@@ -127,6 +145,34 @@ Result httpPostRaw(const Parameters& params, types::vector<uint8_t>& response)
 {
     NVIGI_CATCH_EXCEPTION(_httpPostRaw(params, response));
 }
+Result httpRequestAsync(const Parameters& params, RequestCompletionCallback completion, StreamingDataCallback streamCallback, void* userdata, RequestHandle* handle)
+{
+    NVIGI_CATCH_EXCEPTION(_httpRequestAsync(params, completion, streamCallback, userdata, handle));
+}
+Result cancelRequest(RequestHandle handle)
+{
+    NVIGI_CATCH_EXCEPTION(_cancelRequest(handle));
+}
+Result prewarm(const Parameters& params, const char** urls, size_t count)
+{
+    NVIGI_CATCH_EXCEPTION(_prewarm(params, urls, count));
+}
+Result uploadAssetStreaming(const types::string& contentType, const types::string& description, AssetUploadSource& source, types::string& assetId)
+{
+    NVIGI_CATCH_EXCEPTION(_uploadAssetStreaming(contentType, description, source, assetId));
+}
+Result configureResponseCache(const ResponseCacheSettings& settings)
+{
+    NVIGI_CATCH_EXCEPTION(_configureResponseCache(settings));
+}
+Result getResponseCacheStats(ResponseCacheStats& stats)
+{
+    NVIGI_CATCH_EXCEPTION(_getResponseCacheStats(stats));
+}
+Result clearResponseCache()
+{
+    NVIGI_CATCH_EXCEPTION(_clearResponseCache());
+}
 } // net
 
 //! Main entry point - get information about our plugin
@@ -173,6 +219,13 @@ Result nvigiPluginRegister(framework::IFramework* framework)
         ctx.api.nvcfUploadAsset = net::uploadAsset;
         ctx.api.httpGetRaw = net::httpGetRaw;
         ctx.api.httpPostRaw = net::httpPostRaw;
+        ctx.api.httpRequestAsync = net::httpRequestAsync;
+        ctx.api.cancelRequest = net::cancelRequest;
+        ctx.api.prewarm = net::prewarm;
+        ctx.api.nvcfUploadAssetStreaming = net::uploadAssetStreaming;
+        ctx.api.configureResponseCache = net::configureResponseCache;
+        ctx.api.getResponseCacheStats = net::getResponseCacheStats;
+        ctx.api.clearResponseCache = net::clearResponseCache;
         framework->addInterface(plugin::net::kId, &ctx.api, 0);
     }
 
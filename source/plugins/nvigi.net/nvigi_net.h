@@ -23,6 +23,7 @@ constexpr uint32_t kResultNetCurlError = 3 << 24 | plugin::net::kId.crc24;
 constexpr uint32_t kResultNetServerError = 4 << 24 | plugin::net::kId.crc24;
 constexpr uint32_t kResultNetTimeout = 5 << 24 | plugin::net::kId.crc24;
 constexpr uint32_t kResultNetResponseTooLarge = 6 << 24 | plugin::net::kId.crc24;
+constexpr uint32_t kResultNetCanceled = 7 << 24 | plugin::net::kId.crc24;
 
 }
 }
\ No newline at end of file
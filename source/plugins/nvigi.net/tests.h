@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <thread>
+
 #include "source/plugins/nvigi.net/nvigi_net.h"
 #include "source/plugins/nvigi.net/net.h"
 #include "external/json/source/nlohmann/json.hpp"
@@ -181,6 +184,121 @@ TEST_CASE("net_timeout_configuration", "[net][security][timeout]")
     REQUIRE(passed);
 }
 
+TEST_CASE("net_cancellation", "[net][cancel]")
+{
+    nvigi::net::INet* inet{};
+    auto result = nvigiGetInterfaceDynamic(plugin::net::kId, &inet, params.nvigiLoadInterface);
+    REQUIRE(result == nvigi::kResultOk);
+
+    // Server holds the response for 10 seconds, request is canceled after 500ms
+    auto testParams = nvigi::net::tests::createSecureParams("https://httpbin.org/delay/10");
+    testParams.timeoutSeconds = 30;
+    std::atomic<bool> cancel{ false };
+    testParams.cancelCallback = [](void* userdata)->bool { return static_cast<std::atomic<bool>*>(userdata)->load(std::memory_order_relaxed); };
+    testParams.cancelUserData = &cancel;
+
+    std::thread canceler([&cancel]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        cancel.store(true);
+    });
+    auto start = std::chrono::steady_clock::now();
+    types::string responseStr;
+    Result res = inet->nvcfGet(testParams, responseStr);
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    canceler.join();
+
+    // Progress callback runs at least once per second so abort lands well before the server responds
+    bool passed = (res == kResultNetCanceled && duration < 3000);
+    NVIGI_LOG_TEST_INFO("[%s] Cancellation - %s (actual: %lldms)",
+        passed ? "PASS" : "FAIL",
+        passed ? "Request aborted" : "Request not aborted",
+        duration);
+
+    params.nvigiUnloadInterface(plugin::net::kId, inet);
+    REQUIRE(passed);
+}
+
+TEST_CASE("net_response_cache", "[net][cache]")
+{
+    nvigi::net::INet* inet{};
+    auto result = nvigiGetInterfaceDynamic(plugin::net::kId, &inet, params.nvigiLoadInterface);
+    REQUIRE(result == nvigi::kResultOk);
+    REQUIRE(inet->getVersion() >= kStructVersion7);
+    REQUIRE(inet->clearResponseCache() == kResultOk);
+
+    // Server responds with 'Cache-Control: public, max-age=60' and an 'ETag'
+    auto testParams = nvigi::net::tests::createSecureParams("https://httpbin.org/cache/60");
+    testParams.useResponseCache = true;
+
+    types::string first, second;
+    REQUIRE(inet->nvcfGet(testParams, first) == kResultOk);
+    REQUIRE(inet->nvcfGet(testParams, second) == kResultOk);
+
+    nvigi::net::ResponseCacheStats stats{};
+    REQUIRE(inet->getResponseCacheStats(stats) == kResultOk);
+    bool passed = (stats.misses == 1 && stats.hits == 1 && first == second && stats.bytesSaved == second.size());
+    NVIGI_LOG_TEST_INFO("[%s] Response cache - %llu hits, %llu misses, %llu bytes saved",
+        passed ? "PASS" : "FAIL", stats.hits, stats.misses, stats.bytesSaved);
+
+    REQUIRE(inet->clearResponseCache() == kResultOk);
+    params.nvigiUnloadInterface(plugin::net::kId, inet);
+    REQUIRE(passed);
+}
+
+TEST_CASE("net_stream_framing", "[net][streaming]")
+{
+    nvigi::net::INet* inet{};
+    auto result = nvigiGetInterfaceDynamic(plugin::net::kId, &inet, params.nvigiLoadInterface);
+    REQUIRE(result == nvigi::kResultOk);
+    REQUIRE(inet->getVersion() >= kStructVersion4);
+
+    // Server streams 5 JSON objects, one per line
+    auto testParams = nvigi::net::tests::createSecureParams("https://httpbin.org/stream/5");
+    const char* fields[] = { "id", "url" };
+    nvigi::net::StreamFraming framing{};
+    framing.format = nvigi::net::StreamFormat::eNDJSON;
+    framing.fields = fields;
+    framing.fieldCount = 2;
+
+    struct Received
+    {
+        std::vector<std::string> ids;
+        bool urlFound = true;
+        std::atomic<bool> done{ false };
+        Result result{};
+    } received;
+    framing.eventUserData = &received;
+    framing.eventCallback = [](const nvigi::net::StreamEvent& event, void* userdata)->bool
+    {
+        auto received = static_cast<Received*>(userdata);
+        if (event.fieldValues[0]) received->ids.emplace_back(event.fieldValues[0], event.fieldSizes[0]);
+        received->urlFound &= event.fieldValues[1] != nullptr;
+        return true;
+    };
+    testParams.chain(framing);
+
+    auto completion = [](RequestHandle, Result result, long, const uint8_t*, size_t, void* userdata)
+    {
+        auto received = static_cast<Received*>(userdata);
+        received->result = result;
+        received->done.store(true);
+    };
+    REQUIRE(inet->httpRequestAsync(testParams, completion, nullptr, &received, nullptr) == kResultOk);
+    auto start = std::chrono::steady_clock::now();
+    while (!received.done.load() && std::chrono::steady_clock::now() - start < std::chrono::seconds(30))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    bool passed = (received.done && received.result == kResultOk && received.urlFound &&
+        received.ids == std::vector<std::string>{ "0", "1", "2", "3", "4" });
+    NVIGI_LOG_TEST_INFO("[%s] Stream framing - %zu events", passed ? "PASS" : "FAIL", received.ids.size());
+
+    params.nvigiUnloadInterface(plugin::net::kId, inet);
+    REQUIRE(passed);
+}
+
 TEST_CASE("net_nvidia_chat_api", "[net][api][nvidia]")
 {
     // Check if API key is set
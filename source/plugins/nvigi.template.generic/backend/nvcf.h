@@ -9,6 +9,12 @@
 #include "source/servers/server.h"
 #include "nvigi.extra/extra.h"
 
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 namespace nvigi
 {
 
@@ -18,20 +24,124 @@ namespace tmpl
 namespace nvcf
 {
 
+//! Dispatch settings, see 'addMicroService'
+struct MicroServiceParameters
+{
+    //! Instances created per model on demand, each one serves one request at a time
+    size_t maxInstancesPerModel = std::max(1u, std::thread::hardware_concurrency() / 4);
+    //! Requests allowed to wait for a free instance, anything above is rejected with 429
+    size_t maxQueuedRequests = 16;
+    //! Time a queued request waits for an instance before failing with 503
+    uint32_t queueTimeoutMs = 30000;
+};
+
+//! Per model pool, instances are created lazily up to 'maxInstancesPerModel'
+struct InstancePool
+{
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::vector<nvigi::InferenceInstance*> instances{};
+    std::vector<nvigi::InferenceInstance*> idle{};
+    size_t creating{};
+    size_t waiting{};
+};
+
 struct Context
 {
     nvigi::ITemplate* _interface{};
-    std::map<std::string,nvigi::InferenceInstance*> instances{};
+    MicroServiceParameters config{};
+    std::mutex mtx;
+    std::map<std::string, std::unique_ptr<InstancePool>> pools{};
 };
 Context ctx;
 
-nvigi::Result addMicroService(Server& svr, const std::string& pathToModels, PFun_nvigiLoadInterface* nvigiLoadInterface)
+//! Returns instance to its pool when the request (or the streamed response) is done
+struct InstanceLease
+{
+    InstanceLease(InstancePool* _pool, nvigi::InferenceInstance* _instance) : pool(_pool), instance(_instance) {}
+    InstanceLease(const InstanceLease&) = delete;
+    ~InstanceLease()
+    {
+        {
+            std::scoped_lock lock(pool->mtx);
+            pool->idle.push_back(instance);
+        }
+        pool->cv.notify_one();
+    }
+    InstancePool* pool;
+    nvigi::InferenceInstance* instance;
+};
+
+inline InstancePool* getPool(const std::string& modelGUID)
+{
+    std::scoped_lock lock(ctx.mtx);
+    auto& pool = ctx.pools[modelGUID];
+    if (!pool) pool = std::make_unique<InstancePool>();
+    return pool.get();
+}
+
+//! Admission control and instance acquisition
+//!
+//! kResultBusy if the queue is full (caller should back off), kResultTimedOut if no instance became free in time
+inline nvigi::Result acquireInstance(InstancePool* pool, TemplateCreationParameters& params, std::shared_ptr<InstanceLease>& lease)
+{
+    std::unique_lock lock(pool->mtx);
+    if (pool->idle.empty() && pool->waiting >= ctx.config.maxQueuedRequests)
+    {
+        return kResultBusy;
+    }
+    pool->waiting++;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ctx.config.queueTimeoutMs);
+    while (true)
+    {
+        if (!pool->idle.empty())
+        {
+            lease = std::make_shared<InstanceLease>(pool, pool->idle.back());
+            pool->idle.pop_back();
+            pool->waiting--;
+            return kResultOk;
+        }
+        if (pool->instances.size() + pool->creating < ctx.config.maxInstancesPerModel)
+        {
+            // Model loading can take a while, do not block other requests for this model
+            pool->creating++;
+            lock.unlock();
+            nvigi::InferenceInstance* instance{};
+            auto result = ctx._interface->createInstance(params, &instance);
+            lock.lock();
+            pool->creating--;
+            pool->waiting--;
+            if (NVIGI_FAILED(error, result))
+            {
+                pool->cv.notify_one();
+                return error;
+            }
+            pool->instances.push_back(instance);
+            lease = std::make_shared<InstanceLease>(pool, instance);
+            return kResultOk;
+        }
+        if (pool->cv.wait_until(lock, deadline) == std::cv_status::timeout && pool->idle.empty())
+        {
+            pool->waiting--;
+            return kResultTimedOut;
+        }
+    }
+}
+
+//! Adds the template endpoint to the server
+//!
+//! Requests for the same model are served concurrently by up to 'maxInstancesPerModel' instances, extra requests
+//! queue up to 'maxQueuedRequests' and are rejected with 429 (and 'Retry-After') beyond that. With "stream": true
+//! in the request body partial results are sent back as server-sent events while the evaluation runs.
+nvigi::Result addMicroService(Server& svr, const std::string& pathToModels, PFun_nvigiLoadInterface* nvigiLoadInterface, const MicroServiceParameters& config = {})
 {
     if (NVIGI_FAILED(error, nvigiGetInterfaceDynamic(plugin::tmpl::kBackendApi, &ctx._interface, nvigiLoadInterface)))
     {
         LOG_ERROR("slGPTGetInterface failed", { {"reason",error} });
         return error;
     }
+    ctx.config = config;
+    ctx.config.maxInstancesPerModel = std::max<size_t>(1, ctx.config.maxInstancesPerModel);
 
     //! IMPORTANT: Make sure your URL is unique, consider maybe using feature id to ensure that
     //! 
@@ -43,6 +153,7 @@ nvigi::Result addMicroService(Server& svr, const std::string& pathToModels, PFun
 
         //! Assuming body is JSON, change as needed
         std::string modelGUID;
+        bool stream = false;
         try
         {
             auto body = json::parse(req.body);
@@ -50,6 +161,7 @@ nvigi::Result addMicroService(Server& svr, const std::string& pathToModels, PFun
             //! We expect request to tell us which model to use
             modelGUID = getJSONValue(body, "model", modelGUID);
             params.common->modelGUID = modelGUID.c_str();
+            stream = getJSONValue(body, "stream", stream);
 
             //! Extract additional parameters related to your model
             //! 
@@ -62,65 +174,118 @@ nvigi::Result addMicroService(Server& svr, const std::string& pathToModels, PFun
             return;
         }
 
-        //! Create our instance, normally model GUID comes in the request above
-        nvigi::InferenceInstance* instance{};
+        //! Get an instance from the pool for this model, normally model GUID comes in the request above
         params.common->utf8PathToModels = pathToModels.c_str();
-
-        if (ctx.instances.find(params.common->modelGUID) != ctx.instances.end())
-        {
-            instance = ctx.instances[params.common->modelGUID];
-        }
-        else
+        auto pool = getPool(modelGUID);
+        std::shared_ptr<InstanceLease> lease;
+        if (NVIGI_FAILED(error, acquireInstance(pool, params, lease)))
         {
-            if (NVIGI_FAILED(error, ctx._interface->createInstance(params, &instance)))
+            if (error == kResultBusy)
+            {
+                // Backpressure, let the load balancer or client retry elsewhere/later
+                res.status = 429;
+                res.set_header("Retry-After", "1");
+            }
+            else if (error == kResultTimedOut)
             {
-                LOG_ERROR("gpt::createInstance failed", { {"model",params.common->modelGUID} , {"reason",error} });
-                return;
+                res.status = 503;
             }
-            ctx.instances[params.common->modelGUID] = instance;
+            else
+            {
+                LOG_ERROR("template::createInstance failed", { {"model",modelGUID} , {"reason",error} });
+                res.status = 500;
+            }
+            return;
         }
 
-        //! Setup your callback
-        auto callbackTemplate = [](const nvigi::InferenceExecutionContext* ctx, nvigi::InferenceExecutionState state, void* data)->nvigi::InferenceExecutionState
+        //! Change as needed if response isn't JSON etc.
+        auto makeResponse = [modelGUID](bool stop)->json
+        {
+            return json
+            {
+                {"stop", stop},
+                {"model", modelGUID},
+                //! Add your results as needed
+            };
+        };
+
+        //! Setup your callback, 'data' points to the function receiving each (partial) response
+        using Emit = std::function<bool(const json&)>;
+        auto callbackTemplate = [](const nvigi::InferenceExecutionContext* execCtx, nvigi::InferenceExecutionState state, void* data)->nvigi::InferenceExecutionState
         {
-            if (ctx)
+            auto& emit = *(Emit*)data;
+            if (execCtx)
             {
-                auto slots = &ctx->outputs;
+                auto slots = execCtx->outputs;
                 //const nvigi::InferenceDataText* text{};
                 //slots->findAndValidateSlot(nvigi::kGPTDataSlotResponse, &text);
+                json partial = json{ {"stop", state == nvigi::kInferenceExecutionStateDone} };
+                //! Add your partial results as needed
+                if (!emit(partial))
+                {
+                    // Client went away, no point in finishing the evaluation
+                    return nvigi::kInferenceExecutionStateCancel;
+                }
             }
             return state;
         };
-        
-        //! Setup and evaluate execution context
+
+        //! Setup and evaluate execution context, instance is ours until the lease is released
+        auto evaluate = [lease, callbackTemplate, modelGUID](Emit& emit)->nvigi::Result
         {
             //nvigi::InferenceDataText data(prompt.c_str());
             std::vector<nvigi::InferenceDataSlot> inSlots;// = { {nvigi::kGPTDataSlotSystem, &data} };
+            nvigi::InferenceDataSlotArray inputs = { inSlots.size(), inSlots.data() };
 
-            nvigi::InferenceExecutionContext ctx{};
-            ctx.instance = instance;
-            ctx.callback = callbackTemplate;
-            ctx.callbackUserData = nullptr;
-            ctx.inputs = { inSlots.size(), inSlots.data() };
-            if (NVIGI_FAILED(error, ctx.instance->evaluate(&ctx)))
+            nvigi::InferenceExecutionContext execCtx{};
+            execCtx.instance = lease->instance;
+            execCtx.callback = callbackTemplate;
+            execCtx.callbackUserData = &emit;
+            execCtx.inputs = &inputs;
+            if (NVIGI_FAILED(error, execCtx.instance->evaluate(&execCtx)))
             {
-                LOG_ERROR("template evaluate failed", { {"model",params.common->modelGUID} , {"reason", error} });
-                res.status = 400;
-                return;
+                LOG_ERROR("template evaluate failed", { {"model",modelGUID} , {"reason", error} });
+                return error;
             }
+            return kResultOk;
+        };
+
+        if (stream)
+        {
+            //! Partial results are sent as server-sent events from the connection thread as they are produced,
+            //! the lease travels with the provider so the instance stays busy until the stream is done
+            res.set_chunked_content_provider("text/event-stream", [evaluate, makeResponse](size_t, DataSink& sink) mutable
+            {
+                Emit emit = [&sink](const json& data)->bool
+                {
+                    auto event = "data: " + data.dump(-1, ' ', false, json::error_handler_t::replace) + "\n\n";
+                    return sink.write(event.data(), event.size());
+                };
+                if (evaluate(emit) != kResultOk)
+                {
+                    json error = makeResponse(true);
+                    error["error"] = "evaluation failed";
+                    emit(error);
+                }
+                sink.done();
+                return true;
+            });
+            return;
         }
 
-        //! Send back the response as JSON
-        //! 
-        //! Change as needed if response isn't JSON etc.
-        json data = json
+        json data = makeResponse(true);
+        Emit collect = [&data](const json& partial)->bool
         {
-            {"stop", true},
-            {"model", params.common->modelGUID},
-            {"n_threads", params.common->numThreads},
-            //! Add your results as needed
+            //! Merge partial results into the final response as needed
+            return true;
         };
+        if (evaluate(collect) != kResultOk)
+        {
+            res.status = 400;
+            return;
+        }
 
+        //! Send back the response as JSON
         res.set_content(data.dump(-1, ' ', false, json::error_handler_t::replace), "application/json");
     });
 
@@ -129,13 +294,21 @@ nvigi::Result addMicroService(Server& svr, const std::string& pathToModels, PFun
 
 Result removeMicroService()
 {
-    for (auto& [guid, instance] : ctx.instances)
+    std::scoped_lock lock(ctx.mtx);
+    for (auto& [guid, pool] : ctx.pools)
     {
-        if (NVIGI_FAILED(error, ctx._interface->destroyInstance(instance)))
+        std::scoped_lock poolLock(pool->mtx);
+        for (auto instance : pool->instances)
         {
-            return error;
+            if (NVIGI_FAILED(error, ctx._interface->destroyInstance(instance)))
+            {
+                return error;
+            }
         }
+        pool->instances.clear();
+        pool->idle.clear();
     }
+    ctx.pools.clear();
     return nvigi::kResultOk;
 }
 
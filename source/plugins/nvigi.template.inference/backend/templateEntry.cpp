@@ -53,6 +53,7 @@
 #include "versions.h"
 #include "nvigi_template_infer.h"
 #include "source/utils/nvigi.ai/ai.h"
+#include "source/core/nvigi.resources/resources.h"
 #include "_artifacts/gitVersion.h"
 
 // Modern plugin framework - provides all the base functionality
@@ -64,6 +65,35 @@ using namespace nvigi::plugin::modern;
 namespace nvigi
 {
 
+// ============================================================================
+// Model Weights
+// ============================================================================
+// Immutable model data shared by all instances of the same model, backend and
+// device through the core model cache. Creating eight instances of the same
+// model keeps a single copy of the weights in RAM and VRAM.
+//
+// IMPORTANT: Anything modified during evaluation (KV cache, streams, scratch
+// buffers) belongs in InstanceContext, never here.
+//
+struct ModelWeights
+{
+    std::string modelPath;
+    json modelConfig;
+
+    // Add your model handle here
+    // Example:
+    // void* model = nullptr;
+
+    ~ModelWeights() {
+        // Free your model here, runs once the last instance using it is destroyed
+        // Example:
+        // if (model) {
+        //     your_model_free(model);
+        //     model = nullptr;
+        // }
+    }
+};
+
 // ============================================================================
 // Instance Context
 // ============================================================================
@@ -75,15 +105,13 @@ namespace nvigi
 //
 struct InstanceContext
 {
-    // Model configuration
-    std::string modelPath;
-    json modelConfig;
+    // Shared immutable model data, see ModelWeights
+    std::shared_ptr<const ModelWeights> weights;
     bool isInitialized = false;
 
-    // Add your model-specific state here
+    // Add your per-instance mutable state here
     // Example:
-    // void* model = nullptr;  // Your model handle
-    // std::vector<float> embeddings;
+    // void* session = nullptr;  // KV cache, scratch buffers etc.
 
 #if defined(PLUGIN_USES_CUDA)
     // CUDA context management
@@ -125,11 +153,11 @@ struct InstanceContext
 #endif
 
     ~InstanceContext() {
-        // Clean up your model resources here
+        // Clean up your per-instance resources here, weights are released automatically
         // Example:
-        // if (model) {
-        //     your_model_free(model);
-        //     model = nullptr;
+        // if (session) {
+        //     your_session_free(session);
+        //     session = nullptr;
         // }
     }
 };
@@ -327,6 +355,11 @@ public:
             // bool enableOptimization = extendedParams->enableOptimization;
         }
 
+        // CPU backends should size their thread pools from the resolved budget instead of the core count,
+        // it honors the host's 'CpuThreadBudget' (if any) so we do not compete with the host's job system
+        auto cpuThreads = system::getCpuThreadAssignment(params, (uint32_t)std::max(common->numThreads, 1));
+        NVIGI_LOG_VERBOSE("Using %u CPU thread(s), affinity 0x%llx", cpuThreads.threadCount, cpuThreads.affinityMask);
+
         // Unified model discovery - handles ALL three approaches automatically!
         // Just pass FileIOCallbacks and ai::findModels() does the rest
         auto ioCallbacks = findStruct<FileIOCallbacks>(params);
@@ -414,74 +447,107 @@ public:
         state = std::make_unique<InstanceContext>();
 #endif
 
-        state->modelPath = pathToModel;
+        // Weights are immutable and shared by every instance of this model on the same backend and device,
+        // only the first instance loads them, the rest get a reference (see source/core/nvigi.resources/resources.h)
+        resources::ModelResourceKey weightsKey{};
+        weightsKey.plugin = plugin::template_ai::kId;
+        weightsKey.modelGUID = modelKey.c_str();
+#if defined(PLUGIN_USES_CUDA)
+        weightsKey.backend = "cuda";
+        // weightsKey.device = deviceId;
+#elif defined(PLUGIN_USES_D3D12)
+        weightsKey.backend = "d3d12";
+#else
+        weightsKey.backend = "cpu";
+#endif
+
+        std::string loadError;
+        Result loadResult = kResultOk;
+        state->weights = resources::acquireShared<ModelWeights>(weightsKey, [&]()->ModelWeights*
+        {
+            auto weights = std::make_unique<ModelWeights>();
+            weights->modelPath = pathToModel;
+            weights->modelConfig = modelCard;
 
-        // Initialize your model here
-        // Replace this with your actual model loading code
+            // Initialize your model here
+            // Replace this with your actual model loading code
 
 #if defined(PLUGIN_USES_CUDA)
-        // Example: Set up CUDA device from parameters
-        // auto cudaParams = findStruct<CudaParameters>(params);
-        // int deviceId = cudaParams ? cudaParams->device : 0;
-        // 
-        // Example model initialization with CUDA:
-        // your_model_context_params modelParams = your_model_default_params();
-        // modelParams.use_gpu = true;
-        // modelParams.gpu_device = deviceId;
-        // state->model = your_model_init_from_file_with_params(pathToModel.c_str(), modelParams);
-        // if (!state->model) {
-        //     return std::unexpected(Error{kResultInvalidState, "Failed to initialize model"});
-        // }
-        //
-        // Example: Get CUDA streams from model for async operations
-        // size_t streamCount = your_model_get_stream_count(state->model);
-        // state->cudaStreams.resize(streamCount);
-        // your_model_get_streams(state->model, (void**)state->cudaStreams.data(), streamCount);
-        // NVIGI_LOG_INFO("Initialized %zu CUDA streams", streamCount);
+            // Example: Set up CUDA device from parameters
+            // auto cudaParams = findStruct<CudaParameters>(params);
+            // int deviceId = cudaParams ? cudaParams->device : 0;
+            // 
+            // Example model initialization with CUDA:
+            // your_model_context_params modelParams = your_model_default_params();
+            // modelParams.use_gpu = true;
+            // modelParams.gpu_device = deviceId;
+            // weights->model = your_model_init_from_file_with_params(pathToModel.c_str(), modelParams);
+            // if (!weights->model) {
+            //     loadError = "Failed to initialize model"; return nullptr;
+            // }
 #else
-        // CPU-only model initialization
-        // state->model = your_model_init_from_file(pathToModel.c_str());
-        // if (!state->model) {
-        //     return std::unexpected(Error{kResultInvalidState, "Failed to initialize model"});
-        // }
+            // CPU-only model initialization
+            // weights->model = your_model_init_from_file(pathToModel.c_str());
+            // if (!weights->model) {
+            //     loadError = "Failed to initialize model"; return nullptr;
+            // }
 #endif
 
-        // If using IO callbacks, load model files through callbacks instead of standard file I/O
-        // This allows host to provide custom file handling (encryption, compression, virtual filesystems, etc.)
-        if (ioCallbacks) {
-            NVIGI_LOG_INFO("Loading model '%s' using FileIOCallbacks", pathToModel.c_str());
+            // If using IO callbacks, load model files through callbacks instead of standard file I/O
+            // This allows host to provide custom file handling (encryption, compression, virtual filesystems, etc.)
+            if (ioCallbacks) {
+                NVIGI_LOG_INFO("Loading model '%s' using FileIOCallbacks", pathToModel.c_str());
             
-            // Example: Load model file(s) using callbacks
-            auto handle = ioCallbacks->open(ioCallbacks->userData, pathToModel.c_str(), "rb");
-            if (!handle) {
-                 return std::unexpected(Error{kResultInvalidParameter, "Failed to open model file via callbacks"});
-            }
-            size_t size = ioCallbacks->size(ioCallbacks->userData, handle);
-            std::vector<char> buffer(size);
-            size_t bytesRead = ioCallbacks->read(ioCallbacks->userData, handle, buffer.data(), size);
-            ioCallbacks->close(ioCallbacks->userData, handle);
+                // Example: Load model file(s) using callbacks
+                auto handle = ioCallbacks->open(ioCallbacks->userData, pathToModel.c_str(), "rb");
+                if (!handle) {
+                     loadError = "Failed to open model file via callbacks";
+                     return nullptr;
+                }
+                size_t size = ioCallbacks->size(ioCallbacks->userData, handle);
+                std::vector<char> buffer(size);
+                size_t bytesRead = ioCallbacks->read(ioCallbacks->userData, handle, buffer.data(), size);
+                ioCallbacks->close(ioCallbacks->userData, handle);
              
-            if (bytesRead != size) {
-                return std::unexpected(Error{kResultInvalidParameter, "Failed to read complete model file"});
-            }
+                if (bytesRead != size) {
+                    loadError = "Failed to read complete model file";
+                    return nullptr;
+                }
              
-            // // Load model from buffer
-            // state->model = your_model_init_from_buffer(buffer.data(), buffer.size());
-            // if (!state->model) {
-            //     return std::unexpected(Error{kResultInvalidState, "Failed to initialize model from buffer"});
-            // }
-        }
-        else {
-            // No callbacks - use standard file I/O from disk path
-            NVIGI_LOG_INFO("Loading model '%s' using standard file I/O", pathToModel.c_str());
+                // // Load model from buffer
+                // weights->model = your_model_init_from_buffer(buffer.data(), buffer.size());
+                // if (!weights->model) {
+                //     loadError = "Failed to initialize model from buffer"; return nullptr;
+                // }
+            }
+            else {
+                // No callbacks - use standard file I/O from disk path
+                NVIGI_LOG_INFO("Loading model '%s' using standard file I/O", pathToModel.c_str());
             
-            // Example: Load model from disk
-            // state->model = your_model_init_from_file(pathToModel.c_str());
-            // if (!state->model) {
-            //     return std::unexpected(Error{kResultInvalidState, "Failed to initialize model from file"});
-            // }
+                // Example: Load model from disk
+                // weights->model = your_model_init_from_file(pathToModel.c_str());
+                // if (!weights->model) {
+                //     loadError = "Failed to initialize model from file"; return nullptr;
+                // }
+            }
+
+            return weights.release();
+        }, &loadResult);
+
+        if (!state->weights) {
+            return std::unexpected(Error{
+                loadResult != kResultOk ? loadResult : kResultInvalidState,
+                loadError.empty() ? "Failed to load model weights" : loadError
+            });
         }
 
+#if defined(PLUGIN_USES_CUDA)
+        // Per-instance GPU state goes on top of the shared weights
+        // Example: Create CUDA streams for async operations
+        // state->cudaStreams.resize(streamCount);
+        // for (auto& stream : state->cudaStreams) cudaStreamCreate(&stream);
+#endif
+
         state->isInitialized = true;
 
         // Store instance context in pluginData (MUST use std::shared_ptr for proper lifetime management)
@@ -539,6 +605,37 @@ public:
         return {};
     }
 
+    //! OPTIONAL - Called when an instance is handed back via releaseInstance()
+    //! Clear per-session state here so the instance can be pooled and reused, weights and
+    //! backend state stay loaded. Remove this method if your instance cannot be reset,
+    //! releaseInstance() then simply destroys the instance.
+    static Expected<void> onReset(std::any& pluginData)
+    {
+        auto statePtr = std::any_cast<std::shared_ptr<InstanceContext>>(&pluginData);
+        if (!statePtr || !*statePtr) {
+            return std::unexpected(Error{kResultInvalidState, "Instance context not initialized"});
+        }
+
+        // Example: Clear conversation history / KV cache
+        // your_session_reset((*statePtr)->session);
+
+        return {};
+    }
+
+    //! OPTIONAL - Called on a background thread by swapModel() to build the state for the new model
+    //! Without it the new state is created with onCreateInstance(). 'current' is still evaluating, share
+    //! only immutable parts such as base weights, e.g. when only a LoRA adapter changes.
+    //!
+    //! static Expected<void> onSwapModel(const NVIGIParameter* params, const std::any& current, std::any& next)
+    //! {
+    //!     auto currentState = std::any_cast<std::shared_ptr<InstanceContext>>(&current);
+    //!     auto state = std::make_shared<InstanceContext>();
+    //!     // state->baseWeights = (*currentState)->baseWeights;
+    //!     // state->lora = your_load_lora(params);
+    //!     next = state;
+    //!     return {};
+    //! }
+
     // ========================================================================
     // Inference Execution
     // ========================================================================
@@ -639,6 +736,20 @@ public:
         //     NVIGI_LOG_VERBOSE("Runtime config: temp=%.2f, maxTokens=%d", temperature, maxTokens);
         // }
 
+        // ====================================================================
+        // Restore Persistent State (Optional)
+        // ====================================================================
+        // Hosts can pass back 'kInferenceDataSlotStateOut' from an earlier evaluation (or a memory mapped file,
+        // see ai_state.h) as 'kInferenceDataSlotStateIn' so the conversation history is not processed again.
+        // Mismatching model or format returns nullopt, just process the full prompt in that case.
+
+        // Example: Restore KV cache
+        // const uint64_t modelHash = getInferenceStateModelHash(state->weights->modelPath.c_str());
+        // if (auto restored = ctx.getInputState(kYourStateFormat, 1, modelHash)) {
+        //     your_model_restore(state->model, restored->payload, restored->payloadSize);
+        //     // prompt now only needs to contain what comes after restored->tokenCount
+        // }
+
         // ====================================================================
         // Check Cancellation
         // ====================================================================
@@ -667,22 +778,34 @@ public:
         //     return std::unexpected(Error{kResultInvalidState, "Model generation failed"});
         // }
 
-        // Example: For long operations, check cancellation periodically
-        // This allows the host to interrupt processing if needed
+        // Example: For long operations, check cancellation periodically (e.g. once per token)
+        // This allows the host to interrupt processing if needed, otherwise cancelAsyncEvaluation()
+        // waits for the whole generation (see "cancel_to_idle_us" metric)
         // const int maxSteps = 100;
         // for (int step = 0; step < maxSteps; ++step) {
-        //     if (ctx.isCancelled()) {
+        //     if (auto cancelled = ctx.checkCancelled(); !cancelled) {
         //         NVIGI_LOG_VERBOSE("Inference cancelled at step %d", step);
-        //         return std::unexpected(Error{
-        //             kResultCanceled,
-        //             "Evaluation cancelled during processing"
-        //         });
+        //         return cancelled;
         //     }
         //     
         //     // Perform one step of computation
         //     // your_model_step(state->model);
         // }
 
+        // Example: Time slicing, host may run 'evaluate' on the render thread with a per-frame budget
+        // (see 'EvaluationBudgetParameters'), keep your progress in the resume state and stop at safe points
+        // auto& step = ctx.isResuming() ? std::any_cast<int&>(ctx.getResumeState()) : ctx.getResumeState().emplace<int>(0);
+        // for (; step < maxSteps; ++step) {
+        //     your_model_step(state->model);
+        //     if (ctx.shouldSuspend()) { ++step; return {}; } // base reports kInferenceExecutionStateSuspended
+        // }
+
+        // Example: Blocking network transfers (cloud backends) are aborted through the same flag
+        // auto token = ctx.getCancellationToken();
+        // netParams.cancelCallback = token.isCancelled;
+        // netParams.cancelUserData = token.userData;
+        // auto res = inet->nvcfPost(netParams, response); // kResultNetCanceled if cancelled mid transfer
+
         // ====================================================================
         // Set Outputs (Type-Safe and Ergonomic)
         // ====================================================================
@@ -711,8 +834,49 @@ public:
         //     .set("confidence", 0.95f)
         //     .set("tokens", tokenCount)
         //     .build();
+
+        // Streaming plugins should emit tokens with appendText() instead, it honors the host's coalescing
+        // thresholds (see 'TextStreamingParameters') and delivers the remainder once onEvaluate() returns:
+        // for (auto& token : your_model_generate(prompt))
+        // {
+        //     if (auto res = ctx.appendText(kTemplateAIOutputResponse, token); !res) return res;
+        // }
+        // return {};
+
+        // To export state for the next turn set it before building the outputs:
+        // auto snapshot = your_model_save(state->model);
+        // ctx.setOutputState(kYourStateFormat, 1, modelHash, tokenCount, snapshot.data(), snapshot.size());
+        // or keep it on the GPU: ctx.setDeviceOutputState(kYourStateFormat, 1, modelHash, tokenCount, cudaData);
     }
 
+    //! Batched inference callback (optional) - called for 'evaluateBatch'
+    //!
+    //! If not implemented the framework simply calls onEvaluate() for each context.
+    //! Implement it to fuse all requests into a single forward pass, each context
+    //! has its own inputs and outputs and .build() delivers its callback as soon
+    //! as that context is done.
+    //!
+    //! static Expected<void> onEvaluateBatch(std::span<PluginContext*> batch)
+    //! {
+    //!     // Gather inputs from all contexts, run your model once
+    //!     // your_model_forward(prompts);
+    //!     for (auto ctx : batch) {
+    //!         auto result = ctx->buildOutput().set(kTemplateAIOutputResponse, response).build();
+    //!         if (!result) return result;
+    //!     }
+    //!     return {};
+    //! }
+
+    //! Runtime parameters recorded by 'EvaluationCaptureParameters' (optional)
+    //!
+    //! Only flat structs (no pointer members) can be captured and replayed, anything else is skipped.
+    //!
+    //! static std::span<const ai::CaptureStructDesc> getCapturedRuntimeParameters()
+    //! {
+    //!     static const ai::CaptureStructDesc s_structs[] = { { TemplateAIRuntimeParameters::s_type, sizeof(TemplateAIRuntimeParameters) } };
+    //!     return s_structs;
+    //! }
+
     //! Cancellation callback - called when host requests cancellation
     //! 
     //! This is called when the host wants to cancel an ongoing async evaluation.
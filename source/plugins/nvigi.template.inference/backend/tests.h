@@ -9,6 +9,7 @@
 #include "source/plugins/nvigi.template.inference/nvigi_template_infer.h"
 #include "source/utils/nvigi.ai/ai_data_helpers.h"
 #include "source/core/nvigi.api/nvigi_io.h"
+#include "source/core/nvigi.api/nvigi_cuda.h"
 
 namespace nvigi
 {
@@ -625,6 +626,78 @@ TEST_CASE("template_ai_mixed_approaches_validation", "[template],[inference],[cp
     NVIGI_LOG_TEST_INFO("Validation tests completed");
 }
 
+//! Test instance pooling (plugin implements onReset)
+TEST_CASE("template_ai_pool", "[template],[inference],[cpu],[pool]")
+{
+    nvigi::ITemplateAI* itemplate{};
+    REQUIRE(nvigiGetInterfaceDynamic(plugin::template_ai::kId, &itemplate, params.nvigiLoadInterface) == nvigi::kResultOk);
+    REQUIRE(itemplate->getVersion() >= kStructVersion2);
+
+    CommonCreationParameters common{};
+    common.modelGUID = "{01234567-0123-0123-0123-0123456789AB}";
+    common.utf8PathToModels = params.modelDir.c_str();
+    common.numThreads = 1;
+    TemplateAICreationParameters templateParams{};
+    templateParams.chain(common);
+
+    nvigi::InferenceInstance* first{};
+    auto result = nvigi::acquireInstance(itemplate, templateParams, &first);
+    if (result == nvigi::kResultOk)
+    {
+        REQUIRE(nvigi::releaseInstance(itemplate, first) == nvigi::kResultOk);
+
+        // Same parameters get the warm instance back
+        nvigi::InferenceInstance* second{};
+        REQUIRE(nvigi::acquireInstance(itemplate, templateParams, &second) == nvigi::kResultOk);
+        REQUIRE(second == first);
+
+        // Different parameters never do
+        common.numThreads = 2;
+        nvigi::InferenceInstance* third{};
+        REQUIRE(nvigi::acquireInstance(itemplate, templateParams, &third) == nvigi::kResultOk);
+        REQUIRE(third != second);
+
+        REQUIRE(nvigi::releaseInstance(itemplate, second) == nvigi::kResultOk);
+        REQUIRE(nvigi::releaseInstance(itemplate, third) == nvigi::kResultOk);
+
+        // Device parameters are matched by content, not by where the host keeps them
+        {
+            CudaParameters cuda{};
+            cuda.device = 0;
+            common.chain(cuda);
+            nvigi::InferenceInstance* device0{};
+            REQUIRE(nvigi::acquireInstance(itemplate, templateParams, &device0) == nvigi::kResultOk);
+            REQUIRE(nvigi::releaseInstance(itemplate, device0) == nvigi::kResultOk);
+            common._base.next = nullptr;
+
+            CudaParameters sameDevice{};
+            sameDevice.device = 0;
+            common.chain(sameDevice);
+            nvigi::InferenceInstance* again{};
+            REQUIRE(nvigi::acquireInstance(itemplate, templateParams, &again) == nvigi::kResultOk);
+            REQUIRE(again == device0);
+
+            sameDevice.device = 1;
+            nvigi::InferenceInstance* device1{};
+            REQUIRE(nvigi::acquireInstance(itemplate, templateParams, &device1) == nvigi::kResultOk);
+            REQUIRE(device1 != again);
+            REQUIRE(nvigi::releaseInstance(itemplate, again) == nvigi::kResultOk);
+            REQUIRE(nvigi::releaseInstance(itemplate, device1) == nvigi::kResultOk);
+            common._base.next = nullptr;
+        }
+
+        REQUIRE(itemplate->trimInstancePool(0) == nvigi::kResultOk);
+        // Restore default pool size for other tests
+        REQUIRE(itemplate->trimInstancePool(4) == nvigi::kResultOk);
+    }
+    else
+    {
+        NVIGI_LOG_TEST_WARN("Pool test skipped (no model files available)");
+    }
+
+    REQUIRE(params.nvigiUnloadInterface(plugin::template_ai::kId, itemplate) == nvigi::kResultOk);
+}
+
 //! Add more test cases as needed
 //! Examples:
 //! - Test with different input types (images, tensors, etc.)
@@ -0,0 +1,495 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+
+#include "source/utils/nvigi.ai/nvigi_ai.h"
+#include "source/utils/nvigi.ai/ai_data_helpers.h"
+#include "source/core/nvigi.metrics/metrics.h"
+#include "source/plugins/nvigi.template.inference/nvigi_template_infer.h"
+#include "external/json/source/nlohmann/json.hpp"
+
+//! Load generator for any 'InferenceInterface'
+//!
+//! Functional tests run a single pass, this drives a plugin with N concurrent workers (one instance each or
+//! a shared instance), optionally at a fixed request rate, and reports per request latency, time to first result,
+//! throughput, VRAM and the plugin side histograms from 'IMetrics'. Reports are JSON or CSV so they can be diffed
+//! between SDK builds.
+//!
+//! Hidden by default, run with:
+//!
+//! nvigi.test.exe [load] --load-concurrency 1,4,16,64 --load-mode async --load-requests 32 --load-report load.json
+namespace nvigi
+{
+namespace load
+{
+
+enum class LoadMode
+{
+    eSync,
+    eAsync,
+    ePolled
+};
+
+inline const char* toStr(LoadMode mode)
+{
+    switch (mode)
+    {
+        case LoadMode::eSync: return "sync";
+        case LoadMode::eAsync: return "async";
+        case LoadMode::ePolled: return "polled";
+    };
+    return "unknown";
+}
+
+inline LoadMode toLoadMode(const std::string& name)
+{
+    if (name == "async") return LoadMode::eAsync;
+    if (name == "polled") return LoadMode::ePolled;
+    return LoadMode::eSync;
+}
+
+struct LoadConfig
+{
+    //! Each level is a separate run with its own report entry
+    std::vector<uint32_t> concurrency = { 1, 4, 16, 64 };
+    //! Requests issued by each worker per level
+    uint32_t requestsPerWorker = 16;
+    //! Total requests per second across all workers, 0 runs closed loop (next request as soon as the previous one is done)
+    double requestsPerSecond = 0.0;
+    LoadMode mode = LoadMode::eSync;
+    //! Workers share one instance (sessions) instead of creating their own, plugin must allow concurrent evaluation
+    bool sharedInstance = false;
+    //! Prompts used round robin, from a text file with one prompt per line
+    std::vector<std::string> corpus = { "Hello, how are you today?" };
+    //! Input slot the corpus entries go into, plugin specific
+    std::string inputSlot;
+    //! Report path, '.csv' writes CSV otherwise JSON
+    std::string reportPath;
+};
+
+//! Comma separated list of concurrency levels, e.g. "1,4,16,64"
+inline std::vector<uint32_t> parseConcurrency(const std::string& list)
+{
+    std::vector<uint32_t> levels;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (!item.empty()) levels.push_back(std::max(1u, (uint32_t)std::stoul(item)));
+    }
+    return levels;
+}
+
+inline std::vector<std::string> loadCorpus(const std::string& path)
+{
+    std::vector<std::string> corpus;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty()) corpus.push_back(line);
+    }
+    return corpus;
+}
+
+using clock = std::chrono::steady_clock;
+
+//! One request, shared with the callback via 'callbackUserData'
+struct RequestState
+{
+    clock::time_point start{};
+    clock::time_point firstResult{};
+    clock::time_point end{};
+    uint32_t results{};
+    InferenceExecutionState lastState = kInferenceExecutionStateInvalid;
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool done{};
+
+    void onResult(InferenceExecutionState state)
+    {
+        auto now = clock::now();
+        std::scoped_lock lock(mtx);
+        if (results++ == 0) firstResult = now;
+        lastState = state;
+        if (state == kInferenceExecutionStateDone || state == kInferenceExecutionStateInvalid || state == kInferenceExecutionStateCancel)
+        {
+            end = now;
+            done = true;
+            cv.notify_all();
+        }
+    }
+
+    //! Plugins are not required to report 'kInferenceExecutionStateDone' from a blocking evaluate
+    void finish()
+    {
+        std::scoped_lock lock(mtx);
+        end = clock::now();
+        if (lastState == kInferenceExecutionStateInvalid && results) lastState = kInferenceExecutionStateDone;
+        done = true;
+    }
+
+    void wait()
+    {
+        std::unique_lock lock(mtx);
+        cv.wait(lock, [this]()->bool { return done; });
+    }
+};
+
+struct RequestSample
+{
+    double latencyMs{};
+    double timeToFirstResultMs{};
+    uint32_t results{};
+    Result result = kResultOk;
+};
+
+struct Percentiles
+{
+    double mean{};
+    double p50{};
+    double p90{};
+    double p99{};
+    double max{};
+};
+
+inline Percentiles getPercentiles(std::vector<double> values)
+{
+    Percentiles p{};
+    if (values.empty()) return p;
+    std::sort(values.begin(), values.end());
+    auto at = [&values](double percentile)->double
+    {
+        auto index = (size_t)std::ceil(percentile / 100.0 * double(values.size()));
+        return values[std::clamp<size_t>(index, 1, values.size()) - 1];
+    };
+    double sum = 0.0;
+    for (auto v : values) sum += v;
+    p.mean = sum / double(values.size());
+    p.p50 = at(50.0);
+    p.p90 = at(90.0);
+    p.p99 = at(99.0);
+    p.max = values.back();
+    return p;
+}
+
+struct LevelReport
+{
+    uint32_t concurrency{};
+    uint32_t requests{};
+    uint32_t errors{};
+    double durationMs{};
+    double requestsPerSecond{};
+    double resultsPerSecond{};
+    Percentiles latencyMs{};
+    Percentiles timeToFirstResultMs{};
+    size_t vramBeforeMB{};
+    size_t vramPeakMB{};
+    size_t vramAfterMB{};
+    //! Plugin side histograms, see 'IMetrics'
+    std::vector<metrics::HistogramSnapshot> histograms;
+    std::vector<std::string> histogramNames;
+};
+
+struct LoadReport
+{
+    PluginID feature{};
+    LoadConfig config{};
+    std::vector<LevelReport> levels;
+};
+
+inline InferenceExecutionState loadCallback(const InferenceExecutionContext* ctx, InferenceExecutionState state, void* userData)
+{
+    auto request = (RequestState*)userData;
+    request->onResult(state);
+    return state;
+}
+
+//! Processes one request on 'instance' in the requested mode, returns once the final result arrived
+inline RequestSample runRequest(const LoadConfig& config, InferenceInstance* instance, IPolledInferenceInterface* ipolled, const std::string& prompt, clock::time_point scheduled)
+{
+    RequestState request{};
+    request.start = scheduled;
+
+    ai::InferenceDataTextHelper promptHelper(prompt);
+    InferenceDataSlot inputSlots[] = { {config.inputSlot.c_str(), promptHelper} };
+    InferenceDataSlotArray inputs = { 1, inputSlots };
+
+    InferenceExecutionContext execCtx{};
+    execCtx.instance = instance;
+    execCtx.inputs = &inputs;
+
+    RequestSample sample{};
+    if (config.mode == LoadMode::eSync)
+    {
+        execCtx.callback = loadCallback;
+        execCtx.callbackUserData = &request;
+        sample.result = instance->evaluate(&execCtx);
+        if (!request.done) request.finish();
+    }
+    else if (config.mode == LoadMode::eAsync)
+    {
+        execCtx.callback = loadCallback;
+        execCtx.callbackUserData = &request;
+        sample.result = instance->evaluateAsync ? instance->evaluateAsync(&execCtx) : kResultNoImplementation;
+        if (sample.result == kResultOk) request.wait();
+    }
+    else
+    {
+        sample.result = instance->evaluateAsync && ipolled ? instance->evaluateAsync(&execCtx) : kResultNoImplementation;
+        while (sample.result == kResultOk && !request.done)
+        {
+            InferenceExecutionState state{};
+            auto res = ipolled->getResults(&execCtx, true, &state);
+            if (res == kResultOk)
+            {
+                request.onResult(state);
+                ipolled->releaseResults(&execCtx, state);
+            }
+            else if (res != kResultNotReady)
+            {
+                sample.result = res;
+            }
+        }
+    }
+
+    if (sample.result == kResultOk && request.lastState == kInferenceExecutionStateInvalid) sample.result = kResultInvalidState;
+    if (!request.done) request.finish();
+    sample.results = request.results;
+    sample.latencyMs = std::chrono::duration<double, std::milli>(request.end - request.start).count();
+    sample.timeToFirstResultMs = request.results ? std::chrono::duration<double, std::milli>(request.firstResult - request.start).count() : 0.0;
+    return sample;
+}
+
+inline size_t getCurrentVRAMUsageMB(system::ISystem* isystem)
+{
+    system::VRAMUsage usage{};
+    if (!isystem || isystem->getVRAMStatsCopy(0, &usage) != kResultOk) return 0;
+    return usage.currentUsageMB;
+}
+
+//! Runs all concurrency levels from 'config' against 'iface', instances are created with 'creationParams'
+inline Result runLoad(const LoadConfig& config, const PluginID& feature, InferenceInterface* iface, IPolledInferenceInterface* ipolled,
+    const NVIGIParameter* creationParams, system::ISystem* isystem, metrics::IMetrics* imetrics, LoadReport& report)
+{
+    if (!iface || config.corpus.empty() || config.inputSlot.empty()) return kResultInvalidParameter;
+    report.feature = feature;
+    report.config = config;
+
+    for (auto concurrency : config.concurrency)
+    {
+        LevelReport level{};
+        level.concurrency = concurrency;
+        level.vramBeforeMB = getCurrentVRAMUsageMB(isystem);
+
+        std::vector<InferenceInstance*> instances(config.sharedInstance ? 1 : concurrency);
+        for (auto& instance : instances)
+        {
+            if (NVIGI_FAILED(result, iface->createInstance(creationParams, &instance)))
+            {
+                for (auto i : instances) if (i) iface->destroyInstance(i);
+                return result;
+            }
+        }
+        if (imetrics) imetrics->reset(&feature, nullptr);
+
+        // Sample VRAM while the level runs
+        std::atomic<bool> running = true;
+        std::atomic<size_t> vramPeak = getCurrentVRAMUsageMB(isystem);
+        std::thread vramSampler([&]()->void
+        {
+            while (running)
+            {
+                vramPeak = std::max(vramPeak.load(), getCurrentVRAMUsageMB(isystem));
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            }
+        });
+
+        const uint32_t totalRequests = concurrency * config.requestsPerWorker;
+        std::vector<RequestSample> samples(totalRequests);
+        std::atomic<uint32_t> nextTicket{};
+        auto start = clock::now();
+        std::vector<std::thread> workers;
+        for (uint32_t w = 0; w < concurrency; w++)
+        {
+            workers.emplace_back([&, w]()->void
+            {
+                auto instance = instances[config.sharedInstance ? 0 : w];
+                for (uint32_t ticket = nextTicket++; ticket < totalRequests; ticket = nextTicket++)
+                {
+                    // Open loop, latency is measured from when the request was due so queueing shows up in the numbers
+                    auto scheduled = clock::now();
+                    if (config.requestsPerSecond > 0.0)
+                    {
+                        scheduled = start + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(ticket / config.requestsPerSecond));
+                        std::this_thread::sleep_until(scheduled);
+                    }
+                    samples[ticket] = runRequest(config, instance, ipolled, config.corpus[ticket % config.corpus.size()], scheduled);
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+        level.durationMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+        running = false;
+        vramSampler.join();
+        level.vramPeakMB = vramPeak;
+
+        std::vector<double> latency, ttfr;
+        uint64_t results = 0;
+        for (auto& sample : samples)
+        {
+            if (sample.result != kResultOk)
+            {
+                level.errors++;
+                continue;
+            }
+            latency.push_back(sample.latencyMs);
+            ttfr.push_back(sample.timeToFirstResultMs);
+            results += sample.results;
+        }
+        level.requests = totalRequests;
+        level.latencyMs = getPercentiles(latency);
+        level.timeToFirstResultMs = getPercentiles(ttfr);
+        level.requestsPerSecond = level.durationMs > 0.0 ? double(latency.size()) * 1000.0 / level.durationMs : 0.0;
+        level.resultsPerSecond = level.durationMs > 0.0 ? double(results) * 1000.0 / level.durationMs : 0.0;
+
+        if (imetrics)
+        {
+            imetrics->enumerate(&feature, [](const metrics::HistogramSnapshot* snapshot, void* userData)->void
+            {
+                auto level = (LevelReport*)userData;
+                level->histograms.push_back(*snapshot);
+                level->histogramNames.push_back(snapshot->name);
+            }, &level);
+        }
+
+        for (auto instance : instances) iface->destroyInstance(instance);
+        level.vramAfterMB = getCurrentVRAMUsageMB(isystem);
+        report.levels.push_back(std::move(level));
+    }
+    return kResultOk;
+}
+
+inline nlohmann::json toJSON(const Percentiles& p)
+{
+    return { {"mean", p.mean}, {"p50", p.p50}, {"p90", p.p90}, {"p99", p.p99}, {"max", p.max} };
+}
+
+inline bool writeReport(const LoadReport& report, const std::string& path)
+{
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+
+    auto feature = extra::guidToString(report.feature.id);
+    if (path.ends_with(".csv"))
+    {
+        file << "feature,mode,concurrency,requests,errors,duration_ms,requests_per_s,results_per_s,"
+            "latency_p50_ms,latency_p90_ms,latency_p99_ms,ttfr_p50_ms,ttfr_p90_ms,ttfr_p99_ms,vram_before_mb,vram_peak_mb,vram_after_mb\n";
+        for (auto& l : report.levels)
+        {
+            file << feature << "," << toStr(report.config.mode) << "," << l.concurrency << "," << l.requests << "," << l.errors << ","
+                << l.durationMs << "," << l.requestsPerSecond << "," << l.resultsPerSecond << ","
+                << l.latencyMs.p50 << "," << l.latencyMs.p90 << "," << l.latencyMs.p99 << ","
+                << l.timeToFirstResultMs.p50 << "," << l.timeToFirstResultMs.p90 << "," << l.timeToFirstResultMs.p99 << ","
+                << l.vramBeforeMB << "," << l.vramPeakMB << "," << l.vramAfterMB << "\n";
+        }
+        return true;
+    }
+
+    nlohmann::json root;
+    root["sdk"] = extra::format("{}.{}.{}", NVIGI_CORESDK_VERSION_MAJOR, NVIGI_CORESDK_VERSION_MINOR, NVIGI_CORESDK_VERSION_PATCH);
+    root["feature"] = feature;
+    root["mode"] = toStr(report.config.mode);
+    root["sharedInstance"] = report.config.sharedInstance;
+    root["requestsPerWorker"] = report.config.requestsPerWorker;
+    root["targetRequestsPerSecond"] = report.config.requestsPerSecond;
+    for (auto& l : report.levels)
+    {
+        nlohmann::json level;
+        level["concurrency"] = l.concurrency;
+        level["requests"] = l.requests;
+        level["errors"] = l.errors;
+        level["durationMs"] = l.durationMs;
+        level["requestsPerSecond"] = l.requestsPerSecond;
+        level["resultsPerSecond"] = l.resultsPerSecond;
+        level["latencyMs"] = toJSON(l.latencyMs);
+        level["timeToFirstResultMs"] = toJSON(l.timeToFirstResultMs);
+        level["vramMB"] = { {"before", l.vramBeforeMB}, {"peak", l.vramPeakMB}, {"after", l.vramAfterMB} };
+        for (size_t i = 0; i < l.histograms.size(); i++)
+        {
+            auto& h = l.histograms[i];
+            level["plugin"][l.histogramNames[i]] = { {"count", h.count}, {"mean", h.mean}, {"p50", h.p50}, {"p90", h.p90}, {"p99", h.p99}, {"max", h.max} };
+        }
+        root["levels"].push_back(level);
+    }
+    file << root.dump(2);
+    return true;
+}
+
+inline void logReport(const LoadReport& report)
+{
+    for (auto& l : report.levels)
+    {
+        NVIGI_LOG_TEST_INFO("load[%s] x%u: %.2f req/s, latency p50 %.2fms p99 %.2fms, ttfr p50 %.2fms p99 %.2fms, errors %u, VRAM peak %lluMB",
+            toStr(report.config.mode), l.concurrency, l.requestsPerSecond, l.latencyMs.p50, l.latencyMs.p99,
+            l.timeToFirstResultMs.p50, l.timeToFirstResultMs.p99, l.errors, (unsigned long long)l.vramPeakMB);
+    }
+}
+
+//! Any plugin can be driven the same way, only the creation parameters and the input slot are plugin specific
+TEST_CASE("load_generator", "[.][load]")
+{
+    ITemplateAI* iface{};
+    REQUIRE(nvigiGetInterfaceDynamic(plugin::template_ai::kId, &iface, params.nvigiLoadInterface) == kResultOk);
+    IPolledInferenceInterface* ipolled{};
+    nvigiGetInterfaceDynamic(plugin::template_ai::kId, &ipolled, params.nvigiLoadInterface);
+    metrics::IMetrics* imetrics{};
+    nvigiGetInterfaceDynamic(core::framework::kId, &imetrics, params.nvigiLoadInterface);
+
+    LoadConfig config{};
+    if (!params.loadConcurrency.empty()) config.concurrency = parseConcurrency(params.loadConcurrency);
+    if (!params.loadCorpus.empty()) config.corpus = loadCorpus(params.loadCorpus);
+    config.mode = toLoadMode(params.loadMode);
+    config.requestsPerWorker = std::max(1, params.loadRequests);
+    config.requestsPerSecond = params.loadRate;
+    config.sharedInstance = params.loadSharedInstance;
+    config.inputSlot = kTemplateAIInputPrompt;
+    config.reportPath = params.loadReport;
+    REQUIRE(!config.concurrency.empty());
+    REQUIRE(!config.corpus.empty());
+
+    CommonCreationParameters common{};
+    common.modelGUID = params.loadModel.empty() ? "{01234567-0123-0123-0123-0123456789AB}" : params.loadModel.c_str();
+    common.utf8PathToModels = params.modelDir.c_str();
+    common.numThreads = 1;
+    TemplateAICreationParameters templateParams{};
+    templateParams.chain(common);
+
+    LoadReport report{};
+    auto result = runLoad(config, plugin::template_ai::kId, iface, ipolled, templateParams, params.isystem, imetrics, report);
+    if (result == kResultOk)
+    {
+        logReport(report);
+        for (auto& level : report.levels) CHECK(level.errors == 0);
+        if (!config.reportPath.empty()) REQUIRE(writeReport(report, config.reportPath));
+    }
+    else
+    {
+        NVIGI_LOG_TEST_WARN("Load generator skipped, instance creation failed with 0x%x", result);
+    }
+
+    if (imetrics) params.nvigiUnloadInterface(core::framework::kId, imetrics);
+    if (ipolled) params.nvigiUnloadInterface(plugin::template_ai::kId, ipolled);
+    REQUIRE(params.nvigiUnloadInterface(plugin::template_ai::kId, iface) == kResultOk);
+}
+
+}
+}
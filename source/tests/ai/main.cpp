@@ -28,6 +28,8 @@ namespace fs = std::filesystem;
 #include "source/core/nvigi.system/system.h"
 #include "source/core/nvigi.file/file.h"
 #include "source/core/nvigi.exception/exception.h"
+#include "source/core/nvigi.simd/simd.h"
+#include "source/core/nvigi.trace/trace.h"
 
 // Avoid link error with Logging - we don't want it, but thread uses it
 #include "source/core/nvigi.log/log.h"
@@ -65,6 +67,12 @@ ILog* ilog;
 ILog* getInterface() { return ilog; }
 }
 
+namespace simd
+{
+ISimd* isimd;
+ISimd* getInterface() { return isimd; }
+}
+
 namespace exception
 {
 IException* iexception;
@@ -105,10 +113,44 @@ struct test_params {
     nvigi::IHWICuda* icig{};
     bool hasNvidiaAdapter = false;
     bool useCiG = true;
+
+    // load generator, see source/tests/ai/load.h
+    std::string loadConcurrency;
+    std::string loadMode = "sync";
+    std::string loadCorpus;
+    std::string loadReport;
+    std::string loadModel;
+    int32_t loadRequests = 16;
+    double loadRate = 0.0;
+    bool loadSharedInstance = false;
+
+    // capture replay, see source/tests/ai/replay.h
+    std::string replayCapture;
+    std::string replaySpeed = "recorded";
+    std::string replayReport;
+
+    // auto-tuner, see source/tests/ai/tune.h (also uses the load generator corpus, model and requests)
+    std::string tuneThreads;
+    std::string tuneBatch;
+    int32_t tuneConcurrency = 4;
+    double tuneMaxLatencyMs = 0.0;
+    std::string tuneProfiles;
 };
 
 test_params params{};
 
+// Modern plugin base tests run plugin code in this process
+namespace system
+{
+ISystem* getInterface() { return params.isystem; }
+}
+
+namespace trace
+{
+// Tracing stays off in tests
+ITrace* getInterface() { return nullptr; }
+}
+
 inline std::string getExecutablePath()
 {
 #ifdef NVIGI_WINDOWS
@@ -400,6 +442,9 @@ TEST_CASE("init", "[core]")
     nvigi::params.imem = nvigi::memory::imemory;
     nvigiGetInterfaceDynamic(nvigi::core::framework::kId, &nvigi::log::ilog, nvigi::params.nvigiLoadInterface);
     REQUIRE(nvigi::log::ilog != nullptr);
+    nvigi::log::resetLevelCache();
+    // Optional, helpers fall back to scalar code without it
+    nvigiGetInterfaceDynamic(nvigi::core::framework::kId, &nvigi::simd::isimd, nvigi::params.nvigiLoadInterface);
 
     if (nvigi::params.useCiG && !nvigi::params.hasNvidiaAdapter)
     {
@@ -429,6 +474,30 @@ TEST_CASE("init", "[core]")
 //! 
 #include "source/core/nvigi.types/tests.h"
 
+//! MEMORY
+//! 
+#include "source/core/nvigi.memory/tests.h"
+
+//! THREAD
+//! 
+#include "source/core/nvigi.thread/tests.h"
+
+//! METRICS
+//! 
+#include "source/core/nvigi.metrics/tests.h"
+
+//! RESOURCES
+//! 
+#include "source/core/nvigi.resources/tests.h"
+
+//! SIMD
+//! 
+#include "source/core/nvigi.simd/tests.h"
+
+//! WAV
+//! 
+#include "source/utils/nvigi.wav/tests.h"
+
 //! CUDA/CiG
 //! 
 #ifdef NVIGI_WINDOWS
@@ -440,6 +509,10 @@ TEST_CASE("init", "[core]")
 #include "source/plugins/nvigi.template.generic/backend/tests.h"
 #include "source/plugins/nvigi.template.inference/backend/tests.h"
 
+//! MODERN PLUGIN BASE
+//! 
+#include "source/plugins/common/tests.h"
+
 //! TODO: ALL NEW PLUGIN TESTS GO HERE
 //! 
 #include "source/utils/nvigi.ai/tests.h"
@@ -448,6 +521,18 @@ TEST_CASE("init", "[core]")
 //!
 #include "source/plugins/nvigi.net/tests.h"
 
+//! LOAD GENERATOR (hidden, run with [load])
+//!
+#include "source/tests/ai/load.h"
+
+//! CAPTURE REPLAY (hidden, run with [replay])
+//!
+#include "source/tests/ai/replay.h"
+
+//! AUTO-TUNER (hidden, run with [tune])
+//!
+#include "source/tests/ai/tune.h"
+
 
 
 // DO not add tests after this block without consulting the dev team; active experiments with the CUDA-related tests
@@ -471,6 +556,9 @@ TEST_CASE("shutdown","[core]")
     nvigi::memory::imemory = nullptr;
     nvigi::params.nvigiUnloadInterface(nvigi::core::framework::kId, nvigi::log::ilog);
     nvigi::log::ilog = nullptr;
+    nvigi::log::resetLevelCache();
+    if (nvigi::simd::isimd) nvigi::params.nvigiUnloadInterface(nvigi::core::framework::kId, nvigi::simd::isimd);
+    nvigi::simd::isimd = nullptr;
     auto result = nvigi::params.nvigiShutdown();
     REQUIRE(result == nvigi::kResultOk);
 }
@@ -568,7 +656,71 @@ int wmain(int argc, wchar_t** argv)
         
         | Opt(nvigi::params.depPath, "dependencies path")
         ["--dependencies"]
-        ("path to the nvigi dependencies");
+        ("path to the nvigi dependencies")
+
+        | Opt(nvigi::params.loadConcurrency, "levels")
+        ["--load-concurrency"]
+        ("load generator concurrency levels, e.g. 1,4,16,64")
+
+        | Opt(nvigi::params.loadMode, "sync|async|polled")
+        ["--load-mode"]
+        ("load generator evaluation mode")
+
+        | Opt(nvigi::params.loadRequests, "count")
+        ["--load-requests"]
+        ("load generator requests per worker")
+
+        | Opt(nvigi::params.loadRate, "requests per second")
+        ["--load-rate"]
+        ("load generator target rate across all workers, 0 for closed loop")
+
+        | Opt(nvigi::params.loadSharedInstance)
+        ["--load-shared-instance"]
+        ("load generator workers share one instance")
+
+        | Opt(nvigi::params.loadCorpus, "file")
+        ["--load-corpus"]
+        ("load generator prompts, one per line")
+
+        | Opt(nvigi::params.loadModel, "model guid")
+        ["--load-model"]
+        ("load generator model GUID")
+
+        | Opt(nvigi::params.loadReport, "file")
+        ["--load-report"]
+        ("load generator report, .csv or .json")
+
+        | Opt(nvigi::params.replayCapture, "file")
+        ["--replay-capture"]
+        ("evaluation capture to replay, see 'EvaluationCaptureParameters'")
+
+        | Opt(nvigi::params.replaySpeed, "recorded|max")
+        ["--replay-speed"]
+        ("replay with the recorded timing or as fast as possible")
+
+        | Opt(nvigi::params.replayReport, "file")
+        ["--replay-report"]
+        ("replay report, .json")
+
+        | Opt(nvigi::params.tuneThreads, "counts")
+        ["--tune-threads"]
+        ("auto-tune CPU thread counts, e.g. 1,2,4,8")
+
+        | Opt(nvigi::params.tuneBatch, "sizes")
+        ["--tune-batch"]
+        ("auto-tune micro-batch sizes, e.g. 0,4,8")
+
+        | Opt(nvigi::params.tuneConcurrency, "workers")
+        ["--tune-concurrency"]
+        ("auto-tune concurrent workers")
+
+        | Opt(nvigi::params.tuneMaxLatencyMs, "ms")
+        ["--tune-max-latency"]
+        ("auto-tune p99 latency limit, 0 for no limit")
+
+        | Opt(nvigi::params.tuneProfiles, "file")
+        ["--tune-profiles"]
+        ("auto-tune profile store, defaults to nvigi.tuning.json in the model directory");
 
     // Now pass the new composite back to Catch so it uses that
     session.cli(cli);
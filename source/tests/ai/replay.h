@@ -0,0 +1,236 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <deque>
+
+#include "source/utils/nvigi.ai/ai_capture.h"
+
+//! Replay driver for captures recorded with 'EvaluationCaptureParameters'
+//!
+//! Feeds the recorded inputs and runtime parameters back to the captured plugin, either with the recorded inter-arrival
+//! times or as fast as the plugin accepts them, and reports latency the same way as the load generator (see load.h).
+//! Any build of the plugin can be used, so the same gameplay trace can be compared across SDK builds.
+//!
+//! Instance is created from the captured common creation parameters, plugin specific creation parameters are not captured.
+//! Evaluations always use callbacks, polled captures are replayed with a callback too.
+//!
+//! Hidden by default, run with:
+//!
+//! nvigi.test.exe [replay] --replay-capture gameplay.nvec --replay-speed max --replay-report replay.json
+namespace nvigi
+{
+namespace replay
+{
+
+struct ReplayConfig
+{
+    //! Sleep for the recorded time between calls, otherwise issue the next call as soon as the plugin accepts it
+    bool recordedSpeed = true;
+    //! Overrides the captured model GUID
+    std::string modelGUID;
+    std::string reportPath;
+};
+
+struct ReplayReport
+{
+    PluginID feature{};
+    bool recordedSpeed{};
+    uint32_t calls{};
+    uint32_t evaluations{};
+    uint32_t errors{};
+    //! Async calls the plugin rejected with nvigi::kResultNotReady which had to wait for earlier evaluations
+    uint32_t stalls{};
+    double recordedDurationMs{};
+    double durationMs{};
+    load::Percentiles latencyMs{};
+    load::Percentiles timeToFirstResultMs{};
+    std::vector<metrics::HistogramSnapshot> histograms;
+    std::vector<std::string> histogramNames;
+};
+
+struct ReplayRequest
+{
+    load::RequestState state{};
+    InferenceExecutionContext execCtx{};
+    Result result = kResultOk;
+};
+
+inline Result replayCapture(ai::EvaluationCapture& capture, const ReplayConfig& config, InferenceInterface* iface, const char* utf8PathToModels,
+    metrics::IMetrics* imetrics, ReplayReport& report)
+{
+    if (!iface) return kResultInvalidParameter;
+
+    CommonCreationParameters common{};
+    common.modelGUID = config.modelGUID.empty() ? capture.modelGUID.c_str() : config.modelGUID.c_str();
+    common.utf8PathToModels = utf8PathToModels;
+    common.numThreads = capture.numThreads;
+    common.priorityClass = capture.priorityClass;
+    InferenceInstance* instance{};
+    if (NVIGI_FAILED(result, iface->createInstance(common, &instance))) return result;
+    if (imetrics) imetrics->reset(&capture.feature, nullptr);
+
+    report.feature = capture.feature;
+    report.recordedSpeed = config.recordedSpeed;
+
+    std::deque<std::unique_ptr<ReplayRequest>> requests;
+    auto waitAll = [&requests]()->void
+    {
+        for (auto& request : requests)
+        {
+            if (request->result == kResultOk && request->execCtx.callback) request->state.wait();
+        }
+    };
+
+    auto start = load::clock::now();
+    auto due = start;
+    for (auto& call : capture.calls)
+    {
+        report.calls++;
+        report.recordedDurationMs += double(call.delayUs) / 1000.0;
+        if (config.recordedSpeed)
+        {
+            due += std::chrono::microseconds(call.delayUs);
+            std::this_thread::sleep_until(due);
+        }
+        auto scheduled = config.recordedSpeed ? due : load::clock::now();
+
+        std::vector<InferenceExecutionContext*> execCtxs;
+        for (auto& ctx : call.contexts)
+        {
+            auto request = std::make_unique<ReplayRequest>();
+            request->state.start = scheduled;
+            request->execCtx.instance = instance;
+            request->execCtx.inputs = ctx->getInputs();
+            request->execCtx.runtimeParameters = ctx->getRuntimeParameters();
+            request->execCtx.callback = load::loadCallback;
+            request->execCtx.callbackUserData = &request->state;
+            execCtxs.push_back(&request->execCtx);
+            requests.push_back(std::move(request));
+        }
+        auto first = requests.end() - execCtxs.size();
+        report.evaluations += (uint32_t)execCtxs.size();
+
+        if (call.kind == ai::CapturedCallKind::eEvaluateAsync && instance->evaluateAsync)
+        {
+            auto& request = **first;
+            request.result = instance->evaluateAsync(&request.execCtx);
+            if (request.result == kResultNotReady)
+            {
+                // Plugin was still busy when it was recorded too, or this build is slower
+                report.stalls++;
+                waitAll();
+                request.result = instance->evaluateAsync(&request.execCtx);
+            }
+        }
+        else if (call.kind == ai::CapturedCallKind::eEvaluateBatch && instance->getVersion() >= kStructVersion4 && instance->evaluateBatch)
+        {
+            auto result = instance->evaluateBatch(execCtxs.data(), execCtxs.size());
+            for (auto it = first; it != requests.end(); it++) (*it)->result = result;
+        }
+        else
+        {
+            for (auto it = first; it != requests.end(); it++) (*it)->result = instance->evaluate(&(*it)->execCtx);
+        }
+        for (auto it = first; it != requests.end(); it++)
+        {
+            if (call.kind != ai::CapturedCallKind::eEvaluateAsync && !(*it)->state.done) (*it)->state.finish();
+        }
+    }
+    waitAll();
+    report.durationMs = std::chrono::duration<double, std::milli>(load::clock::now() - start).count();
+
+    std::vector<double> latency, ttfr;
+    for (auto& request : requests)
+    {
+        if (!request->state.done) request->state.finish();
+        if (request->result != kResultOk || request->state.lastState == kInferenceExecutionStateInvalid)
+        {
+            report.errors++;
+            continue;
+        }
+        latency.push_back(std::chrono::duration<double, std::milli>(request->state.end - request->state.start).count());
+        ttfr.push_back(request->state.results ? std::chrono::duration<double, std::milli>(request->state.firstResult - request->state.start).count() : 0.0);
+    }
+    report.latencyMs = load::getPercentiles(latency);
+    report.timeToFirstResultMs = load::getPercentiles(ttfr);
+
+    if (imetrics)
+    {
+        imetrics->enumerate(&capture.feature, [](const metrics::HistogramSnapshot* snapshot, void* userData)->void
+        {
+            auto report = (ReplayReport*)userData;
+            report->histograms.push_back(*snapshot);
+            report->histogramNames.push_back(snapshot->name);
+        }, &report);
+    }
+
+    iface->destroyInstance(instance);
+    return kResultOk;
+}
+
+inline bool writeReport(const ReplayReport& report, const std::string& path)
+{
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+
+    nlohmann::json root;
+    root["sdk"] = extra::format("{}.{}.{}", NVIGI_CORESDK_VERSION_MAJOR, NVIGI_CORESDK_VERSION_MINOR, NVIGI_CORESDK_VERSION_PATCH);
+    root["feature"] = extra::guidToString(report.feature.id);
+    root["speed"] = report.recordedSpeed ? "recorded" : "max";
+    root["calls"] = report.calls;
+    root["evaluations"] = report.evaluations;
+    root["errors"] = report.errors;
+    root["stalls"] = report.stalls;
+    root["recordedDurationMs"] = report.recordedDurationMs;
+    root["durationMs"] = report.durationMs;
+    root["latencyMs"] = load::toJSON(report.latencyMs);
+    root["timeToFirstResultMs"] = load::toJSON(report.timeToFirstResultMs);
+    for (size_t i = 0; i < report.histograms.size(); i++)
+    {
+        auto& h = report.histograms[i];
+        root["plugin"][report.histogramNames[i]] = { {"count", h.count}, {"mean", h.mean}, {"p50", h.p50}, {"p90", h.p90}, {"p99", h.p99}, {"max", h.max} };
+    }
+    file << root.dump(2);
+    return true;
+}
+
+TEST_CASE("replay_capture", "[.][replay]")
+{
+    REQUIRE(!params.replayCapture.empty());
+    ai::EvaluationCapture capture{};
+    REQUIRE(ai::loadEvaluationCapture(params.replayCapture.c_str(), capture) == kResultOk);
+
+    InferenceInterface* iface{};
+    REQUIRE(nvigiGetInterfaceDynamic(capture.feature, &iface, params.nvigiLoadInterface) == kResultOk);
+    metrics::IMetrics* imetrics{};
+    nvigiGetInterfaceDynamic(core::framework::kId, &imetrics, params.nvigiLoadInterface);
+
+    ReplayConfig config{};
+    config.recordedSpeed = params.replaySpeed != "max";
+    config.modelGUID = params.loadModel;
+    config.reportPath = params.replayReport;
+
+    ReplayReport report{};
+    auto result = replayCapture(capture, config, iface, params.modelDir.c_str(), imetrics, report);
+    if (result == kResultOk)
+    {
+        NVIGI_LOG_TEST_INFO("replay[%s] %u calls in %.2fms (recorded %.2fms): latency p50 %.2fms p99 %.2fms, ttfr p50 %.2fms p99 %.2fms, errors %u, stalls %u",
+            report.recordedSpeed ? "recorded" : "max", report.calls, report.durationMs, report.recordedDurationMs, report.latencyMs.p50, report.latencyMs.p99,
+            report.timeToFirstResultMs.p50, report.timeToFirstResultMs.p99, report.errors, report.stalls);
+        CHECK(report.errors == 0);
+        if (!config.reportPath.empty()) REQUIRE(writeReport(report, config.reportPath));
+    }
+    else
+    {
+        NVIGI_LOG_TEST_WARN("Replay skipped, instance creation failed with 0x%x", result);
+    }
+
+    if (imetrics) params.nvigiUnloadInterface(core::framework::kId, imetrics);
+    REQUIRE(params.nvigiUnloadInterface(capture.feature, iface) == kResultOk);
+}
+
+}
+}
@@ -0,0 +1,220 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include "source/tests/ai/load.h"
+#include "source/utils/nvigi.ai/ai_tuning.h"
+#include "source/plugins/nvigi.hwi/common/nvigi_hwi_common.h"
+
+//! Auto-tuner for any 'InferenceInterface'
+//!
+//! Sweeps backends, CPU thread counts, micro-batch sizes, evaluation modes and (when hwi.common is available) the GPU
+//! 'SchedulingMode' for one model on this machine. Each combination runs through the load generator (see load.h) at a
+//! fixed concurrency and the highest throughput within the latency limit is stored per backend in the tuning profile
+//! store (see ai_tuning.h). Instances created later with 'TunedExecutionParameters' pick the stored settings up.
+//!
+//! Hidden by default, run with:
+//!
+//! nvigi.test.exe [tune] --tune-threads 1,2,4,8 --tune-batch 0,4,8 --tune-concurrency 4 --tune-max-latency 250
+namespace nvigi
+{
+namespace tune
+{
+
+struct TuneConfig
+{
+    std::vector<uint32_t> threads = { 1, 2, 4, 8 };
+    //! Zero evaluates each request on its own, batching is only tried with async evaluation
+    std::vector<uint32_t> batchSizes = { 0, 4, 8 };
+    uint32_t batchWindowUs = 2000;
+    std::vector<load::LoadMode> modes = { load::LoadMode::eSync, load::LoadMode::eAsync };
+    //! Concurrent workers, should match what the game is expected to issue
+    uint32_t concurrency = 4;
+    uint32_t requestsPerWorker = 16;
+    //! Combinations with p99 latency above this are never picked, zero for no limit
+    double maxLatencyMs = 0.0;
+    std::vector<std::string> corpus = { "Hello, how are you today?" };
+    std::string modelGUID;
+    std::string modelDir;
+    //! Profile store, defaults to 'nvigi.tuning.json' in the model directory
+    std::string profilePath;
+};
+
+//! Backend under test, creation parameters are plugin specific
+struct TuneBackend
+{
+    PluginID feature{};
+    InferenceInterface* iface{};
+    IPolledInferenceInterface* ipolled{};
+    std::string inputSlot;
+    //! Returns the creation chain for the common parameters provided, must stay valid until the next call
+    std::function<const NVIGIParameter*(CommonCreationParameters& common)> getCreationParameters;
+};
+
+struct TuneTrial
+{
+    ai::TuningProfile profile{};
+    uint32_t errors{};
+};
+
+inline bool isBetter(const TuneConfig& config, const TuneTrial& trial, const TuneTrial* best)
+{
+    if (trial.errors) return false;
+    if (config.maxLatencyMs > 0.0 && trial.profile.latencyP99Ms > config.maxLatencyMs) return false;
+    return !best || trial.profile.requestsPerSecond > best->profile.requestsPerSecond;
+}
+
+//! Runs every combination for each backend and stores the best one, 'ihwi' is optional
+inline Result runTune(const TuneConfig& config, std::vector<TuneBackend>& backends, IHWICommon* ihwi, system::ISystem* isystem,
+    std::vector<TuneTrial>& trials, ai::TuningProfileStore& store)
+{
+    if (backends.empty() || config.threads.empty() || config.modes.empty()) return kResultInvalidParameter;
+
+    std::vector<uint32_t> schedulingModes = { SchedulingMode::kBalance };
+    uint32_t previousMode = SchedulingMode::kBalance;
+    if (ihwi && ihwi->GetGpuInferenceSchedulingMode(&previousMode) == kResultOk)
+    {
+        schedulingModes = { SchedulingMode::kPrioritizeCompute, SchedulingMode::kBalance, SchedulingMode::kPrioritizeGraphics };
+    }
+    auto machine = ai::getMachineKey(isystem ? isystem->getSystemCaps() : nullptr);
+
+    Result result = kResultOk;
+    for (auto& backend : backends)
+    {
+        std::optional<TuneTrial> best;
+        for (auto schedulingMode : schedulingModes)
+        {
+            if (ihwi) ihwi->SetGpuInferenceSchedulingMode(schedulingMode);
+            for (auto mode : config.modes)
+            {
+                for (auto threads : config.threads)
+                {
+                    for (auto batchSize : config.batchSizes)
+                    {
+                        // Micro-batching only collects async evaluations with a callback
+                        if (batchSize && mode != load::LoadMode::eAsync) continue;
+
+                        load::LoadConfig loadConfig{};
+                        loadConfig.concurrency = { config.concurrency };
+                        loadConfig.requestsPerWorker = config.requestsPerWorker;
+                        loadConfig.mode = mode;
+                        loadConfig.corpus = config.corpus;
+                        loadConfig.inputSlot = backend.inputSlot;
+
+                        CommonCreationParameters common{};
+                        common.modelGUID = config.modelGUID.c_str();
+                        common.utf8PathToModels = config.modelDir.c_str();
+                        common.numThreads = (int32_t)threads;
+                        common.maxBatchSize = batchSize;
+                        common.batchWindowUs = batchSize ? config.batchWindowUs : 0;
+
+                        load::LoadReport report{};
+                        auto res = load::runLoad(loadConfig, backend.feature, backend.iface, backend.ipolled, backend.getCreationParameters(common), isystem, nullptr, report);
+                        if (res != kResultOk || report.levels.empty())
+                        {
+                            NVIGI_LOG_TEST_WARN("tune[%s] threads %u batch %u failed with 0x%x", load::toStr(mode), threads, batchSize, res);
+                            result = res;
+                            continue;
+                        }
+
+                        auto& level = report.levels.front();
+                        TuneTrial trial{};
+                        trial.errors = level.errors;
+                        trial.profile.backend = extra::guidToString(backend.feature.id);
+                        trial.profile.numThreads = common.numThreads;
+                        trial.profile.maxBatchSize = common.maxBatchSize;
+                        trial.profile.batchWindowUs = common.batchWindowUs;
+                        trial.profile.schedulingMode = schedulingMode;
+                        trial.profile.mode = load::toStr(mode);
+                        trial.profile.concurrency = config.concurrency;
+                        trial.profile.requestsPerSecond = level.requestsPerSecond;
+                        trial.profile.latencyP50Ms = level.latencyMs.p50;
+                        trial.profile.latencyP99Ms = level.latencyMs.p99;
+                        NVIGI_LOG_TEST_INFO("tune[%s] scheduling %u threads %u batch %u: %.2f req/s, latency p50 %.2fms p99 %.2fms, errors %u",
+                            load::toStr(mode), schedulingMode, threads, batchSize, level.requestsPerSecond, level.latencyMs.p50, level.latencyMs.p99, level.errors);
+
+                        if (isBetter(config, trial, best ? &*best : nullptr)) best = trial;
+                        trials.push_back(std::move(trial));
+                    }
+                }
+            }
+        }
+
+        if (best)
+        {
+            store.store(machine, config.modelGUID.c_str(), best->profile);
+            NVIGI_LOG_TEST_INFO("tune best for %s: %s, scheduling %u, threads %d, batch %u - %.2f req/s, p99 %.2fms", best->profile.backend.c_str(),
+                best->profile.mode.c_str(), best->profile.schedulingMode, best->profile.numThreads, best->profile.maxBatchSize,
+                best->profile.requestsPerSecond, best->profile.latencyP99Ms);
+        }
+        else
+        {
+            NVIGI_LOG_TEST_WARN("tune found no combination within the latency limit for %s", extra::guidToString(backend.feature.id).c_str());
+        }
+    }
+
+    if (ihwi) ihwi->SetGpuInferenceSchedulingMode(previousMode);
+    return result;
+}
+
+//! Add other backends of the same feature to 'backends' to have the tuner pick between them
+TEST_CASE("auto_tune", "[.][tune]")
+{
+    TuneConfig config{};
+    if (!params.tuneThreads.empty()) config.threads = load::parseConcurrency(params.tuneThreads);
+    if (!params.tuneBatch.empty())
+    {
+        // Zero is a valid batch size here, 'parseConcurrency' would turn it into one
+        config.batchSizes.clear();
+        std::stringstream ss(params.tuneBatch);
+        std::string item;
+        while (std::getline(ss, item, ',')) if (!item.empty()) config.batchSizes.push_back((uint32_t)std::stoul(item));
+    }
+    if (!params.loadCorpus.empty()) config.corpus = load::loadCorpus(params.loadCorpus);
+    config.concurrency = std::max(1, params.tuneConcurrency);
+    config.requestsPerWorker = std::max(1, params.loadRequests);
+    config.maxLatencyMs = params.tuneMaxLatencyMs;
+    config.modelGUID = params.loadModel.empty() ? "{01234567-0123-0123-0123-0123456789AB}" : params.loadModel;
+    config.modelDir = params.modelDir;
+    config.profilePath = params.tuneProfiles.empty() ? params.modelDir + "/" + ai::kTuningProfileFile : params.tuneProfiles;
+    REQUIRE(!config.threads.empty());
+    REQUIRE(!config.batchSizes.empty());
+    REQUIRE(!config.corpus.empty());
+
+    ITemplateAI* iface{};
+    REQUIRE(nvigiGetInterfaceDynamic(plugin::template_ai::kId, &iface, params.nvigiLoadInterface) == kResultOk);
+    IPolledInferenceInterface* ipolled{};
+    nvigiGetInterfaceDynamic(plugin::template_ai::kId, &ipolled, params.nvigiLoadInterface);
+    IHWICommon* ihwi{};
+    nvigiGetInterfaceDynamic(plugin::hwi::common::kId, &ihwi, params.nvigiLoadInterface);
+
+    TemplateAICreationParameters templateParams{};
+    std::vector<TuneBackend> backends;
+    backends.push_back({ plugin::template_ai::kId, iface, ipolled, kTemplateAIInputPrompt, [&templateParams](CommonCreationParameters& common)->const NVIGIParameter*
+    {
+        templateParams = {};
+        templateParams.chain(common);
+        return templateParams;
+    }});
+
+    ai::TuningProfileStore store;
+    REQUIRE(store.load(config.profilePath) == kResultOk);
+    std::vector<TuneTrial> trials;
+    auto result = runTune(config, backends, ihwi, params.isystem, trials, store);
+    if (result != kResultOk)
+    {
+        NVIGI_LOG_TEST_WARN("Auto-tune incomplete, last error 0x%x", result);
+    }
+    // Failed combinations are simply not candidates, the rest is still worth keeping
+    REQUIRE(store.save() == kResultOk);
+    NVIGI_LOG_TEST_INFO("tune ran %zu combinations, profiles stored in '%s'", trials.size(), config.profilePath.c_str());
+
+    if (ihwi) params.nvigiUnloadInterface(plugin::hwi::common::kId, ihwi);
+    if (ipolled) params.nvigiUnloadInterface(plugin::template_ai::kId, ipolled);
+    REQUIRE(params.nvigiUnloadInterface(plugin::template_ai::kId, iface) == kResultOk);
+}
+
+}
+}
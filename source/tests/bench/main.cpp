@@ -0,0 +1,449 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifdef NVIGI_WINDOWS
+#include <windows.h>
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <fstream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "nvigi.h"
+#include "source/core/nvigi.extra/extra.h"
+#include "source/core/nvigi.types/types.h"
+#include "source/core/nvigi.memory/memory.h"
+#include "source/core/nvigi.framework/framework.h"
+#include "source/core/nvigi.file/file.h"
+#include "source/core/nvigi.log/log.h"
+#include "source/core/nvigi.thread/thread.h"
+#include "source/utils/nvigi.ai/nvigi_ai.h"
+#include "source/utils/nvigi.poll/poll.h"
+#include "external/json/source/nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+//! Microbenchmarks for core primitives
+//!
+//! Usage: nvigi.bench.exe [--sdk <path>] [--filter <substring>] [--min-time-ms <ms>] [--repeat <n>] [--json <file>]
+//!
+//! Each benchmark is calibrated to run for at least 'min-time-ms', reported numbers are medians over 'repeat' runs.
+//! Allocations per operation include both the CRT heap (operator new) and the NVIGI memory manager.
+
+//! Heap allocations made by this process, counted in the replaced global operator new
+static std::atomic<uint64_t> s_heapAllocations{};
+
+void* operator new(size_t size)
+{
+    s_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace nvigi
+{
+
+//! Forwards to the core memory manager and counts allocations, 'types::string' and friends go through here
+namespace memory
+{
+IMemoryManager* icore{};
+IMemoryManager s_counting{};
+std::atomic<uint64_t> s_allocations{};
+IMemoryManager* getInterface() { return &s_counting; }
+
+void setupCountingAllocator(IMemoryManager* core)
+{
+    icore = core;
+    s_counting.allocate = [](size_t bytes)->void* { s_allocations++; return icore->allocate(bytes); };
+    s_counting.deallocate = [](void* ptr)->void { icore->deallocate(ptr); };
+#ifdef NVIGI_VALIDATE_MEMORY
+    s_counting.getNumAllocations = core->getNumAllocations;
+    s_counting.dumpAllocations = core->dumpAllocations;
+#endif
+    s_counting.allocateUninitialized = [](size_t bytes)->void* { s_allocations++; return allocateUninitialized(icore, bytes); };
+}
+}
+
+namespace log
+{
+ILog* ilog;
+ILog* getInterface() { return ilog; }
+}
+
+namespace bench
+{
+
+#define DECLARE_NVIGI_CORE_FUN(F) PFun_##F* F
+
+struct Options
+{
+    std::string sdkPath;
+    std::string filter;
+    std::string jsonPath;
+    uint32_t minTimeMs = 200;
+    uint32_t repeat = 5;
+};
+
+struct Result
+{
+    std::string name;
+    uint64_t iterations{};
+    double nsPerOp{};
+    double allocsPerOp{};
+};
+
+//! Runs 'iterations' operations, must not return before all of them are done
+using BenchmarkFunction = std::function<void(uint64_t iterations)>;
+
+struct Benchmark
+{
+    std::string name;
+    BenchmarkFunction run;
+};
+
+//! Prevents the compiler from dropping results of benchmarked code
+template<typename T>
+inline void doNotOptimize(const T& value)
+{
+    static volatile const void* s_sink;
+    s_sink = &value;
+}
+
+uint64_t getAllocationCount()
+{
+    return s_heapAllocations.load(std::memory_order_relaxed) + memory::s_allocations.load(std::memory_order_relaxed);
+}
+
+Result runBenchmark(const Benchmark& benchmark, const Options& options)
+{
+    using clock = std::chrono::steady_clock;
+    auto measure = [&benchmark](uint64_t iterations, double& ns, double& allocs)->void
+    {
+        auto allocations = getAllocationCount();
+        auto start = clock::now();
+        benchmark.run(iterations);
+        ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+        allocs = double(getAllocationCount() - allocations);
+    };
+
+    // Warm up caches, lazily created thread contexts etc. then calibrate
+    double ns{}, allocs{};
+    measure(1, ns, allocs);
+    uint64_t iterations = 1;
+    double targetNs = options.minTimeMs * 1e6;
+    while (true)
+    {
+        measure(iterations, ns, allocs);
+        if (ns >= targetNs / 10 || iterations >= (1ull << 32)) break;
+        iterations *= 2;
+    }
+    iterations = std::max<uint64_t>(1, uint64_t(double(iterations) * targetNs / std::max(ns, 1.0)));
+
+    std::vector<double> nsPerOp, allocsPerOp;
+    for (uint32_t i = 0; i < std::max(1u, options.repeat); i++)
+    {
+        measure(iterations, ns, allocs);
+        nsPerOp.push_back(ns / double(iterations));
+        allocsPerOp.push_back(allocs / double(iterations));
+    }
+    auto median = [](std::vector<double>& v)->double
+    {
+        std::sort(v.begin(), v.end());
+        return v[v.size() / 2];
+    };
+    return { benchmark.name, iterations, median(nsPerOp), median(allocsPerOp) };
+}
+
+//! Splits 'iterations' across 'threadCount' threads released at the same time
+void runOnThreads(uint32_t threadCount, uint64_t iterations, const std::function<void(uint64_t)>& func)
+{
+    std::atomic<uint32_t> ready{};
+    std::atomic<bool> go{};
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < threadCount; t++)
+    {
+        uint64_t count = iterations / threadCount + (t < iterations % threadCount ? 1 : 0);
+        threads.emplace_back([&, count]()->void
+        {
+            ready++;
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            func(count);
+        });
+    }
+    while (ready.load() != threadCount) std::this_thread::yield();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) t.join();
+}
+
+std::vector<Benchmark> getBenchmarks()
+{
+    std::vector<Benchmark> benchmarks;
+
+    //! THREAD
+    for (uint32_t threadCount : { 1u, 4u, 16u })
+    {
+        benchmarks.push_back({ "thread::ThreadContext::getContext/threads:" + std::to_string(threadCount), [threadCount](uint64_t iterations)->void
+        {
+            static thread::ThreadContext<uint64_t> s_context;
+            runOnThreads(threadCount, iterations, [](uint64_t count)->void
+            {
+                for (uint64_t i = 0; i < count; i++) doNotOptimize(++s_context.getContext());
+            });
+        } });
+    }
+    benchmarks.push_back({ "thread::WorkerThread::scheduleWork", [](uint64_t iterations)->void
+    {
+        static thread::WorkerThread s_worker(L"nvigi.bench", 0);
+        std::atomic<uint64_t> done{};
+        for (uint64_t i = 0; i < iterations; i++) s_worker.scheduleWork([&done]()->void { done++; });
+        while (done.load() != iterations) std::this_thread::yield();
+    } });
+
+    //! LOG
+    benchmarks.push_back({ "log::logva/enabled", [](uint64_t iterations)->void
+    {
+        for (uint64_t i = 0; i < iterations; i++) NVIGI_LOG_INFO("bench %llu %s", i, "message");
+    } });
+    benchmarks.push_back({ "log::logva/disabled", [](uint64_t iterations)->void
+    {
+        for (uint64_t i = 0; i < iterations; i++) NVIGI_LOG_VERBOSE("bench %llu %s", i, "message");
+    } });
+
+    //! MEMORY
+    for (size_t size : { size_t(64), size_t(4096), size_t(1 << 20) })
+    {
+        benchmarks.push_back({ "memory::allocate/bytes:" + std::to_string(size), [size](uint64_t iterations)->void
+        {
+            auto mm = memory::getInterface();
+            for (uint64_t i = 0; i < iterations; i++)
+            {
+                auto p = mm->allocate(size);
+                doNotOptimize(p);
+                mm->deallocate(p);
+            }
+        } });
+    }
+
+    //! TYPES
+    benchmarks.push_back({ "types::string/copy", [](uint64_t iterations)->void
+    {
+        types::string source("https://api.nvidia.com/v1/chat/completions");
+        for (uint64_t i = 0; i < iterations; i++)
+        {
+            types::string copy(source);
+            doNotOptimize(copy);
+        }
+    } });
+    benchmarks.push_back({ "types::string/append", [](uint64_t iterations)->void
+    {
+        types::string header("Authorization: Bearer ");
+        types::string token("0123456789abcdef");
+        for (uint64_t i = 0; i < iterations; i++)
+        {
+            auto line = header + token;
+            doNotOptimize(line);
+        }
+    } });
+    benchmarks.push_back({ "types::vector<uint8_t>/push_back:4096", [](uint64_t iterations)->void
+    {
+        for (uint64_t i = 0; i < iterations; i += 4096)
+        {
+            types::vector<uint8_t> bytes;
+            for (uint32_t j = 0; j < 4096; j++) bytes.push_back(uint8_t(j));
+            doNotOptimize(bytes);
+        }
+    } });
+    benchmarks.push_back({ "types::vector<types::string>/copy:16", [](uint64_t iterations)->void
+    {
+        types::vector<types::string> headers;
+        for (int j = 0; j < 16; j++) headers.push_back(types::string("Header: value"));
+        for (uint64_t i = 0; i < iterations; i++)
+        {
+            types::vector<types::string> copy(headers);
+            doNotOptimize(copy);
+        }
+    } });
+
+    //! AI
+    benchmarks.push_back({ "InferenceDataSlotArray::findAndValidateSlot/slots:8", [](uint64_t iterations)->void
+    {
+        const char* keys[] = { "system", "user", "assistant", "image", "audio", "tools", "history", "config" };
+        CpuData buffers[8]{};
+        InferenceDataText texts[8]{};
+        InferenceDataSlot slots[8]{};
+        for (int j = 0; j < 8; j++)
+        {
+            texts[j] = InferenceDataText(buffers[j]);
+            slots[j] = InferenceDataSlot(keys[j], texts[j]);
+        }
+        InferenceDataSlotArray array(8, slots);
+        for (uint64_t i = 0; i < iterations; i++)
+        {
+            const InferenceDataText* text{};
+            doNotOptimize(array.findAndValidateSlot(keys[i & 7], &text));
+        }
+    } });
+    benchmarks.push_back({ "poll::PollContext/round trip", [](uint64_t iterations)->void
+    {
+        poll::PollContext<InferenceExecutionState> pollCtx;
+        std::thread producer([&pollCtx, iterations]()->void
+        {
+            for (uint64_t i = 0; i < iterations; i++) pollCtx.triggerCallback(kInferenceExecutionStateDataPending);
+        });
+        for (uint64_t i = 0; i < iterations; i++)
+        {
+            InferenceExecutionState state{};
+            pollCtx.getResults(true, &state);
+            pollCtx.releaseResults(state);
+        }
+        producer.join();
+    } });
+    benchmarks.push_back({ "json::parse/model card", [](uint64_t iterations)->void
+    {
+        static const char* s_modelCard = R"({
+            "name" : "template-model",
+            "vram" : 1344,
+            "model": {
+                "ext" : "gguf",
+                "notes": "Benchmark model card",
+                "file": { "command": "curl -L -o model.gguf 'localhost/model.gguf'" },
+                "local_files": [ "model.gguf", "tokenizer.json", "config.json" ]
+            }
+        })";
+        for (uint64_t i = 0; i < iterations; i++)
+        {
+            auto card = json::parse(s_modelCard);
+            doNotOptimize(card["vram"].get<uint32_t>());
+        }
+    } });
+
+    return benchmarks;
+}
+
+bool parseArguments(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--sdk" && hasValue) options.sdkPath = argv[++i];
+        else if (arg == "--filter" && hasValue) options.filter = argv[++i];
+        else if (arg == "--json" && hasValue) options.jsonPath = argv[++i];
+        else if (arg == "--min-time-ms" && hasValue) options.minTimeMs = (uint32_t)std::stoul(argv[++i]);
+        else if (arg == "--repeat" && hasValue) options.repeat = (uint32_t)std::stoul(argv[++i]);
+        else
+        {
+            printf("Usage: %s [--sdk <path>] [--filter <substring>] [--min-time-ms <ms>] [--repeat <n>] [--json <file>]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+}
+
+#define GET_NVIGI_CORE_FUN(F) F = (PFun_##F*)GetProcAddress(lib, #F)
+
+int main(int argc, char** argv)
+{
+    using namespace nvigi;
+
+    bench::Options options{};
+    if (!bench::parseArguments(argc, argv, options)) return 1;
+
+    auto exePath = file::getExecutablePath();
+    auto corePath = options.sdkPath.empty() ? exePath : extra::utf8ToUtf16(options.sdkPath.c_str());
+    auto libPath = corePath + L"/nvigi.core.framework.dll";
+    HMODULE lib = LoadLibraryW(libPath.c_str());
+    if (!lib)
+    {
+        printf("Failed to load '%S'\n", libPath.c_str());
+        return 1;
+    }
+
+    DECLARE_NVIGI_CORE_FUN(nvigiInit);
+    DECLARE_NVIGI_CORE_FUN(nvigiShutdown);
+    DECLARE_NVIGI_CORE_FUN(nvigiLoadInterface);
+    DECLARE_NVIGI_CORE_FUN(nvigiUnloadInterface);
+    GET_NVIGI_CORE_FUN(nvigiInit);
+    GET_NVIGI_CORE_FUN(nvigiShutdown);
+    GET_NVIGI_CORE_FUN(nvigiLoadInterface);
+    GET_NVIGI_CORE_FUN(nvigiUnloadInterface);
+    if (!nvigiInit || !nvigiShutdown || !nvigiLoadInterface || !nvigiUnloadInterface)
+    {
+        printf("Failed to find core API\n");
+        return 1;
+    }
+
+    // Log file only, benchmarked messages must not go through the console
+    auto corePathUtf8 = extra::utf16ToUtf8(corePath.c_str());
+    const char* paths[] = { corePathUtf8.c_str() };
+    Preferences pref{};
+    pref.logLevel = LogLevel::eDefault;
+    pref.showConsole = false;
+    pref.numPathsToPlugins = 1;
+    pref.utf8PathsToPlugins = paths;
+    pref.utf8PathToDependencies = corePathUtf8.c_str();
+    pref.utf8PathToLogsAndData = corePathUtf8.c_str();
+    if (NVIGI_FAILED(result, nvigiInit(pref, nullptr, kSDKVersion)))
+    {
+        printf("nvigiInit failed with %u\n", result);
+        return 1;
+    }
+
+    // Internal interfaces, same as the unit tests
+    memory::IMemoryManager* imem{};
+    nvigiGetInterfaceDynamic(core::framework::kId, &imem, nvigiLoadInterface);
+    nvigiGetInterfaceDynamic(core::framework::kId, &log::ilog, nvigiLoadInterface);
+    if (!imem || !log::ilog)
+    {
+        printf("Failed to obtain core interfaces\n");
+        nvigiShutdown();
+        return 1;
+    }
+    memory::setupCountingAllocator(imem);
+    log::resetLevelCache();
+
+    printf("%-56s %14s %12s %12s\n", "benchmark", "iterations", "ns/op", "allocs/op");
+    std::vector<bench::Result> results;
+    for (auto& benchmark : bench::getBenchmarks())
+    {
+        if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) continue;
+        auto r = bench::runBenchmark(benchmark, options);
+        printf("%-56s %14llu %12.2f %12.3f\n", r.name.c_str(), (unsigned long long)r.iterations, r.nsPerOp, r.allocsPerOp);
+        results.push_back(r);
+    }
+
+    if (!options.jsonPath.empty())
+    {
+        json report;
+        report["sdk"] = extra::toStr(Version(NVIGI_CORESDK_VERSION_MAJOR, NVIGI_CORESDK_VERSION_MINOR, NVIGI_CORESDK_VERSION_PATCH));
+        report["minTimeMs"] = options.minTimeMs;
+        report["repeat"] = options.repeat;
+        for (auto& r : results)
+        {
+            report["benchmarks"].push_back({ { "name", r.name }, { "iterations", r.iterations }, { "nsPerOp", r.nsPerOp }, { "allocsPerOp", r.allocsPerOp } });
+        }
+        std::ofstream(options.jsonPath) << report.dump(2);
+    }
+
+    nvigiUnloadInterface(core::framework::kId, imem);
+    nvigiUnloadInterface(core::framework::kId, log::ilog);
+    log::ilog = nullptr;
+    log::resetLevelCache();
+    nvigiShutdown();
+    FreeLibrary(lib);
+    return 0;
+}
@@ -0,0 +1,26 @@
+group "tests"
+
+project "nvigi.bench"
+	kind "ConsoleApp"
+	targetdir (bindir .. "%{cfg.platform}/%{cfg.buildcfg}")
+	objdir (artifactsdir .. "%{prj.name}/%{cfg.platform}/%{cfg.buildcfg}")
+	filter {"system:windows"}
+		symbolspath (symbolsdir .. "%{cfg.platform}/%{cfg.buildcfg}/$(TargetName).pdb")
+	filter {}
+
+	dependson { "nvigi.core.framework"}
+
+	files {
+		"./**.h",
+		"./**.cpp",
+	}
+
+	includedirs {
+		ROOT .. "source/core/nvigi.api", 
+		ROOT .. "source/utils/nvigi.ai"
+	}
+
+	filter {"system:windows"}
+		vpaths { ["impl"] = {"./**.h","./**.cpp", }}
+	filter {}
+group ""
@@ -0,0 +1,207 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include <cstdio>
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <windows.h>
+
+#include "source/core/nvigi.api/nvigi.h"
+#include "source/core/nvigi.framework/framework.h"
+#include "source/core/nvigi.log/log.h"
+#include "source/core/nvigi.memory/memory.h"
+#include "source/core/nvigi.extra/extra.h"
+#include "source/utils/nvigi.ai/ai_remote.h"
+
+namespace fs = std::filesystem;
+
+//! Out of process inference host
+//!
+//! Loads plugins on behalf of other processes, see 'RemoteInferenceClient' in source/utils/nvigi.ai/ai_remote.h.
+//! Normally started by the client (see 'RemoteInferenceClientParameters::utf8PathToHost') and exits once the last client is gone.
+
+namespace nvigi
+{
+namespace memory
+{
+IMemoryManager* imemory;
+IMemoryManager* getInterface() { return imemory; }
+}
+namespace log
+{
+ILog* ilog;
+ILog* getInterface() { return ilog; }
+}
+}
+
+#define GET_NVIGI_CORE_FUN(F) PFun_##F* F = (PFun_##F*)GetProcAddress(lib, #F)
+
+struct InputParams
+{
+    std::string service = "inference.host";
+    std::vector<std::string> plugins;
+    std::string sdk;
+    std::string logs;
+    bool verbose{};
+    bool persistent{};
+    uint32_t idleExitMs = 5000;
+};
+
+void print_usage(int /*argc*/, char** argv)
+{
+    fprintf(stderr, "usage: %s [options]\n", argv[0]);
+    fprintf(stderr, "\n");
+    fprintf(stderr, "options:\n");
+    fprintf(stderr, "  -h, --help            show this help message and exit\n");
+    fprintf(stderr, "  --service    NAME     name clients connect to (default: inference.host)\n");
+    fprintf(stderr, "  --plugins    DIR      directory with plugins, can be repeated (default: next to this executable)\n");
+    fprintf(stderr, "  --sdk        DIR      directory with nvigi.core.framework.dll (default: first plugin directory)\n");
+    fprintf(stderr, "  --logs       DIR      directory for logs and data\n");
+    fprintf(stderr, "  --idle-exit  MS       exit after the last client has been gone this long (default: 5000)\n");
+    fprintf(stderr, "  --persistent          keep running without clients\n");
+    fprintf(stderr, "  --verbose             verbose logging with console\n");
+    fprintf(stderr, "\n");
+}
+
+bool params_parse(int argc, char** argv, InputParams& params)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        auto value = [&](std::string& out)->bool
+        {
+            if (++i >= argc)
+            {
+                printf("Invalid parameter count");
+                return false;
+            }
+            out = argv[i];
+            return true;
+        };
+        std::string tmp;
+        if (arg == "-h" || arg == "--help")
+        {
+            print_usage(argc, argv);
+            exit(0);
+        }
+        else if (arg == "--service") { if (!value(params.service)) return false; }
+        else if (arg == "--plugins") { if (!value(tmp)) return false; params.plugins.push_back(tmp); }
+        else if (arg == "--sdk") { if (!value(params.sdk)) return false; }
+        else if (arg == "--logs") { if (!value(params.logs)) return false; }
+        else if (arg == "--idle-exit") { if (!value(tmp)) return false; params.idleExitMs = (uint32_t)std::stoul(tmp); }
+        else if (arg == "--persistent") { params.persistent = true; }
+        else if (arg == "--verbose") { params.verbose = true; }
+        else
+        {
+            printf("error: unknown argument: %s\n", arg.c_str());
+            print_usage(argc, argv);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    InputParams params{};
+    if (!params_parse(argc, argv, params)) return 1;
+
+    wchar_t modulePath[MAX_PATH]{};
+    GetModuleFileNameW(nullptr, modulePath, MAX_PATH);
+    auto exeDir = fs::path(modulePath).parent_path().string();
+    if (params.plugins.empty()) params.plugins.push_back(exeDir);
+    if (params.sdk.empty()) params.sdk = params.plugins.front();
+    if (params.logs.empty()) params.logs = exeDir;
+
+    auto libPath = fs::path(params.sdk) / "nvigi.core.framework.dll";
+    HMODULE lib = LoadLibraryW(libPath.wstring().c_str());
+    if (!lib)
+    {
+        printf("error: failed to load '%s'\n", libPath.string().c_str());
+        return 1;
+    }
+    GET_NVIGI_CORE_FUN(nvigiInit);
+    GET_NVIGI_CORE_FUN(nvigiShutdown);
+    GET_NVIGI_CORE_FUN(nvigiLoadInterface);
+    GET_NVIGI_CORE_FUN(nvigiUnloadInterface);
+    if (!nvigiInit || !nvigiShutdown || !nvigiLoadInterface || !nvigiUnloadInterface)
+    {
+        printf("error: '%s' is not a valid NVIGI SDK\n", libPath.string().c_str());
+        return 1;
+    }
+
+    std::vector<const char*> paths;
+    for (auto& path : params.plugins) paths.push_back(path.c_str());
+    nvigi::Preferences pref{};
+    pref.logLevel = params.verbose ? nvigi::LogLevel::eVerbose : nvigi::LogLevel::eDefault;
+    pref.showConsole = params.verbose;
+    pref.numPathsToPlugins = (uint32_t)paths.size();
+    pref.utf8PathsToPlugins = paths.data();
+    pref.utf8PathToDependencies = params.sdk.c_str();
+    pref.utf8PathToLogsAndData = params.logs.c_str();
+    if (NVIGI_FAILED(result, nvigiInit(pref, nullptr, nvigi::kSDKVersion)))
+    {
+        printf("error: nvigiInit failed 0x%x\n", result);
+        return 1;
+    }
+    nvigiGetInterfaceDynamic(nvigi::core::framework::kId, &nvigi::memory::imemory, nvigiLoadInterface);
+    nvigiGetInterfaceDynamic(nvigi::core::framework::kId, &nvigi::log::ilog, nvigiLoadInterface);
+    nvigi::log::resetLevelCache();
+
+    // Interfaces are loaded on first use and kept until shutdown
+    std::mutex mtx;
+    std::map<std::string, std::pair<nvigi::PluginID, nvigi::InferenceInterface*>> interfaces;
+    auto loader = [&](const nvigi::PluginID& feature)->nvigi::InferenceInterface*
+    {
+        std::scoped_lock lock(mtx);
+        auto key = nvigi::extra::guidToString(feature.id);
+        auto it = interfaces.find(key);
+        if (it != interfaces.end()) return it->second.second;
+        nvigi::InferenceInterface* iface{};
+        if (NVIGI_FAILED(result, nvigiGetInterfaceDynamic(feature, &iface, nvigiLoadInterface)))
+        {
+            NVIGI_LOG_ERROR("Failed to load inference interface for plugin %s (0x%x)", key.c_str(), result);
+            return nullptr;
+        }
+        interfaces[key] = { feature, iface };
+        return iface;
+    };
+
+    int exitCode = 0;
+    {
+        nvigi::ai::RemoteInferenceServer server(loader);
+        if (NVIGI_FAILED(result, server.listen(params.service.c_str())))
+        {
+            // Another host won the race, clients connect to it
+            printf("error: unable to serve '%s' (0x%x)\n", params.service.c_str(), result);
+            exitCode = result == nvigi::kResultAlreadyExists ? 0 : 1;
+        }
+        else
+        {
+            auto idleSince = std::chrono::steady_clock::now();
+            while (true)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                if (server.getClientCount()) idleSince = std::chrono::steady_clock::now();
+                if (params.persistent) continue;
+                if (std::chrono::steady_clock::now() - idleSince > std::chrono::milliseconds(params.idleExitMs)) break;
+            }
+            NVIGI_LOG_INFO("Inference host '%s' idle, served %llu client(s)", params.service.c_str(), (unsigned long long)server.getTotalClientCount());
+        }
+    }
+
+    for (auto& [key, loaded] : interfaces) nvigiUnloadInterface(loaded.first, loaded.second);
+    nvigiUnloadInterface(nvigi::core::framework::kId, nvigi::log::ilog);
+    nvigi::log::ilog = nullptr;
+    nvigi::log::resetLevelCache();
+    nvigiUnloadInterface(nvigi::core::framework::kId, nvigi::memory::imemory);
+    nvigi::memory::imemory = nullptr;
+    nvigiShutdown();
+    return exitCode;
+}
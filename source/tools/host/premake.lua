@@ -0,0 +1,24 @@
+if os.istarget("windows") then
+
+group "tools"
+
+project "nvigi.tool.host"
+	kind "ConsoleApp"
+       targetdir (bindir .. "%{cfg.platform}/%{cfg.buildcfg}")
+       objdir (artifactsdir .. "%{prj.name}/%{cfg.platform}/%{cfg.buildcfg}")
+       filter {"system:windows"}
+               symbolspath (symbolsdir .. "%{cfg.platform}/%{cfg.buildcfg}/$(TargetName).pdb")
+       filter {}
+
+	files {
+		"./**.h",
+		"./**.cpp",
+		ROOT .. "source/utils/nvigi.ai/ai_remote.h",
+		ROOT .. "source/utils/nvigi.ipc/ipc.h",
+	}
+
+	vpaths { ["impl"] = {"./**.h","./**.cpp", }, ["utils"] = {ROOT .. "source/utils/**.h"}}
+
+group ""
+
+end
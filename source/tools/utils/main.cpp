@@ -12,12 +12,17 @@
 #include <regex>
 #include <cstdint>
 #include <cstddef>
+#include <chrono>
+#include <fstream>
 #include <windows.h>
 
 #include "source/core/nvigi.api/nvigi.h"
 #include "source/core/nvigi.framework/framework.h"
 #include "source/core/nvigi.plugin/plugin.h"
 #include "source/core/nvigi.extra/extra.h"
+#include "source/core/nvigi.metrics/metrics.h"
+#include "source/utils/nvigi.ai/nvigi_ai.h"
+#include "external/json/source/nlohmann/json.hpp"
 
 namespace fs = std::filesystem;
 
@@ -124,6 +129,11 @@ struct InputParams
     std::string crc32{};
     std::string _interface{};
     std::string plugin{};
+    std::string profileStartup{};
+    std::string profileSort = "total";
+    std::string profileJSON{};
+    std::string profileModel{};
+    std::string profileModels{};
 };
 
 void print_usage(int /*argc*/, char** argv, const InputParams& params) {
@@ -136,6 +146,11 @@ void print_usage(int /*argc*/, char** argv, const InputParams& params) {
     fprintf(stderr, "  --crc24      NAME     produce crc24 for a given string\n");
     fprintf(stderr, "  --crc32      NAME     produce crc32 for a given string\n");
     fprintf(stderr, "  --validate   DIR      validate all plugins in a directory\n");
+    fprintf(stderr, "  --profile-startup DIR report per plugin startup cost for all plugins in a directory\n");
+    fprintf(stderr, "  --profile-sort COLUMN sort the startup report by name, validate, load, info, register, interface, create or total (default: %s)\n", params.profileSort.c_str());
+    fprintf(stderr, "  --profile-json FILE   also write the startup report to a JSON file\n");
+    fprintf(stderr, "  --profile-model GUID  model used to time the first 'createInstance' of each inference plugin\n");
+    fprintf(stderr, "  --profile-models DIR  model repository for '--profile-model'\n");
     fprintf(stderr, "\n");
 }
 
@@ -181,6 +196,41 @@ bool params_parse(int argc, char** argv, InputParams& params) {
             }
             params.validate = argv[i];
         }
+        else if (arg == "--profile-startup") {
+            if (++i >= argc) {
+                printf("Invalid parameter count");
+                break;
+            }
+            params.profileStartup = argv[i];
+        }
+        else if (arg == "--profile-sort") {
+            if (++i >= argc) {
+                printf("Invalid parameter count");
+                break;
+            }
+            params.profileSort = argv[i];
+        }
+        else if (arg == "--profile-json") {
+            if (++i >= argc) {
+                printf("Invalid parameter count");
+                break;
+            }
+            params.profileJSON = argv[i];
+        }
+        else if (arg == "--profile-model") {
+            if (++i >= argc) {
+                printf("Invalid parameter count");
+                break;
+            }
+            params.profileModel = argv[i];
+        }
+        else if (arg == "--profile-models") {
+            if (++i >= argc) {
+                printf("Invalid parameter count");
+                break;
+            }
+            params.profileModels = argv[i];
+        }
         else {
             printf("error: unknown argument: %s\n", arg.c_str());
             print_usage(argc, argv, params);
@@ -191,6 +241,217 @@ bool params_parse(int argc, char** argv, InputParams& params) {
     return true;
 }
 
+//! Startup cost of one plugin, all times in milliseconds
+//!
+//! Validation, loading and 'getInfo' run when plugins are enumerated in 'nvigiInit' (unless the manifest is cached)
+//! and again when the plugin registers on the first 'nvigiLoadInterface', the framework records both passes.
+struct StartupProfile
+{
+    std::string name;
+    nvigi::PluginID id{};
+    nvigi::Result status{};
+    double validate{};
+    double loadLibrary{};
+    double getInfo{};
+    double registerPlugin{};
+    //! Wall time of the first 'nvigiLoadInterface', includes the registration pass
+    double loadInterface{};
+    double createInstance{};
+    //! 'kResultItemNotFound' when 'createInstance' was not attempted
+    nvigi::Result createStatus = nvigi::kResultItemNotFound;
+
+    double total() const { return validate + loadLibrary + getInfo + registerPlugin + createInstance; }
+};
+
+double getColumn(const StartupProfile& profile, const std::string& column)
+{
+    if (column == "validate") return profile.validate;
+    if (column == "load") return profile.loadLibrary;
+    if (column == "info") return profile.getInfo;
+    if (column == "register") return profile.registerPlugin;
+    if (column == "interface") return profile.loadInterface;
+    if (column == "create") return profile.createInstance;
+    return profile.total();
+}
+
+double getElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int profileStartup(InputParams& params)
+{
+    const std::vector<std::string> columns = { "name", "validate", "load", "info", "register", "interface", "create", "total" };
+    if (std::find(columns.begin(), columns.end(), params.profileSort) == columns.end())
+    {
+        printf("error: unknown sort column '%s'\n", params.profileSort.c_str());
+        return 1;
+    }
+    params.profileStartup = fs::absolute(params.profileStartup).string();
+    if (!fs::is_directory(params.profileStartup))
+    {
+        printf("%s is not a valid directory", params.profileStartup.c_str());
+        return 1;
+    }
+
+    printf("Profiling startup of SDK located at '%s' ...\n", params.profileStartup.c_str());
+
+    auto libPath = params.profileStartup + "/nvigi.core.framework.dll";
+    HMODULE lib = LoadLibraryA(libPath.c_str());
+    if (!lib)
+    {
+        printf("error: unable to load '%s'\n", libPath.c_str());
+        return 1;
+    }
+
+    GET_NVIGI_CORE_FUN(nvigiInit);
+    GET_NVIGI_CORE_FUN(nvigiShutdown);
+    GET_NVIGI_CORE_FUN(nvigiLoadInterface);
+    GET_NVIGI_CORE_FUN(nvigiUnloadInterface);
+
+    const char* paths[] =
+    {
+        params.profileStartup.c_str()
+    };
+
+    nvigi::Preferences pref{};
+    pref.logLevel = nvigi::LogLevel::eOff;
+    pref.showConsole = false;
+    pref.numPathsToPlugins = _countof(paths);
+    pref.utf8PathsToPlugins = paths;
+    pref.utf8PathToDependencies = params.profileStartup.c_str();
+    nvigi::PluginAndSystemInformation* info{};
+    auto start = std::chrono::steady_clock::now();
+    if (NVIGI_FAILED(error, nvigiInit(pref, &info, nvigi::kSDKVersion)))
+    {
+        printf("error: nvigiInit failed\n");
+        return 1;
+    }
+    auto initMs = getElapsedMs(start);
+
+    std::vector<StartupProfile> profiles;
+    for (size_t i = 0; info && i < info->numDetectedPlugins; i++)
+    {
+        auto spec = info->detectedPlugins[i];
+        StartupProfile profile{};
+        profile.name = spec->pluginName ? spec->pluginName : "";
+        profile.id = spec->id;
+        profile.status = spec->status;
+        if (spec->status != nvigi::kResultOk || !spec->numSupportedInterfaces)
+        {
+            profiles.push_back(profile);
+            continue;
+        }
+
+        //! Any interface forces registration, inference plugins also get their first instance timed
+        auto isInference = std::find(spec->supportedInterfaces, spec->supportedInterfaces + spec->numSupportedInterfaces, nvigi::InferenceInterface::s_type) != spec->supportedInterfaces + spec->numSupportedInterfaces;
+        auto interfaceType = isInference ? nvigi::InferenceInterface::s_type : spec->supportedInterfaces[0];
+        void* iface{};
+        start = std::chrono::steady_clock::now();
+        profile.status = nvigiLoadInterface(spec->id, interfaceType, nvigi::kStructVersion1, &iface, nullptr);
+        profile.loadInterface = getElapsedMs(start);
+        if (profile.status != nvigi::kResultOk)
+        {
+            profiles.push_back(profile);
+            continue;
+        }
+
+        if (isInference && !params.profileModel.empty())
+        {
+            auto inference = static_cast<nvigi::InferenceInterface*>(iface);
+            nvigi::CommonCreationParameters common{};
+            common.modelGUID = params.profileModel.c_str();
+            common.utf8PathToModels = params.profileModels.c_str();
+            nvigi::InferenceInstance* instance{};
+            start = std::chrono::steady_clock::now();
+            profile.createStatus = inference->createInstance(common, &instance);
+            profile.createInstance = getElapsedMs(start);
+            if (instance) inference->destroyInstance(instance);
+        }
+        nvigiUnloadInterface(spec->id, iface);
+        profiles.push_back(profile);
+    }
+
+    //! Framework records the time spent in each startup stage, histogram mean times count gives the total
+    double scanMs{};
+    nvigi::metrics::IMetrics* imetrics{};
+    if (nvigiGetInterfaceDynamic(nvigi::core::framework::kId, &imetrics, nvigiLoadInterface) == nvigi::kResultOk)
+    {
+        auto collect = [](const nvigi::metrics::HistogramSnapshot* snapshot, void* userData)->void
+        {
+            auto [profiles, scanMs] = *static_cast<std::pair<std::vector<StartupProfile>*, double*>*>(userData);
+            auto ms = snapshot->mean * snapshot->count / 1000.0;
+            std::string name = snapshot->name;
+            if (snapshot->plugin == nvigi::core::framework::kId)
+            {
+                if (name == "startup_scan_us") *scanMs += ms;
+                return;
+            }
+            auto it = std::find_if(profiles->begin(), profiles->end(), [snapshot](const StartupProfile& p) { return p.id == snapshot->plugin; });
+            if (it == profiles->end()) return;
+            if (name == "startup_validate_us") it->validate = ms;
+            else if (name == "startup_load_library_us") it->loadLibrary = ms;
+            else if (name == "startup_get_info_us") it->getInfo = ms;
+            else if (name == "startup_register_us") it->registerPlugin = ms;
+        };
+        auto userData = std::make_pair(&profiles, &scanMs);
+        imetrics->enumerate(nullptr, collect, &userData);
+        nvigiUnloadInterface(nvigi::core::framework::kId, imetrics);
+    }
+    else
+    {
+        printf("warning: framework does not provide 'IMetrics', only interface and instance times are reported\n");
+    }
+    nvigiShutdown();
+
+    std::sort(profiles.begin(), profiles.end(), [&params](const StartupProfile& a, const StartupProfile& b)
+    {
+        if (params.profileSort == "name") return a.name < b.name;
+        return getColumn(a, params.profileSort) > getColumn(b, params.profileSort);
+    });
+
+    printf("\nnvigiInit %.2fms, directory scan %.2fms\n\n", initMs, scanMs);
+    printf("%-48s %10s %10s %10s %10s %10s %10s %10s  %s\n", "plugin", "validate", "load", "info", "register", "interface", "create", "total", "status");
+    for (auto& profile : profiles)
+    {
+        auto status = profile.status != nvigi::kResultOk ? profile.status : (profile.createStatus == nvigi::kResultItemNotFound ? nvigi::kResultOk : profile.createStatus);
+        printf("%-48s %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f  %s\n", profile.name.c_str(), profile.validate, profile.loadLibrary,
+            profile.getInfo, profile.registerPlugin, profile.loadInterface, profile.createInstance, profile.total(), nvigi::resultToString(status));
+    }
+    printf("\nAll times in milliseconds, sorted by '%s'\n", params.profileSort.c_str());
+
+    if (!params.profileJSON.empty())
+    {
+        nlohmann::json report = { {"sdk", params.profileStartup}, {"initMs", initMs}, {"scanMs", scanMs}, {"sortedBy", params.profileSort}, {"plugins", nlohmann::json::array()} };
+        for (auto& profile : profiles)
+        {
+            nlohmann::json entry = {
+                {"name", profile.name},
+                {"id", nvigi::extra::guidToString(profile.id.id)},
+                {"status", nvigi::resultToString(profile.status)},
+                {"validateMs", profile.validate},
+                {"loadLibraryMs", profile.loadLibrary},
+                {"getInfoMs", profile.getInfo},
+                {"registerMs", profile.registerPlugin},
+                {"loadInterfaceMs", profile.loadInterface},
+                {"createInstanceMs", profile.createInstance},
+                {"totalMs", profile.total()},
+            };
+            if (profile.createStatus != nvigi::kResultItemNotFound) entry["createInstanceStatus"] = nvigi::resultToString(profile.createStatus);
+            report["plugins"].push_back(entry);
+        }
+        std::ofstream file(fs::path((const char8_t*)params.profileJSON.c_str()), std::ios::trunc);
+        file << report.dump(2);
+        if (!file)
+        {
+            printf("error: unable to write '%s'\n", params.profileJSON.c_str());
+            return 1;
+        }
+        printf("Report written to '%s'\n", params.profileJSON.c_str());
+    }
+    return 0;
+}
+
 int main(int argc, char** argv)
 {
     InputParams params{};
@@ -321,5 +582,10 @@ int main(int argc, char** argv)
             printf("Check: FAILED\n");
         }
     }
+
+    if (!params.profileStartup.empty())
+    {
+        return profileStartup(params);
+    }
     return 0;
 }
\ No newline at end of file
@@ -18,6 +18,11 @@ project "nvigi.tool.utils"
 		ROOT .. "source/core/nvigi.memory/**.cpp", -- needed to test types
 	}
 	
+	includedirs {
+		ROOT .. "source/core/nvigi.api",
+		ROOT .. "source/utils/nvigi.ai"
+	}
+
 	vpaths { ["impl"] = {"./**.h","./**.cpp", }}
 	links {"rpcrt4.lib"}
 		
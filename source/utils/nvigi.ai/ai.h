@@ -4,7 +4,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <regex>
+#include <mutex>
+#include <unordered_map>
+#include <deque>
+#include <memory>
 
 #include "source/utils/nvigi.ai/nvigi_ai.h"
 #include "source/core/nvigi.file/file.h"
@@ -217,6 +223,207 @@ inline bool processDirectory(const std::u8string& _directory, json& modelInfo, c
     return true;
 };
 
+//! MODEL INDEX CACHE
+//! 
+//! Scanning model directories parses every model card and lists every file, which takes seconds with hundreds
+//! of models or on spinning disks and network shares. Results are kept in-process (shared by all instances of the plugin)
+//! and in an on-disk index next to the plugin's model directory. Both are invalidated by a stamp over the write time
+//! of every directory in the tree (files added, removed or renamed) and the size and write time of every model card,
+//! see 'getModelDirectoryStamp'.
+
+constexpr const char* kModelIndexExtension = ".nvigi.index.json";
+constexpr uint32_t kModelIndexVersion = 1;
+
+inline void hashModelIndexValue(uint64_t& hash, const void* data, size_t size)
+{
+    // FNV-1a
+    auto bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+}
+
+//! Walking the tree for the stamp is not free either, the result is reused while the top level directory is unchanged
+//! (models added, removed or renamed) for at most 'kModelDirectoryStampTTL', edits deeper in the tree show up once it expires.
+constexpr std::chrono::milliseconds kModelDirectoryStampTTL = std::chrono::milliseconds(2000);
+
+//! 'directory' must be an OS valid path, see 'getModelDirectoryStamp'
+inline uint64_t computeModelDirectoryStamp(const std::u8string& directory)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    std::error_code ec;
+    auto hashEntry = [&hash](const fs::path& path, int64_t time, uintmax_t size)
+    {
+        auto str = path.u8string();
+        hashModelIndexValue(hash, str.data(), str.size());
+        hashModelIndexValue(hash, &time, sizeof(time));
+        hashModelIndexValue(hash, &size, sizeof(size));
+    };
+    hashEntry(directory, fs::last_write_time(directory, ec).time_since_epoch().count(), 0);
+    for (auto it = fs::recursive_directory_iterator(directory, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec))
+    {
+        auto& entry = *it;
+        if (entry.is_directory(ec))
+        {
+            hashEntry(entry.path(), entry.last_write_time(ec).time_since_epoch().count(), 0);
+        }
+        else
+        {
+            auto fileName = entry.path().filename().string();
+            if (fileName == kModelConfigFile || fileName == "model.json")
+            {
+                hashEntry(entry.path(), entry.last_write_time(ec).time_since_epoch().count(), entry.file_size(ec));
+            }
+        }
+    }
+    return hash;
+}
+
+struct ModelDirectoryStampCache
+{
+    struct Entry
+    {
+        int64_t writeTime;
+        std::chrono::steady_clock::time_point computedAt;
+        uint64_t stamp;
+    };
+    std::mutex mtx;
+    std::unordered_map<std::u8string, Entry> entries;
+};
+
+inline uint64_t getModelDirectoryStamp(const std::u8string& _directory)
+{
+    std::u8string directory;
+    if (!file::getOSValidPath(_directory, directory)) return 0xcbf29ce484222325ull;
+    std::error_code ec;
+    auto writeTime = fs::last_write_time(directory, ec).time_since_epoch().count();
+    // Missing or inaccessible, nothing to walk anyway
+    if (ec) return computeModelDirectoryStamp(directory);
+
+    static ModelDirectoryStampCache s_cache;
+    auto now = std::chrono::steady_clock::now();
+    {
+        std::scoped_lock lock(s_cache.mtx);
+        auto it = s_cache.entries.find(directory);
+        if (it != s_cache.entries.end() && it->second.writeTime == writeTime && now - it->second.computedAt < kModelDirectoryStampTTL)
+        {
+            return it->second.stamp;
+        }
+    }
+    // Walk without holding the lock, concurrent walks of the same tree produce the same stamp
+    auto stamp = computeModelDirectoryStamp(directory);
+    std::scoped_lock lock(s_cache.mtx);
+    s_cache.entries[directory] = { writeTime, now, stamp };
+    return stamp;
+}
+
+struct ModelIndexCache
+{
+    struct Entry
+    {
+        uint64_t stamp;
+        json modelInfo;
+    };
+    std::mutex mtx;
+    std::unordered_map<std::string, Entry> entries;
+};
+
+inline ModelIndexCache& getModelIndexCache()
+{
+    static ModelIndexCache s_cache;
+    return s_cache;
+}
+
+//! Runs 'processDirectory' on each directory (in order, directory + optional flag) starting from empty model info,
+//! using the index cache when nothing changed on disk.
+//! 
+//! Empty 'indexPath' disables the on-disk index.
+inline bool processDirectoriesCached(const std::vector<std::pair<std::u8string, bool>>& directories, const std::u8string& indexPath, json& modelInfo, const CommonCreationParameters* params, const std::vector<std::string>& extensions)
+{
+    std::string key;
+    uint64_t stamp = 0xcbf29ce484222325ull;
+    for (auto& [directory, optional] : directories)
+    {
+        key += std::string(directory.begin(), directory.end()) + (optional ? "?" : "") + ";";
+        auto dirStamp = getModelDirectoryStamp(directory);
+        hashModelIndexValue(stamp, &dirStamp, sizeof(dirStamp));
+    }
+    for (auto& ext : extensions) key += "." + ext;
+    auto stampStr = std::to_string(stamp);
+
+    auto& cache = getModelIndexCache();
+    {
+        std::scoped_lock lock(cache.mtx);
+        auto it = cache.entries.find(key);
+        if (it != cache.entries.end() && it->second.stamp == stamp)
+        {
+            modelInfo = it->second.modelInfo;
+            return true;
+        }
+    }
+
+    json index;
+    if (!indexPath.empty())
+    {
+        try
+        {
+            auto text = file::read(fs::path(indexPath).wstring().c_str());
+            if (!text.empty())
+            {
+                index = json::parse(text.begin(), text.end());
+                if (index.value("version", 0u) != kModelIndexVersion || !index.contains("entries")) index = {};
+            }
+        }
+        catch (std::exception&)
+        {
+            index = {};
+        }
+        if (index.contains("entries") && index["entries"].contains(key) && index["entries"][key].value("stamp", std::string()) == stampStr)
+        {
+            NVIGI_LOG_VERBOSE("Using model index '%S'", fs::path(indexPath).wstring().c_str());
+            modelInfo = index["entries"][key]["models"];
+            std::scoped_lock lock(cache.mtx);
+            cache.entries[key] = { stamp, modelInfo };
+            return true;
+        }
+    }
+
+    modelInfo = json::object();
+    for (auto& [directory, optional] : directories)
+    {
+        // Optional directories never fail the scan
+        if (!processDirectory(directory, modelInfo, params, extensions, optional) && !optional) return false;
+    }
+
+    {
+        std::scoped_lock lock(cache.mtx);
+        cache.entries[key] = { stamp, modelInfo };
+    }
+
+    if (!indexPath.empty())
+    {
+        if (index.is_null()) index = { {"version", kModelIndexVersion}, {"entries", json::object()} };
+        index["entries"][key] = { {"stamp", stampStr}, {"models", modelInfo} };
+        auto text = index.dump(1, ' ', false, json::error_handler_t::replace);
+        // Write and rename so that concurrently starting processes never read a partial index, read-only model
+        // repositories are fine we simply scan again next time
+        auto path = fs::path(indexPath);
+        auto tmpPath = path;
+        tmpPath += ".tmp";
+        std::error_code ec;
+        file::write(tmpPath.wstring().c_str(), std::vector<uint8_t>(text.begin(), text.end()));
+        fs::rename(tmpPath, path, ec);
+        if (ec)
+        {
+            NVIGI_LOG_VERBOSE("Unable to store model index '%S' - %s", path.wstring().c_str(), ec.message().c_str());
+            fs::remove(tmpPath, ec);
+        }
+    }
+    return true;
+}
+
 inline bool findFilePath(const json& guidInfo, const char* fileName, std::string& filePath)
 {
     //std::string tmp = guidInfo.dump(1, ' ', false, json::error_handler_t::replace);
@@ -403,13 +610,17 @@ inline bool findModels(const CommonCreationParameters* params, const std::vector
     NVIGI_LOG_INFO("# GUID: %s", params->modelGUID ? params->modelGUID : "any");
     NVIGI_LOG_INFO("# extension(s): [%s]", extStr.c_str());
 
-    // First try optional "configs" path to collect JSON files
-    auto directory = std::u8string((const char8_t*)(params->utf8PathToModels + std::string("/configs/") + pluginDir).c_str());
-    processDirectory(directory, modelInfo, params, extensions, true);
-    
-    // Now collect model info and any JSON files not provided under "configs"
-    directory = std::u8string((const char8_t*)(params->utf8PathToModels + std::string("/") + pluginDir).c_str());
-    if (!processDirectory(directory, modelInfo, params, extensions)) return false;
+    // First try optional "configs" path to collect JSON files, then collect model info and any JSON files not provided under "configs"
+    auto configsDirectory = std::u8string((const char8_t*)(params->utf8PathToModels + std::string("/configs/") + pluginDir).c_str());
+    auto directory = std::u8string((const char8_t*)(params->utf8PathToModels + std::string("/") + pluginDir).c_str());
+    auto indexPath = std::u8string((const char8_t*)(params->utf8PathToModels + std::string("/") + pluginDir + kModelIndexExtension).c_str());
+    json scanned;
+    if (!processDirectoriesCached({ {configsDirectory, true}, {directory, false} }, indexPath, scanned, params, extensions)) return false;
+    // Requested GUID keeps the defaults set above if it was not found
+    for (auto& [guid, info] : scanned.items())
+    {
+        modelInfo[guid] = info;
+    }
     
     // Log which sub-approach was detected
     if (params->modelGUID && modelInfo[params->modelGUID].contains("model") &&
@@ -428,7 +639,13 @@ inline bool findModels(const CommonCreationParameters* params, const std::vector
             return false;
         }
         directory = std::u8string((const char8_t*)(params->utf8PathToAdditionalModels + std::string("/") + pluginDir + std::string("/")).c_str());
-        if (!processDirectory(directory, *additionalModelInfo, params, extensions)) return false;
+        indexPath = std::u8string((const char8_t*)(params->utf8PathToAdditionalModels + std::string("/") + pluginDir + kModelIndexExtension).c_str());
+        json additional;
+        if (!processDirectoriesCached({ {directory, false} }, indexPath, additional, params, extensions)) return false;
+        for (auto& [guid, info] : additional.items())
+        {
+            (*additionalModelInfo)[guid] = info;
+        }
     }
 
     return true;
@@ -514,8 +731,198 @@ inline bool populateCommonCapsAndRequirements(CommonCapsData& data, const Common
     return true;
 }
 
+//! CAPS AND REQUIREMENTS CACHE
+//!
+//! Hosts query caps whenever a settings UI opens, often for several plugins and from several threads. Results are cached
+//! per normalized creation parameters and handed out as immutable snapshots which own all arrays and chained caps, so they
+//! are safe to read from any thread and the plugin is free to reuse its own buffers for the next query. Snapshot is
+//! replaced, never modified, when the model directory stamp (see 'getModelDirectoryStamp') changes.
+//!
+//! Replaced snapshots stay valid for the next 'kMaxRetiredCapsSnapshots' changes of the same query and until the plugin
+//! is unloaded ('CapsCache::clear'), hosts should query again rather than hold on to caps across model changes.
+//!
+//! NOTE: Chained structures defined by the API ('CloudCapabilities') are copied, any other chained structure is plugin
+//! owned, referenced as is and must stay valid and unchanged until the plugin is unloaded.
+
+constexpr size_t kMaxRetiredCapsSnapshots = 4;
+
+struct CapsSnapshot
+{
+    CommonCapabilitiesAndRequirements caps{};
+    std::vector<std::string> names;
+    std::vector<std::string> guids;
+    std::vector<const char*> namePtrs;
+    std::vector<const char*> guidPtrs;
+    std::vector<size_t> vrams;
+    std::vector<ModelFlags> flags;
+    //! Copies of chained caps and their strings, deque keeps the addresses stable
+    std::vector<std::unique_ptr<CloudCapabilities>> clouds;
+    std::deque<std::string> strings;
+};
+
+inline std::unique_ptr<CapsSnapshot> makeCapsSnapshot(const CommonCapabilitiesAndRequirements& caps)
+{
+    auto snapshot = std::make_unique<CapsSnapshot>();
+    auto count = caps.numSupportedModels;
+    for (size_t i = 0; i < count; i++)
+    {
+        snapshot->names.push_back(caps.supportedModelNames && caps.supportedModelNames[i] ? caps.supportedModelNames[i] : "");
+        snapshot->guids.push_back(caps.supportedModelGUIDs && caps.supportedModelGUIDs[i] ? caps.supportedModelGUIDs[i] : "");
+        snapshot->vrams.push_back(caps.modelMemoryBudgetMB ? caps.modelMemoryBudgetMB[i] : 0);
+        snapshot->flags.push_back(caps.getVersion() >= 2 && caps.modelFlags ? caps.modelFlags[i] : 0);
+    }
+    // Pointers are taken once all strings are in place
+    for (size_t i = 0; i < count; i++)
+    {
+        snapshot->namePtrs.push_back(snapshot->names[i].c_str());
+        snapshot->guidPtrs.push_back(snapshot->guids[i].c_str());
+    }
+    snapshot->caps = caps;
+    snapshot->caps.supportedModelNames = caps.supportedModelNames ? snapshot->namePtrs.data() : nullptr;
+    snapshot->caps.supportedModelGUIDs = caps.supportedModelGUIDs ? snapshot->guidPtrs.data() : nullptr;
+    snapshot->caps.modelMemoryBudgetMB = caps.modelMemoryBudgetMB ? snapshot->vrams.data() : nullptr;
+    snapshot->caps.modelFlags = snapshot->flags.data();
+
+    auto copyString = [&snapshot](const char* str)->const char*
+    {
+        return str ? snapshot->strings.emplace_back(str).c_str() : nullptr;
+    };
+    BaseStructure* tail = snapshot->caps;
+    for (auto next = static_cast<BaseStructure*>(caps._base.next); next; next = static_cast<BaseStructure*>(next->next))
+    {
+        BaseStructure* copy = next;
+        if (next->type == CloudCapabilities::s_type)
+        {
+            auto src = reinterpret_cast<const CloudCapabilities*>(next);
+            auto cloud = snapshot->clouds.emplace_back(std::make_unique<CloudCapabilities>()).get();
+            cloud->url = copyString(src->url);
+            cloud->jsonRequestBody = copyString(src->jsonRequestBody);
+            copy = *cloud;
+        }
+        tail->next = copy;
+        tail = copy;
+        // Rest of the chain belongs to the plugin, see above
+        if (copy == next) break;
+    }
+    return snapshot;
+}
+
+//! Cache key and stamp for the given caps query, false if the query cannot be cached (no 'CommonCreationParameters')
+//!
+//! Paths are normalized so different spellings of the same directory share the entry, GUIDs are case insensitive.
+inline bool getCapsCacheKey(const NVIGIParameter* params, std::string& key, uint64_t& stamp)
+{
+    auto common = findStruct<CommonCreationParameters>(params);
+    if (!common) return false;
+
+    auto normalizeDirectory = [](const char* utf8Path)->std::string
+    {
+        if (!utf8Path || !*utf8Path) return {};
+        std::string path;
+        if (!file::getOSValidDirectoryPath(utf8Path, path)) path = utf8Path;
+#ifdef NVIGI_WINDOWS
+        std::transform(path.begin(), path.end(), path.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+#endif
+        return path;
+    };
+    std::string guid = common->modelGUID ? common->modelGUID : "";
+    std::transform(guid.begin(), guid.end(), guid.begin(), [](unsigned char c) { return (char)std::toupper(c); });
+    auto models = normalizeDirectory(common->utf8PathToModels);
+    auto additional = normalizeDirectory(common->utf8PathToAdditionalModels);
+
+    uint64_t cardHash = 0xcbf29ce484222325ull;
+    if (common->getVersion() >= 2 && common->modelCardJSON)
+    {
+        hashModelIndexValue(cardHash, common->modelCardJSON, strlen(common->modelCardJSON));
+    }
+    key = guid + "|" + models + "|" + additional + "|" + std::to_string(common->vramBudgetMB) + "|" + std::to_string(cardHash);
+
+    stamp = 0xcbf29ce484222325ull;
+    for (auto& directory : { models, additional })
+    {
+        if (directory.empty()) continue;
+        auto dirStamp = getModelDirectoryStamp(std::u8string(directory.begin(), directory.end()));
+        hashModelIndexValue(stamp, &dirStamp, sizeof(dirStamp));
+    }
+    return true;
+}
+
+//! One per plugin, see above
+struct CapsCache
+{
+    //! Snapshots are never modified once published, returned pointer is what the host gets (read only by contract)
+    CapsSnapshot* find(const std::string& key, uint64_t stamp)
+    {
+        std::scoped_lock lock(mtx);
+        auto it = entries.find(key);
+        return it != entries.end() && it->second.stamp == stamp ? it->second.current.get() : nullptr;
+    }
+
+    //! Previous snapshot for the key is retired (see 'kMaxRetiredCapsSnapshots') unless identical
+    CapsSnapshot* insert(const std::string& key, uint64_t stamp, const CommonCapabilitiesAndRequirements& caps)
+    {
+        auto snapshot = makeCapsSnapshot(caps);
+        std::scoped_lock lock(mtx);
+        auto& entry = entries[key];
+        entry.stamp = stamp;
+        // Directory touched but nothing relevant changed, keep handing out the same snapshot
+        if (entry.current && isSame(*entry.current, *snapshot))
+        {
+            return entry.current.get();
+        }
+        if (entry.current)
+        {
+            entry.retired.push_back(std::move(entry.current));
+            if (entry.retired.size() > kMaxRetiredCapsSnapshots) entry.retired.pop_front();
+        }
+        entry.current = std::move(snapshot);
+        return entry.current.get();
+    }
+
+    //! Frees all snapshots, call when the plugin is unloaded
+    void clear()
+    {
+        std::scoped_lock lock(mtx);
+        entries.clear();
+    }
+
+    //! Plugins populate caps into shared plugin data, queries which miss the cache run one at a time
+    std::mutex queryMtx;
+
+private:
+    static bool isSame(const CapsSnapshot& a, const CapsSnapshot& b)
+    {
+        if (a.caps.supportedBackends != b.caps.supportedBackends || a.names != b.names || a.guids != b.guids || a.vrams != b.vrams || a.flags != b.flags)
+        {
+            return false;
+        }
+        auto same = [](const char* x, const char* y) { return x == y || (x && y && strcmp(x, y) == 0); };
+        auto x = static_cast<const BaseStructure*>(a.caps._base.next);
+        auto y = static_cast<const BaseStructure*>(b.caps._base.next);
+        for (; x && y; x = static_cast<const BaseStructure*>(x->next), y = static_cast<const BaseStructure*>(y->next))
+        {
+            if (x->type != y->type) return false;
+            if (x->type != CloudCapabilities::s_type) return x == y;
+            auto cx = reinterpret_cast<const CloudCapabilities*>(x);
+            auto cy = reinterpret_cast<const CloudCapabilities*>(y);
+            if (!same(cx->url, cy->url) || !same(cx->jsonRequestBody, cy->jsonRequestBody)) return false;
+        }
+        return x == y;
+    }
+
+    struct Entry
+    {
+        uint64_t stamp{};
+        std::unique_ptr<CapsSnapshot> current;
+        std::deque<std::unique_ptr<CapsSnapshot>> retired;
+    };
+    std::mutex mtx;
+    std::unordered_map<std::string, Entry> entries;
+};
+
 //! A2X HELPER
 //! 
+//! NOTE: Holds a copy of the entire track, use 'StreamingAudioChunker' from ai_audio_chunker.h for live or long inputs
 struct A2XAudioProcessor
 {
     A2XAudioProcessor(float _dt, int _sampleRate, int _bufferLength, int _bufferOffset, const std::vector<float>& _trackData) :
@@ -543,9 +950,9 @@ struct A2XAudioProcessor
         audioBuffer.resize(bufferLength, 0.0f);
         memset(audioBuffer.data(), 0, audioBuffer.size() * sizeof(float));
         int copyLength = std::min(end - begin, bufferLength - begin); // Calculate how many elements we can actually copy
-        for (int idx = 0; idx < copyLength; idx++)
+        if (copyLength > 0)
         {
-            audioBuffer[begin + idx] = trackData[offset + begin + idx];
+            memcpy(audioBuffer.data() + begin, trackData.data() + offset + begin, copyLength * sizeof(float));
         }
         if(index) *index = frameIndex;
         t += dt;
@@ -567,51 +974,151 @@ struct A2XAudioProcessor
 constexpr const char* kPromptTemplate = "prompt_template";
 constexpr const char* kTurnTemplate = "turn_template";
 
-//! PROMPT HELPER
-//! 
-inline std::string generatePrompt(const json& model, const std::string& system, const std::string& user, const std::string& assistant)
+//! Compiled 'prompt_template' or 'turn_template' from the model card
+//!
+//! Compile once per instance, 'render' then only copies the pieces into a buffer which is reused between calls so steady state
+//! rendering does not allocate. Each render also reports how many leading bytes are identical to the previous render
+//! (system prompt, earlier history etc.), backends can keep the tokens and cached state (e.g. KV cache) for that prefix
+//! and only encode the rest. Prefix never ends in the middle of a UTF-8 sequence but it can end in the middle of a token,
+//! backends should only reuse tokens which are fully contained in it.
+//!
+//! NOTE: Not thread safe, typically one per instance
+struct PromptTemplate
 {
-    std::string prompt;
-    if (model.contains(kPromptTemplate))
+    enum class Kind
     {
-        std::vector<std::string> tmpl = model[kPromptTemplate];
-        for (auto& s : tmpl)
+        ePrompt,
+        eTurn
+    };
+
+    //! Missing template falls back to the same defaults as 'generatePrompt' and 'generateTurn'
+    //! 'templateKey' selects a variant (e.g. "prompt_template_think"), by default 'kPromptTemplate' or 'kTurnTemplate' based on 'kind'
+    Result compile(const json& model, Kind kind, const char* templateKey = nullptr)
+    {
+        segments.clear();
+        reset();
+        auto key = templateKey ? templateKey : (kind == Kind::ePrompt ? kPromptTemplate : kTurnTemplate);
+        if (!model.contains(key))
         {
-            if (s == "$system") prompt += system;
-            else if (s == "$user") prompt += user;
-            else if (s == "$assistant") prompt += assistant;
-            else prompt += s;
+            if (kind == Kind::ePrompt)
+            {
+                // User must put it all in the user prompt
+                segments.push_back({ Part::eUser });
+            }
+            else
+            {
+                segments.push_back({ Part::eLiteral, "\nInstruct:" });
+                segments.push_back({ Part::eUser });
+                segments.push_back({ Part::eLiteral, "\nOutput:" });
+                segments.push_back({ Part::eAssistant });
+            }
+            return kResultOk;
         }
+        auto& tmpl = model[key];
+        if (!tmpl.is_array())
+        {
+            NVIGI_LOG_ERROR("Model card entry '%s' must be an array of strings", key);
+            return kResultInvalidParameter;
+        }
+        for (auto& item : tmpl)
+        {
+            if (!item.is_string())
+            {
+                NVIGI_LOG_ERROR("Model card entry '%s' must be an array of strings", key);
+                segments.clear();
+                return kResultInvalidParameter;
+            }
+            auto& str = item.get_ref<const std::string&>();
+            if (str == "$system" && kind == Kind::ePrompt) segments.push_back({ Part::eSystem });
+            else if (str == "$user") segments.push_back({ Part::eUser });
+            else if (str == "$assistant") segments.push_back({ Part::eAssistant });
+            // Adjacent literals are merged so rendering touches as few pieces as possible
+            else if (!segments.empty() && segments.back().part == Part::eLiteral) segments.back().literal += str;
+            else segments.push_back({ Part::eLiteral, str });
+        }
+        return kResultOk;
+    }
+
+    bool isCompiled() const { return !segments.empty(); }
+
+    //! Returned string is valid until the next call, see 'getStablePrefixLength'
+    const std::string& render(const std::string& system, const std::string& user, const std::string& assistant)
+    {
+        std::swap(buffer, previous);
+        buffer.clear();
+        size_t size = 0;
+        for (auto& segment : segments) size += get(segment, system, user, assistant).size();
+        buffer.reserve(size);
+        for (auto& segment : segments) buffer += get(segment, system, user, assistant);
+
+        auto mismatch = std::mismatch(buffer.begin(), buffer.begin() + std::min(buffer.size(), previous.size()), previous.begin());
+        stablePrefix = size_t(mismatch.first - buffer.begin());
+        // Back off to a UTF-8 boundary, continuation bytes are 10xxxxxx
+        while (stablePrefix > 0 && stablePrefix < buffer.size() && (uint8_t(buffer[stablePrefix]) & 0xC0) == 0x80) stablePrefix--;
+        return buffer;
     }
-    else
+
+    //! Bytes at the start of the last render identical to the render before it, 0 after 'compile' or 'reset'
+    size_t getStablePrefixLength() const { return stablePrefix; }
+
+    //! Call when the backend drops its cached state (e.g. context reset), next render reports no stable prefix
+    void reset()
     {
-        // Default - if no prompt template, user must put it all in the user prompt.
-        prompt += user;
+        previous.clear();
+        buffer.clear();
+        stablePrefix = 0;
     }
-    return prompt;
+
+private:
+    enum class Part : uint8_t
+    {
+        eLiteral,
+        eSystem,
+        eUser,
+        eAssistant
+    };
+
+    struct Segment
+    {
+        Part part;
+        std::string literal;
+    };
+
+    static const std::string& get(const Segment& segment, const std::string& system, const std::string& user, const std::string& assistant)
+    {
+        switch (segment.part)
+        {
+            case Part::eSystem: return system;
+            case Part::eUser: return user;
+            case Part::eAssistant: return assistant;
+            default: return segment.literal;
+        }
+    }
+
+    std::vector<Segment> segments;
+    std::string buffer;
+    std::string previous;
+    size_t stablePrefix{};
+};
+
+//! PROMPT HELPER
+//! 
+//! NOTE: Parses the template on every call, use 'PromptTemplate' when rendering more than once
+inline std::string generatePrompt(const json& model, const std::string& system, const std::string& user, const std::string& assistant)
+{
+    PromptTemplate tmpl;
+    if (tmpl.compile(model, PromptTemplate::Kind::ePrompt) != kResultOk) return {};
+    return tmpl.render(system, user, assistant);
 }
 
 //! TURN HELPER (CHAT/INTERACTIVE MODE)
 //! 
+//! NOTE: Parses the template on every call, use 'PromptTemplate' when rendering more than once
 inline std::string generateTurn(const json& model, const std::string& user, const std::string& assistant)
 {
-    std::string prompt;
-    if (model.contains(kTurnTemplate))
-    {
-        std::vector<std::string> tmpl = model[kTurnTemplate];
-        for (auto& s : tmpl)
-        {
-            if (s == "$user") prompt += user;
-            else if (s == "$assistant") prompt += assistant;
-            else prompt += s;
-        }
-    }
-    else
-    {
-        // Default
-        prompt += "\nInstruct:" + user + "\nOutput:" + assistant;
-    }
-    return prompt;
+    PromptTemplate tmpl;
+    if (tmpl.compile(model, PromptTemplate::Kind::eTurn) != kResultOk) return {};
+    return tmpl.render({}, user, assistant);
 }
 
 }
@@ -0,0 +1,239 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#include "source/utils/nvigi.ai/nvigi_ai.h"
+
+namespace nvigi
+{
+namespace ai
+{
+
+//! Up to two spans into a ring buffer, 'second' is used only when the range wraps around
+template<typename T>
+struct AudioView
+{
+    const T* first{};
+    size_t firstCount{};
+    const T* second{};
+    size_t secondCount{};
+
+    size_t size() const { return firstCount + secondCount; }
+    bool contiguous() const { return secondCount == 0; }
+};
+
+//! Lock-free single producer, single consumer ring buffer for audio samples
+//!
+//! Producer (e.g. microphone callback) calls 'write', consumer (e.g. inference thread) calls 'peek' and 'consume'.
+//! Nothing blocks, when the ring is full 'write' returns how many samples actually fit.
+//!
+//! First 'mirror' samples are duplicated past the end of the ring so any 'peek' up to 'mirror' samples long
+//! is always a single contiguous span which can be handed to an inference data slot as is.
+template<typename T>
+struct AudioRingBuffer
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Audio samples must be trivially copyable");
+
+    //! Capacity is rounded up to a power of two
+    AudioRingBuffer(size_t minCapacity, size_t mirror = 0)
+    {
+        capacity = 1;
+        while (capacity < std::max<size_t>(minCapacity, 1)) capacity <<= 1;
+        mask = capacity - 1;
+        mirrorCount = std::min(mirror, capacity);
+        storage.resize(capacity + mirrorCount);
+    }
+
+    AudioRingBuffer(const AudioRingBuffer&) = delete;
+    AudioRingBuffer& operator=(const AudioRingBuffer&) = delete;
+
+    size_t getCapacity() const { return capacity; }
+
+    //! Samples written but not consumed yet, exact on the consumer thread, lower bound on the producer thread
+    size_t available() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+
+    //! PRODUCER
+    //!
+    //! Returns number of samples written, less than 'count' if the consumer is falling behind
+    size_t write(const T* samples, size_t count)
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t freeCount = capacity - (h - tail.load(std::memory_order_acquire));
+        count = std::min(count, freeCount);
+        size_t offset = h & mask;
+        size_t firstCount = std::min(count, capacity - offset);
+        memcpy(storage.data() + offset, samples, firstCount * sizeof(T));
+        memcpy(storage.data(), samples + firstCount, (count - firstCount) * sizeof(T));
+        // Keep the mirrored tail in sync with the start of the ring
+        if (offset < mirrorCount)
+        {
+            size_t n = std::min(firstCount, mirrorCount - offset);
+            memcpy(storage.data() + capacity + offset, samples, n * sizeof(T));
+        }
+        if (count > firstCount)
+        {
+            size_t n = std::min(count - firstCount, mirrorCount);
+            memcpy(storage.data() + capacity, samples + firstCount, n * sizeof(T));
+        }
+        head.store(h + count, std::memory_order_release);
+        return count;
+    }
+
+    //! CONSUMER
+    //!
+    //! View stays valid until the samples are consumed
+    bool peek(size_t count, AudioView<T>& view) const
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (head.load(std::memory_order_acquire) - t < count) return false;
+        size_t offset = t & mask;
+        view = {};
+        view.first = storage.data() + offset;
+        if (offset + count <= capacity + mirrorCount)
+        {
+            view.firstCount = count;
+        }
+        else
+        {
+            view.firstCount = capacity - offset;
+            view.second = storage.data();
+            view.secondCount = count - view.firstCount;
+        }
+        return true;
+    }
+
+    void consume(size_t count)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        count = std::min(count, head.load(std::memory_order_acquire) - t);
+        tail.store(t + count, std::memory_order_release);
+    }
+
+private:
+    std::vector<T> storage;
+    size_t capacity{};
+    size_t mask{};
+    size_t mirrorCount{};
+    // Monotonic counters, separate cache lines so producer and consumer do not false share
+    alignas(64) std::atomic<size_t> head{};
+    alignas(64) std::atomic<size_t> tail{};
+};
+
+//! Streaming audio chunker, replaces 'A2XAudioProcessor' for live and long inputs
+//!
+//! Produces overlapping windows of 'window' samples every 'hop' samples without holding the whole track
+//! or copying samples per frame, each window points straight into the ring buffer.
+//!
+//! Typical flow:
+//!
+//! StreamingAudioChunker<int16_t> chunker(16000, 8000); // 1s windows, 50% overlap at 16kHz
+//!
+//! // producer thread
+//! chunker.push(samples, count);
+//! ...
+//! chunker.finish(); // no more input, remaining samples are returned as a shorter window
+//!
+//! // consumer thread
+//! InferenceDataAudio slot{};
+//! CpuData data{};
+//! while (chunker.acquire(slot, data))
+//! {
+//!     ... evaluate with 'slot' ...
+//!     chunker.release();
+//! }
+template<typename T>
+struct StreamingAudioChunker
+{
+    static_assert(std::is_same_v<T, int16_t> || std::is_same_v<T, float>, "Supported sample types are PCM16 and FP32");
+
+    //! Capacity defaults to four windows, must be at least one window plus the largest expected 'push'
+    StreamingAudioChunker(size_t _window, size_t _hop, size_t capacity = 0) :
+        window(std::max<size_t>(_window, 1)), hop(std::clamp<size_t>(_hop, 1, std::max<size_t>(_window, 1))),
+        ring(std::max(capacity, 4 * std::max<size_t>(_window, 1)), std::max<size_t>(_window, 1))
+    {
+    }
+
+    //! PRODUCER
+    //!
+    //! Returns number of samples accepted, anything else is dropped (ring full)
+    size_t push(const T* samples, size_t count)
+    {
+        size_t written = ring.write(samples, count);
+        if (written < count) dropped.fetch_add(count - written, std::memory_order_relaxed);
+        return written;
+    }
+
+    //! Marks the end of the stream, samples not covered by any full window are returned as one shorter window
+    void finish()
+    {
+        finished.store(true, std::memory_order_release);
+    }
+
+    //! CONSUMER
+    //!
+    //! Returns false if there is not enough data for a full window yet (or no data left once finished)
+    bool acquire(AudioView<T>& view) const
+    {
+        if (ring.peek(window, view)) return true;
+        if (!finished.load(std::memory_order_acquire)) return false;
+        // Finished, 'available' is exact now since producer is done
+        size_t pending = ring.available();
+        if (pending == 0 || (chunkIndex > 0 && pending + hop <= window)) return false;
+        return ring.peek(pending, view);
+    }
+
+    //! Points 'slot' to the next window, no copies
+    bool acquire(InferenceDataAudio& slot, CpuData& data, int samplingRate = 16000) const
+    {
+        AudioView<T> view{};
+        if (!acquire(view)) return false;
+        data.buffer = view.first;
+        data.sizeInBytes = view.firstCount * sizeof(T);
+        slot.audio = data;
+        slot.samplingRate = samplingRate;
+        slot.channels = 1;
+        slot.bitsPerSample = int(sizeof(T) * 8);
+        slot.dataType = std::is_same_v<T, float> ? AudioDataType::eRawFP32 : AudioDataType::ePCM;
+        return true;
+    }
+
+    //! Advances by 'hop' samples, window obtained from 'acquire' becomes invalid
+    void release()
+    {
+        size_t pending = ring.available();
+        // Last (partial) window consumes everything
+        ring.consume(pending < window ? pending : hop);
+        chunkIndex++;
+    }
+
+    //! True once 'finish' was called and the last window was released
+    bool isDone() const
+    {
+        AudioView<T> view{};
+        return finished.load(std::memory_order_acquire) && !acquire(view);
+    }
+
+    size_t getWindow() const { return window; }
+    size_t getHop() const { return hop; }
+    size_t getChunkIndex() const { return chunkIndex; }
+    size_t getDroppedSampleCount() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    size_t window;
+    size_t hop;
+    size_t chunkIndex{};
+    AudioRingBuffer<T> ring;
+    std::atomic<bool> finished{};
+    std::atomic<size_t> dropped{};
+};
+
+}
+}
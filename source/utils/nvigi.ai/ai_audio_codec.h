@@ -0,0 +1,483 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "source/core/nvigi.log/log.h"
+#include "source/utils/nvigi.ai/nvigi_ai.h"
+
+namespace nvigi
+{
+namespace ai
+{
+
+//! Codec used by 'AudioStreamEncoder' and 'AudioStreamDecoder'
+enum class AudioCodec : uint8_t
+{
+    //! Uncompressed 16-bit, still benefits from resampling and downmixing
+    ePCM16,
+    //! IMA ADPCM, 4 bits per sample (4:1 versus PCM16), negligible CPU cost and no lookahead
+    eADPCM,
+    //! Host provided codec (Opus etc.), see 'AudioCodecCallbacks'
+    eCustom
+};
+
+//! Host provided codec, each call handles exactly one frame
+struct AudioCodecCallbacks
+{
+    //! Encodes 'count' mono samples into at most 'capacity' bytes, returns bytes written or 0 on failure
+    //!
+    //! 'capacity' is derived from 'AudioCodecSettings::bitrate' so it doubles as the bitrate cap (e.g. Opus 'max_data_bytes')
+    size_t (*encode)(const int16_t* pcm, size_t count, uint8_t* dst, size_t capacity, void* userData){};
+    //! Decodes one packet into at most 'capacity' mono samples, returns samples written or 0 on failure
+    size_t (*decode)(const uint8_t* packet, size_t size, int16_t* pcm, size_t capacity, void* userData){};
+    void* userData{};
+};
+
+struct AudioCodecSettings
+{
+    AudioCodec codec = AudioCodec::eADPCM;
+    //! Input is downmixed to mono and resampled to this rate before encoding, zero keeps the input rate.
+    //! Main bitrate control for the built-in codecs, 16kHz is what ASR models use anyway.
+    uint32_t sampleRate = 16000;
+    //! One packet per frame, shorter frames go out sooner at the cost of 4 bytes framing per packet
+    uint32_t frameMs = 20;
+    //! Custom codec only - target bits per second, limits the packet size handed to 'AudioCodecCallbacks::encode'
+    uint32_t bitrate = 24000;
+};
+
+struct AudioCodecStats
+{
+    uint64_t frames{};
+    //! Mono samples after resampling
+    uint64_t samples{};
+    //! Bytes received from the host and bytes produced, framing included
+    uint64_t inputBytes{};
+    uint64_t outputBytes{};
+    //! Time spent encoding (or decoding) one frame
+    double lastFrameUs{};
+    double maxFrameUs{};
+    double totalFrameUs{};
+    //! Latency added by framing, samples wait until their frame is complete
+    double frameLatencyMs{};
+    //! Bits per second of audio actually produced
+    double bitrate{};
+};
+
+//! Stream layout shared by 'AudioStreamEncoder' and 'AudioStreamDecoder'
+//!
+//! 16 byte header: "NVAC", version, codec, 2 reserved bytes, sample rate and samples per frame (little endian uint32)
+//! followed by packets: payload size and sample count (little endian uint16) then the payload.
+//! ADPCM payload: first sample (int16), step index, reserved byte, then two samples per byte, low nibble first.
+namespace audio_codec
+{
+constexpr uint8_t kMagic[4] = { 'N', 'V', 'A', 'C' };
+constexpr uint8_t kVersion = 1;
+constexpr size_t kHeaderSize = 16;
+constexpr size_t kPacketHeaderSize = 4;
+constexpr size_t kMaxFrameSamples = 16384;
+//! Content type for requests carrying an encoded stream
+constexpr const char* kContentType = "audio/x-nvigi-codec";
+
+constexpr int16_t kStepTable[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+    130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060,
+    1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132,
+    7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+constexpr int8_t kIndexTable[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+inline void adpcmStep(uint8_t code, int& predictor, int& index)
+{
+    int step = kStepTable[index];
+    int delta = step >> 3;
+    if (code & 4) delta += step;
+    if (code & 2) delta += step >> 1;
+    if (code & 1) delta += step >> 2;
+    predictor = std::clamp(predictor + ((code & 8) ? -delta : delta), -32768, 32767);
+    index = std::clamp(index + kIndexTable[code], 0, 88);
+}
+
+inline uint8_t adpcmEncodeSample(int sample, int& predictor, int& index)
+{
+    int step = kStepTable[index];
+    int diff = sample - predictor;
+    uint8_t code = 0;
+    if (diff < 0)
+    {
+        code = 8;
+        diff = -diff;
+    }
+    if (diff >= step) { code |= 4; diff -= step; }
+    step >>= 1;
+    if (diff >= step) { code |= 2; diff -= step; }
+    step >>= 1;
+    if (diff >= step) code |= 1;
+    // Decoder's reconstruction, errors do not accumulate
+    adpcmStep(code, predictor, index);
+    return code;
+}
+
+inline void putU16(std::vector<uint8_t>& out, uint16_t v) { out.push_back(uint8_t(v)); out.push_back(uint8_t(v >> 8)); }
+inline void putU32(std::vector<uint8_t>& out, uint32_t v) { putU16(out, uint16_t(v)); putU16(out, uint16_t(v >> 16)); }
+inline uint16_t getU16(const uint8_t* p) { return uint16_t(p[0] | (p[1] << 8)); }
+inline uint32_t getU32(const uint8_t* p) { return getU16(p) | (uint32_t(getU16(p + 2)) << 16); }
+}
+
+//! Incremental encoder for audio uploaded to cloud ASR (or any other audio input sent over 'INet')
+//!
+//! Takes 'InferenceDataAudio' chunks of any size, rate and channel count as they are captured and appends encoded packets
+//! to the output as soon as each frame is complete, so uploads can stream while the player is still talking.
+//! Output starts with the stream header, see 'audio_codec'.
+//!
+//! NOTE: Not thread safe, one encoder per stream
+class AudioStreamEncoder
+{
+public:
+    AudioStreamEncoder(const AudioCodecSettings& settings = {}, const AudioCodecCallbacks& custom = {}) : m_settings(settings), m_custom(custom) {}
+
+    //! PCM16 or FP32 audio in a 'CpuData', returns kResultInvalidParameter for anything else
+    Result write(const InferenceDataAudio& audio, std::vector<uint8_t>& out)
+    {
+        auto data = castTo<CpuData>(audio.audio);
+        if (!data || !data->buffer || audio.channels < 1 || audio.samplingRate <= 0) return kResultInvalidParameter;
+        if (audio.dataType == AudioDataType::eRawFP32 && audio.bitsPerSample == 32)
+        {
+            return write((const float*)data->buffer, data->sizeInBytes / sizeof(float), audio.samplingRate, audio.channels, out);
+        }
+        if (audio.dataType == AudioDataType::ePCM && audio.bitsPerSample == 16)
+        {
+            return write((const int16_t*)data->buffer, data->sizeInBytes / sizeof(int16_t), audio.samplingRate, audio.channels, out);
+        }
+        return kResultInvalidParameter;
+    }
+
+    //! Interleaved samples, 'count' covers all channels. Rate and channel count must not change within a stream.
+    template<typename T>
+    Result write(const T* samples, size_t count, uint32_t sampleRate, uint32_t channels, std::vector<uint8_t>& out)
+    {
+        static_assert(std::is_same_v<T, int16_t> || std::is_same_v<T, float>, "PCM16 or FP32 samples expected");
+        if (!samples || !sampleRate || !channels) return kResultInvalidParameter;
+        if (!m_started)
+        {
+            if (auto res = start(sampleRate, channels, out); res != kResultOk) return res;
+        }
+        else if (sampleRate != m_inputRate || channels != m_channels)
+        {
+            return kResultInvalidParameter;
+        }
+        m_stats.inputBytes += count * sizeof(T);
+
+        // Downmix, then resample straight into the frame
+        size_t frames = count / channels;
+        for (size_t i = 0; i < frames; i++)
+        {
+            float sum = 0.0f;
+            for (uint32_t c = 0; c < channels; c++)
+            {
+                if constexpr (std::is_same_v<T, float>) sum += samples[i * channels + c];
+                else sum += samples[i * channels + c] / 32768.0f;
+            }
+            if (auto res = push(sum / channels, out); res != kResultOk) return res;
+        }
+        return kResultOk;
+    }
+
+    //! Encodes whatever is left as a shorter last frame, the encoder can be reused for a new stream afterwards
+    Result flush(std::vector<uint8_t>& out)
+    {
+        // Output sample falling exactly on the last input sample
+        if (m_hasLast && m_phase <= 0.0)
+        {
+            m_frame.push_back(toPCM16(m_last));
+            m_hasLast = false;
+        }
+        if (!m_frame.empty())
+        {
+            if (auto res = encodeFrame(out); res != kResultOk) return res;
+        }
+        m_started = false;
+        return kResultOk;
+    }
+
+    const AudioCodecStats& getStats() const { return m_stats; }
+
+    //! Output sample rate, valid after the first write
+    uint32_t getSampleRate() const { return m_outputRate; }
+
+private:
+    Result start(uint32_t sampleRate, uint32_t channels, std::vector<uint8_t>& out)
+    {
+        if (m_settings.codec == AudioCodec::eCustom && !m_custom.encode) return kResultInvalidParameter;
+        m_inputRate = sampleRate;
+        m_channels = channels;
+        m_outputRate = m_settings.sampleRate ? m_settings.sampleRate : sampleRate;
+        m_frameSamples = std::clamp<size_t>(size_t(m_outputRate) * std::max(1u, m_settings.frameMs) / 1000, 1, audio_codec::kMaxFrameSamples);
+        m_step = double(m_inputRate) / m_outputRate;
+        m_phase = 0.0;
+        m_hasLast = false;
+        m_frame.clear();
+        m_frame.reserve(m_frameSamples);
+        m_index = 0;
+        m_stats.frameLatencyMs = 1000.0 * m_frameSamples / m_outputRate;
+
+        out.insert(out.end(), std::begin(audio_codec::kMagic), std::end(audio_codec::kMagic));
+        out.push_back(audio_codec::kVersion);
+        out.push_back(uint8_t(m_settings.codec));
+        audio_codec::putU16(out, 0);
+        audio_codec::putU32(out, m_outputRate);
+        audio_codec::putU32(out, uint32_t(m_frameSamples));
+        m_stats.outputBytes += audio_codec::kHeaderSize;
+        m_started = true;
+        return kResultOk;
+    }
+
+    //! Same scale as the input conversion so PCM16 passes through unchanged
+    static int16_t toPCM16(float value)
+    {
+        return int16_t(std::clamp<long>(std::lround(value * 32768.0f), -32768, 32767));
+    }
+
+    //! Linear interpolation between the previous and the current input sample, phase is relative to the previous one
+    Result push(float sample, std::vector<uint8_t>& out)
+    {
+        if (!m_hasLast)
+        {
+            m_last = sample;
+            m_hasLast = true;
+            return kResultOk;
+        }
+        while (m_phase < 1.0)
+        {
+            float value = m_last + float(m_phase) * (sample - m_last);
+            m_frame.push_back(toPCM16(value));
+            m_phase += m_step;
+            if (m_frame.size() == m_frameSamples)
+            {
+                if (auto res = encodeFrame(out); res != kResultOk) return res;
+            }
+        }
+        m_phase -= 1.0;
+        m_last = sample;
+        return kResultOk;
+    }
+
+    Result encodeFrame(std::vector<uint8_t>& out)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto packet = out.size();
+        audio_codec::putU16(out, 0);
+        audio_codec::putU16(out, uint16_t(m_frame.size()));
+        auto payload = out.size();
+        switch (m_settings.codec)
+        {
+        case AudioCodec::ePCM16:
+            for (auto s : m_frame) audio_codec::putU16(out, uint16_t(s));
+            break;
+        case AudioCodec::eADPCM:
+        {
+            int predictor = m_frame[0];
+            audio_codec::putU16(out, uint16_t(m_frame[0]));
+            out.push_back(uint8_t(m_index));
+            out.push_back(0);
+            for (size_t i = 1; i < m_frame.size(); i += 2)
+            {
+                uint8_t lo = audio_codec::adpcmEncodeSample(m_frame[i], predictor, m_index);
+                uint8_t hi = i + 1 < m_frame.size() ? audio_codec::adpcmEncodeSample(m_frame[i + 1], predictor, m_index) : 0;
+                out.push_back(uint8_t(lo | (hi << 4)));
+            }
+            break;
+        }
+        case AudioCodec::eCustom:
+        {
+            size_t capacity = std::clamp<size_t>(size_t(m_settings.bitrate) * m_frameSamples / (8ull * m_outputRate), 1, 0xffff);
+            out.resize(payload + capacity);
+            auto size = m_custom.encode(m_frame.data(), m_frame.size(), out.data() + payload, capacity, m_custom.userData);
+            if (!size || size > capacity)
+            {
+                out.resize(packet);
+                return kResultInvalidState;
+            }
+            out.resize(payload + size);
+            break;
+        }
+        }
+        auto size = out.size() - payload;
+        out[packet] = uint8_t(size);
+        out[packet + 1] = uint8_t(size >> 8);
+
+        auto us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        m_stats.frames++;
+        m_stats.samples += m_frame.size();
+        m_stats.outputBytes += out.size() - packet;
+        m_stats.lastFrameUs = us;
+        m_stats.maxFrameUs = std::max(m_stats.maxFrameUs, us);
+        m_stats.totalFrameUs += us;
+        m_stats.bitrate = m_stats.outputBytes * 8.0 * m_outputRate / m_stats.samples;
+        m_frame.clear();
+        return kResultOk;
+    }
+
+    AudioCodecSettings m_settings{};
+    AudioCodecCallbacks m_custom{};
+    AudioCodecStats m_stats{};
+    bool m_started{};
+    uint32_t m_inputRate{};
+    uint32_t m_channels{};
+    uint32_t m_outputRate{};
+    size_t m_frameSamples{};
+    double m_step{};
+    double m_phase{};
+    float m_last{};
+    bool m_hasLast{};
+    int m_index{};
+    std::vector<int16_t> m_frame;
+};
+
+//! Incremental decoder for encoded audio streamed back from the cloud (TTS) or produced by 'AudioStreamEncoder'
+//!
+//! Bytes can arrive in arbitrary pieces (network chunks), every complete packet is decoded on arrival.
+//! Use 'streamingCallback' with 'INet::nvcfPostStreaming' or 'httpRequestAsync' to decode on the networking thread.
+//!
+//! NOTE: Not thread safe, one decoder per stream
+class AudioStreamDecoder
+{
+public:
+    AudioStreamDecoder(const AudioCodecCallbacks& custom = {}) : m_custom(custom) {}
+
+    //! Receives decoded mono PCM16 when decoding via 'streamingCallback', return false to abort the transfer
+    std::function<bool(const int16_t* pcm, size_t count)> onSamples;
+
+    //! Appends decoded samples to 'pcm', returns kResultInvalidState once the stream is malformed (decoder stops)
+    Result write(const uint8_t* data, size_t size, std::vector<int16_t>& pcm)
+    {
+        if (m_failed) return kResultInvalidState;
+        m_pending.insert(m_pending.end(), data, data + size);
+        m_stats.inputBytes += size;
+        size_t offset = 0;
+        auto res = kResultOk;
+        while (res == kResultOk)
+        {
+            auto available = m_pending.size() - offset;
+            auto p = m_pending.data() + offset;
+            if (!m_sampleRate)
+            {
+                if (available < audio_codec::kHeaderSize) break;
+                res = readHeader(p);
+                offset += audio_codec::kHeaderSize;
+                continue;
+            }
+            if (available < audio_codec::kPacketHeaderSize) break;
+            size_t payload = audio_codec::getU16(p);
+            size_t count = audio_codec::getU16(p + 2);
+            if (available < audio_codec::kPacketHeaderSize + payload) break;
+            res = decodePacket(p + audio_codec::kPacketHeaderSize, payload, count, pcm);
+            offset += audio_codec::kPacketHeaderSize + payload;
+        }
+        m_pending.erase(m_pending.begin(), m_pending.begin() + offset);
+        if (res != kResultOk)
+        {
+            m_failed = true;
+            NVIGI_LOG_ERROR("Malformed encoded audio stream (0x%x)", res);
+            return kResultInvalidState;
+        }
+        return kResultOk;
+    }
+
+    //! 'net::StreamingDataCallback' compatible, 'userData' is the decoder and samples are delivered via 'onSamples'
+    static size_t streamingCallback(const char* data, size_t size, void* userData)
+    {
+        auto decoder = (AudioStreamDecoder*)userData;
+        decoder->m_scratch.clear();
+        if (decoder->write((const uint8_t*)data, size, decoder->m_scratch) != kResultOk) return 0;
+        if (!decoder->m_scratch.empty() && decoder->onSamples && !decoder->onSamples(decoder->m_scratch.data(), decoder->m_scratch.size())) return 0;
+        return size;
+    }
+
+    //! Zero until the stream header arrived
+    uint32_t getSampleRate() const { return m_sampleRate; }
+
+    const AudioCodecStats& getStats() const { return m_stats; }
+
+private:
+    Result readHeader(const uint8_t* p)
+    {
+        if (memcmp(p, audio_codec::kMagic, sizeof(audio_codec::kMagic)) || p[4] != audio_codec::kVersion) return kResultInvalidParameter;
+        if (p[5] > uint8_t(AudioCodec::eCustom)) return kResultInvalidParameter;
+        m_codec = AudioCodec(p[5]);
+        if (m_codec == AudioCodec::eCustom && !m_custom.decode) return kResultInvalidParameter;
+        m_frameSamples = audio_codec::getU32(p + 12);
+        if (!m_frameSamples || m_frameSamples > audio_codec::kMaxFrameSamples) return kResultInvalidParameter;
+        m_sampleRate = audio_codec::getU32(p + 8);
+        if (!m_sampleRate) return kResultInvalidParameter;
+        m_stats.frameLatencyMs = 1000.0 * m_frameSamples / m_sampleRate;
+        return kResultOk;
+    }
+
+    Result decodePacket(const uint8_t* payload, size_t size, size_t count, std::vector<int16_t>& pcm)
+    {
+        if (!count || count > m_frameSamples) return kResultInvalidParameter;
+        auto start = std::chrono::steady_clock::now();
+        auto first = pcm.size();
+        switch (m_codec)
+        {
+        case AudioCodec::ePCM16:
+            if (size != count * sizeof(int16_t)) return kResultInvalidParameter;
+            for (size_t i = 0; i < count; i++) pcm.push_back(int16_t(audio_codec::getU16(payload + i * 2)));
+            break;
+        case AudioCodec::eADPCM:
+        {
+            if (size != 4 + count / 2 || payload[2] > 88) return kResultInvalidParameter;
+            int predictor = int16_t(audio_codec::getU16(payload));
+            int index = payload[2];
+            pcm.push_back(int16_t(predictor));
+            for (size_t i = 1; i < count; i++)
+            {
+                uint8_t byte = payload[4 + (i - 1) / 2];
+                audio_codec::adpcmStep((i - 1) & 1 ? byte >> 4 : byte & 0xf, predictor, index);
+                pcm.push_back(int16_t(predictor));
+            }
+            break;
+        }
+        case AudioCodec::eCustom:
+        {
+            pcm.resize(first + count);
+            auto decoded = m_custom.decode(payload, size, pcm.data() + first, count, m_custom.userData);
+            if (!decoded) return kResultInvalidState;
+            pcm.resize(first + decoded);
+            break;
+        }
+        }
+
+        auto us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        m_stats.frames++;
+        m_stats.samples += pcm.size() - first;
+        m_stats.outputBytes += (pcm.size() - first) * sizeof(int16_t);
+        m_stats.lastFrameUs = us;
+        m_stats.maxFrameUs = std::max(m_stats.maxFrameUs, us);
+        m_stats.totalFrameUs += us;
+        m_stats.bitrate = m_stats.inputBytes * 8.0 * m_sampleRate / m_stats.samples;
+        return kResultOk;
+    }
+
+    AudioCodecCallbacks m_custom{};
+    AudioCodecStats m_stats{};
+    AudioCodec m_codec{};
+    uint32_t m_sampleRate{};
+    size_t m_frameSamples{};
+    bool m_failed{};
+    std::vector<uint8_t> m_pending;
+    std::vector<int16_t> m_scratch;
+};
+
+}
+}
@@ -0,0 +1,561 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "source/core/nvigi.log/log.h"
+#include "source/core/nvigi.extra/extra.h"
+#include "source/utils/nvigi.ai/nvigi_ai.h"
+
+namespace nvigi::ai
+{
+
+//! EVALUATION CAPTURE
+//!
+//! Written by 'ModernPluginBase' when 'EvaluationCaptureParameters' are chained with the creation parameters and read back
+//! by the replay driver in the test host. Little endian, all counts and sizes are LEB128 varints:
+//!
+//! header  : magic, format version, plugin id, model GUID, number of threads, priority class
+//! call    : kind, microseconds since the previous call, number of contexts (batches only), contexts
+//! context : input slots (key, data type, type specific members, CPU bytes), runtime structs (type, version, raw members)
+//!
+
+//! "NVEC" in little endian
+constexpr uint32_t kEvaluationCaptureMagic = 0x4345564e;
+constexpr uint32_t kEvaluationCaptureVersion = 1;
+
+enum class CapturedCallKind : uint8_t
+{
+    eEvaluate,
+    eEvaluateAsync,
+    eEvaluateBatch
+};
+
+//! Runtime parameter captured as raw bytes
+//!
+//! IMPORTANT: Only flat structs qualify, pointer members would be replayed as dangling pointers
+struct CaptureStructDesc
+{
+    UID type;
+    size_t size;
+};
+
+//! Flat runtime parameters any plugin can capture, plugins add their own via 'getCapturedRuntimeParameters'
+inline std::span<const CaptureStructDesc> getCommonCapturedRuntimeParameters()
+{
+    static const CaptureStructDesc s_common[] = { { TextStreamingParameters::s_type, sizeof(TextStreamingParameters) } };
+    return s_common;
+}
+
+namespace capture
+{
+
+inline void putVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(uint8_t(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(uint8_t(value));
+}
+
+inline void putBytes(std::vector<uint8_t>& out, const void* data, size_t size)
+{
+    auto bytes = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+template<typename T>
+inline void putPod(std::vector<uint8_t>& out, const T& value)
+{
+    putBytes(out, &value, sizeof(T));
+}
+
+inline void putString(std::vector<uint8_t>& out, const char* str)
+{
+    size_t len = str ? strlen(str) : 0;
+    putVarint(out, len);
+    putBytes(out, str, len);
+}
+
+//! Size is stored plus one, zero means the data was not captured (GPU resident or missing)
+inline void putBlob(std::vector<uint8_t>& out, const NVIGIParameter* data)
+{
+    auto cpu = castTo<CpuData>(data);
+    if (!cpu || (!cpu->buffer && cpu->sizeInBytes))
+    {
+        putVarint(out, 0);
+        return;
+    }
+    putVarint(out, cpu->sizeInBytes + 1);
+    putBytes(out, cpu->buffer, cpu->sizeInBytes);
+}
+
+//! Flat structs from the chain which are listed in 'structs' as (type, version, raw members), others are skipped
+//!
+//! Zero size marks structs the caller encodes some other way, these are skipped without a warning
+inline void putStructs(std::vector<uint8_t>& out, const NVIGIParameter* chain, std::span<const CaptureStructDesc> structs)
+{
+    std::vector<std::pair<const BaseStructure*, const CaptureStructDesc*>> captured;
+    auto item = (const BaseStructure*)chain;
+    for (uint32_t n = 0; item && n < kMaxNumChainedStructs; item = (const BaseStructure*)item->next, n++)
+    {
+        auto desc = std::find_if(structs.begin(), structs.end(), [item](const CaptureStructDesc& d)->bool { return d.type == item->type; });
+        if (desc == structs.end())
+        {
+            NVIGI_LOG_WARN_ONCE("Parameter '%s' is not captured", extra::guidToString(item->type).c_str());
+        }
+        else if (desc->size >= sizeof(BaseStructure))
+        {
+            captured.push_back({ item, &*desc });
+        }
+    }
+    putVarint(out, captured.size());
+    for (auto& [s, desc] : captured)
+    {
+        putPod(out, s->type);
+        putVarint(out, s->version);
+        putVarint(out, desc->size - sizeof(BaseStructure));
+        putBytes(out, (const uint8_t*)s + sizeof(BaseStructure), desc->size - sizeof(BaseStructure));
+    }
+}
+
+struct Cursor
+{
+    const uint8_t* pos{};
+    const uint8_t* end{};
+    bool ok = true;
+
+    uint64_t varint()
+    {
+        uint64_t value = 0;
+        for (uint32_t shift = 0; shift < 64; shift += 7)
+        {
+            if (pos >= end) break;
+            auto byte = *pos++;
+            value |= uint64_t(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        ok = false;
+        return 0;
+    }
+
+    bool bytes(void* out, size_t size)
+    {
+        if (size_t(end - pos) < size)
+        {
+            ok = false;
+            return false;
+        }
+        memcpy(out, pos, size);
+        pos += size;
+        return true;
+    }
+
+    template<typename T>
+    T pod()
+    {
+        T value{};
+        bytes(&value, sizeof(T));
+        return value;
+    }
+
+    std::string string()
+    {
+        auto len = varint();
+        if (!ok || size_t(end - pos) < len)
+        {
+            ok = false;
+            return {};
+        }
+        std::string str((const char*)pos, len);
+        pos += len;
+        return str;
+    }
+
+    //! Returns false if the blob was not captured
+    bool blob(std::vector<uint8_t>& out)
+    {
+        auto size = varint();
+        if (!ok || size == 0) return false;
+        if (size_t(end - pos) < size - 1)
+        {
+            ok = false;
+            return false;
+        }
+        out.assign(pos, pos + size - 1);
+        pos += size - 1;
+        return true;
+    }
+};
+
+}
+
+//! Records evaluations submitted to one instance, thread safe
+class EvaluationCaptureWriter
+{
+public:
+    EvaluationCaptureWriter() {};
+    EvaluationCaptureWriter(const EvaluationCaptureWriter&) = delete;
+    EvaluationCaptureWriter& operator=(const EvaluationCaptureWriter&) = delete;
+    ~EvaluationCaptureWriter() { close(); }
+
+    Result open(const char* path, const PluginID& feature, const CommonCreationParameters* common, uint64_t maxBytes, std::span<const CaptureStructDesc> runtimeStructs)
+    {
+        close();
+        if (!path || !*path) return kResultInvalidParameter;
+#ifdef NVIGI_WINDOWS
+        fopen_s(&m_file, path, "wb");
+#else
+        m_file = fopen(path, "wb");
+#endif
+        if (!m_file) return kResultIOError;
+
+        m_path = path;
+        m_maxBytes = maxBytes;
+        m_structs.assign(runtimeStructs.begin(), runtimeStructs.end());
+        m_last = std::chrono::steady_clock::now();
+
+        m_buffer.clear();
+        capture::putPod(m_buffer, kEvaluationCaptureMagic);
+        capture::putPod(m_buffer, kEvaluationCaptureVersion);
+        capture::putPod(m_buffer, feature.id);
+        capture::putPod(m_buffer, feature.crc24);
+        capture::putString(m_buffer, common ? common->modelGUID : nullptr);
+        capture::putVarint(m_buffer, common ? (uint64_t)std::max(common->numThreads, 1) : 1);
+        auto priority = common && common->getVersion() >= kStructVersion4 ? common->priorityClass : InferencePriorityClass::eInteractive;
+        capture::putVarint(m_buffer, (uint64_t)priority);
+        return flush() ? kResultOk : kResultIOError;
+    }
+
+    void record(CapturedCallKind kind, InferenceExecutionContext* const* execCtxs, size_t count)
+    {
+        std::scoped_lock lock(m_mtx);
+        if (!m_file) return;
+
+        auto now = std::chrono::steady_clock::now();
+        m_buffer.clear();
+        m_buffer.push_back((uint8_t)kind);
+        capture::putVarint(m_buffer, (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(now - m_last).count());
+        m_last = now;
+        if (kind == CapturedCallKind::eEvaluateBatch) capture::putVarint(m_buffer, count);
+        for (size_t i = 0; i < count; i++)
+        {
+            encodeContext(execCtxs[i]);
+        }
+
+        if (m_written + m_buffer.size() > m_maxBytes)
+        {
+            NVIGI_LOG_WARN("Evaluation capture '%s' reached %llu bytes, recording stopped", m_path.c_str(), (unsigned long long)m_written);
+            closeFile();
+            return;
+        }
+        if (!flush())
+        {
+            NVIGI_LOG_ERROR("Failed to write evaluation capture '%s', recording stopped", m_path.c_str());
+            closeFile();
+        }
+    }
+
+    void close()
+    {
+        std::scoped_lock lock(m_mtx);
+        closeFile();
+    }
+
+private:
+    void closeFile()
+    {
+        if (!m_file) return;
+        fclose(m_file);
+        m_file = nullptr;
+        NVIGI_LOG_INFO("Evaluation capture '%s' closed - %llu bytes", m_path.c_str(), (unsigned long long)m_written);
+    }
+
+    bool flush()
+    {
+        if (fwrite(m_buffer.data(), 1, m_buffer.size(), m_file) != m_buffer.size()) return false;
+        m_written += m_buffer.size();
+        return true;
+    }
+
+    void encodeContext(const InferenceExecutionContext* execCtx)
+    {
+        using namespace capture;
+
+        auto inputs = execCtx ? execCtx->inputs : nullptr;
+        size_t numSlots = 0;
+        for (size_t i = 0; inputs && i < inputs->count; i++)
+        {
+            if (inputs->items[i].data) numSlots++;
+        }
+        putVarint(m_buffer, numSlots);
+        for (size_t i = 0; inputs && i < inputs->count; i++)
+        {
+            auto& slot = inputs->items[i];
+            if (!slot.data) continue;
+            auto type = slot.data->type;
+            putString(m_buffer, slot.key);
+            putPod(m_buffer, type);
+            if (type == InferenceDataText::s_type)
+            {
+                putBlob(m_buffer, castTo<InferenceDataText>(slot.data)->utf8Text);
+            }
+            else if (type == InferenceDataAudio::s_type)
+            {
+                auto audio = castTo<InferenceDataAudio>(slot.data);
+                putVarint(m_buffer, (uint32_t)audio->bitsPerSample);
+                putVarint(m_buffer, (uint32_t)audio->samplingRate);
+                putVarint(m_buffer, (uint32_t)audio->channels);
+                putVarint(m_buffer, audio->dataType);
+                putBlob(m_buffer, audio->audio);
+            }
+            else if (type == InferenceDataByteArray::s_type)
+            {
+                putBlob(m_buffer, castTo<InferenceDataByteArray>(slot.data)->bytes);
+            }
+            else if (type == InferenceDataImage::s_type)
+            {
+                auto image = castTo<InferenceDataImage>(slot.data);
+                putVarint(m_buffer, (uint32_t)image->h);
+                putVarint(m_buffer, (uint32_t)image->w);
+                putVarint(m_buffer, (uint32_t)image->c);
+                putBlob(m_buffer, image->bytes);
+            }
+            else if (type == InferenceDataState::s_type)
+            {
+                auto state = castTo<InferenceDataState>(slot.data);
+                putPod(m_buffer, state->format);
+                putVarint(m_buffer, state->formatVersion);
+                putVarint(m_buffer, state->modelHash);
+                putVarint(m_buffer, state->tokenCount);
+                putBlob(m_buffer, state->blob);
+            }
+            else
+            {
+                NVIGI_LOG_WARN_ONCE("Input slot '%s' has unsupported data type '%s', replayed as missing", slot.key, extra::guidToString(type).c_str());
+            }
+        }
+
+        putStructs(m_buffer, execCtx ? execCtx->runtimeParameters : nullptr, m_structs);
+    }
+
+    std::mutex m_mtx;
+    FILE* m_file{};
+    std::string m_path;
+    uint64_t m_written{};
+    uint64_t m_maxBytes{};
+    std::vector<CaptureStructDesc> m_structs;
+    std::vector<uint8_t> m_buffer;
+    std::chrono::steady_clock::time_point m_last{};
+};
+
+//! Captured execution context, owns everything the NVIGI structures point to
+struct CapturedContext
+{
+    struct Slot
+    {
+        std::string key;
+        std::vector<uint8_t> bytes;
+        CpuData cpu{};
+        InferenceDataText text{};
+        InferenceDataAudio audio{};
+        InferenceDataByteArray byteArray{};
+        InferenceDataImage image{};
+        InferenceDataState state{};
+        //! Streamed results received by 'RemoteInferenceClient', never captured
+        InferenceDataTextView textView{};
+        NVIGIParameter* data{};
+    };
+
+    InferenceDataSlotArray* getInputs() { return &inputs; }
+    NVIGIParameter* getRuntimeParameters() { return runtime.empty() ? nullptr : (NVIGIParameter*)runtime.front().get(); }
+
+    std::vector<std::unique_ptr<Slot>> slots;
+    std::vector<InferenceDataSlot> slotArray;
+    InferenceDataSlotArray inputs{};
+    //! Runtime structs rebuilt from raw members, 8 byte aligned and chained in the recorded order
+    std::vector<std::unique_ptr<uint64_t[]>> runtime;
+};
+
+struct CapturedCall
+{
+    CapturedCallKind kind = CapturedCallKind::eEvaluate;
+    //! Time since the previous call
+    uint64_t delayUs{};
+    std::vector<std::unique_ptr<CapturedContext>> contexts;
+};
+
+struct EvaluationCapture
+{
+    PluginID feature{};
+    std::string modelGUID;
+    int32_t numThreads = 1;
+    InferencePriorityClass priorityClass = InferencePriorityClass::eInteractive;
+    std::vector<CapturedCall> calls;
+};
+
+namespace capture
+{
+
+//! Rebuilds structs written by 'putStructs', 8 byte aligned and chained in the recorded order
+inline bool decodeStructs(Cursor& cursor, std::vector<std::unique_ptr<uint64_t[]>>& structs)
+{
+    auto numStructs = cursor.varint();
+    BaseStructure* prev{};
+    for (uint64_t i = 0; i < numStructs && cursor.ok; i++)
+    {
+        auto type = cursor.pod<UID>();
+        auto version = (uint32_t)cursor.varint();
+        auto size = cursor.varint();
+        if (!cursor.ok || size > size_t(cursor.end - cursor.pos)) return false;
+        auto storage = std::make_unique<uint64_t[]>((sizeof(BaseStructure) + size + 7) / 8);
+        auto base = (BaseStructure*)storage.get();
+        base->type = type;
+        base->version = version;
+        cursor.bytes((uint8_t*)base + sizeof(BaseStructure), size);
+        if (prev) prev->next = base;
+        prev = base;
+        structs.push_back(std::move(storage));
+    }
+    return cursor.ok;
+}
+
+inline bool decodeContext(Cursor& cursor, CapturedContext& ctx)
+{
+    auto numSlots = cursor.varint();
+    for (uint64_t i = 0; i < numSlots && cursor.ok; i++)
+    {
+        auto slot = std::make_unique<CapturedContext::Slot>();
+        slot->key = cursor.string();
+        auto type = cursor.pod<UID>();
+        bool captured = false;
+        size_t recordedSize = 0;
+        if (type == InferenceDataText::s_type)
+        {
+            captured = cursor.blob(slot->bytes);
+            recordedSize = slot->bytes.size();
+            // Plugins expect null terminated text
+            if (captured && (slot->bytes.empty() || slot->bytes.back() != 0)) slot->bytes.push_back(0);
+            slot->text.utf8Text = slot->cpu;
+            slot->data = slot->text;
+        }
+        else if (type == InferenceDataAudio::s_type)
+        {
+            slot->audio.bitsPerSample = (int)cursor.varint();
+            slot->audio.samplingRate = (int)cursor.varint();
+            slot->audio.channels = (int)cursor.varint();
+            slot->audio.dataType = (AudioDataType)cursor.varint();
+            captured = cursor.blob(slot->bytes);
+            slot->audio.audio = slot->cpu;
+            slot->data = slot->audio;
+        }
+        else if (type == InferenceDataByteArray::s_type)
+        {
+            captured = cursor.blob(slot->bytes);
+            slot->byteArray.bytes = slot->cpu;
+            slot->data = slot->byteArray;
+        }
+        else if (type == InferenceDataImage::s_type)
+        {
+            slot->image.h = (int)cursor.varint();
+            slot->image.w = (int)cursor.varint();
+            slot->image.c = (int)cursor.varint();
+            captured = cursor.blob(slot->bytes);
+            slot->image.bytes = slot->cpu;
+            slot->data = slot->image;
+        }
+        else if (type == InferenceDataState::s_type)
+        {
+            slot->state.format = cursor.pod<UID>();
+            slot->state.formatVersion = (uint32_t)cursor.varint();
+            slot->state.modelHash = cursor.varint();
+            slot->state.tokenCount = cursor.varint();
+            captured = cursor.blob(slot->bytes);
+            slot->state.blob = slot->cpu;
+            slot->data = slot->state;
+        }
+        if (!captured) continue;
+        slot->cpu.buffer = slot->bytes.data();
+        // Terminator added above is not part of the recorded size
+        slot->cpu.sizeInBytes = type == InferenceDataText::s_type ? recordedSize : slot->bytes.size();
+        ctx.slots.push_back(std::move(slot));
+    }
+
+    if (!decodeStructs(cursor, ctx.runtime)) return false;
+
+    for (auto& slot : ctx.slots)
+    {
+        ctx.slotArray.push_back(InferenceDataSlot(slot->key.c_str(), slot->data));
+    }
+    ctx.inputs.count = ctx.slotArray.size();
+    ctx.inputs.items = ctx.slotArray.data();
+    return cursor.ok;
+}
+
+}
+
+//! Loads a capture written by 'EvaluationCaptureWriter', truncated captures (process killed while recording) keep all complete calls
+inline Result loadEvaluationCapture(const char* path, EvaluationCapture& capture)
+{
+    if (!path) return kResultInvalidParameter;
+    FILE* file{};
+#ifdef NVIGI_WINDOWS
+    fopen_s(&file, path, "rb");
+#else
+    file = fopen(path, "rb");
+#endif
+    if (!file) return kResultItemNotFound;
+    std::vector<uint8_t> data;
+    uint8_t chunk[64 * 1024];
+    size_t read = 0;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+    {
+        data.insert(data.end(), chunk, chunk + read);
+    }
+    fclose(file);
+
+    capture::Cursor cursor{ data.data(), data.data() + data.size() };
+    if (cursor.pod<uint32_t>() != kEvaluationCaptureMagic || cursor.pod<uint32_t>() != kEvaluationCaptureVersion || !cursor.ok)
+    {
+        return kResultInvalidParameter;
+    }
+    capture.feature.id = cursor.pod<UID>();
+    capture.feature.crc24 = cursor.pod<uint32_t>();
+    capture.modelGUID = cursor.string();
+    capture.numThreads = (int32_t)cursor.varint();
+    capture.priorityClass = (InferencePriorityClass)cursor.varint();
+    if (!cursor.ok) return kResultInvalidParameter;
+
+    capture.calls.clear();
+    while (cursor.pos < cursor.end)
+    {
+        CapturedCall call{};
+        call.kind = (CapturedCallKind)cursor.pod<uint8_t>();
+        call.delayUs = cursor.varint();
+        auto numContexts = call.kind == CapturedCallKind::eEvaluateBatch ? cursor.varint() : 1;
+        for (uint64_t i = 0; i < numContexts && cursor.ok; i++)
+        {
+            auto ctx = std::make_unique<CapturedContext>();
+            if (!capture::decodeContext(cursor, *ctx)) break;
+            call.contexts.push_back(std::move(ctx));
+        }
+        if (!cursor.ok) break;
+        capture.calls.push_back(std::move(call));
+    }
+    return kResultOk;
+}
+
+}
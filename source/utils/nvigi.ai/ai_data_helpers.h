@@ -86,6 +86,28 @@ struct InferenceDataByteArrayHelper
     CpuData _data{};
 };
 
+//! GPU resident data (CudaData, D3D12Data or VulkanData) passed as byte array without any copies
+//!
+//! Fill in the stream/fence/semaphore so the plugin can wait on the GPU instead of the host synchronizing
+template<typename T>
+struct InferenceDataDeviceHelper
+{
+    InferenceDataDeviceHelper(const T& data) : _data(data) {};
+
+    operator InferenceDataByteArray* ()
+    {
+        _slot.bytes = _data;
+        return &_slot;
+    };
+    operator NVIGIParameter* ()
+    {
+        return *(operator InferenceDataByteArray * ());
+    };
+
+    InferenceDataByteArray _slot{};
+    T _data{};
+};
+
 struct InferenceDataAudioHelper
 {
     InferenceDataAudioHelper(const InferenceDataAudio* in) { _input = *in; };
@@ -0,0 +1,622 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "source/core/nvigi.log/log.h"
+#include "source/utils/nvigi.ai/nvigi_ai.h"
+
+namespace nvigi
+{
+namespace ai
+{
+
+//! How results of one stage are handed to the next one
+enum class PipelineForwarding : uint32_t
+{
+    //! Everything the evaluation produced (partial results concatenated) once it is done, e.g. final transcript to LLM
+    eFinal,
+    //! Text only, each complete sentence as soon as it is produced, e.g. LLM to TTS so speech starts on the first sentence
+    eSentence,
+    //! Each partial result as is
+    ePartial
+};
+
+struct PipelineStageDesc
+{
+    InferenceInstance* instance{};
+    //! Used in logs and stats
+    const char* name = "stage";
+    //! OPTIONAL - must stay valid while the pipeline exists
+    NVIGIParameter* runtimeParameters{};
+    //! OPTIONAL - inputs which do not come from a binding (e.g. LLM system prompt), must stay valid while the pipeline exists
+    const InferenceDataSlotArray* constantInputs{};
+};
+
+//! Output slot 'outputSlot' of 'fromStage' becomes input slot 'inputSlot' of 'toStage'
+struct PipelineBinding
+{
+    uint32_t fromStage{};
+    const char* outputSlot{};
+    uint32_t toStage{};
+    const char* inputSlot{};
+    PipelineForwarding forwarding = PipelineForwarding::eFinal;
+};
+
+struct PipelineStageStats
+{
+    std::string name;
+    uint64_t evaluations{};
+    uint64_t failures{};
+    uint32_t pending{};
+    //! Moving averages, time waiting for the stage, from evaluation start to the first result and to the end
+    double queueMs{};
+    double firstResultMs{};
+    double evaluateMs{};
+    //! Moving average, from 'submit' to the first result of this stage, i.e. latency accumulated up to and including this stage
+    double sinceSubmitMs{};
+};
+
+struct PipelineStats
+{
+    uint64_t requests{};
+    //! From 'submit' to the first result of a stage without outgoing bindings, e.g. end of speech to first synthesized audio
+    double firstOutputMs{};
+    double lastFirstOutputMs{};
+    double minFirstOutputMs{};
+    std::vector<PipelineStageStats> stages;
+};
+
+//! Called for every result of every stage, on the thread evaluating that stage
+//!
+//! Outputs are valid only during the call (no copies are made), 'stage' is the index returned by 'addStage'.
+//! Returning kInferenceExecutionStateCancel cancels the evaluation of that stage.
+using PipelineCallback = std::function<InferenceExecutionState(uint32_t stage, const InferenceExecutionContext* execCtx, InferenceExecutionState state)>;
+
+//! Feature pipeline, e.g. ASR -> LLM -> TTS, with results handed between stages without a round trip through the host
+//!
+//! Each stage runs its instance on its own thread with blocking 'evaluate'. Results are forwarded straight from the
+//! plugin's callback into the next stage's queue, so TTS can start on the first LLM sentence while the LLM keeps generating.
+//! Forwarded text, audio and byte arrays are copied once into a buffer owned by the queued evaluation, outputs of
+//! the last stage are passed to the host callback as is.
+//!
+//! Typical flow:
+//!
+//! InferencePipeline pipeline(onResult);
+//! pipeline.addStage({ asrInstance, "asr" }, &asr);
+//! pipeline.addStage({ gptInstance, "gpt", nullptr, &systemPrompt }, &gpt);
+//! pipeline.addStage({ ttsInstance, "tts" }, &tts);
+//! pipeline.bind({ asr, kASRWhisperDataSlotTranscribedText, gpt, kGPTDataSlotUser, PipelineForwarding::eFinal });
+//! pipeline.bind({ gpt, kGPTDataSlotResponse, tts, kTTSDataSlotInputText, PipelineForwarding::eSentence });
+//!
+//! pipeline.submit(asr, &audioSlots); // inputs are copied, can be released right away
+//! ...
+//! pipeline.waitIdle();
+//! auto stats = pipeline.getStats(); // per stage latency and end to end time to first audio
+//!
+//! Each forwarded result starts its own evaluation of the downstream stage, stages with several incoming
+//! bindings are evaluated once per forwarded result. Only CPU resident text, audio and byte arrays can be forwarded.
+//!
+//! IMPORTANT: Instances must stay valid until the pipeline is stopped or destroyed
+class InferencePipeline
+{
+public:
+    InferencePipeline(PipelineCallback callback = {}, double smoothing = 0.2) : m_callback(callback), m_smoothing(smoothing) {}
+    InferencePipeline(const InferencePipeline&) = delete;
+    InferencePipeline& operator=(const InferencePipeline&) = delete;
+
+    ~InferencePipeline()
+    {
+        stop();
+    }
+
+    //! Stages and bindings must be added before the first 'submit'
+    Result addStage(const PipelineStageDesc& desc, uint32_t* index = nullptr)
+    {
+        if (!desc.instance || !desc.instance->evaluate) return kResultInvalidParameter;
+        std::scoped_lock lock(m_mtx);
+        if (m_started) return kResultInvalidState;
+        auto stage = std::make_unique<Stage>();
+        stage->pipeline = this;
+        stage->index = (uint32_t)m_stages.size();
+        stage->desc = desc;
+        stage->name = desc.name ? desc.name : "stage";
+        if (index) *index = stage->index;
+        m_stages.push_back(std::move(stage));
+        return kResultOk;
+    }
+
+    //! Bindings must point forward (fromStage < toStage) so the graph has no cycles
+    Result bind(const PipelineBinding& binding)
+    {
+        if (!binding.outputSlot || !binding.inputSlot) return kResultInvalidParameter;
+        std::scoped_lock lock(m_mtx);
+        if (m_started) return kResultInvalidState;
+        if (binding.fromStage >= binding.toStage || binding.toStage >= m_stages.size()) return kResultInvalidParameter;
+        Binding b{};
+        b.desc = binding;
+        b.outputSlot = binding.outputSlot;
+        b.inputSlot = binding.inputSlot;
+        m_stages[binding.fromStage]->bindings.push_back(std::move(b));
+        return kResultOk;
+    }
+
+    //! Queues an evaluation of 'stage', usually the first one
+    //!
+    //! Inputs are copied so they can be released once this returns, 'streaming' is optional and applies to this
+    //! evaluation only (e.g. start/data/stop signals for streaming ASR).
+    Result submit(uint32_t stage, const InferenceDataSlotArray* inputs, const StreamingParameters* streaming = nullptr)
+    {
+        if (!inputs) return kResultInvalidParameter;
+        auto item = std::make_unique<WorkItem>();
+        item->origin = std::make_shared<Origin>();
+        item->origin->submitted = Clock::now();
+        for (size_t i = 0; i < inputs->count; i++)
+        {
+            auto& slot = inputs->items[i];
+            if (!slot.data) continue;
+            auto owned = std::make_unique<OwnedSlot>();
+            owned->key = slot.key;
+            if (!copySlot(slot.data, *owned))
+            {
+                NVIGI_LOG_ERROR("Pipeline can only submit CPU resident text, audio and byte arrays, slot '%s' is not supported", slot.key);
+                return kResultInvalidParameter;
+            }
+            item->slots.push_back(std::move(owned));
+        }
+        if (streaming)
+        {
+            item->hasStreaming = true;
+            item->streaming.mode = streaming->mode;
+            item->streaming.signal = streaming->signal;
+        }
+
+        std::scoped_lock lock(m_mtx);
+        if (m_stopped || stage >= m_stages.size()) return kResultInvalidState;
+        if (!m_started)
+        {
+            m_started = true;
+            for (auto& s : m_stages) s->worker = std::thread(&InferencePipeline::work, this, s.get());
+        }
+        m_requests++;
+        enqueue(*m_stages[stage], std::move(item));
+        return kResultOk;
+    }
+
+    //! Blocks until every queued evaluation, including the ones forwarded between stages, is done
+    void waitIdle()
+    {
+        std::unique_lock lock(m_mtx);
+        m_cv.wait(lock, [this]()
+        {
+            return m_stopped || std::all_of(m_stages.begin(), m_stages.end(), [](auto& s) { return s->queue.empty() && !s->busy; });
+        });
+    }
+
+    //! Drops queued evaluations and waits for the running ones, the pipeline can not be used afterwards
+    void stop()
+    {
+        {
+            std::scoped_lock lock(m_mtx);
+            if (m_stopped) return;
+            m_stopped = true;
+            for (auto& s : m_stages) s->queue.clear();
+            m_cv.notify_all();
+        }
+        for (auto& s : m_stages)
+        {
+            if (s->worker.joinable()) s->worker.join();
+        }
+    }
+
+    PipelineStats getStats() const
+    {
+        std::scoped_lock lock(m_mtx);
+        PipelineStats stats{};
+        stats.requests = m_requests;
+        stats.firstOutputMs = m_firstOutputMs;
+        stats.lastFirstOutputMs = m_lastFirstOutputMs;
+        stats.minFirstOutputMs = m_minFirstOutputMs;
+        for (auto& s : m_stages)
+        {
+            auto stageStats = s->stats;
+            stageStats.name = s->name;
+            stageStats.pending = uint32_t(s->queue.size() + (s->busy ? 1 : 0));
+            stats.stages.push_back(stageStats);
+        }
+        return stats;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    //! One per 'submit', shared by everything forwarded from it
+    struct Origin
+    {
+        Clock::time_point submitted{};
+        //! Guarded by the pipeline's mutex
+        bool output{};
+    };
+
+    struct OwnedSlot
+    {
+        std::string key;
+        std::vector<uint8_t> bytes;
+        CpuData cpu{};
+        InferenceDataText text{};
+        InferenceDataAudio audio{};
+        InferenceDataByteArray byteArray{};
+        NVIGIParameter* data{};
+    };
+
+    struct WorkItem
+    {
+        std::shared_ptr<Origin> origin;
+        Clock::time_point enqueued{};
+        std::vector<std::unique_ptr<OwnedSlot>> slots;
+        bool hasStreaming{};
+        StreamingParameters streaming{};
+    };
+
+    struct Binding
+    {
+        PipelineBinding desc{};
+        std::string outputSlot;
+        std::string inputSlot;
+        //! Evaluation thread only, data collected for eFinal and eSentence
+        std::string text;
+        std::vector<uint8_t> bytes;
+        InferenceDataAudio audioFormat{};
+        UID type{};
+        bool warned{};
+    };
+
+    struct Stage
+    {
+        InferencePipeline* pipeline{};
+        uint32_t index{};
+        PipelineStageDesc desc{};
+        std::string name;
+        std::vector<Binding> bindings;
+        std::thread worker;
+        //! Guarded by the pipeline's mutex
+        std::deque<std::unique_ptr<WorkItem>> queue;
+        bool busy{};
+        PipelineStageStats stats{};
+        //! Evaluation thread only
+        WorkItem* current{};
+        Clock::time_point started{};
+        bool gotResult{};
+    };
+
+    static bool isTextSlot(const NVIGIParameter* data) { return data && data->type == InferenceDataText::s_type; }
+
+    //! Copies CPU resident text, audio or byte array into 'dst', text is stored with a terminating null
+    static bool copySlot(const NVIGIParameter* data, OwnedSlot& dst)
+    {
+        const NVIGIParameter* payload{};
+        if (auto text = castTo<InferenceDataText>(data)) payload = text->utf8Text;
+        else if (auto audio = castTo<InferenceDataAudio>(data)) payload = audio->audio;
+        else if (auto bytes = castTo<InferenceDataByteArray>(data)) payload = bytes->bytes;
+        auto cpu = castTo<CpuData>(payload);
+        if (!cpu || (!cpu->buffer && cpu->sizeInBytes)) return false;
+        auto begin = (const uint8_t*)cpu->buffer;
+        dst.bytes.assign(begin, begin + cpu->sizeInBytes);
+        if (isTextSlot(data))
+        {
+            return setText(std::string((const char*)dst.bytes.data(), strnlen((const char*)dst.bytes.data(), dst.bytes.size())), dst);
+        }
+        if (auto audio = castTo<InferenceDataAudio>(data))
+        {
+            return setAudio(*audio, dst);
+        }
+        return setBytes(dst);
+    }
+
+    static bool setText(const std::string& text, OwnedSlot& dst)
+    {
+        dst.bytes.assign(text.begin(), text.end());
+        dst.bytes.push_back(0);
+        dst.cpu.buffer = dst.bytes.data();
+        dst.cpu.sizeInBytes = text.size();
+        dst.text.utf8Text = dst.cpu;
+        dst.data = dst.text;
+        return true;
+    }
+
+    static bool setAudio(const InferenceDataAudio& format, OwnedSlot& dst)
+    {
+        dst.cpu.buffer = dst.bytes.data();
+        dst.cpu.sizeInBytes = dst.bytes.size();
+        dst.audio.bitsPerSample = format.bitsPerSample;
+        dst.audio.samplingRate = format.samplingRate;
+        dst.audio.channels = format.channels;
+        dst.audio.dataType = format.dataType;
+        dst.audio.audio = dst.cpu;
+        dst.data = dst.audio;
+        return true;
+    }
+
+    static bool setBytes(OwnedSlot& dst)
+    {
+        dst.cpu.buffer = dst.bytes.data();
+        dst.cpu.sizeInBytes = dst.bytes.size();
+        dst.byteArray.bytes = dst.cpu;
+        dst.data = dst.byteArray;
+        return true;
+    }
+
+    //! Length of the first complete sentence in 'text', 0 if there is none yet
+    //!
+    //! Latin punctuation must be followed by white space so "3.14" or "e.g." split across tokens are not cut
+    static size_t findSentenceEnd(const std::string& text)
+    {
+        for (size_t i = 0; i < text.size(); i++)
+        {
+            char c = text[i];
+            if (c == '\n') return i + 1;
+            if ((c == '.' || c == '!' || c == '?' || c == ';') && i + 1 < text.size() && isspace((unsigned char)text[i + 1])) return i + 1;
+            // CJK full stop, exclamation and question marks (U+3002, U+FF01, U+FF1F), no space follows them
+            if (i + 2 < text.size() && (uint8_t)c == 0xe3 && (uint8_t)text[i + 1] == 0x80 && (uint8_t)text[i + 2] == 0x82) return i + 3;
+            if (i + 2 < text.size() && (uint8_t)c == 0xef && (uint8_t)text[i + 1] == 0xbc && ((uint8_t)text[i + 2] == 0x81 || (uint8_t)text[i + 2] == 0x9f)) return i + 3;
+        }
+        return 0;
+    }
+
+    static const NVIGIParameter* findOutput(const InferenceExecutionContext* execCtx, const std::string& key)
+    {
+        auto outputs = execCtx ? execCtx->outputs : nullptr;
+        for (size_t i = 0; outputs && i < outputs->count; i++)
+        {
+            if (outputs->items[i].data && outputs->items[i].key && key == outputs->items[i].key) return outputs->items[i].data;
+        }
+        return nullptr;
+    }
+
+    static double elapsedMs(Clock::time_point from, Clock::time_point to)
+    {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+
+    void average(double& value, double sample, uint64_t count) const
+    {
+        value = count <= 1 ? sample : value + m_smoothing * (sample - value);
+    }
+
+    //! Caller holds 'm_mtx'
+    void enqueue(Stage& stage, std::unique_ptr<WorkItem> item)
+    {
+        item->enqueued = Clock::now();
+        stage.queue.push_back(std::move(item));
+        m_cv.notify_all();
+    }
+
+    //! Evaluation thread, 'text' or 'bytes' become the only forwarded slot of a new evaluation of the downstream stage
+    void forward(Stage& stage, Binding& binding, const std::string* text, const std::vector<uint8_t>* bytes)
+    {
+        auto item = std::make_unique<WorkItem>();
+        item->origin = stage.current->origin;
+        auto owned = std::make_unique<OwnedSlot>();
+        owned->key = binding.inputSlot;
+        if (text)
+        {
+            setText(*text, *owned);
+        }
+        else
+        {
+            owned->bytes = *bytes;
+            if (binding.type == InferenceDataAudio::s_type) setAudio(binding.audioFormat, *owned);
+            else setBytes(*owned);
+        }
+        item->slots.push_back(std::move(owned));
+        std::scoped_lock lock(m_mtx);
+        if (m_stopped) return;
+        enqueue(*m_stages[binding.desc.toStage], std::move(item));
+    }
+
+    //! Evaluation thread, called for each result of 'stage'
+    void collect(Stage& stage, Binding& binding, const NVIGIParameter* data)
+    {
+        auto isText = isTextSlot(data);
+        if (binding.desc.forwarding == PipelineForwarding::ePartial)
+        {
+            OwnedSlot copy{};
+            if (!copySlot(data, copy)) return warnUnsupported(stage, binding);
+            if (isText)
+            {
+                std::string text((const char*)copy.bytes.data(), copy.cpu.sizeInBytes);
+                if (!text.empty()) forward(stage, binding, &text, nullptr);
+            }
+            else
+            {
+                binding.type = data->type;
+                if (auto audio = castTo<InferenceDataAudio>(data)) binding.audioFormat = *audio;
+                if (!copy.bytes.empty()) forward(stage, binding, nullptr, &copy.bytes);
+            }
+            return;
+        }
+
+        OwnedSlot copy{};
+        if (!copySlot(data, copy)) return warnUnsupported(stage, binding);
+        binding.type = data->type;
+        if (isText)
+        {
+            binding.text.append((const char*)copy.bytes.data(), copy.cpu.sizeInBytes);
+        }
+        else
+        {
+            if (binding.desc.forwarding == PipelineForwarding::eSentence) return warnUnsupported(stage, binding);
+            if (auto audio = castTo<InferenceDataAudio>(data)) binding.audioFormat = *audio;
+            binding.bytes.insert(binding.bytes.end(), copy.bytes.begin(), copy.bytes.end());
+        }
+        if (binding.desc.forwarding == PipelineForwarding::eSentence)
+        {
+            size_t length{};
+            while ((length = findSentenceEnd(binding.text)) != 0)
+            {
+                auto sentence = binding.text.substr(0, length);
+                binding.text.erase(0, length);
+                if (sentence.find_first_not_of(" \t\r\n") != std::string::npos) forward(stage, binding, &sentence, nullptr);
+            }
+        }
+    }
+
+    //! Evaluation thread, whatever was collected for eFinal and the last sentence for eSentence
+    void flush(Stage& stage, bool forwardCollected)
+    {
+        for (auto& binding : stage.bindings)
+        {
+            if (forwardCollected && binding.type == InferenceDataText::s_type && binding.text.find_first_not_of(" \t\r\n") != std::string::npos)
+            {
+                forward(stage, binding, &binding.text, nullptr);
+            }
+            else if (forwardCollected && binding.type != InferenceDataText::s_type && !binding.bytes.empty())
+            {
+                forward(stage, binding, nullptr, &binding.bytes);
+            }
+            binding.text.clear();
+            binding.bytes.clear();
+            binding.type = {};
+        }
+    }
+
+    void warnUnsupported(Stage& stage, Binding& binding)
+    {
+        if (binding.warned) return;
+        binding.warned = true;
+        NVIGI_LOG_WARN("Pipeline stage '%s' output '%s' can not be forwarded, only CPU resident text (any mode), audio and byte arrays (final or partial) are supported",
+            stage.name.c_str(), binding.outputSlot.c_str());
+    }
+
+    static InferenceExecutionState onResult(const InferenceExecutionContext* execCtx, InferenceExecutionState state, void* userData)
+    {
+        auto stage = (Stage*)userData;
+        return stage->pipeline->result(*stage, execCtx, state);
+    }
+
+    InferenceExecutionState result(Stage& stage, const InferenceExecutionContext* execCtx, InferenceExecutionState state)
+    {
+        auto now = Clock::now();
+        if (!stage.gotResult && state != kInferenceExecutionStateInvalid)
+        {
+            stage.gotResult = true;
+            std::scoped_lock lock(m_mtx);
+            auto& stats = stage.stats;
+            average(stats.firstResultMs, elapsedMs(stage.started, now), stats.evaluations + 1);
+            average(stats.sinceSubmitMs, elapsedMs(stage.current->origin->submitted, now), stats.evaluations + 1);
+            if (stage.bindings.empty() && !stage.current->origin->output)
+            {
+                stage.current->origin->output = true;
+                m_outputs++;
+                m_lastFirstOutputMs = elapsedMs(stage.current->origin->submitted, now);
+                m_minFirstOutputMs = m_outputs == 1 ? m_lastFirstOutputMs : std::min(m_minFirstOutputMs, m_lastFirstOutputMs);
+                average(m_firstOutputMs, m_lastFirstOutputMs, m_outputs);
+            }
+        }
+        if (state == kInferenceExecutionStateDataPartial || state == kInferenceExecutionStateDone)
+        {
+            for (auto& binding : stage.bindings)
+            {
+                if (auto data = findOutput(execCtx, binding.outputSlot)) collect(stage, binding, data);
+            }
+        }
+        if (m_callback)
+        {
+            auto hostState = m_callback(stage.index, execCtx, state);
+            if (hostState == kInferenceExecutionStateCancel) return hostState;
+        }
+        return state;
+    }
+
+    void run(Stage& stage, WorkItem& item)
+    {
+        std::vector<InferenceDataSlot> slots;
+        if (stage.desc.constantInputs)
+        {
+            slots.insert(slots.end(), stage.desc.constantInputs->items, stage.desc.constantInputs->items + stage.desc.constantInputs->count);
+        }
+        for (auto& owned : item.slots) slots.push_back(InferenceDataSlot(owned->key.c_str(), owned->data));
+        InferenceDataSlotArray inputs(slots.size(), slots.data());
+
+        InferenceExecutionContext ctx{};
+        ctx.instance = stage.desc.instance;
+        ctx.inputs = &inputs;
+        ctx.callback = onResult;
+        ctx.callbackUserData = &stage;
+        ctx.runtimeParameters = stage.desc.runtimeParameters;
+        if (item.hasStreaming)
+        {
+            // Chained in front so it wins over any 'StreamingParameters' in the stage's own runtime parameters
+            BaseStructure* streaming = item.streaming;
+            streaming->next = stage.desc.runtimeParameters;
+            ctx.runtimeParameters = item.streaming;
+        }
+
+        stage.current = &item;
+        stage.started = Clock::now();
+        stage.gotResult = false;
+        auto result = stage.desc.instance->evaluate(&ctx);
+        auto end = Clock::now();
+        flush(stage, result == kResultOk);
+        stage.current = nullptr;
+
+        std::scoped_lock lock(m_mtx);
+        auto& stats = stage.stats;
+        stats.evaluations++;
+        if (result != kResultOk)
+        {
+            stats.failures++;
+            NVIGI_LOG_WARN("Pipeline stage '%s' evaluation failed (0x%x)", stage.name.c_str(), result);
+        }
+        average(stats.queueMs, elapsedMs(item.enqueued, stage.started), stats.evaluations);
+        average(stats.evaluateMs, elapsedMs(stage.started, end), stats.evaluations);
+    }
+
+    void work(Stage* stage)
+    {
+        std::unique_lock lock(m_mtx);
+        while (true)
+        {
+            m_cv.wait(lock, [this, stage]() { return m_stopped || !stage->queue.empty(); });
+            if (m_stopped) break;
+            auto item = std::move(stage->queue.front());
+            stage->queue.pop_front();
+            stage->busy = true;
+            lock.unlock();
+            run(*stage, *item);
+            lock.lock();
+            stage->busy = false;
+            m_cv.notify_all();
+        }
+    }
+
+    PipelineCallback m_callback;
+    double m_smoothing{};
+    mutable std::mutex m_mtx;
+    std::condition_variable m_cv;
+    std::vector<std::unique_ptr<Stage>> m_stages;
+    bool m_started{};
+    bool m_stopped{};
+    uint64_t m_requests{};
+    uint64_t m_outputs{};
+    double m_firstOutputMs{};
+    double m_lastFirstOutputMs{};
+    double m_minFirstOutputMs{};
+};
+
+}
+}
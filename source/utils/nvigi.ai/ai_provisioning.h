@@ -0,0 +1,632 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "source/core/nvigi.log/log.h"
+#include "source/core/nvigi.extra/extra.h"
+#include "source/core/nvigi.simd/simd.h"
+#include "source/utils/nvigi.ai/ai.h"
+#include "source/plugins/nvigi.net/net.h"
+
+namespace nvigi
+{
+namespace ai
+{
+
+//! CRC-32C of the concatenation of A and B given crc(A), crc(B) and length of B, lets ranges be hashed independently
+//!
+//! Multiplies crc(A) by x^(8 * lengthB) modulo the polynomial, same approach as zlib's crc32_combine
+inline uint32_t crc32cCombine(uint32_t crcA, uint32_t crcB, uint64_t lengthB)
+{
+    constexpr uint32_t kPoly = 0x82f63b78;
+    auto multiply = [](uint32_t a, uint32_t b)->uint32_t
+    {
+        uint32_t m = 1u << 31, p = 0;
+        while (m)
+        {
+            if (a & m) p ^= b;
+            m >>= 1;
+            b = b & 1 ? (b >> 1) ^ kPoly : b >> 1;
+        }
+        return p;
+    };
+    // x^(2^k) for k = 3, 4, ... starting at x^8 (one byte)
+    uint32_t power = 1u << 23;
+    uint32_t shift = 1u << 31;
+    for (; lengthB; lengthB >>= 1)
+    {
+        if (lengthB & 1) shift = multiply(power, shift);
+        power = multiply(power, power);
+    }
+    return multiply(shift, crcA) ^ crcB;
+}
+
+//! Falls back to a bytewise loop when running on a core without 'ISimd::crc32c'
+inline uint32_t crc32c(uint32_t crc, const void* data, size_t size)
+{
+    auto isimd = simd::getInterface();
+    if (isimd && isimd->getVersion() >= kStructVersion2 && isimd->crc32c)
+    {
+        return isimd->crc32c(crc, data, size);
+    }
+    auto bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= bytes[i];
+        for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0x82f63b78 & (0u - (crc & 1)));
+    }
+    return ~crc;
+}
+
+//! One file to provision
+struct ModelFile
+{
+    std::string url;
+    //! Destination, parent directory is created if needed
+    std::u8string path;
+    //! Zero if unknown, file is then fetched as a single stream which cannot be resumed
+    uint64_t size{};
+    //! Expected CRC-32C of the whole file, verified while data streams in
+    std::optional<uint32_t> crc32c;
+};
+
+struct ModelProvisioningProgress
+{
+    uint32_t filesTotal{};
+    uint32_t filesDone{};
+    uint32_t filesFailed{};
+    //! Sum of known file sizes
+    uint64_t bytesTotal{};
+    //! Received over the network in this session, resumed ranges are not counted
+    uint64_t bytesDownloaded{};
+    //! Existing files hashed again, see 'ModelProvisioningParameters::verifyExisting'
+    uint64_t bytesVerified{};
+    double bytesPerSecond{};
+};
+
+struct ModelProvisioningParameters
+{
+    net::INet* inet{};
+    //! Auth, SSL and timeout settings for all transfers, url and data are ignored
+    net::Parameters net{};
+    //! Worker threads, each one runs one transfer or verification at a time
+    uint32_t maxConcurrentTransfers = 4;
+    //! Files of known size are split into byte ranges of this size, downloaded in parallel and resumed per range
+    uint64_t rangeSizeBytes = 32ull << 20;
+    //! Failed ranges are retried (from the start of the range) up to this many times
+    uint32_t maxRetries = 3;
+    //! Existing files with a known checksum are hashed again and downloaded if they do not match, otherwise they are trusted
+    bool verifyExisting = true;
+    //! Called from worker threads, at most every 'progressIntervalMs' and once per completed file
+    std::function<void(const ModelProvisioningProgress&)> onProgress;
+    uint32_t progressIntervalMs = 100;
+};
+
+//! Adds files listed in the model config for each model marked 'requiresDownload' by 'processDirectory'
+//!
+//! Expects "model": { "download": [ { "url": "...", "file": "model.gguf", "size": 123, "crc32c": "1a2b3c4d" } ] }
+//! where "size" and "crc32c" are optional. 'directory' is the one passed to 'processDirectory', files go to {directory}/{guid}/{file}
+inline void collectModelDownloads(const json& modelInfo, const std::u8string& directory, std::vector<ModelFile>& files)
+{
+    for (auto& [guid, model] : modelInfo.items())
+    {
+        if (!model.is_object() || !model.value("requiresDownload", false)) continue;
+        if (!model.contains("model") || !model["model"].contains("download")) continue;
+        try
+        {
+            for (auto& entry : model["model"]["download"])
+            {
+                ModelFile file{};
+                file.url = entry.at("url").get<std::string>();
+                std::string name = entry.at("file");
+                file.path = (fs::path(directory) / std::u8string(guid.begin(), guid.end()) / std::u8string(name.begin(), name.end())).u8string();
+                file.size = entry.value("size", uint64_t(0));
+                if (entry.contains("crc32c"))
+                {
+                    file.crc32c = uint32_t(std::stoul(entry["crc32c"].get<std::string>(), nullptr, 16));
+                }
+                files.push_back(std::move(file));
+            }
+        }
+        catch (std::exception& e)
+        {
+            NVIGI_LOG_ERROR("Invalid download list for model %s - %s", guid.c_str(), e.what());
+        }
+    }
+}
+
+//! Downloads and verifies model files on a set of background workers
+//!
+//! Files of known size are split into byte ranges fetched in parallel over 'INet', data is written in place to
+//! "{path}.partial" and hashed as it arrives. Completed ranges are recorded in "{path}.partial.json" so an interrupted
+//! download resumes where it left off. Once all ranges are in, range checksums are combined, compared with the
+//! expected one and the file is renamed to its final name. Files are never left in place unless verified (or no
+//! checksum was provided).
+//!
+//! 'start' returns immediately so provisioning can run ahead of 'createInstance', host can 'wait' or poll 'getProgress'.
+//!
+//! IMPORTANT: 'inet' must stay loaded until 'wait' returns or the provisioner is destroyed
+class ModelProvisioner
+{
+public:
+    ModelProvisioner(const ModelProvisioningParameters& params) : m_params(params) {}
+    ModelProvisioner(const ModelProvisioner&) = delete;
+    ModelProvisioner& operator=(const ModelProvisioner&) = delete;
+
+    ~ModelProvisioner()
+    {
+        cancel();
+        wait();
+    }
+
+    //! Can only be called once
+    Result start(const std::vector<ModelFile>& files)
+    {
+        if (!m_params.inet || !m_params.inet->httpGetRaw || m_params.inet->getVersion() < kStructVersion3) return kResultInvalidParameter;
+        std::scoped_lock lock(m_mtx);
+        if (!m_workers.empty() || m_started) return kResultInvalidState;
+        m_started = true;
+        m_start = Clock::now();
+        for (auto& desc : files)
+        {
+            auto file = std::make_shared<File>();
+            file->desc = desc;
+            m_progress.filesTotal++;
+            m_progress.bytesTotal += desc.size;
+            m_tasks.push_back({ file, kPrepare });
+        }
+        m_pendingTasks = m_tasks.size();
+        auto count = std::max(1u, m_params.maxConcurrentTransfers);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            m_workers.emplace_back([this]() { workerLoop(); });
+        }
+        return kResultOk;
+    }
+
+    //! Blocks until all files are provisioned or failed, returns first failure
+    Result wait()
+    {
+        {
+            std::unique_lock lock(m_mtx);
+            m_cv.wait(lock, [this]() { return m_pendingTasks == 0; });
+            m_exit = true;
+            m_cv.notify_all();
+        }
+        for (auto& worker : m_workers)
+        {
+            if (worker.joinable()) worker.join();
+        }
+        std::scoped_lock lock(m_mtx);
+        return m_cancelled ? kResultCanceled : m_result;
+    }
+
+    //! Aborts transfers in flight, partial files and completed ranges are kept for the next run
+    void cancel()
+    {
+        m_cancelled = true;
+        m_cv.notify_all();
+    }
+
+    bool isDone() const
+    {
+        std::scoped_lock lock(m_mtx);
+        return m_started && m_pendingTasks == 0;
+    }
+
+    ModelProvisioningProgress getProgress() const
+    {
+        std::scoped_lock lock(m_mtx);
+        auto progress = m_progress;
+        progress.bytesDownloaded = m_bytesDownloaded.load();
+        progress.bytesVerified = m_bytesVerified.load();
+        auto seconds = std::chrono::duration<double>(Clock::now() - m_start).count();
+        progress.bytesPerSecond = seconds > 0.0 ? double(progress.bytesDownloaded) / seconds : 0.0;
+        return progress;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct File
+    {
+        ModelFile desc;
+        std::u8string partialPath;
+        std::u8string sidecarPath;
+        //! Guarded by 'mtx'
+        std::mutex mtx;
+        json sidecar;
+        std::vector<std::optional<uint32_t>> rangeCrcs;
+        size_t rangesLeft{};
+        bool failed{};
+    };
+
+    enum TaskType
+    {
+        kPrepare,
+        kRange,
+    };
+
+    struct Task
+    {
+        std::shared_ptr<File> file;
+        TaskType type{};
+        size_t range{};
+    };
+
+    struct RangeWriter
+    {
+        ModelProvisioner* self{};
+        std::fstream* stream{};
+        uint32_t crc{};
+        uint64_t received{};
+        uint64_t expected{};
+        bool failed{};
+    };
+
+    void workerLoop()
+    {
+        while (true)
+        {
+            Task task;
+            {
+                std::unique_lock lock(m_mtx);
+                m_cv.wait(lock, [this]() { return m_exit || !m_tasks.empty(); });
+                if (m_tasks.empty()) return;
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            if (m_cancelled)
+            {
+                if (task.type == kPrepare) finishFile(task.file, kResultCanceled);
+                else finishRange(task.file, task.range, std::nullopt);
+            }
+            else if (task.type == kPrepare)
+            {
+                prepare(task.file);
+            }
+            else
+            {
+                downloadRange(task.file, task.range);
+            }
+            std::scoped_lock lock(m_mtx);
+            m_pendingTasks--;
+            m_cv.notify_all();
+        }
+    }
+
+    //! New tasks are accounted for before the current one completes so 'wait' never sees zero early
+    void schedule(const std::shared_ptr<File>& file, TaskType type, size_t range = 0)
+    {
+        std::scoped_lock lock(m_mtx);
+        m_tasks.push_back({ file, type, range });
+        m_pendingTasks++;
+        m_cv.notify_all();
+    }
+
+    uint64_t rangeSize() const
+    {
+        return std::max<uint64_t>(m_params.rangeSizeBytes, 1ull << 20);
+    }
+
+    static fs::path toPath(const std::u8string& path)
+    {
+        std::u8string valid;
+        return fs::path(file::getOSValidPath(path, valid) ? valid : path);
+    }
+
+    //! Hashes a file already on disk
+    bool hashFile(const fs::path& path, uint32_t& crc)
+    {
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream) return false;
+        std::vector<char> chunk(4 << 20);
+        crc = 0;
+        while (stream && !m_cancelled)
+        {
+            stream.read(chunk.data(), chunk.size());
+            auto count = size_t(stream.gcount());
+            if (count == 0) break;
+            crc = ai::crc32c(crc, chunk.data(), count);
+            m_bytesVerified += count;
+            reportProgress(false);
+        }
+        return !m_cancelled && stream.eof();
+    }
+
+    void prepare(const std::shared_ptr<File>& file)
+    {
+        auto& desc = file->desc;
+        auto path = toPath(desc.path);
+        std::error_code ec;
+        if (fs::exists(path, ec))
+        {
+            auto size = fs::file_size(path, ec);
+            bool sizeOk = !ec && (!desc.size || size == desc.size);
+            if (sizeOk && (!desc.crc32c || !m_params.verifyExisting))
+            {
+                finishFile(file, kResultOk);
+                return;
+            }
+            uint32_t crc{};
+            if (sizeOk && hashFile(path, crc) && crc == *desc.crc32c)
+            {
+                finishFile(file, kResultOk);
+                return;
+            }
+            if (m_cancelled)
+            {
+                finishFile(file, kResultCanceled);
+                return;
+            }
+            NVIGI_LOG_WARN("Model file '%s' is corrupted or incomplete, downloading again", path.string().c_str());
+            fs::remove(path, ec);
+        }
+
+        file->partialPath = desc.path + u8".partial";
+        file->sidecarPath = desc.path + u8".partial.json";
+        auto partial = toPath(file->partialPath);
+        auto sidecar = toPath(file->sidecarPath);
+        fs::create_directories(path.parent_path(), ec);
+
+        size_t ranges = desc.size ? size_t((desc.size + rangeSize() - 1) / rangeSize()) : 1;
+        file->rangeCrcs.resize(std::max<size_t>(ranges, 1));
+
+        // Completed ranges from a previous run are only trusted if they were made for the same file layout
+        bool resume = false;
+        if (desc.size && fs::exists(partial, ec) && fs::file_size(partial, ec) == desc.size && fs::exists(sidecar, ec))
+        {
+            try
+            {
+                std::ifstream stream(sidecar);
+                json state = json::parse(stream);
+                if (state.value("url", "") == desc.url && state.value("size", uint64_t(0)) == desc.size && state.value("rangeSize", uint64_t(0)) == rangeSize())
+                {
+                    for (auto& [index, crc] : state["ranges"].items())
+                    {
+                        auto i = std::stoull(index);
+                        if (i < file->rangeCrcs.size()) file->rangeCrcs[i] = crc.get<uint32_t>();
+                    }
+                    file->sidecar = state;
+                    resume = true;
+                }
+            }
+            catch (std::exception&)
+            {
+                NVIGI_LOG_WARN("Ignoring invalid download state '%s'", sidecar.string().c_str());
+            }
+        }
+        if (!resume)
+        {
+            fs::remove(sidecar, ec);
+            {
+                std::ofstream create(partial, std::ios::binary | std::ios::trunc);
+                if (!create)
+                {
+                    NVIGI_LOG_ERROR("Unable to create '%s'", partial.string().c_str());
+                    finishFile(file, kResultInvalidState);
+                    return;
+                }
+            }
+            if (desc.size) fs::resize_file(partial, desc.size, ec);
+            file->sidecar = { {"url", desc.url}, {"size", desc.size}, {"rangeSize", rangeSize()}, {"ranges", json::object()} };
+        }
+
+        std::vector<size_t> missing;
+        for (size_t i = 0; i < file->rangeCrcs.size(); i++)
+        {
+            if (!file->rangeCrcs[i]) missing.push_back(i);
+        }
+        if (resume)
+        {
+            NVIGI_LOG_INFO("Resuming '%s', %zu out of %zu range(s) left", path.string().c_str(), missing.size(), file->rangeCrcs.size());
+        }
+        file->rangesLeft = missing.size();
+        if (missing.empty())
+        {
+            completeFile(file);
+            return;
+        }
+        for (auto i : missing) schedule(file, kRange, i);
+    }
+
+    static bool onChunk(const uint8_t* data, size_t size, void* userData)
+    {
+        auto writer = static_cast<RangeWriter*>(userData);
+        if (writer->self->m_cancelled) return false;
+        if (writer->expected && writer->received + size > writer->expected)
+        {
+            // Server ignored the range request
+            writer->failed = true;
+            return false;
+        }
+        writer->stream->write(reinterpret_cast<const char*>(data), size);
+        if (!*writer->stream)
+        {
+            writer->failed = true;
+            return false;
+        }
+        writer->crc = ai::crc32c(writer->crc, data, size);
+        writer->received += size;
+        writer->self->m_bytesDownloaded += size;
+        writer->self->reportProgress(false);
+        return true;
+    }
+
+    void downloadRange(const std::shared_ptr<File>& file, size_t range)
+    {
+        {
+            std::scoped_lock lock(file->mtx);
+            if (file->failed)
+            {
+                finishRange(file, range, std::nullopt);
+                return;
+            }
+        }
+        auto& desc = file->desc;
+        uint64_t offset = range * rangeSize();
+        uint64_t length = desc.size ? std::min(rangeSize(), desc.size - offset) : 0;
+
+        net::Parameters params = m_params.net;
+        params.url = desc.url.c_str();
+        params.data = {};
+        params.enableStatusPolling = false;
+        params.maxResponseSizeBytes = length;
+        if (length)
+        {
+            params.headers.push_back(extra::format("Range: bytes={}-{}", offset, offset + length - 1).c_str());
+        }
+        params.cancelCallback = [](void* userData)->bool { return static_cast<ModelProvisioner*>(userData)->m_cancelled.load(std::memory_order_relaxed); };
+        params.cancelUserData = this;
+
+        auto mode = desc.size ? std::ios::in | std::ios::out | std::ios::binary : std::ios::out | std::ios::binary | std::ios::trunc;
+        for (uint32_t attempt = 0; attempt <= m_params.maxRetries && !m_cancelled; attempt++)
+        {
+            std::fstream stream(toPath(file->partialPath), mode);
+            stream.seekp(std::streamoff(offset));
+            if (!stream)
+            {
+                NVIGI_LOG_ERROR("Unable to open '%s' for writing", toPath(file->partialPath).string().c_str());
+                break;
+            }
+            RangeWriter writer{ this, &stream, 0, 0, length, false };
+            net::ResponseSink sink{};
+            sink.chunkCallback = onChunk;
+            sink.chunkUserData = &writer;
+            params._base.next = nullptr;
+            params.chain(sink);
+
+            types::vector<uint8_t> unused;
+            auto res = m_params.inet->httpGetRaw(params, unused);
+            stream.flush();
+            bool complete = res == kResultOk && !writer.failed && stream && (!length || writer.received == length);
+            stream.close();
+            if (complete)
+            {
+                finishRange(file, range, writer.crc);
+                return;
+            }
+            // Range is fetched again from its start
+            m_bytesDownloaded -= writer.received;
+            if (res == net::kResultNetCanceled || m_cancelled) break;
+            NVIGI_LOG_WARN("Range %zu of '%s' failed (0x%x, %llu out of %llu bytes), attempt %u out of %u", range, desc.url.c_str(), res,
+                writer.received, length, attempt + 1, m_params.maxRetries + 1);
+        }
+        finishRange(file, range, std::nullopt);
+    }
+
+    void finishRange(const std::shared_ptr<File>& file, size_t range, std::optional<uint32_t> crc)
+    {
+        bool last{};
+        {
+            std::scoped_lock lock(file->mtx);
+            if (crc)
+            {
+                file->rangeCrcs[range] = crc;
+                if (file->desc.size)
+                {
+                    // Data is flushed already, a crash from here on only costs this range
+                    file->sidecar["ranges"][std::to_string(range)] = *crc;
+                    std::ofstream(toPath(file->sidecarPath), std::ios::trunc) << file->sidecar.dump();
+                }
+            }
+            else
+            {
+                file->failed = true;
+            }
+            last = --file->rangesLeft == 0;
+        }
+        if (last)
+        {
+            if (file->failed) finishFile(file, m_cancelled ? kResultCanceled : kResultInvalidState);
+            else completeFile(file);
+        }
+    }
+
+    void completeFile(const std::shared_ptr<File>& file)
+    {
+        auto& desc = file->desc;
+        uint32_t crc = *file->rangeCrcs.front();
+        for (size_t i = 1; i < file->rangeCrcs.size(); i++)
+        {
+            uint64_t length = std::min(rangeSize(), desc.size - i * rangeSize());
+            crc = crc32cCombine(crc, *file->rangeCrcs[i], length);
+        }
+        std::error_code ec;
+        auto partial = toPath(file->partialPath);
+        if (desc.crc32c && crc != *desc.crc32c)
+        {
+            NVIGI_LOG_ERROR("Checksum mismatch for '%s', expected %08x got %08x", desc.url.c_str(), *desc.crc32c, crc);
+            // Nothing worth resuming
+            fs::remove(partial, ec);
+            fs::remove(toPath(file->sidecarPath), ec);
+            finishFile(file, kResultInvalidState);
+            return;
+        }
+        fs::rename(partial, toPath(desc.path), ec);
+        if (ec)
+        {
+            NVIGI_LOG_ERROR("Unable to move '%s' in place - %s", partial.string().c_str(), ec.message().c_str());
+            finishFile(file, kResultInvalidState);
+            return;
+        }
+        fs::remove(toPath(file->sidecarPath), ec);
+        NVIGI_LOG_INFO("Provisioned '%s'", toPath(desc.path).string().c_str());
+        finishFile(file, kResultOk);
+    }
+
+    void finishFile(const std::shared_ptr<File>&, Result result)
+    {
+        {
+            std::scoped_lock lock(m_mtx);
+            if (result == kResultOk) m_progress.filesDone++;
+            else m_progress.filesFailed++;
+            if (m_result == kResultOk) m_result = result;
+        }
+        reportProgress(true);
+    }
+
+    void reportProgress(bool force)
+    {
+        if (!m_params.onProgress) return;
+        auto now = uint64_t(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - m_start).count());
+        auto last = m_lastReportMs.load();
+        if (force) m_lastReportMs = now;
+        else if (now < last + m_params.progressIntervalMs || !m_lastReportMs.compare_exchange_strong(last, now)) return;
+        m_params.onProgress(getProgress());
+    }
+
+    ModelProvisioningParameters m_params{};
+    mutable std::mutex m_mtx;
+    std::condition_variable m_cv;
+    std::deque<Task> m_tasks;
+    std::vector<std::thread> m_workers;
+    size_t m_pendingTasks{};
+    bool m_started{};
+    bool m_exit{};
+    Result m_result = kResultOk;
+    ModelProvisioningProgress m_progress{};
+    Clock::time_point m_start{};
+    std::atomic<bool> m_cancelled{};
+    std::atomic<uint64_t> m_bytesDownloaded{};
+    std::atomic<uint64_t> m_bytesVerified{};
+    std::atomic<uint64_t> m_lastReportMs{};
+};
+
+}
+}
@@ -0,0 +1,1096 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "source/core/nvigi.log/log.h"
+#include "source/utils/nvigi.ai/nvigi_ai.h"
+#include "source/utils/nvigi.ai/ai_capture.h"
+#include "source/utils/nvigi.ipc/ipc.h"
+
+namespace nvigi
+{
+namespace ai
+{
+
+//! OUT OF PROCESS INFERENCE
+//!
+//! 'RemoteInferenceServer' runs in a helper process (see source/tools/host) which loads the plugins, 'RemoteInferenceClient'
+//! runs in the game or server process and hands out regular 'InferenceInstance's which forward every call to the host.
+//! A backend crash takes down the host only, pending evaluations fail with 'kInferenceExecutionStateInvalid' and the
+//! client process keeps running. One host serves any number of client processes.
+//!
+//! Each client has its own shared memory channel (see ipc.h). Control messages go through small rings and slot data is
+//! copied once into a shared arena, the other side reads it in place (inputs on the host, outputs on the client) so nothing
+//! is serialized. Requests are encoded the same way as evaluation captures (see ai_capture.h).
+//!
+//! Limitations:
+//!
+//! * Only CPU resident slots (CpuData) are supported, D3D12 and CUDA resources are rejected with kResultInvalidParameter
+//! * Only flat creation and runtime parameters are forwarded, see 'RemoteInferenceClientParameters'
+//! * Outputs are always allocated by the plugin, read them via the execution context provided to the callback
+//! * Polled results are not supported, 'evaluateAsync' requires a callback
+namespace remote
+{
+
+enum class MessageType : uint8_t
+{
+    // Client to host
+    eCreateInstance,
+    eEvaluate,
+    eCancel,
+    eDestroyInstance,
+    // Host to client
+    eInstanceCreated,
+    eCallback,
+    eResult
+};
+
+inline void putHeader(std::vector<uint8_t>& out, MessageType type, uint64_t requestId)
+{
+    out.clear();
+    out.push_back((uint8_t)type);
+    capture::putVarint(out, requestId);
+}
+
+//! Copies CPU data of each slot into the outgoing arena, offsets are added to 'blocks' so the caller can discard them on failure
+inline Result putSlots(ipc::Channel& channel, std::vector<uint8_t>& out, const InferenceDataSlotArray* slots, std::vector<uint64_t>& blocks, uint32_t timeoutMs)
+{
+    using namespace capture;
+
+    size_t numSlots = 0;
+    for (size_t i = 0; slots && i < slots->count; i++)
+    {
+        if (slots->items[i].data) numSlots++;
+    }
+    putVarint(out, numSlots);
+    for (size_t i = 0; slots && i < slots->count; i++)
+    {
+        auto& slot = slots->items[i];
+        if (!slot.data) continue;
+        auto type = slot.data->type;
+        putString(out, slot.key);
+        putPod(out, type);
+
+        const void* payload{};
+        size_t size{};
+        const NVIGIParameter* data{};
+        if (type == InferenceDataText::s_type)
+        {
+            data = castTo<InferenceDataText>(slot.data)->utf8Text;
+        }
+        else if (type == InferenceDataTextView::s_type)
+        {
+            auto view = castTo<InferenceDataTextView>(slot.data);
+            putVarint(out, view->streamOffset);
+            putVarint(out, view->tokenCount);
+            payload = view->utf8Text;
+            size = view->length;
+        }
+        else if (type == InferenceDataAudio::s_type)
+        {
+            auto audio = castTo<InferenceDataAudio>(slot.data);
+            putVarint(out, (uint32_t)audio->bitsPerSample);
+            putVarint(out, (uint32_t)audio->samplingRate);
+            putVarint(out, (uint32_t)audio->channels);
+            putVarint(out, audio->dataType);
+            data = audio->audio;
+        }
+        else if (type == InferenceDataByteArray::s_type)
+        {
+            data = castTo<InferenceDataByteArray>(slot.data)->bytes;
+        }
+        else if (type == InferenceDataImage::s_type)
+        {
+            auto image = castTo<InferenceDataImage>(slot.data);
+            putVarint(out, (uint32_t)image->h);
+            putVarint(out, (uint32_t)image->w);
+            putVarint(out, (uint32_t)image->c);
+            data = image->bytes;
+        }
+        else if (type == InferenceDataState::s_type)
+        {
+            auto state = castTo<InferenceDataState>(slot.data);
+            putPod(out, state->format);
+            putVarint(out, state->formatVersion);
+            putVarint(out, state->modelHash);
+            putVarint(out, state->tokenCount);
+            data = state->blob;
+        }
+        else
+        {
+            NVIGI_LOG_ERROR("Slot '%s' has data type '%s' which cannot be sent to another process", slot.key, extra::guidToString(type).c_str());
+            return kResultInvalidParameter;
+        }
+        if (data)
+        {
+            auto cpu = castTo<CpuData>(data);
+            if (!cpu)
+            {
+                NVIGI_LOG_ERROR("Slot '%s' is not CPU resident, only CpuData can be sent to another process", slot.key);
+                return kResultInvalidParameter;
+            }
+            payload = cpu->buffer;
+            size = cpu->buffer ? cpu->sizeInBytes : 0;
+        }
+
+        // Size plus one, zero means no data
+        if (!payload)
+        {
+            putVarint(out, 0);
+            continue;
+        }
+        // Plugins expect null terminated text
+        bool text = type == InferenceDataText::s_type;
+        uint8_t* ptr{};
+        uint64_t offset{};
+        if (NVIGI_FAILED(result, channel.allocate(size + (text ? 1 : 0), &ptr, &offset, timeoutMs)))
+        {
+            NVIGI_LOG_ERROR("Failed to allocate %llu bytes for slot '%s' in shared memory (0x%x)", (unsigned long long)size, slot.key, result);
+            return result;
+        }
+        blocks.push_back(offset);
+        memcpy(ptr, payload, size);
+        if (text) ptr[size] = 0;
+        putVarint(out, size + 1);
+        putVarint(out, offset);
+    }
+    return kResultOk;
+}
+
+//! Slots written by 'putSlots', data points straight into the incoming arena until 'blocks' are released
+inline bool getSlots(capture::Cursor& cursor, ipc::Channel& channel, CapturedContext& ctx, std::vector<uint64_t>& blocks)
+{
+    auto numSlots = cursor.varint();
+    for (uint64_t i = 0; i < numSlots && cursor.ok; i++)
+    {
+        auto slot = std::make_unique<CapturedContext::Slot>();
+        slot->key = cursor.string();
+        auto type = cursor.pod<UID>();
+        if (type == InferenceDataText::s_type)
+        {
+            slot->text.utf8Text = slot->cpu;
+            slot->data = slot->text;
+        }
+        else if (type == InferenceDataTextView::s_type)
+        {
+            slot->textView.streamOffset = cursor.varint();
+            slot->textView.tokenCount = (uint32_t)cursor.varint();
+            slot->data = slot->textView;
+        }
+        else if (type == InferenceDataAudio::s_type)
+        {
+            slot->audio.bitsPerSample = (int)cursor.varint();
+            slot->audio.samplingRate = (int)cursor.varint();
+            slot->audio.channels = (int)cursor.varint();
+            slot->audio.dataType = (AudioDataType)cursor.varint();
+            slot->audio.audio = slot->cpu;
+            slot->data = slot->audio;
+        }
+        else if (type == InferenceDataByteArray::s_type)
+        {
+            slot->byteArray.bytes = slot->cpu;
+            slot->data = slot->byteArray;
+        }
+        else if (type == InferenceDataImage::s_type)
+        {
+            slot->image.h = (int)cursor.varint();
+            slot->image.w = (int)cursor.varint();
+            slot->image.c = (int)cursor.varint();
+            slot->image.bytes = slot->cpu;
+            slot->data = slot->image;
+        }
+        else if (type == InferenceDataState::s_type)
+        {
+            slot->state.format = cursor.pod<UID>();
+            slot->state.formatVersion = (uint32_t)cursor.varint();
+            slot->state.modelHash = cursor.varint();
+            slot->state.tokenCount = cursor.varint();
+            slot->state.blob = slot->cpu;
+            slot->data = slot->state;
+        }
+        else
+        {
+            return false;
+        }
+
+        auto size = cursor.varint();
+        if (size)
+        {
+            size--;
+            auto offset = cursor.varint();
+            bool text = type == InferenceDataText::s_type;
+            auto ptr = cursor.ok ? channel.resolve(offset, size + (text ? 1 : 0)) : nullptr;
+            if (!ptr) return false;
+            blocks.push_back(offset);
+            slot->cpu.buffer = ptr;
+            slot->cpu.sizeInBytes = size;
+            slot->textView.utf8Text = (const char*)ptr;
+            slot->textView.length = size;
+        }
+        ctx.slots.push_back(std::move(slot));
+    }
+    for (auto& slot : ctx.slots)
+    {
+        ctx.slotArray.push_back(InferenceDataSlot(slot->key.c_str(), slot->data));
+    }
+    ctx.inputs.count = ctx.slotArray.size();
+    ctx.inputs.items = ctx.slotArray.data();
+    return cursor.ok;
+}
+
+inline void putSignature(std::vector<uint8_t>& out, const InferenceDataDescriptorArray* signature)
+{
+    capture::putVarint(out, signature ? signature->count : 0);
+    for (size_t i = 0; signature && i < signature->count; i++)
+    {
+        auto& item = signature->items[i];
+        capture::putString(out, item.key);
+        capture::putPod(out, item.dataType);
+        out.push_back(item.optional ? 1 : 0);
+        capture::putVarint(out, (uint32_t)item.dataAllocator);
+    }
+}
+
+struct Signature
+{
+    std::deque<std::string> keys;
+    std::vector<InferenceDataDescriptor> items;
+    InferenceDataDescriptorArray array{};
+
+    void decode(capture::Cursor& cursor)
+    {
+        auto count = cursor.varint();
+        for (uint64_t i = 0; i < count && cursor.ok; i++)
+        {
+            keys.push_back(cursor.string());
+            auto dataType = cursor.pod<UID>();
+            auto optional = cursor.pod<uint8_t>() != 0;
+            InferenceDataDescriptor item(keys.back().c_str(), dataType, optional);
+            item.dataAllocator = (InferenceDataAllocator)cursor.varint();
+            items.push_back(item);
+        }
+        array.count = items.size();
+        array.items = items.data();
+    }
+};
+
+inline bool isTerminal(InferenceExecutionState state)
+{
+    return state == kInferenceExecutionStateDone || state == kInferenceExecutionStateCancel || state == kInferenceExecutionStateInvalid;
+}
+
+}
+
+struct RemoteInferenceClientParameters
+{
+    //! Name served by the host, see 'RemoteInferenceServer::listen'
+    const char* service = "inference.host";
+    //! Optional - host executable to start if nobody serves 'service' yet, launched with "--service <service>" followed by 'hostArguments'
+    const char* utf8PathToHost{};
+    std::vector<std::string> hostArguments;
+    //! Control messages in flight, per direction
+    size_t ringSize = 1 << 20;
+    //! Slot data in flight, per direction, the largest input or output must fit
+    size_t arenaSize = 32 << 20;
+    //! Includes starting the host
+    uint32_t connectTimeoutMs = 10000;
+    //! Limit for instance creation (model loading), destruction and cancellation, evaluations are not limited
+    uint32_t requestTimeoutMs = 120000;
+    //! Flat plugin specific structs forwarded with the creation parameters, 'CommonCreationParameters' are always forwarded
+    std::vector<CaptureStructDesc> creationStructs;
+    //! Flat plugin specific structs forwarded with the runtime parameters in addition to 'getCommonCapturedRuntimeParameters' and 'StreamingParameters'
+    std::vector<CaptureStructDesc> runtimeStructs;
+};
+
+//! Game or server side of the out of process host
+//!
+//! Instances behave like local ones: 'evaluate' blocks and runs the callbacks on the calling thread, 'evaluateAsync'
+//! returns immediately and runs the callbacks on the client's receiving thread. Outputs provided to callbacks live in
+//! shared memory and are valid until the callback returns.
+//!
+//! Asynchronous evaluations are queued on the host, one evaluation per instance runs at a time.
+//!
+//! IMPORTANT: All instances must be destroyed before the client
+class RemoteInferenceClient
+{
+public:
+    RemoteInferenceClient() {};
+    RemoteInferenceClient(const RemoteInferenceClient&) = delete;
+    RemoteInferenceClient& operator=(const RemoteInferenceClient&) = delete;
+    ~RemoteInferenceClient() { disconnect(); }
+
+    Result connect(const RemoteInferenceClientParameters& params)
+    {
+        if (!params.service || !*params.service) return kResultInvalidParameter;
+        disconnect();
+        m_params = params;
+        m_creationStructs = { { CommonCreationParameters::s_type, 0 } };
+        m_creationStructs.insert(m_creationStructs.end(), params.creationStructs.begin(), params.creationStructs.end());
+        auto common = getCommonCapturedRuntimeParameters();
+        m_runtimeStructs.assign(common.begin(), common.end());
+        m_runtimeStructs.push_back({ StreamingParameters::s_type, sizeof(StreamingParameters) });
+        m_runtimeStructs.insert(m_runtimeStructs.end(), params.runtimeStructs.begin(), params.runtimeStructs.end());
+
+        static std::atomic<uint32_t> s_counter{};
+        auto name = extra::format("{}.{}.{}", params.service, ipc::getProcessId(), s_counter++);
+        if (NVIGI_FAILED(result, m_channel.create(name.c_str(), params.ringSize, params.arenaSize))) return result;
+
+        using Clock = std::chrono::steady_clock;
+        auto deadline = Clock::now() + std::chrono::milliseconds(params.connectTimeoutMs);
+        bool launched = false;
+        auto result = ipc::ServiceEndpoint::post(params.service, name.c_str());
+        while (result != kResultOk && Clock::now() < deadline)
+        {
+            if (!launched && params.utf8PathToHost)
+            {
+                std::vector<std::string> args = { "--service", params.service };
+                args.insert(args.end(), params.hostArguments.begin(), params.hostArguments.end());
+                if (NVIGI_FAILED(launchResult, ipc::launchProcess(params.utf8PathToHost, args))) break;
+                launched = true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            result = ipc::ServiceEndpoint::post(params.service, name.c_str());
+        }
+        while (result == kResultOk && !m_channel.getHeader()->hostPid.load(std::memory_order_acquire))
+        {
+            if (Clock::now() >= deadline) result = kResultTimedOut;
+            else std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (result != kResultOk)
+        {
+            NVIGI_LOG_ERROR("Failed to connect to inference host '%s' (0x%x)", params.service, result);
+            m_channel.close();
+            return result;
+        }
+
+        NVIGI_LOG_INFO("Connected to inference host '%s' (pid %u)", params.service, m_channel.getPeerPid());
+        m_connected = true;
+        m_stop = false;
+        m_receiver = std::thread([this]() { receive(); });
+        return kResultOk;
+    }
+
+    //! Pending requests fail with kResultInvalidState, the host releases everything this client created
+    void disconnect()
+    {
+        if (!m_receiver.joinable()) return;
+        m_stop = true;
+        m_channel.wakeReceiver();
+        m_receiver.join();
+        failAll();
+        m_channel.close();
+        std::scoped_lock lock(m_mtx);
+        if (!m_instances.empty()) NVIGI_LOG_WARN("Disconnecting from inference host with %llu instance(s) still alive", (unsigned long long)m_instances.size());
+        m_instances.clear();
+    }
+
+    //! False once the host went away
+    bool isConnected() const { return m_connected; }
+
+    //! Creates an instance of 'feature' in the host, 'params' must contain 'CommonCreationParameters'
+    Result createInstance(const PluginID& feature, const NVIGIParameter* params, InferenceInstance** instance)
+    {
+        auto common = findStruct<CommonCreationParameters>(params);
+        if (!instance || !common) return kResultInvalidParameter;
+        if (!m_connected) return kResultInvalidState;
+
+        using namespace capture;
+        auto request = std::make_shared<Request>();
+        std::vector<uint8_t> message;
+        remote::putHeader(message, remote::MessageType::eCreateInstance, request->id = m_nextId++);
+        putPod(message, feature.id);
+        putPod(message, feature.crc24);
+        putVarint(message, (uint64_t)std::max(common->numThreads, 1));
+        putVarint(message, common->vramBudgetMB);
+        putString(message, common->modelGUID);
+        putString(message, common->utf8PathToModels);
+        putString(message, common->utf8PathToAdditionalModels);
+        putString(message, common->getVersion() >= kStructVersion2 ? common->modelCardJSON : nullptr);
+        putVarint(message, common->getVersion() >= kStructVersion3 ? common->maxBatchSize : 0);
+        putVarint(message, common->getVersion() >= kStructVersion3 ? common->batchWindowUs : 0);
+        putVarint(message, common->getVersion() >= kStructVersion4 ? (uint64_t)common->priorityClass : (uint64_t)InferencePriorityClass::eInteractive);
+        putStructs(message, params, m_creationStructs);
+
+        if (NVIGI_FAILED(result, call(request, message, m_params.requestTimeoutMs))) return result;
+        if (request->result != kResultOk) return request->result;
+
+        Cursor cursor{ request->reply.data(), request->reply.data() + request->reply.size() };
+        auto remoteInstance = std::make_unique<RemoteInstance>();
+        remoteInstance->client = this;
+        remoteInstance->id = cursor.varint();
+        remoteInstance->feature.id = cursor.pod<UID>();
+        remoteInstance->feature.crc24 = cursor.pod<uint32_t>();
+        remoteInstance->inputs.decode(cursor);
+        remoteInstance->outputs.decode(cursor);
+        if (!cursor.ok) return kResultInvalidState;
+
+        auto& api = remoteInstance->api;
+        api._base.version = kStructVersion3;
+        api.data = remoteInstance.get();
+        api.getFeatureId = [](InferenceInstanceData* data)->PluginID { return ((RemoteInstance*)data)->feature; };
+        api.getInputSignature = [](InferenceInstanceData* data)->const InferenceDataDescriptorArray* { return &((RemoteInstance*)data)->inputs.array; };
+        api.getOutputSignature = [](InferenceInstanceData* data)->const InferenceDataDescriptorArray* { return &((RemoteInstance*)data)->outputs.array; };
+        api.evaluate = [](InferenceExecutionContext* execCtx)->Result
+        {
+            if (!execCtx || !execCtx->instance) return kResultInvalidParameter;
+            auto remoteInstance = (RemoteInstance*)execCtx->instance->data;
+            return remoteInstance->client->evaluate(remoteInstance, execCtx, true);
+        };
+        api.evaluateAsync = [](InferenceExecutionContext* execCtx)->Result
+        {
+            if (!execCtx || !execCtx->instance) return kResultInvalidParameter;
+            auto remoteInstance = (RemoteInstance*)execCtx->instance->data;
+            return remoteInstance->client->evaluate(remoteInstance, execCtx, false);
+        };
+        api.cancelAsyncEvaluation = [](InferenceExecutionContext* execCtx)->Result
+        {
+            if (!execCtx || !execCtx->instance) return kResultInvalidParameter;
+            auto remoteInstance = (RemoteInstance*)execCtx->instance->data;
+            return remoteInstance->client->cancel(remoteInstance, execCtx);
+        };
+
+        *instance = &remoteInstance->api;
+        std::scoped_lock lock(m_mtx);
+        m_instances.push_back(std::move(remoteInstance));
+        return kResultOk;
+    }
+
+    //! Waits for evaluations queued on the host, always releases the local proxy
+    Result destroyInstance(InferenceInstance* instance)
+    {
+        if (!instance) return kResultOk;
+        std::unique_ptr<RemoteInstance> remoteInstance;
+        {
+            std::scoped_lock lock(m_mtx);
+            auto it = std::find_if(m_instances.begin(), m_instances.end(), [instance](auto& i) { return &i->api == instance; });
+            if (it == m_instances.end()) return kResultInvalidParameter;
+            remoteInstance = std::move(*it);
+            m_instances.erase(it);
+        }
+        if (!m_connected) return kResultOk;
+        auto request = std::make_shared<Request>();
+        std::vector<uint8_t> message;
+        remote::putHeader(message, remote::MessageType::eDestroyInstance, request->id = m_nextId++);
+        capture::putVarint(message, remoteInstance->id);
+        if (NVIGI_FAILED(result, call(request, message, m_params.requestTimeoutMs))) return result;
+        return request->result;
+    }
+
+private:
+    struct RemoteInstance
+    {
+        InferenceInstance api{};
+        RemoteInferenceClient* client{};
+        uint64_t id{};
+        PluginID feature{};
+        remote::Signature inputs;
+        remote::Signature outputs;
+    };
+
+    struct Request
+    {
+        uint64_t id{};
+        //! Evaluations only
+        RemoteInstance* instance{};
+        InferenceExecutionContext* host{};
+        bool sync{};
+        //! Callback messages for synchronous evaluations, dispatched on the calling thread
+        std::deque<std::vector<uint8_t>> inbox;
+        bool terminal{};
+        bool cancelSent{};
+        bool done{};
+        Result result = kResultOk;
+        std::vector<uint8_t> reply;
+    };
+
+    //! Sends and waits for the reply
+    Result call(const std::shared_ptr<Request>& request, const std::vector<uint8_t>& message, uint32_t timeoutMs)
+    {
+        {
+            // Host may have died since the caller checked
+            std::scoped_lock lock(m_mtx);
+            if (!m_connected) return kResultInvalidState;
+            m_requests[request->id] = request;
+        }
+        auto result = m_channel.send(message, timeoutMs);
+        std::unique_lock lock(m_mtx);
+        if (result == kResultOk && !m_cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&request]() { return request->done; }))
+        {
+            result = kResultTimedOut;
+        }
+        m_requests.erase(request->id);
+        return result;
+    }
+
+    Result evaluate(RemoteInstance* instance, InferenceExecutionContext* execCtx, bool sync)
+    {
+        if (!sync && !execCtx->callback)
+        {
+            NVIGI_LOG_ERROR("Polled results are not supported by remote instances, please provide a callback");
+            return kResultInvalidParameter;
+        }
+        if (!m_connected) return kResultInvalidState;
+
+        auto request = std::make_shared<Request>();
+        request->id = m_nextId++;
+        request->instance = instance;
+        request->host = execCtx;
+        request->sync = sync;
+        std::vector<uint8_t> message;
+        std::vector<uint64_t> blocks;
+        remote::putHeader(message, remote::MessageType::eEvaluate, request->id);
+        capture::putVarint(message, instance->id);
+        auto result = remote::putSlots(m_channel, message, execCtx->inputs, blocks, m_params.requestTimeoutMs);
+        if (result == kResultOk)
+        {
+            capture::putStructs(message, execCtx->runtimeParameters, m_runtimeStructs);
+            std::scoped_lock lock(m_mtx);
+            if (!m_connected) result = kResultInvalidState;
+            else m_requests[request->id] = request;
+        }
+        if (result == kResultOk) result = m_channel.send(message, m_params.requestTimeoutMs);
+        if (result != kResultOk)
+        {
+            for (auto offset : blocks) m_channel.discard(offset);
+            std::scoped_lock lock(m_mtx);
+            m_requests.erase(request->id);
+            return result;
+        }
+        if (!sync) return kResultOk;
+
+        std::unique_lock lock(m_mtx);
+        while (true)
+        {
+            m_cv.wait(lock, [&request]() { return request->done || !request->inbox.empty(); });
+            if (request->inbox.empty()) break;
+            auto callback = std::move(request->inbox.front());
+            request->inbox.pop_front();
+            lock.unlock();
+            capture::Cursor cursor{ callback.data(), callback.data() + callback.size() };
+            cursor.pod<uint8_t>();
+            cursor.varint();
+            dispatch(*request, cursor);
+            lock.lock();
+        }
+        return request->result;
+    }
+
+    Result cancel(RemoteInstance* instance, InferenceExecutionContext* execCtx)
+    {
+        std::shared_ptr<Request> request;
+        {
+            std::scoped_lock lock(m_mtx);
+            for (auto& [id, r] : m_requests)
+            {
+                if (r->instance == instance && r->host == execCtx) request = r;
+            }
+            if (!request) return kResultOk;
+            request->cancelSent = true;
+        }
+        std::vector<uint8_t> message;
+        remote::putHeader(message, remote::MessageType::eCancel, request->id);
+        capture::putVarint(message, instance->id);
+        if (NVIGI_FAILED(result, m_channel.send(message, m_params.requestTimeoutMs))) return result;
+        std::unique_lock lock(m_mtx);
+        // Plugins block until the evaluation stops, so do we
+        if (!m_cv.wait_for(lock, std::chrono::milliseconds(m_params.requestTimeoutMs), [&request]() { return request->done; })) return kResultTimedOut;
+        return kResultOk;
+    }
+
+    //! Invokes the host callback with outputs read in place from shared memory
+    void dispatch(Request& request, capture::Cursor& cursor)
+    {
+        auto state = cursor.pod<InferenceExecutionState>();
+        CapturedContext outputs;
+        std::vector<uint64_t> blocks;
+        if (!remote::getSlots(cursor, m_channel, outputs, blocks))
+        {
+            NVIGI_LOG_ERROR("Received corrupted results from the inference host");
+            state = kInferenceExecutionStateInvalid;
+        }
+        auto host = request.host;
+        auto res = state;
+        if (host->callback)
+        {
+            auto hostOutputs = host->outputs;
+            host->outputs = &outputs.inputs;
+            res = host->callback(host, state, host->callbackUserData);
+            host->outputs = hostOutputs;
+        }
+        for (auto offset : blocks) m_channel.release(offset);
+
+        bool sendCancel = false;
+        {
+            std::scoped_lock lock(m_mtx);
+            if (remote::isTerminal(state)) request.terminal = true;
+            sendCancel = res == kInferenceExecutionStateCancel && !request.terminal && !request.cancelSent;
+            if (sendCancel) request.cancelSent = true;
+        }
+        if (sendCancel)
+        {
+            std::vector<uint8_t> message;
+            remote::putHeader(message, remote::MessageType::eCancel, request.id);
+            capture::putVarint(message, request.instance->id);
+            m_channel.send(message, m_params.requestTimeoutMs);
+        }
+    }
+
+    //! Receiving thread
+    void receive()
+    {
+        std::vector<uint8_t> message;
+        while (!m_stop)
+        {
+            if (!m_channel.receive(message, 100))
+            {
+                if (!m_stop && !m_channel.isPeerAlive())
+                {
+                    NVIGI_LOG_ERROR("Inference host '%s' exited, failing all pending requests", m_params.service);
+                    failAll();
+                    return;
+                }
+                continue;
+            }
+            capture::Cursor cursor{ message.data(), message.data() + message.size() };
+            auto type = (remote::MessageType)cursor.pod<uint8_t>();
+            auto id = cursor.varint();
+            std::shared_ptr<Request> request;
+            {
+                std::scoped_lock lock(m_mtx);
+                auto it = m_requests.find(id);
+                if (it != m_requests.end()) request = it->second;
+            }
+            if (!request || !cursor.ok) continue;
+
+            if (type == remote::MessageType::eCallback)
+            {
+                if (request->sync)
+                {
+                    std::scoped_lock lock(m_mtx);
+                    request->inbox.push_back(message);
+                    m_cv.notify_all();
+                }
+                else
+                {
+                    dispatch(*request, cursor);
+                }
+                continue;
+            }
+
+            auto result = cursor.pod<Result>();
+            if (type == remote::MessageType::eResult && !request->sync && request->host && result != kResultOk && !request->terminal)
+            {
+                // Plugin refused the evaluation, nothing else is coming
+                request->host->callback(request->host, kInferenceExecutionStateInvalid, request->host->callbackUserData);
+            }
+            std::scoped_lock lock(m_mtx);
+            request->result = result;
+            request->reply.assign(cursor.pos, cursor.end);
+            request->done = true;
+            if (request->host) m_requests.erase(id);
+            m_cv.notify_all();
+        }
+    }
+
+    void failAll()
+    {
+        std::map<uint64_t, std::shared_ptr<Request>> requests;
+        {
+            std::scoped_lock lock(m_mtx);
+            m_connected = false;
+            requests.swap(m_requests);
+        }
+        for (auto& [id, request] : requests)
+        {
+            if (request->host && !request->sync && !request->terminal)
+            {
+                request->host->callback(request->host, kInferenceExecutionStateInvalid, request->host->callbackUserData);
+            }
+            std::scoped_lock lock(m_mtx);
+            request->result = kResultInvalidState;
+            request->done = true;
+        }
+        std::scoped_lock lock(m_mtx);
+        m_cv.notify_all();
+    }
+
+    RemoteInferenceClientParameters m_params{};
+    std::vector<CaptureStructDesc> m_creationStructs;
+    std::vector<CaptureStructDesc> m_runtimeStructs;
+    ipc::Channel m_channel;
+    std::thread m_receiver;
+    std::atomic<bool> m_stop{};
+    std::atomic<bool> m_connected{};
+    std::atomic<uint64_t> m_nextId{ 1 };
+    std::mutex m_mtx;
+    std::condition_variable m_cv;
+    std::map<uint64_t, std::shared_ptr<Request>> m_requests;
+    std::vector<std::unique_ptr<RemoteInstance>> m_instances;
+};
+
+//! Returns the interface implementing 'feature' or null, called on a client's session thread, see 'RemoteInferenceServer'
+using RemoteInterfaceLoader = std::function<InferenceInterface*(const PluginID& feature)>;
+
+//! Host side of the out of process host, see source/tools/host
+//!
+//! Each client gets a session thread which creates and destroys instances, each instance gets a worker thread
+//! which runs the queued evaluations one by one with blocking 'evaluate'. Inputs are read in place from shared memory.
+//! Everything a client created is destroyed when it disconnects or dies.
+class RemoteInferenceServer
+{
+public:
+    RemoteInferenceServer(RemoteInterfaceLoader loader) : m_loader(std::move(loader)) {}
+    RemoteInferenceServer(const RemoteInferenceServer&) = delete;
+    RemoteInferenceServer& operator=(const RemoteInferenceServer&) = delete;
+    ~RemoteInferenceServer() { stop(); }
+
+    //! Starts accepting clients on a background thread, fails with kResultAlreadyExists if another host serves this name
+    Result listen(const char* service)
+    {
+        if (!m_loader || m_acceptor.joinable()) return kResultInvalidState;
+        if (NVIGI_FAILED(result, m_endpoint.listen(service))) return result;
+        m_stop = false;
+        m_acceptor = std::thread([this]() { accept(); });
+        NVIGI_LOG_INFO("Inference host serving '%s'", service);
+        return kResultOk;
+    }
+
+    //! Disconnects all clients
+    void stop()
+    {
+        if (!m_acceptor.joinable()) return;
+        m_stop = true;
+        m_endpoint.wake();
+        m_acceptor.join();
+        // Sessions notice 'm_stop' within their receive timeout
+        std::scoped_lock lock(m_mtx);
+        for (auto& session : m_sessions) session->thread.join();
+        m_sessions.clear();
+        m_endpoint.close();
+    }
+
+    size_t getClientCount() const
+    {
+        std::scoped_lock lock(m_mtx);
+        return std::count_if(m_sessions.begin(), m_sessions.end(), [](auto& s) { return !s->finished; });
+    }
+
+    //! Clients served since 'listen'
+    uint64_t getTotalClientCount() const { return m_totalClients; }
+
+private:
+    struct Session;
+
+    struct Job
+    {
+        uint64_t id{};
+        Session* session{};
+        CapturedContext ctx;
+        std::vector<uint64_t> blocks;
+        std::atomic<bool> cancel{};
+    };
+
+    struct Hosted
+    {
+        uint64_t id{};
+        InferenceInterface* iface{};
+        InferenceInstance* instance{};
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::deque<std::unique_ptr<Job>> queue;
+        Job* running{};
+        bool stop{};
+        std::thread worker;
+    };
+
+    struct Session
+    {
+        RemoteInferenceServer* server{};
+        ipc::Channel channel;
+        uint32_t clientPid{};
+        std::thread thread;
+        std::atomic<bool> finished{};
+        std::map<uint64_t, std::unique_ptr<Hosted>> instances;
+        uint64_t nextInstanceId = 1;
+    };
+
+    static constexpr uint32_t kSendTimeoutMs = 30000;
+
+    void accept()
+    {
+        while (!m_stop)
+        {
+            std::string channel;
+            uint32_t clientPid{};
+            if (!m_endpoint.accept(channel, clientPid, 500))
+            {
+                reap();
+                continue;
+            }
+            auto session = std::make_unique<Session>();
+            session->server = this;
+            session->clientPid = clientPid;
+            if (NVIGI_FAILED(result, session->channel.open(channel.c_str())))
+            {
+                NVIGI_LOG_WARN("Failed to open channel '%s' of client %u (0x%x)", channel.c_str(), clientPid, result);
+                continue;
+            }
+            NVIGI_LOG_INFO("Client %u connected", clientPid);
+            m_totalClients++;
+            auto ptr = session.get();
+            session->thread = std::thread([this, ptr]() { serve(*ptr); });
+            std::scoped_lock lock(m_mtx);
+            m_sessions.push_back(std::move(session));
+        }
+    }
+
+    void reap()
+    {
+        std::scoped_lock lock(m_mtx);
+        for (auto it = m_sessions.begin(); it != m_sessions.end();)
+        {
+            if (!(*it)->finished)
+            {
+                it++;
+                continue;
+            }
+            (*it)->thread.join();
+            it = m_sessions.erase(it);
+        }
+    }
+
+    //! Session thread
+    void serve(Session& session)
+    {
+        std::vector<uint8_t> message;
+        while (!m_stop)
+        {
+            if (!session.channel.receive(message, 100))
+            {
+                if (!session.channel.isPeerAlive()) break;
+                continue;
+            }
+            capture::Cursor cursor{ message.data(), message.data() + message.size() };
+            auto type = (remote::MessageType)cursor.pod<uint8_t>();
+            auto id = cursor.varint();
+            if (!cursor.ok) continue;
+            switch (type)
+            {
+                case remote::MessageType::eCreateInstance: create(session, id, cursor); break;
+                case remote::MessageType::eEvaluate: enqueue(session, id, cursor); break;
+                case remote::MessageType::eCancel: cancel(session, id, cursor); break;
+                case remote::MessageType::eDestroyInstance:
+                {
+                    auto it = session.instances.find(cursor.varint());
+                    auto result = it == session.instances.end() ? kResultInvalidParameter : destroy(*it->second);
+                    if (it != session.instances.end()) session.instances.erase(it);
+                    sendResult(session, id, result);
+                    break;
+                }
+                default:
+                    NVIGI_LOG_WARN("Client %u sent unknown message %u", session.clientPid, (uint32_t)type);
+                    break;
+            }
+        }
+        for (auto& [id, hosted] : session.instances) destroy(*hosted);
+        session.instances.clear();
+        NVIGI_LOG_INFO("Client %u disconnected", session.clientPid);
+        session.channel.close();
+        session.finished = true;
+    }
+
+    void sendResult(Session& session, uint64_t id, Result result, const std::vector<uint8_t>* extra = nullptr)
+    {
+        std::vector<uint8_t> message;
+        remote::putHeader(message, extra ? remote::MessageType::eInstanceCreated : remote::MessageType::eResult, id);
+        capture::putPod(message, result);
+        if (extra) capture::putBytes(message, extra->data(), extra->size());
+        session.channel.send(message, kSendTimeoutMs);
+    }
+
+    void create(Session& session, uint64_t id, capture::Cursor& cursor)
+    {
+        PluginID feature{};
+        feature.id = cursor.pod<UID>();
+        feature.crc24 = cursor.pod<uint32_t>();
+        CommonCreationParameters common{};
+        common.numThreads = (int32_t)cursor.varint();
+        common.vramBudgetMB = cursor.varint();
+        auto modelGUID = cursor.string();
+        auto pathToModels = cursor.string();
+        auto pathToAdditionalModels = cursor.string();
+        auto modelCardJSON = cursor.string();
+        common.maxBatchSize = (uint32_t)cursor.varint();
+        common.batchWindowUs = (uint32_t)cursor.varint();
+        common.priorityClass = (InferencePriorityClass)cursor.varint();
+        common.modelGUID = modelGUID.empty() ? nullptr : modelGUID.c_str();
+        common.utf8PathToModels = pathToModels.empty() ? nullptr : pathToModels.c_str();
+        common.utf8PathToAdditionalModels = pathToAdditionalModels.empty() ? nullptr : pathToAdditionalModels.c_str();
+        common.modelCardJSON = modelCardJSON.empty() ? nullptr : modelCardJSON.c_str();
+        std::vector<std::unique_ptr<uint64_t[]>> structs;
+        if (!capture::decodeStructs(cursor, structs)) return sendResult(session, id, kResultInvalidParameter);
+        if (!structs.empty()) common._base.next = (BaseStructure*)structs.front().get();
+
+        auto iface = m_loader(feature);
+        if (!iface) return sendResult(session, id, kResultMissingInterface);
+        InferenceInstance* instance{};
+        if (NVIGI_FAILED(result, iface->createInstance(common, &instance))) return sendResult(session, id, result);
+
+        auto hosted = std::make_unique<Hosted>();
+        hosted->id = session.nextInstanceId++;
+        hosted->iface = iface;
+        hosted->instance = instance;
+        auto ptr = hosted.get();
+        hosted->worker = std::thread([this, ptr]() { work(*ptr); });
+        session.instances[hosted->id] = std::move(hosted);
+
+        std::vector<uint8_t> reply;
+        capture::putVarint(reply, ptr->id);
+        auto instanceFeature = instance->getFeatureId ? instance->getFeatureId(instance->data) : feature;
+        capture::putPod(reply, instanceFeature.id);
+        capture::putPod(reply, instanceFeature.crc24);
+        remote::putSignature(reply, instance->getInputSignature ? instance->getInputSignature(instance->data) : nullptr);
+        remote::putSignature(reply, instance->getOutputSignature ? instance->getOutputSignature(instance->data) : nullptr);
+        sendResult(session, id, kResultOk, &reply);
+    }
+
+    void enqueue(Session& session, uint64_t id, capture::Cursor& cursor)
+    {
+        auto it = session.instances.find(cursor.varint());
+        auto job = std::make_unique<Job>();
+        job->id = id;
+        job->session = &session;
+        bool ok = remote::getSlots(cursor, session.channel, job->ctx, job->blocks) && capture::decodeStructs(cursor, job->ctx.runtime);
+        if (!ok || it == session.instances.end())
+        {
+            for (auto offset : job->blocks) session.channel.release(offset);
+            return sendResult(session, id, kResultInvalidParameter);
+        }
+        auto& hosted = *it->second;
+        std::scoped_lock lock(hosted.mtx);
+        hosted.queue.push_back(std::move(job));
+        hosted.cv.notify_one();
+    }
+
+    void cancel(Session& session, uint64_t id, capture::Cursor& cursor)
+    {
+        auto it = session.instances.find(cursor.varint());
+        if (it == session.instances.end()) return;
+        auto& hosted = *it->second;
+        std::unique_ptr<Job> queued;
+        {
+            std::scoped_lock lock(hosted.mtx);
+            if (hosted.running && hosted.running->id == id) hosted.running->cancel = true;
+            auto job = std::find_if(hosted.queue.begin(), hosted.queue.end(), [id](auto& j) { return j->id == id; });
+            if (job != hosted.queue.end())
+            {
+                queued = std::move(*job);
+                hosted.queue.erase(job);
+            }
+        }
+        if (!queued) return;
+        // Never started
+        for (auto offset : queued->blocks) session.channel.release(offset);
+        std::vector<uint8_t> message;
+        remote::putHeader(message, remote::MessageType::eCallback, id);
+        capture::putPod(message, kInferenceExecutionStateCancel);
+        capture::putVarint(message, 0);
+        session.channel.send(message, kSendTimeoutMs);
+        sendResult(session, id, kResultOk);
+    }
+
+    //! Waits for the queued evaluations
+    Result destroy(Hosted& hosted)
+    {
+        {
+            std::scoped_lock lock(hosted.mtx);
+            hosted.stop = true;
+            hosted.cv.notify_one();
+        }
+        hosted.worker.join();
+        return hosted.iface->destroyInstance(hosted.instance);
+    }
+
+    //! Instance worker thread
+    void work(Hosted& hosted)
+    {
+        while (true)
+        {
+            std::unique_ptr<Job> job;
+            {
+                std::unique_lock lock(hosted.mtx);
+                hosted.cv.wait(lock, [&hosted]() { return hosted.stop || !hosted.queue.empty(); });
+                if (hosted.queue.empty()) return;
+                job = std::move(hosted.queue.front());
+                hosted.queue.pop_front();
+                hosted.running = job.get();
+            }
+            InferenceExecutionContext execCtx{};
+            execCtx.instance = hosted.instance;
+            execCtx.inputs = job->ctx.getInputs();
+            execCtx.runtimeParameters = job->ctx.getRuntimeParameters();
+            execCtx.callback = callback;
+            execCtx.callbackUserData = job.get();
+            auto result = hosted.instance->evaluate(&execCtx);
+            for (auto offset : job->blocks) job->session->channel.release(offset);
+            {
+                std::scoped_lock lock(hosted.mtx);
+                hosted.running = nullptr;
+            }
+            sendResult(*job->session, job->id, result);
+        }
+    }
+
+    //! Copies outputs into shared memory, called on the instance worker or a plugin thread
+    static InferenceExecutionState callback(const InferenceExecutionContext* execCtx, InferenceExecutionState state, void* userData)
+    {
+        auto job = (Job*)userData;
+        auto& channel = job->session->channel;
+        std::vector<uint8_t> message;
+        std::vector<uint64_t> blocks;
+        remote::putHeader(message, remote::MessageType::eCallback, job->id);
+        capture::putPod(message, state);
+        auto result = remote::putSlots(channel, message, execCtx->outputs, blocks, kSendTimeoutMs);
+        if (result != kResultOk)
+        {
+            for (auto offset : blocks) channel.discard(offset);
+            remote::putHeader(message, remote::MessageType::eCallback, job->id);
+            capture::putPod(message, kInferenceExecutionStateInvalid);
+            capture::putVarint(message, 0);
+            channel.send(message, kSendTimeoutMs);
+            return kInferenceExecutionStateCancel;
+        }
+        if (channel.send(message, kSendTimeoutMs) != kResultOk)
+        {
+            // Client is gone or stuck, stop burning GPU time for it
+            for (auto offset : blocks) channel.discard(offset);
+            return kInferenceExecutionStateCancel;
+        }
+        return job->cancel ? kInferenceExecutionStateCancel : state;
+    }
+
+    RemoteInterfaceLoader m_loader;
+    ipc::ServiceEndpoint m_endpoint;
+    std::thread m_acceptor;
+    std::atomic<bool> m_stop{};
+    std::atomic<uint64_t> m_totalClients{};
+    mutable std::mutex m_mtx;
+    std::list<std::unique_ptr<Session>> m_sessions;
+};
+
+}
+}
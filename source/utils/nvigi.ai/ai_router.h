@@ -0,0 +1,885 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "source/core/nvigi.log/log.h"
+#include "source/core/nvigi.system/system.h"
+#include "source/utils/nvigi.ai/nvigi_ai.h"
+#include "source/plugins/nvigi.hwi/common/nvigi_hwi_common.h"
+
+namespace nvigi
+{
+namespace ai
+{
+
+//! One of the interfaces wrapped by 'InferenceRouter', all must implement the same feature (same input/output signature)
+struct InferenceRouterBackend
+{
+    InferenceInterface* iface{};
+    //! Must remain valid until 'InferenceRouter::createInstance' returns
+    const NVIGIParameter* creationParameters{};
+    //! eCPU, eGPU or eCloud
+    InferenceBackendLocations location = InferenceBackendLocations::eGPU;
+    //! GPU only - free VRAM (budget minus current usage) needed to send a request here, 0 skips the check
+    size_t requiredVRAMHeadroomMB{};
+    uint32_t adapterIndex{};
+    //! Requests in flight on one instance before it is considered saturated
+    uint32_t maxInFlight = 1;
+    //! Expected time to first result until something is measured, keep local ones low so they are tried first
+    double priorFirstResultMs{};
+    //! Instances created per routed instance, for example several copies of the same LLM serving many NPCs
+    uint32_t instanceCount = 1;
+};
+
+struct InferenceRouterPolicy
+{
+    //! Optional - VRAM headroom signal, see 'InferenceRouterBackend::requiredVRAMHeadroomMB'
+    system::ISystem* isystem{};
+    //! Optional - current 'SchedulingMode', GPU backends are used as a last resort while graphics are prioritized
+    IHWICommon* ihwi{};
+    //! Issue the same request to the next best backend when no result arrived after max(hedgeAfterMs, hedgeFactor * expected time to first result)
+    //!
+    //! First backend to produce a result wins, the rest are cancelled. Zero disables hedging.
+    uint32_t hedgeAfterMs{};
+    double hedgeFactor = 2.0;
+    //! Weight of new samples in the time to first result moving average
+    double smoothing = 0.2;
+    //! Final result is held back until cancelled backends stop reading the inputs, but not longer than this
+    uint32_t cancelTimeoutMs = 2000;
+    //! Prefix affinity - leading prompt span is hashed in blocks of this many bytes and the request goes to the instance which
+    //! most recently served the longest matching prefix, so its KV cache can be reused. Zero disables affinity.
+    uint32_t prefixBlockSize{};
+    //! Prompts remembered per instance, roughly what fits in its cache
+    uint32_t prefixHistory = 8;
+    //! Load balancing override, best matching instance is skipped if its expected time to first result exceeds the best one by more than this
+    double affinityMaxExtraMs = 500.0;
+    //! Text input slots forming the prefix, in the order the prompt template renders them (for example system, then user).
+    //! Empty uses all text inputs in order.
+    std::vector<std::string> prefixSlots;
+    //! Optional - returns the prefix directly, for example the output of 'PromptTemplate::render', overrides 'prefixSlots'
+    std::function<std::string_view(const InferenceExecutionContext*)> getPrefix;
+};
+
+struct InferenceRouterBackendStats
+{
+    InferenceBackendLocations location{};
+    uint64_t requests{};
+    //! Requests answered by this backend
+    uint64_t wins{};
+    //! Requests sent here as a hedge
+    uint64_t hedges{};
+    //! Requests cancelled here because another backend won
+    uint64_t cancels{};
+    uint64_t failures{};
+    uint32_t inFlight{};
+    double firstResultMs{};
+    //! Prefix affinity - requests with a prefix routed here and the ones landing on an instance which served that prefix before
+    uint64_t prefixRequests{};
+    uint64_t prefixHits{};
+    //! Prefix bytes expected to be served from an instance cache, out of all prefix bytes routed here
+    uint64_t prefixReusedBytes{};
+    uint64_t prefixBytes{};
+    //! Requests routed elsewhere because the best matching instance was too busy, see 'affinityMaxExtraMs'
+    uint64_t affinityOverrides{};
+};
+
+//! Latency aware router for several 'InferenceInterface's implementing the same feature, for example local GPU and cloud
+//!
+//! 'createInstance' returns a regular 'InferenceInstance' which dispatches each request to the backend with the lowest
+//! expected time to first result, computed from live signals: VRAM headroom, requests in flight on each backend,
+//! measured time to first result (cloud RTT) and the current scheduling mode. Failed requests fail over to the next backend.
+//! With 'InferenceRouterPolicy::prefixBlockSize' set, requests sharing a prompt prefix stick to the same instance.
+//!
+//! Routed instances support 'evaluate', 'evaluateAsync' with a callback and 'cancelAsyncEvaluation'.
+//! Polled evaluation is not supported since results would come from different plugins.
+//!
+//! NOTE: Host provided outputs are given to the first backend only, hedged backends allocate their own outputs so
+//! the callback must read results via the provided execution context (as usual).
+//!
+//! IMPORTANT: Interfaces must stay loaded and all routed instances must be destroyed before the router
+class InferenceRouter
+{
+public:
+    InferenceRouter(const InferenceRouterPolicy& policy = {}) : m_policy(policy) {}
+    InferenceRouter(const InferenceRouter&) = delete;
+    InferenceRouter& operator=(const InferenceRouter&) = delete;
+
+    ~InferenceRouter()
+    {
+        {
+            std::scoped_lock lock(m_mtx);
+            m_stop = true;
+            m_cv.notify_all();
+        }
+        if (m_monitor.joinable()) m_monitor.join();
+    }
+
+    //! Must be called before creating instances
+    Result addBackend(const InferenceRouterBackend& desc)
+    {
+        if (!desc.iface || !desc.iface->createInstance || !desc.iface->destroyInstance) return kResultInvalidParameter;
+        std::scoped_lock lock(m_mtx);
+        auto backend = std::make_unique<Backend>();
+        backend->desc = desc;
+        backend->firstResultMs = desc.priorFirstResultMs;
+        m_backends.push_back(std::move(backend));
+        return kResultOk;
+    }
+
+    //! Creates 'InferenceRouterBackend::instanceCount' instances per backend, instances failing to create are skipped
+    Result createInstance(InferenceInstance** instance)
+    {
+        if (!instance) return kResultInvalidParameter;
+        auto routed = std::make_unique<RoutedInstance>();
+        routed->router = this;
+        for (auto& backend : m_backends)
+        {
+            for (uint32_t i = 0; i < std::max(1u, backend->desc.instanceCount); i++)
+            {
+                InferenceInstance* backendInstance{};
+                auto res = backend->desc.iface->createInstance(backend->desc.creationParameters, &backendInstance);
+                if (res != kResultOk || !backendInstance)
+                {
+                    NVIGI_LOG_WARN("Router skipping backend %u, failed to create instance (0x%x)", (uint32_t)backend->desc.location, res);
+                    break;
+                }
+                auto target = std::make_unique<Target>();
+                target->backend = backend.get();
+                target->instance = backendInstance;
+                routed->targets.push_back(std::move(target));
+            }
+        }
+        if (routed->targets.empty()) return kResultInvalidState;
+
+        auto& api = routed->api;
+        api._base.version = kStructVersion3;
+        api.data = routed.get();
+        api.getFeatureId = [](InferenceInstanceData* data)->PluginID
+        {
+            auto first = ((RoutedInstance*)data)->targets.front()->instance;
+            return first->getFeatureId(first->data);
+        };
+        api.getInputSignature = [](InferenceInstanceData* data)->const InferenceDataDescriptorArray*
+        {
+            auto first = ((RoutedInstance*)data)->targets.front()->instance;
+            return first->getInputSignature(first->data);
+        };
+        api.getOutputSignature = [](InferenceInstanceData* data)->const InferenceDataDescriptorArray*
+        {
+            auto first = ((RoutedInstance*)data)->targets.front()->instance;
+            return first->getOutputSignature(first->data);
+        };
+        api.evaluate = [](InferenceExecutionContext* execCtx)->Result
+        {
+            if (!execCtx || !execCtx->instance) return kResultInvalidParameter;
+            auto routed = (RoutedInstance*)execCtx->instance->data;
+            return routed->router->evaluate(routed, execCtx, true);
+        };
+        api.evaluateAsync = [](InferenceExecutionContext* execCtx)->Result
+        {
+            if (!execCtx || !execCtx->instance) return kResultInvalidParameter;
+            auto routed = (RoutedInstance*)execCtx->instance->data;
+            return routed->router->evaluate(routed, execCtx, false);
+        };
+        api.cancelAsyncEvaluation = [](InferenceExecutionContext* execCtx)->Result
+        {
+            if (!execCtx || !execCtx->instance) return kResultInvalidParameter;
+            auto routed = (RoutedInstance*)execCtx->instance->data;
+            return routed->router->cancel(routed, execCtx);
+        };
+
+        *instance = &routed->api;
+        std::scoped_lock lock(m_mtx);
+        m_instances.push_back(std::move(routed));
+        return kResultOk;
+    }
+
+    //! Waits for outstanding requests and destroys all backend instances
+    Result destroyInstance(InferenceInstance* instance)
+    {
+        if (!instance) return kResultOk;
+        std::unique_ptr<RoutedInstance> routed;
+        {
+            std::unique_lock lock(m_mtx);
+            m_cv.wait(lock, [this, instance]() { return !m_monitorBusy || &m_monitorBusy->api != instance; });
+            auto it = std::find_if(m_instances.begin(), m_instances.end(), [instance](auto& i) { return &i->api == instance; });
+            if (it == m_instances.end()) return kResultInvalidParameter;
+            routed = std::move(*it);
+            m_instances.erase(it);
+            // Monitor must not hedge or cancel anything on this instance from now on
+            m_hedges.remove_if([&routed](auto& r) { return r->routed == routed.get(); });
+            m_cancels.remove_if([&routed](auto& c) { return c.request->routed == routed.get(); });
+        }
+        for (auto& target : routed->targets)
+        {
+            // Plugins flush their async jobs on destroy so no callbacks touch our requests after this
+            target->backend->desc.iface->destroyInstance(target->instance);
+        }
+        return kResultOk;
+    }
+
+    std::vector<InferenceRouterBackendStats> getStats() const
+    {
+        std::scoped_lock lock(m_mtx);
+        std::vector<InferenceRouterBackendStats> stats;
+        for (auto& backend : m_backends)
+        {
+            InferenceRouterBackendStats s{};
+            s.location = backend->desc.location;
+            s.requests = backend->requests;
+            s.wins = backend->wins;
+            s.hedges = backend->hedges;
+            s.cancels = backend->cancels;
+            s.failures = backend->failures;
+            s.firstResultMs = backend->firstResultMs;
+            s.prefixRequests = backend->prefixRequests;
+            s.prefixHits = backend->prefixHits;
+            s.prefixReusedBytes = backend->prefixReusedBytes;
+            s.prefixBytes = backend->prefixBytes;
+            s.affinityOverrides = backend->affinityOverrides;
+            for (auto& routed : m_instances)
+            {
+                for (auto& target : routed->targets)
+                {
+                    if (target->backend == backend.get()) s.inFlight += target->inFlight;
+                }
+            }
+            stats.push_back(s);
+        }
+        return stats;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Backend
+    {
+        InferenceRouterBackend desc{};
+        //! Guarded by the router's mutex
+        double firstResultMs{};
+        uint64_t requests{};
+        uint64_t wins{};
+        uint64_t hedges{};
+        uint64_t cancels{};
+        uint64_t failures{};
+        uint64_t prefixRequests{};
+        uint64_t prefixHits{};
+        uint64_t prefixReusedBytes{};
+        uint64_t prefixBytes{};
+        uint64_t affinityOverrides{};
+    };
+
+    struct Target
+    {
+        Backend* backend{};
+        InferenceInstance* instance{};
+        uint32_t inFlight{};
+        //! Block hashes of the last 'prefixHistory' prompts sent here, oldest first
+        std::deque<std::vector<uint64_t>> prefixes;
+        //! Number of remembered prompts containing each block hash
+        std::unordered_map<uint64_t, uint32_t> prefixBlocks;
+    };
+
+    struct Request;
+
+    struct RoutedInstance
+    {
+        InferenceInstance api{};
+        InferenceRouter* router{};
+        std::vector<std::unique_ptr<Target>> targets;
+        //! Kept until all backends are done with them
+        std::list<std::shared_ptr<Request>> requests;
+    };
+
+    struct Leg
+    {
+        Request* request{};
+        Target* target{};
+        InferenceExecutionContext ctx{};
+        Clock::time_point start{};
+        bool gotResult{};
+        bool finished{};
+        bool cancelled{};
+    };
+
+    struct Request
+    {
+        RoutedInstance* routed{};
+        InferenceExecutionContext* host{};
+        bool sync{};
+        std::vector<std::unique_ptr<Leg>> legs;
+        //! Targets to try, best first
+        std::vector<Target*> candidates;
+        size_t nextCandidate{};
+        Leg* winner{};
+        Clock::time_point hedgeAt = Clock::time_point::max();
+        //! Chained block hashes of the prompt prefix, see 'InferenceRouterPolicy::prefixBlockSize'
+        std::vector<uint64_t> prefix;
+        bool cancelled{};
+        bool done{};
+    };
+
+    struct PendingCancel
+    {
+        std::shared_ptr<Request> request;
+        Leg* leg{};
+    };
+
+    static bool isTerminal(InferenceExecutionState state)
+    {
+        return state == kInferenceExecutionStateDone || state == kInferenceExecutionStateCancel || state == kInferenceExecutionStateInvalid;
+    }
+
+    static bool supportsAsync(const InferenceInstance* instance)
+    {
+        return instance->getVersion() >= kStructVersion2 && instance->evaluateAsync;
+    }
+
+    static bool supportsCancel(const InferenceInstance* instance)
+    {
+        return instance->getVersion() >= kStructVersion3 && instance->cancelAsyncEvaluation;
+    }
+
+    //! Hashes full blocks of the prompt prefix, each hash covers everything before it so equal hashes mean equal prefixes
+    std::vector<uint64_t> hashPrefix(const InferenceExecutionContext* execCtx) const
+    {
+        std::vector<uint64_t> blocks;
+        if (!m_policy.prefixBlockSize) return blocks;
+        std::string joined;
+        std::string_view prefix;
+        if (m_policy.getPrefix)
+        {
+            prefix = m_policy.getPrefix(execCtx);
+        }
+        else if (execCtx->inputs)
+        {
+            auto inputs = execCtx->inputs;
+            auto append = [&joined](const InferenceDataText* text)
+            {
+                auto utf8 = text ? text->getUTF8Text() : nullptr;
+                if (!utf8) return;
+                joined += utf8;
+                // Keeps slot boundaries apart, "ab"+"c" must not match "a"+"bc"
+                joined += '\x1f';
+            };
+            if (m_policy.prefixSlots.empty())
+            {
+                for (size_t i = 0; i < inputs->count; i++)
+                {
+                    auto data = (const BaseStructure*)inputs->items[i].data;
+                    if (data && data->type == InferenceDataText::s_type) append((const InferenceDataText*)data);
+                }
+            }
+            else
+            {
+                for (auto& key : m_policy.prefixSlots)
+                {
+                    const InferenceDataText* text{};
+                    if (inputs->findAndValidateSlot(key.c_str(), &text)) append(text);
+                }
+            }
+            prefix = joined;
+        }
+        // FNV-1a, chained across blocks
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i + m_policy.prefixBlockSize <= prefix.size(); i += m_policy.prefixBlockSize)
+        {
+            for (size_t j = i; j < i + m_policy.prefixBlockSize; j++)
+            {
+                hash = (hash ^ uint8_t(prefix[j])) * 1099511628211ull;
+            }
+            blocks.push_back(hash);
+        }
+        return blocks;
+    }
+
+    //! Number of leading prefix blocks the target has seen, caller holds 'm_mtx'
+    static size_t matchPrefix(const Target* target, const std::vector<uint64_t>& prefix)
+    {
+        size_t matched = 0;
+        while (matched < prefix.size() && target->prefixBlocks.count(prefix[matched])) matched++;
+        return matched;
+    }
+
+    //! Caller holds 'm_mtx'
+    void rememberPrefix(Target* target, const std::vector<uint64_t>& prefix)
+    {
+        if (prefix.empty() || !m_policy.prefixHistory) return;
+        // Same prompt again only needs to be moved to the back
+        auto it = std::find(target->prefixes.begin(), target->prefixes.end(), prefix);
+        if (it != target->prefixes.end())
+        {
+            target->prefixes.erase(it);
+            target->prefixes.push_back(prefix);
+            return;
+        }
+        for (auto hash : prefix) target->prefixBlocks[hash]++;
+        target->prefixes.push_back(prefix);
+        while (target->prefixes.size() > m_policy.prefixHistory)
+        {
+            for (auto hash : target->prefixes.front())
+            {
+                auto block = target->prefixBlocks.find(hash);
+                if (--block->second == 0) target->prefixBlocks.erase(block);
+            }
+            target->prefixes.pop_front();
+        }
+    }
+
+    //! Caller holds 'm_mtx'
+    std::vector<Target*> rankTargets(RoutedInstance* routed, bool requireAsync, const std::vector<uint64_t>& prefix)
+    {
+        uint32_t schedulingMode = SchedulingMode::kBalance;
+        if (m_policy.ihwi) m_policy.ihwi->GetGpuInferenceSchedulingMode(&schedulingMode);
+
+        std::vector<std::pair<double, Target*>> ranked;
+        for (auto& target : routed->targets)
+        {
+            auto& desc = target->backend->desc;
+            if (target->inFlight >= std::max(1u, desc.maxInFlight)) continue;
+            if (requireAsync && !supportsAsync(target->instance)) continue;
+            // Queued requests are expected to wait for the ones in flight
+            double expected = target->backend->firstResultMs * (1.0 + target->inFlight);
+            if (desc.location == InferenceBackendLocations::eGPU)
+            {
+                if (desc.requiredVRAMHeadroomMB && m_policy.isystem && m_policy.isystem->getVRAMStatsCopy)
+                {
+                    system::VRAMUsage usage{};
+                    if (m_policy.isystem->getVRAMStatsCopy(desc.adapterIndex, &usage) == kResultOk)
+                    {
+                        auto headroom = usage.budgetMB > usage.currentUsageMB ? usage.budgetMB - usage.currentUsageMB : 0;
+                        if (headroom < desc.requiredVRAMHeadroomMB) continue;
+                    }
+                }
+                // Still usable if nothing else is, game frame time comes first
+                if (schedulingMode == SchedulingMode::kPrioritizeGraphics) expected += 1e9;
+            }
+            ranked.push_back({ expected, target.get() });
+        }
+        std::stable_sort(ranked.begin(), ranked.end(), [](auto& a, auto& b) { return a.first < b.first; });
+        std::vector<Target*> result;
+        for (auto& [score, target] : ranked) result.push_back(target);
+
+        if (!prefix.empty() && !ranked.empty())
+        {
+            // Longest cached prefix first unless that instance is too busy, ties keep the latency order
+            size_t best = 0, bestMatched = 0;
+            for (size_t i = 0; i < ranked.size(); i++)
+            {
+                auto matched = matchPrefix(ranked[i].second, prefix);
+                if (matched > bestMatched)
+                {
+                    best = i;
+                    bestMatched = matched;
+                }
+            }
+            if (bestMatched == 0)
+            {
+                // New prefix, spread it to the least used of the equally fast instances to keep their caches apart
+                for (size_t i = 1; i < ranked.size() && ranked[i].first <= ranked.front().first; i++)
+                {
+                    if (ranked[i].second->prefixes.size() < ranked[best].second->prefixes.size()) best = i;
+                }
+            }
+            if (best > 0 && ranked[best].first - ranked.front().first <= m_policy.affinityMaxExtraMs)
+            {
+                std::rotate(result.begin(), result.begin() + best, result.begin() + best + 1);
+            }
+        }
+        return result;
+    }
+
+    //! Caller holds 'm_mtx'
+    void recordPrefix(const Request& request)
+    {
+        if (request.prefix.empty()) return;
+        auto first = request.candidates.front();
+        auto matched = matchPrefix(first, request.prefix);
+        auto backend = first->backend;
+        backend->prefixRequests++;
+        backend->prefixBytes += request.prefix.size() * m_policy.prefixBlockSize;
+        if (matched > 0)
+        {
+            backend->prefixHits++;
+            backend->prefixReusedBytes += matched * m_policy.prefixBlockSize;
+        }
+        for (auto target : request.candidates)
+        {
+            if (matchPrefix(target, request.prefix) > matched)
+            {
+                target->backend->affinityOverrides++;
+                break;
+            }
+        }
+    }
+
+    //! Starts the next candidate, caller holds 'm_mtx' unless this is a synchronous evaluation
+    Result startNextLeg(std::unique_lock<std::mutex>& lock, const std::shared_ptr<Request>& request, bool hedge)
+    {
+        auto res = kResultInvalidState;
+        while (request->nextCandidate < request->candidates.size())
+        {
+            auto target = request->candidates[request->nextCandidate++];
+            if (target->inFlight >= std::max(1u, target->backend->desc.maxInFlight)) continue;
+
+            auto leg = std::make_unique<Leg>();
+            leg->request = request.get();
+            leg->target = target;
+            leg->ctx = *request->host;
+            leg->ctx.instance = target->instance;
+            leg->ctx.callback = legCallback;
+            leg->ctx.callbackUserData = leg.get();
+            // Concurrent legs must not write to the same host buffers
+            if (!request->legs.empty()) leg->ctx.outputs = nullptr;
+            leg->start = Clock::now();
+            auto legPtr = leg.get();
+            request->legs.push_back(std::move(leg));
+            target->inFlight++;
+            target->backend->requests++;
+            if (hedge) target->backend->hedges++;
+
+            // Callbacks can arrive on this thread (sync) or any other, they need the lock
+            bool inline_ = request->sync && !supportsAsync(target->instance);
+            lock.unlock();
+            res = inline_ ? target->instance->evaluate(&legPtr->ctx) : target->instance->evaluateAsync(&legPtr->ctx);
+            lock.lock();
+            if (res == kResultOk) rememberPrefix(target, request->prefix);
+            if (res == kResultOk && inline_)
+            {
+                // Evaluated on this thread, nothing to hedge and nothing can arrive later
+                finishLeg(legPtr);
+                request->done = true;
+                return kResultOk;
+            }
+            if (res == kResultOk)
+            {
+                if (!request->sync || supportsAsync(target->instance)) scheduleHedge(request, target);
+                return kResultOk;
+            }
+            // Busy or failed, try the next one
+            if (!legPtr->finished)
+            {
+                legPtr->finished = true;
+                target->inFlight--;
+            }
+            target->backend->failures++;
+            NVIGI_LOG_VERBOSE("Router backend %u rejected request (0x%x), trying next", (uint32_t)target->backend->desc.location, res);
+        }
+        return res;
+    }
+
+    //! Caller holds 'm_mtx'
+    void scheduleHedge(const std::shared_ptr<Request>& request, Target* target)
+    {
+        if (!m_policy.hedgeAfterMs || request->winner || request->nextCandidate >= request->candidates.size()) return;
+        auto delayMs = std::max<double>(m_policy.hedgeAfterMs, m_policy.hedgeFactor * target->backend->firstResultMs);
+        request->hedgeAt = Clock::now() + std::chrono::microseconds(uint64_t(delayMs * 1000.0));
+        m_hedges.push_back(request);
+        startMonitor();
+        m_cv.notify_all();
+    }
+
+    //! Caller holds 'm_mtx'
+    void startMonitor()
+    {
+        if (!m_monitor.joinable()) m_monitor = std::thread([this]() { monitor(); });
+    }
+
+    //! Caller holds 'm_mtx'
+    void cancelOthers(const std::shared_ptr<Request>& request, Leg* keep)
+    {
+        for (auto& leg : request->legs)
+        {
+            if (leg.get() == keep || leg->finished || leg->cancelled) continue;
+            leg->cancelled = true;
+            leg->target->backend->cancels++;
+            if (supportsCancel(leg->target->instance))
+            {
+                // Cancel blocks until the backend stops, never do it on a plugin thread
+                m_cancels.push_back({ request, leg.get() });
+                startMonitor();
+            }
+        }
+        m_cv.notify_all();
+    }
+
+    //! Caller holds 'm_mtx'
+    void finishLeg(Leg* leg)
+    {
+        if (leg->finished) return;
+        leg->finished = true;
+        leg->target->inFlight--;
+        m_cv.notify_all();
+    }
+
+    //! Caller holds 'm_mtx'
+    static bool othersFinished(const Request& request, const Leg* leg)
+    {
+        for (auto& other : request.legs)
+        {
+            if (other.get() != leg && !other->finished) return false;
+        }
+        return true;
+    }
+
+    //! Caller holds 'm_mtx'
+    void collectRequests(RoutedInstance* routed)
+    {
+        routed->requests.remove_if([](auto& r) { return r->done && othersFinished(*r, nullptr); });
+    }
+
+    std::shared_ptr<Request> findRequest(RoutedInstance* routed, Request* request)
+    {
+        for (auto& r : routed->requests)
+        {
+            if (r.get() == request) return r;
+        }
+        return {};
+    }
+
+    static InferenceExecutionState legCallback(const InferenceExecutionContext* ctx, InferenceExecutionState state, void* userData)
+    {
+        auto leg = (Leg*)userData;
+        auto router = leg->request->routed->router;
+        return router->onLegResult(leg, ctx, state);
+    }
+
+    InferenceExecutionState onLegResult(Leg* leg, const InferenceExecutionContext* ctx, InferenceExecutionState state)
+    {
+        std::unique_lock lock(m_mtx);
+        auto request = findRequest(leg->request->routed, leg->request);
+        if (!request)
+        {
+            return isTerminal(state) ? state : kInferenceExecutionStateCancel;
+        }
+        auto backend = leg->target->backend;
+        bool terminal = isTerminal(state);
+        bool failed = state == kInferenceExecutionStateInvalid || (state == kInferenceExecutionStateCancel && !request->cancelled);
+
+        if (!leg->gotResult && !failed)
+        {
+            leg->gotResult = true;
+            auto ms = std::chrono::duration<double, std::milli>(Clock::now() - leg->start).count();
+            backend->firstResultMs = backend->firstResultMs > 0.0 ? backend->firstResultMs + m_policy.smoothing * (ms - backend->firstResultMs) : ms;
+        }
+
+        if (!request->winner)
+        {
+            if (failed && !request->cancelled)
+            {
+                backend->failures++;
+                finishLeg(leg);
+                bool othersRunning = !othersFinished(*request, leg);
+                if (othersRunning) return state;
+                // Fail over, keeps the request alive if any other backend accepts it
+                if (startNextLeg(lock, request, false) == kResultOk) return state;
+                if (request->winner) return state;
+            }
+            // First to report forwards everything to the host, including the final state of a cancelled request
+            request->winner = leg;
+            if (!request->cancelled) backend->wins++;
+            cancelOthers(request, leg);
+        }
+
+        if (request->winner != leg)
+        {
+            if (terminal) finishLeg(leg);
+            return terminal ? state : kInferenceExecutionStateCancel;
+        }
+
+        if (terminal)
+        {
+            // Host can release the inputs once it sees the final state, cancelled backends could still be reading them
+            m_cv.wait_for(lock, std::chrono::milliseconds(m_policy.cancelTimeoutMs), [&]() { return othersFinished(*request, leg); });
+            if (!othersFinished(*request, leg))
+            {
+                NVIGI_LOG_WARN("Router cancelled backend did not stop within %ums", m_policy.cancelTimeoutMs);
+            }
+        }
+        auto host = request->host;
+        lock.unlock();
+
+        InferenceExecutionContext view = *host;
+        view.outputs = ctx ? ctx->outputs : nullptr;
+        auto result = host->callback ? host->callback(&view, state, host->callbackUserData) : state;
+
+        lock.lock();
+        if (terminal)
+        {
+            finishLeg(leg);
+            request->done = true;
+            m_cv.notify_all();
+        }
+        else if (result == kInferenceExecutionStateCancel)
+        {
+            request->cancelled = true;
+            cancelOthers(request, leg);
+        }
+        return result;
+    }
+
+    Result evaluate(RoutedInstance* routed, InferenceExecutionContext* execCtx, bool sync)
+    {
+        if (!execCtx->callback) return kResultNoImplementation;
+        // Hashing reads the inputs only, no need to hold the lock
+        auto prefix = hashPrefix(execCtx);
+        std::unique_lock lock(m_mtx);
+        collectRequests(routed);
+
+        auto request = std::make_shared<Request>();
+        request->routed = routed;
+        request->host = execCtx;
+        request->sync = sync;
+        request->prefix = std::move(prefix);
+        // Hedging a synchronous evaluation needs async backends, otherwise the first pick just runs inline
+        request->candidates = rankTargets(routed, !sync, request->prefix);
+        if (sync && m_policy.hedgeAfterMs)
+        {
+            auto async = rankTargets(routed, true, request->prefix);
+            if (async.size() > 1) request->candidates = async;
+        }
+        if (request->candidates.empty())
+        {
+            return kResultNotReady;
+        }
+        routed->requests.push_back(request);
+        recordPrefix(*request);
+
+        auto res = startNextLeg(lock, request, false);
+        if (res != kResultOk)
+        {
+            request->done = true;
+            collectRequests(routed);
+            return res;
+        }
+        if (sync)
+        {
+            m_cv.wait(lock, [&request]() { return request->done; });
+        }
+        return kResultOk;
+    }
+
+    Result cancel(RoutedInstance* routed, InferenceExecutionContext* execCtx)
+    {
+        std::unique_lock lock(m_mtx);
+        std::shared_ptr<Request> request;
+        for (auto& r : routed->requests)
+        {
+            if (r->host == execCtx && !r->done) request = r;
+        }
+        if (!request) return kResultNoImplementation;
+        request->cancelled = true;
+        std::vector<Leg*> legs;
+        for (auto& leg : request->legs)
+        {
+            if (leg->finished || leg->cancelled || !supportsCancel(leg->target->instance)) continue;
+            leg->cancelled = true;
+            legs.push_back(leg.get());
+        }
+        // Same contract as plugins, returns once backends stopped
+        lock.unlock();
+        for (auto leg : legs)
+        {
+            leg->target->instance->cancelAsyncEvaluation(&leg->ctx);
+        }
+        lock.lock();
+        for (auto leg : legs)
+        {
+            finishLeg(leg);
+        }
+        // Nobody reported anything, there is nothing left to forward
+        if (!request->winner && othersFinished(*request, nullptr))
+        {
+            request->done = true;
+        }
+        return kResultOk;
+    }
+
+    void monitor()
+    {
+        std::unique_lock lock(m_mtx);
+        while (!m_stop)
+        {
+            if (!m_cancels.empty())
+            {
+                auto pending = m_cancels.front();
+                m_cancels.pop_front();
+                auto leg = pending.leg;
+                if (leg->finished) continue;
+                m_monitorBusy = pending.request->routed;
+                lock.unlock();
+                leg->target->instance->cancelAsyncEvaluation(&leg->ctx);
+                lock.lock();
+                m_monitorBusy = nullptr;
+                // Backend is done with the execution context now, callback or not
+                finishLeg(leg);
+                m_cv.notify_all();
+                continue;
+            }
+
+            auto now = Clock::now();
+            auto next = Clock::time_point::max();
+            std::shared_ptr<Request> due;
+            for (auto it = m_hedges.begin(); it != m_hedges.end();)
+            {
+                auto& r = *it;
+                if (r->winner || r->done || r->cancelled)
+                {
+                    it = m_hedges.erase(it);
+                    continue;
+                }
+                if (r->hedgeAt <= now)
+                {
+                    due = r;
+                    m_hedges.erase(it);
+                    break;
+                }
+                next = std::min(next, r->hedgeAt);
+                it++;
+            }
+            if (due)
+            {
+                NVIGI_LOG_VERBOSE("Router hedging request after %.1fms", std::chrono::duration<double, std::milli>(now - due->legs.front()->start).count());
+                m_monitorBusy = due->routed;
+                startNextLeg(lock, due, true);
+                m_monitorBusy = nullptr;
+                m_cv.notify_all();
+                continue;
+            }
+            if (next == Clock::time_point::max()) m_cv.wait(lock);
+            else m_cv.wait_until(lock, next);
+        }
+    }
+
+    InferenceRouterPolicy m_policy{};
+    mutable std::mutex m_mtx;
+    std::condition_variable m_cv;
+    std::vector<std::unique_ptr<Backend>> m_backends;
+    std::vector<std::unique_ptr<RoutedInstance>> m_instances;
+    std::list<std::shared_ptr<Request>> m_hedges;
+    std::list<PendingCancel> m_cancels;
+    std::thread m_monitor;
+    //! Instance the monitor is calling into without holding the lock
+    RoutedInstance* m_monitorBusy{};
+    bool m_stop{};
+};
+
+}
+}
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <cstdio>
+
+#include "source/utils/nvigi.ai/nvigi_ai.h"
+#include "source/utils/nvigi.io/mapped_io.h"
+
+namespace nvigi::ai
+{
+
+//! PERSISTENT STATE HELPERS
+//!
+//! Use these to store 'kInferenceDataSlotStateOut' on disk and feed it back as 'kInferenceDataSlotStateIn'
+//!
+
+//! Writes a CPU resident state blob (header + payload) to 'path', GPU resident state must be downloaded first
+inline Result saveInferenceState(const InferenceDataState* state, const char* path)
+{
+    if (!state || !path) return kResultInvalidParameter;
+    auto header = state->getHeader();
+    if (!header) return kResultInvalidParameter;
+    auto size = header->headerSize + header->payloadSize;
+    FILE* file{};
+#ifdef NVIGI_WINDOWS
+    fopen_s(&file, path, "wb");
+#else
+    file = fopen(path, "wb");
+#endif
+    if (!file) return kResultIOError;
+    auto written = fwrite(castTo<CpuData>(state->blob)->buffer, 1, size, file);
+    fclose(file);
+    return written == size ? kResultOk : kResultIOError;
+}
+
+//! Memory mapped state file, nothing is copied so reloading a large KV cache costs only the pages the plugin touches
+//!
+//! Must outlive the evaluate call which uses it as input.
+struct MappedInferenceState
+{
+    MappedInferenceState() : _io(getMappedFileIOCallbacks()) {};
+    MappedInferenceState(const MappedInferenceState&) = delete;
+    MappedInferenceState& operator=(const MappedInferenceState&) = delete;
+    ~MappedInferenceState() { close(); }
+
+    Result open(const char* path)
+    {
+        close();
+        _handle = _io.open(_io.userData, path, "rb");
+        if (!_handle) return kResultItemNotFound;
+        auto size = _io.size(_io.userData, _handle);
+        _view = size ? _io.map(_io.userData, _handle, 0, size, MapAccess::eReadOnly) : nullptr;
+        if (!_view)
+        {
+            close();
+            return kResultIOError;
+        }
+        _data.buffer = _view;
+        _data.sizeInBytes = size;
+        _slot.blob = _data;
+        auto header = _slot.getHeader();
+        if (!header)
+        {
+            NVIGI_LOG_ERROR("'%s' is not a valid inference state file", path);
+            close();
+            return kResultInvalidParameter;
+        }
+        _slot.format = header->format;
+        _slot.formatVersion = header->formatVersion;
+        _slot.modelHash = header->modelHash;
+        _slot.tokenCount = header->tokenCount;
+        return kResultOk;
+    }
+
+    void close()
+    {
+        if (_view) _io.unmap(_io.userData, _handle, _view);
+        if (_handle) _io.close(_io.userData, _handle);
+        _view = nullptr;
+        _handle = nullptr;
+        _slot = {};
+        _data = {};
+    }
+
+    //! Null if no file is mapped
+    operator InferenceDataState* () { return _view ? &_slot : nullptr; }
+    operator NVIGIParameter* () { return _view ? (NVIGIParameter*)_slot : nullptr; }
+
+    FileIOCallbacks _io{};
+    void* _handle{};
+    uint8_t* _view{};
+    CpuData _data{};
+    InferenceDataState _slot{};
+};
+
+}
@@ -0,0 +1,246 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "source/core/nvigi.api/nvigi_cuda.h"
+#include "source/core/nvigi.extra/extra.h"
+#include "source/core/nvigi.log/log.h"
+#include "source/core/nvigi.system/system.h"
+#include "source/utils/nvigi.ai/nvigi_ai.h"
+#include "external/json/source/nlohmann/json.hpp"
+
+namespace nvigi
+{
+namespace ai
+{
+
+//! Execution profiles found by the test host auto-tuner ('[tune]', see source/tests/ai/tune.h)
+//!
+//! The best batch size, CPU thread count, scheduling mode and backend depend on the plugin, the model and the machine.
+//! The tuner sweeps them and stores the winner per machine, model and backend in a small JSON store, by default
+//! 'nvigi.tuning.json' next to the models. 'ModernPluginBase' applies the stored profile on 'createInstance' when
+//! 'TunedExecutionParameters' is chained, hosts use 'findTunedProfile' for the process wide settings.
+
+constexpr const char* kTuningProfileFile = "nvigi.tuning.json";
+constexpr uint32_t kTuningProfileVersion = 1;
+
+struct TuningProfile
+{
+    //! Plugin the profile was measured with, see 'extra::guidToString'
+    std::string backend;
+    int32_t numThreads = 1;
+    uint32_t maxBatchSize = 0;
+    uint32_t batchWindowUs = 0;
+    //! See 'SchedulingMode', process wide so applied by the host
+    uint32_t schedulingMode = SchedulingMode::kBalance;
+    //! Evaluation mode the host should use, "sync", "async" or "polled"
+    std::string mode = "sync";
+    //! Measured with the winning settings
+    uint32_t concurrency = 1;
+    double requestsPerSecond{};
+    double latencyP50Ms{};
+    double latencyP99Ms{};
+};
+
+inline nlohmann::json toJSON(const TuningProfile& profile)
+{
+    return {
+        {"backend", profile.backend},
+        {"numThreads", profile.numThreads},
+        {"maxBatchSize", profile.maxBatchSize},
+        {"batchWindowUs", profile.batchWindowUs},
+        {"schedulingMode", profile.schedulingMode},
+        {"mode", profile.mode},
+        {"concurrency", profile.concurrency},
+        {"requestsPerSecond", profile.requestsPerSecond},
+        {"latencyP50Ms", profile.latencyP50Ms},
+        {"latencyP99Ms", profile.latencyP99Ms},
+    };
+}
+
+inline TuningProfile toTuningProfile(const nlohmann::json& entry)
+{
+    TuningProfile profile{};
+    profile.backend = entry.value("backend", std::string());
+    profile.numThreads = std::max(1, entry.value("numThreads", 1));
+    profile.maxBatchSize = entry.value("maxBatchSize", 0u);
+    profile.batchWindowUs = entry.value("batchWindowUs", 0u);
+    profile.schedulingMode = std::min(entry.value("schedulingMode", SchedulingMode::kBalance), SchedulingMode::kNumOptions - 1);
+    profile.mode = entry.value("mode", std::string("sync"));
+    profile.concurrency = entry.value("concurrency", 1u);
+    profile.requestsPerSecond = entry.value("requestsPerSecond", 0.0);
+    profile.latencyP50Ms = entry.value("latencyP50Ms", 0.0);
+    profile.latencyP99Ms = entry.value("latencyP99Ms", 0.0);
+    return profile;
+}
+
+//! Identifies the machine a profile is valid for: every adapter, the driver and the number of logical CPU cores
+//!
+//! New GPU, driver update or different CPU means the profile no longer applies and the tuner has to run again
+inline std::string getMachineKey(const system::SystemCaps* caps)
+{
+    std::string key;
+    if (caps)
+    {
+        for (uint32_t i = 0; i < caps->adapterCount && i < system::kMaxNumSupportedGPUs; i++)
+        {
+            auto adapter = caps->adapters[i];
+            if (!adapter) continue;
+            key += extra::format("gpu.{}.{}.{}.{}MB;", extra::toHexStr((uint32_t)adapter->vendor, 4), extra::toHexStr(adapter->deviceId, 4),
+                adapter->architecture, adapter->dedicatedMemoryInMB);
+        }
+        key += extra::format("driver.{}.{};", caps->driverVersion.major, caps->driverVersion.minor);
+    }
+    key += extra::format("cpu.{}", std::thread::hardware_concurrency());
+    return key;
+}
+
+//! JSON store of profiles, 'machine' -> 'model GUID' -> 'backend' -> profile
+//!
+//! NOTE: Not thread safe, see 'findTunedProfile' for lookups from plugins
+class TuningProfileStore
+{
+public:
+    //! Missing store is not an error, it simply has no profiles yet
+    Result load(const std::string& utf8Path)
+    {
+        m_path = utf8Path;
+        m_root = { {"version", kTuningProfileVersion}, {"machines", nlohmann::json::object()} };
+        try
+        {
+            auto path = std::filesystem::path((const char8_t*)utf8Path.c_str());
+            std::error_code ec;
+            if (!std::filesystem::exists(path, ec)) return kResultOk;
+            std::ifstream file(path, std::ios::binary);
+            auto root = nlohmann::json::parse(file);
+            if (root.value("version", 0u) != kTuningProfileVersion || !root.contains("machines"))
+            {
+                NVIGI_LOG_WARN("Ignoring tuning profiles '%s' with unknown version", utf8Path.c_str());
+                return kResultOk;
+            }
+            m_root = std::move(root);
+        }
+        catch (std::exception& e)
+        {
+            NVIGI_LOG_WARN("Failed to parse tuning profiles '%s' - %s", utf8Path.c_str(), e.what());
+            return kResultInvalidState;
+        }
+        return kResultOk;
+    }
+
+    //! Write and rename so concurrently starting processes never read a partial store
+    Result save() const
+    {
+        if (m_path.empty()) return kResultInvalidState;
+        auto path = std::filesystem::path((const char8_t*)m_path.c_str());
+        auto tmpPath = path;
+        tmpPath += ".tmp";
+        auto text = m_root.dump(1, ' ', false, nlohmann::json::error_handler_t::replace);
+        std::error_code ec;
+        {
+            std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+            file.write(text.data(), text.size());
+            if (!file) ec = std::make_error_code(std::errc::io_error);
+        }
+        if (!ec) std::filesystem::rename(tmpPath, path, ec);
+        if (ec)
+        {
+            NVIGI_LOG_ERROR("Unable to store tuning profiles '%s' - %s", m_path.c_str(), ec.message().c_str());
+            std::filesystem::remove(tmpPath, ec);
+            return kResultIOError;
+        }
+        return kResultOk;
+    }
+
+    std::optional<TuningProfile> find(const std::string& machine, const char* modelGUID, const PluginID& backend) const
+    {
+        auto models = getModels(machine, modelGUID);
+        auto key = extra::guidToString(backend.id);
+        if (!models || !models->contains(key)) return {};
+        return toTuningProfile((*models)[key]);
+    }
+
+    //! Fastest backend measured for the model on this machine
+    std::optional<TuningProfile> findBest(const std::string& machine, const char* modelGUID) const
+    {
+        auto models = getModels(machine, modelGUID);
+        if (!models) return {};
+        std::optional<TuningProfile> best;
+        for (auto& entry : *models)
+        {
+            auto profile = toTuningProfile(entry);
+            if (!best || profile.requestsPerSecond > best->requestsPerSecond) best = profile;
+        }
+        return best;
+    }
+
+    void store(const std::string& machine, const char* modelGUID, const TuningProfile& profile)
+    {
+        m_root["machines"][machine][modelGUID ? modelGUID : ""][profile.backend] = toJSON(profile);
+    }
+
+private:
+    const nlohmann::json* getModels(const std::string& machine, const char* modelGUID) const
+    {
+        auto& machines = m_root["machines"];
+        if (!machines.contains(machine) || !machines[machine].contains(modelGUID ? modelGUID : "")) return nullptr;
+        return &machines[machine][modelGUID ? modelGUID : ""];
+    }
+
+    std::string m_path;
+    nlohmann::json m_root = { {"version", kTuningProfileVersion}, {"machines", nlohmann::json::object()} };
+};
+
+//! Thread safe lookup used on instance creation, stores are parsed once per process and reloaded when the file changes
+//!
+//! Null 'backend' returns the fastest backend measured for the model
+inline std::optional<TuningProfile> findTunedProfile(const std::string& utf8Path, const char* modelGUID, const PluginID* backend)
+{
+    struct Cache
+    {
+        std::mutex mtx;
+        std::string machine;
+        std::unordered_map<std::string, std::pair<std::filesystem::file_time_type, TuningProfileStore>> stores;
+    };
+    static Cache s_cache;
+
+    std::error_code ec;
+    auto writeTime = std::filesystem::last_write_time(std::filesystem::path((const char8_t*)utf8Path.c_str()), ec);
+    if (ec) return {};
+
+    std::scoped_lock lock(s_cache.mtx);
+    if (s_cache.machine.empty())
+    {
+        auto isystem = system::getInterface();
+        s_cache.machine = getMachineKey(isystem ? isystem->getSystemCaps() : nullptr);
+    }
+    auto it = s_cache.stores.find(utf8Path);
+    if (it == s_cache.stores.end() || it->second.first != writeTime)
+    {
+        TuningProfileStore store;
+        if (store.load(utf8Path) != kResultOk) return {};
+        it = s_cache.stores.insert_or_assign(utf8Path, std::make_pair(writeTime, std::move(store))).first;
+    }
+    return backend ? it->second.second.find(s_cache.machine, modelGUID, *backend) : it->second.second.findBest(s_cache.machine, modelGUID);
+}
+
+//! Profile store path for 'TunedExecutionParameters'
+inline std::string getTuningProfilePath(const TunedExecutionParameters* tuned, const CommonCreationParameters* common)
+{
+    if (tuned && tuned->utf8PathToProfiles) return tuned->utf8PathToProfiles;
+    if (common && common->utf8PathToModels) return std::string(common->utf8PathToModels) + "/" + kTuningProfileFile;
+    return {};
+}
+
+}
+}
@@ -0,0 +1,398 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include "source/utils/nvigi.ai/nvigi_ai.h"
+#include "source/core/nvigi.simd/simd.h"
+
+namespace nvigi
+{
+namespace ai
+{
+
+//! Mean of squared samples, PCM16 is scaled to [-1,1) first
+//!
+//! Falls back to a scalar loop when running on a core without 'ISimd::meanSquare'
+template<typename T>
+inline float meanSquare(const T* samples, size_t count)
+{
+    auto isimd = simd::getInterface();
+    if (isimd && isimd->getVersion() >= kStructVersion3)
+    {
+        if constexpr (std::is_same_v<T, float>) return isimd->meanSquare(samples, count);
+        else return isimd->meanSquarePcm16(samples, count);
+    }
+    if (!count) return 0.0f;
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++)
+    {
+        double v = std::is_same_v<T, float> ? double(samples[i]) : double(samples[i]) / 32768.0;
+        sum += v * v;
+    }
+    return float(sum / double(count));
+}
+
+//! Energy in dBFS, full scale sine is about -3dB, digital silence is clamped to -100dB
+inline float energyToDb(float meanSquare)
+{
+    return 10.0f * std::log10(std::max(meanSquare, 1e-10f));
+}
+
+struct VoiceActivityGateParameters
+{
+    int samplingRate = 16000;
+    //! Energy is measured over frames of this length
+    uint32_t frameMs = 20;
+    //! Forwarded speech is cut into chunks of this length, one evaluation each
+    uint32_t chunkMs = 200;
+    //! Frame is speech when its energy is above max(thresholdDb, noise floor + marginDb), in dBFS
+    float thresholdDb = -50.0f;
+    float marginDb = 12.0f;
+    //! Once a segment is open, frames down to this much below the speech threshold still count as speech
+    float hysteresisDb = 4.0f;
+    //! Consecutive speech frames needed to open a segment, rejects clicks and key presses
+    uint32_t minSpeechMs = 60;
+    //! Audio preceding the detected onset which is forwarded with the first chunk, keeps soft consonants
+    uint32_t preRollMs = 300;
+    //! Silence tolerated before a segment is closed, keeps pauses between words in one segment
+    uint32_t hangoverMs = 500;
+    //! Long segments are split so the instance returns final results regularly, 0 for no limit
+    uint32_t maxSegmentMs = 30000;
+    //! Noise floor tracking per non-speech frame, 0 keeps the floor at 'thresholdDb - marginDb'
+    float noiseAdaptRate = 0.05f;
+};
+
+struct VoiceActivityGateStats
+{
+    uint64_t frames{};
+    uint64_t speechFrames{};
+    uint64_t segments{};
+    //! Samples forwarded in chunks, including pre-roll and hangover
+    uint64_t forwardedSamples{};
+    //! Samples which never reached the instance
+    uint64_t gatedSamples{};
+    float noiseFloorDb{};
+    float lastFrameDb{};
+};
+
+template<typename T>
+struct VoiceActivityChunk
+{
+    StreamSignal signal{};
+    const T* samples{};
+    size_t count{};
+    //! Position of the first sample in the gate input, maps results back to the input timeline
+    uint64_t firstSample{};
+};
+
+//! Energy based voice activity gate for streaming ASR
+//!
+//! Sits between the audio source (chunker, recorder, file) and 'evaluateAsync'. Only speech segments are forwarded,
+//! each one as a stream of chunks marked eStreamSignalStart, eStreamSignalData ... eStreamSignalStop, so the
+//! instance (and the GPU) is busy only while someone is actually talking. Frame energy comes from 'ISimd'.
+//!
+//! Typical flow:
+//!
+//! VoiceActivityGate<int16_t> gate; // 16kHz, 20ms frames, 200ms chunks
+//!
+//! gate.process(samples, count); // any count, e.g. each 'StreamingAudioChunker' window with hop == window
+//! ...
+//! gate.finish(); // end of input, closes an open segment
+//!
+//! InferenceDataAudio slot{};
+//! CpuData data{};
+//! StreamingParameters streaming{};
+//! while (gate.acquire(slot, data, streaming))
+//! {
+//!     ... evaluateAsync with 'slot' and 'streaming' chained to the runtime parameters ...
+//!     gate.release();
+//! }
+//!
+//! Released chunk stays valid until the following one is released, so an evaluation can still read it while
+//! the next chunk is being submitted. Not thread safe, call everything from the thread feeding the instance.
+template<typename T>
+struct VoiceActivityGate
+{
+    static_assert(std::is_same_v<T, int16_t> || std::is_same_v<T, float>, "Supported sample types are PCM16 and FP32");
+
+    VoiceActivityGate(const VoiceActivityGateParameters& params = {}) : parameters(params)
+    {
+        auto toSamples = [this](uint32_t ms)->size_t { return size_t(std::max(parameters.samplingRate, 1)) * ms / 1000; };
+        frameSamples = std::max<size_t>(toSamples(parameters.frameMs), 1);
+        auto toFrames = [this, toSamples](uint32_t ms)->size_t { return (toSamples(ms) + frameSamples - 1) / frameSamples; };
+        chunkSamples = std::max(toSamples(parameters.chunkMs), frameSamples);
+        startFrames = std::max<size_t>(toFrames(parameters.minSpeechMs), 1);
+        hangoverFrames = std::max<size_t>(toFrames(parameters.hangoverMs), 1);
+        maxSegmentSamples = parameters.maxSegmentMs ? std::max(toSamples(parameters.maxSegmentMs), chunkSamples) : 0;
+        historyFrames = toFrames(parameters.preRollMs) + startFrames;
+        history.resize(historyFrames * frameSamples);
+        frame.reserve(frameSamples);
+        noiseFloorDb = parameters.thresholdDb - parameters.marginDb;
+    }
+
+    VoiceActivityGate(const VoiceActivityGate&) = delete;
+    VoiceActivityGate& operator=(const VoiceActivityGate&) = delete;
+
+    //! Analyzes 'count' samples, returns number of chunks ready to be acquired
+    size_t process(const T* samples, size_t count)
+    {
+        while (count)
+        {
+            if (frame.empty() && count >= frameSamples)
+            {
+                // Whole frames are analyzed in place
+                processFrame(samples, frameSamples);
+                samples += frameSamples;
+                count -= frameSamples;
+                continue;
+            }
+            size_t n = std::min(count, frameSamples - frame.size());
+            frame.insert(frame.end(), samples, samples + n);
+            samples += n;
+            count -= n;
+            if (frame.size() == frameSamples)
+            {
+                processFrame(frame.data(), frameSamples);
+                frame.clear();
+            }
+        }
+        return ready.size();
+    }
+
+    //! End of input, an open segment is closed with whatever is left, returns number of chunks ready to be acquired
+    size_t finish()
+    {
+        if (open)
+        {
+            append(frame.data(), frame.size());
+            close();
+        }
+        else
+        {
+            stats.gatedSamples += historyCount * frameSamples + frame.size();
+            historyCount = 0;
+        }
+        position += frame.size();
+        frame.clear();
+        speechRun = 0;
+        return ready.size();
+    }
+
+    bool acquire(VoiceActivityChunk<T>& chunk) const
+    {
+        if (ready.empty()) return false;
+        auto& buffer = ready.front();
+        chunk.signal = buffer.signal;
+        chunk.samples = buffer.samples.data();
+        chunk.count = buffer.samples.size();
+        chunk.firstSample = buffer.firstSample;
+        return true;
+    }
+
+    //! Points 'slot' to the next chunk and sets the matching stream signal, no copies
+    bool acquire(InferenceDataAudio& slot, CpuData& data, StreamingParameters& streaming) const
+    {
+        VoiceActivityChunk<T> chunk{};
+        if (!acquire(chunk)) return false;
+        data.buffer = chunk.samples;
+        data.sizeInBytes = chunk.count * sizeof(T);
+        slot.audio = data;
+        slot.samplingRate = parameters.samplingRate;
+        slot.channels = 1;
+        slot.bitsPerSample = int(sizeof(T) * 8);
+        slot.dataType = std::is_same_v<T, float> ? AudioDataType::eRawFP32 : AudioDataType::ePCM;
+        streaming.signal = chunk.signal;
+        return true;
+    }
+
+    void release()
+    {
+        if (ready.empty()) return;
+        // Chunk released before this one is not referenced by any evaluation anymore, recycle it
+        if (retired.samples.capacity()) pool.push_back(std::move(retired.samples));
+        retired = std::move(ready.front());
+        ready.pop_front();
+    }
+
+    //! True while a segment is open, i.e. the instance is expecting more chunks
+    bool isOpen() const { return open; }
+    size_t getFrameSamples() const { return frameSamples; }
+    size_t getChunkSamples() const { return chunkSamples; }
+    VoiceActivityGateStats getStats() const
+    {
+        auto result = stats;
+        result.noiseFloorDb = noiseFloorDb;
+        return result;
+    }
+
+private:
+
+    struct Buffer
+    {
+        StreamSignal signal{};
+        uint64_t firstSample{};
+        std::vector<T> samples;
+    };
+
+    void processFrame(const T* samples, size_t count)
+    {
+        float db = energyToDb(meanSquare(samples, count));
+        float threshold = std::max(parameters.thresholdDb, noiseFloorDb + parameters.marginDb);
+        stats.frames++;
+        stats.lastFrameDb = db;
+
+        if (!open)
+        {
+            bool speech = db >= threshold;
+            // Speech barely moves the floor so stationary noise above the threshold is absorbed eventually
+            noiseFloorDb += parameters.noiseAdaptRate * (speech ? 0.1f : 1.0f) * (db - noiseFloorDb);
+            if (historyCount == historyFrames)
+            {
+                // Oldest frame falls out of the pre-roll, it is never forwarded
+                historyStart = (historyStart + 1) % historyFrames;
+                historyCount--;
+                stats.gatedSamples += frameSamples;
+            }
+            memcpy(history.data() + ((historyStart + historyCount) % historyFrames) * frameSamples, samples, count * sizeof(T));
+            historyCount++;
+            position += count;
+            speechRun = speech ? speechRun + 1 : 0;
+            if (speechRun >= startFrames)
+            {
+                // Onset, forward the pre-roll and the frames which confirmed it
+                open = true;
+                silenceRun = 0;
+                segmentSamples = 0;
+                nextSignal = StreamSignal::eStreamSignalStart;
+                outputStart = position - historyCount * frameSamples;
+                stats.segments++;
+                for (size_t i = 0; i < historyCount; i++)
+                {
+                    append(history.data() + ((historyStart + i) % historyFrames) * frameSamples, frameSamples);
+                }
+                stats.speechFrames += speechRun;
+                historyStart = 0;
+                historyCount = 0;
+                emitReady();
+            }
+            return;
+        }
+
+        append(samples, count);
+        position += count;
+        if (db >= threshold - parameters.hysteresisDb)
+        {
+            stats.speechFrames++;
+            silenceRun = 0;
+        }
+        else if (++silenceRun >= hangoverFrames)
+        {
+            close();
+            return;
+        }
+        emitReady();
+    }
+
+    void append(const T* samples, size_t count)
+    {
+        output.insert(output.end(), samples, samples + count);
+        segmentSamples += count;
+    }
+
+    void emit(size_t count, StreamSignal signal)
+    {
+        Buffer buffer{};
+        if (!pool.empty())
+        {
+            buffer.samples = std::move(pool.back());
+            pool.pop_back();
+        }
+        buffer.signal = signal;
+        buffer.firstSample = outputStart;
+        buffer.samples.assign(output.begin(), output.begin() + count);
+        output.erase(output.begin(), output.begin() + count);
+        outputStart += count;
+        stats.forwardedSamples += count;
+        ready.push_back(std::move(buffer));
+    }
+
+    //! Start goes out as soon as there is audio, data chunks only while more audio follows so stop is never empty
+    void emitReady()
+    {
+        if (nextSignal == StreamSignal::eStreamSignalStart && !output.empty())
+        {
+            emit(std::min(output.size(), chunkSamples), StreamSignal::eStreamSignalStart);
+            nextSignal = StreamSignal::eStreamSignalData;
+        }
+        while (output.size() > chunkSamples)
+        {
+            if (maxSegmentSamples && segmentSamples - output.size() + chunkSamples >= maxSegmentSamples)
+            {
+                // Split, speech continues in a new segment
+                emit(chunkSamples, StreamSignal::eStreamSignalStop);
+                segmentSamples = output.size();
+                stats.segments++;
+                emit(std::min(output.size(), chunkSamples), StreamSignal::eStreamSignalStart);
+                continue;
+            }
+            emit(chunkSamples, StreamSignal::eStreamSignalData);
+        }
+    }
+
+    void close()
+    {
+        emitReady();
+        size_t padding = output.empty() ? frameSamples : 0;
+        // Start was sent with everything there was, stop has to carry some audio too
+        output.resize(output.size() + padding, T{});
+        emit(output.size(), StreamSignal::eStreamSignalStop);
+        stats.forwardedSamples -= padding;
+        open = false;
+        speechRun = 0;
+        silenceRun = 0;
+    }
+
+    VoiceActivityGateParameters parameters{};
+    size_t frameSamples{};
+    size_t chunkSamples{};
+    size_t startFrames{};
+    size_t hangoverFrames{};
+    size_t maxSegmentSamples{};
+
+    //! Partial frame carried over between 'process' calls
+    std::vector<T> frame;
+    //! Ring of the most recent frames while no segment is open (pre-roll)
+    std::vector<T> history;
+    size_t historyFrames{};
+    size_t historyStart{};
+    size_t historyCount{};
+
+    //! Speech not cut into chunks yet
+    std::vector<T> output;
+    uint64_t outputStart{};
+    uint64_t position{};
+    size_t segmentSamples{};
+
+    bool open = false;
+    StreamSignal nextSignal = StreamSignal::eStreamSignalStart;
+    size_t speechRun{};
+    size_t silenceRun{};
+    float noiseFloorDb{};
+
+    std::deque<Buffer> ready;
+    Buffer retired;
+    std::vector<std::vector<T>> pool;
+    VoiceActivityGateStats stats{};
+};
+
+}
+}
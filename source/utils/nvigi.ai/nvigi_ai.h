@@ -31,6 +31,7 @@ constexpr InferenceExecutionState kInferenceExecutionStateDataPending = 3 << 24;
 constexpr InferenceExecutionState kInferenceExecutionStateDataPartial = 4 << 24; // Partial data, subject to change. This data may be replaced/corrected in subsequent callbacks.
                                                                                    // For example, in ASR as more speech is processed, the context can change allowing the model 
                                                                                    // to "correct" itself, replacing partial data with updated partial or pending data.
+constexpr InferenceExecutionState kInferenceExecutionStateSuspended = 5 << 24;   // Time slice used up, call 'evaluate' again with the same execution context to continue (see 'EvaluationBudgetParameters')
 
 //! NOTE: Careful consideration should be taken when receiving partial data.
 //! 
@@ -194,6 +195,29 @@ struct alignas(8) InferenceDataText {
 
 NVIGI_VALIDATE_STRUCT(InferenceDataText)
 
+//! Length prefixed UTF-8 text, NOT null terminated
+//!
+//! Produced instead of 'InferenceDataText' for streamed text when host asks for it via 'TextStreamingParameters::useTextView',
+//! each result carries only the text appended since the previous result. Text points straight into the plugin's per-evaluation
+//! buffer (no copy) and is valid until the callback returns or the result is released.
+//! 
+//! {D8495BAF-F0F3-4998-94D3-6E2E67E01F29}
+struct alignas(8) InferenceDataTextView {
+    InferenceDataTextView() {};
+    NVIGI_UID(UID({ 0xd8495baf, 0xf0f3, 0x4998,{ 0x94, 0xd3, 0x6e, 0x2e, 0x67, 0xe0, 0x1f, 0x29 } }), kStructVersion1)
+    //! New text, 'length' bytes
+    const char* utf8Text{};
+    size_t length{};
+    //! Byte offset of 'utf8Text' within all text produced by this evaluation, equals the sum of all previous lengths
+    size_t streamOffset{};
+    //! Number of tokens coalesced into this result
+    uint32_t tokenCount{};
+
+    //! v2+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
+};
+
+NVIGI_VALIDATE_STRUCT(InferenceDataTextView)
+
 //! Audio Data Type
 //!
 enum AudioDataType : uint32_t
@@ -254,6 +278,145 @@ struct alignas(8) InferenceDataImage {
 };
 
 NVIGI_VALIDATE_STRUCT(InferenceDataImage)
+
+//! Memory layout of a preprocessed image tensor
+enum class ImageTensorLayout : uint32_t
+{
+    eNCHW,
+    eNHWC
+};
+
+//! ImagePreprocessParameters flags
+enum class ImagePreprocessFlags : uint64_t
+{
+    eNone = 0x00,
+    eFP16 = 0x01,           // Pack the tensor as fp16, fp32 otherwise
+    eSwapRB = 0x02,         // Swap red and blue channels (BGR models)
+    eSRGBToLinear = 0x04,   // Source holds sRGB encoded values which should be linearized before normalization
+    eLinearToSRGB = 0x08,   // Source holds linear values (e.g. HDR render target) which should be sRGB encoded before normalization
+};
+
+NVIGI_ENUM_OPERATORS_64(ImagePreprocessFlags)
+
+//! Interface 'ImagePreprocessParameters'
+//!
+//! Describes how an 'InferenceDataImage' input is converted into the tensor consumed by the model: crop, bilinear resize,
+//! color conversion, per channel normalization 'value = (pixel * scale - mean) / stddev' and packing. Vision plugins fill this
+//! from the model config and run it on the GPU (see 'source/utils/nvigi.d3d12/d3d12_image_preprocess.h') so images which
+//! already live in VRAM never round-trip to system memory.
+//!
+//! Optional - host can chain it with the runtime parameters to override the crop rectangle, zero extent means full image.
+//!
+//! {7C0E5D86-0A0C-4E67-9B0F-2B7D0D5B3E41}
+struct alignas(8) ImagePreprocessParameters
+{
+    ImagePreprocessParameters() { };
+    NVIGI_UID(UID({ 0x7c0e5d86, 0x0a0c, 0x4e67,{ 0x9b, 0x0f, 0x2b, 0x7d, 0x0d, 0x5b, 0x3e, 0x41 } }), kStructVersion1)
+
+    //! Source rectangle in pixels
+    uint32_t cropX{};
+    uint32_t cropY{};
+    uint32_t cropWidth{};
+    uint32_t cropHeight{};
+    //! Output tensor extent, zero keeps the (cropped) source extent
+    uint32_t width{};
+    uint32_t height{};
+    //! Output channels, 1 (luminance), 3 (RGB) or 4 (RGBA)
+    uint32_t channels = 3;
+    ImageTensorLayout layout = ImageTensorLayout::eNCHW;
+    ImagePreprocessFlags flags = ImagePreprocessFlags::eNone;
+    //! Applied to source values in [0,1] range
+    float scale = 1.0f;
+    float mean[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float stddev[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+    //! v2+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
+};
+
+NVIGI_VALIDATE_STRUCT(ImagePreprocessParameters)
+
+//! Standard slot keys for persistent model state (prompt/KV cache snapshots), see 'InferenceDataState'
+//!
+//! Input is optional, plugins which cannot use the provided state (different model, format etc.) ignore it
+//! and process the full input. Output is produced when the host includes the slot in its outputs or,
+//! when plugin allocates the outputs, whenever the plugin supports exporting state.
+//!
+//! CPU state is copied into the host's output blob when it is large enough. Otherwise (GPU state or host buffer
+//! too small) the slot's 'blob' points to plugin owned memory which is only valid until the callback returns,
+//! or until 'releaseResults' in polled mode, afterwards the host's original 'blob' is put back. Host must copy
+//! the state (for example via 'saveInferenceState') before that if it wants to keep it, 'payloadSize' in
+//! the header tells how large its own buffer needs to be next time.
+constexpr const char* kInferenceDataSlotStateIn = "state_in";
+constexpr const char* kInferenceDataSlotStateOut = "state_out";
+
+//! "NVST" in little endian
+constexpr uint32_t kInferenceStateMagic = 0x5453564e;
+
+//! Fixed layout header at the start of CPU resident state blobs
+//!
+//! Blob can be written to disk as is and memory mapped later, payload follows the header immediately.
+struct InferenceStateHeader
+{
+    uint32_t magic = kInferenceStateMagic;
+    uint32_t headerSize = sizeof(InferenceStateHeader);
+    //! Backend specific payload format and its version, plugins reject anything they do not recognize
+    UID format{};
+    uint32_t formatVersion{};
+    uint32_t reserved{};
+    //! Identifies the model the state was produced with, see 'getInferenceStateModelHash'
+    uint64_t modelHash{};
+    //! Number of tokens (or positions) already processed, host only needs to send what comes after
+    uint64_t tokenCount{};
+    uint64_t payloadSize{};
+};
+static_assert(sizeof(InferenceStateHeader) == 56, "State header layout is part of the on-disk format");
+
+//! Interface InferenceDataState
+//!
+//! Versioned snapshot of a model's recurrent/KV state
+//!
+//! 'blob' can point to:
+//!
+//! * CpuData - 'InferenceStateHeader' followed by the payload, for example a memory mapped file
+//! * CudaData, D3D12Data - payload only, stays on the GPU to skip host round trips, described by the members below
+//!
+//! {5B4CB921-980D-4645-9A90-18E4F5045F3D}
+struct alignas(8) InferenceDataState {
+    InferenceDataState() {};
+    NVIGI_UID(UID({ 0x5b4cb921, 0x980d, 0x4645,{ 0x9a, 0x90, 0x18, 0xe4, 0xf5, 0x04, 0x5f, 0x3d } }), kStructVersion1)
+    InferenceDataState(NVIGIParameter* _blob) : blob(_blob) {};
+    NVIGIParameter* blob{};
+    //! Mirrors 'InferenceStateHeader', mandatory for GPU resident blobs
+    UID format{};
+    uint32_t formatVersion{};
+    uint64_t modelHash{};
+    uint64_t tokenCount{};
+
+    //! Header of a CPU resident blob, null if blob is on the GPU or not valid
+    inline const InferenceStateHeader* getHeader() const
+    {
+        const CpuData* data{ castTo<CpuData>(blob) };
+        if (!data || !data->buffer || data->sizeInBytes < sizeof(InferenceStateHeader)) return nullptr;
+        auto header = static_cast<const InferenceStateHeader*>(data->buffer);
+        if (header->magic != kInferenceStateMagic || header->headerSize < sizeof(InferenceStateHeader) || header->headerSize > data->sizeInBytes) return nullptr;
+        if (header->payloadSize > data->sizeInBytes - header->headerSize) return nullptr;
+        return header;
+    }
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
+};
+
+NVIGI_VALIDATE_STRUCT(InferenceDataState)
+
+//! Model identity stored with the state, model GUID and optional model file size are enough to catch stale snapshots
+inline uint64_t getInferenceStateModelHash(const char* modelGUID, uint64_t modelSizeInBytes = 0)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (auto p = modelGUID; p && *p; p++) hash = (hash ^ uint8_t(*p)) * 1099511628211ull;
+    for (int i = 0; i < 8; i++) hash = (hash ^ uint8_t(modelSizeInBytes >> (i * 8))) * 1099511628211ull;
+    return hash;
+}
+
 //! TODO: ADD NEW INFERENCE DATA TYPES HERE
 
 struct InferenceExecutionContext;
@@ -307,6 +470,9 @@ NVIGI_VALIDATE_STRUCT(InferenceExecutionContext)
 
 using InferenceInstanceData = void;
 
+//! Called once a 'swapModel' request completed, 'result' is nvigi::kResultOk if the new model is in use
+using PFun_nvigiModelSwapCallback = void(nvigi::InferenceInstance* instance, nvigi::Result result, void* userData);
+
 //! Inference instance 
 //! 
 //! Contains in/out signatures and the inference execution method
@@ -315,7 +481,7 @@ using InferenceInstanceData = void;
 struct alignas(8) InferenceInstance {
     //! Allow existing code to downgrade version as needed if not planning to implement V2+
     InferenceInstance(uint32_t version = kStructVersion2) { _base.version = version; };
-    NVIGI_UID(UID({ 0xad9dc29c, 0xa89, 0x4a4e,{ 0xb9, 0x0, 0xa7, 0x18, 0x3b, 0x48, 0x33, 0x6e } }), kStructVersion3)
+    NVIGI_UID(UID({ 0xad9dc29c, 0xa89, 0x4a4e,{ 0xb9, 0x0, 0xa7, 0x18, 0x3b, 0x48, 0x33, 0x6e } }), kStructVersion5)
 
     //! Instance data, must be passed as input to all functions below
     InferenceInstanceData* data{};
@@ -370,6 +536,39 @@ struct alignas(8) InferenceInstance {
     //! This method is NOT thread safe.
     nvigi::Result(*cancelAsyncEvaluation)(nvigi::InferenceExecutionContext* execCtx){};
 
+    //! V4
+
+    //! Evaluates multiple execution contexts synchronously, plugins may fuse them into a single forward pass
+    //!
+    //! * All execution contexts MUST use this instance and provide a callback
+    //! * Callbacks are invoked per execution context as each one completes, completion order is not guaranteed
+    //! * Execution contexts MUST be valid until this method returns
+    //! * This method can return nvigi::ResultNoImplementation
+    //!
+    //! This method is NOT thread safe.
+    nvigi::Result(*evaluateBatch)(nvigi::InferenceExecutionContext** execCtxs, size_t count){};
+
+    //! V5
+
+    //! Switches the instance to another model (new model GUID, quantization, LoRA etc.) without destroying it
+    //!
+    //! * New model is loaded on a background thread from 'params' while the instance keeps evaluating with the current one
+    //! * Once loaded, the evaluation in flight (if any) finishes on the current model and every evaluation started after that,
+    //!   including the ones already queued with 'evaluateAsync', uses the new model
+    //! * 'callback' (optional) is called from the background thread with the outcome, on failure the current model is kept
+    //! * 'params' MUST be valid until the instance is destroyed or swapped again, same as creation parameters
+    //! * Per session state (KV cache, history, suspended time sliced evaluation) does not carry over to the new model
+    //! * Priority class and CPU thread budget follow 'params', micro-batching settings cannot change (callback receives
+    //!   nvigi::kResultInvalidParameter)
+    //! * Both models are resident until the switch, VRAM budget must allow for that
+    //! * Returns nvigi::kResultInvalidState if a swap is already in progress
+    //! * This method can return nvigi::ResultNoImplementation
+    //!
+    //! IMPORTANT: 'callback' must not destroy or release the instance
+    //!
+    //! This method is thread safe.
+    nvigi::Result(*swapModel)(nvigi::InferenceInstance* instance, const nvigi::NVIGIParameter* params, PFun_nvigiModelSwapCallback* callback, void* userData){};
+
     //! NEW MEMBERS GO HERE, BUMP THE VERSION IN NVIGI_UID AND CONSTRUCTOR!
 };
 
@@ -380,7 +579,7 @@ NVIGI_VALIDATE_STRUCT(InferenceInstance)
 //! {F0038A35-EEC2-4230-811D-58C9498671BC}
 struct alignas(8) InferenceInterface {
     InferenceInterface() {};
-    NVIGI_UID(UID({ 0xf0038a35, 0xeec2, 0x4230,{ 0x81, 0x1d, 0x58, 0xc9, 0x49, 0x86, 0x71, 0xbc } }), kStructVersion1)
+    NVIGI_UID(UID({ 0xf0038a35, 0xeec2, 0x4230,{ 0x81, 0x1d, 0x58, 0xc9, 0x49, 0x86, 0x71, 0xbc } }), kStructVersion2)
 
     //! Creates new instance
     //!
@@ -433,21 +632,68 @@ struct alignas(8) InferenceInterface {
     //! nvigi::XXXCapabilitiesAndRequirements* caps{};
     //! nvigi::getCapsAndRequirements(ixxx, params, &caps);
     //! 
+    //! NOTE: Returned structure is read only, it stays valid until the plugin is unloaded unless models on disk change
+    //! several times in between, query again after adding or removing models rather than holding on to old results.
+    //!
     //! This method is NOT thread safe.
     nvigi::Result(*getCapsAndRequirements)(nvigi::NVIGIParameter** modelInfo, const nvigi::NVIGIParameter* params);
 
-    //! v2+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
+    //! v2
+
+    //! Returns a pooled instance created with matching parameters or creates a new one
+    //!
+    //! Instances handed back via 'releaseInstance' are kept warm per creation parameter hash and reset
+    //! before they are handed out again, so starting a new session skips model discovery and backend setup.
+    //! Plugins which cannot reset an instance simply create a new one, callers do not need to care.
+    //!
+    //! IMPORTANT: Instance obtained here must be returned via 'releaseInstance' (or destroyed via 'destroyInstance')
+    //!
+    //! This method is thread safe.
+    nvigi::Result(*acquireInstance)(const nvigi::NVIGIParameter* params, nvigi::InferenceInstance** instance);
+
+    //! Hands instance back to the pool, any outstanding async evaluation is cancelled first
+    //!
+    //! Instance is destroyed instead if the pool for its parameters is full or the plugin cannot reset it.
+    //! Idle pooled instances can also be destroyed later when the process goes over its VRAM budget.
+    //!
+    //! This method is thread safe.
+    nvigi::Result(*releaseInstance)(nvigi::InferenceInstance* instance);
+
+    //! Destroys idle instances above 'maxIdleInstances' per creation parameter hash, zero empties the pool
+    //!
+    //! New limit applies to subsequent 'releaseInstance' calls.
+    //!
+    //! This method is thread safe.
+    nvigi::Result(*trimInstancePool)(uint32_t maxIdleInstances);
+
+    //! v3+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
 };
 
 NVIGI_VALIDATE_STRUCT(InferenceInterface)
 
+//! Pooled instance when supported by the plugin interface, regular 'createInstance' otherwise
+inline nvigi::Result acquireInstance(nvigi::InferenceInterface* _interf, const nvigi::NVIGIParameter* params, nvigi::InferenceInstance** instance)
+{
+    if (!_interf) return kResultInvalidParameter;
+    if (_interf->getVersion() >= kStructVersion2 && _interf->acquireInstance) return _interf->acquireInstance(params, instance);
+    return _interf->createInstance(params, instance);
+}
+
+//! Counterpart to 'acquireInstance' above
+inline nvigi::Result releaseInstance(nvigi::InferenceInterface* _interf, nvigi::InferenceInstance* instance)
+{
+    if (!_interf) return kResultInvalidParameter;
+    if (_interf->getVersion() >= kStructVersion2 && _interf->releaseInstance) return _interf->releaseInstance(instance);
+    return _interf->destroyInstance(instance);
+}
+
 //! Interface 'IPolledInferenceInterface'
 //!
 //! {203A2E67-9EA2-47FC-B932-7A3965E608D4}
 struct alignas(8) IPolledInferenceInterface
 {
     IPolledInferenceInterface() { };
-    NVIGI_UID(UID({ 0x203a2e67, 0x9ea2, 0x47fc,{0xb9, 0x32, 0x7a, 0x39, 0x65, 0xe6, 0x08, 0xd4} }), kStructVersion1)
+    NVIGI_UID(UID({ 0x203a2e67, 0x9ea2, 0x47fc,{0xb9, 0x32, 0x7a, 0x39, 0x65, 0xe6, 0x08, 0xd4} }), kStructVersion2)
 
     //! Polls (or blocks) waiting for results to be available
     //!
@@ -477,11 +723,47 @@ struct alignas(8) IPolledInferenceInterface
     //!
     //! This method is thread safe.
     nvigi::Result(*releaseResults)(nvigi::InferenceExecutionContext* execCtx, nvigi::InferenceExecutionState state);
+
+    //! v2
+    //! 
+    //! Returns OS handle which is signaled while results are pending, so that host can wait on many instances at once
+    //! (WaitForMultipleObjects, epoll etc.) and call 'getResults' with wait=false only once the handle fires.
+    //!
+    //! Handle is a manual-reset event HANDLE on Windows and a non-blocking eventfd descriptor on Linux, cast to uint64_t.
+    //! It is level triggered: it stays signaled until the last pending result is released. Results are shared by all
+    //! execution contexts evaluated on the same instance, hence the same handle is returned for all of them.
+    //!
+    //! @param execCtx The execution context passed to evaluate
+    //! @param handle Receives the OS handle, owned by the instance and valid until the instance is destroyed - do NOT close it
+    //! @return nvigi::kResultOk if successful.  Error code otherwise (see NVIGI_result.h for details)
+    //!
+    //! This method is thread safe.
+    nvigi::Result(*getResultsWaitHandle)(nvigi::InferenceExecutionContext* execCtx, uint64_t* handle);
+
+    //! NEW MEMBERS GO HERE, REMEMBER TO BUMP THE VERSION!
 };
 
 NVIGI_VALIDATE_STRUCT(IPolledInferenceInterface)
 
 
+//! Relative priority of inference features running at the same time, see 'CommonCreationParameters::priorityClass'
+//!
+//! Unlike 'SchedulingMode', which balances inference against graphics, this orders inference features against each other
+//! across all plugins. Evaluations wait (at start and at plugin yield points, e.g. between tokens) while an evaluation of
+//! a higher class is running, worker threads and CUDA streams follow the class as well.
+//!
+//! NOTE: D3D12 queues are owned by the host, give realtime features a queue created with D3D12_COMMAND_QUEUE_PRIORITY_HIGH
+enum class InferencePriorityClass : uint32_t
+{
+    //! Latency critical, e.g. ASR while the player is speaking
+    eRealtime,
+    //! Default, e.g. NPC dialog
+    eInteractive,
+    //! Throughput only, e.g. summarization running in the background
+    eBackground,
+    eCount
+};
+
 //! Generic creation parameters - apply to all plugins
 //! 
 //! NOTE: All allocations are managed by the plugin in question and are valid until that plugin is unloaded
@@ -489,7 +771,7 @@ NVIGI_VALIDATE_STRUCT(IPolledInferenceInterface)
 //! {CC8CAD78-95F0-41B0-AD9C-5D6995988B23}
 struct alignas(8) CommonCreationParameters {
     CommonCreationParameters() {};
-    NVIGI_UID(UID({ 0xcc8cad78, 0x95f0, 0x41b0,{ 0xad, 0x9c, 0x5d, 0x69, 0x95, 0x98, 0x8b, 0x23 } }), kStructVersion2)
+    NVIGI_UID(UID({ 0xcc8cad78, 0x95f0, 0x41b0,{ 0xad, 0x9c, 0x5d, 0x69, 0x95, 0x98, 0x8b, 0x23 } }), kStructVersion4)
     //! Relevant only for CPU backends, should be set to 1 for all GPU based backends
     int32_t numThreads = 1;
     //! Now much VRAM is allowed to use
@@ -506,11 +788,287 @@ struct alignas(8) CommonCreationParameters {
     //! JSON model card if model GUID is not used and custom model loading is preferred
     const char* modelCardJSON{};
 
-    //! v3+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
+    //! v3
+
+    //! Optional - dynamic micro-batching of 'evaluateAsync' calls which provide a callback
+    //!
+    //! Requests are collected for up to 'batchWindowUs' after the first one arrives (or until 'maxBatchSize' requests are queued)
+    //! and then evaluated together via the plugin's batched path, see 'InferenceInstance::evaluateBatch'.
+    //! Larger window trades latency for throughput. Zero 'maxBatchSize' (default) disables batching.
+    //!
+    //! NOTE: When batching is enabled 'evaluateAsync' with a callback is thread safe and never returns nvigi::kResultNotReady
+    uint32_t maxBatchSize = 0;
+    uint32_t batchWindowUs = 0;
+
+    //! v4
+
+    //! Optional - priority of this instance relative to other inference features, see 'InferencePriorityClass'
+    InferencePriorityClass priorityClass = InferencePriorityClass::eInteractive;
+
+    //! v5+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
 };
 
 NVIGI_VALIDATE_STRUCT(CommonCreationParameters)
 
+//! Interface 'EvaluationQueueStats'
+//!
+//! Optional - chain with the runtime parameters of an execution context submitted for micro-batching,
+//! filled in right before the execution context is evaluated (see 'CommonCreationParameters::maxBatchSize')
+//! 
+//! {6739F957-0C27-4E0F-8783-5B0137D68B58}
+struct alignas(8) EvaluationQueueStats
+{
+    EvaluationQueueStats() { };
+    NVIGI_UID(UID({ 0x6739f957, 0x0c27, 0x4e0f,{ 0x87, 0x83, 0x5b, 0x01, 0x37, 0xd6, 0x8b, 0x58 } }), kStructVersion1)
+
+    //! Time spent waiting for the batch to be dispatched
+    uint64_t queueWaitUs = 0;
+    //! Number of execution contexts evaluated together, including this one
+    uint32_t batchSize = 0;
+
+    //! v2+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
+};
+
+NVIGI_VALIDATE_STRUCT(EvaluationQueueStats)
+
+//! Interface 'EvaluationGpuTimingStats'
+//!
+//! Optional - chain with the runtime parameters of an execution context to measure how long the evaluation occupied the GPU,
+//! supported by plugins running on D3D12 (timestamp queries) or CUDA (events).
+//!
+//! Values are resolved asynchronously once the GPU is done, which can be after 'kInferenceExecutionStateDone' is reported,
+//! 'resolved' becomes non-zero when all fields are valid.
+//!
+//! IMPORTANT: Must remain valid until resolved or until the instance is destroyed
+//! 
+//! {E6F68424-AE38-41AE-9187-8F7A977DD4F7}
+struct alignas(8) EvaluationGpuTimingStats
+{
+    EvaluationGpuTimingStats() { };
+    NVIGI_UID(UID({ 0xe6f68424, 0xae38, 0x41ae,{ 0x91, 0x87, 0x8f, 0x7a, 0x97, 0x7d, 0xd4, 0xf7 } }), kStructVersion1)
+
+    //! GPU time for this evaluation
+    uint64_t gpuTimeUs = 0;
+    //! Per instance, including this evaluation
+    uint64_t instanceAverageGpuTimeUs = 0;
+    uint64_t instanceMaxGpuTimeUs = 0;
+    uint32_t instanceEvaluationCount = 0;
+    //! Written last (release), read with acquire semantics when polling from another thread
+    uint32_t resolved = 0;
+
+    //! v2+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
+};
+
+NVIGI_VALIDATE_STRUCT(EvaluationGpuTimingStats)
+
+//! What happens when 'evaluateAsync' is called while the evaluation queue is full
+enum class EvaluationQueueOverflowPolicy : uint32_t
+{
+    //! 'evaluateAsync' returns nvigi::kResultNotReady and new inputs are NOT queued
+    eReject,
+    //! Oldest queued execution context is dropped to make room, its callback (if any) receives 'kInferenceExecutionStateCancel'
+    eDropOldest,
+    //! 'evaluateAsync' blocks until there is room in the queue
+    //! 
+    //! NOTE: Requires a callback, polled evaluations fall back to 'eReject' since the host thread must consume results to make room
+    eBlock
+};
+
+//! Interface 'AsyncEvaluationParameters'
+//!
+//! Optional - chain with the creation parameters to control how and where 'evaluateAsync' runs evaluations
+//! 
+//! {FACD5E49-7EC0-413D-A67A-DA32A51BF7CF}
+struct alignas(8) AsyncEvaluationParameters
+{
+    AsyncEvaluationParameters() { };
+    NVIGI_UID(UID({ 0xfacd5e49, 0x7ec0, 0x413d,{ 0xa6, 0x7a, 0xda, 0x32, 0xa5, 0x1b, 0xf7, 0xcf } }), kStructVersion1)
+
+    //! Maximum number of execution contexts waiting for the running evaluation, evaluated back-to-back in FIFO order
+    //! 
+    //! Zero (default) disables queueing, 'evaluateAsync' returns nvigi::kResultNotReady while busy.
+    //! 
+    //! IMPORTANT: Each queued execution context (and its inputs) must remain valid until it is evaluated or dropped
+    uint32_t queueDepth = 0;
+    //! What to do when queue is full
+    EvaluationQueueOverflowPolicy overflowPolicy = EvaluationQueueOverflowPolicy::eReject;
+    //! Run all async evaluations on a long-lived per-instance thread instead of spawning a thread per 'evaluateAsync' call
+    //! 
+    //! NOTE: When running on CUDA the context stays current on that thread across evaluations
+    bool persistentThread = false;
+    //! Number of polled results (no callback provided) which can be outstanding before the evaluation blocks
+    //!
+    //! Zero or one (default) keeps single-slot behavior, each result must be released before the next one is produced.
+    //! With N > 1 host can drain several results per frame by calling 'getResults'/'releaseResults' until nvigi::kResultNotReady,
+    //! 'getResults' points 'execCtx->outputs' to the oldest result.
+    //!
+    //! NOTE: Only applies when plugin allocates the outputs, plugins may also opt out and keep single-slot behavior
+    uint32_t resultRingDepth = 0;
+
+    //! v2+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
+};
+
+NVIGI_VALIDATE_STRUCT(AsyncEvaluationParameters)
+
+//! Host function which runs 'task(taskData)' later on one of the host's threads (job system enqueue etc.)
+//!
+//! IMPORTANT: Must not block and must eventually run every task it accepted, instance destruction waits for them
+using PFun_nvigiExecutorPost = void(void (*task)(void* taskData), void* taskData, void* executorUserData);
+
+//! Interface 'InferenceCallbackExecutor'
+//!
+//! Optional - chain with the runtime parameters so that 'InferenceExecutionContext::callback' never runs on the plugin's
+//! evaluation thread. Each result is posted to the host's executor instead and the callback runs wherever the executor runs it.
+//!
+//! Outputs are handed over without copying, each posted result owns its output slots until its callback returns so they can
+//! be consumed in place on the host's thread without any locking. Callback receives a per-result copy of the execution
+//! context with 'outputs' pointing to these slots. Once 'maxResultsInFlight' results are posted but not executed yet
+//! the evaluation blocks, slow host code throttles the plugin instead of growing memory.
+//!
+//! NOTE: Only applies when plugin allocates the outputs (no 'outputs' provided), cancellation is still reported from the plugin's thread
+//! 
+//! {C285C8B4-1DB3-496E-B008-2DBBF8699152}
+struct alignas(8) InferenceCallbackExecutor
+{
+    InferenceCallbackExecutor() { };
+    NVIGI_UID(UID({ 0xc285c8b4, 0x1db3, 0x496e,{ 0xb0, 0x08, 0x2d, 0xbb, 0xf8, 0x69, 0x91, 0x52 } }), kStructVersion1)
+
+    //! Host's executor, mandatory
+    PFun_nvigiExecutorPost* post{};
+    //! Passed back to 'post' as is
+    void* executorUserData{};
+    //! Number of results posted but not yet executed before evaluation blocks
+    uint32_t maxResultsInFlight = 4;
+
+    //! v2+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
+};
+
+NVIGI_VALIDATE_STRUCT(InferenceCallbackExecutor)
+
+//! Interface 'TextStreamingParameters'
+//!
+//! Optional - chain with the runtime parameters to coalesce streamed text, by default plugins deliver one result per token.
+//!
+//! Text is accumulated and delivered once 'maxTokens' tokens are pending or 'maxIntervalMs' passed since the previous
+//! result (whichever comes first), anything left is delivered when the evaluation finishes. Each result carries only the
+//! newly appended text. Zero disables the respective threshold, both zero delivers every token.
+//! 
+//! {D488DA40-3045-49A5-8D96-6DC2C3ABA059}
+struct alignas(8) TextStreamingParameters
+{
+    TextStreamingParameters() { };
+    NVIGI_UID(UID({ 0xd488da40, 0x3045, 0x49a5,{ 0x8d, 0x96, 0x6d, 0xc2, 0xc3, 0xab, 0xa0, 0x59 } }), kStructVersion1)
+
+    uint32_t maxTokens = 0;
+    uint32_t maxIntervalMs = 0;
+    //! Deliver 'InferenceDataTextView' slots instead of null terminated 'InferenceDataText' copies
+    //!
+    //! NOTE: Only applies when plugin allocates the outputs
+    bool useTextView = false;
+
+    //! v2+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
+};
+
+NVIGI_VALIDATE_STRUCT(TextStreamingParameters)
+
+//! Interface 'EvaluationBudgetParameters'
+//!
+//! Optional - chain with the runtime parameters to time slice a synchronous 'evaluate', for example to advance local GPU
+//! inference on the render thread by a fixed amount each frame.
+//!
+//! Plugin stops at the first safe point (per layer group, per token etc.) after the budget is used up and reports
+//! 'kInferenceExecutionStateSuspended' via callback, 'evaluate' then returns nvigi::kResultOk. Results produced so far are
+//! delivered as usual. Calling 'evaluate' again with the same execution context resumes where the previous call stopped,
+//! 'cancelAsyncEvaluation' drops the suspended evaluation and evaluating any other execution context abandons it.
+//! Zero disables the respective limit. Hosts which do not track callback states can check 'suspended' after each call.
+//!
+//! NOTE: Only applies to 'evaluate', plugins without safe points ignore the budget and finish in one call.
+//!
+//! IMPORTANT: Inputs must remain valid until the evaluation finishes, not just for the duration of one call
+//!
+//! {3B6E0F52-8C1D-4A7E-9F25-61D4C8B0E7A3}
+struct alignas(8) EvaluationBudgetParameters
+{
+    EvaluationBudgetParameters() { };
+    NVIGI_UID(UID({ 0x3b6e0f52, 0x8c1d, 0x4a7e,{ 0x9f, 0x25, 0x61, 0xd4, 0xc8, 0xb0, 0xe7, 0xa3 } }), kStructVersion2)
+
+    //! Wall clock time per call, checked at safe points so a call can overrun by up to one work item
+    uint32_t timeBudgetUs = 0;
+    //! Work items (safe points) per call
+    uint32_t maxWorkItems = 0;
+
+    //! v2+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
+
+    //! Output, set by 'evaluate' before it returns - true while the evaluation is suspended and waits for the next call
+    bool suspended = false;
+
+    //! v3+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
+};
+
+NVIGI_VALIDATE_STRUCT(EvaluationBudgetParameters)
+
+//! Interface 'EvaluationCaptureParameters'
+//!
+//! Optional - chain with the creation parameters to record every evaluation submitted to the instance into a compact binary
+//! capture: CPU resident input slots, supported runtime parameters and the time between calls. Captures are replayed with
+//! the test host (see 'source/tests/ai/replay.h') against any build of the plugin to benchmark real workloads deterministically.
+//!
+//! NOTE: Inputs are copied on the calling thread, meant for profiling sessions and not for shipping builds.
+//! GPU resident inputs and host pointers (callbacks, executors) are not captured.
+//!
+//! {FC0277A1-9AA9-4C75-B42C-94604E5DBF52}
+struct alignas(8) EvaluationCaptureParameters
+{
+    EvaluationCaptureParameters() { };
+    NVIGI_UID(UID({ 0xfc0277a1, 0x9aa9, 0x4c75,{ 0xb4, 0x2c, 0x94, 0x60, 0x4e, 0x5d, 0xbf, 0x52 } }), kStructVersion1)
+
+    //! Capture file, overwritten if it exists
+    const char* utf8PathToCaptureFile{};
+    //! Recording stops once the capture reaches this size
+    uint64_t maxCaptureBytes = 256ull * 1024 * 1024;
+
+    //! v2+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
+};
+
+NVIGI_VALIDATE_STRUCT(EvaluationCaptureParameters)
+
+//! Settings a tuned execution profile can change, see 'TunedExecutionParameters'
+using TunedSettings = uint32_t;
+
+constexpr TunedSettings kTunedSettingNone = 0;
+//! 'CommonCreationParameters::numThreads'
+constexpr TunedSettings kTunedSettingNumThreads = 1 << 0;
+//! 'CommonCreationParameters::maxBatchSize' and 'CommonCreationParameters::batchWindowUs'
+constexpr TunedSettings kTunedSettingBatching = 1 << 1;
+
+//! Interface 'TunedExecutionParameters'
+//!
+//! Optional - chain with the creation parameters to apply the execution profile the test host auto-tuner
+//! (see 'source/tests/ai/tune.h') found best for this plugin, model and machine. Profiles are keyed by the
+//! adapters, driver and CPU so a profile tuned on one machine is never applied on another.
+//!
+//! Settings listed in 'hostOverrides' keep the values from 'CommonCreationParameters'. Without a matching
+//! profile the instance is created exactly as requested. 'SchedulingMode' and backend choice are process wide
+//! decisions, the host reads them with 'ai::findTunedProfile' (see ai_tuning.h) and applies them itself.
+//!
+//! NOTE: Requires 'CommonCreationParameters' v3 or newer
+//!
+//! {37C50971-D986-4981-B55A-098432D1559D}
+struct alignas(8) TunedExecutionParameters
+{
+    TunedExecutionParameters() { };
+    NVIGI_UID(UID({ 0x37c50971, 0xd986, 0x4981,{ 0xb5, 0x5a, 0x09, 0x84, 0x32, 0xd1, 0x55, 0x9d } }), kStructVersion1)
+
+    //! Optional - profile store, defaults to 'nvigi.tuning.json' in 'CommonCreationParameters::utf8PathToModels'
+    const char* utf8PathToProfiles{};
+    //! Settings the host sets explicitly, see 'TunedSettings'
+    TunedSettings hostOverrides = kTunedSettingNone;
+
+    //! v2+ members go here, remember to update the kStructVersionN in the above NVIGI_UID macro!
+};
+
+NVIGI_VALIDATE_STRUCT(TunedExecutionParameters)
+
 //! Model flags
 //! 
 //1 NOTE: Can be custom and declared in plugin headers, please see nvigi::Result to find out how to make custom/unique per plugin flags
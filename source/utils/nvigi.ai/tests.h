@@ -17,6 +17,15 @@
 namespace fs = std::filesystem;
 
 #include "source/utils/nvigi.ai/nvigi_stl_helpers.h"
+#include "source/utils/nvigi.ai/ai_audio_chunker.h"
+#include "source/utils/nvigi.ai/ai_vad.h"
+#include "source/utils/nvigi.ai/ai_audio_codec.h"
+#include "source/utils/nvigi.ai/ai_router.h"
+#include "source/utils/nvigi.ai/ai_pipeline.h"
+#include "source/utils/nvigi.ai/ai_remote.h"
+#include "source/utils/nvigi.ai/ai_provisioning.h"
+#include "source/utils/nvigi.ai/ai_capture.h"
+#include "source/utils/nvigi.ai/ai_tuning.h"
 
 namespace nvigi::stl
 {
@@ -65,6 +74,526 @@ TEST_CASE("InferenceDataAudioSTLHelper", "[stl][audio]")
     REQUIRE(audioData->dataType == nvigi::AudioDataType::ePCM);
 }
 
+TEST_CASE("StreamingAudioChunker", "[ai][audio]")
+{
+    // Small ring so windows wrap around many times
+    nvigi::ai::StreamingAudioChunker<int16_t> chunker(10, 4, 16);
+    std::vector<int16_t> pcm16(1000);
+    for (size_t i = 0; i < pcm16.size(); i++) pcm16[i] = int16_t(i);
+
+    size_t pushed = 0, start = 0, chunks = 0;
+    bool valid = true;
+    while (true)
+    {
+        if (pushed < pcm16.size())
+        {
+            pushed += chunker.push(pcm16.data() + pushed, std::min<size_t>(3, pcm16.size() - pushed));
+            if (pushed == pcm16.size()) chunker.finish();
+        }
+        nvigi::InferenceDataAudio slot{};
+        nvigi::CpuData data{};
+        if (!chunker.acquire(slot, data))
+        {
+            if (chunker.isDone()) break;
+            continue;
+        }
+        REQUIRE(slot.bitsPerSample == 16);
+        auto samples = (const int16_t*)data.buffer;
+        for (size_t i = 0; i < data.sizeInBytes / sizeof(int16_t); i++)
+        {
+            valid &= samples[i] == int16_t(start + i);
+        }
+        start += chunker.getHop();
+        chunks++;
+        chunker.release();
+    }
+    REQUIRE(valid);
+    REQUIRE(chunks == 249); // 248 full windows and a shorter one with the last 8 samples
+    REQUIRE(chunker.getDroppedSampleCount() == 0);
+}
+
+TEST_CASE("VoiceActivityGate", "[ai][audio]")
+{
+    // 1s quiet noise, 1s speech-like tone, 1.5s noise, 0.5s tone at 16kHz
+    std::vector<int16_t> pcm16;
+    uint32_t rng = 1;
+    auto noise = [&](size_t count) { for (size_t i = 0; i < count; i++) { rng = rng * 1664525u + 1013904223u; pcm16.push_back(int16_t(int(rng >> 24) - 128)); } };
+    auto tone = [&](size_t count) { for (size_t i = 0; i < count; i++) pcm16.push_back(int16_t(8000 * std::sin(double(i) * 0.2))); };
+    noise(16000); tone(16000); noise(24000); tone(8000);
+
+    nvigi::ai::VoiceActivityGate<int16_t> gate;
+    std::vector<nvigi::ai::VoiceActivityChunk<int16_t>> chunks;
+    bool valid = true;
+    auto drain = [&]()
+    {
+        nvigi::ai::VoiceActivityChunk<int16_t> chunk{};
+        while (gate.acquire(chunk))
+        {
+            // Chunks carry the input samples unchanged
+            valid &= memcmp(chunk.samples, pcm16.data() + chunk.firstSample, chunk.count * sizeof(int16_t)) == 0;
+            chunks.push_back(chunk);
+            gate.release();
+        }
+    };
+    for (size_t offset = 0; offset < pcm16.size(); offset += 333)
+    {
+        gate.process(pcm16.data() + offset, std::min<size_t>(333, pcm16.size() - offset));
+        drain();
+    }
+    gate.finish();
+    drain();
+    REQUIRE(valid);
+    REQUIRE(!gate.isOpen());
+
+    auto stats = gate.getStats();
+    REQUIRE(stats.segments == 2);
+    REQUIRE(stats.forwardedSamples + stats.gatedSamples == pcm16.size());
+    // Each segment is a complete stream, pre-roll starts it before the onset and hangover ends it after the speech
+    size_t starts = 0;
+    for (size_t i = 0; i < chunks.size(); i++)
+    {
+        auto expected = nvigi::StreamSignal::eStreamSignalData;
+        if (i == 0 || chunks[i - 1].signal == nvigi::StreamSignal::eStreamSignalStop) expected = nvigi::StreamSignal::eStreamSignalStart;
+        else if (i + 1 == chunks.size() || chunks[i + 1].firstSample != chunks[i].firstSample + chunks[i].count) expected = nvigi::StreamSignal::eStreamSignalStop;
+        REQUIRE(chunks[i].signal == expected);
+        if (expected == nvigi::StreamSignal::eStreamSignalStart)
+        {
+            REQUIRE(chunks[i].firstSample < (starts++ ? 56000u : 16000u));
+        }
+    }
+    REQUIRE(chunks.back().firstSample + chunks.back().count == pcm16.size());
+    REQUIRE(chunks[0].firstSample >= 16000 - 8000);
+    // Silence between the segments is never sent
+    REQUIRE(stats.gatedSamples >= 16000);
+}
+
+TEST_CASE("AudioStreamCodec", "[ai][audio]")
+{
+    // One second of 48kHz stereo voice-like tone, captured in uneven chunks
+    std::vector<float> stereo(48000 * 2);
+    for (size_t i = 0; i < 48000; i++)
+    {
+        stereo[i * 2] = stereo[i * 2 + 1] = 0.5f * sinf(2.0f * 3.14159265f * 440.0f * i / 48000.0f);
+    }
+    nvigi::ai::AudioStreamEncoder encoder;
+    std::vector<uint8_t> encoded;
+    for (size_t offset = 0; offset < stereo.size();)
+    {
+        size_t count = std::min<size_t>(1234 * 2, stereo.size() - offset);
+        REQUIRE(encoder.write(stereo.data() + offset, count, 48000, 2, encoded) == nvigi::kResultOk);
+        offset += count;
+    }
+    REQUIRE(encoder.flush(encoded) == nvigi::kResultOk);
+    auto& stats = encoder.getStats();
+    REQUIRE(stats.samples == 16000);
+    REQUIRE(stats.frameLatencyMs == 20.0);
+    // 16kHz ADPCM is 64kbps plus framing, raw upload would be 3072kbps
+    REQUIRE(stats.bitrate < 70000.0);
+    REQUIRE(stats.inputBytes > 40 * stats.outputBytes);
+
+    // Network delivers arbitrary pieces
+    nvigi::ai::AudioStreamDecoder decoder;
+    std::vector<int16_t> decoded;
+    for (size_t offset = 0; offset < encoded.size(); offset += 7)
+    {
+        REQUIRE(decoder.write(encoded.data() + offset, std::min<size_t>(7, encoded.size() - offset), decoded) == nvigi::kResultOk);
+    }
+    REQUIRE(decoder.getSampleRate() == 16000);
+    REQUIRE(decoded.size() == 16000);
+    double error = 0.0, signal = 0.0;
+    for (size_t i = 0; i < decoded.size(); i++)
+    {
+        double expected = 0.5 * 32767.0 * sin(2.0 * 3.14159265 * 440.0 * i / 16000.0);
+        error += (decoded[i] - expected) * (decoded[i] - expected);
+        signal += expected * expected;
+    }
+    REQUIRE(10.0 * log10(signal / error) > 20.0);
+
+    // PCM16 at the input rate is lossless, decoding straight from the network callback
+    nvigi::ai::AudioCodecSettings settings{};
+    settings.codec = nvigi::ai::AudioCodec::ePCM16;
+    settings.sampleRate = 0;
+    nvigi::ai::AudioStreamEncoder pcmEncoder(settings);
+    std::vector<int16_t> pcm16 = { 1, -2, 300, -32768, 32767, 0, 42 };
+    nvigi::InferenceDataAudioSTLHelper audio(pcm16);
+    encoded.clear();
+    REQUIRE(pcmEncoder.write(*(nvigi::InferenceDataAudio*)audio, encoded) == nvigi::kResultOk);
+    REQUIRE(pcmEncoder.flush(encoded) == nvigi::kResultOk);
+    nvigi::ai::AudioStreamDecoder pcmDecoder;
+    std::vector<int16_t> received;
+    pcmDecoder.onSamples = [&received](const int16_t* pcm, size_t count) { received.insert(received.end(), pcm, pcm + count); return true; };
+    REQUIRE(nvigi::ai::AudioStreamDecoder::streamingCallback((const char*)encoded.data(), encoded.size(), &pcmDecoder) == encoded.size());
+    REQUIRE(received == pcm16);
+
+    // Corrupted stream stops the decoder
+    encoded[0] = 'X';
+    nvigi::ai::AudioStreamDecoder corrupted;
+    REQUIRE(corrupted.write(encoded.data(), encoded.size(), received) == nvigi::kResultInvalidState);
+}
+
+TEST_CASE("InferenceRouter", "[ai][router]")
+{
+    // Synchronous v1 backends, first one rejects everything so the router must fail over
+    static nvigi::InferenceInstance rejecting(nvigi::kStructVersion1), accepting(nvigi::kStructVersion1);
+    rejecting.evaluate = [](nvigi::InferenceExecutionContext*)->nvigi::Result { return nvigi::kResultInvalidState; };
+    accepting.evaluate = [](nvigi::InferenceExecutionContext* ctx)->nvigi::Result
+    {
+        ctx->callback(ctx, nvigi::kInferenceExecutionStateDone, ctx->callbackUserData);
+        return nvigi::kResultOk;
+    };
+    nvigi::InferenceInterface local{}, cloud{};
+    local.createInstance = [](const nvigi::NVIGIParameter*, nvigi::InferenceInstance** instance)->nvigi::Result { *instance = &rejecting; return nvigi::kResultOk; };
+    cloud.createInstance = [](const nvigi::NVIGIParameter*, nvigi::InferenceInstance** instance)->nvigi::Result { *instance = &accepting; return nvigi::kResultOk; };
+    local.destroyInstance = cloud.destroyInstance = [](const nvigi::InferenceInstance*)->nvigi::Result { return nvigi::kResultOk; };
+
+    nvigi::ai::InferenceRouter router;
+    nvigi::ai::InferenceRouterBackend backend{};
+    backend.iface = &local;
+    backend.location = nvigi::InferenceBackendLocations::eGPU;
+    backend.priorFirstResultMs = 10.0;
+    REQUIRE(router.addBackend(backend) == nvigi::kResultOk);
+    backend.iface = &cloud;
+    backend.location = nvigi::InferenceBackendLocations::eCloud;
+    backend.priorFirstResultMs = 100.0;
+    REQUIRE(router.addBackend(backend) == nvigi::kResultOk);
+
+    nvigi::InferenceInstance* instance{};
+    REQUIRE(router.createInstance(&instance) == nvigi::kResultOk);
+    uint32_t results = 0;
+    nvigi::InferenceExecutionContext ctx{};
+    ctx.instance = instance;
+    ctx.callbackUserData = &results;
+    ctx.callback = [](const nvigi::InferenceExecutionContext*, nvigi::InferenceExecutionState state, void* userData)->nvigi::InferenceExecutionState
+    {
+        (*(uint32_t*)userData)++;
+        return state;
+    };
+    REQUIRE(instance->evaluate(&ctx) == nvigi::kResultOk);
+    REQUIRE(results == 1);
+
+    auto stats = router.getStats();
+    REQUIRE(stats.size() == 2);
+    REQUIRE(stats[0].failures == 1);
+    REQUIRE(stats[1].wins == 1);
+    REQUIRE(stats[0].inFlight + stats[1].inFlight == 0);
+    REQUIRE(router.destroyInstance(instance) == nvigi::kResultOk);
+}
+
+TEST_CASE("InferenceRouterPrefixAffinity", "[ai][router]")
+{
+    // Two copies of the same model, each evaluation records which copy served it
+    static nvigi::InferenceInstance copies[2] = { nvigi::InferenceInstance(nvigi::kStructVersion1), nvigi::InferenceInstance(nvigi::kStructVersion1) };
+    static uint32_t created = 0;
+    static const nvigi::InferenceInstance* served{};
+    for (auto& copy : copies)
+    {
+        copy.evaluate = [](nvigi::InferenceExecutionContext* ctx)->nvigi::Result
+        {
+            served = ctx->instance;
+            ctx->callback(ctx, nvigi::kInferenceExecutionStateDone, ctx->callbackUserData);
+            return nvigi::kResultOk;
+        };
+    }
+    nvigi::InferenceInterface llm{};
+    llm.createInstance = [](const nvigi::NVIGIParameter*, nvigi::InferenceInstance** instance)->nvigi::Result { *instance = &copies[created++ % 2]; return nvigi::kResultOk; };
+    llm.destroyInstance = [](const nvigi::InferenceInstance*)->nvigi::Result { return nvigi::kResultOk; };
+
+    nvigi::ai::InferenceRouterPolicy policy{};
+    policy.prefixBlockSize = 8;
+    policy.prefixSlots = { "system", "user" };
+    nvigi::ai::InferenceRouter router(policy);
+    nvigi::ai::InferenceRouterBackend backend{};
+    backend.iface = &llm;
+    backend.instanceCount = 2;
+    backend.priorFirstResultMs = 10.0;
+    REQUIRE(router.addBackend(backend) == nvigi::kResultOk);
+    nvigi::InferenceInstance* instance{};
+    REQUIRE(router.createInstance(&instance) == nvigi::kResultOk);
+
+    auto run = [instance](const char* system, const char* user)->const nvigi::InferenceInstance*
+    {
+        nvigi::InferenceDataTextSTLHelper systemText(system), userText(user);
+        std::vector<nvigi::InferenceDataSlot> slots = { {"user", userText}, {"system", systemText} };
+        nvigi::InferenceDataSlotArray inputs(slots.size(), slots.data());
+        nvigi::InferenceExecutionContext ctx{};
+        ctx.instance = instance;
+        ctx.inputs = &inputs;
+        ctx.callback = [](const nvigi::InferenceExecutionContext*, nvigi::InferenceExecutionState state, void*)->nvigi::InferenceExecutionState { return state; };
+        served = nullptr;
+        REQUIRE(instance->evaluate(&ctx) == nvigi::kResultOk);
+        return served;
+    };
+    const char* blacksmith = "Brom, the village blacksmith. You speak briefly and never reveal the secret of the forge.";
+    const char* innkeeper = "Mara, the innkeeper. You gossip about every traveller who passes through the village.";
+    auto first = run(blacksmith, "Can you fix my sword?");
+    // New prefix spreads to the idle copy
+    auto second = run(innkeeper, "Any news?");
+    REQUIRE(first != second);
+    // Same persona sticks to the copy which has it cached
+    REQUIRE(run(blacksmith, "How much for a shield?") == first);
+    REQUIRE(run(innkeeper, "Who came by today?") == second);
+
+    auto stats = router.getStats();
+    REQUIRE(stats.size() == 1);
+    REQUIRE(stats[0].prefixRequests == 4);
+    REQUIRE(stats[0].prefixHits == 2);
+    REQUIRE(stats[0].prefixReusedBytes >= strlen(blacksmith) / 8 * 8);
+    REQUIRE(stats[0].prefixReusedBytes < stats[0].prefixBytes);
+    REQUIRE(stats[0].affinityOverrides == 0);
+    REQUIRE(router.destroyInstance(instance) == nvigi::kResultOk);
+}
+
+TEST_CASE("InferencePipeline", "[ai][pipeline]")
+{
+    // ASR -> LLM -> TTS stand-ins, LLM streams tokens and TTS echoes each sentence it receives
+    static nvigi::InferenceInstance asr(nvigi::kStructVersion1), llm(nvigi::kStructVersion1), tts(nvigi::kStructVersion1);
+    auto emit = [](nvigi::InferenceExecutionContext* ctx, const char* key, const std::string& text, nvigi::InferenceExecutionState state)
+    {
+        nvigi::InferenceDataTextSTLHelper output(text);
+        nvigi::InferenceDataSlot slot(key, output);
+        nvigi::InferenceDataSlotArray outputs(1, &slot);
+        ctx->outputs = &outputs;
+        ctx->callback(ctx, state, ctx->callbackUserData);
+        ctx->outputs = nullptr;
+    };
+    static decltype(emit) s_emit = emit;
+    auto inputText = [](nvigi::InferenceExecutionContext* ctx, const char* key)->std::string
+    {
+        const nvigi::InferenceDataText* text{};
+        if (!ctx->inputs->findAndValidateSlot(key, &text)) return {};
+        return (const char*)castTo<nvigi::CpuData>(text->utf8Text)->buffer;
+    };
+    static decltype(inputText) s_inputText = inputText;
+    asr.evaluate = [](nvigi::InferenceExecutionContext* ctx)->nvigi::Result
+    {
+        auto streaming = findStruct<nvigi::StreamingParameters>(ctx->runtimeParameters);
+        if (!streaming || streaming->signal != nvigi::StreamSignal::eStreamSignalStop) return nvigi::kResultInvalidParameter;
+        s_emit(ctx, "text", s_inputText(ctx, "audio"), nvigi::kInferenceExecutionStateDone);
+        return nvigi::kResultOk;
+    };
+    llm.evaluate = [](nvigi::InferenceExecutionContext* ctx)->nvigi::Result
+    {
+        if (s_inputText(ctx, "system") != "sys" || s_inputText(ctx, "user") != "hello") return nvigi::kResultInvalidParameter;
+        for (auto token : { "Hi.", " How are", " you?", " Pi is 3.14", " ok" })
+        {
+            s_emit(ctx, "response", token, nvigi::kInferenceExecutionStateDataPartial);
+        }
+        s_emit(ctx, "response", "", nvigi::kInferenceExecutionStateDone);
+        return nvigi::kResultOk;
+    };
+    tts.evaluate = [](nvigi::InferenceExecutionContext* ctx)->nvigi::Result
+    {
+        s_emit(ctx, "speech", s_inputText(ctx, "text"), nvigi::kInferenceExecutionStateDone);
+        return nvigi::kResultOk;
+    };
+
+    std::mutex mtx;
+    std::vector<std::string> spoken;
+    nvigi::ai::InferencePipeline pipeline([&](uint32_t stage, const nvigi::InferenceExecutionContext* ctx, nvigi::InferenceExecutionState state)
+    {
+        const nvigi::InferenceDataText* text{};
+        if (stage == 2 && ctx->outputs->findAndValidateSlot("speech", &text))
+        {
+            std::scoped_lock lock(mtx);
+            spoken.push_back((const char*)castTo<nvigi::CpuData>(text->utf8Text)->buffer);
+        }
+        return state;
+    });
+    nvigi::InferenceDataTextSTLHelper system("sys");
+    std::vector<nvigi::InferenceDataSlot> constant = { {"system", system} };
+    nvigi::InferenceDataSlotArray constantInputs(constant.size(), constant.data());
+    uint32_t a{}, l{}, t{};
+    REQUIRE(pipeline.addStage({ &asr, "asr" }, &a) == nvigi::kResultOk);
+    REQUIRE(pipeline.addStage({ &llm, "llm", nullptr, &constantInputs }, &l) == nvigi::kResultOk);
+    REQUIRE(pipeline.addStage({ &tts, "tts" }, &t) == nvigi::kResultOk);
+    REQUIRE(pipeline.bind({ l, "response", a, "user" }) == nvigi::kResultInvalidParameter);
+    REQUIRE(pipeline.bind({ a, "text", l, "user", nvigi::ai::PipelineForwarding::eFinal }) == nvigi::kResultOk);
+    REQUIRE(pipeline.bind({ l, "response", t, "text", nvigi::ai::PipelineForwarding::eSentence }) == nvigi::kResultOk);
+
+    nvigi::StreamingParameters streaming{};
+    streaming.signal = nvigi::StreamSignal::eStreamSignalStop;
+    {
+        // Inputs are copied, nothing has to outlive 'submit'
+        nvigi::InferenceDataTextSTLHelper audio("hello");
+        std::vector<nvigi::InferenceDataSlot> inputs = { {"audio", audio} };
+        nvigi::InferenceDataSlotArray inputArray(inputs.size(), inputs.data());
+        REQUIRE(pipeline.submit(a, &inputArray, &streaming) == nvigi::kResultOk);
+    }
+    pipeline.waitIdle();
+
+    REQUIRE(spoken == std::vector<std::string>{ "Hi.", " How are you?", " Pi is 3.14 ok" });
+    auto stats = pipeline.getStats();
+    REQUIRE(stats.requests == 1);
+    REQUIRE(stats.stages.size() == 3);
+    REQUIRE(stats.stages[0].evaluations == 1);
+    REQUIRE(stats.stages[1].evaluations == 1);
+    REQUIRE(stats.stages[2].evaluations == 3);
+    for (auto& stage : stats.stages)
+    {
+        REQUIRE(stage.failures == 0);
+        REQUIRE(stage.pending == 0);
+    }
+    REQUIRE(stats.lastFirstOutputMs >= stats.stages[1].sinceSubmitMs);
+    REQUIRE(pipeline.addStage({ &tts, "late" }) == nvigi::kResultInvalidState);
+}
+
+TEST_CASE("RemoteInference", "[ai][remote]")
+{
+    // Host and client share this process but talk only through the shared memory channel
+    static nvigi::InferenceInstance echo(nvigi::kStructVersion1);
+    echo.evaluate = [](nvigi::InferenceExecutionContext* ctx)->nvigi::Result
+    {
+        const nvigi::InferenceDataText* text{};
+        if (!ctx->inputs->findAndValidateSlot("prompt", &text)) return nvigi::kResultInvalidParameter;
+        auto streaming = findStruct<nvigi::StreamingParameters>(ctx->runtimeParameters);
+        std::string prompt = text->getUTF8Text();
+        for (size_t i = 0; i < prompt.size(); i += 4)
+        {
+            nvigi::InferenceDataTextSTLHelper output(prompt.substr(i, 4));
+            nvigi::InferenceDataSlot slot("response", output);
+            nvigi::InferenceDataSlotArray outputs(1, &slot);
+            ctx->outputs = &outputs;
+            bool last = i + 4 >= prompt.size();
+            auto state = last && (!streaming || streaming->signal == nvigi::StreamSignal::eStreamSignalStop) ? nvigi::kInferenceExecutionStateDone : nvigi::kInferenceExecutionStateDataPending;
+            auto res = ctx->callback(ctx, state, ctx->callbackUserData);
+            ctx->outputs = nullptr;
+            if (res == nvigi::kInferenceExecutionStateCancel) break;
+        }
+        return nvigi::kResultOk;
+    };
+    nvigi::InferenceInterface iface{};
+    iface.createInstance = [](const nvigi::NVIGIParameter* params, nvigi::InferenceInstance** instance)->nvigi::Result
+    {
+        auto common = findStruct<nvigi::CommonCreationParameters>(params);
+        if (!common || !common->modelGUID || strcmp(common->modelGUID, "{ECHO}")) return nvigi::kResultInvalidParameter;
+        *instance = &echo;
+        return nvigi::kResultOk;
+    };
+    iface.destroyInstance = [](const nvigi::InferenceInstance*)->nvigi::Result { return nvigi::kResultOk; };
+    static const nvigi::PluginID kEcho = { {0x4a1e2f01, 0x7d3b, 0x4c55,{0x9e, 0x21, 0x0b, 0x6f, 0x3a, 0x88, 0xd1, 0x42}}, 0x1a2b3c };
+
+    auto service = nvigi::extra::format("test.{}", nvigi::ipc::getProcessId());
+    nvigi::ai::RemoteInferenceServer server([&iface](const nvigi::PluginID& feature)->nvigi::InferenceInterface*
+    {
+        return feature == kEcho ? &iface : nullptr;
+    });
+    REQUIRE(server.listen(service.c_str()) == nvigi::kResultOk);
+    nvigi::ai::RemoteInferenceServer duplicate([](const nvigi::PluginID&)->nvigi::InferenceInterface* { return nullptr; });
+    REQUIRE(duplicate.listen(service.c_str()) == nvigi::kResultAlreadyExists);
+
+    nvigi::ai::RemoteInferenceClient client;
+    nvigi::ai::RemoteInferenceClientParameters params{};
+    params.service = service.c_str();
+    params.arenaSize = 1 << 16;
+    REQUIRE(client.connect(params) == nvigi::kResultOk);
+
+    nvigi::CommonCreationParameters common{};
+    nvigi::InferenceInstance* instance{};
+    REQUIRE(client.createInstance(kEcho, common, &instance) == nvigi::kResultInvalidParameter);
+    common.modelGUID = "{ECHO}";
+    REQUIRE(client.createInstance(kEcho, common, &instance) == nvigi::kResultOk);
+
+    struct Received
+    {
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::string text;
+        std::thread::id thread;
+        bool done{};
+    } received;
+    nvigi::InferenceDataTextSTLHelper prompt("Hello from the other process!");
+    std::vector<nvigi::InferenceDataSlot> slots = { {"prompt", prompt} };
+    nvigi::InferenceDataSlotArray inputs(slots.size(), slots.data());
+    nvigi::StreamingParameters streaming{};
+    streaming.signal = nvigi::StreamSignal::eStreamSignalStop;
+    nvigi::InferenceExecutionContext ctx{};
+    ctx.instance = instance;
+    ctx.inputs = &inputs;
+    ctx.runtimeParameters = streaming;
+    ctx.callbackUserData = &received;
+    ctx.callback = [](const nvigi::InferenceExecutionContext* ctx, nvigi::InferenceExecutionState state, void* userData)->nvigi::InferenceExecutionState
+    {
+        auto received = (Received*)userData;
+        const nvigi::InferenceDataText* text{};
+        std::scoped_lock lock(received->mtx);
+        if (ctx->outputs && ctx->outputs->findAndValidateSlot("response", &text)) received->text += text->getUTF8Text();
+        received->thread = std::this_thread::get_id();
+        received->done = state == nvigi::kInferenceExecutionStateDone;
+        received->cv.notify_all();
+        return state;
+    };
+
+    // Blocking evaluation runs callbacks on the calling thread
+    REQUIRE(instance->evaluate(&ctx) == nvigi::kResultOk);
+    REQUIRE(received.text == "Hello from the other process!");
+    REQUIRE(received.thread == std::this_thread::get_id());
+    REQUIRE(received.done);
+
+    received.text.clear();
+    received.done = false;
+    REQUIRE(instance->evaluateAsync(&ctx) == nvigi::kResultOk);
+    {
+        std::unique_lock lock(received.mtx);
+        REQUIRE(received.cv.wait_for(lock, std::chrono::seconds(10), [&received]() { return received.done; }));
+        REQUIRE(received.text == "Hello from the other process!");
+    }
+
+    // Streaming parameters are forwarded, evaluation stays open until 'eStreamSignalStop'
+    received.done = false;
+    streaming.signal = nvigi::StreamSignal::eStreamSignalData;
+    REQUIRE(instance->evaluate(&ctx) == nvigi::kResultOk);
+    REQUIRE(!received.done);
+
+    // Only known data types backed by CpuData can cross the process boundary
+    nvigi::InferenceDataByteArray unsupported{};
+    unsupported.bytes = streaming;
+    std::vector<nvigi::InferenceDataSlot> unsupportedSlots = { {"prompt", unsupported} };
+    nvigi::InferenceDataSlotArray unsupportedInputs(unsupportedSlots.size(), unsupportedSlots.data());
+    ctx.inputs = &unsupportedInputs;
+    REQUIRE(instance->evaluate(&ctx) == nvigi::kResultInvalidParameter);
+
+    REQUIRE(server.getClientCount() == 1);
+    REQUIRE(client.destroyInstance(instance) == nvigi::kResultOk);
+    client.disconnect();
+    REQUIRE(!client.isConnected());
+    server.stop();
+    REQUIRE(server.getTotalClientCount() == 1);
+}
+
+TEST_CASE("ModelProvisioningChecksums", "[ai][models]")
+{
+    // Standard CRC-32C check value
+    REQUIRE(nvigi::ai::crc32c(0, "123456789", 9) == 0xe3069283);
+
+    // Ranges hashed independently must combine to the checksum of the whole file
+    std::vector<uint8_t> data(100003);
+    for (size_t i = 0; i < data.size(); i++) data[i] = uint8_t(i * 131 + i / 7);
+    auto full = nvigi::ai::crc32c(0, data.data(), data.size());
+    uint32_t combined = nvigi::ai::crc32c(0, data.data(), 4096);
+    for (size_t offset = 4096; offset < data.size(); offset += 4096)
+    {
+        auto length = std::min<size_t>(4096, data.size() - offset);
+        combined = nvigi::ai::crc32cCombine(combined, nvigi::ai::crc32c(0, data.data() + offset, length), length);
+    }
+    REQUIRE(combined == full);
+
+    json modelInfo = json::parse(R"({
+        "{01234567-0123-0123-0123-0123456789AB}": { "requiresDownload": true, "model": { "download": [
+            { "url": "https://example.com/a.gguf", "file": "a.gguf", "size": 1024, "crc32c": "e3069283" },
+            { "url": "https://example.com/b.gguf", "file": "b.gguf" } ] } },
+        "{11234567-0123-0123-0123-0123456789AB}": { "requiresDownload": false, "model": { "download": [
+            { "url": "https://example.com/c.gguf", "file": "c.gguf" } ] } }
+    })");
+    std::vector<nvigi::ai::ModelFile> files;
+    nvigi::ai::collectModelDownloads(modelInfo, u8"models", files);
+    REQUIRE(files.size() == 2);
+    REQUIRE(files[0].size == 1024);
+    REQUIRE(files[0].crc32c == 0xe3069283);
+    REQUIRE(fs::path(files[0].path).filename() == "a.gguf");
+    REQUIRE(!files[1].size);
+    REQUIRE(!files[1].crc32c);
+}
+
 TEST_CASE("InferenceDataByteArraySTLHelper", "[stl][bytearray]")
 {
     // Test constructors and operators for nvigi::InferenceDataByteArraySTLHelper
@@ -105,6 +634,121 @@ TEST_CASE("InferenceDataByteArraySTLHelper", "[stl][bytearray]")
     REQUIRE(((const uint8_t*)data1->buffer)[3] == 0x04);
     REQUIRE(((const uint8_t*)data1->buffer)[4] == 0x05);
 }
+
+TEST_CASE("EvaluationCapture", "[ai][capture]")
+{
+    auto path = (fs::temp_directory_path() / "nvigi.test.capture.nvec").string();
+
+    nvigi::CommonCreationParameters common{};
+    common.modelGUID = "{01234567-0123-0123-0123-0123456789AB}";
+    common.numThreads = 3;
+    nvigi::PluginID feature{ { 0x01234567, 0x0123, 0x0123, { 0x01, 0x23, 0x01, 0x23, 0x45, 0x67, 0x89, 0xab } }, 0x123456 };
+    nvigi::ai::EvaluationCaptureWriter writer;
+    REQUIRE(writer.open(path.c_str(), feature, &common, 1024 * 1024, nvigi::ai::getCommonCapturedRuntimeParameters()) == nvigi::kResultOk);
+
+    nvigi::InferenceDataTextSTLHelper text("Hello World!");
+    std::vector<float> pcm = { 0.25f, 0.5f, 0.75f };
+    nvigi::InferenceDataAudioSTLHelper audio(pcm, 1);
+    std::vector<nvigi::InferenceDataSlot> slots = { {kTestInputSlotA, text}, {kTestInputSlotBA, audio} };
+    nvigi::InferenceDataSlotArray inputs = { slots.size(), slots.data() };
+    nvigi::TextStreamingParameters streaming{};
+    streaming.maxTokens = 8;
+    nvigi::InferenceExecutionContext execCtx{};
+    execCtx.inputs = &inputs;
+    execCtx.runtimeParameters = streaming;
+
+    nvigi::InferenceExecutionContext* batch[] = { &execCtx, &execCtx };
+    writer.record(nvigi::ai::CapturedCallKind::eEvaluateAsync, batch, 1);
+    writer.record(nvigi::ai::CapturedCallKind::eEvaluateBatch, batch, 2);
+    writer.close();
+
+    nvigi::ai::EvaluationCapture capture{};
+    REQUIRE(nvigi::ai::loadEvaluationCapture(path.c_str(), capture) == nvigi::kResultOk);
+    REQUIRE(capture.feature.crc24 == feature.crc24);
+    REQUIRE(capture.modelGUID == common.modelGUID);
+    REQUIRE(capture.numThreads == 3);
+    REQUIRE(capture.calls.size() == 2);
+    REQUIRE(capture.calls[0].kind == nvigi::ai::CapturedCallKind::eEvaluateAsync);
+    REQUIRE(capture.calls[1].contexts.size() == 2);
+
+    auto& ctx = *capture.calls[1].contexts[1];
+    const nvigi::InferenceDataText* replayedText{};
+    REQUIRE(ctx.getInputs()->findAndValidateSlot(kTestInputSlotA, &replayedText));
+    REQUIRE(std::string(replayedText->getUTF8Text()) == "Hello World!");
+    const nvigi::InferenceDataAudio* replayedAudio{};
+    REQUIRE(ctx.getInputs()->findAndValidateSlot(kTestInputSlotBA, &replayedAudio));
+    auto samples = nvigi::castTo<nvigi::CpuData>(replayedAudio->audio);
+    REQUIRE(samples->sizeInBytes == pcm.size() * sizeof(float));
+    REQUIRE(((const float*)samples->buffer)[2] == 0.75f);
+    auto replayedStreaming = nvigi::findStruct<nvigi::TextStreamingParameters>(ctx.getRuntimeParameters());
+    REQUIRE(replayedStreaming != nullptr);
+    REQUIRE(replayedStreaming->maxTokens == 8);
+
+    fs::remove(path);
+}
+
+TEST_CASE("TuningProfileStore", "[ai][tuning]")
+{
+    auto path = (fs::temp_directory_path() / "nvigi.test.tuning.json").string();
+    fs::remove(path);
+    const char* modelGUID = "{01234567-0123-0123-0123-0123456789AB}";
+    nvigi::PluginID cpu{ { 0x01234567, 0x0123, 0x0123, { 0x01, 0x23, 0x01, 0x23, 0x45, 0x67, 0x89, 0xab } }, 0x123456 };
+    nvigi::PluginID gpu{ { 0x76543210, 0x3210, 0x3210, { 0x01, 0x23, 0x01, 0x23, 0x45, 0x67, 0x89, 0xab } }, 0x654321 };
+
+    // Missing store is empty, not an error
+    nvigi::ai::TuningProfileStore store;
+    REQUIRE(store.save() == nvigi::kResultInvalidState);
+    REQUIRE(store.load(path) == nvigi::kResultOk);
+    REQUIRE(!store.find("machine", modelGUID, cpu));
+    REQUIRE(!store.findBest("machine", modelGUID));
+
+    nvigi::ai::TuningProfile slow{};
+    slow.backend = nvigi::extra::guidToString(cpu.id);
+    slow.numThreads = 8;
+    slow.maxBatchSize = 2;
+    slow.batchWindowUs = 250;
+    slow.mode = "async";
+    slow.requestsPerSecond = 10.0;
+    nvigi::ai::TuningProfile fast = slow;
+    fast.backend = nvigi::extra::guidToString(gpu.id);
+    fast.numThreads = 1;
+    fast.requestsPerSecond = 100.0;
+    store.store("machine", modelGUID, slow);
+    store.store("machine", modelGUID, fast);
+    REQUIRE(store.save() == nvigi::kResultOk);
+    REQUIRE(!fs::exists(path + ".tmp"));
+
+    nvigi::ai::TuningProfileStore loaded;
+    REQUIRE(loaded.load(path) == nvigi::kResultOk);
+    auto found = loaded.find("machine", modelGUID, cpu);
+    REQUIRE(found);
+    REQUIRE(found->numThreads == 8);
+    REQUIRE(found->maxBatchSize == 2);
+    REQUIRE(found->batchWindowUs == 250);
+    REQUIRE(found->mode == "async");
+    auto best = loaded.findBest("machine", modelGUID);
+    REQUIRE(best);
+    REQUIRE(best->backend == fast.backend);
+    // Profiles never leak to other machines or models
+    REQUIRE(!loaded.find("other machine", modelGUID, cpu));
+    REQUIRE(!loaded.find("machine", "{76543210-3210-3210-0123-0123456789AB}", cpu));
+
+    // Unknown version is ignored, corrupt store is an error
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << R"({"version": 999, "machines": {}})";
+    }
+    REQUIRE(loaded.load(path) == nvigi::kResultOk);
+    REQUIRE(!loaded.find("machine", modelGUID, cpu));
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << "{ not json";
+    }
+    REQUIRE(loaded.load(path) == nvigi::kResultInvalidState);
+
+    fs::remove(path);
+}
+
 } // namespace nvigi::stl
 
 #ifdef NVIGI_WINDOWS
@@ -278,4 +922,129 @@ TEST_CASE("processDirectory", "[ai][models]")
     }
 }
 
-#endif // NVIGI_WINDOWS
\ No newline at end of file
+TEST_CASE("ModelDirectoryStamp", "[ai][models]")
+{
+    auto root = fs::temp_directory_path() / "nvigi.test.stamp";
+    fs::remove_all(root);
+    fs::create_directories(root / "{A}");
+    {
+        std::ofstream card(root / "{A}" / "nvigi.model.config.json");
+        card << "{}";
+    }
+    auto directory = root.u8string();
+    auto stamp = nvigi::ai::getModelDirectoryStamp(directory);
+    REQUIRE(nvigi::ai::getModelDirectoryStamp(directory) == stamp);
+    REQUIRE(stamp == nvigi::ai::computeModelDirectoryStamp(directory));
+
+    // Model added at the top level is picked up without waiting for the cached stamp to expire
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    fs::create_directories(root / "{B}");
+    auto added = nvigi::ai::getModelDirectoryStamp(directory);
+    REQUIRE(added != stamp);
+    REQUIRE(added == nvigi::ai::computeModelDirectoryStamp(directory));
+
+    fs::remove_all(root);
+}
+
+TEST_CASE("CapsCache", "[ai][models]")
+{
+    std::vector<std::string> names = { "a", "b" };
+    std::vector<const char*> namePtrs = { names[0].c_str(), names[1].c_str() };
+    const char* guids[] = { "{A}", "{B}" };
+    size_t vrams[] = { 100, 200 };
+    nvigi::CommonCapabilitiesAndRequirements caps{};
+    caps.numSupportedModels = 2;
+    caps.supportedModelNames = namePtrs.data();
+    caps.supportedModelGUIDs = guids;
+    caps.modelMemoryBudgetMB = vrams;
+
+    nvigi::ai::CapsCache cache;
+    REQUIRE(cache.find("key", 1) == nullptr);
+    auto snapshot = cache.insert("key", 1, caps);
+    // Snapshot owns its data, plugin is free to reuse its buffers
+    names[0] = "changed";
+    namePtrs[0] = names[0].c_str();
+    REQUIRE(std::string(snapshot->caps.supportedModelNames[0]) == "a");
+    REQUIRE(snapshot->caps.supportedModelNames != caps.supportedModelNames);
+    REQUIRE(snapshot->caps.modelMemoryBudgetMB[1] == 200);
+    REQUIRE(cache.find("key", 1) == snapshot);
+    // Stamp changed, same content keeps the same snapshot
+    REQUIRE(cache.find("key", 2) == nullptr);
+    namePtrs[0] = "a";
+    REQUIRE(cache.insert("key", 2, caps) == snapshot);
+    // Different content replaces the entry, old snapshot stays valid
+    vrams[0] = 50;
+    auto updated = cache.insert("key", 3, caps);
+    REQUIRE(updated != snapshot);
+    REQUIRE(updated->caps.modelMemoryBudgetMB[0] == 50);
+    REQUIRE(snapshot->caps.modelMemoryBudgetMB[0] == 100);
+    REQUIRE(cache.find("key", 3) == updated);
+
+    // Chained caps are copied, plugin can reuse its strings
+    std::string url = "https://a";
+    nvigi::CloudCapabilities cloud{};
+    cloud.url = url.c_str();
+    caps._base.next = cloud;
+    auto chained = cache.insert("key", 4, caps);
+    REQUIRE(chained != updated);
+    auto copy = nvigi::findStruct<nvigi::CloudCapabilities>(chained->caps);
+    REQUIRE(copy);
+    REQUIRE(copy != &cloud);
+    REQUIRE(std::string(copy->url) == "https://a");
+    REQUIRE(copy->jsonRequestBody == nullptr);
+    REQUIRE(cache.insert("key", 5, caps) == chained);
+    url = "https://b";
+    cloud.url = url.c_str();
+    REQUIRE(std::string(copy->url) == "https://a");
+    REQUIRE(cache.insert("key", 6, caps) != chained);
+
+    // Only the last few retired snapshots are kept, the current one is always valid
+    for (size_t i = 0; i < nvigi::ai::kMaxRetiredCapsSnapshots * 2; i++)
+    {
+        vrams[0] = 1000 + i;
+        auto latest = cache.insert("key", 7 + i, caps);
+        REQUIRE(latest->caps.modelMemoryBudgetMB[0] == 1000 + i);
+    }
+    cache.clear();
+    REQUIRE(cache.find("key", 6 + nvigi::ai::kMaxRetiredCapsSnapshots * 2) == nullptr);
+}
+
+TEST_CASE("PromptTemplate", "[ai][prompt]")
+{
+    json model = json::parse(R"({"prompt_template": ["<s>", "[SYS]", "$system", "[/SYS]", "$user", "\n", "$assistant"], "turn_template": ["[U]", "$user", "[A]", "$assistant"]})");
+    std::string system = "You are a blacksmith in a small village.";
+
+    nvigi::ai::PromptTemplate prompt;
+    REQUIRE(prompt.compile(model, nvigi::ai::PromptTemplate::Kind::ePrompt) == nvigi::kResultOk);
+    REQUIRE(prompt.isCompiled());
+    auto& first = prompt.render(system, "Hello", "");
+    REQUIRE(first == "<s>[SYS]" + system + "[/SYS]Hello\n");
+    REQUIRE(first == nvigi::ai::generatePrompt(model, system, "Hello", ""));
+    REQUIRE(prompt.getStablePrefixLength() == 0);
+
+    // Same system prompt, only the user part differs
+    auto& second = prompt.render(system, "Help me", "");
+    REQUIRE(prompt.getStablePrefixLength() == std::string("<s>[SYS]" + system + "[/SYS]Hel").size());
+    REQUIRE(second.compare(prompt.getStablePrefixLength(), std::string::npos, "p me\n") == 0);
+    prompt.render(system, "Help me", "");
+    REQUIRE(prompt.getStablePrefixLength() == second.size());
+
+    // Prefix never splits a UTF-8 sequence, both strings start with the 0xC3 lead byte
+    prompt.render(system, "\xC3\xA9", "");
+    prompt.render(system, "\xC3\xA8", "");
+    REQUIRE(prompt.getStablePrefixLength() == std::string("<s>[SYS]" + system + "[/SYS]").size());
+
+    prompt.reset();
+    prompt.render(system, "Hello", "");
+    REQUIRE(prompt.getStablePrefixLength() == 0);
+
+    nvigi::ai::PromptTemplate turn;
+    REQUIRE(turn.compile(model, nvigi::ai::PromptTemplate::Kind::eTurn) == nvigi::kResultOk);
+    REQUIRE(turn.render({}, "Hi", "Hey") == "[U]Hi[A]Hey");
+    REQUIRE(nvigi::ai::generateTurn(json::object(), "Hi", "") == "\nInstruct:Hi\nOutput:");
+
+    REQUIRE(prompt.compile(json::parse(R"({"prompt_template": "oops"})"), nvigi::ai::PromptTemplate::Kind::ePrompt) == nvigi::kResultInvalidParameter);
+    REQUIRE(!prompt.isCompiled());
+}
+
+#endif // NVIGI_WINDOWS
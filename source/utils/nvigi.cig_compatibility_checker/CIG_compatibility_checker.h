@@ -13,6 +13,8 @@
 #include <cstdio>
 #include <cstring>
 #include <cstdlib>
+#include <string>
+#include <algorithm>
 
 #if WITHOUT_IGI
 #include <windows.h>
@@ -109,6 +111,43 @@ namespace CIGCompatibilityChecker
 #endif
     CigSchedulerSettingsAPI sched{};
 
+    // Profiler mode reuses the same CUPTI subscription, kernels are recorded with
+    // their launch attribution so slow kernels can be found without Nsight
+    struct KernelRecord
+    {
+        std::string name;
+        // CUPTI timestamps in ns
+        uint64_t start;
+        uint64_t end;
+        uint32_t grid[3];
+        uint32_t block[3];
+        uint32_t contextId;
+        uint32_t streamId;
+        uint32_t sharedMemBytes;
+        uint32_t registersPerThread;
+        // 0 if launched outside of any ProfileScope
+        uint64_t evaluation;
+    };
+
+    struct ProfileEvaluation
+    {
+        std::string plugin;
+        const void* instance;
+    };
+
+    struct ProfilerState
+    {
+        std::atomic<bool> enabled = false;
+        // Separate from CheckerState::mutex since check() flushes activity buffers while holding that one
+        std::mutex mutex;
+        std::vector<KernelRecord> kernels;
+        // Evaluation N is at index N - 1
+        std::vector<ProfileEvaluation> evaluations;
+        std::unordered_map<uint32_t, uint64_t> correlationToEvaluation;
+    };
+    ProfilerState gProfilerState;
+    thread_local uint64_t tCurrentEvaluation = 0;
+
 #define checkCuErrors(err)  __checkCuErrors (err, __FILE__, __LINE__)
     inline void __checkCuErrors(CUresult err, const char* file, const int line)
     {
@@ -895,6 +934,32 @@ namespace CIGCompatibilityChecker
         *pMaxNumRecords = 0;
     }
 
+    // Called for every kernel activity record while profiling is enabled
+    void recordKernel(const CUpti_ActivityKernel9* pKernelRecord)
+    {
+        const std::lock_guard<std::mutex> lock(gProfilerState.mutex);
+
+        KernelRecord record{};
+        record.name = pKernelRecord->name ? pKernelRecord->name : "<unknown>";
+        record.start = pKernelRecord->start;
+        record.end = pKernelRecord->end;
+        record.grid[0] = (uint32_t)pKernelRecord->gridX;
+        record.grid[1] = (uint32_t)pKernelRecord->gridY;
+        record.grid[2] = (uint32_t)pKernelRecord->gridZ;
+        record.block[0] = (uint32_t)pKernelRecord->blockX;
+        record.block[1] = (uint32_t)pKernelRecord->blockY;
+        record.block[2] = (uint32_t)pKernelRecord->blockZ;
+        record.contextId = pKernelRecord->contextId;
+        record.streamId = pKernelRecord->streamId;
+        record.sharedMemBytes = pKernelRecord->staticSharedMemory + pKernelRecord->dynamicSharedMemory;
+        record.registersPerThread = pKernelRecord->registersPerThread;
+
+        // Kernels from a graph launch all share the correlation id of cuGraphLaunch
+        auto iter = gProfilerState.correlationToEvaluation.find(pKernelRecord->correlationId);
+        record.evaluation = iter != gProfilerState.correlationToEvaluation.end() ? iter->second : 0;
+        gProfilerState.kernels.push_back(std::move(record));
+    }
+
     // Process a single activity record from CUPTI
     void processActivity(
         CUpti_Activity* pRecord,
@@ -907,6 +972,11 @@ namespace CIGCompatibilityChecker
         {
             CUpti_ActivityKernel9* pKernelRecord = (CUpti_ActivityKernel9*)pRecord;
 
+            if (gProfilerState.enabled)
+            {
+                recordKernel(pKernelRecord);
+            }
+
             uint32_t totalSharedMemBytes = pKernelRecord->staticSharedMemory +
                 pKernelRecord->dynamicSharedMemory;
 
@@ -1003,6 +1073,19 @@ namespace CIGCompatibilityChecker
         {
             if (pCallbackData->callbackSite == CUPTI_API_ENTER)
             {
+                if (gProfilerState.enabled && tCurrentEvaluation &&
+                    (callbackId == CUPTI_DRIVER_TRACE_CBID_cuLaunchKernel ||
+                    callbackId == CUPTI_DRIVER_TRACE_CBID_cuLaunchKernel_ptsz ||
+                    callbackId == CUPTI_DRIVER_TRACE_CBID_cuLaunchKernelEx ||
+                    callbackId == CUPTI_DRIVER_TRACE_CBID_cuLaunchKernelEx_ptsz ||
+                    callbackId == CUPTI_DRIVER_TRACE_CBID_cuGraphLaunch ||
+                    callbackId == CUPTI_DRIVER_TRACE_CBID_cuGraphLaunch_ptsz))
+                {
+                    // Launch happens on the calling thread, activity records arrive later without any thread information
+                    const std::lock_guard<std::mutex> lock(gProfilerState.mutex);
+                    gProfilerState.correlationToEvaluation[pCallbackData->correlationId] = tCurrentEvaluation;
+                }
+
                 if (callbackId == CUPTI_DRIVER_TRACE_CBID_cuMemcpyHtoD || // 43
                     callbackId == CUPTI_DRIVER_TRACE_CBID_cu64MemcpyHtoD || // 44
                     callbackId == CUPTI_DRIVER_TRACE_CBID_cuMemcpyDtoH || // 45
@@ -1330,6 +1413,192 @@ namespace CIGCompatibilityChecker
             gCheckerState.launchesOfType[i] = 0;
         }
     }
+
+    // Profiler mode
+    //
+    // Enable after init() and wrap the calls to profile (typically evaluate) in a ProfileScope, kernels are
+    // collected until check() unsubscribes from CUPTI. Results remain available after check().
+    //
+    // CIGCompatibilityChecker::enableProfiling(true);
+    // {
+    //     CIGCompatibilityChecker::ProfileScope scope("nvigi.plugin.gpt.ggml.cuda", instance);
+    //     igpt->evaluate(instance);
+    // }
+    // CIGCompatibilityChecker::printProfile();
+    // CIGCompatibilityChecker::writeChromeTrace("gpt_kernels.json");
+    void enableProfiling(bool enable)
+    {
+        gProfilerState.enabled = enable;
+    }
+
+    void resetProfile()
+    {
+        const std::lock_guard<std::mutex> lock(gProfilerState.mutex);
+        gProfilerState.kernels.clear();
+        gProfilerState.evaluations.clear();
+        gProfilerState.correlationToEvaluation.clear();
+    }
+
+    // Attributes all kernels launched on this thread during its lifetime to the given plugin and instance,
+    // each scope is reported as a separate evaluation
+    struct ProfileScope
+    {
+        ProfileScope(const char* plugin, const void* instance = nullptr) : previous(tCurrentEvaluation)
+        {
+            if (!gProfilerState.enabled) return;
+
+            const std::lock_guard<std::mutex> lock(gProfilerState.mutex);
+            gProfilerState.evaluations.push_back({ plugin ? plugin : "", instance });
+            tCurrentEvaluation = gProfilerState.evaluations.size();
+        }
+        ~ProfileScope()
+        {
+            tCurrentEvaluation = previous;
+        }
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+        uint64_t previous;
+    };
+
+    // Activity records are delivered in batches, make sure everything launched so far is recorded
+    void flushProfile()
+    {
+#ifndef NVIGI_DISABLE_CUPTI
+        cuptiActivityFlushAll(1);
+#endif
+    }
+
+    // Prints GPU time per evaluation followed by its most expensive kernels
+    void printProfile(size_t topKernels = 5)
+    {
+        flushProfile();
+        const std::lock_guard<std::mutex> lock(gProfilerState.mutex);
+
+        struct KernelTotals
+        {
+            uint64_t ns = 0;
+            size_t count = 0;
+        };
+        struct EvaluationTotals
+        {
+            uint64_t busyNs = 0;
+            uint64_t first = UINT64_MAX;
+            uint64_t last = 0;
+            size_t count = 0;
+            std::unordered_map<std::string, KernelTotals> kernels;
+        };
+        std::vector<EvaluationTotals> totals(gProfilerState.evaluations.size() + 1);
+        for (const KernelRecord& record : gProfilerState.kernels)
+        {
+            EvaluationTotals& evaluation = totals[record.evaluation];
+            uint64_t ns = record.end - record.start;
+            evaluation.busyNs += ns;
+            evaluation.first = std::min(evaluation.first, record.start);
+            evaluation.last = std::max(evaluation.last, record.end);
+            evaluation.count++;
+            KernelTotals& kernel = evaluation.kernels[record.name];
+            kernel.ns += ns;
+            kernel.count++;
+        }
+
+        printf("CIG Profile: %zu kernels in %zu evaluations\n", gProfilerState.kernels.size(), gProfilerState.evaluations.size());
+        for (size_t i = 0; i != totals.size(); i++)
+        {
+            EvaluationTotals& evaluation = totals[i];
+            if (evaluation.count == 0) continue;
+
+            if (i == 0)
+            {
+                printf("  Unattributed:");
+            }
+            else
+            {
+                const ProfileEvaluation& info = gProfilerState.evaluations[i - 1];
+                printf("  Evaluation %zu (%s, instance %p):", i, info.plugin.c_str(), info.instance);
+            }
+            // Busy is the sum of kernel durations, span also includes gaps between them
+            printf(" %zu kernels, GPU busy %.3f ms, span %.3f ms\n", evaluation.count,
+                evaluation.busyNs / 1e6, (evaluation.last - evaluation.first) / 1e6);
+
+            std::vector<std::pair<std::string, KernelTotals>> sorted(evaluation.kernels.begin(), evaluation.kernels.end());
+            std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.second.ns > b.second.ns; });
+            for (size_t k = 0; k != std::min(topKernels, sorted.size()); k++)
+            {
+                const auto& [name, kernel] = sorted[k];
+                printf("    %6.2f%% %10.3f ms %6zux  %s\n", evaluation.busyNs ? 100.0 * kernel.ns / evaluation.busyNs : 0.0,
+                    kernel.ns / 1e6, kernel.count, name.c_str());
+            }
+        }
+    }
+
+    // Writes all recorded kernels in Chrome trace event format (chrome://tracing, Perfetto),
+    // one process per CUDA context and one thread per stream
+    bool writeChromeTrace(const char* path)
+    {
+        flushProfile();
+        const std::lock_guard<std::mutex> lock(gProfilerState.mutex);
+
+        FILE* file = nullptr;
+        if (fopen_s(&file, path, "wt") != 0 || !file)
+        {
+            printf("CIG Profile Error: unable to open '%s' for writing\n", path);
+            return false;
+        }
+
+        auto writeEscaped = [file](const std::string& text)
+        {
+            for (char c : text)
+            {
+                if (c == '"' || c == '\\') fputc('\\', file);
+                if ((unsigned char)c >= 0x20) fputc(c, file);
+            }
+        };
+
+        uint64_t origin = UINT64_MAX;
+        for (const KernelRecord& record : gProfilerState.kernels)
+        {
+            origin = std::min(origin, record.start);
+        }
+
+        fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+        std::unordered_set<uint64_t> namedThreads;
+        bool first = true;
+        for (const KernelRecord& record : gProfilerState.kernels)
+        {
+            uint64_t thread = ((uint64_t)record.contextId << 32) | record.streamId;
+            if (namedThreads.insert(thread).second)
+            {
+                fprintf(file, "%s{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%u,\"args\":{\"name\":\"CUDA context %u\"}},\n",
+                    first ? "" : ",", record.contextId, record.contextId);
+                fprintf(file, "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"Stream %u\"}}",
+                    record.contextId, record.streamId, record.streamId);
+                first = false;
+            }
+
+            fprintf(file, "%s{\"ph\":\"X\",\"cat\":\"kernel\",\"name\":\"", first ? "" : ",\n");
+            first = false;
+            writeEscaped(record.name);
+            fprintf(file, "\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"grid\":\"%u,%u,%u\",\"block\":\"%u,%u,%u\","
+                "\"sharedMemBytes\":%u,\"registersPerThread\":%u,\"evaluation\":%llu",
+                record.contextId, record.streamId, (record.start - origin) / 1e3, (record.end - record.start) / 1e3,
+                record.grid[0], record.grid[1], record.grid[2], record.block[0], record.block[1], record.block[2],
+                record.sharedMemBytes, record.registersPerThread, (unsigned long long)record.evaluation);
+            if (record.evaluation)
+            {
+                const ProfileEvaluation& info = gProfilerState.evaluations[record.evaluation - 1];
+                fprintf(file, ",\"plugin\":\"");
+                writeEscaped(info.plugin);
+                fprintf(file, "\",\"instance\":\"%p\"", info.instance);
+            }
+            fprintf(file, "}}");
+        }
+        fprintf(file, "\n]}\n");
+        fclose(file);
+
+        printf("CIG Profile: wrote %zu kernels to '%s'\n", gProfilerState.kernels.size(), path);
+        return true;
+    }
 #else
     nvigi::D3D12Parameters init(PFun_nvigiLoadInterface*, PFun_nvigiUnloadInterface*, bool = true)
     {
@@ -1345,5 +1614,15 @@ namespace CIGCompatibilityChecker
 
     // Call at end of test
     bool check(bool = true) { return true; }
+
+    struct ProfileScope
+    {
+        ProfileScope(const char*, const void* = nullptr) {}
+    };
+    void enableProfiling(bool) {}
+    void resetProfile() {}
+    void flushProfile() {}
+    void printProfile(size_t = 5) {}
+    bool writeChromeTrace(const char*) { return false; }
 #endif
 }
@@ -5,6 +5,9 @@
 #pragma once
 
 #include <dxgi1_6.h>
+#include <deque>
+#include <vector>
+#include <algorithm>
 
 #include "source/core/nvigi.log/log.h"
 #include "source/core/nvigi.system/system.h"
@@ -164,5 +167,422 @@ Result applyNVDASpecificSettings(const D3D12Parameters* d3d12Params, IHWID3D12*
     return kResultOk;
 }
 
+//! Compute queue for inference work, in order of preference:
+//!
+//! * host's 'D3D12Parameters::queueCompute'
+//! * queue shared by all plugins from the hwi.d3d12 pool (IHWID3D12 v6), never the host's direct queue
+//! * private queue created for the caller
+//!
+//! Queue is referenced in all cases, 'release' returns it the same way it was obtained.
+struct ComputeQueue
+{
+    Result acquire(const D3D12Parameters* d3d12Params, IHWID3D12* iscg, uint32_t queueClass = D3D12QueueClass::kForeground)
+    {
+        if (!d3d12Params || !d3d12Params->device) return kResultInvalidParameter;
+        if (d3d12Params->getVersion() >= 2 && d3d12Params->queueCompute)
+        {
+            queue = d3d12Params->queueCompute;
+            queue->AddRef();
+            return kResultOk;
+        }
+        if (iscg && iscg->getVersion() >= 6 && iscg->d3d12AcquireComputeQueue(d3d12Params->device, queueClass, &queue) == kResultOk)
+        {
+            pool = iscg;
+            return kResultOk;
+        }
+        D3D12_COMMAND_QUEUE_DESC desc{ D3D12_COMMAND_LIST_TYPE_COMPUTE };
+        if (FAILED(d3d12Params->device->CreateCommandQueue(&desc, IID_PPV_ARGS(&queue))))
+        {
+            queue = {};
+            NVIGI_LOG_ERROR("Failed to create D3D12 compute queue");
+            return kResultInvalidState;
+        }
+        NVIGI_LOG_WARN_ONCE("'D3D12Parameters::queueCompute' not provided and hwi.d3d12 queue pool is not available, using a private compute queue");
+        return kResultOk;
+    }
+
+    void release()
+    {
+        if (pool) pool->d3d12ReleaseComputeQueue(queue);
+        else if (queue) queue->Release();
+        queue = {};
+        pool = {};
+    }
+
+    ID3D12CommandQueue* queue{};
+    IHWID3D12* pool{};
+};
+
+//! GPU side ordering against the host's frame, see 'D3D12FrameSyncParameters'
+//!
+//! Call 'frameSyncWait' before the first ExecuteCommandLists of the evaluation and 'frameSyncSignal' after the last one,
+//! both are no-ops when the host did not chain the parameters.
+Result frameSyncWait(ID3D12CommandQueue* queue, const D3D12FrameSyncParameters* sync)
+{
+    if (!queue || !sync || !sync->waitFence) return kResultOk;
+    if (FAILED(queue->Wait(sync->waitFence, sync->waitValue)))
+    {
+        NVIGI_LOG_ERROR("Failed to wait on the host frame fence");
+        return kResultInvalidState;
+    }
+    return kResultOk;
+}
+
+Result frameSyncSignal(ID3D12CommandQueue* queue, const D3D12FrameSyncParameters* sync)
+{
+    if (!queue || !sync || !sync->signalFence) return kResultOk;
+    if (FAILED(queue->Signal(sync->signalFence, sync->signalValue)))
+    {
+        NVIGI_LOG_ERROR("Failed to signal the host frame fence");
+        return kResultInvalidState;
+    }
+    return kResultOk;
+}
+
+//! Fence shared by the staging rings and command list pools working with a queue
+struct QueueFence
+{
+    //! Use 'D3D12_FENCE_FLAG_SHARED' when the fence is imported by another API (e.g. CUDA external semaphore)
+    Result init(ID3D12Device* device, D3D12_FENCE_FLAGS flags = D3D12_FENCE_FLAG_NONE)
+    {
+        if (FAILED(device->CreateFence(0, flags, IID_PPV_ARGS(&fence))))
+        {
+            NVIGI_LOG_ERROR("Failed to create D3D12 fence");
+            return kResultInvalidState;
+        }
+        event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+        return kResultOk;
+    }
+
+    void shutdown()
+    {
+        if (fence) fence->Release();
+        if (event) CloseHandle(event);
+        fence = {};
+        event = {};
+    }
+
+    //! Returns the value which is reached once all work submitted to the queue so far is done
+    uint64_t signal(ID3D12CommandQueue* queue)
+    {
+        queue->Signal(fence, ++lastSignaled);
+        return lastSignaled;
+    }
+
+    bool isComplete(uint64_t value) const { return fence->GetCompletedValue() >= value; }
+
+    void wait(uint64_t value)
+    {
+        if (isComplete(value)) return;
+        fence->SetEventOnCompletion(value, event);
+        WaitForSingleObject(event, INFINITE);
+    }
+
+    ID3D12Fence* fence{};
+    HANDLE event{};
+    uint64_t lastSignaled{};
+};
+
+//! Persistently mapped upload or readback buffer sub-allocated as a ring
+//!
+//! Allocations made between two 'retire' calls are recycled once the fence value passed to 'retire' is reached,
+//! steady state evaluation does no resource creation or mapping. Upload ring uses GPU upload heap (ReBAR) when
+//! the device supports it and host did not opt out, otherwise a regular upload heap.
+//!
+//! NOTE: Not thread safe, typically one ring per instance or per queue
+struct StagingRing
+{
+    enum class Type
+    {
+        eUpload,
+        eReadback
+    };
+
+    struct Allocation
+    {
+        ID3D12Resource* resource{};
+        uint64_t offset{};
+        uint8_t* cpuAddress{};
+        D3D12_GPU_VIRTUAL_ADDRESS gpuAddress{};
+    };
+
+    Result init(const D3D12Parameters* d3d12Params, Type _type, uint64_t sizeInBytes, QueueFence* _fence)
+    {
+        if (!d3d12Params || !d3d12Params->device || !_fence || !sizeInBytes) return kResultInvalidParameter;
+
+        type = _type;
+        fence = _fence;
+        size = sizeInBytes;
+        // Host parameters are typically gone once the instance is created, only keep what 'shutdown' needs
+        if (d3d12Params->getVersion() >= 2)
+        {
+            destroyResourceCallback = d3d12Params->destroyResourceCallback;
+            destroyResourceUserContext = d3d12Params->destroyResourceUserContext;
+        }
+
+        D3D12_HEAP_PROPERTIES heapProps{ type == Type::eUpload ? D3D12_HEAP_TYPE_UPLOAD : D3D12_HEAP_TYPE_READBACK };
+        D3D12_RESOURCE_STATES state = type == Type::eUpload ? D3D12_RESOURCE_STATE_GENERIC_READ : D3D12_RESOURCE_STATE_COPY_DEST;
+        if (type == Type::eUpload && !(d3d12Params->getVersion() >= 3 && (d3d12Params->flags & D3D12ParametersFlags::eDisableReBAR)))
+        {
+            D3D12_FEATURE_DATA_D3D12_OPTIONS16 options16 = {};
+            if (SUCCEEDED(d3d12Params->device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS16, &options16, sizeof(options16))) && options16.GPUUploadHeapSupported)
+            {
+                heapProps.Type = D3D12_HEAP_TYPE_GPU_UPLOAD;
+                state = D3D12_RESOURCE_STATE_COMMON;
+            }
+        }
+
+        D3D12_RESOURCE_DESC desc{};
+        desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        desc.Width = size;
+        desc.Height = desc.DepthOrArraySize = desc.MipLevels = 1;
+        desc.SampleDesc.Count = 1;
+        desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+        // Host can manage our allocations
+        if (d3d12Params->getVersion() >= 2 && d3d12Params->createCommittedResourceCallback)
+        {
+            resource = d3d12Params->createCommittedResourceCallback(d3d12Params->device, &heapProps, D3D12_HEAP_FLAG_NONE, &desc, state, nullptr, d3d12Params->createCommitResourceUserContext);
+        }
+        else if (FAILED(d3d12Params->device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc, state, nullptr, IID_PPV_ARGS(&resource))))
+        {
+            resource = {};
+        }
+        if (!resource)
+        {
+            NVIGI_LOG_ERROR("Failed to create %s staging ring (%llu bytes)", type == Type::eUpload ? "upload" : "readback", size);
+            return kResultInsufficientResources;
+        }
+        // Readback ring is mapped with a full read range, CPU reads only after the fence anyway
+        D3D12_RANGE noRead{};
+        if (FAILED(resource->Map(0, type == Type::eUpload ? &noRead : nullptr, (void**)&cpuBase)))
+        {
+            NVIGI_LOG_ERROR("Failed to map staging ring");
+            shutdown();
+            return kResultInvalidState;
+        }
+        gpuBase = resource->GetGPUVirtualAddress();
+        NVIGI_LOG_VERBOSE("Created %s staging ring (%llu bytes, %s)", type == Type::eUpload ? "upload" : "readback", size, heapProps.Type == D3D12_HEAP_TYPE_GPU_UPLOAD ? "ReBAR" : "system memory");
+        return kResultOk;
+    }
+
+    void shutdown()
+    {
+        if (resource)
+        {
+            if (fence && fence->fence && !segments.empty()) fence->wait(segments.back().fenceValue);
+            if (cpuBase) resource->Unmap(0, nullptr);
+            if (destroyResourceCallback)
+                destroyResourceCallback(resource, destroyResourceUserContext);
+            else
+                resource->Release();
+        }
+        resource = {};
+        cpuBase = {};
+        segments.clear();
+        head = tail = used = pending = 0;
+    }
+
+    //! Blocks on the oldest in flight work if the ring is full, fails only if the request can never fit
+    Result allocate(uint64_t bytes, uint64_t alignment, Allocation& allocation)
+    {
+        if (!resource) return kResultInvalidState;
+        alignment = alignment ? alignment : D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+        if (bytes + alignment > size)
+        {
+            NVIGI_LOG_ERROR("Staging allocation of %llu bytes does not fit the ring (%llu bytes)", bytes, size);
+            return kResultInsufficientResources;
+        }
+        while (true)
+        {
+            reclaim();
+            uint64_t offset = (head + alignment - 1) & ~(alignment - 1);
+            uint64_t padding = offset - head;
+            // Wrap if the allocation does not fit at the end
+            if (offset + bytes > size)
+            {
+                padding = size - head;
+                offset = 0;
+            }
+            if (used + padding + bytes <= size)
+            {
+                used += padding + bytes;
+                pending += padding + bytes;
+                head = (offset + bytes) % size;
+                allocation = { resource, offset, cpuBase + offset, gpuBase + offset };
+                return kResultOk;
+            }
+            if (segments.empty())
+            {
+                // Everything is allocated since the last 'retire', caller must submit and retire first
+                NVIGI_LOG_ERROR("Staging ring is exhausted by allocations which were not retired");
+                return kResultInsufficientResources;
+            }
+            fence->wait(segments.front().fenceValue);
+        }
+    }
+
+    //! All allocations since the previous call can be reused once 'fenceValue' is reached (see QueueFence::signal)
+    void retire(uint64_t fenceValue)
+    {
+        if (!pending) return;
+        segments.push_back({ fenceValue, pending });
+        pending = 0;
+    }
+
+private:
+    void reclaim()
+    {
+        while (!segments.empty() && fence->isComplete(segments.front().fenceValue))
+        {
+            tail = (tail + segments.front().bytes) % size;
+            used -= segments.front().bytes;
+            segments.pop_front();
+        }
+        if (!used) head = tail = 0;
+    }
+
+    struct Segment
+    {
+        uint64_t fenceValue;
+        uint64_t bytes;
+    };
+
+    Type type{};
+    PFun_destroyResource* destroyResourceCallback{};
+    void* destroyResourceUserContext{};
+    QueueFence* fence{};
+    ID3D12Resource* resource{};
+    uint8_t* cpuBase{};
+    D3D12_GPU_VIRTUAL_ADDRESS gpuBase{};
+    uint64_t size{};
+    uint64_t head{};
+    uint64_t tail{};
+    uint64_t used{};
+    uint64_t pending{};
+    std::deque<Segment> segments;
+};
+
+//! Recycled command allocators and command lists for a queue
+//!
+//! 'acquire' returns a list ready for recording, 'execute' closes and submits it and recycles the allocator
+//! once the returned fence value is reached. No D3D12 objects are created once the pool is warmed up.
+//!
+//! NOTE: Not thread safe, typically one pool per instance and queue
+struct CommandListPool
+{
+    Result init(ID3D12Device* _device, D3D12_COMMAND_LIST_TYPE _type, QueueFence* _fence)
+    {
+        if (!_device || !_fence) return kResultInvalidParameter;
+        device = _device;
+        type = _type;
+        fence = _fence;
+        return kResultOk;
+    }
+
+    void shutdown()
+    {
+        for (auto& entry : inFlight)
+        {
+            fence->wait(entry.fenceValue);
+            available.push_back(entry.allocator);
+        }
+        inFlight.clear();
+        for (auto allocator : available) allocator->Release();
+        for (auto list : lists) list->Release();
+        available.clear();
+        lists.clear();
+    }
+
+    Result acquire(ID3D12GraphicsCommandList** commandList)
+    {
+        if (!commandList) return kResultInvalidParameter;
+
+        while (!inFlight.empty() && fence->isComplete(inFlight.front().fenceValue))
+        {
+            available.push_back(inFlight.front().allocator);
+            inFlight.pop_front();
+        }
+
+        ID3D12CommandAllocator* allocator{};
+        if (!available.empty())
+        {
+            allocator = available.back();
+            available.pop_back();
+            allocator->Reset();
+        }
+        else if (FAILED(device->CreateCommandAllocator(type, IID_PPV_ARGS(&allocator))))
+        {
+            NVIGI_LOG_ERROR("Failed to create D3D12 command allocator");
+            return kResultInvalidState;
+        }
+
+        // Lists can be reset as soon as they are submitted, only allocators must wait for the GPU
+        ID3D12GraphicsCommandList* list{};
+        if (!lists.empty())
+        {
+            list = lists.back();
+            lists.pop_back();
+            list->Reset(allocator, nullptr);
+        }
+        else if (FAILED(device->CreateCommandList(0, type, allocator, nullptr, IID_PPV_ARGS(&list))))
+        {
+            available.push_back(allocator);
+            NVIGI_LOG_ERROR("Failed to create D3D12 command list");
+            return kResultInvalidState;
+        }
+        recording.push_back({ list, allocator });
+        *commandList = list;
+        return kResultOk;
+    }
+
+    //! Returns the fence value to be used with 'StagingRing::retire' for allocations used by this list
+    Result execute(ID3D12CommandQueue* queue, ID3D12GraphicsCommandList* commandList, uint64_t* fenceValue = nullptr)
+    {
+        auto it = std::find_if(recording.begin(), recording.end(), [commandList](const Recording& r) { return r.list == commandList; });
+        if (!queue || it == recording.end()) return kResultInvalidParameter;
+
+        auto allocator = it->allocator;
+        recording.erase(it);
+
+        HRESULT hr = commandList->Close();
+        if (SUCCEEDED(hr))
+        {
+            ID3D12CommandList* lists[] = { commandList };
+            queue->ExecuteCommandLists(1, lists);
+        }
+        auto value = fence->signal(queue);
+        inFlight.push_back({ value, allocator });
+        this->lists.push_back(commandList);
+        if (fenceValue) *fenceValue = value;
+        if (FAILED(hr))
+        {
+            NVIGI_LOG_ERROR("Failed to close D3D12 command list - error 0x%x", hr);
+            return kResultInvalidState;
+        }
+        return kResultOk;
+    }
+
+private:
+    struct InFlight
+    {
+        uint64_t fenceValue;
+        ID3D12CommandAllocator* allocator;
+    };
+    struct Recording
+    {
+        ID3D12GraphicsCommandList* list;
+        ID3D12CommandAllocator* allocator;
+    };
+
+    ID3D12Device* device{};
+    D3D12_COMMAND_LIST_TYPE type{};
+    QueueFence* fence{};
+    std::deque<InFlight> inFlight;
+    std::vector<ID3D12CommandAllocator*> available;
+    std::vector<ID3D12GraphicsCommandList*> lists;
+    std::vector<Recording> recording;
+};
+
 } // namespace d3d12
 } // namespace nvigi
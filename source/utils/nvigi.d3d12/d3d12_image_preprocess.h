@@ -0,0 +1,674 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <d3dcompiler.h>
+#include <array>
+#include <cmath>
+
+#include "d3d12_helpers.h"
+#include "source/utils/nvigi.ai/nvigi_ai.h"
+
+namespace nvigi
+{
+namespace d3d12
+{
+
+namespace detail
+{
+
+//! Compiled at runtime (cs_5_1) so plugins do not need a shader build step, once per preprocessor
+//!
+//! Each thread produces two consecutive tensor elements so fp16 output can be stored as whole dwords.
+constexpr const char* kImagePreprocessShader = R"(
+cbuffer Constants : register(b0)
+{
+    float2 srcOrigin;
+    float2 srcScale;
+    uint2 srcExtent;
+    uint dstWidth;
+    uint dstHeight;
+    uint channels;
+    uint layout;
+    uint flags;
+    uint elementCount;
+    uint srcChannels;
+    uint srcRowPitch;
+    uint dispatchWidth;
+    uint padding;
+    float4 channelScale;
+    float4 channelBias;
+};
+
+RWByteAddressBuffer dst : register(u0);
+
+#ifdef SOURCE_BUFFER
+ByteAddressBuffer srcBuffer : register(t1);
+
+float4 loadTexel(int2 p)
+{
+    p = clamp(p, int2(0, 0), int2(srcExtent) - 1);
+    uint offset = p.y * srcRowPitch + p.x * srcChannels;
+    // Texel never spans more than two dwords, buffer is padded accordingly
+    uint2 raw = srcBuffer.Load2(offset & ~3u);
+    uint shift = (offset & 3u) * 8;
+    uint bits = shift ? (raw.x >> shift) | (raw.y << (32 - shift)) : raw.x;
+    float4 v = float4(bits & 0xff, (bits >> 8) & 0xff, (bits >> 16) & 0xff, bits >> 24) / 255.0;
+    if (srcChannels == 1) v = float4(v.xxx, 1);
+    else if (srcChannels == 2) v = float4(v.xxx, v.y);
+    else if (srcChannels == 3) v.w = 1;
+    return v;
+}
+
+float4 sampleSource(float2 pos)
+{
+    float2 p = pos - 0.5;
+    int2 p0 = int2(floor(p));
+    float2 f = p - p0;
+    float4 top = lerp(loadTexel(p0), loadTexel(p0 + int2(1, 0)), f.x);
+    float4 bottom = lerp(loadTexel(p0 + int2(0, 1)), loadTexel(p0 + int2(1, 1)), f.x);
+    return lerp(top, bottom, f.y);
+}
+#else
+Texture2D<float4> srcTexture : register(t0);
+SamplerState linearClamp : register(s0);
+
+float4 sampleSource(float2 pos)
+{
+    return srcTexture.SampleLevel(linearClamp, pos / float2(srcExtent), 0);
+}
+#endif
+
+float3 srgbToLinear(float3 c)
+{
+    return c <= 0.04045 ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
+}
+
+float3 linearToSrgb(float3 c)
+{
+    return c <= 0.0031308 ? c * 12.92 : 1.055 * pow(c, 1.0 / 2.4) - 0.055;
+}
+
+float loadElement(uint index)
+{
+    uint plane = dstWidth * dstHeight;
+    uint c = layout == 0 ? index / plane : index % channels;
+    uint pixel = layout == 0 ? index % plane : index / channels;
+    float2 xy = float2(pixel % dstWidth, pixel / dstWidth);
+    float4 v = sampleSource(srcOrigin + (xy + 0.5) * srcScale);
+    if (flags & 2) v.rgb = v.bgr;
+    if (flags & 4) v.rgb = srgbToLinear(saturate(v.rgb));
+    if (flags & 8) v.rgb = linearToSrgb(saturate(v.rgb));
+    float value = channels == 1 ? dot(v.rgb, float3(0.299, 0.587, 0.114)) : v[c];
+    return value * channelScale[c] + channelBias[c];
+}
+
+[numthreads(64, 1, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+    uint pair = id.y * dispatchWidth + id.x;
+    uint index = pair * 2;
+    if (index >= elementCount) return;
+    bool last = index + 1 >= elementCount;
+    float a = loadElement(index);
+    float b = last ? 0 : loadElement(index + 1);
+    if (flags & 1) dst.Store(pair * 4, f32tof16(a) | (f32tof16(b) << 16));
+    else if (last) dst.Store(pair * 8, asuint(a));
+    else dst.Store2(pair * 8, asuint(float2(a, b)));
+}
+)";
+
+//! Must match the cbuffer above
+struct ImagePreprocessConstants
+{
+    float srcOrigin[2];
+    float srcScale[2];
+    uint32_t srcExtent[2];
+    uint32_t dstWidth;
+    uint32_t dstHeight;
+    uint32_t channels;
+    uint32_t layout;
+    uint32_t flags;
+    uint32_t elementCount;
+    uint32_t srcChannels;
+    uint32_t srcRowPitch;
+    uint32_t dispatchWidth;
+    uint32_t padding;
+    float channelScale[4];
+    float channelBias[4];
+};
+
+constexpr uint32_t kImagePreprocessGroupSize = 64;
+
+//! States which can be used (and transitioned from/to) on compute command lists
+inline bool isComputeCompatible(D3D12_RESOURCE_STATES state)
+{
+    const auto kAllowed = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_UNORDERED_ACCESS | D3D12_RESOURCE_STATE_COPY_DEST |
+        D3D12_RESOURCE_STATE_COPY_SOURCE | D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER | D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT;
+    return (state & ~kAllowed) == 0;
+}
+
+//! Typeless render targets need a typed view
+inline DXGI_FORMAT getTypedFormat(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+        case DXGI_FORMAT_R8G8B8A8_TYPELESS: return DXGI_FORMAT_R8G8B8A8_UNORM;
+        case DXGI_FORMAT_B8G8R8A8_TYPELESS: return DXGI_FORMAT_B8G8R8A8_UNORM;
+        case DXGI_FORMAT_B8G8R8X8_TYPELESS: return DXGI_FORMAT_B8G8R8X8_UNORM;
+        case DXGI_FORMAT_R10G10B10A2_TYPELESS: return DXGI_FORMAT_R10G10B10A2_UNORM;
+        case DXGI_FORMAT_R16G16B16A16_TYPELESS: return DXGI_FORMAT_R16G16B16A16_FLOAT;
+        case DXGI_FORMAT_R32G32B32A32_TYPELESS: return DXGI_FORMAT_R32G32B32A32_FLOAT;
+        case DXGI_FORMAT_R8_TYPELESS: return DXGI_FORMAT_R8_UNORM;
+        default: return format;
+    }
+}
+
+}
+
+//! GPU image preprocessing shared by the vision plugins
+//!
+//! Crops, resizes (bilinear), converts color and packs an 'InferenceDataImage' into an NCHW/NHWC fp32/fp16 tensor with
+//! a single compute dispatch, see 'ImagePreprocessParameters'. Image can be a D3D12 texture (render target, screenshot),
+//! a D3D12 buffer or CPU data with tightly packed 8 bit channels. Textures are sampled through their view format so
+//! '_SRGB' formats are linearized by the hardware and BGRA formats already return RGB.
+//!
+//! Work goes to 'D3D12Parameters::queueCompute' (or the hwi.d3d12 pooled compute queue), or the direct queue when the image is in a graphics only state
+//! (e.g. RENDER_TARGET). Image fence (if any) is waited on the GPU, output is signaled with our queue fence so the
+//! consumer can wait on the GPU as well, CPU never blocks in steady state.
+//!
+//! NOTE: Not thread safe, typically one preprocessor per instance
+struct ImagePreprocessor
+{
+    //! Internal output buffers are recycled round robin
+    static constexpr uint32_t kOutputBufferCount = 3;
+    static constexpr uint32_t kDescriptorCount = 64;
+
+    struct OutputBuffer
+    {
+        ID3D12Resource* resource{};
+        uint64_t size{};
+        //! Bumped whenever the resource is recreated, lets interop layers cache imports
+        uint64_t serial{};
+    };
+
+    //! 'shareable' creates internal outputs and fences which can be imported by CUDA, see 'image_preprocess_cuda.h'
+    //! 'iscg' (optional) provides the pooled compute queue when the host did not set 'D3D12Parameters::queueCompute'
+    Result init(const D3D12Parameters* d3d12Params, bool shareable = false, uint64_t uploadRingSize = 32 * 1024 * 1024,
+        IHWID3D12* iscg = nullptr, uint32_t queueClass = D3D12QueueClass::kForeground)
+    {
+        if (!d3d12Params || !d3d12Params->device) return kResultInvalidParameter;
+        // Host parameters are typically gone once the instance is created, only keep the allocation callbacks
+        if (d3d12Params->getVersion() >= 2)
+        {
+            createCommittedResourceCallback = d3d12Params->createCommittedResourceCallback;
+            createCommitResourceUserContext = d3d12Params->createCommitResourceUserContext;
+            destroyResourceCallback = d3d12Params->destroyResourceCallback;
+            destroyResourceUserContext = d3d12Params->destroyResourceUserContext;
+        }
+        device = d3d12Params->device;
+        shared = shareable;
+
+        if (NVIGI_FAILED(res, createPipelines())) return res;
+
+        auto fenceFlags = shared ? D3D12_FENCE_FLAG_SHARED : D3D12_FENCE_FLAG_NONE;
+        if (NVIGI_FAILED(res, computeQueue.acquire(d3d12Params, iscg, queueClass))) return res;
+        compute.queue = computeQueue.queue;
+        compute.queue->AddRef();
+        if (NVIGI_FAILED(res, compute.fence.init(device, fenceFlags))) return res;
+        if (NVIGI_FAILED(res, compute.pool.init(device, D3D12_COMMAND_LIST_TYPE_COMPUTE, &compute.fence))) return res;
+        if (d3d12Params->queue)
+        {
+            direct.queue = d3d12Params->queue;
+            direct.queue->AddRef();
+            if (NVIGI_FAILED(res, direct.fence.init(device, fenceFlags))) return res;
+            if (NVIGI_FAILED(res, direct.pool.init(device, D3D12_COMMAND_LIST_TYPE_DIRECT, &direct.fence))) return res;
+        }
+        if (NVIGI_FAILED(res, upload.init(d3d12Params, StagingRing::Type::eUpload, uploadRingSize, &compute.fence))) return res;
+
+        D3D12_DESCRIPTOR_HEAP_DESC heapDesc{ D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, kDescriptorCount, D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE };
+        if (FAILED(device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&descriptorHeap))))
+        {
+            NVIGI_LOG_ERROR("Failed to create image preprocessing descriptor heap");
+            return kResultInvalidState;
+        }
+        descriptorSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+        return kResultOk;
+    }
+
+    void shutdown()
+    {
+        for (auto ctx : { &compute, &direct })
+        {
+            if (!ctx->queue) continue;
+            if (ctx->fence.fence) ctx->fence.wait(ctx->fence.lastSignaled);
+            ctx->pool.shutdown();
+            ctx->queue->Release();
+            ctx->queue = {};
+        }
+        computeQueue.release();
+        upload.shutdown();
+        compute.fence.shutdown();
+        direct.fence.shutdown();
+        for (auto& output : outputs)
+        {
+            if (output.buffer.resource) releaseResource(output.buffer.resource);
+            output = {};
+        }
+        for (auto pso : { psoTexture, psoBuffer }) if (pso) pso->Release();
+        if (rootSignature) rootSignature->Release();
+        if (descriptorHeap) descriptorHeap->Release();
+        psoTexture = psoBuffer = {};
+        rootSignature = {};
+        descriptorHeap = {};
+    }
+
+    //! Size of the tensor produced for the given source extent
+    static uint64_t getOutputSize(const ImagePreprocessParameters& desc, uint32_t srcWidth, uint32_t srcHeight)
+    {
+        uint32_t w = desc.width ? desc.width : (desc.cropWidth ? desc.cropWidth : srcWidth);
+        uint32_t h = desc.height ? desc.height : (desc.cropHeight ? desc.cropHeight : srcHeight);
+        uint64_t count = uint64_t(w) * h * desc.channels;
+        // fp16 pairs are stored as whole dwords
+        return (desc.flags & ImagePreprocessFlags::eFP16) ? ((count + 1) / 2) * 4 : count * 4;
+    }
+
+    //! Index of the internal buffer the next 'process' call writes to when the output has no resource
+    uint32_t getNextOutputIndex() const { return nextOutput; }
+    const OutputBuffer& getOutputBuffer(uint32_t index) const { return outputs[index % kOutputBufferCount].buffer; }
+    //! Bytes written by the last successful 'process' call
+    uint64_t getLastOutputSize() const { return lastOutputSize; }
+    const QueueFence& getComputeFence() const { return compute.fence; }
+    const QueueFence& getDirectFence() const { return direct.fence; }
+
+    //! Preprocesses 'image' into 'output'
+    //!
+    //! If 'output.resource' is provided it must be a buffer with UAV access and at least 'getOutputSize' bytes, it is returned
+    //! to its original state. Otherwise one of the internal buffers is used, returned in UNORDERED_ACCESS state and valid
+    //! until 'kOutputBufferCount' further calls. In both cases 'output.fence/fenceValue' mark completion.
+    Result process(const InferenceDataImage* image, const ImagePreprocessParameters& desc, D3D12Data& output)
+    {
+        if (!image || !image->bytes || !psoTexture) return kResultInvalidParameter;
+        if (desc.channels < 1 || desc.channels > 4)
+        {
+            NVIGI_LOG_ERROR("Image preprocessing supports 1 to 4 output channels, requested %u", desc.channels);
+            return kResultInvalidParameter;
+        }
+
+        const D3D12Data* srcD3D12 = castTo<D3D12Data>(image->bytes);
+        const CpuData* srcCpu = castTo<CpuData>(image->bytes);
+        if (!srcD3D12 && !srcCpu)
+        {
+            NVIGI_LOG_ERROR("Image preprocessing requires D3D12Data or CpuData image bytes");
+            return kResultInvalidParameter;
+        }
+        if (srcD3D12 && !srcD3D12->resource) return kResultInvalidParameter;
+
+        D3D12_RESOURCE_DESC srcDesc{};
+        if (srcD3D12) srcDesc = srcD3D12->resource->GetDesc();
+        bool srcTexture = srcD3D12 && srcDesc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+        uint32_t srcWidth = srcTexture ? uint32_t(srcDesc.Width) : uint32_t(image->w);
+        uint32_t srcHeight = srcTexture ? srcDesc.Height : uint32_t(image->h);
+        if (!srcTexture && (image->c < 1 || image->c > 4 || image->w <= 0 || image->h <= 0))
+        {
+            NVIGI_LOG_ERROR("Invalid image extent %dx%dx%d", image->w, image->h, image->c);
+            return kResultInvalidParameter;
+        }
+        uint64_t srcBytes = uint64_t(srcWidth) * srcHeight * (srcTexture ? 0 : image->c);
+        if (srcCpu && srcCpu->sizeInBytes < srcBytes)
+        {
+            NVIGI_LOG_ERROR("Image CPU data holds %llu bytes, expected %llu", srcCpu->sizeInBytes, srcBytes);
+            return kResultInvalidParameter;
+        }
+
+        // Clamp the crop rectangle to the source
+        ImagePreprocessParameters d = desc;
+        if (d.cropX >= srcWidth || d.cropY >= srcHeight) d.cropX = d.cropY = 0;
+        uint32_t cropW = d.cropWidth ? std::min(d.cropWidth, srcWidth - d.cropX) : srcWidth - d.cropX;
+        uint32_t cropH = d.cropHeight ? std::min(d.cropHeight, srcHeight - d.cropY) : srcHeight - d.cropY;
+        d.cropWidth = cropW;
+        d.cropHeight = cropH;
+        uint32_t dstW = d.width ? d.width : cropW;
+        uint32_t dstH = d.height ? d.height : cropH;
+        uint64_t outputSize = getOutputSize(d, srcWidth, srcHeight);
+
+        // Pick the queue, compute lists cannot touch graphics only states
+        D3D12_RESOURCE_STATES srcState = srcD3D12 && srcD3D12->getVersion() >= 2 ? D3D12_RESOURCE_STATES(srcD3D12->state) : D3D12_RESOURCE_STATE_COMMON;
+        D3D12_RESOURCE_STATES dstState = output.resource && output.getVersion() >= 2 ? D3D12_RESOURCE_STATES(output.state) : D3D12_RESOURCE_STATE_COMMON;
+        if (output.resource && !detail::isComputeCompatible(dstState))
+        {
+            NVIGI_LOG_ERROR("Image preprocessing output is in a graphics only state 0x%x", dstState);
+            return kResultInvalidParameter;
+        }
+        bool needsDirect = srcD3D12 && !detail::isComputeCompatible(srcState);
+        if (needsDirect && !direct.queue)
+        {
+            NVIGI_LOG_ERROR("Image is in a graphics only state 0x%x and 'D3D12Parameters::queue' was not provided", srcState);
+            return kResultInvalidState;
+        }
+        QueueContext& ctx = needsDirect ? direct : compute;
+
+        // Destination
+        ID3D12Resource* dstResource = output.resource;
+        OutputEntry* internal{};
+        if (!dstResource)
+        {
+            internal = &outputs[nextOutput];
+            if (internal->ctx) internal->ctx->fence.wait(internal->fenceValue);
+            if (internal->buffer.size < outputSize)
+            {
+                if (internal->buffer.resource) releaseResource(internal->buffer.resource);
+                internal->buffer = { createBuffer(outputSize), outputSize, internal->buffer.serial + 1 };
+                if (!internal->buffer.resource)
+                {
+                    internal->buffer = {};
+                    NVIGI_LOG_ERROR("Failed to create image preprocessing output (%llu bytes)", outputSize);
+                    return kResultInsufficientResources;
+                }
+            }
+            dstResource = internal->buffer.resource;
+        }
+        else if (dstResource->GetDesc().Width < outputSize)
+        {
+            NVIGI_LOG_ERROR("Image preprocessing output holds %llu bytes, expected %llu", dstResource->GetDesc().Width, outputSize);
+            return kResultInvalidParameter;
+        }
+
+        // Source address for buffer inputs
+        D3D12_GPU_VIRTUAL_ADDRESS srcAddress{};
+        StagingRing::Allocation staging{};
+        if (srcCpu)
+        {
+            // Shader reads whole dwords, pad so the last texel never reads past the allocation
+            if (NVIGI_FAILED(res, upload.allocate(srcBytes + 8, 256, staging))) return res;
+            memcpy(staging.cpuAddress, srcCpu->buffer, srcBytes);
+            srcAddress = staging.gpuAddress;
+        }
+        else if (!srcTexture)
+        {
+            srcAddress = srcD3D12->resource->GetGPUVirtualAddress();
+        }
+
+        ID3D12GraphicsCommandList* cmd{};
+        if (NVIGI_FAILED(res, ctx.pool.acquire(&cmd)))
+        {
+            if (srcCpu) upload.retire(compute.fence.lastSignaled);
+            return res;
+        }
+
+        // Transitions in, reverted after the dispatch
+        const D3D12_RESOURCE_STATES srcReadState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+        D3D12_RESOURCE_STATES dstBefore = internal ? D3D12_RESOURCE_STATE_UNORDERED_ACCESS : dstState;
+        std::array<D3D12_RESOURCE_BARRIER, 2> barriers{};
+        uint32_t barrierCount = 0;
+        if (srcD3D12 && srcState != srcReadState)
+        {
+            barriers[barrierCount++] = transition(srcD3D12->resource, srcState, srcReadState);
+        }
+        if (dstBefore != D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+        {
+            barriers[barrierCount++] = transition(dstResource, dstBefore, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+        }
+        if (barrierCount) cmd->ResourceBarrier(barrierCount, barriers.data());
+
+        detail::ImagePreprocessConstants constants{};
+        constants.srcOrigin[0] = float(d.cropX);
+        constants.srcOrigin[1] = float(d.cropY);
+        constants.srcScale[0] = float(cropW) / float(dstW);
+        constants.srcScale[1] = float(cropH) / float(dstH);
+        constants.srcExtent[0] = srcWidth;
+        constants.srcExtent[1] = srcHeight;
+        constants.dstWidth = dstW;
+        constants.dstHeight = dstH;
+        constants.channels = d.channels;
+        constants.layout = d.layout == ImageTensorLayout::eNCHW ? 0 : 1;
+        constants.flags = uint32_t(d.flags);
+        constants.elementCount = dstW * dstH * d.channels;
+        constants.srcChannels = srcTexture ? 0 : uint32_t(image->c);
+        constants.srcRowPitch = srcTexture ? 0 : srcWidth * uint32_t(image->c);
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            float stddev = d.stddev[c] != 0.0f ? d.stddev[c] : 1.0f;
+            constants.channelScale[c] = d.scale / stddev;
+            constants.channelBias[c] = -d.mean[c] / stddev;
+        }
+        uint32_t pairs = (constants.elementCount + 1) / 2;
+        uint32_t groups = (pairs + detail::kImagePreprocessGroupSize - 1) / detail::kImagePreprocessGroupSize;
+        uint32_t groupsX = std::min<uint32_t>(groups, D3D12_CS_DISPATCH_MAX_THREAD_GROUPS_PER_DIMENSION);
+        uint32_t groupsY = (groups + groupsX - 1) / groupsX;
+        constants.dispatchWidth = groupsX * detail::kImagePreprocessGroupSize;
+
+        cmd->SetComputeRootSignature(rootSignature);
+        cmd->SetComputeRoot32BitConstants(0, sizeof(constants) / 4, &constants, 0);
+        cmd->SetComputeRootUnorderedAccessView(2, dstResource->GetGPUVirtualAddress());
+        if (srcTexture)
+        {
+            DescriptorSlot& slot = descriptors[nextDescriptor];
+            if (slot.ctx) slot.ctx->fence.wait(slot.fenceValue);
+            D3D12_SHADER_RESOURCE_VIEW_DESC srv{};
+            srv.Format = detail::getTypedFormat(srcDesc.Format);
+            srv.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+            srv.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+            srv.Texture2D.MipLevels = 1;
+            auto cpuHandle = descriptorHeap->GetCPUDescriptorHandleForHeapStart();
+            auto gpuHandle = descriptorHeap->GetGPUDescriptorHandleForHeapStart();
+            cpuHandle.ptr += uint64_t(nextDescriptor) * descriptorSize;
+            gpuHandle.ptr += uint64_t(nextDescriptor) * descriptorSize;
+            device->CreateShaderResourceView(srcD3D12->resource, &srv, cpuHandle);
+            cmd->SetDescriptorHeaps(1, &descriptorHeap);
+            cmd->SetComputeRootDescriptorTable(3, gpuHandle);
+            cmd->SetPipelineState(psoTexture);
+        }
+        else
+        {
+            cmd->SetComputeRootShaderResourceView(1, srcAddress);
+            cmd->SetPipelineState(psoBuffer);
+        }
+        cmd->Dispatch(groupsX, groupsY, 1);
+
+        // Revert, internal outputs stay in UAV state
+        barrierCount = 0;
+        if (srcD3D12 && srcState != srcReadState)
+        {
+            barriers[barrierCount++] = transition(srcD3D12->resource, srcReadState, srcState);
+        }
+        if (dstBefore != D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+        {
+            barriers[barrierCount++] = transition(dstResource, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, dstBefore);
+        }
+        else
+        {
+            barriers[barrierCount].Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+            barriers[barrierCount++].UAV.pResource = dstResource;
+        }
+        cmd->ResourceBarrier(barrierCount, barriers.data());
+
+        // Producer of the image signaled its fence, wait on the GPU
+        if (srcD3D12 && srcD3D12->getVersion() >= 3 && srcD3D12->fence)
+        {
+            ctx.queue->Wait(srcD3D12->fence, srcD3D12->fenceValue);
+        }
+        uint64_t fenceValue{};
+        auto res = ctx.pool.execute(ctx.queue, cmd, &fenceValue);
+        if (srcCpu) upload.retire(fenceValue);
+        if (srcTexture)
+        {
+            descriptors[nextDescriptor] = { &ctx, fenceValue };
+            nextDescriptor = (nextDescriptor + 1) % kDescriptorCount;
+        }
+        if (internal)
+        {
+            internal->ctx = &ctx;
+            internal->fenceValue = fenceValue;
+            nextOutput = (nextOutput + 1) % kOutputBufferCount;
+        }
+        if (res != kResultOk) return res;
+
+        lastOutputSize = outputSize;
+        output.resource = dstResource;
+        if (output.getVersion() >= 2) output.state = internal ? D3D12_RESOURCE_STATE_UNORDERED_ACCESS : dstState;
+        if (output.getVersion() >= 3)
+        {
+            output.fence = ctx.fence.fence;
+            output.fenceValue = fenceValue;
+        }
+        return kResultOk;
+    }
+
+private:
+    struct QueueContext
+    {
+        ID3D12CommandQueue* queue{};
+        QueueFence fence{};
+        CommandListPool pool{};
+    };
+
+    struct OutputEntry
+    {
+        OutputBuffer buffer{};
+        QueueContext* ctx{};
+        uint64_t fenceValue{};
+    };
+
+    struct DescriptorSlot
+    {
+        QueueContext* ctx{};
+        uint64_t fenceValue{};
+    };
+
+    static D3D12_RESOURCE_BARRIER transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after)
+    {
+        D3D12_RESOURCE_BARRIER barrier{};
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barrier.Transition.pResource = resource;
+        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        barrier.Transition.StateBefore = before;
+        barrier.Transition.StateAfter = after;
+        return barrier;
+    }
+
+    Result createPipelines()
+    {
+        // Loaded on demand, ships with the OS
+        using PFun_D3DCompile = decltype(&D3DCompile);
+        static HMODULE s_compiler = LoadLibraryW(L"d3dcompiler_47.dll");
+        auto compile = s_compiler ? (PFun_D3DCompile)GetProcAddress(s_compiler, "D3DCompile") : nullptr;
+        if (!compile)
+        {
+            NVIGI_LOG_ERROR("Failed to load 'd3dcompiler_47.dll', image preprocessing is not available");
+            return kResultInvalidState;
+        }
+
+        D3D12_ROOT_PARAMETER rootParams[4]{};
+        rootParams[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+        rootParams[0].Constants.Num32BitValues = sizeof(detail::ImagePreprocessConstants) / 4;
+        rootParams[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+        rootParams[1].Descriptor.ShaderRegister = 1;
+        rootParams[2].ParameterType = D3D12_ROOT_PARAMETER_TYPE_UAV;
+        D3D12_DESCRIPTOR_RANGE range{ D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 0, 0 };
+        rootParams[3].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+        rootParams[3].DescriptorTable.NumDescriptorRanges = 1;
+        rootParams[3].DescriptorTable.pDescriptorRanges = &range;
+        D3D12_STATIC_SAMPLER_DESC sampler{};
+        sampler.Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
+        sampler.AddressU = sampler.AddressV = sampler.AddressW = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+        sampler.MaxLOD = D3D12_FLOAT32_MAX;
+        D3D12_ROOT_SIGNATURE_DESC rootDesc{ 4, rootParams, 1, &sampler, D3D12_ROOT_SIGNATURE_FLAG_NONE };
+
+        ID3DBlob* blob{};
+        ID3DBlob* errors{};
+        if (FAILED(D3D12SerializeRootSignature(&rootDesc, D3D_ROOT_SIGNATURE_VERSION_1, &blob, &errors)) ||
+            FAILED(device->CreateRootSignature(0, blob->GetBufferPointer(), blob->GetBufferSize(), IID_PPV_ARGS(&rootSignature))))
+        {
+            NVIGI_LOG_ERROR("Failed to create image preprocessing root signature - %s", errors ? (const char*)errors->GetBufferPointer() : "unknown error");
+            if (blob) blob->Release();
+            if (errors) errors->Release();
+            return kResultInvalidState;
+        }
+        blob->Release();
+
+        const D3D_SHADER_MACRO bufferDefines[] = { { "SOURCE_BUFFER", "1" }, { nullptr, nullptr } };
+        for (auto variant : { &psoTexture, &psoBuffer })
+        {
+            ID3DBlob* code{};
+            errors = {};
+            auto defines = variant == &psoBuffer ? bufferDefines : nullptr;
+            if (FAILED(compile(detail::kImagePreprocessShader, strlen(detail::kImagePreprocessShader), "image_preprocess", defines, nullptr, "main", "cs_5_1", D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, &code, &errors)))
+            {
+                NVIGI_LOG_ERROR("Failed to compile image preprocessing shader - %s", errors ? (const char*)errors->GetBufferPointer() : "unknown error");
+                if (errors) errors->Release();
+                return kResultInvalidState;
+            }
+            D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc{};
+            psoDesc.pRootSignature = rootSignature;
+            psoDesc.CS = { code->GetBufferPointer(), code->GetBufferSize() };
+            HRESULT hr = device->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(variant));
+            code->Release();
+            if (FAILED(hr))
+            {
+                NVIGI_LOG_ERROR("Failed to create image preprocessing pipeline - error 0x%x", hr);
+                return kResultInvalidState;
+            }
+        }
+        return kResultOk;
+    }
+
+    ID3D12Resource* createBuffer(uint64_t size)
+    {
+        D3D12_HEAP_PROPERTIES heapProps{ D3D12_HEAP_TYPE_DEFAULT };
+        D3D12_HEAP_FLAGS heapFlags = shared ? D3D12_HEAP_FLAG_SHARED : D3D12_HEAP_FLAG_NONE;
+        D3D12_RESOURCE_DESC desc{};
+        desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        desc.Width = size;
+        desc.Height = desc.DepthOrArraySize = desc.MipLevels = 1;
+        desc.SampleDesc.Count = 1;
+        desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+        desc.Flags = D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+
+        ID3D12Resource* resource{};
+        // Shared resources must be created by us, host callbacks cannot honor the heap flag
+        if (!shared && createCommittedResourceCallback)
+        {
+            resource = createCommittedResourceCallback(device, &heapProps, heapFlags, &desc, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, nullptr, createCommitResourceUserContext);
+        }
+        else if (FAILED(device->CreateCommittedResource(&heapProps, heapFlags, &desc, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, nullptr, IID_PPV_ARGS(&resource))))
+        {
+            resource = {};
+        }
+        return resource;
+    }
+
+    void releaseResource(ID3D12Resource* resource)
+    {
+        if (!shared && destroyResourceCallback)
+            destroyResourceCallback(resource, destroyResourceUserContext);
+        else
+            resource->Release();
+    }
+
+    PFun_createCommittedResource* createCommittedResourceCallback{};
+    void* createCommitResourceUserContext{};
+    PFun_destroyResource* destroyResourceCallback{};
+    void* destroyResourceUserContext{};
+    ID3D12Device* device{};
+    bool shared{};
+    ID3D12RootSignature* rootSignature{};
+    ID3D12PipelineState* psoTexture{};
+    ID3D12PipelineState* psoBuffer{};
+    ID3D12DescriptorHeap* descriptorHeap{};
+    uint32_t descriptorSize{};
+    ComputeQueue computeQueue{};
+    QueueContext compute{};
+    QueueContext direct{};
+    StagingRing upload{};
+    std::array<OutputEntry, kOutputBufferCount> outputs{};
+    std::array<DescriptorSlot, kDescriptorCount> descriptors{};
+    uint32_t nextOutput{};
+    uint32_t nextDescriptor{};
+    uint64_t lastOutputSize{};
+};
+
+} // namespace d3d12
+} // namespace nvigi
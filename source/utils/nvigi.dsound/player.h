@@ -7,6 +7,16 @@
 #include <dsound.h>
 #include <mmreg.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <nvigi_ai.h>
+#include <nvigi_cpu.h>
+
 namespace nvigi
 {
 namespace utils
@@ -41,6 +51,85 @@ struct Buffer
     DSBUFFERDESC desc = { sizeof(DSBUFFERDESC) };
 };
 
+//! Playback statistics for StreamingPlayer
+struct StreamingPlayerStats
+{
+    //! Total bytes handed to 'write' and accepted
+    uint64_t bytesQueued{};
+    //! Total bytes consumed by the play cursor (including silence during underruns)
+    uint64_t bytesPlayed{};
+    //! Number of times the play cursor caught up with the producer
+    uint32_t underruns{};
+    //! Milliseconds from the first 'write' until playback started, negative if not started yet
+    double timeToFirstAudioMs{ -1.0 };
+    //! Audio currently queued ahead of the play cursor
+    uint32_t queuedMs{};
+};
+
+//! Streams audio chunks through a single looping DirectSound buffer
+//!
+//! Meant for partial results (kInferenceExecutionStateDataPending) from TTS and similar
+//! plugins, chunks can be written from the execution callback as they arrive. Playback
+//! starts once 'latencyMs' of audio is queued (or 'finish' is called) so time-to-first-audio
+//! is bounded by the first chunk plus the latency, not by the whole clip.
+//!
+//! If the producer falls behind the buffer is stopped and silenced, playback resumes
+//! once 'latencyMs' is queued again. All methods are thread safe, 'write' blocks only
+//! when the ring is full.
+struct StreamingPlayer
+{
+    StreamingPlayer(Player& player, uint32_t latencyMs = 100, uint32_t ringMs = 2000);
+    StreamingPlayer(const StreamingPlayer&) = delete;
+    StreamingPlayer(StreamingPlayer&&) = delete;
+    virtual ~StreamingPlayer();
+
+    //! Queues raw samples in the player format, returns false if not initialized or stopped
+    bool write(const void* const data, size_t size);
+    //! Queues CPU audio from an inference callback, format must match the player
+    bool write(const nvigi::InferenceDataAudio* audio);
+    //! Marks the end of the stream, remaining audio plays out even if below the latency
+    void finish();
+    //! Blocks until everything queued before 'finish' has played
+    void wait();
+    //! Stops playback and drops any queued audio, the player can be reused afterwards
+    void reset();
+
+    StreamingPlayerStats getStats();
+
+    std::atomic_bool initialized{ false };
+    LPDIRECTSOUNDBUFFER buf{};
+    DSBUFFERDESC desc = { sizeof(DSBUFFERDESC) };
+
+private:
+    void service();
+    void updatePlayPosition();
+    void fillSilence(uint64_t from, DWORD size);
+    bool copyToRing(uint64_t offset, const uint8_t* data, DWORD size);
+    void startPlayback();
+    void stopPlayback();
+    uint32_t bytesToMs(uint64_t bytes) const;
+
+    DWORD ringBytes{};
+    DWORD latencyBytes{};
+    DWORD blockAlign{};
+    DWORD bytesPerSecond{};
+    WAVEFORMATEXTENSIBLE format{};
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::thread thread;
+    bool quit = false;
+    bool playing = false;
+    bool finished = false;
+    // Monotonic byte positions, ring offset is 'pos % ringBytes'
+    uint64_t writePos{};
+    uint64_t playPos{};
+    uint64_t silencedPos{};
+    DWORD lastCursor{};
+    std::chrono::steady_clock::time_point firstWrite{};
+    StreamingPlayerStats stats{};
+};
+
 Player::Player(uint32_t bitsPerSample, uint32_t sample_rate)
 {
     HRESULT res{ S_FALSE };
@@ -133,5 +222,270 @@ void Buffer::Wait()
     }
 }
 
+inline StreamingPlayer::StreamingPlayer(Player& player, uint32_t latencyMs, uint32_t ringMs)
+{
+    if (!player.initialized || !player.ds)
+        return;
+
+    format = player.waveFormat;
+    blockAlign = format.Format.nBlockAlign;
+    bytesPerSecond = format.Format.nAvgBytesPerSec;
+    auto msToBytes = [this](uint32_t ms)->DWORD
+    {
+        uint64_t bytes = uint64_t(bytesPerSecond) * ms / 1000;
+        return DWORD(bytes - bytes % blockAlign);
+    };
+    latencyBytes = (std::max)(msToBytes(latencyMs), blockAlign);
+    // Ring must hold the latency window plus room for the producer to keep writing
+    ringBytes = (std::max)(msToBytes(ringMs), 4 * latencyBytes);
+
+    desc.dwFlags = DSBCAPS_GLOBALFOCUS | DSBCAPS_CTRLVOLUME | DSBCAPS_GETCURRENTPOSITION2;
+    desc.dwBufferBytes = ringBytes;
+    desc.lpwfxFormat = (LPWAVEFORMATEX)&player.waveFormat;
+    if (player.ds->CreateSoundBuffer(&desc, &buf, NULL) != S_OK) { return; }
+
+    fillSilence(0, ringBytes);
+    initialized = true;
+    thread = std::thread(&StreamingPlayer::service, this);
+}
+
+inline StreamingPlayer::~StreamingPlayer()
+{
+    if (thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            quit = true;
+        }
+        cv.notify_all();
+        thread.join();
+    }
+    if (initialized)
+    {
+        buf->Stop();
+        buf->Release();
+        initialized = false;
+    }
+}
+
+inline uint32_t StreamingPlayer::bytesToMs(uint64_t bytes) const
+{
+    return bytesPerSecond ? uint32_t(bytes * 1000 / bytesPerSecond) : 0;
+}
+
+inline bool StreamingPlayer::copyToRing(uint64_t offset, const uint8_t* data, DWORD size)
+{
+    void* ptr1{}, * ptr2{};
+    DWORD len1{}, len2{};
+    HRESULT res = buf->Lock(DWORD(offset % ringBytes), size, &ptr1, &len1, &ptr2, &len2, 0);
+    if (res == DSERR_BUFFERLOST)
+    {
+        buf->Restore();
+        res = buf->Lock(DWORD(offset % ringBytes), size, &ptr1, &len1, &ptr2, &len2, 0);
+    }
+    if (res != S_OK) { return false; }
+
+    // Lock splits the region at the wrap-around point
+    if (data)
+    {
+        memcpy(ptr1, data, len1);
+        if (ptr2) memcpy(ptr2, data + len1, len2);
+    }
+    else
+    {
+        // Silence is zero for both 16-bit PCM and float
+        memset(ptr1, 0, len1);
+        if (ptr2) memset(ptr2, 0, len2);
+    }
+    buf->Unlock(ptr1, len1, ptr2, len2);
+    return true;
+}
+
+inline void StreamingPlayer::fillSilence(uint64_t from, DWORD size)
+{
+    if (size) copyToRing(from, nullptr, size);
+}
+
+inline void StreamingPlayer::updatePlayPosition()
+{
+    if (!playing) return;
+
+    DWORD cursor{};
+    if (buf->GetCurrentPosition(&cursor, nullptr) != S_OK) return;
+    DWORD delta = cursor >= lastCursor ? cursor - lastCursor : ringBytes - lastCursor + cursor;
+    lastCursor = cursor;
+    playPos += delta;
+    stats.bytesPlayed += delta;
+}
+
+inline void StreamingPlayer::startPlayback()
+{
+    buf->SetCurrentPosition(DWORD(playPos % ringBytes));
+    lastCursor = DWORD(playPos % ringBytes);
+    if (buf->Play(0, 0, DSBPLAY_LOOPING) != S_OK) return;
+    playing = true;
+    if (stats.timeToFirstAudioMs < 0.0)
+    {
+        stats.timeToFirstAudioMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - firstWrite).count();
+    }
+}
+
+inline void StreamingPlayer::stopPlayback()
+{
+    buf->Stop();
+    updatePlayPosition();
+    playing = false;
+    // Anything the cursor ran over was silence, continue writing from the cursor
+    if (playPos > writePos)
+    {
+        writePos = playPos;
+    }
+    else
+    {
+        playPos = writePos;
+    }
+    silencedPos = writePos;
+}
+
+inline void StreamingPlayer::service()
+{
+    // Wake up often enough to stay ahead of the cursor with silence
+    auto period = std::chrono::milliseconds((std::max)(1u, bytesToMs(latencyBytes) / 4));
+    std::unique_lock<std::mutex> lock(mtx);
+    while (!quit)
+    {
+        cv.wait_for(lock, period);
+        if (quit) break;
+        if (!playing)
+        {
+            if (finished && writePos > playPos)
+            {
+                startPlayback();
+            }
+            continue;
+        }
+
+        updatePlayPosition();
+        if (playPos >= writePos)
+        {
+            if (!finished)
+            {
+                stats.underruns++;
+            }
+            stopPlayback();
+            cv.notify_all();
+            continue;
+        }
+
+        // Keep one latency window of silence after the producer's data so a late
+        // producer results in a gap rather than stale audio from the previous lap
+        uint64_t silenceEnd = (std::min)(writePos + latencyBytes, playPos + ringBytes);
+        uint64_t silenceStart = (std::max)(silencedPos, writePos);
+        if (silenceEnd > silenceStart)
+        {
+            fillSilence(silenceStart, DWORD(silenceEnd - silenceStart));
+            silencedPos = silenceEnd;
+        }
+        cv.notify_all();
+    }
+}
+
+inline bool StreamingPlayer::write(const void* const data, size_t size)
+{
+    if (!initialized) return false;
+
+    auto src = (const uint8_t*)data;
+    size -= size % blockAlign;
+    std::unique_lock<std::mutex> lock(mtx);
+    if (stats.bytesQueued == 0 && stats.timeToFirstAudioMs < 0.0)
+    {
+        firstWrite = std::chrono::steady_clock::now();
+    }
+    finished = false;
+    while (size > 0)
+    {
+        updatePlayPosition();
+        if (playing && playPos >= writePos)
+        {
+            stats.underruns++;
+            stopPlayback();
+        }
+        uint64_t queued = writePos - playPos;
+        // Leave one block so the write position never equals the play position on a full ring
+        uint64_t space = ringBytes - blockAlign - (std::min)<uint64_t>(queued, ringBytes - blockAlign);
+        if (space == 0)
+        {
+            if (!playing) startPlayback();
+            cv.wait_for(lock, std::chrono::milliseconds(1));
+            if (quit) return false;
+            continue;
+        }
+        DWORD chunk = DWORD((std::min)<uint64_t>(space, size));
+        if (!copyToRing(writePos, src, chunk)) return false;
+        writePos += chunk;
+        silencedPos = (std::max)(silencedPos, writePos);
+        stats.bytesQueued += chunk;
+        src += chunk;
+        size -= chunk;
+
+        if (!playing && writePos - playPos >= latencyBytes)
+        {
+            startPlayback();
+        }
+    }
+    return true;
+}
+
+inline bool StreamingPlayer::write(const nvigi::InferenceDataAudio* audio)
+{
+    if (!audio) return false;
+    auto cpuBuffer = castTo<CpuData>(audio->audio);
+    if (!cpuBuffer || !cpuBuffer->buffer) return false;
+    if (audio->bitsPerSample != format.Format.wBitsPerSample ||
+        audio->samplingRate != (int)format.Format.nSamplesPerSec ||
+        audio->channels != format.Format.nChannels)
+    {
+        return false;
+    }
+    return write(cpuBuffer->buffer, cpuBuffer->sizeInBytes);
+}
+
+inline void StreamingPlayer::finish()
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    finished = true;
+}
+
+inline void StreamingPlayer::wait()
+{
+    if (!initialized) return;
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait(lock, [this]() { return quit || (finished && !playing && writePos <= playPos); });
+}
+
+inline void StreamingPlayer::reset()
+{
+    if (!initialized) return;
+    std::lock_guard<std::mutex> lock(mtx);
+    if (playing)
+    {
+        stopPlayback();
+    }
+    playPos = writePos;
+    silencedPos = writePos;
+    finished = false;
+    fillSilence(0, ringBytes);
+    cv.notify_all();
+}
+
+inline StreamingPlayerStats StreamingPlayer::getStats()
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    updatePlayPosition();
+    auto result = stats;
+    result.queuedMs = bytesToMs(writePos > playPos ? writePos - playPos : 0);
+    return result;
+}
+
 }
 }
\ No newline at end of file
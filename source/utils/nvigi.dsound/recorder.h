@@ -7,6 +7,20 @@
 #include <nvigi_struct.h>
 #include <nvigi_stl_helpers.h>
 
+#include <mmdeviceapi.h>
+#include <audioclient.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "source/core/nvigi.thread/timer.h"
+#include "source/utils/nvigi.ai/ai_audio_chunker.h"
+#include "source/utils/nvigi.ai/ai_vad.h"
+
 namespace nvigi
 {
 namespace utils
@@ -158,5 +172,459 @@ bool stopRecordingAudio(RecordingInfo* infoPtr, nvigi::InferenceDataAudioSTLHelp
     return true;
 }
 
+//! Capture settings for StreamingRecorder
+struct StreamingRecorderParameters
+{
+    //! Exclusive mode gives the shortest device period but the device must support 16kHz mono PCM natively,
+    //! shared mode lets the audio engine convert from the mix format
+    bool exclusive = false;
+    //! Device period (shared mode buffer duration), clamped to the device minimum in exclusive mode
+    uint32_t periodMs = 10;
+    //! Size of each chunk handed to the inference instance
+    uint32_t chunkMs = 200;
+    //! Capture ring capacity, samples are dropped if the consumer falls further behind than this
+    uint32_t ringMs = 4000;
+    int samplingRate = 16000;
+    //! Forwards only speech segments, each one as its own start/data/stop stream (see 'ai::VoiceActivityGate').
+    //! Gate uses 'samplingRate' and 'chunkMs' from above, its own values are ignored.
+    bool gateVoiceActivity = false;
+    ai::VoiceActivityGateParameters voiceActivity{};
+};
+
+//! Per chunk information, also reported to the optional observer
+struct StreamingRecorderChunkInfo
+{
+    uint64_t index{};
+    StreamSignal signal{};
+    size_t sampleCount{};
+    //! Time from the last sample of the chunk being captured by the device until 'evaluateAsync' accepted it
+    double deviceToSlotMs{};
+    //! Number of times 'evaluateAsync' returned kResultNotReady for this chunk
+    uint32_t retries{};
+    Result result{ kResultOk };
+};
+
+struct StreamingRecorderStats
+{
+    uint64_t chunks{};
+    uint64_t droppedSamples{};
+    uint64_t retries{};
+    double lastDeviceToSlotMs{};
+    double avgDeviceToSlotMs{};
+    double maxDeviceToSlotMs{};
+    //! Voice activity gating only, samples never sent to the instance and number of speech segments
+    uint64_t gatedSamples{};
+    uint64_t segments{};
+};
+
+//! Streams microphone input to an inference instance while recording continues
+//!
+//! WASAPI capture thread writes 16-bit PCM into a lock-free ring (no locks or allocations on the device path),
+//! a consumer thread cuts it into fixed size chunks and calls 'evaluateAsync' with 'StreamingParameters::signal'
+//! set to start/data/stop. Chunks point straight into the ring, a chunk is released only after the following one
+//! is accepted (i.e. after the instance is done with it).
+//!
+//! Evaluations use two copies of the provided execution context, each with its own inputs and streaming
+//! parameters, so preparing the next chunk never touches what the in-flight evaluation reads. Callbacks
+//! receive one of these copies, use 'callbackUserData' rather than comparing the pointer.
+//!
+//! Typical flow:
+//!
+//! StreamingRecorder recorder;
+//! execCtx.callback = asrCallback; // results arrive as usual
+//! recorder.start(&execCtx, kASRWhisperDataSlotAudio);
+//! ...
+//! recorder.stop(); // last chunk is sent with eStreamSignalStop
+//!
+//! With 'gateVoiceActivity' silence is not sent at all, every speech segment becomes a start/data/stop stream
+//! of its own and 'stop' sends eStreamSignalStop only if a segment is still open.
+//!
+//! NOTE: Execution context must not use a queued or batched async mode, one evaluation at a time is assumed.
+//! Keep the recorder alive until the final results arrive, the last chunk still points into its ring.
+struct StreamingRecorder
+{
+    using Observer = std::function<void(const StreamingRecorderChunkInfo&)>;
+
+    StreamingRecorder(const StreamingRecorderParameters& params = {}) : parameters(params)
+    {
+        chunkSamples = (std::max)(size_t(1), size_t(parameters.samplingRate) * parameters.chunkMs / 1000);
+        size_t ringSamples = (std::max)(size_t(parameters.samplingRate) * parameters.ringMs / 1000, 4 * chunkSamples);
+        // Mirror covers the in-flight chunk plus the next one so both are always contiguous
+        ring = std::make_unique<ai::AudioRingBuffer<int16_t>>(ringSamples, 2 * chunkSamples);
+        silence.resize((std::max)(1, parameters.samplingRate / 100));
+    }
+    StreamingRecorder(const StreamingRecorder&) = delete;
+    StreamingRecorder(StreamingRecorder&&) = delete;
+    virtual ~StreamingRecorder() { stop(); }
+
+    //! Starts capturing, 'execCtx' is copied but its runtime parameters must stay valid until 'stop' returns
+    //!
+    //! Evaluations get a single audio slot named 'audioSlotKey' as inputs and 'StreamingParameters' in front of
+    //! the runtime parameters of 'execCtx' (copied from the host's own if present), 'execCtx' is not modified.
+    bool start(InferenceExecutionContext* execCtx, const char* audioSlotKey, Observer _observer = {})
+    {
+        if (running || !execCtx || !execCtx->instance || !execCtx->instance->evaluateAsync || !audioSlotKey) return false;
+
+        observer = _observer;
+        for (auto& buffer : buffers)
+        {
+            buffer.ctx = *execCtx;
+            buffer.slot = InferenceDataSlot(audioSlotKey, buffer.audio);
+            buffer.slots = InferenceDataSlotArray(1, &buffer.slot);
+            buffer.ctx.inputs = &buffer.slots;
+            // Host chain is shared read-only, only the head differs
+            auto hostStreaming = findStruct<StreamingParameters>(execCtx->runtimeParameters);
+            buffer.streaming = hostStreaming ? *hostStreaming : StreamingParameters{};
+            buffer.streaming._base.next = execCtx->runtimeParameters;
+            buffer.ctx.runtimeParameters = buffer.streaming;
+        }
+        nextBuffer = 0;
+
+        ring->consume(ring->available());
+        stats = {};
+        origin100ns.store(0);
+        captureError.store(false);
+        stopRequested.store(false);
+        captureDone.store(false);
+        captureReady.store(false);
+        captureThread = std::thread(&StreamingRecorder::capture, this);
+        while (!captureReady.load() && !captureError.load())
+        {
+            thread::preciseSleep(std::chrono::milliseconds(1));
+        }
+        if (captureError.load())
+        {
+            captureThread.join();
+            return false;
+        }
+        consumerThread = std::thread(parameters.gateVoiceActivity ? &StreamingRecorder::consumeGated : &StreamingRecorder::consume, this);
+        running = true;
+        return true;
+    }
+
+    //! Stops capturing and sends whatever is left as the final chunk
+    void stop()
+    {
+        if (!running) return;
+        stopRequested.store(true, std::memory_order_release);
+        captureThread.join();
+        captureDone.store(true, std::memory_order_release);
+        consumerThread.join();
+        running = false;
+    }
+
+    bool isRunning() const { return running; }
+
+    StreamingRecorderStats getStats() const
+    {
+        std::lock_guard<std::mutex> lock(statsMtx);
+        auto result = stats;
+        result.droppedSamples = dropped.load(std::memory_order_relaxed);
+        return result;
+    }
+
+private:
+
+    static int64_t now100ns()
+    {
+        LARGE_INTEGER counter, frequency;
+        QueryPerformanceCounter(&counter);
+        QueryPerformanceFrequency(&frequency);
+        return int64_t(counter.QuadPart / double(frequency.QuadPart) * 1e7);
+    }
+
+    //! Device thread, only writes into the ring
+    void capture()
+    {
+        CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+        IMMDeviceEnumerator* enumerator{};
+        IMMDevice* device{};
+        IAudioClient* client{};
+        IAudioCaptureClient* captureClient{};
+        HANDLE event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+
+        auto cleanup = [&]()
+        {
+            if (captureClient) captureClient->Release();
+            if (client) { client->Stop(); client->Release(); }
+            if (device) device->Release();
+            if (enumerator) enumerator->Release();
+            if (event) CloseHandle(event);
+            CoUninitialize();
+        };
+        auto fail = [&]()
+        {
+            captureError.store(true);
+            cleanup();
+        };
+
+        WAVEFORMATEX format{};
+        format.wFormatTag = WAVE_FORMAT_PCM;
+        format.nChannels = 1;
+        format.nSamplesPerSec = parameters.samplingRate;
+        format.wBitsPerSample = 16;
+        format.nBlockAlign = (format.wBitsPerSample / 8) * format.nChannels;
+        format.nAvgBytesPerSec = format.nSamplesPerSec * format.nBlockAlign;
+
+        if (!event || FAILED(CoCreateInstance(__uuidof(MMDeviceEnumerator), nullptr, CLSCTX_ALL, __uuidof(IMMDeviceEnumerator), (void**)&enumerator)) ||
+            FAILED(enumerator->GetDefaultAudioEndpoint(eCapture, eConsole, &device)) ||
+            FAILED(device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr, (void**)&client)))
+        {
+            return fail();
+        }
+
+        REFERENCE_TIME period = REFERENCE_TIME(parameters.periodMs) * 10000;
+        HRESULT hr{};
+        if (parameters.exclusive)
+        {
+            REFERENCE_TIME defaultPeriod{}, minPeriod{};
+            client->GetDevicePeriod(&defaultPeriod, &minPeriod);
+            period = (std::max)(period, minPeriod);
+            hr = client->Initialize(AUDCLNT_SHAREMODE_EXCLUSIVE, AUDCLNT_STREAMFLAGS_EVENTCALLBACK, period, period, &format, nullptr);
+            if (hr == AUDCLNT_E_BUFFER_SIZE_NOT_ALIGNED)
+            {
+                // Period must match the aligned buffer size, client has to be recreated
+                UINT32 frames{};
+                client->GetBufferSize(&frames);
+                period = REFERENCE_TIME(10000.0 * 1000 * frames / format.nSamplesPerSec + 0.5);
+                client->Release();
+                client = nullptr;
+                if (FAILED(device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr, (void**)&client))) return fail();
+                hr = client->Initialize(AUDCLNT_SHAREMODE_EXCLUSIVE, AUDCLNT_STREAMFLAGS_EVENTCALLBACK, period, period, &format, nullptr);
+            }
+        }
+        else
+        {
+            hr = client->Initialize(AUDCLNT_SHAREMODE_SHARED,
+                AUDCLNT_STREAMFLAGS_EVENTCALLBACK | AUDCLNT_STREAMFLAGS_AUTOCONVERTPCM | AUDCLNT_STREAMFLAGS_SRC_DEFAULT_QUALITY,
+                period, 0, &format, nullptr);
+        }
+        if (FAILED(hr) || FAILED(client->SetEventHandle(event)) ||
+            FAILED(client->GetService(__uuidof(IAudioCaptureClient), (void**)&captureClient)) ||
+            FAILED(client->Start()))
+        {
+            return fail();
+        }
+        captureReady.store(true);
+
+        uint64_t captured{};
+        while (!stopRequested.load(std::memory_order_acquire))
+        {
+            if (WaitForSingleObject(event, 100) != WAIT_OBJECT_0) continue;
+
+            UINT32 packetFrames{};
+            while (SUCCEEDED(captureClient->GetNextPacketSize(&packetFrames)) && packetFrames)
+            {
+                BYTE* data{};
+                UINT32 frames{};
+                DWORD flags{};
+                UINT64 qpcPosition{};
+                if (FAILED(captureClient->GetBuffer(&data, &frames, &flags, nullptr, &qpcPosition))) break;
+
+                if ((flags & AUDCLNT_BUFFERFLAGS_TIMESTAMP_ERROR) == 0)
+                {
+                    // Device time of sample zero, lets the consumer time any sample without sharing per packet data
+                    origin100ns.store(int64_t(qpcPosition) - int64_t(captured * 10000000ull / format.nSamplesPerSec), std::memory_order_relaxed);
+                }
+                size_t written{};
+                if (flags & AUDCLNT_BUFFERFLAGS_SILENT)
+                {
+                    for (size_t i = 0; i < frames; i += silence.size())
+                    {
+                        written += ring->write(silence.data(), (std::min)(silence.size(), frames - i));
+                    }
+                }
+                else
+                {
+                    written = ring->write((const int16_t*)data, frames);
+                }
+                if (written < frames) dropped.fetch_add(frames - written, std::memory_order_relaxed);
+                captured += frames;
+                captureClient->ReleaseBuffer(frames);
+            }
+        }
+        cleanup();
+    }
+
+    //! Fills the buffer which is not in flight, it was used two chunks ago and that evaluation is done
+    //! since the following chunk was accepted
+    Result submit(const int16_t* samples, size_t count, StreamSignal signal, uint64_t endSample, bool& stopOnError)
+    {
+        auto& buffer = buffers[nextBuffer];
+        buffer.cpuData.buffer = samples;
+        buffer.cpuData.sizeInBytes = count * sizeof(int16_t);
+        buffer.audio.audio = buffer.cpuData;
+        buffer.audio.samplingRate = parameters.samplingRate;
+        buffer.audio.channels = 1;
+        buffer.audio.bitsPerSample = 16;
+        buffer.audio.dataType = AudioDataType::ePCM;
+        buffer.streaming.signal = signal;
+
+        StreamingRecorderChunkInfo info{};
+        info.signal = signal;
+        info.sampleCount = count;
+        while ((info.result = buffer.ctx.instance->evaluateAsync(&buffer.ctx)) == kResultNotReady)
+        {
+            info.retries++;
+            thread::preciseSleep(std::chrono::milliseconds(1));
+        }
+        if (info.result == kResultOk)
+        {
+            nextBuffer ^= 1;
+        }
+        auto origin = origin100ns.load(std::memory_order_relaxed);
+        if (origin)
+        {
+            int64_t captured = origin + int64_t(endSample * 10000000ull / parameters.samplingRate);
+            info.deviceToSlotMs = (std::max)(0.0, (now100ns() - captured) / 10000.0);
+        }
+        {
+            std::lock_guard<std::mutex> lock(statsMtx);
+            info.index = stats.chunks++;
+            stats.retries += info.retries;
+            stats.lastDeviceToSlotMs = info.deviceToSlotMs;
+            stats.maxDeviceToSlotMs = (std::max)(stats.maxDeviceToSlotMs, info.deviceToSlotMs);
+            stats.avgDeviceToSlotMs += (info.deviceToSlotMs - stats.avgDeviceToSlotMs) / double(stats.chunks);
+        }
+        if (observer) observer(info);
+        stopOnError = info.result != kResultOk;
+        return info.result;
+    }
+
+    //! Consumer thread, cuts the ring into chunks and feeds the instance
+    void consume()
+    {
+        bool inFlight = false;
+        bool error = false;
+        uint64_t consumed{};
+        StreamSignal signal = StreamSignal::eStreamSignalStart;
+        auto wait = std::chrono::milliseconds((std::max)(1u, parameters.periodMs / 2));
+        while (!error)
+        {
+            size_t offset = inFlight ? chunkSamples : 0;
+            ai::AudioView<int16_t> view{};
+            if (ring->peek(offset + chunkSamples, view))
+            {
+                submit(view.first + offset, chunkSamples, signal, consumed + offset + chunkSamples, error);
+                if (error) break;
+                // Accepted, so the previous evaluation is done with the in-flight chunk
+                if (inFlight)
+                {
+                    ring->consume(chunkSamples);
+                    consumed += chunkSamples;
+                }
+                inFlight = true;
+                signal = StreamSignal::eStreamSignalData;
+                continue;
+            }
+            if (captureDone.load(std::memory_order_acquire))
+            {
+                // Capture stopped so 'available' is exact, anything left is shorter than a chunk
+                size_t remaining = ring->available() - offset;
+                if (remaining && ring->peek(offset + remaining, view))
+                {
+                    submit(view.first + offset, remaining, StreamSignal::eStreamSignalStop, consumed + offset + remaining, error);
+                }
+                else
+                {
+                    submit(silence.data(), silence.size(), StreamSignal::eStreamSignalStop, consumed + offset, error);
+                }
+                break;
+            }
+            thread::preciseSleep(wait);
+        }
+    }
+
+    //! Consumer thread with voice activity gating, the ring is analyzed frame by frame and only speech is submitted
+    //!
+    //! Gate copies speech into its own chunks so the ring is consumed right away, a chunk is recycled only
+    //! after the following one is accepted (same rule as in 'consume').
+    void consumeGated()
+    {
+        auto gateParameters = parameters.voiceActivity;
+        gateParameters.samplingRate = parameters.samplingRate;
+        gateParameters.chunkMs = parameters.chunkMs;
+        // Member so the final chunk outlives this thread, like the ring does for ungated chunks
+        gate = std::make_unique<ai::VoiceActivityGate<int16_t>>(gateParameters);
+        size_t frameSamples = gate->getFrameSamples();
+        bool error = false;
+        auto wait = std::chrono::milliseconds((std::max)(1u, parameters.periodMs / 2));
+        while (!error)
+        {
+            // Read before peeking, once capture is done everything it wrote is already in the ring
+            bool done = captureDone.load(std::memory_order_acquire);
+            ai::AudioView<int16_t> view{};
+            size_t count = ring->peek(frameSamples, view) ? frameSamples : 0;
+            if (!count && done)
+            {
+                count = ring->available();
+                if (count && !ring->peek(count, view)) count = 0;
+            }
+            if (count)
+            {
+                gate->process(view.first, view.firstCount);
+                gate->process(view.second, view.secondCount);
+                ring->consume(count);
+            }
+            else if (done)
+            {
+                gate->finish();
+            }
+
+            ai::VoiceActivityChunk<int16_t> chunk{};
+            while (!error && gate->acquire(chunk))
+            {
+                submit(chunk.samples, chunk.count, chunk.signal, chunk.firstSample + chunk.count, error);
+                gate->release();
+            }
+            {
+                std::lock_guard<std::mutex> lock(statsMtx);
+                auto gateStats = gate->getStats();
+                stats.gatedSamples = gateStats.gatedSamples;
+                stats.segments = gateStats.segments;
+            }
+            if (!count)
+            {
+                if (done) break;
+                thread::preciseSleep(wait);
+            }
+        }
+    }
+
+    StreamingRecorderParameters parameters{};
+    size_t chunkSamples{};
+    std::unique_ptr<ai::AudioRingBuffer<int16_t>> ring;
+    std::unique_ptr<ai::VoiceActivityGate<int16_t>> gate;
+    std::vector<int16_t> silence;
+
+    //! Everything an evaluation reads, one set is in flight while the other one is prepared
+    struct SubmitBuffer
+    {
+        InferenceExecutionContext ctx{};
+        CpuData cpuData{};
+        InferenceDataAudio audio{};
+        InferenceDataSlot slot{};
+        InferenceDataSlotArray slots{};
+        StreamingParameters streaming{};
+    };
+
+    Observer observer;
+    SubmitBuffer buffers[2]{};
+    uint32_t nextBuffer{};
+
+    bool running = false;
+    std::thread captureThread;
+    std::thread consumerThread;
+    std::atomic<bool> stopRequested{};
+    std::atomic<bool> captureReady{};
+    std::atomic<bool> captureError{};
+    std::atomic<bool> captureDone{};
+    std::atomic<int64_t> origin100ns{};
+    std::atomic<uint64_t> dropped{};
+
+    mutable std::mutex statsMtx;
+    StreamingRecorderStats stats{};
+};
+
 }
 }
\ No newline at end of file
@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <cuda.h>
+#include <array>
+
+#include "source/core/nvigi.api/nvigi_cuda.h"
+#include "source/utils/nvigi.d3d12/d3d12_image_preprocess.h"
+
+namespace nvigi
+{
+namespace cuda
+{
+
+//! Hands the output of 'd3d12::ImagePreprocessor' to CUDA backends without leaving VRAM
+//!
+//! Internal output buffers and queue fences are imported once as CUDA external memory/semaphores, each call makes
+//! 'stream' wait for the D3D12 dispatch on the GPU and returns the mapped device pointer in 'CudaData'. The preprocessor
+//! must be initialized with 'shareable' set and on the same adapter as the CUDA context.
+//!
+//! Returned buffer stays valid until 'kOutputBufferCount' further calls, consumer must enqueue its work on 'stream'
+//! before the next call. Buffer is not overwritten before that work completes.
+//!
+//! NOTE: Caller makes the CUDA context current (see 'RuntimeContextScope'), not thread safe
+struct ImagePreprocessorExport
+{
+    Result process(d3d12::ImagePreprocessor& preprocessor, const InferenceDataImage* image, const ImagePreprocessParameters& desc, CUstream stream, CudaData& output)
+    {
+        // Work enqueued on the stream so far consumed the previous output, D3D12 must not overwrite it earlier
+        if (lastIndex < entries.size() && entries[lastIndex].released)
+        {
+            cuEventRecord(entries[lastIndex].released, stream);
+            entries[lastIndex].releasePending = true;
+        }
+        auto index = preprocessor.getNextOutputIndex();
+        auto& entry = entries[index];
+        if (entry.releasePending)
+        {
+            // Normally long done, the buffer was handed out 'kOutputBufferCount' calls ago
+            cuEventSynchronize(entry.released);
+            entry.releasePending = false;
+        }
+
+        D3D12Data d3d12Output{};
+        if (NVIGI_FAILED(res, preprocessor.process(image, desc, d3d12Output))) return res;
+        lastIndex = index;
+
+        auto& buffer = preprocessor.getOutputBuffer(index);
+        if (entry.serial != buffer.serial)
+        {
+            if (NVIGI_FAILED(res, importBuffer(buffer, entry))) return res;
+        }
+        auto semaphore = getSemaphore(d3d12Output.fence);
+        if (!semaphore) return kResultInvalidState;
+
+        CUDA_EXTERNAL_SEMAPHORE_WAIT_PARAMS waitParams{};
+        waitParams.params.fence.value = d3d12Output.fenceValue;
+        if (cuWaitExternalSemaphoresAsync(&semaphore, &waitParams, 1, stream) != CUDA_SUCCESS)
+        {
+            NVIGI_LOG_ERROR("Failed to wait on the image preprocessing fence");
+            return kResultInvalidState;
+        }
+        output.buffer = (const void*)entry.pointer;
+        output.sizeInBytes = preprocessor.getLastOutputSize();
+        if (output.getVersion() >= 2) output.stream = stream;
+        return kResultOk;
+    }
+
+    void shutdown()
+    {
+        for (auto& entry : entries)
+        {
+            if (entry.releasePending) cuEventSynchronize(entry.released);
+            releaseBuffer(entry);
+            if (entry.released) cuEventDestroy(entry.released);
+            entry = {};
+        }
+        for (auto& semaphore : semaphores)
+        {
+            if (semaphore.semaphore) cuDestroyExternalSemaphore(semaphore.semaphore);
+            semaphore = {};
+        }
+        lastIndex = UINT32_MAX;
+    }
+
+private:
+    struct Entry
+    {
+        CUexternalMemory memory{};
+        CUdeviceptr pointer{};
+        uint64_t serial{};
+        CUevent released{};
+        bool releasePending{};
+    };
+
+    struct Semaphore
+    {
+        ID3D12Fence* fence{};
+        CUexternalSemaphore semaphore{};
+    };
+
+    static void releaseBuffer(Entry& entry)
+    {
+        if (entry.pointer) cuMemFree(entry.pointer);
+        if (entry.memory) cuDestroyExternalMemory(entry.memory);
+        entry.pointer = {};
+        entry.memory = {};
+        entry.serial = 0;
+    }
+
+    static HANDLE createSharedHandle(ID3D12Device* device, ID3D12DeviceChild* object)
+    {
+        HANDLE handle{};
+        if (FAILED(device->CreateSharedHandle(object, nullptr, GENERIC_ALL, nullptr, &handle))) return nullptr;
+        return handle;
+    }
+
+    Result importBuffer(const d3d12::ImagePreprocessor::OutputBuffer& buffer, Entry& entry)
+    {
+        releaseBuffer(entry);
+        if (!entry.released && cuEventCreate(&entry.released, CU_EVENT_DISABLE_TIMING) != CUDA_SUCCESS) return kResultInvalidState;
+
+        ID3D12Device* device{};
+        buffer.resource->GetDevice(IID_PPV_ARGS(&device));
+        HANDLE handle = device ? createSharedHandle(device, buffer.resource) : nullptr;
+        auto resourceDesc = buffer.resource->GetDesc();
+        auto allocationSize = device ? device->GetResourceAllocationInfo(0, 1, &resourceDesc).SizeInBytes : 0;
+        if (device) device->Release();
+        if (!handle)
+        {
+            NVIGI_LOG_ERROR("Failed to share image preprocessing output, was the preprocessor initialized as 'shareable'?");
+            return kResultInvalidState;
+        }
+
+        CUDA_EXTERNAL_MEMORY_HANDLE_DESC memoryDesc{};
+        memoryDesc.type = CU_EXTERNAL_MEMORY_HANDLE_TYPE_D3D12_RESOURCE;
+        memoryDesc.handle.win32.handle = handle;
+        memoryDesc.size = allocationSize;
+        memoryDesc.flags = CUDA_EXTERNAL_MEMORY_DEDICATED;
+        CUresult result = cuImportExternalMemory(&entry.memory, &memoryDesc);
+        CloseHandle(handle);
+        if (result == CUDA_SUCCESS)
+        {
+            CUDA_EXTERNAL_MEMORY_BUFFER_DESC bufferDesc{};
+            bufferDesc.size = buffer.size;
+            result = cuExternalMemoryGetMappedBuffer(&entry.pointer, entry.memory, &bufferDesc);
+        }
+        if (result != CUDA_SUCCESS)
+        {
+            releaseBuffer(entry);
+            NVIGI_LOG_ERROR("Failed to import image preprocessing output into CUDA - error %d", result);
+            return kResultInvalidState;
+        }
+        entry.serial = buffer.serial;
+        return kResultOk;
+    }
+
+    CUexternalSemaphore getSemaphore(ID3D12Fence* fence)
+    {
+        for (auto& semaphore : semaphores)
+        {
+            if (semaphore.fence == fence) return semaphore.semaphore;
+        }
+        auto slot = std::find_if(semaphores.begin(), semaphores.end(), [](const Semaphore& s) { return !s.fence; });
+        if (!fence || slot == semaphores.end()) return nullptr;
+
+        ID3D12Device* device{};
+        fence->GetDevice(IID_PPV_ARGS(&device));
+        HANDLE handle = device ? createSharedHandle(device, fence) : nullptr;
+        if (device) device->Release();
+        if (!handle)
+        {
+            NVIGI_LOG_ERROR("Failed to share image preprocessing fence");
+            return nullptr;
+        }
+        CUDA_EXTERNAL_SEMAPHORE_HANDLE_DESC semaphoreDesc{};
+        semaphoreDesc.type = CU_EXTERNAL_SEMAPHORE_HANDLE_TYPE_D3D12_FENCE;
+        semaphoreDesc.handle.win32.handle = handle;
+        CUexternalSemaphore semaphore{};
+        CUresult result = cuImportExternalSemaphore(&semaphore, &semaphoreDesc);
+        CloseHandle(handle);
+        if (result != CUDA_SUCCESS)
+        {
+            NVIGI_LOG_ERROR("Failed to import image preprocessing fence into CUDA - error %d", result);
+            return nullptr;
+        }
+        *slot = { fence, semaphore };
+        return semaphore;
+    }
+
+    std::array<Entry, d3d12::ImagePreprocessor::kOutputBufferCount> entries{};
+    //! Compute and direct queue fences
+    std::array<Semaphore, 2> semaphores{};
+    uint32_t lastIndex = UINT32_MAX;
+};
+
+} // namespace cuda
+} // namespace nvigi
@@ -7,15 +7,15 @@
 #include "runtime_context_scope.h"
 
 #include "source/core/nvigi.log/log.h"
+#include "source/core/nvigi.thread/thread.h"
 #include "source/core/nvigi.api/nvigi_cuda.h"
 #include "source/core/nvigi.api/nvigi_result.h"
 #include "source/core/nvigi.api/nvigi_vulkan.h"
 #include "source/plugins/nvigi.hwi/cuda/nvigi_hwi_cuda.h"
 
 #include <cuda.h>
-#include <unordered_set>
+#include <atomic>
 #include <thread>
-#include <mutex>
 #include <assert.h>
 
 #define CUDA_CTX_DEBUG 0
@@ -46,15 +46,31 @@ namespace nvigi
     // thread or a worker thread, threads can be spawned between a push and a pop,
     // and Cuda tracks current context per thread. For this reason we have to track
     // whether or not our context is active (has been pushed) per thread. We store 
-    // this in an unordered_set, but protect it with a mutex to make it threadsafe.
+    // this in a thread::ThreadContext so lookups are thread_local without any locks.
+    //
+    // Long-lived evaluation threads can pin the context instead, it then stays current
+    // on that thread and push/pop (including RuntimeContextScope) become no-ops there.
+    //
+    // If our context is already current on the thread (host or an outer scope made it
+    // current) the push/pop pair is elided, only the bookkeeping is done. Actual driver
+    // switches are counted, see 'getContextSwitchCount' and 'getElidedSwitchCount'.
 
     struct PushPoppableCudaContext
     {
         bool useCudaCtx = false;
         bool cudaCtxNeedsRelease = false;
         bool constructorSucceeded = false;
-        std::unordered_set<std::thread::id> threadsThatHavePushed;
-        std::mutex threadsThatHavePushedMutex;
+        struct ThreadState
+        {
+            bool pushed = false;
+            bool pinned = false;
+            // Context was already current when pushed, nothing to pop
+            bool elided = false;
+        };
+        thread::ThreadContext<ThreadState> threadState;
+        // cuCtxPushCurrent/cuCtxPopCurrent calls actually made, and push/pop pairs skipped
+        std::atomic<uint64_t> contextSwitches{};
+        std::atomic<uint64_t> elidedSwitches{};
         CUcontext cudaCtx{};
         nvigi::IHWICuda* icig{};
         bool usingCiG = false;
@@ -201,6 +217,10 @@ namespace nvigi
 
         ~PushPoppableCudaContext()
         {
+            if (useCudaCtx)
+            {
+                NVIGI_LOG_VERBOSE("CUDA context switches %llu, elided %llu", contextSwitches.load(), elidedSwitches.load());
+            }
             if (cudaCtxNeedsRelease)
             {
                 // If user didn't give us a context, then we retained device 0's primary 
@@ -237,126 +257,142 @@ namespace nvigi
 
         bool isUsingCiG() { return usingCiG; }
 
-        void pushRuntimeContext()
+        uint64_t getContextSwitchCount() const { return contextSwitches.load(std::memory_order_relaxed); }
+        uint64_t getElidedSwitchCount() const { return elidedSwitches.load(std::memory_order_relaxed); }
+
+        bool isPinnedOnThisThread()
         {
-            if (useCudaCtx)
+            return threadState.getContext().pinned;
+        }
+
+        // Keeps our context current on the calling thread until unpinRuntimeContext is called
+        void pinRuntimeContext()
+        {
+            if (useCudaCtx && !isPinnedOnThisThread())
             {
-                bool alreadyPushed;
+                pushRuntimeContext();
+                auto& state = threadState.getContext();
+                if (state.pushed)
                 {
-                    const std::lock_guard<std::mutex> lock(threadsThatHavePushedMutex);
-                    auto iter = threadsThatHavePushed.find(std::this_thread::get_id());
-                    alreadyPushed = (iter != threadsThatHavePushed.end());
+                    state.pinned = true;
                 }
-                if (alreadyPushed)
-                {
-                    NVIGI_LOG_ERROR("Pushing CUDA context when it is already active");
-                    assert(false && "Pushing CUDA context when it is already active");
-                    return;
-                }
-                
+            }
+        }
+        void unpinRuntimeContext()
+        {
+            if (useCudaCtx && isPinnedOnThisThread())
+            {
+                threadState.getContext().pinned = false;
+                popRuntimeContext();
+            }
+        }
+
+        void pushRuntimeContext()
+        {
+            if (!useCudaCtx) return;
+            auto& state = threadState.getContext();
+            if (state.pinned) return;
+            if (state.pushed)
+            {
+                NVIGI_LOG_ERROR("Pushing CUDA context when it is already active");
+                assert(false && "Pushing CUDA context when it is already active");
+                return;
+            }
+
+            // Thread local lookup in the driver, much cheaper than a push/pop pair
+            CUcontext currentCtx = nullptr;
+            cuCtxGetCurrent(&currentCtx);
+            if (currentCtx == cudaCtx)
+            {
+                state.pushed = true;
+                state.elided = true;
+                elidedSwitches.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
 #if CUDA_CTX_DEBUG                
-                // Log the current context before pushing
-                CUcontext currentCtx = nullptr;
-                cuCtxGetCurrent(&currentCtx);
-                NVIGI_LOG_INFO("[CUDA_CTX_DEBUG] PUSH: thread_id=0x%llx, about to push context=%p, current_context_before_push=%p", 
-                               (unsigned long long)std::hash<std::thread::id>{}(std::this_thread::get_id()),
-                               cudaCtx, currentCtx);
+            NVIGI_LOG_INFO("[CUDA_CTX_DEBUG] PUSH: thread_id=0x%llx, about to push context=%p, current_context_before_push=%p", 
+                           (unsigned long long)std::hash<std::thread::id>{}(std::this_thread::get_id()),
+                           cudaCtx, currentCtx);
 #endif                
-                CUresult pushResult = cuCtxPushCurrent(cudaCtx);
-                if (CUDA_SUCCESS != pushResult)
-                {
-                    NVIGI_LOG_ERROR("Pushing CUDA context failed, error code: %d", pushResult);
-                    assert(false && "Pushing CUDA context failed");
-                    return;
-                }
-
-                {
-                    const std::lock_guard<std::mutex> lock(threadsThatHavePushedMutex);
-                    threadsThatHavePushed.insert(std::this_thread::get_id());
-                }
+            CUresult pushResult = cuCtxPushCurrent(cudaCtx);
+            if (CUDA_SUCCESS != pushResult)
+            {
+                NVIGI_LOG_ERROR("Pushing CUDA context failed, error code: %d", pushResult);
+                assert(false && "Pushing CUDA context failed");
+                return;
+            }
+            contextSwitches.fetch_add(1, std::memory_order_relaxed);
+            state.pushed = true;
+            state.elided = false;
 #if CUDA_CTX_DEBUG                 
-                NVIGI_LOG_INFO("[CUDA_CTX_DEBUG] PUSH: succeeded, context=%p is now active on thread 0x%llx", 
-                               cudaCtx, (unsigned long long)std::hash<std::thread::id>{}(std::this_thread::get_id()));
+            NVIGI_LOG_INFO("[CUDA_CTX_DEBUG] PUSH: succeeded, context=%p is now active on thread 0x%llx", 
+                           cudaCtx, (unsigned long long)std::hash<std::thread::id>{}(std::this_thread::get_id()));
 #endif                               
-            }
         }
         void popRuntimeContext()
         {
-            if (useCudaCtx)
+            if (!useCudaCtx) return;
+            auto& state = threadState.getContext();
+            if (state.pinned) return;
+            if (!state.pushed)
             {
-                CUcontext oldCtx{};
+                NVIGI_LOG_ERROR("Popping CUDA context when it was not active");
+                assert(false && "Popping CUDA context when it was not active");
+                return;
+            }
+            if (state.elided)
+            {
+                // Context was current before our push, leave it that way
+                state.pushed = false;
+                state.elided = false;
+                return;
+            }
 
-                bool wasPushed;
-                {
-                    const std::lock_guard<std::mutex> lock(threadsThatHavePushedMutex);
-                    auto iter = threadsThatHavePushed.find(std::this_thread::get_id());
-                    wasPushed = (iter != threadsThatHavePushed.end());
-                }
-                if (!wasPushed)
-                {
-                    NVIGI_LOG_ERROR("Popping CUDA context when it was not active");
-                    assert(false && "Popping CUDA context when it was not active");
-                    return;
-                }
-                
 #if CUDA_CTX_DEBUG                 
-                // Log the current context before popping
-                CUcontext currentCtx = nullptr;
-                cuCtxGetCurrent(&currentCtx);
-                NVIGI_LOG_INFO("[CUDA_CTX_DEBUG] POP: thread_id=0x%llx, expected_context=%p, current_context_before_pop=%p", 
-                               (unsigned long long)std::hash<std::thread::id>{}(std::this_thread::get_id()),
-                               cudaCtx, currentCtx);
+            CUcontext currentCtx = nullptr;
+            cuCtxGetCurrent(&currentCtx);
+            NVIGI_LOG_INFO("[CUDA_CTX_DEBUG] POP: thread_id=0x%llx, expected_context=%p, current_context_before_pop=%p", 
+                           (unsigned long long)std::hash<std::thread::id>{}(std::this_thread::get_id()),
+                           cudaCtx, currentCtx);
 #endif
 
-                CUresult popResult = cuCtxPopCurrent(&oldCtx);
-                if (CUDA_SUCCESS != popResult)
-                {
-                    NVIGI_LOG_ERROR("Popping CUDA context failed, error code: %d", popResult);
-                    assert(false && "Popping CUDA context failed");
-                    return;
-                }
-                
+            CUcontext oldCtx{};
+            CUresult popResult = cuCtxPopCurrent(&oldCtx);
+            if (CUDA_SUCCESS != popResult)
+            {
+                NVIGI_LOG_ERROR("Popping CUDA context failed, error code: %d", popResult);
+                assert(false && "Popping CUDA context failed");
+                return;
+            }
+            contextSwitches.fetch_add(1, std::memory_order_relaxed);
+            
 #if CUDA_CTX_DEBUG                   
-                // Get the context that's now current after the pop
-                CUcontext newCurrentCtx = nullptr;
-                cuCtxGetCurrent(&newCurrentCtx);
+            CUcontext newCurrentCtx = nullptr;
+            cuCtxGetCurrent(&newCurrentCtx);
 #endif                
-                if (oldCtx != cudaCtx)
-                {
+            if (oldCtx != cudaCtx)
+            {
 #if CUDA_CTX_DEBUG                      
-                    NVIGI_LOG_ERROR("[CUDA_CTX_DEBUG] CONTEXT MISMATCH DETECTED!");
-                    NVIGI_LOG_ERROR("  Thread ID:                    0x%llx", 
-                                    (unsigned long long)std::hash<std::thread::id>{}(std::this_thread::get_id()));
-                    NVIGI_LOG_ERROR("  Expected context to pop:      %p", cudaCtx);
-                    NVIGI_LOG_ERROR("  Context before pop:           %p", currentCtx);
-                    NVIGI_LOG_ERROR("  Context actually popped:      %p", oldCtx);
-                    NVIGI_LOG_ERROR("  Context now current after pop:%p", newCurrentCtx);
-                    NVIGI_LOG_ERROR("  Using CiG:                    %s", usingCiG ? "YES" : "NO");
-                    
-                    // Log all threads that have pushed
-                    {
-                        const std::lock_guard<std::mutex> lock(threadsThatHavePushedMutex);
-                        NVIGI_LOG_ERROR("  Threads with active push: %zu", threadsThatHavePushed.size());
-                        for (const auto& tid : threadsThatHavePushed)
-                        {
-                            NVIGI_LOG_ERROR("    - Thread 0x%llx", (unsigned long long)std::hash<std::thread::id>{}(tid));
-                        }
-                    }
+                NVIGI_LOG_ERROR("[CUDA_CTX_DEBUG] CONTEXT MISMATCH DETECTED!");
+                NVIGI_LOG_ERROR("  Thread ID:                    0x%llx", 
+                                (unsigned long long)std::hash<std::thread::id>{}(std::this_thread::get_id()));
+                NVIGI_LOG_ERROR("  Expected context to pop:      %p", cudaCtx);
+                NVIGI_LOG_ERROR("  Context before pop:           %p", currentCtx);
+                NVIGI_LOG_ERROR("  Context actually popped:      %p", oldCtx);
+                NVIGI_LOG_ERROR("  Context now current after pop:%p", newCurrentCtx);
+                NVIGI_LOG_ERROR("  Using CiG:                    %s", usingCiG ? "YES" : "NO");
 #endif                    
-                    NVIGI_LOG_ERROR("Popping the wrong CUDA context");
-                    assert(false && "Popping the wrong CUDA context");
-                    return;
-                }
+                NVIGI_LOG_ERROR("Popping the wrong CUDA context");
+                assert(false && "Popping the wrong CUDA context");
+                return;
+            }
 
-                {
-                    const std::lock_guard<std::mutex> lock(threadsThatHavePushedMutex);
-                    threadsThatHavePushed.erase(std::this_thread::get_id());
-                }
+            state.pushed = false;
 #if CUDA_CTX_DEBUG                 
-                NVIGI_LOG_INFO("[CUDA_CTX_DEBUG] POP: succeeded, popped context=%p, now current=%p on thread 0x%llx", 
-                               oldCtx, newCurrentCtx, (unsigned long long)std::hash<std::thread::id>{}(std::this_thread::get_id()));
+            NVIGI_LOG_INFO("[CUDA_CTX_DEBUG] POP: succeeded, popped context=%p, now current=%p on thread 0x%llx", 
+                           oldCtx, newCurrentCtx, (unsigned long long)std::hash<std::thread::id>{}(std::this_thread::get_id()));
 #endif                               
-            }
         }
     };
 
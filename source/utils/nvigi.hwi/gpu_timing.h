@@ -0,0 +1,260 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+#include <unordered_map>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "source/utils/nvigi.ai/nvigi_ai.h"
+
+namespace nvigi::gpu_timing
+{
+
+//! Used by the hwi plugins to resolve GPU timings off the evaluation thread
+//!
+//! Each job is polled until it returns true, jobs are expected to wait for the GPU with a short timeout
+//! so shutdown and 'abort' are never blocked on a hung GPU.
+struct Resolver
+{
+    using Job = std::function<bool(bool shuttingDown)>;
+
+    //! What a job depends on, used to abort it before that goes away
+    struct Tag
+    {
+        //! Stable identifier of the device/context the job waits on, 0 if not needed
+        uint64_t contextId{};
+        //! As passed with the resolution callback
+        const void* userData{};
+    };
+    using TagMatch = std::function<bool(const Tag& tag)>;
+
+    ~Resolver() { stop(); }
+
+    void submit(const Tag& tag, Job job)
+    {
+        {
+            std::scoped_lock lock(mtx);
+            if (!thread.joinable())
+            {
+                running = true;
+                thread = std::thread([this]() { loop(); });
+            }
+            jobs.push_back({ tag, std::move(job) });
+        }
+        cv.notify_all();
+    }
+
+    //! Matching jobs are called with 'shuttingDown' so they can release their resources but must not report anything,
+    //! blocks until a matching job running on the resolver thread returns
+    //!
+    //! NOTE: Must not be called from a job or a callback it triggers
+    void abort(const TagMatch& match)
+    {
+        std::vector<Entry> aborted;
+        {
+            std::unique_lock lock(mtx);
+            for (auto it = jobs.begin(); it != jobs.end();)
+            {
+                if (match(it->tag))
+                {
+                    aborted.push_back(std::move(*it));
+                    it = jobs.erase(it);
+                }
+                else
+                {
+                    it++;
+                }
+            }
+            // Running job is not re-queued while we are waiting, see 'loop'
+            aborts.push_back(&match);
+            cv.wait(lock, [this, &match]() { return !busy || !match(current); });
+            aborts.erase(std::find(aborts.begin(), aborts.end(), &match));
+        }
+        for (auto& entry : aborted)
+        {
+            entry.job(true);
+        }
+    }
+
+    //! Pending jobs are called with 'shuttingDown' so they can release their resources
+    void stop()
+    {
+        {
+            std::scoped_lock lock(mtx);
+            running = false;
+        }
+        cv.notify_all();
+        if (thread.joinable()) thread.join();
+    }
+
+private:
+    struct Entry
+    {
+        Tag tag;
+        Job job;
+    };
+
+    void loop()
+    {
+        std::unique_lock lock(mtx);
+        while (true)
+        {
+            cv.wait(lock, [this]() { return !jobs.empty() || !running; });
+            if (jobs.empty()) break;
+            auto entry = std::move(jobs.front());
+            jobs.pop_front();
+            bool shuttingDown = !running;
+            busy = true;
+            current = entry.tag;
+            lock.unlock();
+            bool done = entry.job(shuttingDown);
+            lock.lock();
+            if (!done)
+            {
+                if (std::any_of(aborts.begin(), aborts.end(), [&entry](const TagMatch* match) { return (*match)(entry.tag); }))
+                {
+                    // Aborted while waiting for the GPU, 'abort' is blocked until this returns
+                    lock.unlock();
+                    entry.job(true);
+                    lock.lock();
+                }
+                else
+                {
+                    // GPU not done yet, keep FIFO order since work on a queue completes in order
+                    jobs.push_front(std::move(entry));
+                }
+            }
+            busy = false;
+            cv.notify_all();
+        }
+    }
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<Entry> jobs;
+    std::vector<const TagMatch*> aborts;
+    Tag current{};
+    bool busy = false;
+    std::thread thread;
+    bool running = false;
+};
+
+//! Used by inference plugins, one per instance, to fill in 'EvaluationGpuTimingStats' chained to execution contexts
+//!
+//! Typical flow with token based hwi APIs:
+//!
+//! gpu_timing::Tracker tracker([ihwi](void* userData) { ihwi->d3d12GpuTimingAbort(userData); });
+//! ...
+//! uint32_t token;
+//! ihwi->d3d12GpuTimingBegin(device, commandList, &token);
+//! tracker.track(token, findStruct<EvaluationGpuTimingStats>(execCtx->runtimeParameters));
+//! ... record inference work ...
+//! ihwi->d3d12GpuTimingEnd(commandList, token);
+//! queue->ExecuteCommandLists(...);
+//! ihwi->d3d12GpuTimingSubmit(queue, token, gpu_timing::Tracker::onResolved, tracker.getUserData());
+struct Tracker
+{
+    //! 'abort' is optional, it should drop measurements pending for 'userData' (d3d12GpuTimingAbort or cudaGpuTimingAbort).
+    //! Without it state shared with pending measurements outlives the tracker until they resolve.
+    explicit Tracker(std::function<void(void* userData)> abort = {}) : m_abort(std::move(abort)), m_state(new State{}) {}
+
+    Tracker(const Tracker&) = delete;
+    Tracker& operator=(const Tracker&) = delete;
+
+    ~Tracker()
+    {
+        // Never blocks on the GPU, either nothing resolves after abort or the last resolution releases the state
+        if (m_abort) m_abort(m_state);
+        std::unique_lock lock(m_state->mtx);
+        m_state->detached = true;
+        if (m_abort) m_state->pending.clear();
+        for (auto& [token, stats] : m_state->pending)
+        {
+            // Stats are owned by the host and only guaranteed to be valid until the instance is destroyed
+            stats = nullptr;
+        }
+        bool release = m_state->pending.empty();
+        lock.unlock();
+        if (release) delete m_state;
+    }
+
+    //! Stats are optional, timings are still accumulated per instance
+    void track(uint32_t token, EvaluationGpuTimingStats* stats)
+    {
+        std::scoped_lock lock(m_state->mtx);
+        m_state->pending[token] = stats;
+    }
+
+    //! Measurement was abandoned (evaluation failed before submitting)
+    void untrack(uint32_t token)
+    {
+        std::scoped_lock lock(m_state->mtx);
+        m_state->pending.erase(token);
+    }
+
+    //! Passed as 'userData' with 'onResolved'
+    void* getUserData() const { return m_state; }
+
+    //! Matches PFun_nvigiD3D12GpuTimingCallback and PFun_nvigiCudaGpuTimingCallback
+    static void onResolved(uint32_t token, uint64_t gpuTimeUs, void* userData)
+    {
+        static_cast<State*>(userData)->resolve(token, gpuTimeUs);
+    }
+
+    uint64_t getAverageGpuTimeUs() const
+    {
+        std::scoped_lock lock(m_state->mtx);
+        return m_state->count ? m_state->totalUs / m_state->count : 0;
+    }
+
+private:
+    struct State
+    {
+        void resolve(uint32_t token, uint64_t gpuTimeUs)
+        {
+            std::unique_lock lock(mtx);
+            count++;
+            totalUs += gpuTimeUs;
+            maxUs = std::max(maxUs, gpuTimeUs);
+            auto it = pending.find(token);
+            if (it != pending.end())
+            {
+                if (auto stats = it->second)
+                {
+                    stats->gpuTimeUs = gpuTimeUs;
+                    stats->instanceAverageGpuTimeUs = totalUs / count;
+                    stats->instanceMaxGpuTimeUs = maxUs;
+                    stats->instanceEvaluationCount = count;
+                    std::atomic_ref<uint32_t>(stats->resolved).store(1, std::memory_order_release);
+                }
+                pending.erase(it);
+            }
+            bool release = detached && pending.empty();
+            lock.unlock();
+            if (release) delete this;
+        }
+
+        mutable std::mutex mtx;
+        std::unordered_map<uint32_t, EvaluationGpuTimingStats*> pending;
+        uint32_t count{};
+        uint64_t totalUs{};
+        uint64_t maxUs{};
+        //! Tracker is gone, last pending resolution releases the state
+        bool detached = false;
+    };
+
+    std::function<void(void* userData)> m_abort;
+    State* m_state{};
+};
+
+} // namespace nvigi::gpu_timing
@@ -0,0 +1,571 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+#include <algorithm>
+#include <errno.h>
+#include <cstdio>
+
+#ifdef NVIGI_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+#include "nvigi_io.h"
+#include "source/core/nvigi.extra/extra.h"
+#include "source/core/nvigi.thread/thread.h"
+
+namespace nvigi
+{
+
+//! Asynchronous file IO callbacks
+//!
+//! Implements 'readAsync'/'waitAsync' on top of overlapped IO completed on an IO completion port (Windows)
+//! or positional reads executed on a small worker pool (other platforms). Synchronous callbacks are
+//! implemented as well so the same handle can be used by loaders which are not async aware.
+//!
+//! At most 'queueDepth' reads are in flight per handle, 'readAsync' blocks when the queue is full.
+
+struct AsyncFileIOOptions
+{
+    //! Maximum number of reads in flight per handle
+    uint32_t queueDepth = 8;
+    //! Access is mostly sequential (typical weight loading), enables aggressive read ahead
+    bool sequential = true;
+};
+
+struct AsyncFileRequest
+{
+#ifdef NVIGI_WINDOWS
+    // Must be first, completion port hands us back the OVERLAPPED pointer
+    OVERLAPPED overlapped{};
+#endif
+    FileIOReadCompletion completion{};
+    void* completionContext{};
+};
+
+struct AsyncFile
+{
+    size_t size{};
+    size_t position{};
+    std::string identifier;
+    Result lastError = kResultOk;
+    uint32_t queueDepth{};
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    uint32_t inFlight{};
+    Result asyncError = kResultOk;
+
+#ifdef NVIGI_WINDOWS
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE port{};
+    std::thread completionThread;
+#else
+    int fd = -1;
+    std::unique_ptr<thread::WorkerPool> workers;
+#endif
+};
+
+// Thread-local storage for errors that occur before we have a handle (e.g., open failures)
+static thread_local Result g_asyncIOLastError = kResultOk;
+
+static void async_complete(AsyncFile* file, AsyncFileRequest* request, Result result, size_t bytesRead)
+{
+    request->completion(request->completionContext, result, bytesRead);
+    delete request;
+    // Notify under the lock, waiter in 'close' destroys the file as soon as it observes no reads in flight
+    std::scoped_lock lock(file->mtx);
+    if (result != kResultOk && file->asyncError == kResultOk) file->asyncError = result;
+    file->inFlight--;
+    file->cv.notify_all();
+}
+
+#ifdef NVIGI_WINDOWS
+static void async_completionLoop(AsyncFile* file)
+{
+    SetThreadDescription(GetCurrentThread(), L"nvigi.io.completion");
+    while (true)
+    {
+        DWORD bytes{};
+        ULONG_PTR key{};
+        OVERLAPPED* overlapped{};
+        BOOL ok = GetQueuedCompletionStatus(file->port, &bytes, &key, &overlapped, INFINITE);
+        if (!overlapped)
+        {
+            // Posted by close (or port is gone), all reads are retired by then
+            break;
+        }
+        Result result = kResultOk;
+        if (!ok)
+        {
+            auto error = GetLastError();
+            result = error == ERROR_HANDLE_EOF ? kResultOk : kResultIOError;
+        }
+        async_complete(file, reinterpret_cast<AsyncFileRequest*>(overlapped), result, bytes);
+    }
+}
+#endif
+
+static Result async_waitAsync(void* user_data, void* handle);
+
+static void async_destroy(AsyncFile* file)
+{
+#ifdef NVIGI_WINDOWS
+    if (file->completionThread.joinable())
+    {
+        PostQueuedCompletionStatus(file->port, 0, 0, nullptr);
+        file->completionThread.join();
+    }
+    if (file->port) CloseHandle(file->port);
+    if (file->file != INVALID_HANDLE_VALUE) CloseHandle(file->file);
+#else
+    file->workers.reset();
+    if (file->fd >= 0) ::close(file->fd);
+#endif
+    delete file;
+}
+
+static void* async_open(void* user_data, const char* fname, const char* mode)
+{
+    static const AsyncFileIOOptions s_defaultOptions{};
+    auto options = user_data ? static_cast<const AsyncFileIOOptions*>(user_data) : &s_defaultOptions;
+
+    if (!fname || !mode || std::string(mode) != "rb")
+    {
+        NVIGI_LOG_ERROR("Asynchronous IO supports only 'rb' mode");
+        g_asyncIOLastError = kResultNoImplementation;
+        return nullptr;
+    }
+
+    auto file = new (std::nothrow) AsyncFile();
+    if (!file)
+    {
+        g_asyncIOLastError = kResultInsufficientResources;
+        return nullptr;
+    }
+    file->identifier = fname;
+    file->queueDepth = std::max(1u, options->queueDepth);
+
+#ifdef NVIGI_WINDOWS
+    auto path = extra::utf8ToUtf16(fname);
+    file->file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_FLAG_OVERLAPPED | (options->sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS), nullptr);
+    LARGE_INTEGER size{};
+    if (file->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file->file, &size))
+    {
+        NVIGI_LOG_ERROR("Failed to open '%s' - error %u", fname, GetLastError());
+        g_asyncIOLastError = kResultItemNotFound;
+        async_destroy(file);
+        return nullptr;
+    }
+    file->size = size_t(size.QuadPart);
+    file->port = CreateIoCompletionPort(file->file, nullptr, 0, 1);
+    if (!file->port)
+    {
+        NVIGI_LOG_ERROR("Failed to create IO completion port for '%s' - error %u", fname, GetLastError());
+        g_asyncIOLastError = kResultIOError;
+        async_destroy(file);
+        return nullptr;
+    }
+    file->completionThread = std::thread(async_completionLoop, file);
+#else
+    file->fd = ::open(fname, O_RDONLY | O_CLOEXEC);
+    struct stat st {};
+    if (file->fd < 0 || fstat(file->fd, &st) != 0)
+    {
+        NVIGI_LOG_ERROR("Failed to open '%s' - errno %d", fname, errno);
+        g_asyncIOLastError = kResultItemNotFound;
+        async_destroy(file);
+        return nullptr;
+    }
+    file->size = size_t(st.st_size);
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(file->fd, 0, 0, options->sequential ? POSIX_FADV_SEQUENTIAL : POSIX_FADV_RANDOM);
+#endif
+    // Workers are created on first 'readAsync', plain synchronous readers never pay for them
+#endif
+
+    g_asyncIOLastError = kResultOk;
+    return file;
+}
+
+static void async_close(void* user_data, void* handle)
+{
+    if (!handle) return;
+    auto file = static_cast<AsyncFile*>(handle);
+    async_waitAsync(user_data, handle);
+    async_destroy(file);
+}
+
+static size_t async_size(void* user_data, void* handle)
+{
+    (void)user_data;
+    return static_cast<AsyncFile*>(handle)->size;
+}
+
+static size_t async_tell(void* user_data, void* handle)
+{
+    (void)user_data;
+    return static_cast<AsyncFile*>(handle)->position;
+}
+
+static int async_seek(void* user_data, void* handle, size_t offset, int whence)
+{
+    (void)user_data;
+    auto file = static_cast<AsyncFile*>(handle);
+
+    size_t new_position = 0;
+    switch (whence)
+    {
+    case SEEK_SET:
+        new_position = offset;
+        break;
+    case SEEK_CUR:
+        new_position = file->position + offset;
+        break;
+    case SEEK_END:
+        new_position = file->size + offset;
+        break;
+    default:
+        file->lastError = kResultInvalidParameter;
+        return EINVAL;
+    }
+
+    if (new_position > file->size)
+    {
+        file->lastError = kResultOutOfRange;
+        return EOVERFLOW;
+    }
+
+    file->position = new_position;
+    file->lastError = kResultOk;
+    return 0;
+}
+
+//! Positional blocking read, does not touch the file position
+static size_t async_readAt(AsyncFile* file, size_t offset, void* ptr, size_t len, Result& result)
+{
+    result = kResultOk;
+    size_t total = 0;
+    auto dst = static_cast<uint8_t*>(ptr);
+    while (total < len)
+    {
+#ifdef NVIGI_WINDOWS
+        OVERLAPPED overlapped{};
+        auto at = offset + total;
+        overlapped.Offset = DWORD(at & 0xffffffff);
+        overlapped.OffsetHigh = DWORD(uint64_t(at) >> 32);
+        // Low bit set on the event prevents the completion from being queued to the port
+        HANDLE event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        overlapped.hEvent = (HANDLE)((ULONG_PTR)event | 1);
+        DWORD chunk = DWORD(std::min<size_t>(len - total, 0x40000000));
+        DWORD bytes{};
+        BOOL ok = ReadFile(file->file, dst + total, chunk, nullptr, &overlapped);
+        if (!ok && GetLastError() == ERROR_IO_PENDING)
+        {
+            ok = GetOverlappedResult(file->file, &overlapped, &bytes, TRUE);
+        }
+        else if (ok)
+        {
+            GetOverlappedResult(file->file, &overlapped, &bytes, FALSE);
+        }
+        auto error = ok ? ERROR_SUCCESS : GetLastError();
+        CloseHandle(event);
+        if (!ok)
+        {
+            if (error != ERROR_HANDLE_EOF) result = kResultIOError;
+            break;
+        }
+        if (bytes == 0) break;
+        total += bytes;
+#else
+        auto bytes = pread(file->fd, dst + total, len - total, off_t(offset + total));
+        if (bytes < 0)
+        {
+            if (errno == EINTR) continue;
+            result = kResultIOError;
+            break;
+        }
+        if (bytes == 0) break;
+        total += size_t(bytes);
+#endif
+    }
+    return total;
+}
+
+static size_t async_read(void* user_data, void* handle, void* ptr, size_t len)
+{
+    (void)user_data;
+    auto file = static_cast<AsyncFile*>(handle);
+
+    Result result{};
+    auto bytes = async_readAt(file, file->position, ptr, len, result);
+    file->position += bytes;
+    file->lastError = result != kResultOk ? result : (bytes < len ? kResultEndOfFile : kResultOk);
+    return bytes;
+}
+
+static Result async_readAsync(void* user_data, void* handle, size_t offset, size_t len, void* dst, FileIOReadCompletion completion, void* completionContext)
+{
+    (void)user_data;
+    if (!handle || !dst || !completion)
+    {
+        return kResultInvalidParameter;
+    }
+    auto file = static_cast<AsyncFile*>(handle);
+#ifdef NVIGI_WINDOWS
+    if (len > MAXDWORD)
+    {
+        // Single overlapped read is limited to 4GB, callers stream in chunks anyway
+        file->lastError = kResultInvalidParameter;
+        return kResultInvalidParameter;
+    }
+#endif
+
+    auto request = new (std::nothrow) AsyncFileRequest();
+    if (!request)
+    {
+        file->lastError = kResultInsufficientResources;
+        return kResultInsufficientResources;
+    }
+    request->completion = completion;
+    request->completionContext = completionContext;
+
+    {
+        std::unique_lock lock(file->mtx);
+        file->cv.wait(lock, [file]() { return file->inFlight < file->queueDepth; });
+        file->inFlight++;
+#ifndef NVIGI_WINDOWS
+        if (!file->workers)
+        {
+            file->workers = std::make_unique<thread::WorkerPool>(L"nvigi.io", 0, file->queueDepth);
+        }
+#endif
+    }
+
+#ifdef NVIGI_WINDOWS
+    request->overlapped.Offset = DWORD(offset & 0xffffffff);
+    request->overlapped.OffsetHigh = DWORD(uint64_t(offset) >> 32);
+    if (!ReadFile(file->file, dst, DWORD(len), nullptr, &request->overlapped))
+    {
+        auto error = GetLastError();
+        if (error == ERROR_HANDLE_EOF)
+        {
+            // Nothing queued to the port, complete inline
+            async_complete(file, request, kResultOk, 0);
+            return kResultOk;
+        }
+        if (error != ERROR_IO_PENDING)
+        {
+            NVIGI_LOG_ERROR("Failed to issue read on '%s' - error %u", file->identifier.c_str(), error);
+            delete request;
+            {
+                std::scoped_lock lock(file->mtx);
+                file->inFlight--;
+            }
+            file->cv.notify_all();
+            file->lastError = kResultIOError;
+            return kResultIOError;
+        }
+    }
+    // Synchronous success is still reported through the completion port
+#else
+    file->workers->scheduleWork([file, request, offset, len, dst]()->void
+    {
+        Result result{};
+        auto bytes = async_readAt(file, offset, dst, len, result);
+        async_complete(file, request, result, bytes);
+    });
+#endif
+    file->lastError = kResultOk;
+    return kResultOk;
+}
+
+static Result async_waitAsync(void* user_data, void* handle)
+{
+    (void)user_data;
+    if (!handle) return kResultInvalidParameter;
+    auto file = static_cast<AsyncFile*>(handle);
+    std::unique_lock lock(file->mtx);
+    file->cv.wait(lock, [file]() { return file->inFlight == 0; });
+    auto result = file->asyncError;
+    file->asyncError = kResultOk;
+    return result;
+}
+
+static Result async_getLastError(void* user_data, void* handle)
+{
+    (void)user_data;
+    if (handle)
+    {
+        return static_cast<AsyncFile*>(handle)->lastError;
+    }
+    return g_asyncIOLastError;
+}
+
+//! Returns asynchronous file IO callbacks, options (if provided) must outlive all opened handles
+inline FileIOCallbacks getAsyncFileIOCallbacks(const AsyncFileIOOptions* options = nullptr)
+{
+    return FileIOCallbacks(const_cast<AsyncFileIOOptions*>(options), async_open, async_close, async_size, async_tell, async_seek,
+        async_read, nullptr, nullptr, nullptr, async_getLastError, async_readAsync, async_waitAsync);
+}
+
+//! Double buffered streaming from FileIOCallbacks to device memory
+//!
+//! Chunk N+1 is read from disk while chunk N is copied to the device. Staging buffers should be pinned/upload heap
+//! memory for the device copy to be truly asynchronous, if not provided they are allocated on the heap.
+//!
+//! 'copy' must enqueue the device copy of 'len' bytes from 'src' to 'dstOffset', 'wait' must block until the copy
+//! previously enqueued from staging buffer 'buffer' has finished, for example:
+//!
+//! CudaData: cudaMemcpyAsync(dst + dstOffset, src, len, cudaMemcpyHostToDevice, cuda.stream) + cudaEventRecord(events[buffer])
+//!           and cudaEventSynchronize(events[buffer])
+//! D3D12Data: CopyBufferRegion from the upload heap backing 'src' + queue->Signal(fence, ++values[buffer])
+//!            and fence->SetEventOnCompletion(values[buffer], nullptr)
+struct StagedUploadDesc
+{
+    size_t chunkSize = 8 * 1024 * 1024;
+    //! Optional, each must hold at least 'chunkSize' bytes
+    uint8_t* stagingBuffers[2]{};
+    std::function<Result(uint32_t buffer, const uint8_t* src, size_t dstOffset, size_t len)> copy;
+    std::function<Result(uint32_t buffer)> wait;
+};
+
+namespace detail
+{
+struct StagedRead
+{
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool done = true;
+    Result result = kResultOk;
+    size_t bytes{};
+
+    static void onComplete(void* context, Result result, size_t bytesRead)
+    {
+        auto read = static_cast<StagedRead*>(context);
+        {
+            std::scoped_lock lock(read->mtx);
+            read->result = result;
+            read->bytes = bytesRead;
+            read->done = true;
+        }
+        read->cv.notify_all();
+    }
+
+    Result waitFor(size_t expected)
+    {
+        std::unique_lock lock(mtx);
+        cv.wait(lock, [this]() { return done; });
+        if (result == kResultOk && bytes != expected) return kResultEndOfFile;
+        return result;
+    }
+};
+}
+
+//! Streams 'size' bytes starting at 'offset' from an opened handle through the staging buffers
+//!
+//! Uses 'readAsync' when available (struct v2+) otherwise falls back to 'seek' + 'read' which still overlaps
+//! the disk read with the device copy of the previous chunk.
+inline Result stagedUpload(const FileIOCallbacks& io, void* handle, size_t offset, size_t size, const StagedUploadDesc& desc)
+{
+    if (!handle || !desc.copy || !desc.wait || desc.chunkSize == 0)
+    {
+        return kResultInvalidParameter;
+    }
+
+    std::unique_ptr<uint8_t[]> owned[2];
+    uint8_t* buffers[2]{};
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        buffers[i] = desc.stagingBuffers[i];
+        if (!buffers[i])
+        {
+            owned[i].reset(new (std::nothrow) uint8_t[desc.chunkSize]);
+            if (!owned[i]) return kResultInsufficientResources;
+            buffers[i] = owned[i].get();
+        }
+    }
+
+    const bool useAsync = io.getVersion() >= kStructVersion2 && io.readAsync && io.waitAsync;
+    detail::StagedRead reads[2];
+    bool copyPending[2]{};
+
+    auto issueRead = [&](uint32_t buffer, size_t at, size_t len)->Result
+    {
+        auto& read = reads[buffer];
+        if (useAsync)
+        {
+            read.done = false;
+            auto res = io.readAsync(io.userData, handle, offset + at, len, buffers[buffer], detail::StagedRead::onComplete, &read);
+            if (res != kResultOk) read.done = true;
+            return res;
+        }
+        if (io.seek(io.userData, handle, offset + at, SEEK_SET) != 0)
+        {
+            return io.getLastError ? io.getLastError(io.userData, handle) : kResultIOError;
+        }
+        read.bytes = io.read(io.userData, handle, buffers[buffer], len);
+        read.result = kResultOk;
+        return kResultOk;
+    };
+
+    Result result = kResultOk;
+    const size_t chunks = (size + desc.chunkSize - 1) / desc.chunkSize;
+    if (chunks > 0)
+    {
+        result = issueRead(0, 0, std::min(size, desc.chunkSize));
+    }
+    for (size_t i = 0; i < chunks && result == kResultOk; i++)
+    {
+        auto buffer = uint32_t(i & 1);
+        auto at = i * desc.chunkSize;
+        auto len = std::min(size - at, desc.chunkSize);
+        if ((result = reads[buffer].waitFor(len)) != kResultOk) break;
+        if ((result = desc.copy(buffer, buffers[buffer], at, len)) != kResultOk) break;
+        copyPending[buffer] = true;
+
+        if (i + 1 < chunks)
+        {
+            auto next = buffer ^ 1;
+            if (copyPending[next])
+            {
+                // Staging buffer can only be refilled once device is done reading from it
+                if ((result = desc.wait(next)) != kResultOk) break;
+                copyPending[next] = false;
+            }
+            auto nextAt = at + desc.chunkSize;
+            result = issueRead(next, nextAt, std::min(size - nextAt, desc.chunkSize));
+        }
+    }
+
+    // Never leave reads or copies targeting our staging buffers behind
+    if (useAsync)
+    {
+        for (auto& read : reads) read.waitFor(read.bytes);
+    }
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        if (copyPending[i])
+        {
+            auto res = desc.wait(i);
+            if (result == kResultOk) result = res;
+        }
+    }
+    return result;
+}
+
+} // namespace nvigi
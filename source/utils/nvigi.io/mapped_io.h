@@ -0,0 +1,547 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <string>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <cstring>
+#include <algorithm>
+#include <errno.h>
+#include <cstdio>
+
+#ifdef NVIGI_WINDOWS
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "nvigi_io.h"
+#include "source/core/nvigi.extra/extra.h"
+#include "source/core/nvigi.memory/memory.h"
+
+namespace nvigi
+{
+
+//! Memory mapped file IO callbacks
+//!
+//! Unlike the 'MemoryBuffer' example in io.h nothing is copied up front, the whole file is mapped read-only
+//! once on open and 'map' returns views straight into the OS page cache so multi-GB models are loaded zero-copy
+//! and never double the peak RAM. 'read' is serviced from the same mapping (memcpy, no syscalls).
+//!
+//! Views are reference counted, a handle closed while views are still alive keeps the mapping until the last 'unmap'.
+//!
+//! NOTE: Page cache backed file mappings cannot use large pages on Windows, on Linux 'largePages' requests
+//! transparent huge pages for the mapping (effective only where the kernel supports it for file mappings).
+//! On Windows 'memory::kMemoryFlagLargePages' in 'memoryFlags' therefore trades zero-copy for large pages, the file
+//! is read once into a private large page allocation (falls back to the mapping if large pages are not available).
+//!
+//! With 'shared' set every process opening the same model file maps the same physical pages: on Windows through a named
+//! read-only section keyed by file identity (volume, file id, size and last write time), on Linux through a shared
+//! read-only mapping of the page cache. Views can never be made writable (VirtualProtect/mprotect fail) so plugins
+//! cannot mutate weights other processes use, plugins needing writable weights must 'read' them into their own memory.
+//! Private copies (large pages) are never made for shared mappings. See 'SharedWeightsHolder' to keep them warm.
+//! On Windows an existing section is only used if it maps this very file, otherwise the file is mapped privately.
+
+struct MappedFileIOOptions
+{
+    //! Hint the OS to read ahead the mapped range on 'map' (PrefetchVirtualMemory/MADV_WILLNEED)
+    bool prefetch = true;
+    //! Access is mostly sequential (typical weight loading), enables aggressive read ahead
+    bool sequential = true;
+    //! See note above
+    bool largePages = false;
+    //! Placement of the weights in host memory, see 'memory::MemoryFlags' and the note above
+    memory::MemoryFlags memoryFlags = memory::kMemoryFlagNone;
+    //! Node used with 'memory::kMemoryFlagNumaPreferred'
+    uint32_t numaNode = 0;
+    //! Share read-only mappings across processes, see note above
+    bool shared = false;
+    //! Windows only - namespace of shared sections, "Global\\" shares across sessions (services) but needs SeCreateGlobalPrivilege
+    const char* sharedNamespace = "Local\\";
+};
+
+struct MappedFile
+{
+    uint8_t* base{};
+    size_t size{};
+    size_t position{};
+    std::string identifier;
+    Result lastError = kResultOk;
+    const MappedFileIOOptions* options{};
+    //! True if 'base' is a private copy from the memory manager rather than a file mapping
+    bool copied{};
+    //! Shared mapping, 'attached' if another process created it first
+    bool shared{};
+    bool attached{};
+#ifdef NVIGI_WINDOWS
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping{};
+#else
+    int fd = -1;
+#endif
+    // Open handle counts as one reference, each live view as another
+    std::atomic<uint32_t> refCount{ 1 };
+};
+
+// Thread-local storage for errors that occur before we have a handle (e.g., open failures)
+static thread_local Result g_mappedIOLastError = kResultOk;
+
+static void mapped_release(MappedFile* file)
+{
+    if (file->refCount.fetch_sub(1) != 1) return;
+    if (file->copied)
+    {
+        memory::getInterface()->deallocate(file->base);
+        file->base = nullptr;
+    }
+#ifdef NVIGI_WINDOWS
+    if (file->base) UnmapViewOfFile(file->base);
+    if (file->mapping) CloseHandle(file->mapping);
+    if (file->file != INVALID_HANDLE_VALUE) CloseHandle(file->file);
+#else
+    if (file->base) munmap(file->base, file->size);
+    if (file->fd >= 0) ::close(file->fd);
+#endif
+    delete file;
+}
+
+//! Identifies the file contents, replaced or modified files get a new identity so stale shared mappings are never reused
+static std::string mapped_fileIdentity(MappedFile* file)
+{
+#ifdef NVIGI_WINDOWS
+    FILE_ID_INFO id{};
+    FILETIME written{};
+    if (!GetFileInformationByHandleEx(file->file, FileIdInfo, &id, sizeof(id)) || !GetFileTime(file->file, nullptr, nullptr, &written)) return {};
+    std::string identity = extra::toHexStr(id.VolumeSerialNumber) + ".";
+    for (auto byte : id.FileId.Identifier) identity += extra::toHexStr(byte);
+    return identity + "." + extra::toHexStr(written.dwHighDateTime) + extra::toHexStr(written.dwLowDateTime) + "." + extra::toHexStr(uint64_t(file->size));
+#else
+    struct stat st {};
+    if (fstat(file->fd, &st) != 0) return {};
+    return extra::toHexStr(uint64_t(st.st_dev)) + "." + extra::toHexStr(uint64_t(st.st_ino)) + "." +
+        extra::toHexStr(uint64_t(st.st_mtim.tv_sec)) + extra::toHexStr(uint64_t(st.st_mtim.tv_nsec)) + "." + extra::toHexStr(uint64_t(st.st_size));
+#endif
+}
+
+#ifdef NVIGI_WINDOWS
+//! Any process in the namespace can create a section with our name, an attached one must be a view of this very file
+static bool mapped_verifyAttached(MappedFile* file)
+{
+    SYSTEM_INFO system{};
+    GetSystemInfo(&system);
+    const size_t page = system.dwPageSize;
+    MEMORY_BASIC_INFORMATION info{};
+    if (!VirtualQuery(file->base, &info, sizeof(info)) || info.Type != MEM_MAPPED || info.RegionSize != (file->size + page - 1) / page * page) return false;
+    // Both in NT device form, e.g. \Device\HarddiskVolume3\models\model.gguf
+    wchar_t mapped[MAX_PATH * 4]{};
+    wchar_t opened[MAX_PATH * 4]{};
+    DWORD mappedLength = GetMappedFileNameW(GetCurrentProcess(), file->base, mapped, ARRAYSIZE(mapped));
+    DWORD openedLength = GetFinalPathNameByHandleW(file->file, opened, ARRAYSIZE(opened), FILE_NAME_NORMALIZED | VOLUME_NAME_NT);
+    return mappedLength && openedLength && openedLength < ARRAYSIZE(opened) && _wcsicmp(mapped, opened) == 0;
+}
+#endif
+
+static void* mapped_open(void* user_data, const char* fname, const char* mode)
+{
+    static const MappedFileIOOptions s_defaultOptions{};
+    auto options = user_data ? static_cast<const MappedFileIOOptions*>(user_data) : &s_defaultOptions;
+
+    if (!fname || !mode || std::string(mode) != "rb")
+    {
+        NVIGI_LOG_ERROR("Memory mapped IO supports only 'rb' mode");
+        g_mappedIOLastError = kResultNoImplementation;
+        return nullptr;
+    }
+
+    auto file = new (std::nothrow) MappedFile();
+    if (!file)
+    {
+        g_mappedIOLastError = kResultInsufficientResources;
+        return nullptr;
+    }
+    file->identifier = fname;
+    file->options = options;
+
+#ifdef NVIGI_WINDOWS
+    auto path = extra::utf8ToUtf16(fname);
+    file->file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | (options->sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS), nullptr);
+    LARGE_INTEGER size{};
+    if (file->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file->file, &size))
+    {
+        NVIGI_LOG_ERROR("Failed to open '%s' - error %u", fname, GetLastError());
+        g_mappedIOLastError = kResultItemNotFound;
+        mapped_release(file);
+        return nullptr;
+    }
+    file->size = size_t(size.QuadPart);
+    file->shared = options->shared;
+    if (file->shared && (options->memoryFlags & memory::kMemoryFlagLargePages))
+    {
+        NVIGI_LOG_WARN("Large pages need a private copy, ignored for shared mapping of '%s'", fname);
+    }
+    if (file->size && !file->shared && (options->memoryFlags & memory::kMemoryFlagLargePages))
+    {
+        auto mm = memory::getInterface();
+        bool available = mm->getVersion() >= kStructVersion3 && (mm->getAvailableFlags() & memory::kMemoryFlagLargePages);
+        file->base = available ? static_cast<uint8_t*>(memory::allocateWithFlags(mm, file->size, options->memoryFlags | memory::kMemoryFlagUninitialized, options->numaNode)) : nullptr;
+        size_t offset = 0;
+        while (file->base && offset < file->size)
+        {
+            DWORD chunk = DWORD(std::min<size_t>(file->size - offset, 1u << 30));
+            DWORD bytesRead = 0;
+            if (!ReadFile(file->file, file->base + offset, chunk, &bytesRead, nullptr) || bytesRead == 0) break;
+            offset += bytesRead;
+        }
+        if (file->base && offset == file->size)
+        {
+            file->copied = true;
+            NVIGI_LOG_VERBOSE("Loaded '%s' into large pages", fname);
+        }
+        else
+        {
+            NVIGI_LOG_WARN("Large pages not available for '%s' (%s), using regular file mapping", fname, available ? "read failed" : "see memory manager diagnostics");
+            if (file->base) mm->deallocate(file->base);
+            file->base = nullptr;
+        }
+    }
+    if (file->size && !file->copied)
+    {
+        bool preferred = options->memoryFlags & memory::kMemoryFlagNumaPreferred;
+        if (file->shared)
+        {
+            auto identity = mapped_fileIdentity(file);
+            if (!identity.empty())
+            {
+                auto name = extra::utf8ToUtf16((std::string(options->sharedNamespace ? options->sharedNamespace : "") + "nvigi.weights." + identity).c_str());
+                file->mapping = OpenFileMappingW(FILE_MAP_READ, FALSE, name.c_str());
+                file->attached = file->mapping != nullptr;
+                if (!file->mapping)
+                {
+                    // Returns the existing section if another process created it in the meantime
+                    file->mapping = CreateFileMappingW(file->file, nullptr, PAGE_READONLY, 0, 0, name.c_str());
+                    file->attached = file->mapping && GetLastError() == ERROR_ALREADY_EXISTS;
+                }
+            }
+            if (!file->mapping)
+            {
+                NVIGI_LOG_WARN("Failed to create shared mapping for '%s' - error %u, mapping privately", fname, GetLastError());
+                file->shared = false;
+            }
+        }
+        if (!file->mapping) file->mapping = CreateFileMappingW(file->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        auto mapView = [file, options, preferred]() {
+            return file->mapping ? static_cast<uint8_t*>(MapViewOfFileExNuma(file->mapping, FILE_MAP_READ, 0, 0, 0, nullptr, preferred ? options->numaNode : NUMA_NO_PREFERRED_NODE)) : nullptr;
+        };
+        file->base = mapView();
+        if (file->base && file->attached && !mapped_verifyAttached(file))
+        {
+            NVIGI_LOG_WARN("Shared mapping for '%s' does not map this file, mapping privately", fname);
+            UnmapViewOfFile(file->base);
+            CloseHandle(file->mapping);
+            file->shared = file->attached = false;
+            file->mapping = CreateFileMappingW(file->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            file->base = mapView();
+        }
+        if (!file->base)
+        {
+            NVIGI_LOG_ERROR("Failed to map '%s' - error %u", fname, GetLastError());
+            g_mappedIOLastError = kResultIOError;
+            mapped_release(file);
+            return nullptr;
+        }
+    }
+#else
+    file->fd = ::open(fname, O_RDONLY | O_CLOEXEC);
+    struct stat st {};
+    if (file->fd < 0 || fstat(file->fd, &st) != 0)
+    {
+        NVIGI_LOG_ERROR("Failed to open '%s' - errno %d", fname, errno);
+        g_mappedIOLastError = kResultItemNotFound;
+        mapped_release(file);
+        return nullptr;
+    }
+    file->size = size_t(st.st_size);
+    file->shared = options->shared;
+    if (file->size)
+    {
+        // Page cache is shared by inode, MAP_SHARED on a read-only descriptor also makes the view impossible to mprotect writable
+        void* base = mmap(nullptr, file->size, PROT_READ, file->shared ? MAP_SHARED : MAP_PRIVATE, file->fd, 0);
+        if (base == MAP_FAILED)
+        {
+            NVIGI_LOG_ERROR("Failed to map '%s' - errno %d", fname, errno);
+            g_mappedIOLastError = kResultIOError;
+            mapped_release(file);
+            return nullptr;
+        }
+        file->base = static_cast<uint8_t*>(base);
+        madvise(file->base, file->size, options->sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+#ifdef MADV_HUGEPAGE
+        if (!file->shared && (options->largePages || (options->memoryFlags & memory::kMemoryFlagLargePages))) madvise(file->base, file->size, MADV_HUGEPAGE);
+#endif
+    }
+#endif
+
+    NVIGI_LOG_VERBOSE("Mapped '%s' (%zu bytes%s)", fname, file->size, file->attached ? ", attached to shared mapping" : file->shared ? ", shared" : "");
+    g_mappedIOLastError = kResultOk;
+    return file;
+}
+
+static void mapped_close(void* user_data, void* handle)
+{
+    (void)user_data;
+    if (!handle) return;
+    auto file = static_cast<MappedFile*>(handle);
+    if (file->refCount.load() > 1)
+    {
+        NVIGI_LOG_VERBOSE("Closing '%s' with %u view(s) still mapped, releasing once unmapped", file->identifier.c_str(), file->refCount.load() - 1);
+    }
+    mapped_release(file);
+}
+
+static size_t mapped_size(void* user_data, void* handle)
+{
+    (void)user_data;
+    return static_cast<MappedFile*>(handle)->size;
+}
+
+static size_t mapped_tell(void* user_data, void* handle)
+{
+    (void)user_data;
+    return static_cast<MappedFile*>(handle)->position;
+}
+
+static int mapped_seek(void* user_data, void* handle, size_t offset, int whence)
+{
+    (void)user_data;
+    auto file = static_cast<MappedFile*>(handle);
+
+    size_t new_position = 0;
+    switch (whence)
+    {
+    case SEEK_SET:
+        new_position = offset;
+        break;
+    case SEEK_CUR:
+        new_position = file->position + offset;
+        break;
+    case SEEK_END:
+        new_position = file->size + offset;
+        break;
+    default:
+        file->lastError = kResultInvalidParameter;
+        return EINVAL;
+    }
+
+    if (new_position > file->size)
+    {
+        file->lastError = kResultOutOfRange;
+        return EOVERFLOW;
+    }
+
+    file->position = new_position;
+    file->lastError = kResultOk;
+    return 0;
+}
+
+static size_t mapped_read(void* user_data, void* handle, void* ptr, size_t len)
+{
+    (void)user_data;
+    auto file = static_cast<MappedFile*>(handle);
+
+    size_t bytes_to_read = std::min(len, file->size - file->position);
+    if (bytes_to_read > 0)
+    {
+        std::memcpy(ptr, file->base + file->position, bytes_to_read);
+        file->position += bytes_to_read;
+        file->lastError = kResultOk;
+    }
+    else
+    {
+        file->lastError = len > 0 ? kResultEndOfFile : kResultOk;
+    }
+    return bytes_to_read;
+}
+
+static uint8_t* mapped_map(void* user_data, void* handle, size_t offset, size_t size, MapAccess access)
+{
+    (void)user_data;
+    if (!handle)
+    {
+        g_mappedIOLastError = kResultInvalidParameter;
+        return nullptr;
+    }
+    auto file = static_cast<MappedFile*>(handle);
+    if (access != MapAccess::eReadOnly)
+    {
+        file->lastError = kResultNoImplementation;
+        return nullptr;
+    }
+    if (offset > file->size || size > file->size - offset)
+    {
+        file->lastError = kResultOutOfRange;
+        return nullptr;
+    }
+
+    auto view = file->base + offset;
+    if (file->options->prefetch && size)
+    {
+#ifdef NVIGI_WINDOWS
+        WIN32_MEMORY_RANGE_ENTRY range{ view, size };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+        // madvise requires page aligned address
+        auto pageSize = size_t(sysconf(_SC_PAGESIZE));
+        auto aligned = reinterpret_cast<uint8_t*>(reinterpret_cast<uintptr_t>(view) & ~(uintptr_t(pageSize) - 1));
+        madvise(aligned, size + size_t(view - aligned), MADV_WILLNEED);
+#endif
+    }
+    file->refCount.fetch_add(1);
+    file->lastError = kResultOk;
+    return view;
+}
+
+static void mapped_unmap(void* user_data, void* handle, uint8_t* mappedPtr)
+{
+    (void)user_data;
+    if (!handle || !mappedPtr) return;
+    auto file = static_cast<MappedFile*>(handle);
+    file->lastError = kResultOk;
+    mapped_release(file);
+}
+
+static Result mapped_getLastError(void* user_data, void* handle)
+{
+    (void)user_data;
+    if (handle)
+    {
+        return static_cast<MappedFile*>(handle)->lastError;
+    }
+    return g_mappedIOLastError;
+}
+
+//! Returns memory mapped file IO callbacks, options (if provided) must outlive all opened handles
+inline FileIOCallbacks getMappedFileIOCallbacks(const MappedFileIOOptions* options = nullptr)
+{
+    return FileIOCallbacks(const_cast<MappedFileIOOptions*>(options), mapped_open, mapped_close, mapped_size, mapped_tell, mapped_seek,
+        mapped_read, nullptr, mapped_map, mapped_unmap, mapped_getLastError);
+}
+
+//! Keeps shared model mappings alive and resident between game server processes
+//!
+//! Meant for a small daemon started before the servers (or the first server to start), it holds the shared mapping of
+//! each model so the pages stay in memory while no server has the model loaded, and reads every page up front so the
+//! first server to load a model does not pay for the disk reads.
+//!
+//! NOTE: Locked pages count against the process working set quota (Windows) or RLIMIT_MEMLOCK (Linux), locking is best effort
+class SharedWeightsHolder
+{
+public:
+    SharedWeightsHolder(const MappedFileIOOptions& options = {}) : m_options(options)
+    {
+        m_options.shared = true;
+        m_io = getMappedFileIOCallbacks(&m_options);
+    }
+    SharedWeightsHolder(const SharedWeightsHolder&) = delete;
+    SharedWeightsHolder& operator=(const SharedWeightsHolder&) = delete;
+
+    ~SharedWeightsHolder()
+    {
+        std::scoped_lock lock(m_mtx);
+        for (auto& [path, held] : m_held) drop(held);
+    }
+
+    Result hold(const char* path, bool lockPages = false)
+    {
+        if (!path) return kResultInvalidParameter;
+        std::scoped_lock lock(m_mtx);
+        if (m_held.count(path)) return kResultOk;
+        Held held{};
+        held.handle = m_io.open(m_io.userData, path, "rb");
+        if (!held.handle) return m_io.getLastError(m_io.userData, nullptr);
+        auto size = m_io.size(m_io.userData, held.handle);
+        held.view = size ? m_io.map(m_io.userData, held.handle, 0, size, MapAccess::eReadOnly) : nullptr;
+        if (size && !held.view)
+        {
+            auto res = m_io.getLastError(m_io.userData, held.handle);
+            m_io.close(m_io.userData, held.handle);
+            return res;
+        }
+        held.size = size;
+        // Fault every page in, prefetch is only a hint
+#ifdef NVIGI_WINDOWS
+        SYSTEM_INFO info{};
+        GetSystemInfo(&info);
+        size_t pageSize = info.dwPageSize;
+#else
+        size_t pageSize = size_t(sysconf(_SC_PAGESIZE));
+#endif
+        volatile uint8_t sink = 0;
+        for (size_t offset = 0; offset < size; offset += pageSize) sink = sink + held.view[offset];
+        (void)sink;
+        if (lockPages && size)
+        {
+#ifdef NVIGI_WINDOWS
+            SIZE_T minimum{}, maximum{};
+            GetProcessWorkingSetSize(GetCurrentProcess(), &minimum, &maximum);
+            SetProcessWorkingSetSize(GetCurrentProcess(), minimum + size, maximum + size);
+            held.locked = VirtualLock(held.view, size) != FALSE;
+#else
+            held.locked = mlock(held.view, size) == 0;
+#endif
+            if (!held.locked) NVIGI_LOG_WARN("Failed to lock shared weights '%s' in memory, pages can still be evicted", path);
+        }
+        NVIGI_LOG_INFO("Holding shared weights '%s' (%zu bytes%s)", path, size, held.locked ? ", locked" : "");
+        m_held[path] = held;
+        return kResultOk;
+    }
+
+    Result release(const char* path)
+    {
+        if (!path) return kResultInvalidParameter;
+        std::scoped_lock lock(m_mtx);
+        auto it = m_held.find(path);
+        if (it == m_held.end()) return kResultItemNotFound;
+        drop(it->second);
+        m_held.erase(it);
+        return kResultOk;
+    }
+
+private:
+    struct Held
+    {
+        void* handle{};
+        uint8_t* view{};
+        size_t size{};
+        bool locked{};
+    };
+
+    void drop(Held& held)
+    {
+        if (held.locked)
+        {
+#ifdef NVIGI_WINDOWS
+            VirtualUnlock(held.view, held.size);
+#else
+            munlock(held.view, held.size);
+#endif
+        }
+        if (held.view) m_io.unmap(m_io.userData, held.handle, held.view);
+        m_io.close(m_io.userData, held.handle);
+    }
+
+    MappedFileIOOptions m_options{};
+    FileIOCallbacks m_io{};
+    std::mutex m_mtx;
+    std::map<std::string, Held> m_held;
+};
+
+} // namespace nvigi
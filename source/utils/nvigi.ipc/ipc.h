@@ -0,0 +1,774 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef NVIGI_WINDOWS
+#include <windows.h>
+#else
+#include <climits>
+#include <ctime>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+extern char** environ;
+#endif
+
+#include "source/core/nvigi.log/log.h"
+#include "source/core/nvigi.extra/extra.h"
+
+namespace nvigi
+{
+namespace ipc
+{
+
+//! Shared memory transport between processes on the same machine
+//!
+//! Building blocks only, see 'RemoteInferenceClient' and 'RemoteInferenceServer' in ai_remote.h for the actual protocol.
+//!
+//! * 'SharedMemory' - named mapping, "Local\nvigi.<name>" on Windows and "/nvigi.<name>" on Linux
+//! * 'Doorbell' - sequence word in shared memory, waits on a named auto-reset event (Windows) or a futex (Linux)
+//! * 'MessageRing' - single producer, single consumer ring of variable length control messages
+//! * 'PayloadArena' - bulk data written once by the producer and read in place by the consumer, released out of order
+//! * 'Channel' - one connection, a ring and an arena in each direction
+//! * 'ServiceEndpoint' - well known mapping used by any number of processes to hand their channels to the host
+//!
+//! NOTE: Names must not contain '/' or '\'
+
+constexpr uint32_t kChannelMagic = 0x4e414843; // "CHAN"
+constexpr uint32_t kServiceMagic = 0x56524553; // "SERV"
+constexpr uint32_t kProtocolVersion = 1;
+constexpr uint32_t kMaxServiceClients = 64;
+constexpr uint64_t kInvalidOffset = UINT64_MAX;
+
+inline uint32_t getProcessId()
+{
+#ifdef NVIGI_WINDOWS
+    return (uint32_t)GetCurrentProcessId();
+#else
+    return (uint32_t)getpid();
+#endif
+}
+
+inline bool isProcessAlive(uint32_t pid)
+{
+    if (!pid) return false;
+#ifdef NVIGI_WINDOWS
+    HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, pid);
+    if (!process) return GetLastError() == ERROR_ACCESS_DENIED;
+    bool alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return alive;
+#else
+    return kill((pid_t)pid, 0) == 0 || errno == EPERM;
+#endif
+}
+
+//! Starts a detached process, arguments are passed as is (no shell)
+inline Result launchProcess(const char* utf8Path, const std::vector<std::string>& args, uint32_t* pid = nullptr)
+{
+    if (!utf8Path || !*utf8Path) return kResultInvalidParameter;
+#ifdef NVIGI_WINDOWS
+    std::wstring cmdLine = L"\"" + extra::utf8ToUtf16(utf8Path) + L"\"";
+    for (auto& arg : args) cmdLine += L" \"" + extra::utf8ToUtf16(arg.c_str()) + L"\"";
+    STARTUPINFOW si{};
+    si.cb = sizeof(si);
+    PROCESS_INFORMATION pi{};
+    if (!CreateProcessW(nullptr, cmdLine.data(), nullptr, nullptr, FALSE, CREATE_NO_WINDOW, nullptr, nullptr, &si, &pi))
+    {
+        NVIGI_LOG_ERROR("Failed to launch '%s' - error %u", utf8Path, GetLastError());
+        return kResultItemNotFound;
+    }
+    if (pid) *pid = pi.dwProcessId;
+    CloseHandle(pi.hThread);
+    CloseHandle(pi.hProcess);
+#else
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(utf8Path));
+    for (auto& arg : args) argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(nullptr);
+    pid_t child{};
+    int err = posix_spawn(&child, utf8Path, nullptr, nullptr, argv.data(), environ);
+    if (err != 0)
+    {
+        NVIGI_LOG_ERROR("Failed to launch '%s' - error %d", utf8Path, err);
+        return kResultItemNotFound;
+    }
+    if (pid) *pid = (uint32_t)child;
+#endif
+    return kResultOk;
+}
+
+//! Named shared memory mapping, removed once the creator and all other users close it
+//!
+//! NOTE: On Linux a crashed creator leaves the name behind, 'create' with 'replace' set removes such leftovers
+class SharedMemory
+{
+public:
+    SharedMemory() {};
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+    ~SharedMemory() { close(); }
+
+    //! Fails with kResultAlreadyExists if the name is taken, zero initialized
+    Result create(const char* name, size_t size, bool replace = false)
+    {
+        close();
+        if (!name || !*name || !size) return kResultInvalidParameter;
+#ifdef NVIGI_WINDOWS
+        auto wname = extra::utf8ToUtf16(("Local\\nvigi." + std::string(name)).c_str());
+        m_mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, DWORD(uint64_t(size) >> 32), DWORD(size), wname.c_str());
+        if (!m_mapping) return kResultInsufficientResources;
+        if (GetLastError() == ERROR_ALREADY_EXISTS && !replace)
+        {
+            close();
+            return kResultAlreadyExists;
+        }
+        m_base = (uint8_t*)MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+#else
+        m_name = "/nvigi." + std::string(name);
+        int fd = shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0 && errno == EEXIST && replace)
+        {
+            shm_unlink(m_name.c_str());
+            fd = shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        }
+        if (fd < 0)
+        {
+            auto err = errno;
+            m_name.clear();
+            return err == EEXIST ? kResultAlreadyExists : kResultInsufficientResources;
+        }
+        m_owner = true;
+        if (ftruncate(fd, (off_t)size) == 0)
+        {
+            auto base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            m_base = base == MAP_FAILED ? nullptr : (uint8_t*)base;
+        }
+        ::close(fd);
+#endif
+        if (!m_base)
+        {
+            NVIGI_LOG_ERROR("Failed to map %llu bytes of shared memory '%s'", (unsigned long long)size, name);
+            close();
+            return kResultInsufficientResources;
+        }
+        m_size = size;
+        return kResultOk;
+    }
+
+    Result open(const char* name)
+    {
+        close();
+        if (!name || !*name) return kResultInvalidParameter;
+#ifdef NVIGI_WINDOWS
+        auto wname = extra::utf8ToUtf16(("Local\\nvigi." + std::string(name)).c_str());
+        m_mapping = OpenFileMappingW(FILE_MAP_ALL_ACCESS, FALSE, wname.c_str());
+        if (!m_mapping) return kResultItemNotFound;
+        m_base = (uint8_t*)MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+        MEMORY_BASIC_INFORMATION info{};
+        if (m_base && VirtualQuery(m_base, &info, sizeof(info))) m_size = info.RegionSize;
+#else
+        int fd = shm_open(("/nvigi." + std::string(name)).c_str(), O_RDWR, 0600);
+        if (fd < 0) return kResultItemNotFound;
+        struct stat st{};
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            auto base = mmap(nullptr, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            m_base = base == MAP_FAILED ? nullptr : (uint8_t*)base;
+            m_size = (size_t)st.st_size;
+        }
+        ::close(fd);
+#endif
+        if (!m_base)
+        {
+            close();
+            return kResultInvalidState;
+        }
+        return kResultOk;
+    }
+
+    void close()
+    {
+#ifdef NVIGI_WINDOWS
+        if (m_base) UnmapViewOfFile(m_base);
+        if (m_mapping) CloseHandle(m_mapping);
+        m_mapping = {};
+#else
+        if (m_base) munmap(m_base, m_size);
+        // Existing mappings stay valid, the name is gone so nobody new can attach
+        if (m_owner) shm_unlink(m_name.c_str());
+        m_owner = false;
+        m_name.clear();
+#endif
+        m_base = nullptr;
+        m_size = 0;
+    }
+
+    uint8_t* data() const { return m_base; }
+    size_t size() const { return m_size; }
+
+private:
+    uint8_t* m_base{};
+    size_t m_size{};
+#ifdef NVIGI_WINDOWS
+    HANDLE m_mapping{};
+#else
+    std::string m_name;
+    bool m_owner{};
+#endif
+};
+
+//! Wakes the other process, sequence word lives in shared memory so a wake between 'load' and 'wait' is never lost
+class Doorbell
+{
+public:
+    Doorbell() {};
+    Doorbell(const Doorbell&) = delete;
+    Doorbell& operator=(const Doorbell&) = delete;
+    ~Doorbell() { reset(); }
+
+    Result init(std::atomic<uint32_t>* word, const char* name)
+    {
+        reset();
+        if (!word || !name) return kResultInvalidParameter;
+        m_word = word;
+#ifdef NVIGI_WINDOWS
+        auto wname = extra::utf8ToUtf16(("Local\\nvigi." + std::string(name)).c_str());
+        m_event = CreateEventW(nullptr, FALSE, FALSE, wname.c_str());
+        if (!m_event) return kResultInsufficientResources;
+#endif
+        return kResultOk;
+    }
+
+    void reset()
+    {
+#ifdef NVIGI_WINDOWS
+        if (m_event) CloseHandle(m_event);
+        m_event = {};
+#endif
+        m_word = nullptr;
+    }
+
+    uint32_t load() const { return m_word->load(std::memory_order_acquire); }
+
+    void ring()
+    {
+        m_word->fetch_add(1, std::memory_order_acq_rel);
+#ifdef NVIGI_WINDOWS
+        SetEvent(m_event);
+#else
+        syscall(SYS_futex, (uint32_t*)m_word, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+    }
+
+    //! Returns once the word differs from 'seen' or after the timeout, spins briefly first since replies usually follow quickly
+    void wait(uint32_t seen, uint32_t timeoutMs)
+    {
+        for (uint32_t i = 0; i < kSpinCount; i++)
+        {
+            if (load() != seen) return;
+            std::this_thread::yield();
+        }
+#ifdef NVIGI_WINDOWS
+        if (load() != seen) return;
+        WaitForSingleObject(m_event, timeoutMs);
+#else
+        timespec ts{ time_t(timeoutMs / 1000), long(timeoutMs % 1000) * 1000000 };
+        syscall(SYS_futex, (uint32_t*)m_word, FUTEX_WAIT, seen, &ts, nullptr, 0);
+#endif
+    }
+
+private:
+    static constexpr uint32_t kSpinCount = 64;
+
+    std::atomic<uint32_t>* m_word{};
+#ifdef NVIGI_WINDOWS
+    HANDLE m_event{};
+#endif
+};
+
+static_assert(sizeof(std::atomic<uint32_t>) == 4 && std::atomic<uint32_t>::is_always_lock_free, "Shared memory atomics must be address free");
+static_assert(sizeof(std::atomic<uint64_t>) == 8 && std::atomic<uint64_t>::is_always_lock_free, "Shared memory atomics must be address free");
+
+//! Positions only grow, offset in the ring is position modulo capacity
+struct RingHeader
+{
+    alignas(64) std::atomic<uint64_t> head;
+    alignas(64) std::atomic<uint64_t> tail;
+};
+
+//! Variable length messages, 8 byte size prefix and 8 byte aligned, a message never wraps around the end
+//!
+//! Writes are serialized within the producing process, there must be only one reading thread.
+class MessageRing
+{
+public:
+    void attach(RingHeader* header, uint8_t* data, size_t capacity)
+    {
+        m_header = header;
+        m_data = data;
+        m_capacity = capacity;
+    }
+
+    size_t getMaxMessageSize() const { return m_capacity / 2 - kPrefix; }
+
+    bool tryWrite(const void* data, size_t size)
+    {
+        std::scoped_lock lock(m_mtx);
+        auto record = align(kPrefix + size);
+        if (record > m_capacity / 2) return false;
+        auto head = m_header->head.load(std::memory_order_relaxed);
+        auto tail = m_header->tail.load(std::memory_order_acquire);
+        auto offset = head % m_capacity;
+        auto skip = offset + record > m_capacity ? m_capacity - offset : 0;
+        if (m_capacity - (head - tail) < skip + record) return false;
+        if (skip)
+        {
+            *(uint64_t*)(m_data + offset) = kWrapMarker;
+            head += skip;
+            offset = 0;
+        }
+        *(uint64_t*)(m_data + offset) = size;
+        memcpy(m_data + offset + kPrefix, data, size);
+        m_header->head.store(head + record, std::memory_order_release);
+        return true;
+    }
+
+    bool tryRead(std::vector<uint8_t>& out)
+    {
+        auto tail = m_header->tail.load(std::memory_order_relaxed);
+        auto head = m_header->head.load(std::memory_order_acquire);
+        if (tail == head) return false;
+        auto offset = tail % m_capacity;
+        auto size = *(const uint64_t*)(m_data + offset);
+        if (size == kWrapMarker)
+        {
+            tail += m_capacity - offset;
+            offset = 0;
+            size = *(const uint64_t*)m_data;
+        }
+        if (size > getMaxMessageSize())
+        {
+            // Corrupted by the other process, drop everything
+            m_header->tail.store(head, std::memory_order_release);
+            return false;
+        }
+        out.assign(m_data + offset + kPrefix, m_data + offset + kPrefix + size);
+        m_header->tail.store(tail + align(kPrefix + size), std::memory_order_release);
+        return true;
+    }
+
+private:
+    static constexpr size_t kPrefix = 8;
+    static constexpr uint64_t kWrapMarker = UINT64_MAX;
+    static size_t align(size_t size) { return (size + 7) & ~size_t(7); }
+
+    std::mutex m_mtx;
+    RingHeader* m_header{};
+    uint8_t* m_data{};
+    size_t m_capacity{};
+};
+
+//! Only the producer moves these, consumer just flips block states
+struct ArenaHeader
+{
+    alignas(64) uint64_t head;
+    uint64_t tail;
+};
+
+//! Bulk payloads (slot data), written once by the producer and read in place by the consumer
+//!
+//! Blocks are allocated in order and reclaimed in order once the consumer released them, releases can happen in any order.
+//! A block which is never released stalls the producer once the arena wraps around to it.
+class PayloadArena
+{
+public:
+    void attach(ArenaHeader* header, uint8_t* data, size_t capacity)
+    {
+        m_header = header;
+        m_data = data;
+        m_capacity = capacity;
+    }
+
+    //! False if 'size' does not fit even into an empty arena
+    bool fits(size_t size) const { return size <= m_capacity && align(sizeof(Block) + size) <= m_capacity; }
+
+    //! Producer, returns 'kInvalidOffset' if there is not enough space right now
+    uint64_t tryAllocate(size_t size, uint8_t** ptr)
+    {
+        std::scoped_lock lock(m_mtx);
+        if (!fits(size)) return kInvalidOffset;
+        auto block = align(sizeof(Block) + size);
+        auto tail = m_header->tail;
+        while (tail < m_header->head)
+        {
+            auto b = (Block*)(m_data + tail % m_capacity);
+            if (b->state.load(std::memory_order_acquire) != kFree) break;
+            tail += b->size;
+        }
+        m_header->tail = tail;
+        auto head = m_header->head;
+        auto offset = head % m_capacity;
+        auto skip = offset + block > m_capacity ? m_capacity - offset : 0;
+        if (m_capacity - (head - tail) < skip + block) return kInvalidOffset;
+        if (skip)
+        {
+            auto padding = (Block*)(m_data + offset);
+            padding->size = skip;
+            padding->state.store(kFree, std::memory_order_relaxed);
+            head += skip;
+            offset = 0;
+        }
+        auto b = (Block*)(m_data + offset);
+        b->size = block;
+        b->state.store(kUsed, std::memory_order_relaxed);
+        m_header->head = head + block;
+        *ptr = m_data + offset + sizeof(Block);
+        return offset + sizeof(Block);
+    }
+
+    //! Producer, gives back a block which was never sent
+    void discard(uint64_t offset) { release(offset); }
+
+    //! Consumer, null if the range is not inside the arena
+    const uint8_t* resolve(uint64_t offset, size_t size) const
+    {
+        if (offset < sizeof(Block) || offset > m_capacity || size > m_capacity - offset) return nullptr;
+        return m_data + offset;
+    }
+
+    //! Consumer
+    void release(uint64_t offset)
+    {
+        if (offset < sizeof(Block) || offset > m_capacity) return;
+        ((Block*)(m_data + offset - sizeof(Block)))->state.store(kFree, std::memory_order_release);
+    }
+
+private:
+    static constexpr uint32_t kFree = 0;
+    static constexpr uint32_t kUsed = 1;
+    //! Cache line aligned payloads
+    static size_t align(size_t size) { return (size + 63) & ~size_t(63); }
+
+    struct Block
+    {
+        std::atomic<uint32_t> state;
+        uint32_t reserved;
+        uint64_t size;
+    };
+
+    std::mutex m_mtx;
+    ArenaHeader* m_header{};
+    uint8_t* m_data{};
+    size_t m_capacity{};
+};
+
+struct ChannelHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t clientPid;
+    //! Set by the host once it attached
+    std::atomic<uint32_t> hostPid;
+    //! Set by either side when leaving
+    std::atomic<uint32_t> closed;
+    std::atomic<uint32_t> toHostSignal;
+    std::atomic<uint32_t> toClientSignal;
+    uint64_t ringSize;
+    uint64_t arenaSize;
+    RingHeader toHostRing;
+    RingHeader toClientRing;
+    ArenaHeader toHostArena;
+    ArenaHeader toClientArena;
+};
+
+//! One client connection, created by the client and opened by the host
+//!
+//! Each side sends on its own ring and arena and receives on the other pair.
+class Channel
+{
+public:
+    Channel() {};
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    Result create(const char* name, size_t ringSize, size_t arenaSize)
+    {
+        ringSize = (ringSize + 63) & ~size_t(63);
+        arenaSize = (arenaSize + 63) & ~size_t(63);
+        auto headerSize = (sizeof(ChannelHeader) + 63) & ~size_t(63);
+        if (NVIGI_FAILED(result, m_memory.create(name, headerSize + 2 * ringSize + 2 * arenaSize, true))) return result;
+        auto header = (ChannelHeader*)m_memory.data();
+        header->version = kProtocolVersion;
+        header->clientPid = getProcessId();
+        header->ringSize = ringSize;
+        header->arenaSize = arenaSize;
+        std::atomic_thread_fence(std::memory_order_release);
+        header->magic = kChannelMagic;
+        return attach(name, false);
+    }
+
+    Result open(const char* name)
+    {
+        if (NVIGI_FAILED(result, m_memory.open(name))) return result;
+        auto header = (ChannelHeader*)m_memory.data();
+        auto headerSize = (sizeof(ChannelHeader) + 63) & ~size_t(63);
+        if (m_memory.size() < headerSize || header->magic != kChannelMagic || header->version != kProtocolVersion ||
+            m_memory.size() < headerSize + 2 * header->ringSize + 2 * header->arenaSize)
+        {
+            m_memory.close();
+            return kResultInvalidState;
+        }
+        if (NVIGI_FAILED(result, attach(name, true))) return result;
+        header->hostPid.store(getProcessId(), std::memory_order_release);
+        m_toPeer.ring();
+        return kResultOk;
+    }
+
+    void close()
+    {
+        if (!m_memory.data()) return;
+        getHeader()->closed.store(1, std::memory_order_release);
+        m_toPeer.ring();
+        m_toPeer.reset();
+        m_fromPeer.reset();
+        m_memory.close();
+    }
+
+    ChannelHeader* getHeader() const { return (ChannelHeader*)m_memory.data(); }
+    uint32_t getPeerPid() const { return m_isHost ? getHeader()->clientPid : getHeader()->hostPid.load(std::memory_order_acquire); }
+    bool isPeerAlive() const { return !getHeader()->closed.load(std::memory_order_acquire) && isProcessAlive(getPeerPid()); }
+    size_t getMaxMessageSize() const { return m_send.getMaxMessageSize(); }
+
+    //! Waits for room until the timeout expires or the peer goes away
+    Result send(const std::vector<uint8_t>& message, uint32_t timeoutMs)
+    {
+        if (message.size() > m_send.getMaxMessageSize()) return kResultInsufficientResources;
+        if (!waitFor([&]() { return m_send.tryWrite(message.data(), message.size()); }, timeoutMs)) return kResultTimedOut;
+        m_toPeer.ring();
+        return kResultOk;
+    }
+
+    //! False on timeout
+    bool receive(std::vector<uint8_t>& message, uint32_t timeoutMs)
+    {
+        auto seen = m_fromPeer.load();
+        if (m_receive.tryRead(message)) return true;
+        m_fromPeer.wait(seen, timeoutMs);
+        return m_receive.tryRead(message);
+    }
+
+    //! Space for a payload in the outgoing arena, see 'PayloadArena'
+    Result allocate(size_t size, uint8_t** ptr, uint64_t* offset, uint32_t timeoutMs)
+    {
+        // Waiting cannot help, same as 'send' with a message larger than the ring
+        if (!m_sendArena.fits(size)) return kResultInsufficientResources;
+        if (!waitFor([&]() { return (*offset = m_sendArena.tryAllocate(size, ptr)) != kInvalidOffset; }, timeoutMs))
+        {
+            return kResultTimedOut;
+        }
+        return kResultOk;
+    }
+    void discard(uint64_t offset) { m_sendArena.discard(offset); }
+
+    //! Payloads received from the peer
+    const uint8_t* resolve(uint64_t offset, size_t size) const { return m_receiveArena.resolve(offset, size); }
+    void release(uint64_t offset) { m_receiveArena.release(offset); }
+
+    //! Wakes the local receiving thread, for example when shutting down
+    void wakeReceiver() { m_fromPeer.ring(); }
+
+private:
+    Result attach(const char* name, bool host)
+    {
+        auto header = getHeader();
+        auto headerSize = (sizeof(ChannelHeader) + 63) & ~size_t(63);
+        auto toHostRing = m_memory.data() + headerSize;
+        auto toClientRing = toHostRing + header->ringSize;
+        auto toHostArena = toClientRing + header->ringSize;
+        auto toClientArena = toHostArena + header->arenaSize;
+        m_isHost = host;
+        m_send.attach(host ? &header->toClientRing : &header->toHostRing, host ? toClientRing : toHostRing, header->ringSize);
+        m_receive.attach(host ? &header->toHostRing : &header->toClientRing, host ? toHostRing : toClientRing, header->ringSize);
+        m_sendArena.attach(host ? &header->toClientArena : &header->toHostArena, host ? toClientArena : toHostArena, header->arenaSize);
+        m_receiveArena.attach(host ? &header->toHostArena : &header->toClientArena, host ? toHostArena : toClientArena, header->arenaSize);
+        auto toHost = std::string(name) + ".h";
+        auto toClient = std::string(name) + ".c";
+        auto result = m_toPeer.init(host ? &header->toClientSignal : &header->toHostSignal, host ? toClient.c_str() : toHost.c_str());
+        if (result == kResultOk) result = m_fromPeer.init(host ? &header->toHostSignal : &header->toClientSignal, host ? toHost.c_str() : toClient.c_str());
+        if (result != kResultOk) m_memory.close();
+        return result;
+    }
+
+    template<typename F>
+    bool waitFor(F&& tryOnce, uint32_t timeoutMs)
+    {
+        if (tryOnce()) return true;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        for (uint32_t attempt = 0; std::chrono::steady_clock::now() < deadline; attempt++)
+        {
+            // Consumer is busy, back off from yielding to sleeping
+            if (attempt < 64) std::this_thread::yield();
+            else std::this_thread::sleep_for(std::chrono::microseconds(200));
+            if (tryOnce()) return true;
+            if ((attempt & 1023) == 1023 && !isPeerAlive()) return false;
+        }
+        return false;
+    }
+
+    SharedMemory m_memory;
+    bool m_isHost{};
+    MessageRing m_send;
+    MessageRing m_receive;
+    PayloadArena m_sendArena;
+    PayloadArena m_receiveArena;
+    Doorbell m_toPeer;
+    Doorbell m_fromPeer;
+};
+
+struct ServiceSlot
+{
+    //! Free, claimed by a client, pending acceptance by the host
+    std::atomic<uint32_t> state;
+    uint32_t clientPid;
+    char channel[120];
+};
+
+struct ServiceHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    std::atomic<uint32_t> hostPid;
+    std::atomic<uint32_t> signal;
+    ServiceSlot slots[kMaxServiceClients];
+};
+
+//! Well known rendezvous point, clients post the name of the channel they created and the host opens it
+class ServiceEndpoint
+{
+public:
+    ServiceEndpoint() {};
+    ServiceEndpoint(const ServiceEndpoint&) = delete;
+    ServiceEndpoint& operator=(const ServiceEndpoint&) = delete;
+    ~ServiceEndpoint() { close(); }
+
+    //! Host side, fails with kResultAlreadyExists if another live host serves this name
+    Result listen(const char* name)
+    {
+        close();
+        auto res = m_memory.create(name, sizeof(ServiceHeader));
+        if (res == kResultAlreadyExists)
+        {
+            SharedMemory existing;
+            if (existing.open(name) == kResultOk && existing.size() >= sizeof(ServiceHeader) &&
+                isProcessAlive(((ServiceHeader*)existing.data())->hostPid.load(std::memory_order_acquire)))
+            {
+                return kResultAlreadyExists;
+            }
+            existing.close();
+            // Left behind by a host which crashed
+            res = m_memory.create(name, sizeof(ServiceHeader), true);
+        }
+        if (res != kResultOk) return res;
+        auto header = getHeader();
+        header->version = kProtocolVersion;
+        header->magic = kServiceMagic;
+        header->hostPid.store(getProcessId(), std::memory_order_release);
+        return m_bell.init(&header->signal, (std::string(name) + ".s").c_str());
+    }
+
+    //! Host side, returns false on timeout
+    bool accept(std::string& channel, uint32_t& clientPid, uint32_t timeoutMs)
+    {
+        auto seen = m_bell.load();
+        if (takePending(channel, clientPid)) return true;
+        m_bell.wait(seen, timeoutMs);
+        return takePending(channel, clientPid);
+    }
+
+    //! Wakes a thread blocked in 'accept'
+    void wake() { m_bell.ring(); }
+
+    //! Client side, posts the channel name and returns immediately, see 'Channel::getHeader()->hostPid' for acceptance
+    static Result post(const char* service, const char* channel)
+    {
+        auto length = channel ? strlen(channel) : 0;
+        if (!length || length >= sizeof(ServiceSlot::channel)) return kResultInvalidParameter;
+        SharedMemory memory;
+        if (NVIGI_FAILED(result, memory.open(service))) return result;
+        auto header = (ServiceHeader*)memory.data();
+        if (memory.size() < sizeof(ServiceHeader) || header->magic != kServiceMagic || header->version != kProtocolVersion) return kResultInvalidState;
+        if (!isProcessAlive(header->hostPid.load(std::memory_order_acquire))) return kResultItemNotFound;
+        for (auto& slot : header->slots)
+        {
+            uint32_t expected = kFree;
+            if (!slot.state.compare_exchange_strong(expected, kClaimed, std::memory_order_acq_rel)) continue;
+            slot.clientPid = getProcessId();
+            memcpy(slot.channel, channel, length + 1);
+            slot.state.store(kPending, std::memory_order_release);
+            Doorbell bell;
+            if (NVIGI_FAILED(result, bell.init(&header->signal, (std::string(service) + ".s").c_str()))) return result;
+            bell.ring();
+            return kResultOk;
+        }
+        return kResultInsufficientResources;
+    }
+
+    void close()
+    {
+        m_bell.reset();
+        m_memory.close();
+    }
+
+private:
+    static constexpr uint32_t kFree = 0;
+    static constexpr uint32_t kClaimed = 1;
+    static constexpr uint32_t kPending = 2;
+
+    ServiceHeader* getHeader() const { return (ServiceHeader*)m_memory.data(); }
+
+    bool takePending(std::string& channel, uint32_t& clientPid)
+    {
+        for (auto& slot : getHeader()->slots)
+        {
+            auto state = slot.state.load(std::memory_order_acquire);
+            if (state == kClaimed && slot.clientPid && !isProcessAlive(slot.clientPid))
+            {
+                // Client died while posting
+                slot.clientPid = 0;
+                slot.state.store(kFree, std::memory_order_release);
+                continue;
+            }
+            if (state != kPending) continue;
+            slot.channel[sizeof(slot.channel) - 1] = 0;
+            channel = slot.channel;
+            clientPid = slot.clientPid;
+            slot.clientPid = 0;
+            slot.state.store(kFree, std::memory_order_release);
+            return true;
+        }
+        return false;
+    }
+
+    SharedMemory m_memory;
+    Doorbell m_bell;
+};
+
+}
+}
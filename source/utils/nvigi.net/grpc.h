@@ -12,6 +12,12 @@
 #include <string>
 #include <sstream>
 #include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <future>
+#include <functional>
+#include <algorithm>
+#include <vector>
 
 // Function to split the input string by commas
 std::unordered_map<std::string, std::string> parseAuthorizationString(const std::string& authString) {
@@ -150,4 +156,215 @@ inline std::shared_ptr<::grpc::ChannelCredentials> CreateChannelCredentials(bool
     return creds;
 }
 
+/// Keepalive and connection settings applied to pooled channels
+struct ChannelOptions
+{
+    /// Number of independent connections to round-robin over, use more than one for high volume streaming RPCs
+    uint32_t subchannelCount = 1;
+    /// Interval between HTTP2 keepalive pings, 0 disables keepalive
+    ///
+    /// NOTE: gRPC servers by default reject pings more frequent than every 5 minutes and pings without active
+    /// calls, the connection is then closed with GOAWAY 'too_many_pings'. Only go lower (or permit pings without
+    /// calls) when the server's keepalive enforcement policy is known to allow it.
+    uint32_t keepaliveTimeMs = 300000;
+    /// How long to wait for ping acknowledgement before the connection is considered dead
+    uint32_t keepaliveTimeoutMs = 20000;
+    /// Keep pinging while there are no active calls so idle sessions start without a reconnect
+    bool keepalivePermitWithoutCalls = false;
+    /// Maximum pings sent without data frames, 0 means unlimited
+    uint32_t maxPingsWithoutData = 0;
+};
+
+/// Invoked once channel is connected (true) or connection timed out (false), on a background thread
+using ChannelReadyCallback = std::function<void(bool connected)>;
+
+/// Cache of gRPC channels keyed by endpoint, credentials and options
+///
+/// Channels are created without blocking and shared by all sessions talking to the same endpoint
+/// so connection setup (DNS, TCP, TLS, HTTP2) is paid once. Each entry holds 'subchannelCount'
+/// channels with separate connections, 'getChannel' hands them out round-robin.
+///
+/// NOTE: Cache is per module (plugin) since this is a header only utility. Plugins must call 'shutdown' from
+/// 'nvigiPluginDeregister', waiting for background connection attempts from a static destructor would run under
+/// the loader lock and can deadlock.
+class ChannelPool
+{
+public:
+    static ChannelPool& get()
+    {
+        static ChannelPool s_pool;
+        return s_pool;
+    }
+
+    ~ChannelPool()
+    {
+        std::scoped_lock lock(m_mtx);
+        for (auto& [key, entry] : m_entries)
+        {
+            if (entry->connecting.valid() && entry->connecting.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                // Too late to wait, future's destructor would block so entries are leaked instead
+                NVIGI_LOG_WARN("gRPC channel pool was not shut down, connection attempt to '%s' still in progress", entry->uri.c_str());
+                new std::unordered_map<std::string, std::shared_ptr<Entry>>(std::move(m_entries));
+                break;
+            }
+        }
+    }
+
+    /// Returns a channel immediately, connection is established in the background
+    ///
+    /// @param onReady Optional, invoked when the first connection attempt for this entry completes. If that attempt
+    /// has already completed it is invoked right away on the calling thread.
+    std::shared_ptr<::grpc::Channel> getChannel(const std::string& uri, bool use_ssl, const std::string& cacert, const std::string& metadata,
+        const ChannelOptions& options = {}, ChannelReadyCallback onReady = {}, uint64_t timeout_ms = 10000)
+    {
+        auto key = makeKey(uri, use_ssl, cacert, metadata, options);
+        std::shared_ptr<Entry> entry;
+        bool created = false;
+        {
+            std::scoped_lock lock(m_mtx);
+            auto& slot = m_entries[key];
+            if (!slot)
+            {
+                slot = std::make_shared<Entry>();
+                slot->uri = uri;
+                auto credentials = CreateChannelCredentials(use_ssl, cacert, metadata);
+                for (uint32_t i = 0; i < std::max(1u, options.subchannelCount); i++)
+                {
+                    ::grpc::ChannelArguments args;
+                    if (options.keepaliveTimeMs > 0)
+                    {
+                        args.SetInt(GRPC_ARG_KEEPALIVE_TIME_MS, int(options.keepaliveTimeMs));
+                        args.SetInt(GRPC_ARG_KEEPALIVE_TIMEOUT_MS, int(options.keepaliveTimeoutMs));
+                        args.SetInt(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, options.keepalivePermitWithoutCalls ? 1 : 0);
+                        args.SetInt(GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA, int(options.maxPingsWithoutData));
+                    }
+                    // Otherwise gRPC coalesces identical channels onto the same connection
+                    args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+                    args.SetInt("nvigi.subchannel_index", int(i));
+                    slot->channels.push_back(::grpc::CreateCustomChannel(uri, credentials, args));
+                }
+                created = true;
+            }
+            entry = slot;
+        }
+
+        if (onReady)
+        {
+            std::unique_lock lock(entry->state->mtx);
+            if (entry->state->done)
+            {
+                auto connected = entry->state->connected;
+                lock.unlock();
+                onReady(connected);
+            }
+            else
+            {
+                entry->state->callbacks.push_back(std::move(onReady));
+            }
+        }
+
+        if (created)
+        {
+            NVIGI_LOG_VERBOSE("Connecting %zu gRPC channel(s) to '%s' in the background", entry->channels.size(), uri.c_str());
+            // Task must not own the entry, entry owns the task's future
+            std::scoped_lock lock(m_mtx);
+            entry->connecting = std::async(std::launch::async, [channels = entry->channels, state = entry->state, uri, timeout_ms]()->void
+            {
+                auto deadline = std::chrono::system_clock::now() + std::chrono::milliseconds(timeout_ms);
+                bool connected = true;
+                for (auto& channel : channels)
+                {
+                    connected &= channel->WaitForConnected(deadline);
+                }
+                if (connected)
+                {
+                    NVIGI_LOG_VERBOSE("Connected to '%s'", uri.c_str());
+                }
+                else
+                {
+                    NVIGI_LOG_WARN("Unable to establish connection to '%s' within %llums", uri.c_str(), timeout_ms);
+                }
+                std::vector<ChannelReadyCallback> callbacks;
+                {
+                    std::scoped_lock lock(state->mtx);
+                    state->done = true;
+                    state->connected = connected;
+                    callbacks.swap(state->callbacks);
+                }
+                for (auto& callback : callbacks) callback(connected);
+            });
+        }
+
+        auto index = entry->next.fetch_add(1) % entry->channels.size();
+        return entry->channels[index];
+    }
+
+    /// Blocking variant, same semantics as 'CreateChannelBlocking' but served from the cache
+    std::shared_ptr<::grpc::Channel> getChannelBlocking(const std::string& uri, bool use_ssl, const std::string& cacert, const std::string& metadata,
+        const ChannelOptions& options = {}, uint64_t timeout_ms = 10000)
+    {
+        auto channel = getChannel(uri, use_ssl, cacert, metadata, options, {}, timeout_ms);
+        auto deadline = std::chrono::system_clock::now() + std::chrono::milliseconds(timeout_ms);
+        if (!channel->WaitForConnected(deadline))
+        {
+            throw std::runtime_error("Unable to establish connection to server. Current state: " + std::to_string((int)channel->GetState(true)));
+        }
+        return channel;
+    }
+
+    /// Drops all cached channels and waits for connection attempts in progress, call from 'nvigiPluginDeregister'
+    void shutdown()
+    {
+        clear();
+    }
+
+    /// Drops all cached channels, channels still referenced by callers stay alive until released
+    ///
+    /// Blocks until connection attempts in progress complete (at most their timeout)
+    void clear()
+    {
+        std::unordered_map<std::string, std::shared_ptr<Entry>> entries;
+        {
+            std::scoped_lock lock(m_mtx);
+            entries.swap(m_entries);
+        }
+        for (auto& [key, entry] : entries)
+        {
+            if (entry->connecting.valid()) entry->connecting.wait();
+        }
+    }
+
+private:
+    struct ConnectState
+    {
+        std::mutex mtx;
+        bool done = false;
+        bool connected = false;
+        std::vector<ChannelReadyCallback> callbacks;
+    };
+
+    struct Entry
+    {
+        std::string uri;
+        std::vector<std::shared_ptr<::grpc::Channel>> channels;
+        std::atomic<uint32_t> next{};
+        std::shared_ptr<ConnectState> state = std::make_shared<ConnectState>();
+        std::future<void> connecting;
+    };
+
+    static std::string makeKey(const std::string& uri, bool use_ssl, const std::string& cacert, const std::string& metadata, const ChannelOptions& options)
+    {
+        // Full credentials (length prefixed so no separator is ambiguous), a hash collision must never hand out a channel
+        // authenticated for someone else. Secrets are held by the channel credentials for the lifetime of the entry anyway.
+        return std::to_string(uri.size()) + ":" + uri + (use_ssl ? "|ssl|" : "|insecure|") + std::to_string(cacert.size()) + ":" + cacert + "|" +
+            std::to_string(metadata.size()) + ":" + metadata + "|" + std::to_string(options.subchannelCount) + "|" +
+            std::to_string(options.keepaliveTimeMs) + "|" + std::to_string(options.keepaliveTimeoutMs) + "|" +
+            std::to_string(options.keepalivePermitWithoutCalls) + "|" + std::to_string(options.maxPingsWithoutData);
+    }
+
+    std::mutex m_mtx;
+    std::unordered_map<std::string, std::shared_ptr<Entry>> m_entries;
+};
+
 }  // namespace nvigi::net
\ No newline at end of file
@@ -7,21 +7,95 @@
 #include <mutex>
 #include <functional>
 #include <chrono>
+#include <atomic>
+#include <vector>
 
 #include "source/core/nvigi.thread/thread.h"
 
+#ifndef NVIGI_WINDOWS
+#include <unistd.h>
+#include <sys/eventfd.h>
+#endif
+
 namespace nvigi::poll
 {
 
 constexpr uint32_t kDefaultTimeoutMs = 5000;
 
+//! By default a single result is handed over at a time, 'triggerCallback' blocks the producer
+//! until the host calls 'releaseResults'.
+//!
+//! With 'setRingDepth(N > 1)' results go through an SPSC ring instead, the producer only blocks
+//! when N results are outstanding and the host can drain several of them per frame by calling
+//! 'getResults'/'releaseResults' until kResultNotReady. Each entry carries an opaque payload
+//! (typically the outputs) which stays owned by the producer until the entry is released.
 template<typename T>
 struct PollContext
 {
+    PollContext() = default;
+    PollContext(const PollContext&) = delete;
+    PollContext& operator=(const PollContext&) = delete;
+    ~PollContext()
+    {
+#ifdef NVIGI_WINDOWS
+        if (waitHandle) CloseHandle(waitHandle);
+#else
+        if (waitHandle >= 0) ::close(waitHandle);
+#endif
+    }
+
+    //! Must be called before any result is produced, 0 or 1 keeps single-slot semantics
+    void setRingDepth(uint32_t depth)
+    {
+        ringDepth = depth > 1 ? depth : 0;
+        ring.resize(ringDepth);
+        head.store(0);
+        tail.store(0);
+    }
+
+    uint32_t getRingDepth() const { return ringDepth; }
+
+    //! Producer side, blocks until an entry is free and returns its index (same index until 'publish')
+    uint32_t acquireSlot()
+    {
+        auto t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) >= ringDepth)
+        {
+            std::unique_lock lck(resultPendingMutex);
+            resultPendingCV.wait(lck, [this, t]() { return t - head.load(std::memory_order_acquire) < ringDepth; });
+        }
+        return uint32_t(t % ringDepth);
+    }
+
+    //! Producer side, makes the acquired entry visible to the host
+    void publish(T state, void* payload)
+    {
+        auto t = tail.load(std::memory_order_relaxed);
+        acquireSlot();
+        ring[t % ringDepth] = { state, payload };
+        tail.store(t + 1, std::memory_order_release);
+        // Lock so a consumer which just evaluated the predicate cannot miss the wakeup
+        {
+            std::unique_lock lck(resultPendingMutex);
+            updateWaitHandle();
+        }
+        resultPendingCV.notify_all();
+    }
+
+    //! Payload of the oldest outstanding entry (ring mode only)
+    void* peekPayload()
+    {
+        auto h = head.load(std::memory_order_relaxed);
+        if (!ringDepth || h == tail.load(std::memory_order_acquire))
+            return nullptr;
+        return ring[h % ringDepth].payload;
+    }
+
     void signalResultPending()
     {
         std::unique_lock lck(resultPendingMutex);
         resultPending = true;
+        updateWaitHandle();
         resultPendingCV.notify_one();
     }
 
@@ -29,13 +103,14 @@ struct PollContext
     {
         std::unique_lock lck(resultPendingMutex);
         resultPending = false;
+        updateWaitHandle();
         resultPendingCV.notify_one();
     }
 
     Result waitResultPending(uint32_t timeoutMs = kDefaultTimeoutMs)
     {
         std::unique_lock lck(resultPendingMutex);
-        if (!resultPendingCV.wait_for(lck, std::chrono::milliseconds(timeoutMs), [this]() { return resultPending; }))
+        if (!thread::waitFor(resultPendingCV, lck, std::chrono::milliseconds(timeoutMs), [this]() { return isPending(); }))
         {
             return nvigi::kResultTimedOut;
         }
@@ -44,12 +119,23 @@ struct PollContext
 
     bool checkResultPending()
     {
+        if (ringDepth)
+            return isPending();
         std::unique_lock lck(resultPendingMutex);
         return resultPending;
     }
 
     T triggerCallback(T state)
     {
+        if (ringDepth)
+        {
+            // Caller expects to own its data again on return, wait until host consumed everything
+            auto t = tail.load(std::memory_order_relaxed) + 1;
+            publish(state, nullptr);
+            std::unique_lock lck(resultPendingMutex);
+            resultPendingCV.wait(lck, [this, t]() { return head.load(std::memory_order_acquire) >= t; });
+            return resultPendingStatus.load();
+        }
         resultPendingStatus.store(state);
         signalResultPending();
         // Wait indefinitely for host to consume results (no timeout)
@@ -59,7 +145,8 @@ struct PollContext
     }
 
     
-    Result getResults(bool wait, T* state, uint32_t timeoutMs = kDefaultTimeoutMs)
+    //! In ring mode returns the oldest outstanding entry, its payload is returned via 'payload' (if provided)
+    Result getResults(bool wait, T* state, uint32_t timeoutMs = kDefaultTimeoutMs, void** payload = nullptr)
     {
         if (wait)
         {
@@ -72,22 +159,126 @@ struct PollContext
             if (!checkResultPending())
                 return nvigi::kResultNotReady;
         }
+        if (ringDepth)
+        {
+            auto& entry = ring[head.load(std::memory_order_relaxed) % ringDepth];
+            if (state)
+                *state = entry.state;
+            if (payload)
+                *payload = entry.payload;
+            return kResultOk;
+        }
         if (state)
             *state = resultPendingStatus;
+        if (payload)
+            *payload = nullptr;
         return kResultOk;
     }
 
+    //! In ring mode releases the oldest outstanding entry
     Result releaseResults(T state)
     {
         resultPendingStatus = state;
+        if (ringDepth)
+        {
+            auto h = head.load(std::memory_order_relaxed);
+            if (h == tail.load(std::memory_order_acquire))
+                return kResultOk;
+            head.store(h + 1, std::memory_order_release);
+            {
+                std::unique_lock lck(resultPendingMutex);
+                updateWaitHandle();
+            }
+            resultPendingCV.notify_all();
+            return kResultOk;
+        }
         signalResultConsumed();
         return kResultOk;
     }
 
+    bool isPending()
+    {
+        if (ringDepth)
+            return head.load(std::memory_order_acquire) != tail.load(std::memory_order_acquire);
+        return resultPending;
+    }
+
+    //! OS handle signaled while 'isPending', created on first request so hosts which never ask pay nothing
+    //!
+    //! Returns 0 if the handle could not be created
+    uint64_t getWaitHandle()
+    {
+        std::unique_lock lck(resultPendingMutex);
+#ifdef NVIGI_WINDOWS
+        if (!waitHandle)
+        {
+            waitHandle = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+            if (!waitHandle)
+            {
+                NVIGI_LOG_ERROR("Failed to create results wait handle - error %u", GetLastError());
+                return 0;
+            }
+            updateWaitHandle();
+        }
+        return uint64_t(waitHandle);
+#else
+        if (waitHandle < 0)
+        {
+            waitHandle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (waitHandle < 0)
+            {
+                NVIGI_LOG_ERROR("Failed to create results wait handle - errno %d", errno);
+                return 0;
+            }
+            updateWaitHandle();
+        }
+        return uint64_t(waitHandle);
+#endif
+    }
+
     std::mutex resultPendingMutex;
     std::condition_variable resultPendingCV{};
     bool resultPending = false;
     std::atomic<T> resultPendingStatus{};
+
+    struct Entry
+    {
+        T state{};
+        void* payload{};
+    };
+    uint32_t ringDepth = 0;
+    std::vector<Entry> ring;
+    std::atomic<uint64_t> head{};
+    std::atomic<uint64_t> tail{};
+
+private:
+    //! Must be called with 'resultPendingMutex' held whenever 'isPending' might have changed
+    void updateWaitHandle()
+    {
+#ifdef NVIGI_WINDOWS
+        if (!waitHandle) return;
+#else
+        if (waitHandle < 0) return;
+#endif
+        bool pending = isPending();
+        if (pending == waitHandleSignaled) return;
+        waitHandleSignaled = pending;
+#ifdef NVIGI_WINDOWS
+        pending ? SetEvent(waitHandle) : ResetEvent(waitHandle);
+#else
+        // eventfd counter is non-zero while signaled, reading resets it
+        uint64_t value = 1;
+        ssize_t res = pending ? ::write(waitHandle, &value, sizeof(value)) : ::read(waitHandle, &value, sizeof(value));
+        (void)res;
+#endif
+    }
+
+#ifdef NVIGI_WINDOWS
+    HANDLE waitHandle{};
+#else
+    int waitHandle = -1;
+#endif
+    bool waitHandleSignaled = false;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#pragma once
+
+#include <fstream>
+
+#include "source/utils/nvigi.wav/wav.h"
+
+namespace nvigi
+{
+
+namespace wav
+{
+
+//! Writes a canonical 44 byte header followed by the raw sample bytes
+inline void wavTestWriteFile(const fs::path& path, uint16_t format, uint16_t channels, uint32_t sampleRate, uint16_t bitsPerSample, const std::vector<uint8_t>& data)
+{
+    std::ofstream file(path, std::ios::binary);
+    auto write16 = [&file](uint16_t v) { file.write(reinterpret_cast<const char*>(&v), sizeof(v)); };
+    auto write32 = [&file](uint32_t v) { file.write(reinterpret_cast<const char*>(&v), sizeof(v)); };
+    const uint16_t blockAlign = uint16_t(channels * bitsPerSample / 8);
+    file.write("RIFF", 4);
+    write32(uint32_t(36 + data.size()));
+    file.write("WAVEfmt ", 8);
+    write32(16);
+    write16(format);
+    write16(channels);
+    write32(sampleRate);
+    write32(sampleRate * blockAlign);
+    write16(blockAlign);
+    write16(bitsPerSample);
+    file.write("data", 4);
+    write32(uint32_t(data.size()));
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+TEST_CASE("wav::readAudioFileAs16bit header describes converted 24-bit samples", "[wav]") {
+    // Multiples of 256 so the 24 to 16 bit conversion is exact
+    std::vector<int16_t> expected;
+    for (int i = 0; i < 1000; i++) expected.push_back(int16_t((i * 97) % 65536 - 32768));
+    std::vector<uint8_t> data;
+    for (int16_t v : expected)
+    {
+        uint32_t sample = uint32_t(int32_t(v) * 256);
+        data.push_back(uint8_t(sample));
+        data.push_back(uint8_t(sample >> 8));
+        data.push_back(uint8_t(sample >> 16));
+    }
+    auto path = fs::temp_directory_path() / "nvigi_wav_test_24bit.wav";
+    wavTestWriteFile(path, kWAVFormatPCM, 2, 22050, 24, data);
+
+    std::vector<int16_t> audio;
+    WAVHeaderInfo header{};
+    REQUIRE(readAudioFileAs16bit(path.string(), audio, header));
+    REQUIRE(header.audioFormat == kWAVFormatPCM);
+    REQUIRE(header.numChannels == 2);
+    REQUIRE(header.sampleRate == 22050);
+    REQUIRE(header.bitsPerSample == 16);
+    REQUIRE(header.blockAlign == 4);
+    REQUIRE(header.byteRate == 22050 * 4);
+    REQUIRE(header.dataSize == audio.size() * sizeof(int16_t));
+    REQUIRE(audio == expected);
+    fs::remove(path);
+}
+
+TEST_CASE("wav::readAudioFileAs16bit header describes converted float samples", "[wav]") {
+    std::vector<float> samples = { 0.0f, 0.5f, -0.5f, 0.25f, -1.0f, 2.0f, -2.0f };
+    std::vector<uint8_t> data(samples.size() * sizeof(float));
+    memcpy(data.data(), samples.data(), data.size());
+    auto path = fs::temp_directory_path() / "nvigi_wav_test_float.wav";
+    wavTestWriteFile(path, kWAVFormatFloat, 1, 16000, 32, data);
+
+    std::vector<int16_t> audio;
+    WAVHeaderInfo header{};
+    REQUIRE(readAudioFileAs16bit(path.string(), audio, header));
+    REQUIRE(header.audioFormat == kWAVFormatPCM);
+    REQUIRE(header.numChannels == 1);
+    REQUIRE(header.sampleRate == 16000);
+    REQUIRE(header.bitsPerSample == 16);
+    REQUIRE(header.blockAlign == 2);
+    REQUIRE(header.byteRate == 16000 * 2);
+    REQUIRE(header.dataSize == samples.size() * sizeof(int16_t));
+    REQUIRE(audio == std::vector<int16_t>{ 0, 16384, -16384, 8192, -32768, 32767, -32768 });
+    fs::remove(path);
+}
+
+TEST_CASE("wav::readAudioFileAs16bit fails on missing file", "[wav]") {
+    std::vector<int16_t> audio;
+    WAVHeaderInfo header{};
+    REQUIRE(!readAudioFileAs16bit((fs::temp_directory_path() / "nvigi_wav_test_missing.wav").string(), audio, header));
+}
+
+}
+
+}
@@ -8,6 +8,10 @@
 #include <string>
 #include <fstream>
 #include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <numeric>
 #include <vector>
 
 using std::fstream;
@@ -16,6 +20,10 @@ using std::string;
 namespace nvigi::wav
 {
 
+constexpr uint16_t kWAVFormatPCM = 1;
+constexpr uint16_t kWAVFormatFloat = 3;
+constexpr uint16_t kWAVFormatExtensible = 0xfffe;
+
 struct WAVHeaderInfo {
     uint16_t audioFormat;
     uint16_t numChannels;
@@ -60,10 +68,21 @@ bool extractWAVHeader(std::ifstream& file, WAVHeaderInfo& headerInfo) {
             file.read(reinterpret_cast<char*>(&blockAlign), sizeof(blockAlign));
             file.read(reinterpret_cast<char*>(&bitsPerSample), sizeof(bitsPerSample));
 
+            // WAVE_FORMAT_EXTENSIBLE stores the actual format in the first two bytes of the sub-format GUID
+            uint32_t extraBytes = 0;
+            if (audioFormat == kWAVFormatExtensible && chunkSize >= 40) {
+                char extension[24];
+                file.read(extension, sizeof(extension));
+                memcpy(&audioFormat, extension + 8, sizeof(audioFormat));
+                extraBytes = sizeof(extension);
+            }
+
             // Skip the rest of the chunk if it's larger than the expected size for PCM
-            if (chunkSize > 16) {
-                file.seekg(chunkSize - 16, std::ios::cur);
+            if (chunkSize > 16 + extraBytes) {
+                file.seekg(chunkSize - 16 - extraBytes, std::ios::cur);
             }
+            // Chunks are word aligned
+            if (chunkSize & 1) file.seekg(1, std::ios::cur);
 
             headerInfo = { audioFormat, numChannels, sampleRate, byteRate, blockAlign, bitsPerSample, 0 };
         }
@@ -74,8 +93,8 @@ bool extractWAVHeader(std::ifstream& file, WAVHeaderInfo& headerInfo) {
             return true;
         }
         else {
-            // Skip over chunks that are not "fmt " or "data"
-            file.seekg(chunkSize, std::ios::cur);
+            // Skip over chunks that are not "fmt " or "data", chunks are word aligned
+            file.seekg(chunkSize + (chunkSize & 1), std::ios::cur);
         }
     }
 
@@ -89,13 +108,347 @@ bool extractWAVHeader(std::ifstream& file, WAVHeaderInfo& headerInfo) {
 }
 
 
+//! Polyphase windowed sinc resampler for planar float streams
+//!
+//! Input frames are pushed in any block size, output frames are pulled as they become available.
+//! Rates are reduced to 'up/down' so common conversions (e.g. 44.1kHz or 48kHz to 16kHz) use exact phases.
+struct PolyphaseResampler
+{
+    static constexpr size_t kMaxPhases = 256;
+    static constexpr size_t kMaxTaps = 256;
+
+    bool init(uint32_t inRate, uint32_t outRate, uint16_t numChannels)
+    {
+        if (!inRate || !outRate || !numChannels) return false;
+        auto divisor = std::gcd(inRate, outRate);
+        up = outRate / divisor;
+        down = inRate / divisor;
+        channels = numChannels;
+        if (up == down)
+        {
+            taps = 1;
+            phases = 1;
+            coefs = { 1.0f };
+        }
+        else
+        {
+            // Low pass at the lower of the two Nyquist frequencies, longer filter when decimating
+            double cutoff = std::min(1.0, double(up) / double(down));
+            taps = std::min(kMaxTaps, size_t(std::ceil(16.0 / cutoff / 8.0)) * 8);
+            phases = std::min<size_t>(up, kMaxPhases);
+            coefs.resize(phases * taps);
+            constexpr double kPi = 3.14159265358979323846;
+            for (size_t p = 0; p < phases; p++)
+            {
+                double sum = 0;
+                for (size_t k = 0; k < taps; k++)
+                {
+                    // Distance between the output position and input tap 'k', in input samples
+                    double tau = double(p) / double(phases) + double(left()) - double(k);
+                    double x = cutoff * tau;
+                    double sinc = x == 0.0 ? 1.0 : std::sin(kPi * x) / (kPi * x);
+                    double w = 2.0 * kPi * (tau / double(taps) + 0.5);
+                    double blackman = 0.42 - 0.5 * std::cos(w) + 0.08 * std::cos(2.0 * w);
+                    double c = cutoff * sinc * blackman;
+                    coefs[p * taps + k] = float(c);
+                    sum += c;
+                }
+                // Unity DC gain for every phase
+                for (size_t k = 0; k < taps; k++) coefs[p * taps + k] = float(coefs[p * taps + k] / sum);
+            }
+        }
+        history.assign(channels, std::vector<float>(left(), 0.0f));
+        historyStart = -int64_t(left());
+        inputFrames = 0;
+        outputFrames = 0;
+        flushed = false;
+        return true;
+    }
+
+    bool isPassthrough() const { return up == down; }
+    uint16_t getChannels() const { return channels; }
+
+    //! Number of output frames produced for 'frames' input frames
+    uint64_t getOutputFrameCount(uint64_t frames) const { return down ? (frames * up + down - 1) / down : 0; }
+
+    //! Appends interleaved input frames
+    void push(const float* interleaved, size_t frames)
+    {
+        for (uint16_t c = 0; c < channels; c++)
+        {
+            auto& h = history[c];
+            size_t offset = h.size();
+            h.resize(offset + frames);
+            for (size_t i = 0; i < frames; i++) h[offset + i] = interleaved[i * channels + c];
+        }
+        inputFrames += frames;
+    }
+
+    //! No more input, remaining frames can be pulled
+    void flush()
+    {
+        if (flushed) return;
+        flushed = true;
+        for (auto& h : history) h.resize(h.size() + right(), 0.0f);
+    }
+
+    //! Returns number of interleaved frames written to 'out'
+    size_t pull(float* out, size_t maxFrames)
+    {
+        size_t produced = 0;
+        const int64_t historyEnd = historyStart + int64_t(history.empty() ? 0 : history[0].size());
+        while (produced < maxFrames)
+        {
+            uint64_t t = outputFrames * down;
+            if (flushed && t >= inputFrames * up) break;
+            int64_t i = int64_t(t / up);
+            if (i + int64_t(right()) >= historyEnd) break;
+            size_t phase = size_t(up <= kMaxPhases ? t % up : (t % up) * phases / up);
+            size_t offset = size_t(i - int64_t(left()) - historyStart);
+            const float* h = coefs.data() + phase * taps;
+            for (uint16_t c = 0; c < channels; c++)
+            {
+                out[produced * channels + c] = dot(history[c].data() + offset, h);
+            }
+            produced++;
+            outputFrames++;
+        }
+
+        // Drop input no longer referenced, in large steps to keep the cost of moving the tail low
+        int64_t first = int64_t(outputFrames * down / up) - int64_t(left());
+        if (first - historyStart >= 4096)
+        {
+            size_t drop = size_t(first - historyStart);
+            for (auto& h : history) h.erase(h.begin(), h.begin() + drop);
+            historyStart = first;
+        }
+        return produced;
+    }
+
+private:
+    size_t left() const { return (taps - 1) / 2; }
+    size_t right() const { return taps - 1 - left(); }
+
+    float dot(const float* x, const float* h) const
+    {
+        if (taps == 1) return x[0] * h[0];
+        // Independent accumulators so compilers vectorize without reassociating
+        float acc[8]{};
+        for (size_t k = 0; k < taps; k += 8)
+        {
+            for (size_t j = 0; j < 8; j++) acc[j] += x[k + j] * h[k + j];
+        }
+        return ((acc[0] + acc[4]) + (acc[1] + acc[5])) + ((acc[2] + acc[6]) + (acc[3] + acc[7]));
+    }
+
+    uint64_t up = 1;
+    uint64_t down = 1;
+    uint16_t channels{};
+    size_t taps = 1;
+    size_t phases = 1;
+    std::vector<float> coefs;
+    std::vector<std::vector<float>> history;
+    int64_t historyStart{};
+    uint64_t inputFrames{};
+    uint64_t outputFrames{};
+    bool flushed = false;
+};
+
+//! Streaming WAV reader
+//!
+//! Decodes the data chunk in fixed size blocks so memory use does not depend on the length of the file.
+//! Supports PCM 8/16/24/32-bit and 32-bit float (including WAVE_FORMAT_EXTENSIBLE) and optionally converts
+//! to the target channel count (mono downmix or duplication) and sample rate.
+//!
+//! WAVStreamReader reader;
+//! if (reader.open("speech.wav", 16000, 1))
+//! {
+//!     std::vector<int16_t> block(4096);
+//!     while (size_t frames = reader.read(block.data(), block.size())) { ... }
+//! }
+struct WAVStreamReader
+{
+    //! Zero target rate or channel count keeps the format from the file
+    bool open(const string& filename, uint32_t targetSampleRate = 0, uint16_t targetChannels = 0, size_t blockFrames = 4096)
+    {
+        file = std::ifstream(filename, std::ios::binary);
+        if (!file.is_open())
+        {
+            NVIGI_LOG_ERROR("Failed to open '%s'", filename.c_str());
+            return false;
+        }
+        if (!extractWAVHeader(file, header)) return false;
+
+        bool supported = header.numChannels > 0 && header.sampleRate > 0 &&
+            ((header.audioFormat == kWAVFormatPCM && (header.bitsPerSample == 8 || header.bitsPerSample == 16 || header.bitsPerSample == 24 || header.bitsPerSample == 32)) ||
+             (header.audioFormat == kWAVFormatFloat && header.bitsPerSample == 32));
+        if (!supported)
+        {
+            NVIGI_LOG_ERROR("Unsupported WAV format %u with %u bits per sample", header.audioFormat, header.bitsPerSample);
+            return false;
+        }
+
+        frameBytes = size_t(header.numChannels) * (header.bitsPerSample / 8);
+        // Streamed recordings can leave the size unset, read until the end of the file in that case
+        bytesRemaining = (header.dataSize == 0 || header.dataSize == 0xffffffff) ? UINT64_MAX : header.dataSize;
+        outChannels = targetChannels ? targetChannels : header.numChannels;
+        outSampleRate = targetSampleRate ? targetSampleRate : header.sampleRate;
+        if (!resampler.init(header.sampleRate, outSampleRate, outChannels)) return false;
+
+        blockSize = std::max<size_t>(blockFrames, 1);
+        raw.resize(blockSize * frameBytes);
+        decoded.resize(blockSize * header.numChannels);
+        mixed.resize(blockSize * outChannels);
+        return true;
+    }
+
+    const WAVHeaderInfo& getHeader() const { return header; }
+    uint32_t getSampleRate() const { return outSampleRate; }
+    uint16_t getChannels() const { return outChannels; }
+
+    //! Output frames for the whole file, exact unless the data chunk size is missing
+    uint64_t getFrameCount() const { return frameBytes ? resampler.getOutputFrameCount(header.dataSize / frameBytes) : 0; }
+
+    //! Reads up to 'maxFrames' interleaved frames into a preallocated buffer, returns 0 at the end of the stream
+    size_t read(float* out, size_t maxFrames)
+    {
+        size_t written = 0;
+        while (written < maxFrames)
+        {
+            size_t frames = resampler.pull(out + written * outChannels, maxFrames - written);
+            written += frames;
+            if (frames == 0 && !decodeBlock()) break;
+        }
+        return written;
+    }
+
+    //! Same as above but converts to PCM16
+    size_t read(int16_t* out, size_t maxFrames)
+    {
+        scratch.resize(std::min(maxFrames, blockSize) * outChannels);
+        size_t written = 0;
+        while (written < maxFrames)
+        {
+            size_t frames = read(scratch.data(), std::min(maxFrames - written, blockSize));
+            if (frames == 0) break;
+            auto dst = out + written * outChannels;
+            for (size_t i = 0; i < frames * outChannels; i++)
+            {
+                dst[i] = int16_t(std::clamp(std::lrintf(scratch[i] * 32768.0f), -32768l, 32767l));
+            }
+            written += frames;
+        }
+        return written;
+    }
+
+private:
+    //! Returns false once everything was decoded and flushed
+    bool decodeBlock()
+    {
+        if (eof) return false;
+        size_t bytes = size_t(std::min<uint64_t>(raw.size(), bytesRemaining));
+        file.read(reinterpret_cast<char*>(raw.data()), bytes);
+        size_t frames = size_t(file.gcount()) / frameBytes;
+        bytesRemaining -= std::min<uint64_t>(bytesRemaining, uint64_t(file.gcount()));
+        if (frames == 0)
+        {
+            eof = true;
+            resampler.flush();
+            return true;
+        }
+
+        const size_t count = frames * header.numChannels;
+        const uint8_t* src = raw.data();
+        switch (header.bitsPerSample)
+        {
+            case 8:
+                for (size_t i = 0; i < count; i++) decoded[i] = float(src[i]) / 128.0f - 1.0f;
+                break;
+            case 16:
+                for (size_t i = 0; i < count; i++)
+                {
+                    int16_t v;
+                    memcpy(&v, src + i * 2, sizeof(v));
+                    decoded[i] = float(v) / 32768.0f;
+                }
+                break;
+            case 24:
+                for (size_t i = 0; i < count; i++)
+                {
+                    // Sign extend from the top byte
+                    int32_t v = int32_t(uint32_t(src[i * 3]) << 8 | uint32_t(src[i * 3 + 1]) << 16 | uint32_t(src[i * 3 + 2]) << 24) >> 8;
+                    decoded[i] = float(v) / 8388608.0f;
+                }
+                break;
+            case 32:
+                if (header.audioFormat == kWAVFormatFloat)
+                {
+                    memcpy(decoded.data(), src, count * sizeof(float));
+                }
+                else
+                {
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        int32_t v;
+                        memcpy(&v, src + i * 4, sizeof(v));
+                        decoded[i] = float(v) / 2147483648.0f;
+                    }
+                }
+                break;
+        }
+
+        const uint16_t inChannels = header.numChannels;
+        if (inChannels == outChannels)
+        {
+            resampler.push(decoded.data(), frames);
+            return true;
+        }
+        for (size_t f = 0; f < frames; f++)
+        {
+            const float* in = decoded.data() + f * inChannels;
+            float* out = mixed.data() + f * outChannels;
+            if (outChannels == 1)
+            {
+                float sum = 0.0f;
+                for (uint16_t c = 0; c < inChannels; c++) sum += in[c];
+                out[0] = sum / float(inChannels);
+            }
+            else if (inChannels == 1)
+            {
+                for (uint16_t c = 0; c < outChannels; c++) out[c] = in[0];
+            }
+            else
+            {
+                for (uint16_t c = 0; c < outChannels; c++) out[c] = c < inChannels ? in[c] : 0.0f;
+            }
+        }
+        resampler.push(mixed.data(), frames);
+        return true;
+    }
+
+    std::ifstream file;
+    WAVHeaderInfo header{};
+    PolyphaseResampler resampler;
+    size_t frameBytes{};
+    size_t blockSize{};
+    uint64_t bytesRemaining{};
+    uint16_t outChannels{};
+    uint32_t outSampleRate{};
+    bool eof = false;
+    std::vector<uint8_t> raw;
+    std::vector<float> decoded;
+    std::vector<float> mixed;
+    std::vector<float> scratch;
+};
+
+//! Formats other than PCM16 are converted, 'header' then describes the returned samples rather than the file
 bool readAudioFileAs16bit(string input_filename, std::vector<int16_t>& out_audio, WAVHeaderInfo& header)
 {
     std::ifstream file(input_filename, std::ios::binary);
 
     if (!file.is_open()) {
         NVIGI_LOG_ERROR("Failed to open file.");
-        return 1;
+        return false;
     }
 
     if (extractWAVHeader(file, header)) {
@@ -104,6 +457,7 @@ bool readAudioFileAs16bit(string input_filename, std::vector<int16_t>& out_audio
     }
     else {
         NVIGI_LOG_ERROR("Failed to extract WAV header info.");
+        return false;
     }
 
     // Print some information about the WAV file
@@ -130,18 +484,24 @@ bool readAudioFileAs16bit(string input_filename, std::vector<int16_t>& out_audio
     //}
 
     // Assuming little-endian representation for all cases
-    if (header.bitsPerSample == 8)          // uint8
-    {
-        return false;
-    }
-    else if (header.bitsPerSample == 16)    // int16
+    if (header.audioFormat == kWAVFormatPCM && header.bitsPerSample == 16)    // int16
     {
         out_audio.resize(header.dataSize / 2); // every two bytes of file data represents one value
         file.read((char*)out_audio.data(), out_audio.size() * sizeof(int16_t));
     }
-    else if (header.bitsPerSample == 32)   // int32
+    else
     {
-        return false;
+        // Everything else is converted, keeping channels and rate as they are in the file
+        WAVStreamReader reader;
+        if (!reader.open(input_filename)) return false;
+        out_audio.resize(size_t(reader.getFrameCount()) * reader.getChannels());
+        out_audio.resize(reader.read(out_audio.data(), out_audio.size() / reader.getChannels()) * reader.getChannels());
+
+        header.audioFormat = kWAVFormatPCM;
+        header.bitsPerSample = 16;
+        header.blockAlign = uint16_t(header.numChannels * sizeof(int16_t));
+        header.byteRate = header.sampleRate * header.blockAlign;
+        header.dataSize = uint32_t(out_audio.size() * sizeof(int16_t));
     }
 
     file.close();